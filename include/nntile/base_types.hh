@@ -86,6 +86,53 @@ inline std::ostream &operator<<(std::ostream &os, const int64_t &value)
     return os;
 }
 
+//! NNTile wrapper type for 8-bit signed integers inside NNTile tensors
+/*! Used to store quantized values, e.g., a quantized KV-cache */
+class int8_t
+{
+public:
+    //! Basic type that must have the same size, as this type
+    using storage_t = std::int8_t;
+    //! Basic type that must cover all possible values of this type
+    using repr_t = std::int8_t;
+    //! Flag if copy from repr_t does not require conversion
+    static const bool trivial_copy_from_compat = true;
+    //! String to represent this type
+    static constexpr const char *type_repr = "int8_t";
+    //! Internal value of this type to hold actual data
+    storage_t value;
+    //! Constructor
+    NNTILE_HOST_DEVICE int8_t() = default;
+    //! Constructor from another value of this type
+    NNTILE_HOST_DEVICE int8_t(const int8_t &other) = default;
+    //! Constructor from a repr_t value
+    NNTILE_HOST_DEVICE explicit int8_t(const repr_t &other):
+        value(other)
+    {
+    }
+    //! Assignment from another value of this type
+    NNTILE_HOST_DEVICE int8_t &operator=(const int8_t &other) = default;
+    //! Assignment from a repr_t value
+    NNTILE_HOST_DEVICE int8_t &operator=(const repr_t &other)
+    {
+        value = other;
+        return *this;
+    }
+    //! Conversion to repr_t value
+    NNTILE_HOST_DEVICE explicit operator repr_t() const
+    {
+        return value;
+    }
+};
+
+//! Print function for nntile::int8_t
+inline std::ostream &operator<<(std::ostream &os, const int8_t &value)
+{
+    // Print as a number, not as a character
+    os << static_cast<int>(static_cast<typename int8_t::repr_t>(value));
+    return os;
+}
+
 //! NNTile wrapper type for bool values inside NNTile tensors
 class bool_t
 {
@@ -65,6 +65,17 @@
 //#include <nntile/kernel/fp32_to_fp16.hh>
 //#include <nntile/kernel/fp16_to_fp32.hh>
 #include <nntile/kernel/mask_scalar.hh>
+#include <nntile/kernel/mask_scalar_causal.hh>
+#include <nntile/kernel/mask_varlen.hh>
+#include <nntile/kernel/topk.hh>
+#include <nntile/kernel/sample_topk.hh>
+#include <nntile/kernel/quantize.hh>
+#include <nntile/kernel/dequantize.hh>
+#include <nntile/kernel/gemv.hh>
+#include <nntile/kernel/pack_panels.hh>
+#include <nntile/kernel/gemm_packed.hh>
+#include <nntile/kernel/beam_topk.hh>
+#include <nntile/kernel/index_select.hh>
 #include <nntile/kernel/scal.hh>
 #include <nntile/kernel/adam_step.hh>
 #include <nntile/kernel/adamw_step.hh>
@@ -76,6 +87,7 @@
 #include <nntile/kernel/conv2d_bwd_weight_inplace.hh>
 #include <nntile/kernel/rope.hh>
 #include <nntile/kernel/rope_backward.hh>
+#include <nntile/kernel/rope_qk.hh>
 #include <nntile/kernel/norm_fiber.hh>
 
 //! @namespace nntile::kernel
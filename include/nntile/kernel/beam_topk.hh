@@ -0,0 +1,31 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/beam_topk.hh
+ * Top-k largest elements of a matrix for beam search
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/kernel/beam_topk/cpu.hh>
+#include <nntile/defs.h>
+#ifdef NNTILE_USE_CUDA
+#include <nntile/kernel/beam_topk/cuda.hh>
+#endif // NNTILE_USE_CUDA
+
+//! @namespace nntile::kernel::beam_topk
+/*! Low-level implementations of beam search top-k operation, that selects
+ * the largest elements among all columns (beams) together with their rows
+ * (tokens) and columns
+ * */
+namespace nntile::kernel::beam_topk
+{
+
+} // namespace nntile::kernel::beam_topk
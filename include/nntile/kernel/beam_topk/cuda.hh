@@ -0,0 +1,30 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/beam_topk/cuda.hh
+ * Top-k largest elements of a matrix for beam search on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+#include <cuda_runtime.h>
+
+namespace nntile::kernel::beam_topk
+{
+
+// Accumulate top-k largest elements of a matrix with their positions
+template<typename T>
+void cuda(cudaStream_t stream, Index m, Index n, Index k, Index row_offset,
+        Index col_offset, bool init, const T *src, T *dst_val,
+        int64_t *dst_idx, int64_t *dst_beam)
+    noexcept;
+
+} // namespace nntile::kernel::beam_topk
@@ -33,6 +33,14 @@ struct CPUComputeType<int64_t>
     using value = std::int64_t;
 };
 
+//! Compute type for nntile::int8_t type
+template<>
+struct CPUComputeType<int8_t>
+{
+    // nntile::int8_t -> std::int8_t from <cstdint>
+    using value = std::int8_t;
+};
+
 //! Compute type for nntile::bool_t type
 template<>
 struct CPUComputeType<bool_t>
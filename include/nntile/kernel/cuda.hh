@@ -48,6 +48,14 @@ struct CUDAComputeType<int64_t>
     using value = std::int64_t;
 };
 
+//! Compute type for nntile::int8_t type
+template<>
+struct CUDAComputeType<int8_t>
+{
+    // nntile::int8_t -> std::int8_t from <cstdint>
+    using value = std::int8_t;
+};
+
 //! Compute type for nntile::bool_t type
 template<>
 struct CUDAComputeType<bool_t>
@@ -0,0 +1,30 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/dequantize.hh
+ * Dequantization of int8 columns
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/kernel/dequantize/cpu.hh>
+#include <nntile/defs.h>
+#ifdef NNTILE_USE_CUDA
+#include <nntile/kernel/dequantize/cuda.hh>
+#endif // NNTILE_USE_CUDA
+
+//! @namespace nntile::kernel::dequantize
+/*! Low-level implementations of dequantization of int8 columns of a matrix
+ * with a scale per column
+ * */
+namespace nntile::kernel::dequantize
+{
+
+} // namespace nntile::kernel::dequantize
@@ -0,0 +1,29 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/dequantize/cuda.hh
+ * Dequantization of int8 columns on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+#include <cuda_runtime.h>
+
+namespace nntile::kernel::dequantize
+{
+
+// Dequantization of int8 columns
+template<typename T>
+void cuda(cudaStream_t stream, Index m, Index n, const int8_t *src,
+        const T *scale, T *dst)
+    noexcept;
+
+} // namespace nntile::kernel::dequantize
@@ -0,0 +1,26 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/gemm_packed.hh
+ * Product of a packed matrix by a matrix
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/kernel/gemm_packed/cpu.hh>
+
+//! @namespace nntile::kernel::gemm_packed
+/*! Low-level implementations of a product of a matrix, that is packed into
+ * panels of rows by kernel::pack_panels, by a matrix
+ * */
+namespace nntile::kernel::gemm_packed
+{
+
+} // namespace nntile::kernel::gemm_packed
@@ -0,0 +1,28 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/gemm_packed/cpu.hh
+ * Product of a packed matrix by a matrix on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+
+namespace nntile::kernel::gemm_packed
+{
+
+// Product of a packed matrix by a matrix
+template<typename T>
+void cpu(bool transB, Index m, Index n, Index k, Scalar alpha, const T *A,
+        const T *B, Scalar beta, T *C)
+    noexcept;
+
+} // namespace nntile::kernel::gemm_packed
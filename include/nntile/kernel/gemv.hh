@@ -0,0 +1,31 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/gemv.hh
+ * Matrix times a few vectors, specialized gemm for decoding
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/kernel/gemv/cpu.hh>
+#include <nntile/defs.h>
+#ifdef NNTILE_USE_CUDA
+#include <nntile/kernel/gemv/cuda.hh>
+#endif // NNTILE_USE_CUDA
+
+//! @namespace nntile::kernel::gemv
+/*! Low-level implementations of a product of a matrix by a matrix with only
+ * a few columns, which is memory-bound and is done by reading the first
+ * matrix exactly once
+ * */
+namespace nntile::kernel::gemv
+{
+
+} // namespace nntile::kernel::gemv
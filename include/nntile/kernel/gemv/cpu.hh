@@ -0,0 +1,28 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/gemv/cpu.hh
+ * Matrix times a few vectors on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+
+namespace nntile::kernel::gemv
+{
+
+// Product of a matrix by a matrix with a few columns
+template<typename T>
+void cpu(bool transA, Index m, Index n, Index k, Scalar alpha, const T *A,
+        const T *B, Scalar beta, T *C)
+    noexcept;
+
+} // namespace nntile::kernel::gemv
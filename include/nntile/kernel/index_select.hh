@@ -0,0 +1,30 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/index_select.hh
+ * Selection of slices along an axis by indices
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/kernel/index_select/cpu.hh>
+#include <nntile/defs.h>
+#ifdef NNTILE_USE_CUDA
+#include <nntile/kernel/index_select/cuda.hh>
+#endif // NNTILE_USE_CUDA
+
+//! @namespace nntile::kernel::index_select
+/*! Low-level implementations of index_select operation, that gathers slices
+ * of an array along the middle mode by indices
+ * */
+namespace nntile::kernel::index_select
+{
+
+} // namespace nntile::kernel::index_select
@@ -0,0 +1,28 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/index_select/cpu.hh
+ * Selection of slices along an axis by indices on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+
+namespace nntile::kernel::index_select
+{
+
+// Gather slices of an array along the middle mode by indices
+template<typename T>
+void cpu(Index m, Index n, Index k, Index src_n, const int64_t *index,
+        const T *src, T *dst)
+    noexcept;
+
+} // namespace nntile::kernel::index_select
@@ -0,0 +1,29 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/index_select/cuda.hh
+ * Selection of slices along an axis by indices on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+#include <cuda_runtime.h>
+
+namespace nntile::kernel::index_select
+{
+
+// Gather slices of an array along the middle mode by indices
+template<typename T>
+void cuda(cudaStream_t stream, Index m, Index n, Index k, Index src_n,
+        const int64_t *index, const T *src, T *dst)
+    noexcept;
+
+} // namespace nntile::kernel::index_select
@@ -0,0 +1,30 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/mask_scalar_causal.hh
+ * Implicit causal mask with scalar
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/kernel/mask_scalar_causal/cpu.hh>
+#include <nntile/defs.h>
+#ifdef NNTILE_USE_CUDA
+#include <nntile/kernel/mask_scalar_causal/cuda.hh>
+#endif // NNTILE_USE_CUDA
+
+//! @namespace nntile::kernel::mask_scalar_causal
+/*! Low-level implementations of mask scalar operation, where the mask is not
+ * stored in memory but evaluated from positions of keys and queries
+ * */
+namespace nntile::kernel::mask_scalar_causal
+{
+
+} // namespace nntile::kernel::mask_scalar_causal
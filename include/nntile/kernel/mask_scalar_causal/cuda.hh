@@ -0,0 +1,28 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/mask_scalar_causal/cuda.hh
+ * Implicit causal mask with scalar on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+#include <cuda_runtime.h>
+
+namespace nntile::kernel::mask_scalar_causal
+{
+
+template<typename T>
+void cuda(cudaStream_t stream, Index m, Index n, Index batch, Index k_start,
+        Index q_start, Index window, Index kv_len, Scalar val, T *data)
+    noexcept;
+
+} // namespace nntile::kernel::mask_scalar_causal
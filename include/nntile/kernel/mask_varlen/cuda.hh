@@ -0,0 +1,28 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/mask_varlen/cuda.hh
+ * Boolean mask of packed sequences on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+#include <cuda_runtime.h>
+
+namespace nntile::kernel::mask_varlen
+{
+
+// Set columns of a boolean mask for queries of a single sequence on CUDA
+void cuda(cudaStream_t stream, Index m, Index n, Index i_lo, Index i_hi,
+        Index diag, bool_t *mask)
+    noexcept;
+
+} // namespace nntile::kernel::mask_varlen
@@ -0,0 +1,26 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/pack_panels.hh
+ * Packing of a matrix into panels of rows
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/kernel/pack_panels/cpu.hh>
+
+//! @namespace nntile::kernel::pack_panels
+/*! Low-level implementations of packing of a matrix into panels of rows,
+ * which is the layout of weights for kernel::gemm_packed
+ * */
+namespace nntile::kernel::pack_panels
+{
+
+} // namespace nntile::kernel::pack_panels
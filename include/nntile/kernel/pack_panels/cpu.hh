@@ -0,0 +1,30 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/pack_panels/cpu.hh
+ * Packing of a matrix into panels of rows on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+
+namespace nntile::kernel::pack_panels
+{
+
+//! Number of rows of a single panel
+constexpr Index PANEL_M = 64;
+
+// Packing of a matrix into panels of rows
+template<typename T>
+void cpu(Index m, Index k, const T *src, T *dst)
+    noexcept;
+
+} // namespace nntile::kernel::pack_panels
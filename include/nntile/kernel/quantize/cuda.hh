@@ -0,0 +1,29 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/quantize/cuda.hh
+ * Symmetric int8 quantization of columns on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+#include <cuda_runtime.h>
+
+namespace nntile::kernel::quantize
+{
+
+// Symmetric int8 quantization of columns
+template<typename T>
+void cuda(cudaStream_t stream, Index m, Index n, const T *src, int8_t *dst,
+        T *scale)
+    noexcept;
+
+} // namespace nntile::kernel::quantize
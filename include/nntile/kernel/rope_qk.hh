@@ -0,0 +1,31 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/rope_qk.hh
+ * Fused in-place rotary positional embedding of queries and keys
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/kernel/rope_qk/cpu.hh>
+#include <nntile/defs.h>
+#ifdef NNTILE_USE_CUDA
+#include <nntile/kernel/rope_qk/cuda.hh>
+#endif // NNTILE_USE_CUDA
+
+//! @namespace nntile::kernel::rope_qk
+/*! Low-level implementations of rotary positional embedding, applied in-place
+ * to queries and keys at once with sines and cosines read directly from
+ * precomputed tables
+ * */
+namespace nntile::kernel::rope_qk
+{
+
+} // namespace nntile::kernel::rope_qk
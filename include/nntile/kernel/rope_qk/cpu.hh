@@ -0,0 +1,28 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/rope_qk/cpu.hh
+ * Fused in-place rotary positional embedding of queries and keys on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+
+namespace nntile::kernel::rope_qk
+{
+
+template<typename T>
+void cpu(Index m, Index seq, Index batch, Index nq, Index nk, Index ld_seq,
+        Index ld_batch, Index sin_ld_seq, bool inverse, const T *sin,
+        const T *cos, T *q, T *k)
+    noexcept;
+
+} // namespace nntile::kernel::rope_qk
@@ -0,0 +1,29 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/sample_topk/cpu.hh
+ * Sample tokens from top-k candidates on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+
+namespace nntile::kernel::sample_topk
+{
+
+// Sample tokens from top-k candidates
+template<typename T>
+void cpu(Index k, Index n, Scalar temperature, Scalar top_p,
+        unsigned long long seed, const T *val, const int64_t *idx,
+        int64_t *dst)
+    noexcept;
+
+} // namespace nntile::kernel::sample_topk
@@ -0,0 +1,29 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/kernel/topk/cuda.hh
+ * Top-k largest elements along the first mode on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+#include <cuda_runtime.h>
+
+namespace nntile::kernel::topk
+{
+
+// Accumulate top-k largest elements of fibers along the first mode
+template<typename T>
+void cuda(cudaStream_t stream, Index m, Index n, Index k, Index offset,
+        bool init, const T *src, T *dst_val, int64_t *dst_idx)
+    noexcept;
+
+} // namespace nntile::kernel::topk
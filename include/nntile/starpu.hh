@@ -16,6 +16,8 @@
 
 // StarPU wrappers for data handles and config
 #include <nntile/starpu/config.hh>
+// Capture and replay of graphs of tasks
+#include <nntile/starpu/graph.hh>
 
 // StarPU wrappers for low-level kernels
 #include <nntile/starpu/accumulate.hh>
@@ -83,6 +85,17 @@
 //#include <nntile/starpu/fp32_to_fp16.hh>
 //#include <nntile/starpu/fp16_to_fp32.hh>
 #include <nntile/starpu/mask_scalar.hh>
+#include <nntile/starpu/mask_scalar_causal.hh>
+#include <nntile/starpu/mask_varlen.hh>
+#include <nntile/starpu/topk.hh>
+#include <nntile/starpu/sample_topk.hh>
+#include <nntile/starpu/quantize.hh>
+#include <nntile/starpu/dequantize.hh>
+#include <nntile/starpu/gemv.hh>
+#include <nntile/starpu/pack_panels.hh>
+#include <nntile/starpu/gemm_packed.hh>
+#include <nntile/starpu/beam_topk.hh>
+#include <nntile/starpu/index_select.hh>
 #include <nntile/starpu/adam_step.hh>
 #include <nntile/starpu/adamw_step.hh>
 #include <nntile/starpu/transpose.hh>
@@ -93,6 +106,7 @@
 #include <nntile/starpu/conv2d_bwd_weight_inplace.hh>
 #include <nntile/starpu/rope.hh>
 #include <nntile/starpu/rope_backward.hh>
+#include <nntile/starpu/rope_qk.hh>
 #include <nntile/starpu/norm_fiber.hh>
 #include <nntile/starpu/log_scalar.hh>
 
@@ -171,6 +185,17 @@ void init()
     //fp32_to_fp16::init();
     //fp16_to_fp32::init();
     mask_scalar::init();
+    mask_scalar_causal::init();
+    mask_varlen::init();
+    topk::init();
+    sample_topk::init();
+    quantize::init();
+    dequantize::init();
+    gemv::init();
+    pack_panels::init();
+    gemm_packed::init();
+    beam_topk::init();
+    index_select::init();
     adam_step::init();
     adamw_step::init();
     transpose::init();
@@ -181,6 +206,7 @@ void init()
     conv2d_bwd_weight_inplace::init();
     rope::init();
     rope_backward::init();
+    rope_qk::init();
     log_scalar::init();
 }
 
@@ -253,6 +279,17 @@ void restrict_where(uint32_t where)
     //fp32_to_fp16::restrict_where(where);
     //fp16_to_fp32::restrict_where(where);
     mask_scalar::restrict_where(where);
+    mask_scalar_causal::restrict_where(where);
+    mask_varlen::restrict_where(where);
+    topk::restrict_where(where);
+    sample_topk::restrict_where(where);
+    quantize::restrict_where(where);
+    dequantize::restrict_where(where);
+    gemv::restrict_where(where);
+    pack_panels::restrict_where(where);
+    gemm_packed::restrict_where(where);
+    beam_topk::restrict_where(where);
+    index_select::restrict_where(where);
     adam_step::restrict_where(where);
     adamw_step::restrict_where(where);
     transpose::restrict_where(where);
@@ -263,6 +300,7 @@ void restrict_where(uint32_t where)
     conv2d_bwd_weight_inplace::restrict_where(where);
     rope::restrict_where(where);
     rope_backward::restrict_where(where);
+    rope_qk::restrict_where(where);
     log_scalar::restrict_where(where);
 }
 
@@ -335,6 +373,17 @@ void restore_where()
     //fp32_to_fp16::restore_where();
     //fp16_to_fp32::restore_where();
     mask_scalar::restore_where();
+    mask_scalar_causal::restore_where();
+    mask_varlen::restore_where();
+    topk::restore_where();
+    sample_topk::restore_where();
+    quantize::restore_where();
+    dequantize::restore_where();
+    gemv::restore_where();
+    pack_panels::restore_where();
+    gemm_packed::restore_where();
+    beam_topk::restore_where();
+    index_select::restore_where();
     adam_step::restore_where();
     adamw_step::restore_where();
     transpose::restore_where();
@@ -345,6 +394,7 @@ void restore_where()
     conv2d_bwd_weight_inplace::restore_where();
     rope::restore_where();
     rope_backward::restore_where();
+    rope_qk::restore_where();
     log_scalar::restore_where();
 }
 
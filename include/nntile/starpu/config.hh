@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <cerrno>
 #include <stdexcept>
 #include <vector>
 #include <memory>
@@ -62,7 +63,8 @@ class Config: public starpu_conf
 public:
     explicit Config(int ncpus_=-1, int ncuda_=-1, int cublas_=-1, int logger=0,
             const char *logger_server_addr="localhost",
-            int logger_server_port=5001, int verbose_=0)
+            int logger_server_port=5001, int verbose_=0,
+            const char *sched_policy="dmda")
     {
         starpu_fxt_autostart_profiling(0);
         // Init StarPU configuration with default values at first
@@ -78,8 +80,11 @@ public:
 #else // NNTILE_USE_CUDA
         ncuda = 0;
 #endif // NNTILE_USE_CUDA
-        // Set history-based scheduler to utilize performance models
-        sched_policy_name = "dmda";
+        // Set scheduler, history-based dmda utilizes performance models,
+        // while dmdas also sorts ready tasks by their priorities (e.g., for
+        // inference). StarPU gives STARPU_SCHED environment variable
+        // precedence over this value.
+        sched_policy_name = sched_policy;
         // Save initial value
         cublas = cublas_;
         // Verbosity level
@@ -145,6 +150,12 @@ public:
     static constexpr starpu_data_access_mode STARPU_RW_COMMUTE
     //    = STARPU_RW; // Temporarily disabled commute mode
         = static_cast<starpu_data_access_mode>(STARPU_RW | STARPU_COMMUTE);
+    //! Priority of tasks, submitted by starpu::*::submit() functions
+    /*! A caller may raise it for a latency-critical group of tasks (e.g., a
+     * decode step of a served request) so that they are executed ahead of
+     * bulk tasks (e.g., a prefill of a long prompt).
+     * */
+    static inline int task_priority = STARPU_DEFAULT_PRIO;
     // Unpack args by pointers without copying actual data
     template<typename... Ts>
     static
@@ -190,15 +201,123 @@ public:
 // Forward declaration
 class HandleLocalData;
 
+//! Task, recorded by a task graph to be built again on every replay
+struct TaskRecord
+{
+    //! Codelet of the task
+    starpu_codelet *cl;
+    //! Data handles and their access modes
+    std::vector<starpu_data_handle_t> handles;
+    std::vector<starpu_data_access_mode> modes;
+    //! Copy of codelet arguments
+    std::vector<char> cl_arg;
+    //! Priority of the task
+    int priority;
+    //! Number of floating point operations
+    double flops;
+};
+
+//! Tasks of a task graph, that is being captured
+/*! See TaskGraph in nntile/starpu/graph.hh
+ * */
+struct TaskCapture
+{
+    //! Submitted tasks in the order of submission
+    std::vector<TaskRecord> tasks;
+    //! Data handles, that were unregistered during capture
+    std::vector<starpu_data_handle_t> unregistered;
+    //! Scratch data handles, released during capture and kept for replays
+    std::vector<starpu_data_handle_t> workspace;
+    //! Record a built task before its submission
+    void record(starpu_task *task)
+    {
+        TaskRecord rec;
+        rec.cl = task->cl;
+        unsigned nbuffers = STARPU_TASK_GET_NBUFFERS(task);
+        rec.handles.reserve(nbuffers);
+        rec.modes.reserve(nbuffers);
+        for(unsigned i = 0; i < nbuffers; ++i)
+        {
+            rec.handles.push_back(STARPU_TASK_GET_HANDLE(task, i));
+            rec.modes.push_back(STARPU_TASK_GET_MODE(task, i));
+        }
+        auto cl_arg = reinterpret_cast<const char *>(task->cl_arg);
+        rec.cl_arg.assign(cl_arg, cl_arg+task->cl_arg_size);
+        rec.priority = task->priority;
+        rec.flops = task->flops;
+        tasks.push_back(std::move(rec));
+    }
+};
+
+//! Task graph being captured or nullptr if tasks are not captured
+inline TaskCapture *task_capture = nullptr;
+
+//! Submit a built task into StarPU pool of tasks
+/*! Same as starpu_task_submit(), but the task is also recorded by a task
+ * graph, that is being captured. The task is executed and destroyed as usual,
+ * while the graph keeps only its codelet, data and arguments.
+ * */
+inline int task_submit(starpu_task *task)
+{
+    if(task_capture == nullptr)
+    {
+        return starpu_task_submit(task);
+    }
+    // Arguments are copied before the task can be executed and destroyed
+    task_capture->record(task);
+    int ret = starpu_task_submit(task);
+    if(ret != 0)
+    {
+        task_capture->tasks.pop_back();
+    }
+    return ret;
+}
+
+//! Insert a task into StarPU pool of tasks
+/*! Drop-in replacement of starpu_task_insert(), used by all
+ * starpu::*::submit() functions. While a task graph is being captured, the
+ * task is built and recorded by the graph, so that it can be built again
+ * without parsing arguments.
+ * */
+template<typename... Args>
+int task_insert(starpu_codelet *cl, Args... args)
+{
+    if(task_capture == nullptr)
+    {
+        return starpu_task_insert(cl, args...);
+    }
+    starpu_task *task = starpu_task_build(cl, args...);
+    if(task == nullptr)
+    {
+        return -EINVAL;
+    }
+    int ret = task_submit(task);
+    if(ret != 0)
+    {
+        task->destroy = 0;
+        starpu_task_destroy(task);
+    }
+    return ret;
+}
+
 //! StarPU data handle as a shared pointer to its internal state
 //
 // This class takes the ownership of the data handle. That said, it unregisters
 // the data handle automatically at the end of lifetime.
 class Handle
 {
+    // Tasks on the unregistered handle shall not be replayed by a task graph
+    static void _capture_unregister(starpu_data_handle_t ptr)
+    {
+        if(task_capture != nullptr)
+        {
+            task_capture->unregistered.push_back(ptr);
+        }
+    }
     // Different deleters for the handle
     static void _deleter(starpu_data_handle_t ptr)
     {
+        _capture_unregister(ptr);
         // Unregister data and bring back result
         // All the tasks using given starpu data handle shall be finished
         // before unregistering the handle
@@ -207,6 +326,7 @@ class Handle
     }
     static void _deleter_no_coherency(starpu_data_handle_t ptr)
     {
+        _capture_unregister(ptr);
         // Unregister data without bringing back result
         // All the tasks using given starpu data handle shall be finished
         // before unregistering the handle
@@ -217,6 +337,13 @@ class Handle
     }
     static void _deleter_temporary(starpu_data_handle_t ptr)
     {
+        // Scratch data of captured tasks becomes a workspace of the task
+        // graph, that unregisters it when the graph is cleared
+        if(task_capture != nullptr)
+        {
+            task_capture->workspace.push_back(ptr);
+            return;
+        }
         // Lazily unregister data as it is defined as temporary and may still
         // be in use. This shall only appear in use for data, allocated by
         // starpu as it will be deallocated during actual unregistering and at
@@ -22,6 +22,21 @@
 namespace nntile::starpu::gemm
 {
 
+//! Operand of a batched gemm, that is shared by a group of gemms
+/*! Index of a gemm in a batch is decomposed as i_inner+inner*(i_group
+ * +group*i_outer). The shared operand does not depend on i_group and
+ * contains only inner*outer matrices. It allows grouped-query attention to
+ * read each K and V matrix once per group instead of repeating them. If the
+ * shared operand is C, then results of the group are accumulated.
+ * */
+enum GroupBcast: int
+{
+    GROUP_BCAST_NONE = 0,
+    GROUP_BCAST_A = 1,
+    GROUP_BCAST_B = 2,
+    GROUP_BCAST_C = 3
+};
+
 //! Structure for arguments
 struct args_t
 {
@@ -33,6 +48,9 @@ struct args_t
     Index batch; // Number of gemms in a batch
     Scalar alpha;
     Scalar beta;
+    Index group_inner; // Number of gemms in a batch before a group
+    Index group_size; // Number of gemms in a group
+    int group_bcast; // Operand shared by a group
 };
 
 #ifdef NNTILE_USE_CBLAS
@@ -294,6 +312,7 @@ void restore_where();
 template<typename T>
 void submit(const TransOp &transA, const TransOp &transB, Index m, Index n,
         Index k, Index batch, Scalar alpha, Handle A, Handle B, Scalar beta,
-        Handle C, int redux=0);
+        Handle C, int redux=0, Index group_inner=1, Index group_size=1,
+        int group_bcast=GROUP_BCAST_NONE);
 
 } // namespace nntile::starpu::gemm
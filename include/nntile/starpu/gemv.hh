@@ -0,0 +1,105 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/starpu/gemv.hh
+ * Matrix times a few vectors, specialized gemm for decoding
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+#include <nntile/constants.hh>
+#include <nntile/starpu/config.hh>
+#include <nntile/defs.h>
+
+namespace nntile::starpu::gemv
+{
+
+//! Maximal number of columns of B, for which gemm is done by gemv tasks
+/*! Such a product (e.g., a linear layer during a decode step) is bound by
+ * reading the matrix A, so tensor::gemm_async submits gemv tasks, that read
+ * A once, instead of generic gemm tasks.
+ * */
+constexpr Index max_n = 8;
+
+//! Structure for arguments
+struct args_t
+{
+    bool transA;
+    Index m;
+    Index n;
+    Index k;
+    Index batch;
+    Scalar alpha;
+    Scalar beta;
+};
+
+// Product of a matrix by a few columns within StarPU buffers on CPU
+template<typename T>
+void cpu(void *buffers[], void *cl_args)
+    noexcept;
+
+extern Codelet codelet_fp32, codelet_fp64, codelet_fp32_fast_tf32, codelet_bf16,
+               codelet_fp32_fast_fp16, codelet_fp32_fast_bf16;
+
+template<typename T>
+constexpr Codelet *codelet()
+{
+    throw std::runtime_error("Non-supported type");
+    return nullptr;
+}
+
+template<>
+constexpr Codelet *codelet<fp32_t>()
+{
+    return &codelet_fp32;
+}
+
+template<>
+constexpr Codelet *codelet<bf16_t>()
+{
+    return &codelet_bf16;
+}
+
+template<>
+constexpr Codelet *codelet<fp32_fast_tf32_t>()
+{
+    return &codelet_fp32_fast_tf32;
+}
+
+template<>
+constexpr Codelet *codelet<fp32_fast_fp16_t>()
+{
+    return &codelet_fp32_fast_fp16;
+}
+
+template<>
+constexpr Codelet *codelet<fp32_fast_bf16_t>()
+{
+    return &codelet_fp32_fast_bf16;
+}
+
+template<>
+constexpr Codelet *codelet<fp64_t>()
+{
+    return &codelet_fp64;
+}
+
+void init();
+
+void restrict_where(uint32_t where);
+
+void restore_where();
+
+template<typename T>
+void submit(const TransOp &transA, Index m, Index n, Index k, Index batch,
+        Scalar alpha, Handle A, Handle B, Scalar beta, Handle C, int redux);
+
+} // namespace nntile::starpu::gemv
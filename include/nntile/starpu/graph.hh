@@ -0,0 +1,95 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/starpu/graph.hh
+ * Capture and replay of a graph of StarPU tasks
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+#include <nntile/starpu/config.hh>
+#include <mutex>
+#include <string>
+#include <condition_variable>
+
+namespace nntile::starpu
+{
+
+//! Graph of tasks, that is captured once and submitted many times
+/*! All the tasks, inserted by starpu::*::submit() functions between
+ * begin_capture() and end_capture(), are executed as usual and recorded by
+ * the graph. Every replay() builds the recorded tasks again on the same data
+ * handles with the same arguments and submits them in the captured order,
+ * skipping parsing of arguments. Replays do not wait for each other.
+ *
+ * Dependencies between tasks of the graph are computed once at the end of
+ * capture from data accesses and declared explicitly on every replay. Only
+ * the accesses of a handle up to its first write and from its last write
+ * keep implicit data dependencies, that order a replay with tasks outside of
+ * the graph, including other replays. Only tasks are replayed: data
+ * registration, invalidation and transfers of the captured code are not
+ * repeated.
+ *
+ * Replays access the same data handles as the captured tasks, so every handle
+ * a graph captures must outlive the graph, or at least its clear(). The only
+ * exception is scratch data (e.g., a STARPU_SCRATCH buffer of indices of
+ * tensor::copy_intersection or tensor::gather), released during capture: the
+ * graph keeps such handles as its own workspace and unregisters them in
+ * clear().
+ * */
+class TaskGraph
+{
+    //! Recorded tasks
+    TaskCapture capture;
+    //! Explicit dependencies of each task on previous tasks of the graph
+    std::vector<std::vector<Index>> deps;
+    //! Sequential consistency of each data access of each task
+    std::vector<std::vector<unsigned char>> seq_consistency;
+    //! Tasks, that no other task of the graph depends on
+    std::vector<Index> sinks;
+    //! Number of replays, that are not finished yet
+    Index nreplays = 0;
+    std::mutex mutex;
+    std::condition_variable finished;
+    //! Callback of the last task of a replay
+    static void _replay_callback(void *graph);
+    //! Build a recorded task
+    starpu_task *_build(Index i);
+public:
+    TaskGraph() = default;
+    TaskGraph(const TaskGraph &) = delete;
+    TaskGraph &operator=(const TaskGraph &) = delete;
+    ~TaskGraph();
+    //! Start capturing tasks, previously captured tasks are dropped
+    void begin_capture();
+    //! Stop capturing tasks
+    /*! Returns false if the captured tasks cannot be replayed, as they
+     * access data, that was unregistered during capture (e.g., temporary
+     * tensors, but not scratch data). Such a graph is left empty, and its
+     * tasks shall be submitted as usual.
+     * */
+    bool end_capture();
+    //! Build and submit all the captured tasks again
+    void replay();
+    //! Wait for all the replays of the captured tasks to finish
+    void wait();
+    //! Drop all the captured tasks and unregister the workspace
+    void clear();
+    //! Number of captured tasks
+    Index size() const
+    {
+        return capture.tasks.size();
+    }
+    //! Number of captured tasks of codelets with a given name prefix
+    Index count(const std::string &prefix) const;
+};
+
+} // namespace nntile::starpu
@@ -0,0 +1,56 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/starpu/mask_varlen.hh
+ * StarPU wrappers for boolean mask of packed sequences
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+#include <nntile/starpu/config.hh>
+#include <nntile/defs.h>
+
+namespace nntile::starpu::mask_varlen
+{
+
+//! Structure for arguments
+struct args_t
+{
+    Index m;
+    Index n;
+    Index offset;
+    Index i_lo;
+    Index i_hi;
+    Index diag;
+};
+
+// Set columns of a boolean mask in StarPU buffer on CPU
+void cpu(void *buffers[], void *cl_args)
+    noexcept;
+
+#ifdef NNTILE_USE_CUDA
+// Set columns of a boolean mask in StarPU buffer on CUDA
+void cuda(void *buffers[], void *cl_args)
+    noexcept;
+#endif // NNTILE_USE_CUDA
+
+extern Codelet codelet;
+
+void init();
+
+void restrict_where(uint32_t where);
+
+void restore_where();
+
+void submit(Index m, Index n, Index offset, Index i_lo, Index i_hi,
+        Index diag, Handle mask);
+
+} // namespace nntile::starpu::mask_varlen
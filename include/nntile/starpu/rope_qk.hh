@@ -0,0 +1,96 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/starpu/rope_qk.hh
+ * Fused in-place rotary positional embedding of queries and keys
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/base_types.hh>
+#include <nntile/starpu/config.hh>
+#include <nntile/defs.h>
+
+namespace nntile::starpu::rope_qk
+{
+
+//! Structure for arguments
+struct args_t
+{
+    Index m;
+    Index seq;
+    Index batch;
+    Index nq;
+    Index nk;
+    Index ld_seq;
+    Index ld_batch;
+    Index sin_ld_seq;
+    Index offset;
+    Index sin_offset;
+    bool inverse;
+};
+
+// StarPU wrapper for kernel::rope_qk::cpu<T>
+template<typename T>
+void cpu(void *buffers[], void *cl_args)
+    noexcept;
+
+#ifdef NNTILE_USE_CUDA
+// StarPU wrapper for kernel::rope_qk::cuda<T>
+template<typename T>
+void cuda(void *buffers[], void *cl_args)
+    noexcept;
+#endif // NNTILE_USE_CUDA
+
+extern Codelet codelet_fp32, codelet_fp64, codelet_fp32_fast_tf32, codelet_bf16;
+
+template<typename T>
+constexpr Codelet *codelet()
+{
+    throw std::runtime_error("Non-supported type");
+    return nullptr;
+}
+
+template<>
+constexpr Codelet *codelet<fp32_t>()
+{
+    return &codelet_fp32;
+}
+
+template<>
+constexpr Codelet *codelet<fp64_t>()
+{
+    return &codelet_fp64;
+}
+
+template<>
+constexpr Codelet *codelet<fp32_fast_tf32_t>()
+{
+    return &codelet_fp32_fast_tf32;
+}
+
+template<>
+constexpr Codelet *codelet<bf16_t>()
+{
+    return &codelet_bf16;
+}
+
+void init();
+
+void restrict_where(uint32_t where);
+
+void restore_where();
+
+template<typename T>
+void submit(Index m, Index seq, Index batch, Index nq, Index nk, Index ld_seq,
+        Index ld_batch, Index sin_ld_seq, Index offset, Index sin_offset,
+        bool inverse, Handle sin, Handle cos, Handle q, Handle k);
+
+} // namespace nntile::starpu::rope_qk
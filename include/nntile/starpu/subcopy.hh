@@ -27,7 +27,7 @@ void cpu(void *buffers[], void *cl_args)
 
 //extern Codelet codelet_fp16;
 extern Codelet codelet_fp32, codelet_fp64, codelet_int64,
-       codelet_bool, codelet_fp32_fast_tf32, codelet_bf16,
+       codelet_bool, codelet_int8, codelet_fp32_fast_tf32, codelet_bf16,
        codelet_fp32_fast_fp16, codelet_fp32_fast_bf16;
 
 template<typename T>
@@ -67,6 +67,12 @@ constexpr Codelet *codelet<bool_t>()
     return &codelet_bool;
 }
 
+template<>
+constexpr Codelet *codelet<int8_t>()
+{
+    return &codelet_int8;
+}
+
 template<>
 constexpr Codelet *codelet<bf16_t>()
 {
@@ -39,6 +39,7 @@
 #include <nntile/tensor/dgelutanh.hh>
 #include <nntile/tensor/drelu.hh>
 #include <nntile/tensor/gemm.hh>
+#include <nntile/tensor/gemm_gqa.hh>
 #include <nntile/tensor/nrm2.hh>
 #include <nntile/tensor/normalize.hh>
 #include <nntile/tensor/prod.hh>
@@ -81,6 +82,18 @@
 //#include <nntile/tensor/fp32_to_fp16.hh>
 //#include <nntile/tensor/fp16_to_fp32.hh>
 #include <nntile/tensor/mask_scalar.hh>
+#include <nntile/tensor/mask_scalar_causal.hh>
+#include <nntile/tensor/mask_varlen.hh>
+#include <nntile/tensor/topk.hh>
+#include <nntile/tensor/sample_topk.hh>
+#include <nntile/tensor/quantize.hh>
+#include <nntile/tensor/dequantize.hh>
+#include <nntile/tensor/pack_panels.hh>
+#include <nntile/tensor/gemm_packed.hh>
+#include <nntile/tensor/beam_topk.hh>
+#include <nntile/tensor/index_select.hh>
+#include <nntile/tensor/set_index.hh>
+#include <nntile/tensor/mask_tile_status.hh>
 #include <nntile/tensor/hypot.hh>
 #include <nntile/tensor/hypot_scalar_inverse.hh>
 #include <nntile/tensor/adam_step.hh>
@@ -93,6 +106,7 @@
 #include <nntile/tensor/conv2d_bwd_weight_inplace.hh>
 #include <nntile/tensor/rope.hh>
 #include <nntile/tensor/rope_backward.hh>
+#include <nntile/tensor/rope_qk.hh>
 #include <nntile/tensor/norm_fiber.hh>
 #include <nntile/tensor/log_scalar.hh>
 
@@ -0,0 +1,32 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/tensor/beam_topk.hh
+ * Top-k largest elements of a tensor for beam search
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/tensor/tensor.hh>
+
+namespace nntile::tensor
+{
+
+// Asynchronous tensor-wise beam search top-k operation
+template<typename T>
+void beam_topk_async(const Tensor<T> &src, const Tensor<T> &dst_val,
+        const Tensor<int64_t> &dst_idx, const Tensor<int64_t> &dst_beam);
+
+// Blocking version of tensor-wise beam search top-k operation
+template<typename T>
+void beam_topk(const Tensor<T> &src, const Tensor<T> &dst_val,
+        const Tensor<int64_t> &dst_idx, const Tensor<int64_t> &dst_beam);
+
+} // namespace nntile::tensor
@@ -0,0 +1,32 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/tensor/dequantize.hh
+ * Dequantization of an int8 tensor along the first axis
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/tensor/tensor.hh>
+
+namespace nntile::tensor
+{
+
+// Asynchronous tensor-wise int8 dequantization
+template<typename T>
+void dequantize_async(const Tensor<int8_t> &src, const Tensor<T> &scale,
+        const Tensor<T> &dst);
+
+// Blocking version of tensor-wise int8 dequantization
+template<typename T>
+void dequantize(const Tensor<int8_t> &src, const Tensor<T> &scale,
+        const Tensor<T> &dst);
+
+} // namespace nntile::tensor
@@ -22,11 +22,13 @@ namespace nntile::tensor
 template<typename T>
 void flash_maxsumexp_async(const Tensor<T> &Q, const Tensor<T> &K,
         const Tensor<bool_t> &mask, const Tensor<T> &maxsumexp,
-        const Tensor<T> &tmp, int redux=0);
+        const Tensor<T> &tmp, int redux=0,
+        const std::vector<int> &mask_tile_status={});
 
 template<typename T>
 void flash_maxsumexp(const Tensor<T> &Q, const Tensor<T> &K,
         const Tensor<bool_t> &mask, const Tensor<T> &maxsumexp,
-        const Tensor<T> &tmp, int redux=0);
+        const Tensor<T> &tmp, int redux=0,
+        const std::vector<int> &mask_tile_status={});
 
 } // namespace nntile::tensor
@@ -23,12 +23,14 @@ template<typename T>
 void flash_softmax_gemm_async(const Tensor<T> &Q, const Tensor<T> &K,
         const Tensor<T> &V, const Tensor<bool_t> &mask,
         const Tensor<T> &maxsumexp, const Tensor<T> &dst,
-        const Tensor<T> &tmp, int redux=0);
+        const Tensor<T> &tmp, int redux=0,
+        const std::vector<int> &mask_tile_status={});
 
 template<typename T>
 void flash_softmax_gemm(const Tensor<T> &Q, const Tensor<T> &K,
         const Tensor<T> &V, const Tensor<bool_t> &mask,
         const Tensor<T> &maxsumexp, const Tensor<T> &dst,
-        const Tensor<T> &tmp, int redux=0);
+        const Tensor<T> &tmp, int redux=0,
+        const std::vector<int> &mask_tile_status={});
 
 } // namespace nntile::tensor
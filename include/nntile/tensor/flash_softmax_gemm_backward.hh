@@ -25,7 +25,8 @@ void flash_softmax_gemm_backward_async(const Tensor<T> &Q, const Tensor<T> &dQ,
         const Tensor<T> &dV, const Tensor<bool_t> &mask,
         const Tensor<T> &maxsumexp, const Tensor<T> &dst_grad,
         const Tensor<T> &tmp, const Tensor<T> &tmp_grad,
-        const Tensor<T> &tmp_sumprod_slice, int redux=0);
+        const Tensor<T> &tmp_sumprod_slice, int redux=0,
+        const std::vector<int> &mask_tile_status={});
 
 template<typename T>
 void flash_softmax_gemm_backward(const Tensor<T> &Q, const Tensor<T> &dQ,
@@ -33,6 +34,7 @@ void flash_softmax_gemm_backward(const Tensor<T> &Q, const Tensor<T> &dQ,
         const Tensor<T> &dV, const Tensor<bool_t> &mask,
         const Tensor<T> &maxsumexp, const Tensor<T> &dst_grad,
         const Tensor<T> &tmp, const Tensor<T> &tmp_grad,
-        const Tensor<T> &tmp_sumprod_slice, int redux=0);
+        const Tensor<T> &tmp_sumprod_slice, int redux=0,
+        const std::vector<int> &mask_tile_status={});
 
 } // namespace nntile::tensor
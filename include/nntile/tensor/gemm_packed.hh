@@ -0,0 +1,35 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/tensor/gemm_packed.hh
+ * Product of a packed tensor by a tensor
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/tensor/tensor.hh>
+#include <nntile/constants.hh>
+
+namespace nntile::tensor
+{
+
+// Asynchronous product of a packed tensor by a tensor
+template<typename T>
+void gemm_packed_async(Scalar alpha, const Tensor<T> &A,
+        const TransOp &transB, const Tensor<T> &B, Scalar beta,
+        const Tensor<T> &C, Index ndim, int redux=0);
+
+// Blocking version of a product of a packed tensor by a tensor
+template<typename T>
+void gemm_packed(Scalar alpha, const Tensor<T> &A, const TransOp &transB,
+        const Tensor<T> &B, Scalar beta, const Tensor<T> &C, Index ndim,
+        int redux=0);
+
+} // namespace nntile::tensor
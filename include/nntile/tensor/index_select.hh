@@ -0,0 +1,32 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/tensor/index_select.hh
+ * Selection of slices of a tensor along an axis by indices
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/tensor/tensor.hh>
+
+namespace nntile::tensor
+{
+
+// Asynchronous tensor-wise selection of slices by indices
+template<typename T>
+void index_select_async(const Tensor<int64_t> &index, const Tensor<T> &src,
+        const Tensor<T> &dst, Index axis);
+
+// Blocking version of tensor-wise selection of slices by indices
+template<typename T>
+void index_select(const Tensor<int64_t> &index, const Tensor<T> &src,
+        const Tensor<T> &dst, Index axis);
+
+} // namespace nntile::tensor
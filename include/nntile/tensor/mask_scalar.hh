@@ -22,11 +22,11 @@ namespace nntile::tensor
 // Asynchronous tensor-wise mask_scalar operation
 template<typename T>
 void mask_scalar_async(const Tensor<bool_t> &mask, Scalar val, const Tensor<T> &A,
-        Index batch_ndim);
+        Index batch_ndim, const std::vector<int> &mask_tile_status={});
 
 // Blocking version of tensor-wise mask_scalar operation
 template<typename T>
 void mask_scalar(const Tensor<bool_t> &mask, Scalar val, const Tensor<T> &A,
-        Index batch_ndim);
+        Index batch_ndim, const std::vector<int> &mask_tile_status={});
 
 } // namespace nntile::tensor
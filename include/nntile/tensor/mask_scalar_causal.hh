@@ -0,0 +1,32 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/tensor/mask_scalar_causal.hh
+ * Implicit causal mask with scalar on tensor
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include "nntile/tensor/tensor.hh"
+
+namespace nntile::tensor
+{
+
+// Asynchronous tensor-wise implicit causal mask operation
+template<typename T>
+void mask_scalar_causal_async(Index offset, Index window, Index kv_len,
+        Scalar val, const Tensor<T> &A, Index batch_ndim);
+
+// Blocking version of tensor-wise implicit causal mask operation
+template<typename T>
+void mask_scalar_causal(Index offset, Index window, Index kv_len, Scalar val,
+        const Tensor<T> &A, Index batch_ndim);
+
+} // namespace nntile::tensor
@@ -0,0 +1,102 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/tensor/mask_tile_status.hh
+ * Per-tile status of a boolean attention mask
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include "nntile/tensor/tensor.hh"
+#include <stdexcept>
+
+namespace nntile::tensor
+{
+
+//! Status of a single tile of a boolean mask
+/*! Attention operations accept an optional vector of statuses, one per tile
+ * of the mask in the order of mask.grid. It allows to skip tasks for tiles
+ * that are entirely masked out (e.g., upper blocks of a causal mask) and to
+ * avoid reading the mask for tiles, where all elements are kept. An empty
+ * vector means every tile is treated as partially masked.
+ * */
+enum MaskTileStatus: int
+{
+    //! All elements of the tile are masked out
+    MASK_TILE_EMPTY = 0,
+    //! Some elements of the tile are masked out
+    MASK_TILE_PARTIAL = 1,
+    //! No element of the tile is masked out
+    MASK_TILE_FULL = 2
+};
+
+//! Check that vector of tile statuses corresponds to a given mask
+inline void mask_tile_status_check(const Tensor<bool_t> &mask,
+        const std::vector<int> &mask_tile_status)
+{
+    if(mask_tile_status.empty())
+    {
+        return;
+    }
+    if(static_cast<Index>(mask_tile_status.size()) != mask.grid.nelems)
+    {
+        throw std::runtime_error("mask_tile_status.size() != "
+                "mask.grid.nelems");
+    }
+    for(auto status: mask_tile_status)
+    {
+        if(status < MASK_TILE_EMPTY or status > MASK_TILE_FULL)
+        {
+            throw std::runtime_error("Invalid value in mask_tile_status");
+        }
+    }
+}
+
+//! Get status of a tile of a mask
+inline int mask_tile_status_get(const Tensor<bool_t> &mask,
+        const std::vector<int> &mask_tile_status,
+        const std::vector<Index> &mask_tile_index)
+{
+    if(mask_tile_status.empty())
+    {
+        return MASK_TILE_PARTIAL;
+    }
+    return mask_tile_status[mask.grid.index_to_linear(mask_tile_index)];
+}
+
+//! Get status of a tile of an implicit causal mask
+/*! Tile covers keys at positions [k_begin, k_end) and queries at positions
+ * [q_begin, q_end). A key is kept for a query if it is not in the future, it
+ * is within the sliding window (if window > 0) and it is not a padding (if
+ * kv_len >= 0).
+ * */
+inline int mask_causal_tile_status(Index k_begin, Index k_end, Index q_begin,
+        Index q_end, Index window, Index kv_len)
+{
+    // All keys are in the future or beyond padding
+    if(k_begin > q_end-1 or (kv_len >= 0 and k_begin >= kv_len))
+    {
+        return MASK_TILE_EMPTY;
+    }
+    // All keys are out of the sliding window
+    if(window > 0 and q_begin-(k_end-1) >= window)
+    {
+        return MASK_TILE_EMPTY;
+    }
+    // All keys are visible for all queries
+    if(k_end-1 <= q_begin and (window <= 0 or q_end-1-k_begin < window)
+            and (kv_len < 0 or k_end <= kv_len))
+    {
+        return MASK_TILE_FULL;
+    }
+    return MASK_TILE_PARTIAL;
+}
+
+} // namespace nntile::tensor
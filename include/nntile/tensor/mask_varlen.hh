@@ -0,0 +1,35 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/tensor/mask_varlen.hh
+ * Boolean mask of packed sequences of variable lengths
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include "nntile/tensor/tensor.hh"
+
+namespace nntile::tensor
+{
+
+// Asynchronous tensor-wise boolean mask of packed sequences
+void mask_varlen_async(const std::vector<Index> &cu_seqlens_k,
+        const std::vector<Index> &cu_seqlens_q, const Tensor<bool_t> &mask);
+
+// Blocking version of tensor-wise boolean mask of packed sequences
+void mask_varlen(const std::vector<Index> &cu_seqlens_k,
+        const std::vector<Index> &cu_seqlens_q, const Tensor<bool_t> &mask);
+
+// Status of every tile of a boolean mask of packed sequences
+std::vector<int> mask_varlen_tile_status(
+        const std::vector<Index> &cu_seqlens_k,
+        const std::vector<Index> &cu_seqlens_q, const TensorTraits &mask);
+
+} // namespace nntile::tensor
@@ -0,0 +1,31 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/tensor/pack_panels.hh
+ * Packing of a matrix into panels of rows
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/tensor/tensor.hh>
+
+namespace nntile::tensor
+{
+
+// Asynchronous tensor-wise packing of matrices into panels of rows
+template<typename T>
+void pack_panels_async(const Tensor<T> &src, const Tensor<T> &dst,
+        Index ndim);
+
+// Blocking version of tensor-wise packing of matrices into panels of rows
+template<typename T>
+void pack_panels(const Tensor<T> &src, const Tensor<T> &dst, Index ndim);
+
+} // namespace nntile::tensor
@@ -0,0 +1,32 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/tensor/quantize.hh
+ * Symmetric int8 quantization of a tensor along the first axis
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/tensor/tensor.hh>
+
+namespace nntile::tensor
+{
+
+// Asynchronous tensor-wise int8 quantization
+template<typename T>
+void quantize_async(const Tensor<T> &src, const Tensor<int8_t> &dst,
+        const Tensor<T> &scale);
+
+// Blocking version of tensor-wise int8 quantization
+template<typename T>
+void quantize(const Tensor<T> &src, const Tensor<int8_t> &dst,
+        const Tensor<T> &scale);
+
+} // namespace nntile::tensor
@@ -0,0 +1,42 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/tensor/rope_qk.hh
+ * Fused in-place rotary positional embedding of queries and keys
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/tensor/tensor.hh>
+
+namespace nntile::tensor
+{
+
+// Tensor<T> in-place RoPE of queries and keys with a position offset
+template<typename T>
+void rope_qk_async(Index offset, const Tensor<T> &sin, const Tensor<T> &cos,
+        const Tensor<T> &q, const Tensor<T> &k);
+
+// Tensor<T> in-place RoPE of queries and keys with a position offset
+template<typename T>
+void rope_qk(Index offset, const Tensor<T> &sin, const Tensor<T> &cos,
+        const Tensor<T> &q, const Tensor<T> &k);
+
+// Tensor<T> in-place backward RoPE of queries and keys with a position offset
+template<typename T>
+void rope_qk_backward_async(Index offset, const Tensor<T> &sin,
+        const Tensor<T> &cos, const Tensor<T> &dq, const Tensor<T> &dk);
+
+// Tensor<T> in-place backward RoPE of queries and keys with a position offset
+template<typename T>
+void rope_qk_backward(Index offset, const Tensor<T> &sin,
+        const Tensor<T> &cos, const Tensor<T> &dq, const Tensor<T> &dk);
+
+} // namespace nntile::tensor
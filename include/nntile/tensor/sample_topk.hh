@@ -0,0 +1,34 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/tensor/sample_topk.hh
+ * Sampling of tokens from top-k candidates of Tensor<T>
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/tensor/tensor.hh>
+
+namespace nntile::tensor
+{
+
+// Asynchronous tensor-wise sampling from top-k candidates
+template<typename T>
+void sample_topk_async(Scalar temperature, Scalar top_p,
+        unsigned long long seed, const Tensor<T> &val,
+        const Tensor<int64_t> &idx, const Tensor<int64_t> &dst);
+
+// Blocking version of tensor-wise sampling from top-k candidates
+template<typename T>
+void sample_topk(Scalar temperature, Scalar top_p, unsigned long long seed,
+        const Tensor<T> &val, const Tensor<int64_t> &idx,
+        const Tensor<int64_t> &dst);
+
+} // namespace nntile::tensor
@@ -0,0 +1,32 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/tensor/set_index.hh
+ * Copy a single index along an axis from one Tensor<T> into another
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/tensor/tensor.hh>
+
+namespace nntile::tensor
+{
+
+// Asynchronous tensor-wise copy of a single index along an axis
+template<typename T>
+void set_index_async(const Tensor<T> &src, Index src_index,
+        const Tensor<T> &dst, Index dst_index, Index axis);
+
+// Blocking version of tensor-wise copy of a single index along an axis
+template<typename T>
+void set_index(const Tensor<T> &src, Index src_index, const Tensor<T> &dst,
+        Index dst_index, Index axis);
+
+} // namespace nntile::tensor
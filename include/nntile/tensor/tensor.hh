@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdlib>
 #include <nntile/tensor/traits.hh>
 #include <nntile/tile/tile.hh>
@@ -80,6 +81,199 @@ public:
         }
         next_tag = last_tag;
     }
+    //! Constructor of a view of leading tiles of another tensor
+    /*! The view consists of the first grid_shape[i] tiles of the parent
+     * tensor along every dimension i. Tiles of the view share StarPU handles
+     * with tiles of the parent tensor, so no data is copied and any update of
+     * the view is an update of the parent. Shape of the view is rounded up to
+     * full tiles, so it is useful for tile-aligned buffers (e.g., KV-cache),
+     * whose valid part is tracked separately.
+     *
+     * @param[in] parent: Tensor to take tiles from
+     * @param[in] grid_shape: Number of leading tiles along every dimension
+     * */
+    explicit Tensor(const Tensor<T> &parent,
+            const std::vector<Index> &grid_shape):
+        TensorTraits(_leading_tiles_shape(parent, grid_shape),
+                parent.basetile_shape),
+        next_tag(parent.next_tag)
+    {
+        tile_traits.reserve(grid.nelems);
+        tile_handles.reserve(grid.nelems);
+        tile_distr.reserve(grid.nelems);
+        for(Index i = 0; i < grid.nelems; ++i)
+        {
+            const auto tile_index = grid.linear_to_index(i);
+            Index j = parent.grid.index_to_linear(tile_index);
+            tile_traits.push_back(parent.tile_traits[j]);
+            tile_handles.push_back(parent.tile_handles[j]);
+            tile_distr.push_back(parent.tile_distr[j]);
+        }
+    }
+    //! Constructor of a view of selected tiles of another tensor
+    /*! Tiles of the view along dimension dim are tiles of the parent tensor
+     * with indices tile_indices (e.g., a block table of a paged KV-cache),
+     * while all the tiles along other dimensions are taken. Tiles are shared
+     * with the parent tensor, so no data is copied. The last tile of the
+     * parent tensor along dimension dim may be smaller than the base tile,
+     * so it can only be selected as the last tile of the view.
+     *
+     * @param[in] parent: Tensor to take tiles from
+     * @param[in] dim: Dimension, along which tiles are selected
+     * @param[in] tile_indices: Indices of tiles along dimension dim
+     * */
+    explicit Tensor(const Tensor<T> &parent, Index dim,
+            const std::vector<Index> &tile_indices):
+        TensorTraits(_selected_tiles_shape(parent, dim, tile_indices),
+                parent.basetile_shape),
+        next_tag(parent.next_tag)
+    {
+        tile_traits.reserve(grid.nelems);
+        tile_handles.reserve(grid.nelems);
+        tile_distr.reserve(grid.nelems);
+        for(Index i = 0; i < grid.nelems; ++i)
+        {
+            auto tile_index = grid.linear_to_index(i);
+            tile_index[dim] = tile_indices[tile_index[dim]];
+            Index j = parent.grid.index_to_linear(tile_index);
+            tile_traits.push_back(parent.tile_traits[j]);
+            tile_handles.push_back(parent.tile_handles[j]);
+            tile_distr.push_back(parent.tile_distr[j]);
+        }
+    }
+    //! Constructor of a view of another tensor with unit dimensions changed
+    /*! The view has the same shape and tiling as the parent tensor, except
+     * for dimensions of size 1, that may be removed or inserted (e.g., to
+     * take keys of shape (n_head, head_size) out of a fused (1, n_head,
+     * head_size) tensor). Layout of every tile stays the same, so tiles are
+     * shared with the parent tensor and no data is copied.
+     *
+     * @param[in] parent: Tensor to take tiles from
+     * @param[in] shape: Shape of the view
+     * @param[in] basetile_shape: Shape of a base tile of the view
+     * */
+    explicit Tensor(const Tensor<T> &parent, const std::vector<Index> &shape,
+            const std::vector<Index> &basetile_shape):
+        TensorTraits(_reshaped_shape(parent, shape, basetile_shape),
+                basetile_shape),
+        tile_distr(parent.tile_distr),
+        next_tag(parent.next_tag)
+    {
+        // Tile grids of the view and the parent differ only by dimensions of
+        // size 1, so tiles are ordered in the same way
+        tile_traits.reserve(grid.nelems);
+        tile_handles.reserve(grid.nelems);
+        for(Index i = 0; i < grid.nelems; ++i)
+        {
+            const auto tile_index = grid.linear_to_index(i);
+            tile_traits.emplace_back(TensorTraits::get_tile_shape(tile_index));
+            tile_handles.push_back(parent.tile_handles[i]);
+        }
+    }
+    //! Shape of a view of a tensor with unit dimensions changed
+    static std::vector<Index> _reshaped_shape(const TensorTraits &parent,
+            const std::vector<Index> &shape,
+            const std::vector<Index> &basetile_shape)
+    {
+        if(shape.size() != basetile_shape.size())
+        {
+            throw std::runtime_error("shape.size() != "
+                    "basetile_shape.size()");
+        }
+        std::vector<Index> parent_shape, parent_basetile, view_shape,
+            view_basetile;
+        for(Index i = 0; i < parent.ndim; ++i)
+        {
+            if(parent.shape[i] != 1)
+            {
+                parent_shape.push_back(parent.shape[i]);
+                parent_basetile.push_back(parent.basetile_shape[i]);
+            }
+        }
+        for(Index i = 0; i < shape.size(); ++i)
+        {
+            if(shape[i] != 1)
+            {
+                view_shape.push_back(shape[i]);
+                view_basetile.push_back(basetile_shape[i]);
+            }
+            else if(basetile_shape[i] != 1)
+            {
+                throw std::runtime_error("Unit dimension of the view must "
+                        "have unit base tile");
+            }
+        }
+        if(parent_shape != view_shape)
+        {
+            throw std::runtime_error("Shapes differ not only by unit "
+                    "dimensions");
+        }
+        if(parent_basetile != view_basetile)
+        {
+            throw std::runtime_error("Base tiles differ not only by unit "
+                    "dimensions");
+        }
+        return shape;
+    }
+    //! Shape of a view of selected tiles of a tensor
+    static std::vector<Index> _selected_tiles_shape(const TensorTraits &parent,
+            Index dim, const std::vector<Index> &tile_indices)
+    {
+        if(dim < 0 or dim >= parent.ndim)
+        {
+            throw std::runtime_error("dim < 0 or dim >= parent.ndim");
+        }
+        if(tile_indices.empty())
+        {
+            throw std::runtime_error("tile_indices is empty");
+        }
+        Index last = parent.grid.shape[dim] - 1;
+        Index leftover = parent.shape[dim] - last*parent.basetile_shape[dim];
+        for(Index i = 0; i < tile_indices.size(); ++i)
+        {
+            Index index = tile_indices[i];
+            if(index < 0 or index > last)
+            {
+                throw std::runtime_error("Tile index is out of bounds");
+            }
+            if(index == last and i+1 < tile_indices.size()
+                    and leftover != parent.basetile_shape[dim])
+            {
+                throw std::runtime_error("Partial tile is not the last one");
+            }
+        }
+        std::vector<Index> shape(parent.shape);
+        shape[dim] = (tile_indices.size()-1) * parent.basetile_shape[dim];
+        if(tile_indices.back() == last)
+        {
+            shape[dim] += leftover;
+        }
+        else
+        {
+            shape[dim] += parent.basetile_shape[dim];
+        }
+        return shape;
+    }
+    //! Shape of a view of leading tiles of a tensor
+    static std::vector<Index> _leading_tiles_shape(const TensorTraits &parent,
+            const std::vector<Index> &grid_shape)
+    {
+        if(grid_shape.size() != parent.ndim)
+        {
+            throw std::runtime_error("grid_shape.size() != parent.ndim");
+        }
+        std::vector<Index> shape(parent.ndim);
+        for(Index i = 0; i < parent.ndim; ++i)
+        {
+            if(grid_shape[i] <= 0 or grid_shape[i] > parent.grid.shape[i])
+            {
+                throw std::runtime_error("Wrong number of leading tiles");
+            }
+            shape[i] = std::min(grid_shape[i]*parent.basetile_shape[i],
+                    parent.shape[i]);
+        }
+        return shape;
+    }
     tile::Tile<T> get_tile(Index linear_offset) const
     {
         if(linear_offset < 0 or linear_offset >= grid.nelems)
@@ -0,0 +1,32 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file include/nntile/tensor/topk.hh
+ * Top-k largest elements along the first axis of Tensor<T>
+ *
+ * @version 1.1.0
+ * */
+
+#pragma once
+
+#include <nntile/tensor/tensor.hh>
+
+namespace nntile::tensor
+{
+
+// Asynchronous tensor-wise top-k operation
+template<typename T>
+void topk_async(const Tensor<T> &src, const Tensor<T> &dst_val,
+        const Tensor<int64_t> &dst_idx);
+
+// Blocking version of tensor-wise top-k operation
+template<typename T>
+void topk(const Tensor<T> &src, const Tensor<T> &dst_val,
+        const Tensor<int64_t> &dst_idx);
+
+} // namespace nntile::tensor
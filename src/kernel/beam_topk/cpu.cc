@@ -0,0 +1,148 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/beam_topk/cpu.cc
+ * Top-k largest elements of a matrix for beam search on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/beam_topk/cpu.hh"
+#include <cmath>
+#include "nntile/kernel/cpu.hh"
+
+namespace nntile::kernel::beam_topk
+{
+
+//! Check if (val1, beam1, idx1) goes before (val2, beam2, idx2)
+template<typename Y>
+static inline
+bool better(Y val1, std::int64_t beam1, std::int64_t idx1, Y val2,
+        std::int64_t beam2, std::int64_t idx2)
+{
+    return val1 > val2 or (val1 == val2 and (beam1 < beam2
+                or (beam1 == beam2 and idx1 < idx2)));
+}
+
+template<typename T>
+void cpu(Index m, Index n, Index k, Index row_offset, Index col_offset,
+        bool init, const T *src, T *dst_val, int64_t *dst_idx_,
+        int64_t *dst_beam_)
+    noexcept
+//! Accumulate top-k largest elements of a matrix with their positions on CPU
+/*! The k largest elements of the m-by-n input array src, that are merged with
+ * the k elements already stored in dst_val, dst_idx and dst_beam, are stored
+ * back into these arrays. Row of src[i,j] is row_offset+i (e.g., a token) and
+ * its column is col_offset+j (e.g., a beam), which allows to reduce over
+ * several tiles of a tensor one after another in any order. Elements are
+ * sorted in descending order and ties are resolved in favor of the smaller
+ * column and then the smaller row. Empty slots of dst are marked by index -1
+ * and NaN inputs are ignored.
+ *
+ * @param[in] m: Number of rows of src array
+ * @param[in] n: Number of columns of src array
+ * @param[in] k: Number of the largest elements to keep
+ * @param[in] row_offset: Row of the first element of src
+ * @param[in] col_offset: Column of the first element of src
+ * @param[in] init: If true, dst arrays are overwritten, otherwise they are
+ *      accumulated
+ * @param[in] src: Input contiguous m-by-n array
+ * @param[inout] dst_val: Array of k largest values
+ * @param[inout] dst_idx_: Array of rows of the largest values
+ * @param[inout] dst_beam_: Array of columns of the largest values
+ * */
+{
+    using Y = typename T::repr_t;
+    auto idx = reinterpret_cast<std::int64_t *>(dst_idx_);
+    auto beam = reinterpret_cast<std::int64_t *>(dst_beam_);
+    // Number of occupied slots
+    Index size = 0;
+    if(init)
+    {
+        for(Index r = 0; r < k; ++r)
+        {
+            idx[r] = -1;
+        }
+    }
+    else
+    {
+        while(size < k and idx[size] >= 0)
+        {
+            ++size;
+        }
+    }
+    for(Index j = 0; j < n; ++j)
+    {
+        std::int64_t vb = col_offset + j;
+        for(Index i = 0; i < m; ++i)
+        {
+            Y v = static_cast<Y>(src[j*m+i]);
+            if(std::isnan(v))
+            {
+                continue;
+            }
+            std::int64_t vi = row_offset + i;
+            if(size == k and not better(v, vb, vi,
+                        static_cast<Y>(dst_val[k-1]), beam[k-1], idx[k-1]))
+            {
+                continue;
+            }
+            Index r = size < k ? size++ : k-1;
+            while(r > 0 and better(v, vb, vi, static_cast<Y>(dst_val[r-1]),
+                        beam[r-1], idx[r-1]))
+            {
+                dst_val[r] = dst_val[r-1];
+                idx[r] = idx[r-1];
+                beam[r] = beam[r-1];
+                --r;
+            }
+            dst_val[r] = static_cast<T>(v);
+            idx[r] = vi;
+            beam[r] = vb;
+        }
+    }
+}
+
+// Explicit instantiation
+template
+void cpu<fp32_t>(Index m, Index n, Index k, Index row_offset, Index col_offset,
+        bool init, const fp32_t *src, fp32_t *dst_val, int64_t *dst_idx,
+        int64_t *dst_beam)
+    noexcept;
+
+template
+void cpu<fp32_fast_tf32_t>(Index m, Index n, Index k, Index row_offset,
+        Index col_offset, bool init, const fp32_fast_tf32_t *src,
+        fp32_fast_tf32_t *dst_val, int64_t *dst_idx, int64_t *dst_beam)
+    noexcept;
+
+template
+void cpu<fp32_fast_fp16_t>(Index m, Index n, Index k, Index row_offset,
+        Index col_offset, bool init, const fp32_fast_fp16_t *src,
+        fp32_fast_fp16_t *dst_val, int64_t *dst_idx, int64_t *dst_beam)
+    noexcept;
+
+template
+void cpu<fp32_fast_bf16_t>(Index m, Index n, Index k, Index row_offset,
+        Index col_offset, bool init, const fp32_fast_bf16_t *src,
+        fp32_fast_bf16_t *dst_val, int64_t *dst_idx, int64_t *dst_beam)
+    noexcept;
+
+template
+void cpu<fp64_t>(Index m, Index n, Index k, Index row_offset, Index col_offset,
+        bool init, const fp64_t *src, fp64_t *dst_val, int64_t *dst_idx,
+        int64_t *dst_beam)
+    noexcept;
+
+template
+void cpu<bf16_t>(Index m, Index n, Index k, Index row_offset, Index col_offset,
+        bool init, const bf16_t *src, bf16_t *dst_val, int64_t *dst_idx,
+        int64_t *dst_beam)
+    noexcept;
+
+} // namespace nntile::kernel::beam_topk
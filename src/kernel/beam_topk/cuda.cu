@@ -0,0 +1,219 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/beam_topk/cuda.cu
+ * Top-k largest elements of a matrix for beam search on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/beam_topk/cuda.hh"
+#include "nntile/kernel/cuda.hh"
+
+namespace nntile::kernel::beam_topk
+{
+
+//! Number of threads of the only block
+static constexpr int BLOCK = 256;
+
+//! Check if (val1, beam1, idx1) goes before (val2, beam2, idx2)
+template<typename Y>
+static __device__
+bool better(Y val1, Index beam1, Index idx1, Y val2, Index beam2, Index idx2)
+{
+    return idx1 >= 0 and (idx2 < 0 or val1 > val2 or (val1 == val2
+                and (beam1 < beam2 or (beam1 == beam2 and idx1 < idx2))));
+}
+
+template<typename T>
+static __global__
+void cuda_kernel(Index m, Index n, Index k, Index row_offset,
+        Index col_offset, bool init, const T *src, T *dst_val, Index *dst_idx,
+        Index *dst_beam)
+//! Accumulate top-k largest elements of a matrix with a single block
+/*! Top-k elements are selected one after another. Each round is a reduction
+ * over all the candidates (elements of src and previously stored elements of
+ * dst) for the best one among those, that go after the element selected at
+ * the previous round. Selected elements are kept in shared memory, as dst is
+ * also read during the selection. Number of beams k is small, so a few passes
+ * over the matrix are cheaper than a sort.
+ * */
+{
+    using Y = typename T::repr_t;
+    int tid = threadIdx.x;
+    __shared__ Y red_val[BLOCK];
+    __shared__ Index red_idx[BLOCK], red_beam[BLOCK];
+    extern __shared__ Index res_idx[];
+    Index *res_beam = res_idx + k;
+    Y *res_val = reinterpret_cast<Y *>(res_beam + k);
+    // Previously selected element
+    Y prev_val = 0.0;
+    Index prev_idx = -1, prev_beam = -1;
+    for(Index r = 0; r < k; ++r)
+    {
+        Y best_val = 0.0;
+        Index best_idx = -1, best_beam = -1;
+        for(Index e = tid; e < m*n; e += BLOCK)
+        {
+            Y v = Y{src[e]};
+            if(::isnan(v))
+            {
+                continue;
+            }
+            Index vi = row_offset + e%m, vb = col_offset + e/m;
+            if((prev_idx < 0 or better(prev_val, prev_beam, prev_idx, v, vb,
+                            vi))
+                    and better(v, vb, vi, best_val, best_beam, best_idx))
+            {
+                best_val = v;
+                best_idx = vi;
+                best_beam = vb;
+            }
+        }
+        if(not init)
+        {
+            for(Index e = tid; e < k; e += BLOCK)
+            {
+                Index vi = dst_idx[e], vb = dst_beam[e];
+                Y v = Y{dst_val[e]};
+                if((prev_idx < 0 or better(prev_val, prev_beam, prev_idx, v,
+                                vb, vi))
+                        and better(v, vb, vi, best_val, best_beam, best_idx))
+                {
+                    best_val = v;
+                    best_idx = vi;
+                    best_beam = vb;
+                }
+            }
+        }
+        red_val[tid] = best_val;
+        red_idx[tid] = best_idx;
+        red_beam[tid] = best_beam;
+        __syncthreads();
+        for(int s = BLOCK/2; s > 0; s /= 2)
+        {
+            if(tid < s and better(red_val[tid+s], red_beam[tid+s],
+                        red_idx[tid+s], red_val[tid], red_beam[tid],
+                        red_idx[tid]))
+            {
+                red_val[tid] = red_val[tid+s];
+                red_idx[tid] = red_idx[tid+s];
+                red_beam[tid] = red_beam[tid+s];
+            }
+            __syncthreads();
+        }
+        prev_val = red_val[0];
+        prev_idx = red_idx[0];
+        prev_beam = red_beam[0];
+        if(tid == 0)
+        {
+            res_val[r] = prev_val;
+            res_idx[r] = prev_idx;
+            res_beam[r] = prev_beam;
+        }
+        __syncthreads();
+        // All the candidates are exhausted, remaining slots are empty
+        if(prev_idx < 0)
+        {
+            for(Index e = r+1+tid; e < k; e += BLOCK)
+            {
+                res_idx[e] = -1;
+            }
+            break;
+        }
+    }
+    __syncthreads();
+    for(Index e = tid; e < k; e += BLOCK)
+    {
+        dst_idx[e] = res_idx[e];
+        if(res_idx[e] >= 0)
+        {
+            dst_val[e] = T{res_val[e]};
+            dst_beam[e] = res_beam[e];
+        }
+    }
+}
+
+template<typename T>
+void cuda(cudaStream_t stream, Index m, Index n, Index k, Index row_offset,
+        Index col_offset, bool init, const T *src, T *dst_val,
+        int64_t *dst_idx_, int64_t *dst_beam_)
+    noexcept
+//! Accumulate top-k largest elements of a matrix with their positions on CUDA
+/*! The k largest elements of the m-by-n input array src, that are merged with
+ * the k elements already stored in dst_val, dst_idx and dst_beam, are stored
+ * back into these arrays. Row of src[i,j] is row_offset+i (e.g., a token) and
+ * its column is col_offset+j (e.g., a beam), which allows to reduce over
+ * several tiles of a tensor one after another in any order. Elements are
+ * sorted in descending order and ties are resolved in favor of the smaller
+ * column and then the smaller row. Empty slots of dst are marked by index -1
+ * and NaN inputs are ignored.
+ *
+ * @param[in] m: Number of rows of src array
+ * @param[in] n: Number of columns of src array
+ * @param[in] k: Number of the largest elements to keep
+ * @param[in] row_offset: Row of the first element of src
+ * @param[in] col_offset: Column of the first element of src
+ * @param[in] init: If true, dst arrays are overwritten, otherwise they are
+ *      accumulated
+ * @param[in] src: Input contiguous m-by-n array
+ * @param[inout] dst_val: Array of k largest values
+ * @param[inout] dst_idx_: Array of rows of the largest values
+ * @param[inout] dst_beam_: Array of columns of the largest values
+ * */
+{
+    using Y = typename T::repr_t;
+    using I = typename CUDAComputeType<int64_t>::value;
+    auto dst_idx = reinterpret_cast<I *>(dst_idx_);
+    auto dst_beam = reinterpret_cast<I *>(dst_beam_);
+    std::size_t shared = k * (2*sizeof(Index)+sizeof(Y));
+    (cuda_kernel<T>)<<<1, BLOCK, shared, stream>>>(m, n, k, row_offset,
+            col_offset, init, src, dst_val, dst_idx, dst_beam);
+}
+
+// Explicit instantiation
+template
+void cuda<fp32_t>(cudaStream_t stream, Index m, Index n, Index k,
+        Index row_offset, Index col_offset, bool init, const fp32_t *src,
+        fp32_t *dst_val, int64_t *dst_idx, int64_t *dst_beam)
+    noexcept;
+
+template
+void cuda<fp32_fast_tf32_t>(cudaStream_t stream, Index m, Index n, Index k,
+        Index row_offset, Index col_offset, bool init,
+        const fp32_fast_tf32_t *src, fp32_fast_tf32_t *dst_val,
+        int64_t *dst_idx, int64_t *dst_beam)
+    noexcept;
+
+template
+void cuda<fp32_fast_fp16_t>(cudaStream_t stream, Index m, Index n, Index k,
+        Index row_offset, Index col_offset, bool init,
+        const fp32_fast_fp16_t *src, fp32_fast_fp16_t *dst_val,
+        int64_t *dst_idx, int64_t *dst_beam)
+    noexcept;
+
+template
+void cuda<fp32_fast_bf16_t>(cudaStream_t stream, Index m, Index n, Index k,
+        Index row_offset, Index col_offset, bool init,
+        const fp32_fast_bf16_t *src, fp32_fast_bf16_t *dst_val,
+        int64_t *dst_idx, int64_t *dst_beam)
+    noexcept;
+
+template
+void cuda<fp64_t>(cudaStream_t stream, Index m, Index n, Index k,
+        Index row_offset, Index col_offset, bool init, const fp64_t *src,
+        fp64_t *dst_val, int64_t *dst_idx, int64_t *dst_beam)
+    noexcept;
+
+template
+void cuda<bf16_t>(cudaStream_t stream, Index m, Index n, Index k,
+        Index row_offset, Index col_offset, bool init, const bf16_t *src,
+        bf16_t *dst_val, int64_t *dst_idx, int64_t *dst_beam)
+    noexcept;
+
+} // namespace nntile::kernel::beam_topk
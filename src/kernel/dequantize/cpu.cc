@@ -0,0 +1,77 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/dequantize/cpu.cc
+ * Dequantization of int8 columns on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/dequantize/cpu.hh"
+#include "nntile/kernel/cpu.hh"
+
+namespace nntile::kernel::dequantize
+{
+
+template<typename T>
+void cpu(Index m, Index n, const int8_t *src_, const T *scale, T *dst)
+    noexcept
+//! Dequantization of int8 columns
+/*! Inverse of the quantize kernel: dst[i,j] = src[i,j] * scale[j].
+ *
+ * @param[in] m: Size of columns
+ * @param[in] n: Number of columns
+ * @param[in] src_: Input contiguous m-by-n array of quantized values
+ * @param[in] scale: Input array of n scales
+ * @param[out] dst: Output contiguous m-by-n array
+ * */
+{
+    using Y = typename T::repr_t;
+    auto src = reinterpret_cast<const std::int8_t *>(src_);
+    for(Index j = 0; j < n; ++j)
+    {
+        Y s = Y{scale[j]};
+        for(Index i = 0; i < m; ++i)
+        {
+            dst[j*m+i] = T{Y(src[j*m+i]) * s};
+        }
+    }
+}
+
+// Explicit instantiation
+template
+void cpu<fp32_t>(Index m, Index n, const int8_t *src, const fp32_t *scale,
+        fp32_t *dst)
+    noexcept;
+
+template
+void cpu<fp32_fast_tf32_t>(Index m, Index n, const int8_t *src,
+        const fp32_fast_tf32_t *scale, fp32_fast_tf32_t *dst)
+    noexcept;
+
+template
+void cpu<fp32_fast_fp16_t>(Index m, Index n, const int8_t *src,
+        const fp32_fast_fp16_t *scale, fp32_fast_fp16_t *dst)
+    noexcept;
+
+template
+void cpu<fp32_fast_bf16_t>(Index m, Index n, const int8_t *src,
+        const fp32_fast_bf16_t *scale, fp32_fast_bf16_t *dst)
+    noexcept;
+
+template
+void cpu<fp64_t>(Index m, Index n, const int8_t *src, const fp64_t *scale,
+        fp64_t *dst)
+    noexcept;
+
+template
+void cpu<bf16_t>(Index m, Index n, const int8_t *src, const bf16_t *scale,
+        bf16_t *dst)
+    noexcept;
+
+} // namespace nntile::kernel::dequantize
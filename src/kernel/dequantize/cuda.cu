@@ -0,0 +1,91 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/dequantize/cuda.cu
+ * Dequantization of int8 columns on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/dequantize/cuda.hh"
+#include "nntile/kernel/cuda.hh"
+
+namespace nntile::kernel::dequantize
+{
+
+template<typename T>
+static __global__
+void cuda_kernel(Index m, Index n, const std::int8_t *src, const T *scale,
+        T *dst)
+//! Dequantize a single element per thread
+{
+    using Y = typename T::repr_t;
+    Index i = threadIdx.x + blockIdx.x*blockDim.x;
+    if(i >= m*n)
+    {
+        return;
+    }
+    dst[i] = T{Y(src[i]) * Y{scale[i/m]}};
+}
+
+template<typename T>
+void cuda(cudaStream_t stream, Index m, Index n, const int8_t *src_,
+        const T *scale, T *dst)
+    noexcept
+//! Dequantization of int8 columns
+/*! Inverse of the quantize kernel: dst[i,j] = src[i,j] * scale[j].
+ *
+ * @param[in] m: Size of columns
+ * @param[in] n: Number of columns
+ * @param[in] src_: Input contiguous m-by-n array of quantized values
+ * @param[in] scale: Input array of n scales
+ * @param[out] dst: Output contiguous m-by-n array
+ * */
+{
+    using I = typename CUDAComputeType<int8_t>::value;
+    auto src = reinterpret_cast<const I *>(src_);
+    dim3 threads(256);
+    dim3 blocks((m*n+threads.x-1)/threads.x);
+    (cuda_kernel<T>)<<<blocks, threads, 0, stream>>>(m, n, src, scale, dst);
+}
+
+// Explicit instantiation
+template
+void cuda<fp32_t>(cudaStream_t stream, Index m, Index n, const int8_t *src,
+        const fp32_t *scale, fp32_t *dst)
+    noexcept;
+
+template
+void cuda<fp32_fast_tf32_t>(cudaStream_t stream, Index m, Index n,
+        const int8_t *src, const fp32_fast_tf32_t *scale,
+        fp32_fast_tf32_t *dst)
+    noexcept;
+
+template
+void cuda<fp32_fast_fp16_t>(cudaStream_t stream, Index m, Index n,
+        const int8_t *src, const fp32_fast_fp16_t *scale,
+        fp32_fast_fp16_t *dst)
+    noexcept;
+
+template
+void cuda<fp32_fast_bf16_t>(cudaStream_t stream, Index m, Index n,
+        const int8_t *src, const fp32_fast_bf16_t *scale,
+        fp32_fast_bf16_t *dst)
+    noexcept;
+
+template
+void cuda<fp64_t>(cudaStream_t stream, Index m, Index n, const int8_t *src,
+        const fp64_t *scale, fp64_t *dst)
+    noexcept;
+
+template
+void cuda<bf16_t>(cudaStream_t stream, Index m, Index n, const int8_t *src,
+        const bf16_t *scale, bf16_t *dst)
+    noexcept;
+
+} // namespace nntile::kernel::dequantize
@@ -0,0 +1,134 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/gemm_packed/cpu.cc
+ * Product of a packed matrix by a matrix on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/gemm_packed/cpu.hh"
+#include "nntile/kernel/pack_panels/cpu.hh"
+#include "nntile/kernel/cpu.hh"
+#include <algorithm>
+
+namespace nntile::kernel::gemm_packed
+{
+
+using kernel::pack_panels::PANEL_M;
+
+//! Number of columns of B, that are multiplied by a panel at once
+static constexpr Index BLOCK_N = 8;
+
+template<typename T>
+void cpu(bool transB, Index m, Index n, Index k, Scalar alpha, const T *A,
+        const T *B, Scalar beta, T *C)
+    noexcept
+//! Product of a packed matrix by a matrix
+/*! Computes C = alpha*A*op(B) + beta*C, where m-by-k matrix A is packed into
+ * panels of rows by kernel::pack_panels, op(B) is k-by-n and C is a
+ * contiguous column-major m-by-n matrix. A panel is multiplied by BLOCK_N
+ * columns of op(B) at a time with partial sums of a PANEL_M-by-BLOCK_N block
+ * of C kept in the compute type. A panel is read sequentially and is reused
+ * from cache for other columns, so A is read from memory once, and no
+ * packing is done on every call, unlike BLAS gemm. If beta is zero, C is
+ * not read.
+ *
+ * @param[in] transB: Whether op(B) is B^T
+ * @param[in] m: Number of rows of A and C
+ * @param[in] n: Number of columns of op(B) and C
+ * @param[in] k: Number of columns of A and rows of op(B)
+ * @param[in] alpha: Scalar factor of the product
+ * @param[in] A: Input packed m-by-k matrix
+ * @param[in] B: Input contiguous matrix, k-by-n if not transposed and n-by-k
+ *      otherwise
+ * @param[in] beta: Scalar factor of C
+ * @param[inout] C: Output contiguous m-by-n matrix
+ * */
+{
+    using Y = typename T::repr_t;
+    Index B_stride_l = transB ? n : 1, B_stride_j = transB ? 1 : k;
+    Y acc[BLOCK_N][PANEL_M];
+    for(Index p0 = 0; p0 < m; p0 += PANEL_M)
+    {
+        Index pm = std::min(PANEL_M, m-p0);
+        const T *panel = A + p0*k;
+        for(Index j0 = 0; j0 < n; j0 += BLOCK_N)
+        {
+            Index bn = std::min(BLOCK_N, n-j0);
+            for(Index j = 0; j < bn; ++j)
+            {
+                for(Index i = 0; i < pm; ++i)
+                {
+                    acc[j][i] = 0;
+                }
+            }
+            for(Index l = 0; l < k; ++l)
+            {
+                const T *panel_col = panel + l*pm;
+                for(Index j = 0; j < bn; ++j)
+                {
+                    Y b = Y{B[l*B_stride_l+(j0+j)*B_stride_j]};
+                    for(Index i = 0; i < pm; ++i)
+                    {
+                        acc[j][i] += Y{panel_col[i]} * b;
+                    }
+                }
+            }
+            for(Index j = 0; j < bn; ++j)
+            {
+                T *C_col = C + (j0+j)*m + p0;
+                for(Index i = 0; i < pm; ++i)
+                {
+                    Y val = Y(alpha) * acc[j][i];
+                    if(beta != 0.0)
+                    {
+                        val += Y(beta) * Y{C_col[i]};
+                    }
+                    C_col[i] = T{val};
+                }
+            }
+        }
+    }
+}
+
+// Explicit instantiation
+template
+void cpu<fp32_t>(bool transB, Index m, Index n, Index k, Scalar alpha,
+        const fp32_t *A, const fp32_t *B, Scalar beta, fp32_t *C)
+    noexcept;
+
+template
+void cpu<fp32_fast_tf32_t>(bool transB, Index m, Index n, Index k,
+        Scalar alpha, const fp32_fast_tf32_t *A, const fp32_fast_tf32_t *B,
+        Scalar beta, fp32_fast_tf32_t *C)
+    noexcept;
+
+template
+void cpu<fp32_fast_fp16_t>(bool transB, Index m, Index n, Index k,
+        Scalar alpha, const fp32_fast_fp16_t *A, const fp32_fast_fp16_t *B,
+        Scalar beta, fp32_fast_fp16_t *C)
+    noexcept;
+
+template
+void cpu<fp32_fast_bf16_t>(bool transB, Index m, Index n, Index k,
+        Scalar alpha, const fp32_fast_bf16_t *A, const fp32_fast_bf16_t *B,
+        Scalar beta, fp32_fast_bf16_t *C)
+    noexcept;
+
+template
+void cpu<fp64_t>(bool transB, Index m, Index n, Index k, Scalar alpha,
+        const fp64_t *A, const fp64_t *B, Scalar beta, fp64_t *C)
+    noexcept;
+
+template
+void cpu<bf16_t>(bool transB, Index m, Index n, Index k, Scalar alpha,
+        const bf16_t *A, const bf16_t *B, Scalar beta, bf16_t *C)
+    noexcept;
+
+} // namespace nntile::kernel::gemm_packed
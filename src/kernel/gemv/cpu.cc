@@ -0,0 +1,180 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/gemv/cpu.cc
+ * Matrix times a few vectors on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/gemv/cpu.hh"
+#include "nntile/kernel/cpu.hh"
+#include <algorithm>
+
+namespace nntile::kernel::gemv
+{
+
+//! Maximal number of columns of B, that are processed by a single pass
+static constexpr Index MAX_N = 8;
+
+//! Number of rows of C, that are accumulated at once for non-transposed A
+static constexpr Index BLOCK_M = 64;
+
+template<typename T>
+static void cpu_notrans(Index m, Index n, Index k, Scalar alpha, const T *A,
+        const T *B, Scalar beta, T *C)
+//! C = alpha*A*B + beta*C, columns of A are read one by one
+{
+    using Y = typename T::repr_t;
+    Y acc[MAX_N][BLOCK_M];
+    for(Index i0 = 0; i0 < m; i0 += BLOCK_M)
+    {
+        Index block_m = std::min(BLOCK_M, m-i0);
+        for(Index j = 0; j < n; ++j)
+        {
+            for(Index i = 0; i < block_m; ++i)
+            {
+                acc[j][i] = 0;
+            }
+        }
+        for(Index l = 0; l < k; ++l)
+        {
+            const T *A_col = A + l*m + i0;
+            for(Index j = 0; j < n; ++j)
+            {
+                Y b = Y{B[j*k+l]};
+                for(Index i = 0; i < block_m; ++i)
+                {
+                    acc[j][i] += Y{A_col[i]} * b;
+                }
+            }
+        }
+        for(Index j = 0; j < n; ++j)
+        {
+            T *C_col = C + j*m + i0;
+            for(Index i = 0; i < block_m; ++i)
+            {
+                Y val = Y(alpha) * acc[j][i];
+                if(beta != 0.0)
+                {
+                    val += Y(beta) * Y{C_col[i]};
+                }
+                C_col[i] = T{val};
+            }
+        }
+    }
+}
+
+template<typename T>
+static void cpu_trans(Index m, Index n, Index k, Scalar alpha, const T *A,
+        const T *B, Scalar beta, T *C)
+//! C = alpha*A^T*B + beta*C, every row of C is a set of dot products
+{
+    using Y = typename T::repr_t;
+    Y acc[MAX_N];
+    for(Index i = 0; i < m; ++i)
+    {
+        const T *A_col = A + i*k;
+        for(Index j = 0; j < n; ++j)
+        {
+            acc[j] = 0;
+        }
+        for(Index l = 0; l < k; ++l)
+        {
+            Y a = Y{A_col[l]};
+            for(Index j = 0; j < n; ++j)
+            {
+                acc[j] += a * Y{B[j*k+l]};
+            }
+        }
+        for(Index j = 0; j < n; ++j)
+        {
+            Y val = Y(alpha) * acc[j];
+            if(beta != 0.0)
+            {
+                val += Y(beta) * Y{C[j*m+i]};
+            }
+            C[j*m+i] = T{val};
+        }
+    }
+}
+
+template<typename T>
+void cpu(bool transA, Index m, Index n, Index k, Scalar alpha, const T *A,
+        const T *B, Scalar beta, T *C)
+    noexcept
+//! Product of a matrix by a matrix with a few columns
+/*! Computes C = alpha*op(A)*B + beta*C for contiguous column-major matrices,
+ * where op(A) is m-by-k, B is k-by-n and C is m-by-n. It is a gemm, that is
+ * efficient only for a small n (e.g., a decode step of a few tokens), as
+ * every element of A is read exactly once for up to MAX_N columns of B and
+ * partial sums are accumulated in the compute type. If beta is zero, C is
+ * not read.
+ *
+ * @param[in] transA: Whether op(A) is A^T
+ * @param[in] m: Number of rows of op(A) and C
+ * @param[in] n: Number of columns of B and C
+ * @param[in] k: Number of columns of op(A) and rows of B
+ * @param[in] alpha: Scalar factor of the product
+ * @param[in] A: Input contiguous matrix, m-by-k if not transposed and k-by-m
+ *      otherwise
+ * @param[in] B: Input contiguous k-by-n matrix
+ * @param[in] beta: Scalar factor of C
+ * @param[inout] C: Output contiguous m-by-n matrix
+ * */
+{
+    // Columns of B are processed by groups of MAX_N
+    for(Index j = 0; j < n; j += MAX_N)
+    {
+        Index group_n = std::min(MAX_N, n-j);
+        if(transA)
+        {
+            cpu_trans<T>(m, group_n, k, alpha, A, B+j*k, beta, C+j*m);
+        }
+        else
+        {
+            cpu_notrans<T>(m, group_n, k, alpha, A, B+j*k, beta, C+j*m);
+        }
+    }
+}
+
+// Explicit instantiation
+template
+void cpu<fp32_t>(bool transA, Index m, Index n, Index k, Scalar alpha,
+        const fp32_t *A, const fp32_t *B, Scalar beta, fp32_t *C)
+    noexcept;
+
+template
+void cpu<fp32_fast_tf32_t>(bool transA, Index m, Index n, Index k,
+        Scalar alpha, const fp32_fast_tf32_t *A, const fp32_fast_tf32_t *B,
+        Scalar beta, fp32_fast_tf32_t *C)
+    noexcept;
+
+template
+void cpu<fp32_fast_fp16_t>(bool transA, Index m, Index n, Index k,
+        Scalar alpha, const fp32_fast_fp16_t *A, const fp32_fast_fp16_t *B,
+        Scalar beta, fp32_fast_fp16_t *C)
+    noexcept;
+
+template
+void cpu<fp32_fast_bf16_t>(bool transA, Index m, Index n, Index k,
+        Scalar alpha, const fp32_fast_bf16_t *A, const fp32_fast_bf16_t *B,
+        Scalar beta, fp32_fast_bf16_t *C)
+    noexcept;
+
+template
+void cpu<fp64_t>(bool transA, Index m, Index n, Index k, Scalar alpha,
+        const fp64_t *A, const fp64_t *B, Scalar beta, fp64_t *C)
+    noexcept;
+
+template
+void cpu<bf16_t>(bool transA, Index m, Index n, Index k, Scalar alpha,
+        const bf16_t *A, const bf16_t *B, Scalar beta, bf16_t *C)
+    noexcept;
+
+} // namespace nntile::kernel::gemv
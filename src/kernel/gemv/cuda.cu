@@ -0,0 +1,189 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/gemv/cuda.cu
+ * Matrix times a few vectors on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/gemv/cuda.hh"
+#include "nntile/kernel/cuda.hh"
+#include <algorithm>
+
+namespace nntile::kernel::gemv
+{
+
+//! Maximal number of columns of B, that are processed by a single pass
+static constexpr Index MAX_N = 8;
+
+template<typename T>
+static __global__
+void cuda_kernel_notrans(Index m, Index n, Index k, Scalar alpha, const T *A,
+        const T *B, Scalar beta, T *C)
+//! A single row of C per thread, reads of A are coalesced along columns
+{
+    using Y = typename T::repr_t;
+    Index i = threadIdx.x + blockIdx.x*blockDim.x;
+    if(i >= m)
+    {
+        return;
+    }
+    Y acc[MAX_N];
+    for(Index j = 0; j < n; ++j)
+    {
+        acc[j] = 0;
+    }
+    for(Index l = 0; l < k; ++l)
+    {
+        Y a = Y{A[l*m+i]};
+        for(Index j = 0; j < n; ++j)
+        {
+            acc[j] += a * Y{B[j*k+l]};
+        }
+    }
+    for(Index j = 0; j < n; ++j)
+    {
+        Y val = Y(alpha) * acc[j];
+        if(beta != 0.0)
+        {
+            val += Y(beta) * Y{C[j*m+i]};
+        }
+        C[j*m+i] = T{val};
+    }
+}
+
+template<typename T>
+static __global__
+void cuda_kernel_trans(Index m, Index n, Index k, Scalar alpha, const T *A,
+        const T *B, Scalar beta, T *C)
+//! A single row of C per warp, that reads a column of A
+{
+    using Y = typename T::repr_t;
+    Index i = threadIdx.y + blockIdx.x*blockDim.y;
+    // All the threads of a warp share the same row
+    if(i >= m)
+    {
+        return;
+    }
+    A += i*k;
+    Y acc[MAX_N];
+    for(Index j = 0; j < n; ++j)
+    {
+        acc[j] = 0;
+    }
+    for(Index l = threadIdx.x; l < k; l += blockDim.x)
+    {
+        Y a = Y{A[l]};
+        for(Index j = 0; j < n; ++j)
+        {
+            acc[j] += a * Y{B[j*k+l]};
+        }
+    }
+    for(Index j = 0; j < n; ++j)
+    {
+        for(int offset = blockDim.x/2; offset > 0; offset /= 2)
+        {
+            acc[j] += __shfl_xor_sync(0xffffffff, acc[j], offset);
+        }
+    }
+    if(threadIdx.x == 0)
+    {
+        for(Index j = 0; j < n; ++j)
+        {
+            Y val = Y(alpha) * acc[j];
+            if(beta != 0.0)
+            {
+                val += Y(beta) * Y{C[j*m+i]};
+            }
+            C[j*m+i] = T{val};
+        }
+    }
+}
+
+template<typename T>
+void cuda(cudaStream_t stream, bool transA, Index m, Index n, Index k,
+        Scalar alpha, const T *A, const T *B, Scalar beta, T *C)
+    noexcept
+//! Product of a matrix by a matrix with a few columns
+/*! Computes C = alpha*op(A)*B + beta*C for contiguous column-major matrices,
+ * where op(A) is m-by-k, B is k-by-n and C is m-by-n. It is a gemm, that is
+ * efficient only for a small n (e.g., a decode step of a few tokens), as
+ * every element of A is read exactly once for up to MAX_N columns of B and
+ * partial sums are accumulated in the compute type. If beta is zero, C is
+ * not read.
+ *
+ * @param[in] transA: Whether op(A) is A^T
+ * @param[in] m: Number of rows of op(A) and C
+ * @param[in] n: Number of columns of B and C
+ * @param[in] k: Number of columns of op(A) and rows of B
+ * @param[in] alpha: Scalar factor of the product
+ * @param[in] A: Input contiguous matrix, m-by-k if not transposed and k-by-m
+ *      otherwise
+ * @param[in] B: Input contiguous k-by-n matrix
+ * @param[in] beta: Scalar factor of C
+ * @param[inout] C: Output contiguous m-by-n matrix
+ * */
+{
+    // Columns of B are processed by groups of MAX_N
+    for(Index j = 0; j < n; j += MAX_N)
+    {
+        Index group_n = std::min(MAX_N, n-j);
+        if(transA)
+        {
+            // A warp per row of C
+            dim3 threads(32, 8);
+            dim3 blocks((m+threads.y-1)/threads.y);
+            (cuda_kernel_trans<T>)<<<blocks, threads, 0, stream>>>(m,
+                    group_n, k, alpha, A, B+j*k, beta, C+j*m);
+        }
+        else
+        {
+            dim3 threads(256);
+            dim3 blocks((m+threads.x-1)/threads.x);
+            (cuda_kernel_notrans<T>)<<<blocks, threads, 0, stream>>>(m,
+                    group_n, k, alpha, A, B+j*k, beta, C+j*m);
+        }
+    }
+}
+
+// Explicit instantiation
+template
+void cuda<fp32_t>(cudaStream_t stream, bool transA, Index m, Index n, Index k,
+        Scalar alpha, const fp32_t *A, const fp32_t *B, Scalar beta, fp32_t *C)
+    noexcept;
+
+template
+void cuda<fp32_fast_tf32_t>(cudaStream_t stream, bool transA, Index m, Index n,
+        Index k, Scalar alpha, const fp32_fast_tf32_t *A,
+        const fp32_fast_tf32_t *B, Scalar beta, fp32_fast_tf32_t *C)
+    noexcept;
+
+template
+void cuda<fp32_fast_fp16_t>(cudaStream_t stream, bool transA, Index m, Index n,
+        Index k, Scalar alpha, const fp32_fast_fp16_t *A,
+        const fp32_fast_fp16_t *B, Scalar beta, fp32_fast_fp16_t *C)
+    noexcept;
+
+template
+void cuda<fp32_fast_bf16_t>(cudaStream_t stream, bool transA, Index m, Index n,
+        Index k, Scalar alpha, const fp32_fast_bf16_t *A,
+        const fp32_fast_bf16_t *B, Scalar beta, fp32_fast_bf16_t *C)
+    noexcept;
+
+template
+void cuda<fp64_t>(cudaStream_t stream, bool transA, Index m, Index n, Index k,
+        Scalar alpha, const fp64_t *A, const fp64_t *B, Scalar beta, fp64_t *C)
+    noexcept;
+
+template
+void cuda<bf16_t>(cudaStream_t stream, bool transA, Index m, Index n, Index k,
+        Scalar alpha, const bf16_t *A, const bf16_t *B, Scalar beta, bf16_t *C)
+    noexcept;
+
+} // namespace nntile::kernel::gemv
@@ -0,0 +1,95 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/index_select/cpu.cc
+ * Selection of slices along an axis by indices on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/index_select/cpu.hh"
+#include "nntile/kernel/cpu.hh"
+
+namespace nntile::kernel::index_select
+{
+
+template<typename T>
+void cpu(Index m, Index n, Index k, Index src_n, const int64_t *index_,
+        const T *src, T *dst)
+    noexcept
+//! Gather slices of an array along the middle mode by indices on CPU
+/*! Slices of the m-by-src_n-by-k input array src along its middle mode are
+ * gathered into the m-by-n-by-k output array dst, i.e., dst[i,j,l] is
+ * src[i,index[j],l]. The same slice may be selected several times (e.g., to
+ * copy a cache of a beam into several beams). Indices must be within
+ * [0,src_n).
+ *
+ * @param[in] m: Size of the first mode of src and dst arrays
+ * @param[in] n: Size of the middle mode of dst array and of index array
+ * @param[in] k: Size of the last mode of src and dst arrays
+ * @param[in] src_n: Size of the middle mode of src array
+ * @param[in] index_: Indices of slices of src
+ * @param[in] src: Input contiguous m-by-src_n-by-k array
+ * @param[out] dst: Output contiguous m-by-n-by-k array
+ * */
+{
+    auto index = reinterpret_cast<const std::int64_t *>(index_);
+    for(Index l = 0; l < k; ++l)
+    {
+        for(Index j = 0; j < n; ++j)
+        {
+            const T *src_slice = src + (l*src_n+index[j])*m;
+            T *dst_slice = dst + (l*n+j)*m;
+            for(Index i = 0; i < m; ++i)
+            {
+                dst_slice[i] = src_slice[i];
+            }
+        }
+    }
+}
+
+// Explicit instantiation
+template
+void cpu<fp32_t>(Index m, Index n, Index k, Index src_n, const int64_t *index,
+        const fp32_t *src, fp32_t *dst)
+    noexcept;
+
+template
+void cpu<fp32_fast_tf32_t>(Index m, Index n, Index k, Index src_n,
+        const int64_t *index, const fp32_fast_tf32_t *src,
+        fp32_fast_tf32_t *dst)
+    noexcept;
+
+template
+void cpu<fp32_fast_fp16_t>(Index m, Index n, Index k, Index src_n,
+        const int64_t *index, const fp32_fast_fp16_t *src,
+        fp32_fast_fp16_t *dst)
+    noexcept;
+
+template
+void cpu<fp32_fast_bf16_t>(Index m, Index n, Index k, Index src_n,
+        const int64_t *index, const fp32_fast_bf16_t *src,
+        fp32_fast_bf16_t *dst)
+    noexcept;
+
+template
+void cpu<fp64_t>(Index m, Index n, Index k, Index src_n, const int64_t *index,
+        const fp64_t *src, fp64_t *dst)
+    noexcept;
+
+template
+void cpu<bf16_t>(Index m, Index n, Index k, Index src_n, const int64_t *index,
+        const bf16_t *src, bf16_t *dst)
+    noexcept;
+
+template
+void cpu<int64_t>(Index m, Index n, Index k, Index src_n, const int64_t *index,
+        const int64_t *src, int64_t *dst)
+    noexcept;
+
+} // namespace nntile::kernel::index_select
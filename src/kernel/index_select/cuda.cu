@@ -0,0 +1,105 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/index_select/cuda.cu
+ * Selection of slices along an axis by indices on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/index_select/cuda.hh"
+#include "nntile/kernel/cuda.hh"
+
+namespace nntile::kernel::index_select
+{
+
+template<typename T>
+static __global__
+void cuda_kernel(Index m, Index n, Index k, Index src_n, const Index *index,
+        const T *src, T *dst)
+//! Gather slices of an array along the middle mode, a thread per element
+{
+    Index e = threadIdx.x + blockIdx.x*blockDim.x;
+    if(e < m*n*k)
+    {
+        Index i = e % m;
+        Index j = (e / m) % n;
+        Index l = e / (m*n);
+        dst[e] = src[(l*src_n+index[j])*m+i];
+    }
+}
+
+template<typename T>
+void cuda(cudaStream_t stream, Index m, Index n, Index k, Index src_n,
+        const int64_t *index_, const T *src, T *dst)
+    noexcept
+//! Gather slices of an array along the middle mode by indices on CUDA
+/*! Slices of the m-by-src_n-by-k input array src along its middle mode are
+ * gathered into the m-by-n-by-k output array dst, i.e., dst[i,j,l] is
+ * src[i,index[j],l]. The same slice may be selected several times (e.g., to
+ * copy a cache of a beam into several beams). Indices must be within
+ * [0,src_n).
+ *
+ * @param[in] m: Size of the first mode of src and dst arrays
+ * @param[in] n: Size of the middle mode of dst array and of index array
+ * @param[in] k: Size of the last mode of src and dst arrays
+ * @param[in] src_n: Size of the middle mode of src array
+ * @param[in] index_: Indices of slices of src
+ * @param[in] src: Input contiguous m-by-src_n-by-k array
+ * @param[out] dst: Output contiguous m-by-n-by-k array
+ * */
+{
+    using I = typename CUDAComputeType<int64_t>::value;
+    auto index = reinterpret_cast<const I *>(index_);
+    Index nelems = m * n * k;
+    dim3 threads(256);
+    dim3 blocks((nelems+threads.x-1)/threads.x);
+    (cuda_kernel<T>)<<<blocks, threads, 0, stream>>>(m, n, k, src_n, index,
+            src, dst);
+}
+
+// Explicit instantiation
+template
+void cuda<fp32_t>(cudaStream_t stream, Index m, Index n, Index k, Index src_n,
+        const int64_t *index, const fp32_t *src, fp32_t *dst)
+    noexcept;
+
+template
+void cuda<fp32_fast_tf32_t>(cudaStream_t stream, Index m, Index n, Index k,
+        Index src_n, const int64_t *index, const fp32_fast_tf32_t *src,
+        fp32_fast_tf32_t *dst)
+    noexcept;
+
+template
+void cuda<fp32_fast_fp16_t>(cudaStream_t stream, Index m, Index n, Index k,
+        Index src_n, const int64_t *index, const fp32_fast_fp16_t *src,
+        fp32_fast_fp16_t *dst)
+    noexcept;
+
+template
+void cuda<fp32_fast_bf16_t>(cudaStream_t stream, Index m, Index n, Index k,
+        Index src_n, const int64_t *index, const fp32_fast_bf16_t *src,
+        fp32_fast_bf16_t *dst)
+    noexcept;
+
+template
+void cuda<fp64_t>(cudaStream_t stream, Index m, Index n, Index k, Index src_n,
+        const int64_t *index, const fp64_t *src, fp64_t *dst)
+    noexcept;
+
+template
+void cuda<bf16_t>(cudaStream_t stream, Index m, Index n, Index k, Index src_n,
+        const int64_t *index, const bf16_t *src, bf16_t *dst)
+    noexcept;
+
+template
+void cuda<int64_t>(cudaStream_t stream, Index m, Index n, Index k, Index src_n,
+        const int64_t *index, const int64_t *src, int64_t *dst)
+    noexcept;
+
+} // namespace nntile::kernel::index_select
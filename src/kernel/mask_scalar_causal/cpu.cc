@@ -0,0 +1,111 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/mask_scalar_causal/cpu.cc
+ * Implicit causal mask with scalar on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/mask_scalar_causal/cpu.hh"
+#include "nntile/kernel/cpu.hh"
+
+namespace nntile::kernel::mask_scalar_causal
+{
+
+template<typename T>
+void cpu(Index m, Index n, Index batch, Index k_start, Index q_start,
+        Index window, Index kv_len, Scalar val_, T *data)
+    noexcept
+//! Set masked out entries of attention scores to a given value on CPU
+/*! The mask is not read from memory, it is evaluated from absolute positions
+ * of keys and queries. Element data[i,j,b] corresponds to the key at position
+ * k=k_start+i and the query at position q=q_start+j. It is set to val if
+ * any of the following holds:
+ *      k > q (causality),
+ *      window > 0 and q-k >= window (sliding window),
+ *      kv_len >= 0 and k >= kv_len (padding of keys).
+ *
+ * @params[in] m: Number of keys
+ * @params[in] n: Number of queries
+ * @params[in] batch: Number of m by n matrices
+ * @params[in] k_start: Position of the first key
+ * @params[in] q_start: Position of the first query
+ * @params[in] window: Size of sliding window or 0 to disable it
+ * @params[in] kv_len: Number of valid keys or -1 to disable padding
+ * @params[in] val_: value to set if mask element is false
+ * @params[inout] data: m by n by batch array, whose elements are updated
+ * */
+{
+    using Y = typename T::repr_t;
+    const T val = static_cast<T>(Y{val_});
+    for(Index j = 0; j < n; ++j)
+    {
+        Index q = q_start + j;
+        // Keys in range [k_lo, k_hi) are kept
+        Index k_hi = q + 1;
+        if(kv_len >= 0 and kv_len < k_hi)
+        {
+            k_hi = kv_len;
+        }
+        Index k_lo = 0;
+        if(window > 0)
+        {
+            k_lo = q - window + 1;
+        }
+        // Convert to local indices of keys
+        Index i_lo = k_lo - k_start, i_hi = k_hi - k_start;
+        if(i_lo < 0)
+        {
+            i_lo = 0;
+        }
+        if(i_hi > m)
+        {
+            i_hi = m;
+        }
+        if(i_hi < i_lo)
+        {
+            i_hi = i_lo;
+        }
+        for(Index b = 0; b < batch; ++b)
+        {
+            T *col = data + (b*n+j)*m;
+            for(Index i = 0; i < i_lo; ++i)
+            {
+                col[i] = val;
+            }
+            for(Index i = i_hi; i < m; ++i)
+            {
+                col[i] = val;
+            }
+        }
+    }
+}
+
+// Explicit instantiation
+template
+void cpu<fp32_t>(Index m, Index n, Index batch, Index k_start, Index q_start,
+        Index window, Index kv_len, Scalar val, fp32_t *data)
+    noexcept;
+
+template
+void cpu<fp64_t>(Index m, Index n, Index batch, Index k_start, Index q_start,
+        Index window, Index kv_len, Scalar val, fp64_t *data)
+    noexcept;
+
+template
+void cpu<fp32_fast_tf32_t>(Index m, Index n, Index batch, Index k_start, Index q_start,
+        Index window, Index kv_len, Scalar val, fp32_fast_tf32_t *data)
+    noexcept;
+
+template
+void cpu<bf16_t>(Index m, Index n, Index batch, Index k_start, Index q_start,
+        Index window, Index kv_len, Scalar val, bf16_t *data)
+    noexcept;
+
+} // namespace nntile::kernel::mask_scalar_causal
@@ -0,0 +1,107 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/mask_scalar_causal/cuda.cu
+ * Implicit causal mask with scalar on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/mask_scalar_causal/cuda.hh"
+#include "nntile/kernel/cuda.hh"
+
+namespace nntile::kernel::mask_scalar_causal
+{
+
+template<typename T>
+static __global__
+void cuda_kernel(Index m, Index n, Index batch, Index k_start, Index q_start,
+        Index window, Index kv_len, Scalar val_, T *data)
+{
+    Index i = threadIdx.x + blockIdx.x*blockDim.x;
+    Index j = blockIdx.y;
+    using Y = typename T::repr_t;
+    const T val = static_cast<T>(static_cast<Y>(val_));
+    if(i < m)
+    {
+        Index k = k_start + i;
+        Index q = q_start + j;
+        bool masked = (k > q) or (window > 0 and q-k >= window)
+            or (kv_len >= 0 and k >= kv_len);
+        if(masked)
+        {
+            for(Index b = 0; b < batch; ++b)
+            {
+                data[(b*n+j)*m+i] = val;
+            }
+        }
+    }
+}
+
+template<typename T>
+void cuda(cudaStream_t stream, Index m, Index n, Index batch, Index k_start,
+        Index q_start, Index window, Index kv_len, Scalar val, T *data)
+    noexcept
+//! Set masked out entries of attention scores to a given value on CUDA
+/*! See description of the CPU version of the kernel.
+ *
+ * @params[in] m: Number of keys
+ * @params[in] n: Number of queries
+ * @params[in] batch: Number of m by n matrices
+ * @params[in] k_start: Position of the first key
+ * @params[in] q_start: Position of the first query
+ * @params[in] window: Size of sliding window or 0 to disable it
+ * @params[in] kv_len: Number of valid keys or -1 to disable padding
+ * @params[in] val: value to set if mask element is false
+ * @params[inout] data: m by n by batch array, whose elements are updated
+ * */
+{
+    dim3 threads(256);
+    dim3 blocks((m+255)/256, n);
+    (cuda_kernel<T>)<<<blocks, threads, 0, stream>>>(m, n, batch, k_start,
+            q_start, window, kv_len, val, data);
+}
+
+// Explicit instantiation
+template
+void cuda<fp32_t>(cudaStream_t stream, Index m, Index n, Index batch,
+        Index k_start, Index q_start, Index window, Index kv_len, Scalar val,
+        fp32_t *data)
+    noexcept;
+
+template
+void cuda<fp32_fast_tf32_t>(cudaStream_t stream, Index m, Index n, Index batch,
+        Index k_start, Index q_start, Index window, Index kv_len, Scalar val,
+        fp32_fast_tf32_t *data)
+    noexcept;
+
+template
+void cuda<fp32_fast_fp16_t>(cudaStream_t stream, Index m, Index n, Index batch,
+        Index k_start, Index q_start, Index window, Index kv_len, Scalar val,
+        fp32_fast_fp16_t *data)
+    noexcept;
+
+template
+void cuda<fp32_fast_bf16_t>(cudaStream_t stream, Index m, Index n, Index batch,
+        Index k_start, Index q_start, Index window, Index kv_len, Scalar val,
+        fp32_fast_bf16_t *data)
+    noexcept;
+
+template
+void cuda<fp64_t>(cudaStream_t stream, Index m, Index n, Index batch,
+        Index k_start, Index q_start, Index window, Index kv_len, Scalar val,
+        fp64_t *data)
+    noexcept;
+
+template
+void cuda<bf16_t>(cudaStream_t stream, Index m, Index n, Index batch,
+        Index k_start, Index q_start, Index window, Index kv_len, Scalar val,
+        bf16_t *data)
+    noexcept;
+
+} // namespace nntile::kernel::mask_scalar_causal
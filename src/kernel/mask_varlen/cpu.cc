@@ -0,0 +1,75 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/mask_varlen/cpu.cc
+ * Boolean mask of packed sequences on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/mask_varlen/cpu.hh"
+
+namespace nntile::kernel::mask_varlen
+{
+
+void cpu(Index m, Index n, Index i_lo, Index i_hi, Index diag, bool_t *mask)
+    noexcept
+//! Set columns of a boolean mask for queries of a single sequence on CPU
+/*! All queries of the m by n column-major mask belong to the same sequence,
+ * whose keys are rows [i_lo, i_hi). Element mask[i,j] is set to true if
+ * i_lo <= i < i_hi and i <= j+diag, and to false otherwise. So keys of other
+ * sequences and keys in the future of the query are masked out. Indices i_lo,
+ * i_hi and diag may point outside of the buffer.
+ *
+ * @params[in] m: Number of keys
+ * @params[in] n: Number of queries
+ * @params[in] i_lo: First key of the sequence
+ * @params[in] i_hi: Key after the last key of the sequence
+ * @params[in] diag: Shift of the causal diagonal
+ * @params[out] mask: m by n array of mask values
+ * */
+{
+    const bool_t val_true(true), val_false(false);
+    Index lo = i_lo < 0 ? 0 : i_lo;
+    if(lo > m)
+    {
+        lo = m;
+    }
+    for(Index j = 0; j < n; ++j)
+    {
+        // Keys in range [lo, hi) are kept
+        Index hi = j + diag + 1;
+        if(hi > i_hi)
+        {
+            hi = i_hi;
+        }
+        if(hi > m)
+        {
+            hi = m;
+        }
+        if(hi < lo)
+        {
+            hi = lo;
+        }
+        bool_t *col = mask + j*m;
+        for(Index i = 0; i < lo; ++i)
+        {
+            col[i] = val_false;
+        }
+        for(Index i = lo; i < hi; ++i)
+        {
+            col[i] = val_true;
+        }
+        for(Index i = hi; i < m; ++i)
+        {
+            col[i] = val_false;
+        }
+    }
+}
+
+} // namespace nntile::kernel::mask_varlen
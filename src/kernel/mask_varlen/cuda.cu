@@ -0,0 +1,54 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/mask_varlen/cuda.cu
+ * Boolean mask of packed sequences on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/mask_varlen/cuda.hh"
+#include "nntile/kernel/cuda.hh"
+
+namespace nntile::kernel::mask_varlen
+{
+
+static __global__
+void cuda_kernel(Index m, Index n, Index i_lo, Index i_hi, Index diag,
+        bool_t *mask)
+{
+    Index i = threadIdx.x + blockIdx.x*blockDim.x;
+    Index j = blockIdx.y;
+    if(i < m)
+    {
+        bool keep = i >= i_lo and i < i_hi and i <= j+diag;
+        mask[j*m+i] = bool_t(keep);
+    }
+}
+
+void cuda(cudaStream_t stream, Index m, Index n, Index i_lo, Index i_hi,
+        Index diag, bool_t *mask)
+    noexcept
+//! Set columns of a boolean mask for queries of a single sequence on CUDA
+/*! See description of the CPU version of the kernel.
+ *
+ * @params[in] m: Number of keys
+ * @params[in] n: Number of queries
+ * @params[in] i_lo: First key of the sequence
+ * @params[in] i_hi: Key after the last key of the sequence
+ * @params[in] diag: Shift of the causal diagonal
+ * @params[out] mask: m by n array of mask values
+ * */
+{
+    dim3 threads(256);
+    dim3 blocks((m+255)/256, n);
+    (cuda_kernel)<<<blocks, threads, 0, stream>>>(m, n, i_lo, i_hi, diag,
+            mask);
+}
+
+} // namespace nntile::kernel::mask_varlen
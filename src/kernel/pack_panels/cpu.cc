@@ -0,0 +1,80 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/pack_panels/cpu.cc
+ * Packing of a matrix into panels of rows on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/pack_panels/cpu.hh"
+#include "nntile/kernel/cpu.hh"
+#include <algorithm>
+
+namespace nntile::kernel::pack_panels
+{
+
+template<typename T>
+void cpu(Index m, Index k, const T *src, T *dst)
+    noexcept
+//! Packing of a matrix into panels of rows
+/*! Rows of a contiguous column-major m-by-k matrix are split into panels of
+ * PANEL_M rows (the last one may be smaller). Panels are stored one after
+ * another, while every panel is stored as a contiguous column-major matrix,
+ * i.e., element (i,l) of the panel p0=i-i%PANEL_M, that has pm rows, goes to
+ * dst[p0*k+l*pm+i-p0]. A product by a packed matrix reads it sequentially.
+ *
+ * @param[in] m: Number of rows
+ * @param[in] k: Number of columns
+ * @param[in] src: Input contiguous m-by-k matrix
+ * @param[out] dst: Output packed matrix of the same size
+ * */
+{
+    for(Index p0 = 0; p0 < m; p0 += PANEL_M)
+    {
+        Index pm = std::min(PANEL_M, m-p0);
+        T *panel = dst + p0*k;
+        for(Index l = 0; l < k; ++l)
+        {
+            for(Index i = 0; i < pm; ++i)
+            {
+                panel[l*pm+i] = src[l*m+p0+i];
+            }
+        }
+    }
+}
+
+// Explicit instantiation
+template
+void cpu<fp32_t>(Index m, Index k, const fp32_t *src, fp32_t *dst)
+    noexcept;
+
+template
+void cpu<fp32_fast_tf32_t>(Index m, Index k, const fp32_fast_tf32_t *src,
+        fp32_fast_tf32_t *dst)
+    noexcept;
+
+template
+void cpu<fp32_fast_fp16_t>(Index m, Index k, const fp32_fast_fp16_t *src,
+        fp32_fast_fp16_t *dst)
+    noexcept;
+
+template
+void cpu<fp32_fast_bf16_t>(Index m, Index k, const fp32_fast_bf16_t *src,
+        fp32_fast_bf16_t *dst)
+    noexcept;
+
+template
+void cpu<fp64_t>(Index m, Index k, const fp64_t *src, fp64_t *dst)
+    noexcept;
+
+template
+void cpu<bf16_t>(Index m, Index k, const bf16_t *src, bf16_t *dst)
+    noexcept;
+
+} // namespace nntile::kernel::pack_panels
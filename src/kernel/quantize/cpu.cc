@@ -0,0 +1,94 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/quantize/cpu.cc
+ * Symmetric int8 quantization of columns on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/quantize/cpu.hh"
+#include <cmath>
+#include <algorithm>
+#include "nntile/kernel/cpu.hh"
+
+namespace nntile::kernel::quantize
+{
+
+template<typename T>
+void cpu(Index m, Index n, const T *src, int8_t *dst_, T *scale)
+    noexcept
+//! Symmetric int8 quantization of columns
+/*! Every column of a contiguous m-by-n matrix is quantized independently:
+ * scale[j] = max_i |src[i,j]| / 127 and dst[i,j] = round(src[i,j]/scale[j]).
+ * Scale is rounded to the type T before quantization, so that dequantization
+ * with the stored scale reproduces the values as close as possible. A zero
+ * column gets a zero scale.
+ *
+ * @param[in] m: Size of columns
+ * @param[in] n: Number of columns
+ * @param[in] src: Input contiguous m-by-n array
+ * @param[out] dst_: Output contiguous m-by-n array of quantized values
+ * @param[out] scale: Output array of n scales
+ * */
+{
+    using Y = typename T::repr_t;
+    auto dst = reinterpret_cast<std::int8_t *>(dst_);
+    for(Index j = 0; j < n; ++j)
+    {
+        const T *src_col = src + j*m;
+        std::int8_t *dst_col = dst + j*m;
+        Y amax = 0.0;
+        for(Index i = 0; i < m; ++i)
+        {
+            amax = std::max(amax, std::fabs(Y{src_col[i]}));
+        }
+        scale[j] = T{amax / Y{127}};
+        Y s = Y{scale[j]};
+        Y inv = s > 0 ? Y{1} / s : Y{0};
+        for(Index i = 0; i < m; ++i)
+        {
+            Y q = std::nearbyint(Y{src_col[i]} * inv);
+            q = std::min(std::max(q, Y{-127}), Y{127});
+            dst_col[i] = static_cast<std::int8_t>(q);
+        }
+    }
+}
+
+// Explicit instantiation
+template
+void cpu<fp32_t>(Index m, Index n, const fp32_t *src, int8_t *dst,
+        fp32_t *scale)
+    noexcept;
+
+template
+void cpu<fp32_fast_tf32_t>(Index m, Index n, const fp32_fast_tf32_t *src,
+        int8_t *dst, fp32_fast_tf32_t *scale)
+    noexcept;
+
+template
+void cpu<fp32_fast_fp16_t>(Index m, Index n, const fp32_fast_fp16_t *src,
+        int8_t *dst, fp32_fast_fp16_t *scale)
+    noexcept;
+
+template
+void cpu<fp32_fast_bf16_t>(Index m, Index n, const fp32_fast_bf16_t *src,
+        int8_t *dst, fp32_fast_bf16_t *scale)
+    noexcept;
+
+template
+void cpu<fp64_t>(Index m, Index n, const fp64_t *src, int8_t *dst,
+        fp64_t *scale)
+    noexcept;
+
+template
+void cpu<bf16_t>(Index m, Index n, const bf16_t *src, int8_t *dst,
+        bf16_t *scale)
+    noexcept;
+
+} // namespace nntile::kernel::quantize
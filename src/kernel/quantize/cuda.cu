@@ -0,0 +1,116 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/quantize/cuda.cu
+ * Symmetric int8 quantization of columns on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/quantize/cuda.hh"
+#include "nntile/kernel/cuda.hh"
+
+namespace nntile::kernel::quantize
+{
+
+template<typename T>
+static __global__
+void cuda_kernel(Index m, Index n, const T *src, std::int8_t *dst, T *scale)
+//! Quantize a single column per warp
+{
+    using Y = typename T::repr_t;
+    Index j = threadIdx.y + blockIdx.x*blockDim.y;
+    // All the threads of a warp share the same column
+    if(j >= n)
+    {
+        return;
+    }
+    src += j*m;
+    dst += j*m;
+    Y amax = 0.0;
+    for(Index i = threadIdx.x; i < m; i += blockDim.x)
+    {
+        amax = ::fmax(amax, ::fabs(Y{src[i]}));
+    }
+    for(int offset = blockDim.x/2; offset > 0; offset /= 2)
+    {
+        amax = ::fmax(amax, __shfl_xor_sync(0xffffffff, amax, offset));
+    }
+    T scale_val{amax / Y{127}};
+    if(threadIdx.x == 0)
+    {
+        scale[j] = scale_val;
+    }
+    Y s = Y{scale_val};
+    Y inv = s > 0 ? Y{1} / s : Y{0};
+    for(Index i = threadIdx.x; i < m; i += blockDim.x)
+    {
+        Y q = ::rint(Y{src[i]} * inv);
+        q = ::fmin(::fmax(q, Y{-127}), Y{127});
+        dst[i] = static_cast<std::int8_t>(q);
+    }
+}
+
+template<typename T>
+void cuda(cudaStream_t stream, Index m, Index n, const T *src, int8_t *dst_,
+        T *scale)
+    noexcept
+//! Symmetric int8 quantization of columns
+/*! Every column of a contiguous m-by-n matrix is quantized independently:
+ * scale[j] = max_i |src[i,j]| / 127 and dst[i,j] = round(src[i,j]/scale[j]).
+ * Scale is rounded to the type T before quantization, so that dequantization
+ * with the stored scale reproduces the values as close as possible. A zero
+ * column gets a zero scale.
+ *
+ * @param[in] m: Size of columns
+ * @param[in] n: Number of columns
+ * @param[in] src: Input contiguous m-by-n array
+ * @param[out] dst_: Output contiguous m-by-n array of quantized values
+ * @param[out] scale: Output array of n scales
+ * */
+{
+    using I = typename CUDAComputeType<int8_t>::value;
+    auto dst = reinterpret_cast<I *>(dst_);
+    // A warp per column
+    dim3 threads(32, 8);
+    dim3 blocks((n+threads.y-1)/threads.y);
+    (cuda_kernel<T>)<<<blocks, threads, 0, stream>>>(m, n, src, dst, scale);
+}
+
+// Explicit instantiation
+template
+void cuda<fp32_t>(cudaStream_t stream, Index m, Index n, const fp32_t *src,
+        int8_t *dst, fp32_t *scale)
+    noexcept;
+
+template
+void cuda<fp32_fast_tf32_t>(cudaStream_t stream, Index m, Index n,
+        const fp32_fast_tf32_t *src, int8_t *dst, fp32_fast_tf32_t *scale)
+    noexcept;
+
+template
+void cuda<fp32_fast_fp16_t>(cudaStream_t stream, Index m, Index n,
+        const fp32_fast_fp16_t *src, int8_t *dst, fp32_fast_fp16_t *scale)
+    noexcept;
+
+template
+void cuda<fp32_fast_bf16_t>(cudaStream_t stream, Index m, Index n,
+        const fp32_fast_bf16_t *src, int8_t *dst, fp32_fast_bf16_t *scale)
+    noexcept;
+
+template
+void cuda<fp64_t>(cudaStream_t stream, Index m, Index n, const fp64_t *src,
+        int8_t *dst, fp64_t *scale)
+    noexcept;
+
+template
+void cuda<bf16_t>(cudaStream_t stream, Index m, Index n, const bf16_t *src,
+        int8_t *dst, bf16_t *scale)
+    noexcept;
+
+} // namespace nntile::kernel::quantize
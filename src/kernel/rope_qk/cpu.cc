@@ -0,0 +1,107 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/rope_qk/cpu.cc
+ * Fused in-place rotary positional embedding of queries and keys on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/rope_qk/cpu.hh"
+#include "nntile/kernel/cpu.hh"
+
+namespace nntile::kernel::rope_qk
+{
+
+template<typename T>
+void cpu(Index m, Index seq, Index batch, Index nq, Index nk, Index ld_seq,
+        Index ld_batch, Index sin_ld_seq, bool inverse, const T *sin,
+        const T *cos, T *q, T *k)
+    noexcept
+/*! Rotate pairs of elements of q and k in-place by angles from sin and cos
+ * tables. Tensor q is a 2m-by-ld_seq-by-ld_batch-by-nq array and k is a
+ * 2m-by-ld_seq-by-ld_batch-by-nk array, but only their first seq positions
+ * and batch batches (starting at provided pointers) are updated. Tables sin
+ * and cos are m-by-sin_ld_seq-by-batch arrays (only their leading extents
+ * are needed), and their pointers correspond to the first position to be
+ * used. This way a position offset
+ * (e.g., size of a KV-cache) is applied without copying the tables.
+ *  q[2i,s,b,j] = cos[i,s,b] * q[2i,s,b,j] - sin[i,s,b] * q[2i+1,s,b,j]
+ *  q[2i+1,s,b,j] = sin[i,s,b] * q[2i,s,b,j] + cos[i,s,b] * q[2i+1,s,b,j]
+ * and the same for k. If inverse is true, then the sine is negated, which
+ * provides the backward pass.
+ *
+ * @param[in] m: Number of pairs of elements to rotate
+ * @param[in] seq: Number of positions to update
+ * @param[in] batch: Number of batches to update
+ * @param[in] nq: Number of heads of q
+ * @param[in] nk: Number of heads of k
+ * @param[in] ld_seq: Leading extent of the position mode of q and k
+ * @param[in] ld_batch: Leading extent of the batch mode of q and k
+ * @param[in] sin_ld_seq: Leading extent of the position mode of tables
+ * @param[in] inverse: Whether to rotate by negated angles
+ * @param[in] sin: Input sine table
+ * @param[in] cos: Input cosine table
+ * @param[inout] q: Queries to be rotated
+ * @param[inout] k: Keys to be rotated
+ * */
+{
+    using Y = typename T::repr_t;
+    const Y sign = inverse ? Y{-1} : Y{1};
+    Index head_stride = 2 * m * ld_seq * ld_batch;
+    for(Index b = 0; b < batch; ++b)
+    {
+        for(Index s = 0; s < seq; ++s)
+        {
+            const T *sin_fiber = sin + m*(s+b*sin_ld_seq);
+            const T *cos_fiber = cos + m*(s+b*sin_ld_seq);
+            Index offset = 2 * m * (s+b*ld_seq);
+            for(Index j = 0; j < nq+nk; ++j)
+            {
+                T *fiber = j < nq ? q + offset + j*head_stride
+                    : k + offset + (j-nq)*head_stride;
+                for(Index i = 0; i < m; ++i)
+                {
+                    Y c{cos_fiber[i]}, sn{sin_fiber[i]};
+                    sn *= sign;
+                    Y a{fiber[2*i]}, d{fiber[2*i+1]};
+                    fiber[2*i] = static_cast<T>(c*a - sn*d);
+                    fiber[2*i+1] = static_cast<T>(sn*a + c*d);
+                }
+            }
+        }
+    }
+}
+
+// Explicit instantiation
+template
+void cpu<fp32_t>(Index m, Index seq, Index batch, Index nq, Index nk,
+        Index ld_seq, Index ld_batch, Index sin_ld_seq, bool inverse,
+        const fp32_t *sin, const fp32_t *cos, fp32_t *q, fp32_t *k)
+    noexcept;
+
+template
+void cpu<fp64_t>(Index m, Index seq, Index batch, Index nq, Index nk,
+        Index ld_seq, Index ld_batch, Index sin_ld_seq, bool inverse,
+        const fp64_t *sin, const fp64_t *cos, fp64_t *q, fp64_t *k)
+    noexcept;
+
+template
+void cpu<fp32_fast_tf32_t>(Index m, Index seq, Index batch, Index nq, Index nk,
+        Index ld_seq, Index ld_batch, Index sin_ld_seq, bool inverse,
+        const fp32_fast_tf32_t *sin, const fp32_fast_tf32_t *cos,
+        fp32_fast_tf32_t *q, fp32_fast_tf32_t *k)
+    noexcept;
+
+template
+void cpu<bf16_t>(Index m, Index seq, Index batch, Index nq, Index nk,
+        Index ld_seq, Index ld_batch, Index sin_ld_seq, bool inverse,
+        const bf16_t *sin, const bf16_t *cos, bf16_t *q, bf16_t *k)
+    noexcept;
+
+} // namespace nntile::kernel::rope_qk
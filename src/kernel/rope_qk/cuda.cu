@@ -0,0 +1,93 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/rope_qk/cuda.cu
+ * Fused in-place rotary positional embedding of queries and keys on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/rope_qk/cuda.hh"
+#include "nntile/kernel/cuda.hh"
+
+namespace nntile::kernel::rope_qk
+{
+
+template<typename T>
+static __global__
+void cuda_kernel(Index m, Index seq, Index batch, Index nq, Index nk,
+        Index ld_seq, Index ld_batch, Index sin_ld_seq, bool inverse,
+        const T *sin, const T *cos, T *q, T *k)
+//! Rotate a single pair of elements of q or k, see rope_qk::cpu<T>
+{
+    Index idx = threadIdx.x + Index(blockIdx.x)*blockDim.x;
+    if(idx < m*seq*batch*(nq+nk))
+    {
+        using Y = typename T::repr_t;
+        Index i = idx % m;
+        Index s = (idx/m) % seq;
+        Index b = (idx/(m*seq)) % batch;
+        Index j = idx / (m*seq*batch);
+        Index table = i + m*(s+b*sin_ld_seq);
+        Y c{cos[table]}, sn{sin[table]};
+        if(inverse)
+        {
+            sn = -sn;
+        }
+        Index offset = 2 * (i+m*(s+b*ld_seq));
+        Index head_stride = 2 * m * ld_seq * ld_batch;
+        T *fiber = j < nq ? q + offset + j*head_stride
+            : k + offset + (j-nq)*head_stride;
+        Y a{fiber[0]}, d{fiber[1]};
+        fiber[0] = static_cast<T>(c*a - sn*d);
+        fiber[1] = static_cast<T>(sn*a + c*d);
+    }
+}
+
+template<typename T>
+void cuda(cudaStream_t stream, Index m, Index seq, Index batch, Index nq,
+        Index nk, Index ld_seq, Index ld_batch, Index sin_ld_seq, bool inverse,
+        const T *sin, const T *cos, T *q, T *k)
+    noexcept
+{
+    Index total = m * seq * batch * (nq+nk);
+    dim3 blocks((total+255)/256), threads(256);
+    cuda_kernel<T><<<blocks, threads, 0, stream>>>(m, seq, batch, nq, nk,
+            ld_seq, ld_batch, sin_ld_seq, inverse, sin, cos, q, k);
+}
+
+// Explicit instantiation
+template
+void cuda<fp32_t>(cudaStream_t stream, Index m, Index seq, Index batch,
+        Index nq, Index nk, Index ld_seq, Index ld_batch, Index sin_ld_seq,
+        bool inverse, const fp32_t *sin, const fp32_t *cos, fp32_t *q,
+        fp32_t *k)
+    noexcept;
+
+template
+void cuda<fp64_t>(cudaStream_t stream, Index m, Index seq, Index batch,
+        Index nq, Index nk, Index ld_seq, Index ld_batch, Index sin_ld_seq,
+        bool inverse, const fp64_t *sin, const fp64_t *cos, fp64_t *q,
+        fp64_t *k)
+    noexcept;
+
+template
+void cuda<fp32_fast_tf32_t>(cudaStream_t stream, Index m, Index seq,
+        Index batch, Index nq, Index nk, Index ld_seq, Index ld_batch,
+        Index sin_ld_seq, bool inverse, const fp32_fast_tf32_t *sin,
+        const fp32_fast_tf32_t *cos, fp32_fast_tf32_t *q, fp32_fast_tf32_t *k)
+    noexcept;
+
+template
+void cuda<bf16_t>(cudaStream_t stream, Index m, Index seq, Index batch,
+        Index nq, Index nk, Index ld_seq, Index ld_batch, Index sin_ld_seq,
+        bool inverse, const bf16_t *sin, const bf16_t *cos, bf16_t *q,
+        bf16_t *k)
+    noexcept;
+
+} // namespace nntile::kernel::rope_qk
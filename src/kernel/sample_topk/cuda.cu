@@ -0,0 +1,160 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/sample_topk/cuda.cu
+ * Sample tokens from top-k candidates on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/sample_topk/cuda.hh"
+#include <algorithm>
+#include "nntile/kernel/cuda.hh"
+
+namespace nntile::kernel::sample_topk
+{
+
+//! Uniform random number in [0,1) for a given seed and counter (splitmix64)
+static __device__ inline
+double uniform(unsigned long long seed, Index counter)
+{
+    unsigned long long z = seed + (counter+1)*0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+    return (z >> 11) * 0x1.0p-53;
+}
+
+template<typename T>
+static __global__
+void cuda_kernel(Index k, Index n, Scalar temperature, Scalar top_p,
+        unsigned long long seed, const T *val_, const Index *idx_, Index *dst)
+//! Sample a token of a single column per thread
+{
+    using Y = typename T::repr_t;
+    Index j = threadIdx.x + blockIdx.x*blockDim.x;
+    if(j >= n)
+    {
+        return;
+    }
+    const T *val = val_ + j*k;
+    const Index *idx = idx_ + j*k;
+    dst += j;
+    Index ncand = 0;
+    while(ncand < k and idx[ncand] >= 0)
+    {
+        ++ncand;
+    }
+    if(ncand <= 1 or temperature <= 0)
+    {
+        *dst = idx[0];
+        return;
+    }
+    // Unnormalized probabilities, relative to the largest value
+    Y max_val = Y{val[0]};
+    Y total = 0.0;
+    for(Index r = 0; r < ncand; ++r)
+    {
+        total += ::exp((Y{val[r]}-max_val) / temperature);
+    }
+    // Nucleus of candidates
+    Y nucleus = 0.0;
+    Index nkeep = 0;
+    while(nkeep < ncand and (nkeep == 0 or nucleus < top_p*total))
+    {
+        nucleus += ::exp((Y{val[nkeep]}-max_val) / temperature);
+        ++nkeep;
+    }
+    // Sample within the nucleus
+    Y u = uniform(seed, j) * nucleus;
+    Y cumsum = 0.0;
+    Index r = 0;
+    for(; r < nkeep-1; ++r)
+    {
+        cumsum += ::exp((Y{val[r]}-max_val) / temperature);
+        if(u < cumsum)
+        {
+            break;
+        }
+    }
+    *dst = idx[r];
+}
+
+template<typename T>
+void cuda(cudaStream_t stream, Index k, Index n, Scalar temperature,
+        Scalar top_p, unsigned long long seed, const T *val,
+        const int64_t *idx_, int64_t *dst_)
+    noexcept
+//! Sample tokens from top-k candidates
+/*! Candidates of a column j are given by the k-by-n arrays val and idx, as
+ * produced by the topk kernel: values are sorted in descending order and
+ * empty slots are marked by index -1. Probability of a candidate is
+ * proportional to exp(val/temperature). If top_p < 1, only the smallest
+ * prefix of candidates with the total probability of at least top_p is kept.
+ * Chosen index is stored into dst[j]. If temperature is not positive, the
+ * first (the largest) candidate is taken. Random numbers are obtained by a
+ * counter-based generator from the seed and the column index, so the result
+ * does not depend on the device.
+ *
+ * @param[in] k: Number of candidates per column
+ * @param[in] n: Number of columns
+ * @param[in] temperature: Temperature of sampling
+ * @param[in] top_p: Threshold of the cumulative probability
+ * @param[in] seed: Random seed
+ * @param[in] val: Contiguous k-by-n array of values of candidates
+ * @param[in] idx_: Contiguous k-by-n array of indices of candidates
+ * @param[out] dst_: Array of n sampled indices
+ * */
+{
+    using I = typename CUDAComputeType<int64_t>::value;
+    auto idx = reinterpret_cast<const I *>(idx_);
+    auto dst = reinterpret_cast<I *>(dst_);
+    dim3 threads(std::min(n, Index(256)));
+    dim3 blocks((n+threads.x-1)/threads.x);
+    (cuda_kernel<T>)<<<blocks, threads, 0, stream>>>(k, n, temperature,
+            top_p, seed, val, idx, dst);
+}
+
+// Explicit instantiation
+template
+void cuda<fp32_t>(cudaStream_t stream, Index k, Index n, Scalar temperature,
+        Scalar top_p, unsigned long long seed, const fp32_t *val,
+        const int64_t *idx, int64_t *dst)
+    noexcept;
+
+template
+void cuda<fp32_fast_tf32_t>(cudaStream_t stream, Index k, Index n,
+        Scalar temperature, Scalar top_p, unsigned long long seed,
+        const fp32_fast_tf32_t *val, const int64_t *idx, int64_t *dst)
+    noexcept;
+
+template
+void cuda<fp32_fast_fp16_t>(cudaStream_t stream, Index k, Index n,
+        Scalar temperature, Scalar top_p, unsigned long long seed,
+        const fp32_fast_fp16_t *val, const int64_t *idx, int64_t *dst)
+    noexcept;
+
+template
+void cuda<fp32_fast_bf16_t>(cudaStream_t stream, Index k, Index n,
+        Scalar temperature, Scalar top_p, unsigned long long seed,
+        const fp32_fast_bf16_t *val, const int64_t *idx, int64_t *dst)
+    noexcept;
+
+template
+void cuda<fp64_t>(cudaStream_t stream, Index k, Index n, Scalar temperature,
+        Scalar top_p, unsigned long long seed, const fp64_t *val,
+        const int64_t *idx, int64_t *dst)
+    noexcept;
+
+template
+void cuda<bf16_t>(cudaStream_t stream, Index k, Index n, Scalar temperature,
+        Scalar top_p, unsigned long long seed, const bf16_t *val,
+        const int64_t *idx, int64_t *dst)
+    noexcept;
+
+} // namespace nntile::kernel::sample_topk
@@ -130,6 +130,12 @@ void cpu<bool_t>(Index ndim, const Index *src_start, const Index *src_stride,
         const Index *dst_stride, bool_t *dst, int64_t *tmp_index)
     noexcept;
 
+template
+void cpu<int8_t>(Index ndim, const Index *src_start, const Index *src_stride,
+        const Index *copy_shape, const int8_t *src, const Index *dst_start,
+        const Index *dst_stride, int8_t *dst, int64_t *tmp_index)
+    noexcept;
+
 template
 void cpu<bf16_t>(Index ndim, const Index *src_start, const Index *src_stride,
         const Index *copy_shape, const bf16_t *src, const Index *dst_start,
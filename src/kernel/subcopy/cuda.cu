@@ -241,4 +241,10 @@ void cuda<bool_t>(cudaStream_t stream, Index ndim, const Index *src_start,
         const Index *dst_start, const Index *dst_stride, bool_t *dst_)
     noexcept;
 
+template
+void cuda<int8_t>(cudaStream_t stream, Index ndim, const Index *src_start,
+        const Index *src_stride, const Index *copy_shape, const int8_t *src_,
+        const Index *dst_start, const Index *dst_stride, int8_t *dst_)
+    noexcept;
+
 } // namespace nntile::kernel::subcopy
@@ -0,0 +1,131 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/topk/cpu.cc
+ * Top-k largest elements along the first mode on CPU
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/topk/cpu.hh"
+#include <cmath>
+#include "nntile/kernel/cpu.hh"
+
+namespace nntile::kernel::topk
+{
+
+template<typename T>
+void cpu(Index m, Index n, Index k, Index offset, bool init, const T *src,
+        T *dst_val, int64_t *dst_idx_)
+    noexcept
+//! Accumulate top-k largest elements of fibers along the first mode on CPU
+/*! For every column j of the m-by-n input array src the k largest elements of
+ * the column, that are merged with the k elements already stored in column j
+ * of the k-by-n arrays dst_val and dst_idx, are stored back into dst_val and
+ * dst_idx. Elements are sorted in descending order and ties are resolved in
+ * favor of the smaller index, so that the first element is the argmax. Index
+ * of src[i,j] is offset+i, which allows to reduce over several tiles of a
+ * tensor one after another. Empty slots of dst are marked by index -1 and
+ * NaN inputs are ignored.
+ *
+ * @param[in] m: Size of the first mode of src array
+ * @param[in] n: Number of columns of src, dst_val and dst_idx arrays
+ * @param[in] k: Number of the largest elements to keep
+ * @param[in] offset: Index of the first element of every column of src
+ * @param[in] init: If true, dst_val and dst_idx are overwritten, otherwise
+ *      they are accumulated
+ * @param[in] src: Input contiguous m-by-n array
+ * @param[inout] dst_val: Contiguous k-by-n array of the largest values
+ * @param[inout] dst_idx_: Contiguous k-by-n array of indices of the largest
+ *      values
+ * */
+{
+    using Y = typename T::repr_t;
+    auto dst_idx = reinterpret_cast<std::int64_t *>(dst_idx_);
+    for(Index j = 0; j < n; ++j)
+    {
+        const T *src_col = src + j*m;
+        T *val = dst_val + j*k;
+        std::int64_t *idx = dst_idx + j*k;
+        // Number of occupied slots
+        Index size = 0;
+        if(init)
+        {
+            for(Index r = 0; r < k; ++r)
+            {
+                idx[r] = -1;
+            }
+        }
+        else
+        {
+            while(size < k and idx[size] >= 0)
+            {
+                ++size;
+            }
+        }
+        for(Index i = 0; i < m; ++i)
+        {
+            Y v = static_cast<Y>(src_col[i]);
+            if(std::isnan(v))
+            {
+                continue;
+            }
+            // Indices of src are larger than all stored indices, so ties are
+            // never inserted before equal values
+            if(size == k and not (v > static_cast<Y>(val[k-1])))
+            {
+                continue;
+            }
+            Index r = size < k ? size++ : k-1;
+            while(r > 0 and v > static_cast<Y>(val[r-1]))
+            {
+                val[r] = val[r-1];
+                idx[r] = idx[r-1];
+                --r;
+            }
+            val[r] = static_cast<T>(v);
+            idx[r] = offset + i;
+        }
+    }
+}
+
+// Explicit instantiation
+template
+void cpu<fp32_t>(Index m, Index n, Index k, Index offset, bool init,
+        const fp32_t *src, fp32_t *dst_val, int64_t *dst_idx)
+    noexcept;
+
+template
+void cpu<fp32_fast_tf32_t>(Index m, Index n, Index k, Index offset, bool init,
+        const fp32_fast_tf32_t *src, fp32_fast_tf32_t *dst_val,
+        int64_t *dst_idx)
+    noexcept;
+
+template
+void cpu<fp32_fast_fp16_t>(Index m, Index n, Index k, Index offset, bool init,
+        const fp32_fast_fp16_t *src, fp32_fast_fp16_t *dst_val,
+        int64_t *dst_idx)
+    noexcept;
+
+template
+void cpu<fp32_fast_bf16_t>(Index m, Index n, Index k, Index offset, bool init,
+        const fp32_fast_bf16_t *src, fp32_fast_bf16_t *dst_val,
+        int64_t *dst_idx)
+    noexcept;
+
+template
+void cpu<fp64_t>(Index m, Index n, Index k, Index offset, bool init,
+        const fp64_t *src, fp64_t *dst_val, int64_t *dst_idx)
+    noexcept;
+
+template
+void cpu<bf16_t>(Index m, Index n, Index k, Index offset, bool init,
+        const bf16_t *src, bf16_t *dst_val, int64_t *dst_idx)
+    noexcept;
+
+} // namespace nntile::kernel::topk
@@ -0,0 +1,201 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/kernel/topk/cuda.cu
+ * Top-k largest elements along the first mode on CUDA
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/topk/cuda.hh"
+#include "nntile/kernel/cuda.hh"
+
+namespace nntile::kernel::topk
+{
+
+//! Number of threads per column
+static constexpr int BLOCK = 256;
+
+//! Check if (val1, idx1) goes before (val2, idx2) in the top-k order
+template<typename Y>
+static __device__
+bool better(Y val1, Index idx1, Y val2, Index idx2)
+{
+    return idx1 >= 0 and (idx2 < 0 or val1 > val2
+            or (val1 == val2 and idx1 < idx2));
+}
+
+template<typename T>
+static __global__
+void cuda_kernel(Index m, Index n, Index k, Index offset, bool init,
+        const T *src, T *dst_val, Index *dst_idx)
+//! Accumulate top-k largest elements of a column, one block per column
+/*! Top-k elements are selected one after another. Each round is a reduction
+ * over all the candidates (elements of src and previously stored elements of
+ * dst) for the best one among those, that go after the element selected at
+ * the previous round. Selected elements are kept in shared memory, as dst is
+ * also read during the selection.
+ * */
+{
+    using Y = typename T::repr_t;
+    Index j = blockIdx.x;
+    int tid = threadIdx.x;
+    const T *src_col = src + j*m;
+    T *val = dst_val + j*k;
+    Index *idx = dst_idx + j*k;
+    __shared__ Y red_val[BLOCK];
+    __shared__ Index red_idx[BLOCK];
+    extern __shared__ Index res_idx[];
+    Y *res_val = reinterpret_cast<Y *>(res_idx + k);
+    // Previously selected element
+    Y prev_val = 0.0;
+    Index prev_idx = -1;
+    for(Index r = 0; r < k; ++r)
+    {
+        Y best_val = 0.0;
+        Index best_idx = -1;
+        for(Index i = tid; i < m; i += BLOCK)
+        {
+            Y v = Y{src_col[i]};
+            if(::isnan(v))
+            {
+                continue;
+            }
+            Index vi = offset + i;
+            if((prev_idx < 0 or better(prev_val, prev_idx, v, vi))
+                    and better(v, vi, best_val, best_idx))
+            {
+                best_val = v;
+                best_idx = vi;
+            }
+        }
+        if(not init)
+        {
+            for(Index i = tid; i < k; i += BLOCK)
+            {
+                Index vi = idx[i];
+                Y v = Y{val[i]};
+                if((prev_idx < 0 or better(prev_val, prev_idx, v, vi))
+                        and better(v, vi, best_val, best_idx))
+                {
+                    best_val = v;
+                    best_idx = vi;
+                }
+            }
+        }
+        red_val[tid] = best_val;
+        red_idx[tid] = best_idx;
+        __syncthreads();
+        for(int s = BLOCK/2; s > 0; s /= 2)
+        {
+            if(tid < s and better(red_val[tid+s], red_idx[tid+s],
+                        red_val[tid], red_idx[tid]))
+            {
+                red_val[tid] = red_val[tid+s];
+                red_idx[tid] = red_idx[tid+s];
+            }
+            __syncthreads();
+        }
+        prev_val = red_val[0];
+        prev_idx = red_idx[0];
+        if(tid == 0)
+        {
+            res_val[r] = prev_val;
+            res_idx[r] = prev_idx;
+        }
+        __syncthreads();
+        // All the candidates are exhausted, remaining slots are empty
+        if(prev_idx < 0)
+        {
+            for(Index i = r+1+tid; i < k; i += BLOCK)
+            {
+                res_idx[i] = -1;
+            }
+            break;
+        }
+    }
+    __syncthreads();
+    for(Index i = tid; i < k; i += BLOCK)
+    {
+        idx[i] = res_idx[i];
+        if(res_idx[i] >= 0)
+        {
+            val[i] = T{res_val[i]};
+        }
+    }
+}
+
+template<typename T>
+void cuda(cudaStream_t stream, Index m, Index n, Index k, Index offset,
+        bool init, const T *src, T *dst_val, int64_t *dst_idx_)
+    noexcept
+//! Accumulate top-k largest elements of fibers along the first mode on CUDA
+/*! For every column j of the m-by-n input array src the k largest elements of
+ * the column, that are merged with the k elements already stored in column j
+ * of the k-by-n arrays dst_val and dst_idx, are stored back into dst_val and
+ * dst_idx. Elements are sorted in descending order and ties are resolved in
+ * favor of the smaller index, so that the first element is the argmax. Index
+ * of src[i,j] is offset+i, which allows to reduce over several tiles of a
+ * tensor one after another. Empty slots of dst are marked by index -1 and
+ * NaN inputs are ignored.
+ *
+ * @param[in] m: Size of the first mode of src array
+ * @param[in] n: Number of columns of src, dst_val and dst_idx arrays
+ * @param[in] k: Number of the largest elements to keep
+ * @param[in] offset: Index of the first element of every column of src
+ * @param[in] init: If true, dst_val and dst_idx are overwritten, otherwise
+ *      they are accumulated
+ * @param[in] src: Input contiguous m-by-n array
+ * @param[inout] dst_val: Contiguous k-by-n array of the largest values
+ * @param[inout] dst_idx_: Contiguous k-by-n array of indices of the largest
+ *      values
+ * */
+{
+    using Y = typename T::repr_t;
+    using I = typename CUDAComputeType<int64_t>::value;
+    auto dst_idx = reinterpret_cast<I *>(dst_idx_);
+    std::size_t shared = k * (sizeof(Index)+sizeof(Y));
+    (cuda_kernel<T>)<<<n, BLOCK, shared, stream>>>(m, n, k, offset, init,
+            src, dst_val, dst_idx);
+}
+
+// Explicit instantiation
+template
+void cuda<fp32_t>(cudaStream_t stream, Index m, Index n, Index k, Index offset,
+        bool init, const fp32_t *src, fp32_t *dst_val, int64_t *dst_idx)
+    noexcept;
+
+template
+void cuda<fp32_fast_tf32_t>(cudaStream_t stream, Index m, Index n, Index k,
+        Index offset, bool init, const fp32_fast_tf32_t *src,
+        fp32_fast_tf32_t *dst_val, int64_t *dst_idx)
+    noexcept;
+
+template
+void cuda<fp32_fast_fp16_t>(cudaStream_t stream, Index m, Index n, Index k,
+        Index offset, bool init, const fp32_fast_fp16_t *src,
+        fp32_fast_fp16_t *dst_val, int64_t *dst_idx)
+    noexcept;
+
+template
+void cuda<fp32_fast_bf16_t>(cudaStream_t stream, Index m, Index n, Index k,
+        Index offset, bool init, const fp32_fast_bf16_t *src,
+        fp32_fast_bf16_t *dst_val, int64_t *dst_idx)
+    noexcept;
+
+template
+void cuda<fp64_t>(cudaStream_t stream, Index m, Index n, Index k, Index offset,
+        bool init, const fp64_t *src, fp64_t *dst_val, int64_t *dst_idx)
+    noexcept;
+
+template
+void cuda<bf16_t>(cudaStream_t stream, Index m, Index n, Index k, Index offset,
+        bool init, const bf16_t *src, bf16_t *dst_val, int64_t *dst_idx)
+    noexcept;
+
+} // namespace nntile::kernel::topk
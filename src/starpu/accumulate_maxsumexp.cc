@@ -179,10 +179,11 @@ void submit(Handle src, Handle dst)
 {
     //double nflops;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_RW|STARPU_COMMUTE, static_cast<starpu_data_handle_t>(dst),
             STARPU_R, static_cast<starpu_data_handle_t>(src),
             // STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
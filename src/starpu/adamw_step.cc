@@ -178,12 +178,13 @@ void submit(Index num_iter, Index num_elems, Scalar beta_1, Scalar beta_2, Scala
     {
         moments_mode = STARPU_RW;
     }
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(grad),
             moments_mode, static_cast<starpu_data_handle_t>(first_moment),
             moments_mode, static_cast<starpu_data_handle_t>(second_moment),
             STARPU_RW, static_cast<starpu_data_handle_t>(p),
             STARPU_CL_ARGS, args, sizeof(*args),
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -197,11 +197,12 @@ void submit(Index m, Index n, Index k, Index batch, Scalar alpha, Handle src,
     args->beta = beta;
     double nflops = batch * k * (2*m*n+1);
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(src),
             STARPU_CL_ARGS, args, sizeof(*args),
             dst_mode, static_cast<starpu_data_handle_t>(dst),
             STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -201,11 +201,12 @@ void submit(Index nelems, Scalar alpha, Handle src, Scalar beta, Handle dst)
     // Put amount of bytes read and write inplace of gflops
     double nflops = sizeof(T) * 3 * nelems;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(src),
             STARPU_CL_ARGS, args, sizeof(*args),
             dst_mode, static_cast<starpu_data_handle_t>(dst),
             STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -121,9 +121,10 @@ void submit(Index num_elements, Scalar alpha, Scalar beta, Handle dst)
     args->alpha = alpha;
     args->beta = beta;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_CL_ARGS, args, sizeof(*args),
-            STARPU_RW, static_cast<starpu_data_handle_t>(dst), 0);
+            STARPU_RW, static_cast<starpu_data_handle_t>(dst),
+            STARPU_PRIORITY, Config::task_priority, 0);
             // STARPU_FLOPS, nflops);
     // Check submission
     if(ret != 0)
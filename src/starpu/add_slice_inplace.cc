@@ -203,11 +203,12 @@ void submit(Index m, Index n, Index k, Scalar alpha, Handle src, Scalar beta, Ha
     double nflops = beta == zero ? sizeof(T)*m*(k+1)*n :
             sizeof(T)*m*(2*k+1)*n;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(src),
             STARPU_CL_ARGS, args, sizeof(*args),
             dst_mode, static_cast<starpu_data_handle_t>(dst),
             STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
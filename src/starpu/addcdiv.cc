@@ -135,12 +135,13 @@ void submit(Scalar val, Scalar eps, Index nelems, Handle nom, Handle denom, Hand
     args->nelems = nelems;
     //double nflops = 5 * nelems;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(nom),
             STARPU_R, static_cast<starpu_data_handle_t>(denom),
             STARPU_RW, static_cast<starpu_data_handle_t>(src),
             STARPU_CL_ARGS, args, sizeof(*args),
             //STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
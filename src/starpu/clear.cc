@@ -90,8 +90,9 @@ void restore_where()
 void submit(Handle data)
 {
     // Submit task
-    int ret = starpu_task_insert(&codelet,
+    int ret = task_insert(&codelet,
             STARPU_W, static_cast<starpu_data_handle_t>(data),
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
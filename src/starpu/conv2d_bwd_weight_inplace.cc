@@ -180,11 +180,12 @@ void submit(Index src1_m, Index src1_n, Index src1_channels, Index batch,
         dst_mode = STARPU_W;
     }
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(src1),
             STARPU_R, static_cast<starpu_data_handle_t>(src2),
             STARPU_CL_ARGS, args, sizeof(*args),
             dst_mode, static_cast<starpu_data_handle_t>(dst),
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
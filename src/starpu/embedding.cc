@@ -181,13 +181,14 @@ void submit(Index m, Index n, Index k, Index k_start, Index k_size,
     args->k_size = k_size;
     double nflops = m * n * k_size;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(index),
             STARPU_R, static_cast<starpu_data_handle_t>(vocab),
             STARPU_RW, static_cast<starpu_data_handle_t>(embed),
             //Config::STARPU_RW_COMMUTE, static_cast<starpu_data_handle_t>(embed),
             STARPU_CL_ARGS, args, sizeof(*args),
             STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -192,12 +192,13 @@ void submit(Index m, Index n, Index k, Index k_start, Index k_size,
         vocab_mode = Config::STARPU_RW_COMMUTE;
     }
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(index),
             STARPU_R, static_cast<starpu_data_handle_t>(embed),
             vocab_mode, static_cast<starpu_data_handle_t>(vocab),
             STARPU_CL_ARGS, args, sizeof(*args),
             STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
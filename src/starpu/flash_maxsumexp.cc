@@ -260,7 +260,7 @@ void submit(Index seq, Index head, Index batch, Handle K, Handle Q,
     }
     // Submit task
     double nflops = 2 * seq * seq * head * batch;
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(K),
             STARPU_R, static_cast<starpu_data_handle_t>(Q),
             STARPU_R, static_cast<starpu_data_handle_t>(mask),
@@ -268,6 +268,7 @@ void submit(Index seq, Index head, Index batch, Handle K, Handle Q,
             STARPU_SCRATCH, static_cast<starpu_data_handle_t>(tmp),
             STARPU_CL_ARGS, args, sizeof(*args),
             STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -152,11 +152,12 @@ void submit(Index nelems, Handle x, Handle dy, Handle dx)
 {
     Index *nelems_ = (Index *)std::malloc(sizeof(*nelems_));
     *nelems_ = nelems;
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(x),
             STARPU_R, static_cast<starpu_data_handle_t>(dy),
             STARPU_RW, static_cast<starpu_data_handle_t>(dx),
             STARPU_CL_ARGS, nelems_, sizeof(*nelems_),
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -193,6 +194,7 @@ void submit_mpi(Index nelems, Handle x, Handle dy, Handle dx, int exec_rank)
             STARPU_R, static_cast<starpu_data_handle_t>(x),
             STARPU_R, static_cast<starpu_data_handle_t>(dy),
             STARPU_RW, static_cast<starpu_data_handle_t>(dx),
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Only execution node will have non-nullptr task
     if(task)
@@ -205,7 +207,7 @@ void submit_mpi(Index nelems, Handle x, Handle dy, Handle dx, int exec_rank)
         // Set codelet arguments
         *nelems_ = nelems;
         // Submit task to the DAG
-        int ret = starpu_task_submit(task);
+        int ret = task_submit(task);
         // Check submission
         if(ret != 0)
         {
@@ -69,13 +69,46 @@ void cpu(void *buffers[], void *cl_args)
     // Call corresponding CBLAS routine
     Index A_offset = args->m * args->k, B_offset = args->n * args->k,
             C_offset = args->m * args->n;
+    if(args->group_bcast == GROUP_BCAST_NONE)
+    {
+        for(Index i = 0; i < args->batch; ++i)
+        {
+            cblas(transA_, transB_, M, N, K, args->alpha, A, ldA, B, ldB,
+                    args->beta, C, ldC);
+            A += A_offset;
+            B += B_offset;
+            C += C_offset;
+        }
+        return;
+    }
+    // One of operands is shared by a group of gemms
+    Index inner = args->group_inner, group = args->group_size;
     for(Index i = 0; i < args->batch; ++i)
     {
-        cblas(transA_, transB_, M, N, K, args->alpha, A, ldA, B, ldB,
-                args->beta, C, ldC);
-        A += A_offset;
-        B += B_offset;
-        C += C_offset;
+        Index i_group = (i/inner) % group;
+        Index i_shared = i%inner + inner*(i/(inner*group));
+        Index i_A = i, i_B = i, i_C = i;
+        Scalar beta = args->beta;
+        switch(args->group_bcast)
+        {
+            case GROUP_BCAST_A:
+                i_A = i_shared;
+                break;
+            case GROUP_BCAST_B:
+                i_B = i_shared;
+                break;
+            // This parameter was already checked during task submission
+            //case GROUP_BCAST_C:
+            default:
+                i_C = i_shared;
+                // Accumulate results of the group
+                if(i_group > 0)
+                {
+                    beta = 1.0;
+                }
+        }
+        cblas(transA_, transB_, M, N, K, args->alpha, A+i_A*A_offset, ldA,
+                B+i_B*B_offset, ldB, beta, C+i_C*C_offset, ldC);
     }
 #endif // STARPU_SIMGRID
 }
@@ -136,7 +169,7 @@ void cuda(void *buffers[], void *cl_args)
         cublas(handle, transA_, transB_, M, N, K, args->alpha, A, ldA, B, ldB,
                 args->beta, C, M);
     }
-    else
+    else if(args->group_bcast == GROUP_BCAST_NONE)
     {
         Index A_offset = args->m * args->k, B_offset = args->n * args->k,
                 C_offset = args->m * args->n;
@@ -144,6 +177,62 @@ void cuda(void *buffers[], void *cl_args)
                 A_offset, B, ldB, B_offset, args->beta, C, M, C_offset,
                 args->batch);
     }
+    else
+    {
+        // One of operands is shared by a group of gemms. Each strided batched
+        // call goes over outer index, so that shared operand is read with a
+        // stride of inner matrices, while others with a stride of
+        // inner*group matrices. Calls for different elements of a group are
+        // serialized on the stream, which makes accumulation into shared C
+        // safe.
+        Index inner = args->group_inner, group = args->group_size;
+        Index outer = args->batch / (inner*group);
+        Index A_offset = args->m * args->k, B_offset = args->n * args->k,
+                C_offset = args->m * args->n;
+        Index A_stride = A_offset * inner * group,
+                B_stride = B_offset * inner * group,
+                C_stride = C_offset * inner * group;
+        switch(args->group_bcast)
+        {
+            case GROUP_BCAST_A:
+                A_stride = A_offset * inner;
+                break;
+            case GROUP_BCAST_B:
+                B_stride = B_offset * inner;
+                break;
+            // This parameter was already checked during task submission
+            //case GROUP_BCAST_C:
+            default:
+                C_stride = C_offset * inner;
+        }
+        for(Index i_group = 0; i_group < group; ++i_group)
+        {
+            Scalar beta = args->beta;
+            if(args->group_bcast == GROUP_BCAST_C and i_group > 0)
+            {
+                beta = 1.0;
+            }
+            for(Index i_inner = 0; i_inner < inner; ++i_inner)
+            {
+                Index i_full = i_inner + inner*i_group;
+                Index i_A = i_full, i_B = i_full, i_C = i_full;
+                switch(args->group_bcast)
+                {
+                    case GROUP_BCAST_A:
+                        i_A = i_inner;
+                        break;
+                    case GROUP_BCAST_B:
+                        i_B = i_inner;
+                        break;
+                    default:
+                        i_C = i_inner;
+                }
+                cublas_batch(handle, transA_, transB_, M, N, K, args->alpha,
+                        A+i_A*A_offset, ldA, A_stride, B+i_B*B_offset, ldB,
+                        B_stride, beta, C+i_C*C_offset, M, C_stride, outer);
+            }
+        }
+    }
 #endif // STARPU_SIMGRID
 }
 #endif //NNTILE_USE_CUDA
@@ -164,6 +253,14 @@ uint32_t footprint(struct starpu_task *task)
     hash = starpu_hash_crc32c_be_n(&args->n, sizeof(args->n), hash);
     hash = starpu_hash_crc32c_be_n(&args->k, sizeof(args->k), hash);
     hash = starpu_hash_crc32c_be_n(&args->batch, sizeof(args->batch), hash);
+    // Gemms with a shared operand have different performance
+    if(args->group_bcast != GROUP_BCAST_NONE)
+    {
+        hash = starpu_hash_crc32c_be_n(&args->group_size,
+                sizeof(args->group_size), hash);
+        hash = starpu_hash_crc32c_be_n(&args->group_bcast,
+                sizeof(args->group_bcast), hash);
+    }
     return hash;
 }
 
@@ -563,8 +660,22 @@ void restore_where()
 template<typename T>
 void submit(const TransOp &transA, const TransOp &transB, Index m, Index n,
         Index k, Index batch, Scalar alpha, Handle A, Handle B, Scalar beta,
-        Handle C, int redux)
+        Handle C, int redux, Index group_inner, Index group_size,
+        int group_bcast)
 {
+    // Check parameters of a group of gemms with a shared operand
+    if(group_bcast < GROUP_BCAST_NONE or group_bcast > GROUP_BCAST_C)
+    {
+        throw std::runtime_error("Invalid value of group_bcast");
+    }
+    if(group_inner <= 0 or group_size <= 0)
+    {
+        throw std::runtime_error("group_inner <= 0 or group_size <= 0");
+    }
+    if(batch % (group_inner*group_size) != 0)
+    {
+        throw std::runtime_error("batch % (group_inner*group_size) != 0");
+    }
     // Check that matrix sizes fit proper types for underlying CBLAS
 #ifdef NNTILE_USE_CBLAS
 #ifndef STARPU_SIMGRID
@@ -631,16 +742,20 @@ void submit(const TransOp &transA, const TransOp &transB, Index m, Index n,
         .k = k,
         .batch = batch,
         .alpha = alpha,
-        .beta = beta
+        .beta = beta,
+        .group_inner = group_inner,
+        .group_size = group_size,
+        .group_bcast = group_bcast
     };
     double nflops = 2 * m * n * k * batch;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(transA, transB),
+    int ret = task_insert(codelet<T>(transA, transB),
             STARPU_R, static_cast<starpu_data_handle_t>(A),
             STARPU_R, static_cast<starpu_data_handle_t>(B),
             C_mode, static_cast<starpu_data_handle_t>(C),
             STARPU_CL_ARGS, args, sizeof(*args),
             STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -653,31 +768,37 @@ void submit(const TransOp &transA, const TransOp &transB, Index m, Index n,
 template
 void submit<fp32_t>(const TransOp &transA, const TransOp &transB,
         Index m, Index n, Index k, Index batch, Scalar alpha, Handle A,
-        Handle B, Scalar beta, Handle C, int redux);
+        Handle B, Scalar beta, Handle C, int redux, Index group_inner,
+        Index group_size, int group_bcast);
 
 template
 void submit<fp32_fast_tf32_t>(const TransOp &transA, const TransOp &transB,
         Index m, Index n, Index k, Index batch, Scalar alpha, Handle A,
-        Handle B, Scalar beta, Handle C, int redux);
+        Handle B, Scalar beta, Handle C, int redux, Index group_inner,
+        Index group_size, int group_bcast);
 
 template
 void submit<fp32_fast_fp16_t>(const TransOp &transA, const TransOp &transB,
         Index m, Index n, Index k, Index batch, Scalar alpha, Handle A,
-        Handle B, Scalar beta, Handle C, int redux);
+        Handle B, Scalar beta, Handle C, int redux, Index group_inner,
+        Index group_size, int group_bcast);
 
 template
 void submit<fp32_fast_bf16_t>(const TransOp &transA, const TransOp &transB,
         Index m, Index n, Index k, Index batch, Scalar alpha, Handle A,
-        Handle B, Scalar beta, Handle C, int redux);
+        Handle B, Scalar beta, Handle C, int redux, Index group_inner,
+        Index group_size, int group_bcast);
 
 template
 void submit<fp64_t>(const TransOp &transA, const TransOp &transB,
         Index m, Index n, Index k, Index batch, Scalar alpha, Handle A,
-        Handle B, Scalar beta, Handle C, int redux);
+        Handle B, Scalar beta, Handle C, int redux, Index group_inner,
+        Index group_size, int group_bcast);
 
 template
 void submit<bf16_t>(const TransOp &transA, const TransOp &transB,
         Index m, Index n, Index k, Index batch, Scalar alpha, Handle A,
-        Handle B, Scalar beta, Handle C, int redux);
+        Handle B, Scalar beta, Handle C, int redux, Index group_inner,
+        Index group_size, int group_bcast);
 
 } // namespace nntile::starpu::gemm
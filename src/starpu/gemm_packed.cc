@@ -0,0 +1,200 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/starpu/gemm_packed.cc
+ * StarPU wrappers for a product of a packed matrix by a matrix
+ *
+ * @version 1.1.0
+ * */
+
+#ifndef STARPU_SIMGRID
+#include "nntile/kernel/gemm_packed.hh"
+#endif // STARPU_SIMGRID
+#include "nntile/starpu/gemm_packed.hh"
+
+namespace nntile::starpu::gemm_packed
+{
+
+//! Product of a packed matrix by a matrix within StarPU buffers on CPU
+template<typename T>
+void cpu(void *buffers[], void *cl_args)
+    noexcept
+{
+#ifndef STARPU_SIMGRID // Run the code only if this is not a simulation
+    // Get arguments
+    auto args = reinterpret_cast<args_t *>(cl_args);
+    // Get interfaces
+    auto interfaces = reinterpret_cast<VariableInterface **>(buffers);
+    const T *A = interfaces[0]->get_ptr<T>();
+    const T *B = interfaces[1]->get_ptr<T>();
+    T *C = interfaces[2]->get_ptr<T>();
+    // Launch kernel
+    kernel::gemm_packed::cpu<T>(args->transB, args->m, args->n, args->k,
+            args->alpha, A, B, args->beta, C);
+#endif // STARPU_SIMGRID
+}
+
+//! Footprint for gemm_packed tasks that depends only on cl_arg
+static
+uint32_t footprint(struct starpu_task *task)
+{
+    // Get arguments
+    auto args = reinterpret_cast<args_t *>(task->cl_arg);
+    // Apply hash over parameters transB, m, n and k
+    uint32_t hash = 0;
+    hash = starpu_hash_crc32c_be_n(&args->transB, sizeof(args->transB), hash);
+    hash = starpu_hash_crc32c_be_n(&args->m, sizeof(args->m), hash);
+    hash = starpu_hash_crc32c_be_n(&args->n, sizeof(args->n), hash);
+    hash = starpu_hash_crc32c_be_n(&args->k, sizeof(args->k), hash);
+    return hash;
+}
+
+Codelet codelet_fp32, codelet_fp64, codelet_fp32_fast_tf32, codelet_bf16,
+        codelet_fp32_fast_fp16, codelet_fp32_fast_bf16;
+
+void init()
+{
+    codelet_fp32.init("nntile_gemm_packed_fp32",
+            footprint,
+            {cpu<fp32_t>},
+            {}
+            );
+
+    codelet_bf16.init("nntile_gemm_packed_bf16",
+            footprint,
+            {cpu<bf16_t>},
+            {}
+            );
+
+    codelet_fp32_fast_tf32.init("nntile_gemm_packed_fp32_fast_tf32",
+            footprint,
+            {cpu<fp32_t>},
+            {}
+            );
+
+    codelet_fp32_fast_fp16.init("nntile_gemm_packed_fp32_fast_fp16",
+            footprint,
+            {cpu<fp32_t>},
+            {}
+            );
+
+    codelet_fp32_fast_bf16.init("nntile_gemm_packed_fp32_fast_bf16",
+            footprint,
+            {cpu<fp32_t>},
+            {}
+            );
+
+    codelet_fp64.init("nntile_gemm_packed_fp64",
+            footprint,
+            {cpu<fp64_t>},
+            {}
+            );
+}
+
+void restrict_where(uint32_t where)
+{
+    codelet_fp32.restrict_where(where);
+    codelet_bf16.restrict_where(where);
+    codelet_fp32_fast_tf32.restrict_where(where);
+    codelet_fp32_fast_fp16.restrict_where(where);
+    codelet_fp32_fast_bf16.restrict_where(where);
+    codelet_fp64.restrict_where(where);
+}
+
+void restore_where()
+{
+    codelet_fp32.restore_where();
+    codelet_bf16.restore_where();
+    codelet_fp32_fast_tf32.restore_where();
+    codelet_fp32_fast_fp16.restore_where();
+    codelet_fp32_fast_bf16.restore_where();
+    codelet_fp64.restore_where();
+}
+
+template<typename T>
+void submit(const TransOp &transB, Index m, Index n, Index k, Scalar alpha,
+        Handle A, Handle B, Scalar beta, Handle C, int redux)
+//! Insert gemm_packed task into StarPU pool of tasks
+/*! No argument checking is performed. All the inputs are packed and passed to
+ * starpu_task_insert() function. If task submission fails, this routines
+ * throws an std::runtime_error() exception.
+ * */
+{
+    // Access mode for C as in gemm
+    constexpr Scalar zero = 0, one = 1;
+    enum starpu_data_access_mode C_mode;
+    if(beta == zero)
+    {
+        C_mode = STARPU_W;
+    }
+    else if(beta == one)
+    {
+        if(redux != 0)
+        {
+            C_mode = STARPU_REDUX;
+        }
+        else
+        {
+            C_mode = Config::STARPU_RW_COMMUTE;
+        }
+    }
+    else
+    {
+        C_mode = STARPU_RW;
+    }
+    // Codelet arguments
+    args_t *args = (args_t *)std::malloc(sizeof(*args));
+    args->transB = (transB.value == TransOp::Trans);
+    args->m = m;
+    args->n = n;
+    args->k = k;
+    args->alpha = alpha;
+    args->beta = beta;
+    double nflops = 2 * m * n * k;
+    // Submit task
+    int ret = task_insert(codelet<T>(),
+            STARPU_R, static_cast<starpu_data_handle_t>(A),
+            STARPU_R, static_cast<starpu_data_handle_t>(B),
+            C_mode, static_cast<starpu_data_handle_t>(C),
+            STARPU_CL_ARGS, args, sizeof(*args),
+            STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
+            0);
+    // Check submission
+    if(ret != 0)
+    {
+        throw std::runtime_error("Error in gemm_packed task submission");
+    }
+}
+
+// Explicit instantiation
+template
+void submit<fp32_t>(const TransOp &transB, Index m, Index n, Index k,
+        Scalar alpha, Handle A, Handle B, Scalar beta, Handle C, int redux);
+
+template
+void submit<bf16_t>(const TransOp &transB, Index m, Index n, Index k,
+        Scalar alpha, Handle A, Handle B, Scalar beta, Handle C, int redux);
+
+template
+void submit<fp32_fast_tf32_t>(const TransOp &transB, Index m, Index n, Index k,
+        Scalar alpha, Handle A, Handle B, Scalar beta, Handle C, int redux);
+
+template
+void submit<fp32_fast_fp16_t>(const TransOp &transB, Index m, Index n, Index k,
+        Scalar alpha, Handle A, Handle B, Scalar beta, Handle C, int redux);
+
+template
+void submit<fp32_fast_bf16_t>(const TransOp &transB, Index m, Index n, Index k,
+        Scalar alpha, Handle A, Handle B, Scalar beta, Handle C, int redux);
+
+template
+void submit<fp64_t>(const TransOp &transB, Index m, Index n, Index k,
+        Scalar alpha, Handle A, Handle B, Scalar beta, Handle C, int redux);
+
+} // namespace nntile::starpu::gemm_packed
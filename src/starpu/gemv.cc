@@ -0,0 +1,314 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/starpu/gemv.cc
+ * Matrix times a few vectors, specialized gemm for decoding
+ *
+ * @version 1.1.0
+ * */
+
+#ifndef STARPU_SIMGRID
+#include "nntile/kernel/gemv.hh"
+#endif // STARPU_SIMGRID
+#include "nntile/starpu/gemv.hh"
+#ifdef NNTILE_USE_CBLAS
+// CBLAS header and CBLAS_INT come with the configured gemm kernel header
+#include "nntile/kernel/gemm.hh"
+#endif // NNTILE_USE_CBLAS
+
+namespace nntile::starpu::gemv
+{
+
+#ifndef STARPU_SIMGRID
+//! Product of a matrix by a few columns on CPU for a generic type
+template<typename T>
+static inline
+void cpu_kernel(bool transA, Index m, Index n, Index k, Scalar alpha,
+        const T *A, const T *B, Scalar beta, T *C)
+    noexcept
+{
+    kernel::gemv::cpu<T>(transA, m, n, k, alpha, A, B, beta, C);
+}
+
+#ifdef NNTILE_USE_CBLAS
+// Overloaded call to CBLAS GEMV for every column of B
+static inline
+void cpu_kernel(bool transA, Index m, Index n, Index k, Scalar alpha,
+        const fp32_t *A, const fp32_t *B, Scalar beta, fp32_t *C)
+    noexcept
+{
+    CBLAS_TRANSPOSE transA_ = transA ? CblasTrans : CblasNoTrans;
+    CBLAS_INT M = transA ? k : m, N = transA ? m : k;
+    for(Index j = 0; j < n; ++j)
+    {
+        cblas_sgemv(CblasColMajor, transA_, M, N, alpha, (const float *)A, M,
+                (const float *)(B+j*k), 1, beta, (float *)(C+j*m), 1);
+    }
+}
+
+// Overloaded call to CBLAS GEMV for every column of B
+static inline
+void cpu_kernel(bool transA, Index m, Index n, Index k, Scalar alpha,
+        const fp64_t *A, const fp64_t *B, Scalar beta, fp64_t *C)
+    noexcept
+{
+    CBLAS_TRANSPOSE transA_ = transA ? CblasTrans : CblasNoTrans;
+    CBLAS_INT M = transA ? k : m, N = transA ? m : k;
+    for(Index j = 0; j < n; ++j)
+    {
+        cblas_dgemv(CblasColMajor, transA_, M, N, alpha, (const double *)A, M,
+                (const double *)(B+j*k), 1, beta, (double *)(C+j*m), 1);
+    }
+}
+#endif // NNTILE_USE_CBLAS
+#endif // STARPU_SIMGRID
+
+//! Product of a matrix by a few columns within StarPU buffers on CPU
+template<typename T>
+void cpu(void *buffers[], void *cl_args)
+    noexcept
+{
+#ifndef STARPU_SIMGRID // Run the code only if this is not a simulation
+    // Get arguments
+    auto args = reinterpret_cast<args_t *>(cl_args);
+    // Get interfaces
+    auto interfaces = reinterpret_cast<VariableInterface **>(buffers);
+    const T *A = interfaces[0]->get_ptr<T>();
+    const T *B = interfaces[1]->get_ptr<T>();
+    T *C = interfaces[2]->get_ptr<T>();
+    Index A_offset = args->m * args->k, B_offset = args->n * args->k,
+            C_offset = args->m * args->n;
+    // Launch kernel for every matrix of a batch, fp32 and fp64 go to CBLAS
+    for(Index i = 0; i < args->batch; ++i)
+    {
+        cpu_kernel(args->transA, args->m, args->n, args->k, args->alpha,
+                A+i*A_offset, B+i*B_offset, args->beta, C+i*C_offset);
+    }
+#endif // STARPU_SIMGRID
+}
+
+#ifdef NNTILE_USE_CUDA
+//! Product of a matrix by a few columns within StarPU buffers on CUDA
+template<typename T>
+void cuda(void *buffers[], void *cl_args)
+    noexcept
+{
+#ifndef STARPU_SIMGRID // Run the code only if this is not a simulation
+    // Get arguments
+    auto args = reinterpret_cast<args_t *>(cl_args);
+    // Get interfaces
+    auto interfaces = reinterpret_cast<VariableInterface **>(buffers);
+    const T *A = interfaces[0]->get_ptr<T>();
+    const T *B = interfaces[1]->get_ptr<T>();
+    T *C = interfaces[2]->get_ptr<T>();
+    Index A_offset = args->m * args->k, B_offset = args->n * args->k,
+            C_offset = args->m * args->n;
+    // Get CUDA stream
+    cudaStream_t stream = starpu_cuda_get_local_stream();
+    // Launch kernel for every matrix of a batch
+    for(Index i = 0; i < args->batch; ++i)
+    {
+        kernel::gemv::cuda<T>(stream, args->transA, args->m, args->n,
+                args->k, args->alpha, A+i*A_offset, B+i*B_offset,
+                args->beta, C+i*C_offset);
+    }
+#endif // STARPU_SIMGRID
+}
+#endif // NNTILE_USE_CUDA
+
+//! Footprint for gemv tasks that depends only on cl_arg
+static
+uint32_t footprint(struct starpu_task *task)
+{
+    // Get arguments
+    auto args = reinterpret_cast<args_t *>(task->cl_arg);
+    // Apply hash over parameters transA, m, n, k and batch
+    uint32_t hash = 0;
+    hash = starpu_hash_crc32c_be_n(&args->transA, sizeof(args->transA), hash);
+    hash = starpu_hash_crc32c_be_n(&args->m, sizeof(args->m), hash);
+    hash = starpu_hash_crc32c_be_n(&args->n, sizeof(args->n), hash);
+    hash = starpu_hash_crc32c_be_n(&args->k, sizeof(args->k), hash);
+    hash = starpu_hash_crc32c_be_n(&args->batch, sizeof(args->batch), hash);
+    return hash;
+}
+
+Codelet codelet_fp32, codelet_fp64, codelet_fp32_fast_tf32, codelet_bf16,
+        codelet_fp32_fast_fp16, codelet_fp32_fast_bf16;
+
+void init()
+{
+    codelet_fp32.init("nntile_gemv_fp32",
+            footprint,
+            {cpu<fp32_t>},
+#ifdef NNTILE_USE_CUDA
+            {cuda<fp32_t>}
+#else // NNTILE_USE_CUDA
+            {}
+#endif // NNTILE_USE_CUDA
+            );
+
+    codelet_bf16.init("nntile_gemv_bf16",
+            footprint,
+            {cpu<bf16_t>},
+#ifdef NNTILE_USE_CUDA
+            {cuda<bf16_t>}
+#else // NNTILE_USE_CUDA
+            {}
+#endif // NNTILE_USE_CUDA
+            );
+
+    codelet_fp32_fast_tf32.init("nntile_gemv_fp32_fast_tf32",
+            footprint,
+            {cpu<fp32_t>},
+#ifdef NNTILE_USE_CUDA
+            {cuda<fp32_t>}
+#else // NNTILE_USE_CUDA
+            {}
+#endif // NNTILE_USE_CUDA
+            );
+
+    codelet_fp32_fast_fp16.init("nntile_gemv_fp32_fast_fp16",
+            footprint,
+            {cpu<fp32_t>},
+#ifdef NNTILE_USE_CUDA
+            {cuda<fp32_t>}
+#else // NNTILE_USE_CUDA
+            {}
+#endif // NNTILE_USE_CUDA
+            );
+
+    codelet_fp32_fast_bf16.init("nntile_gemv_fp32_fast_bf16",
+            footprint,
+            {cpu<fp32_t>},
+#ifdef NNTILE_USE_CUDA
+            {cuda<fp32_t>}
+#else // NNTILE_USE_CUDA
+            {}
+#endif // NNTILE_USE_CUDA
+            );
+
+    codelet_fp64.init("nntile_gemv_fp64",
+            footprint,
+            {cpu<fp64_t>},
+#ifdef NNTILE_USE_CUDA
+            {cuda<fp64_t>}
+#else // NNTILE_USE_CUDA
+            {}
+#endif // NNTILE_USE_CUDA
+            );
+}
+
+void restrict_where(uint32_t where)
+{
+    codelet_fp32.restrict_where(where);
+    codelet_bf16.restrict_where(where);
+    codelet_fp32_fast_tf32.restrict_where(where);
+    codelet_fp32_fast_fp16.restrict_where(where);
+    codelet_fp32_fast_bf16.restrict_where(where);
+    codelet_fp64.restrict_where(where);
+}
+
+void restore_where()
+{
+    codelet_fp32.restore_where();
+    codelet_bf16.restore_where();
+    codelet_fp32_fast_tf32.restore_where();
+    codelet_fp32_fast_fp16.restore_where();
+    codelet_fp32_fast_bf16.restore_where();
+    codelet_fp64.restore_where();
+}
+
+template<typename T>
+void submit(const TransOp &transA, Index m, Index n, Index k, Index batch,
+        Scalar alpha, Handle A, Handle B, Scalar beta, Handle C, int redux)
+//! Insert gemv task into StarPU pool of tasks
+/*! No argument checking is performed. All the inputs are packed and passed to
+ * starpu_task_insert() function. If task submission fails, this routines
+ * throws an std::runtime_error() exception.
+ * */
+{
+    // Access mode for C as in gemm
+    constexpr Scalar zero = 0, one = 1;
+    enum starpu_data_access_mode C_mode;
+    if(beta == zero)
+    {
+        C_mode = STARPU_W;
+    }
+    else if(beta == one)
+    {
+        if(redux != 0)
+        {
+            C_mode = STARPU_REDUX;
+        }
+        else
+        {
+            C_mode = Config::STARPU_RW_COMMUTE;
+        }
+    }
+    else
+    {
+        C_mode = STARPU_RW;
+    }
+    // Codelet arguments
+    args_t *args = (args_t *)std::malloc(sizeof(*args));
+    args->transA = (transA.value == TransOp::Trans);
+    args->m = m;
+    args->n = n;
+    args->k = k;
+    args->batch = batch;
+    args->alpha = alpha;
+    args->beta = beta;
+    double nflops = 2 * m * n * k * batch;
+    // Submit task
+    int ret = task_insert(codelet<T>(),
+            STARPU_R, static_cast<starpu_data_handle_t>(A),
+            STARPU_R, static_cast<starpu_data_handle_t>(B),
+            C_mode, static_cast<starpu_data_handle_t>(C),
+            STARPU_CL_ARGS, args, sizeof(*args),
+            STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
+            0);
+    // Check submission
+    if(ret != 0)
+    {
+        throw std::runtime_error("Error in gemv task submission");
+    }
+}
+
+// Explicit instantiation
+template
+void submit<fp32_t>(const TransOp &transA, Index m, Index n, Index k,
+        Index batch, Scalar alpha, Handle A, Handle B, Scalar beta, Handle C,
+        int redux);
+
+template
+void submit<bf16_t>(const TransOp &transA, Index m, Index n, Index k,
+        Index batch, Scalar alpha, Handle A, Handle B, Scalar beta, Handle C,
+        int redux);
+
+template
+void submit<fp32_fast_tf32_t>(const TransOp &transA, Index m, Index n, Index k,
+        Index batch, Scalar alpha, Handle A, Handle B, Scalar beta, Handle C,
+        int redux);
+
+template
+void submit<fp32_fast_fp16_t>(const TransOp &transA, Index m, Index n, Index k,
+        Index batch, Scalar alpha, Handle A, Handle B, Scalar beta, Handle C,
+        int redux);
+
+template
+void submit<fp32_fast_bf16_t>(const TransOp &transA, Index m, Index n, Index k,
+        Index batch, Scalar alpha, Handle A, Handle B, Scalar beta, Handle C,
+        int redux);
+
+template
+void submit<fp64_t>(const TransOp &transA, Index m, Index n, Index k,
+        Index batch, Scalar alpha, Handle A, Handle B, Scalar beta, Handle C,
+        int redux);
+
+} // namespace nntile::starpu::gemv
@@ -0,0 +1,305 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/starpu/graph.cc
+ * Capture and replay of a graph of StarPU tasks
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/starpu/graph.hh"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace nntile::starpu
+{
+
+TaskGraph::~TaskGraph()
+{
+    // Graph may outlive StarPU, that already finished all the tasks
+    if(starpu_is_initialized())
+    {
+        if(task_capture == &capture)
+        {
+            task_capture = nullptr;
+        }
+        clear();
+    }
+}
+
+void TaskGraph::begin_capture()
+{
+    if(task_capture != nullptr)
+    {
+        throw std::runtime_error("Another task graph is being captured");
+    }
+    clear();
+    task_capture = &capture;
+}
+
+bool TaskGraph::end_capture()
+{
+    if(task_capture != &capture)
+    {
+        throw std::runtime_error("Task graph is not being captured");
+    }
+    task_capture = nullptr;
+    // Tasks on data, that was unregistered during capture (e.g., temporary
+    // tiles of a tensor operation), cannot be replayed. Scratch data is not
+    // unregistered, as the graph keeps it as a workspace
+    auto &unregistered = capture.unregistered;
+    std::sort(unregistered.begin(), unregistered.end());
+    for(const auto &rec: capture.tasks)
+    {
+        for(auto handle: rec.handles)
+        {
+            if(std::binary_search(unregistered.begin(), unregistered.end(),
+                        handle))
+            {
+                clear();
+                return false;
+            }
+        }
+    }
+    unregistered.clear();
+    // Accesses of each data handle in the order of submission
+    struct Accesses
+    {
+        std::vector<std::pair<Index, Index>> list;
+        Index first_write = -1, last_write = -1;
+        Index last_writer = -1;
+        std::vector<Index> readers;
+        // Reductions and commuting accesses are left to StarPU
+        bool implicit = false;
+    };
+    std::unordered_map<starpu_data_handle_t, Accesses> accesses;
+    Index ntasks = capture.tasks.size();
+    deps.assign(ntasks, {});
+    seq_consistency.resize(ntasks);
+    for(Index i = 0; i < ntasks; ++i)
+    {
+        const auto &rec = capture.tasks[i];
+        Index nbuffers = rec.handles.size();
+        seq_consistency[i].assign(nbuffers, 1);
+        for(Index j = 0; j < nbuffers; ++j)
+        {
+            auto mode = rec.modes[j];
+            // Scratch data does not carry values between tasks
+            if(mode & STARPU_SCRATCH)
+            {
+                continue;
+            }
+            auto &acc = accesses[rec.handles[j]];
+            if(mode & (STARPU_REDUX | STARPU_COMMUTE))
+            {
+                acc.implicit = true;
+            }
+            Index pos = acc.list.size();
+            acc.list.emplace_back(i, j);
+            if(mode & (STARPU_W | STARPU_REDUX))
+            {
+                // Write after reads or after a previous write
+                if(!acc.readers.empty())
+                {
+                    deps[i].insert(deps[i].end(), acc.readers.begin(),
+                            acc.readers.end());
+                }
+                else if(acc.last_writer >= 0)
+                {
+                    deps[i].push_back(acc.last_writer);
+                }
+                acc.last_writer = i;
+                acc.readers.clear();
+                if(acc.first_write < 0)
+                {
+                    acc.first_write = pos;
+                }
+                acc.last_write = pos;
+            }
+            else
+            {
+                // Read after a write
+                if(acc.last_writer >= 0)
+                {
+                    deps[i].push_back(acc.last_writer);
+                }
+                acc.readers.push_back(i);
+            }
+        }
+    }
+    // Accesses between the first and the last writes of a handle are ordered
+    // only by explicit dependencies
+    for(const auto &[handle, acc]: accesses)
+    {
+        if(acc.implicit)
+        {
+            continue;
+        }
+        for(Index pos = acc.first_write+1; pos < acc.last_write; ++pos)
+        {
+            const auto &[i, j] = acc.list[pos];
+            seq_consistency[i][j] = 0;
+        }
+    }
+    // Remove self and duplicate dependencies and find tasks without
+    // dependent tasks
+    std::vector<bool> has_successor(ntasks, false);
+    for(Index i = 0; i < ntasks; ++i)
+    {
+        auto &task_deps = deps[i];
+        task_deps.erase(std::remove(task_deps.begin(), task_deps.end(), i),
+                task_deps.end());
+        std::sort(task_deps.begin(), task_deps.end());
+        task_deps.erase(std::unique(task_deps.begin(), task_deps.end()),
+                task_deps.end());
+        for(auto dep: task_deps)
+        {
+            has_successor[dep] = true;
+        }
+    }
+    for(Index i = 0; i < ntasks; ++i)
+    {
+        if(!has_successor[i])
+        {
+            sinks.push_back(i);
+        }
+    }
+    return true;
+}
+
+starpu_task *TaskGraph::_build(Index i)
+{
+    const auto &rec = capture.tasks[i];
+    starpu_task *task = starpu_task_create();
+    task->cl = rec.cl;
+    Index nbuffers = rec.handles.size();
+    task->nbuffers = nbuffers;
+    if(nbuffers > STARPU_NMAXBUFS)
+    {
+        // StarPU frees these arrays together with the task
+        task->dyn_handles = reinterpret_cast<starpu_data_handle_t *>(
+                std::malloc(nbuffers*sizeof(starpu_data_handle_t)));
+        task->dyn_modes = reinterpret_cast<starpu_data_access_mode *>(
+                std::malloc(nbuffers*sizeof(starpu_data_access_mode)));
+    }
+    for(Index j = 0; j < nbuffers; ++j)
+    {
+        STARPU_TASK_SET_HANDLE(task, rec.handles[j], j);
+        STARPU_TASK_SET_MODE(task, rec.modes[j], j);
+    }
+    task->handles_sequential_consistency = const_cast<unsigned char *>(
+            seq_consistency[i].data());
+    // Arguments are owned by the graph, that outlives its replays
+    task->cl_arg = const_cast<char *>(rec.cl_arg.data());
+    task->cl_arg_size = rec.cl_arg.size();
+    task->cl_arg_free = 0;
+    task->priority = rec.priority;
+    task->flops = rec.flops;
+    return task;
+}
+
+void TaskGraph::_replay_callback(void *graph)
+{
+    auto self = reinterpret_cast<TaskGraph *>(graph);
+    std::lock_guard<std::mutex> lock(self->mutex);
+    --self->nreplays;
+    self->finished.notify_all();
+}
+
+void TaskGraph::replay()
+{
+    // Replayed tasks would be missing from a graph, that is being captured
+    if(task_capture != nullptr)
+    {
+        throw std::runtime_error("Task graph is replayed during capture");
+    }
+    Index ntasks = capture.tasks.size();
+    if(ntasks == 0)
+    {
+        return;
+    }
+    // All dependencies are declared before any task is submitted, as a
+    // submitted task can be finished and destroyed at any moment
+    std::vector<starpu_task *> tasks(ntasks);
+    std::vector<starpu_task *> task_deps;
+    for(Index i = 0; i < ntasks; ++i)
+    {
+        tasks[i] = _build(i);
+        if(!deps[i].empty())
+        {
+            task_deps.clear();
+            for(auto dep: deps[i])
+            {
+                task_deps.push_back(tasks[dep]);
+            }
+            starpu_task_declare_deps_array(tasks[i], task_deps.size(),
+                    task_deps.data());
+        }
+    }
+    // Empty task to track the end of the replay without waiting for it
+    starpu_task *last = starpu_task_create();
+    last->cl = nullptr;
+    last->callback_func = _replay_callback;
+    last->callback_arg = this;
+    task_deps.clear();
+    for(auto sink: sinks)
+    {
+        task_deps.push_back(tasks[sink]);
+    }
+    starpu_task_declare_deps_array(last, task_deps.size(), task_deps.data());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++nreplays;
+    }
+    tasks.push_back(last);
+    for(auto task: tasks)
+    {
+        int ret = starpu_task_submit(task);
+        if(ret != 0)
+        {
+            throw std::runtime_error("Error in task graph replay");
+        }
+    }
+}
+
+void TaskGraph::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this](){return nreplays == 0;});
+}
+
+Index TaskGraph::count(const std::string &prefix) const
+{
+    return std::count_if(capture.tasks.begin(), capture.tasks.end(),
+            [&prefix](const TaskRecord &rec)
+            {
+                return rec.cl != nullptr && rec.cl->name != nullptr
+                    && std::strncmp(rec.cl->name, prefix.c_str(),
+                            prefix.size()) == 0;
+            });
+}
+
+void TaskGraph::clear()
+{
+    // Replayed tasks read arguments and dependencies, kept by the graph
+    wait();
+    capture.tasks.clear();
+    capture.unregistered.clear();
+    // Workspace is unregistered after all the tasks, that use it
+    for(auto handle: capture.workspace)
+    {
+        starpu_data_unregister_submit(handle);
+    }
+    capture.workspace.clear();
+    deps.clear();
+    seq_consistency.clear();
+    sinks.clear();
+}
+
+} // namespace nntile::starpu
@@ -169,10 +169,11 @@ void submit(Index nelems, Scalar alpha, Handle src, Scalar beta, Handle dst)
     args->alpha = alpha;
     args->beta = beta;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(src),
             STARPU_CL_ARGS, args, sizeof(*args),
-            dst_mode, static_cast<starpu_data_handle_t>(dst), 0);
+            dst_mode, static_cast<starpu_data_handle_t>(dst),
+            STARPU_PRIORITY, Config::task_priority, 0);
             // STARPU_FLOPS, nflops);
     // Check submission
     if(ret != 0)
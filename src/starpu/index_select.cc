@@ -0,0 +1,237 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/starpu/index_select.cc
+ * Selection of slices along an axis by indices
+ *
+ * @version 1.1.0
+ * */
+
+#ifndef STARPU_SIMGRID
+#include "nntile/kernel/index_select.hh"
+#endif // STARPU_SIMGRID
+#include "nntile/starpu/index_select.hh"
+
+namespace nntile::starpu::index_select
+{
+
+//! Gather slices of an array by indices within StarPU buffers on CPU
+template<typename T>
+void cpu(void *buffers[], void *cl_args)
+    noexcept
+{
+#ifndef STARPU_SIMGRID // Run the code only if this is not a simulation
+    // Get arguments
+    auto args = reinterpret_cast<args_t *>(cl_args);
+    // Get interfaces
+    auto interfaces = reinterpret_cast<VariableInterface **>(buffers);
+    const int64_t *index = interfaces[0]->get_ptr<int64_t>();
+    const T *src = interfaces[1]->get_ptr<T>();
+    T *dst = interfaces[2]->get_ptr<T>();
+    // Launch kernel
+    kernel::index_select::cpu<T>(args->m, args->n, args->k, args->src_n,
+            index, src, dst);
+#endif // STARPU_SIMGRID
+}
+
+#ifdef NNTILE_USE_CUDA
+//! Gather slices of an array by indices within StarPU buffers on CUDA
+template<typename T>
+void cuda(void *buffers[], void *cl_args)
+    noexcept
+{
+#ifndef STARPU_SIMGRID // Run the code only if this is not a simulation
+    // Get arguments
+    auto args = reinterpret_cast<args_t *>(cl_args);
+    // Get interfaces
+    auto interfaces = reinterpret_cast<VariableInterface **>(buffers);
+    const int64_t *index = interfaces[0]->get_ptr<int64_t>();
+    const T *src = interfaces[1]->get_ptr<T>();
+    T *dst = interfaces[2]->get_ptr<T>();
+    // Get CUDA stream
+    cudaStream_t stream = starpu_cuda_get_local_stream();
+    // Launch kernel
+    kernel::index_select::cuda<T>(stream, args->m, args->n, args->k,
+            args->src_n, index, src, dst);
+#endif // STARPU_SIMGRID
+}
+#endif // NNTILE_USE_CUDA
+
+//! Footprint for index_select tasks that depends only on cl_arg
+static
+uint32_t footprint(struct starpu_task *task)
+{
+    // Get arguments
+    auto args = reinterpret_cast<args_t *>(task->cl_arg);
+    // Apply hash over parameters m, n, k and src_n
+    uint32_t hash = 0;
+    hash = starpu_hash_crc32c_be_n(&args->m, sizeof(args->m), hash);
+    hash = starpu_hash_crc32c_be_n(&args->n, sizeof(args->n), hash);
+    hash = starpu_hash_crc32c_be_n(&args->k, sizeof(args->k), hash);
+    hash = starpu_hash_crc32c_be_n(&args->src_n, sizeof(args->src_n), hash);
+    return hash;
+}
+
+Codelet codelet_fp32, codelet_fp64, codelet_fp32_fast_tf32, codelet_bf16,
+        codelet_fp32_fast_fp16, codelet_fp32_fast_bf16, codelet_int64;
+
+void init()
+{
+    codelet_fp32.init("nntile_index_select_fp32",
+            footprint,
+            {cpu<fp32_t>},
+#ifdef NNTILE_USE_CUDA
+            {cuda<fp32_t>}
+#else // NNTILE_USE_CUDA
+            {}
+#endif // NNTILE_USE_CUDA
+            );
+
+    codelet_bf16.init("nntile_index_select_bf16",
+            footprint,
+            {cpu<bf16_t>},
+#ifdef NNTILE_USE_CUDA
+            {cuda<bf16_t>}
+#else // NNTILE_USE_CUDA
+            {}
+#endif // NNTILE_USE_CUDA
+            );
+
+    codelet_fp32_fast_tf32.init("nntile_index_select_fp32_fast_tf32",
+            footprint,
+            {cpu<fp32_t>},
+#ifdef NNTILE_USE_CUDA
+            {cuda<fp32_t>}
+#else // NNTILE_USE_CUDA
+            {}
+#endif // NNTILE_USE_CUDA
+            );
+
+    codelet_fp32_fast_fp16.init("nntile_index_select_fp32_fast_fp16",
+            footprint,
+            {cpu<fp32_t>},
+#ifdef NNTILE_USE_CUDA
+            {cuda<fp32_t>}
+#else // NNTILE_USE_CUDA
+            {}
+#endif // NNTILE_USE_CUDA
+            );
+
+    codelet_fp32_fast_bf16.init("nntile_index_select_fp32_fast_bf16",
+            footprint,
+            {cpu<fp32_t>},
+#ifdef NNTILE_USE_CUDA
+            {cuda<fp32_t>}
+#else // NNTILE_USE_CUDA
+            {}
+#endif // NNTILE_USE_CUDA
+            );
+
+    codelet_fp64.init("nntile_index_select_fp64",
+            footprint,
+            {cpu<fp64_t>},
+#ifdef NNTILE_USE_CUDA
+            {cuda<fp64_t>}
+#else // NNTILE_USE_CUDA
+            {}
+#endif // NNTILE_USE_CUDA
+            );
+
+    codelet_int64.init("nntile_index_select_int64",
+            footprint,
+            {cpu<int64_t>},
+#ifdef NNTILE_USE_CUDA
+            {cuda<int64_t>}
+#else // NNTILE_USE_CUDA
+            {}
+#endif // NNTILE_USE_CUDA
+            );
+}
+
+void restrict_where(uint32_t where)
+{
+    codelet_fp32.restrict_where(where);
+    codelet_bf16.restrict_where(where);
+    codelet_fp32_fast_tf32.restrict_where(where);
+    codelet_fp32_fast_fp16.restrict_where(where);
+    codelet_fp32_fast_bf16.restrict_where(where);
+    codelet_fp64.restrict_where(where);
+    codelet_int64.restrict_where(where);
+}
+
+void restore_where()
+{
+    codelet_fp32.restore_where();
+    codelet_bf16.restore_where();
+    codelet_fp32_fast_tf32.restore_where();
+    codelet_fp32_fast_fp16.restore_where();
+    codelet_fp32_fast_bf16.restore_where();
+    codelet_fp64.restore_where();
+    codelet_int64.restore_where();
+}
+
+template<typename T>
+void submit(Index m, Index n, Index k, Index src_n, Handle index, Handle src,
+        Handle dst)
+//! Insert index_select task into StarPU pool of tasks
+/*! No argument checking is performed. All the inputs are packed and passed to
+ * starpu_task_insert() function. If task submission fails, this routines
+ * throws an std::runtime_error() exception.
+ * */
+{
+    // Codelet arguments
+    args_t *args = (args_t *)std::malloc(sizeof(*args));
+    args->m = m;
+    args->n = n;
+    args->k = k;
+    args->src_n = src_n;
+    // Submit task
+    int ret = task_insert(codelet<T>(),
+            STARPU_R, static_cast<starpu_data_handle_t>(index),
+            STARPU_R, static_cast<starpu_data_handle_t>(src),
+            STARPU_W, static_cast<starpu_data_handle_t>(dst),
+            STARPU_CL_ARGS, args, sizeof(*args),
+            STARPU_PRIORITY, Config::task_priority,
+            0);
+    // Check submission
+    if(ret != 0)
+    {
+        throw std::runtime_error("Error in index_select task submission");
+    }
+}
+
+// Explicit instantiation
+template
+void submit<fp32_t>(Index m, Index n, Index k, Index src_n, Handle index,
+        Handle src, Handle dst);
+
+template
+void submit<bf16_t>(Index m, Index n, Index k, Index src_n, Handle index,
+        Handle src, Handle dst);
+
+template
+void submit<fp32_fast_tf32_t>(Index m, Index n, Index k, Index src_n,
+        Handle index, Handle src, Handle dst);
+
+template
+void submit<fp32_fast_fp16_t>(Index m, Index n, Index k, Index src_n,
+        Handle index, Handle src, Handle dst);
+
+template
+void submit<fp32_fast_bf16_t>(Index m, Index n, Index k, Index src_n,
+        Handle index, Handle src, Handle dst);
+
+template
+void submit<fp64_t>(Index m, Index n, Index k, Index src_n, Handle index,
+        Handle src, Handle dst);
+
+template
+void submit<int64_t>(Index m, Index n, Index k, Index src_n, Handle index,
+        Handle src, Handle dst);
+
+} // namespace nntile::starpu::index_select
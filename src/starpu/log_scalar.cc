@@ -103,9 +103,10 @@ void submit(const std::string &name, Handle value)
     args_t *args = new args_t;
     args->name = name;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(value),
             STARPU_CL_ARGS_NFREE, args, sizeof(*args),
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -156,11 +156,12 @@ void submit(Index nelems, Handle maxsumexp, Handle logsumexp)
     Index *nelems_ = (Index *)std::malloc(sizeof(*nelems_));
     *nelems_ = nelems;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(maxsumexp),
             STARPU_CL_ARGS, nelems_, sizeof(*nelems_),
             STARPU_W, static_cast<starpu_data_handle_t>(logsumexp),
             //STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
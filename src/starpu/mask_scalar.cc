@@ -175,11 +175,12 @@ void submit(Index nrows, Index ncols, Handle mask, Scalar val, Handle data)
     // Indicate maximal possible amount of writes as flops count
     double nflops = sizeof(T) * nrows * (ncols+1);
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_RW, static_cast<starpu_data_handle_t>(data),
             STARPU_R, static_cast<starpu_data_handle_t>(mask),
             STARPU_CL_ARGS, args, sizeof(*args),
             STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -0,0 +1,126 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/starpu/mask_varlen.cc
+ * StarPU wrappers for boolean mask of packed sequences
+ *
+ * @version 1.1.0
+ * */
+
+#ifndef STARPU_SIMGRID
+#include "nntile/kernel/mask_varlen.hh"
+#endif // STARPU_SIMGRID
+#include "nntile/starpu/mask_varlen.hh"
+
+namespace nntile::starpu::mask_varlen
+{
+
+//! Set columns of a boolean mask in StarPU buffer on CPU
+void cpu(void *buffers[], void *cl_args)
+    noexcept
+{
+#ifndef STARPU_SIMGRID // Run the code only if this is not a simulation
+    // Get arguments
+    auto args = reinterpret_cast<args_t *>(cl_args);
+    // Get interfaces
+    auto interfaces = reinterpret_cast<VariableInterface **>(buffers);
+    bool_t *mask = interfaces[0]->get_ptr<bool_t>();
+    // Launch kernel
+    kernel::mask_varlen::cpu(args->m, args->n, args->i_lo, args->i_hi,
+            args->diag, mask+args->offset*args->m);
+#endif // STARPU_SIMGRID
+}
+
+#ifdef NNTILE_USE_CUDA
+//! Set columns of a boolean mask in StarPU buffer on CUDA
+void cuda(void *buffers[], void *cl_args)
+    noexcept
+{
+#ifndef STARPU_SIMGRID // Run the code only if this is not a simulation
+    // Get arguments
+    auto args = reinterpret_cast<args_t *>(cl_args);
+    // Get interfaces
+    auto interfaces = reinterpret_cast<VariableInterface **>(buffers);
+    bool_t *mask = interfaces[0]->get_ptr<bool_t>();
+    // Get CUDA stream
+    cudaStream_t stream = starpu_cuda_get_local_stream();
+    // Launch kernel
+    kernel::mask_varlen::cuda(stream, args->m, args->n, args->i_lo,
+            args->i_hi, args->diag, mask+args->offset*args->m);
+#endif // STARPU_SIMGRID
+}
+#endif // NNTILE_USE_CUDA
+
+//! Footprint for mask_varlen tasks
+static
+uint32_t footprint(struct starpu_task *task)
+{
+    // Get arguments
+    auto args = reinterpret_cast<args_t *>(task->cl_arg);
+    // Apply hash over parameters m and n
+    uint32_t hash = 0;
+    hash = starpu_hash_crc32c_be_n(&args->m, sizeof(args->m), hash);
+    hash = starpu_hash_crc32c_be_n(&args->n, sizeof(args->n), hash);
+    return hash;
+}
+
+Codelet codelet;
+
+void init()
+{
+    codelet.init("nntile_mask_varlen",
+            footprint,
+            {cpu},
+#ifdef NNTILE_USE_CUDA
+            {cuda}
+#else // NNTILE_USE_CUDA
+            {}
+#endif // NNTILE_USE_CUDA
+            );
+}
+
+void restrict_where(uint32_t where)
+{
+    codelet.restrict_where(where);
+}
+
+void restore_where()
+{
+    codelet.restore_where();
+}
+
+void submit(Index m, Index n, Index offset, Index i_lo, Index i_hi,
+        Index diag, Handle mask)
+//! Insert mask_varlen task into StarPU pool of tasks
+/*! Task sets n columns of the m by n mask, starting from column offset. Other
+ * columns are left intact, so tasks for different sequences of the same tile
+ * are submitted with STARPU_RW access mode.
+ * */
+{
+    // Codelet arguments
+    args_t *args = (args_t *)std::malloc(sizeof(*args));
+    args->m = m;
+    args->n = n;
+    args->offset = offset;
+    args->i_lo = i_lo;
+    args->i_hi = i_hi;
+    args->diag = diag;
+    // Submit task
+    int ret = task_insert(&codelet,
+            STARPU_RW, static_cast<starpu_data_handle_t>(mask),
+            STARPU_CL_ARGS, args, sizeof(*args),
+            STARPU_PRIORITY, Config::task_priority,
+            0);
+    // Check submission
+    if(ret != 0)
+    {
+        throw std::runtime_error("Error in mask_varlen task submission");
+    }
+}
+
+} // namespace nntile::starpu::mask_varlen
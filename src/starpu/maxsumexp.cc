@@ -190,11 +190,12 @@ void submit(Index m, Index n, Index k, Handle src, Handle dst, int redux)
     // Put amount of bytes read and write inplace of gflops
     double nflops = sizeof(T) * m * (k+2) * n;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(src),
             STARPU_CL_ARGS, args, sizeof(*args),
             dst_mode, static_cast<starpu_data_handle_t>(dst),
             STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -137,12 +137,13 @@ void submit(Index m, Index n, Index k, Index l, Scalar eps, Handle gamma_beta,
     };
     double nflops = 14 * m * n * k;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(gamma_beta),
             STARPU_R, static_cast<starpu_data_handle_t>(sumnorm),
             STARPU_RW, static_cast<starpu_data_handle_t>(dst),
             STARPU_CL_ARGS, args, sizeof(*args),
             STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
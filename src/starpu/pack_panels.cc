@@ -0,0 +1,160 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/starpu/pack_panels.cc
+ * StarPU wrappers for packing of a matrix into panels of rows
+ *
+ * @version 1.1.0
+ * */
+
+#ifndef STARPU_SIMGRID
+#include "nntile/kernel/pack_panels.hh"
+#endif // STARPU_SIMGRID
+#include "nntile/starpu/pack_panels.hh"
+
+namespace nntile::starpu::pack_panels
+{
+
+//! Packing of a matrix into panels of rows within StarPU buffers on CPU
+template<typename T>
+void cpu(void *buffers[], void *cl_args)
+    noexcept
+{
+#ifndef STARPU_SIMGRID // Run the code only if this is not a simulation
+    // Get arguments
+    auto args = reinterpret_cast<args_t *>(cl_args);
+    // Get interfaces
+    auto interfaces = reinterpret_cast<VariableInterface **>(buffers);
+    const T *src = interfaces[0]->get_ptr<T>();
+    T *dst = interfaces[1]->get_ptr<T>();
+    // Launch kernel
+    kernel::pack_panels::cpu<T>(args->m, args->k, src, dst);
+#endif // STARPU_SIMGRID
+}
+
+//! Footprint for pack_panels tasks that depends only on cl_arg
+static
+uint32_t footprint(struct starpu_task *task)
+{
+    // Get arguments
+    auto args = reinterpret_cast<args_t *>(task->cl_arg);
+    // Apply hash over parameters m and k
+    uint32_t hash = 0;
+    hash = starpu_hash_crc32c_be_n(&args->m, sizeof(args->m), hash);
+    hash = starpu_hash_crc32c_be_n(&args->k, sizeof(args->k), hash);
+    return hash;
+}
+
+Codelet codelet_fp32, codelet_fp64, codelet_fp32_fast_tf32, codelet_bf16,
+        codelet_fp32_fast_fp16, codelet_fp32_fast_bf16;
+
+void init()
+{
+    codelet_fp32.init("nntile_pack_panels_fp32",
+            footprint,
+            {cpu<fp32_t>},
+            {}
+            );
+
+    codelet_bf16.init("nntile_pack_panels_bf16",
+            footprint,
+            {cpu<bf16_t>},
+            {}
+            );
+
+    codelet_fp32_fast_tf32.init("nntile_pack_panels_fp32_fast_tf32",
+            footprint,
+            {cpu<fp32_t>},
+            {}
+            );
+
+    codelet_fp32_fast_fp16.init("nntile_pack_panels_fp32_fast_fp16",
+            footprint,
+            {cpu<fp32_t>},
+            {}
+            );
+
+    codelet_fp32_fast_bf16.init("nntile_pack_panels_fp32_fast_bf16",
+            footprint,
+            {cpu<fp32_t>},
+            {}
+            );
+
+    codelet_fp64.init("nntile_pack_panels_fp64",
+            footprint,
+            {cpu<fp64_t>},
+            {}
+            );
+}
+
+void restrict_where(uint32_t where)
+{
+    codelet_fp32.restrict_where(where);
+    codelet_bf16.restrict_where(where);
+    codelet_fp32_fast_tf32.restrict_where(where);
+    codelet_fp32_fast_fp16.restrict_where(where);
+    codelet_fp32_fast_bf16.restrict_where(where);
+    codelet_fp64.restrict_where(where);
+}
+
+void restore_where()
+{
+    codelet_fp32.restore_where();
+    codelet_bf16.restore_where();
+    codelet_fp32_fast_tf32.restore_where();
+    codelet_fp32_fast_fp16.restore_where();
+    codelet_fp32_fast_bf16.restore_where();
+    codelet_fp64.restore_where();
+}
+
+template<typename T>
+void submit(Index m, Index k, Handle src, Handle dst)
+//! Insert pack_panels task into StarPU pool of tasks
+/*! No argument checking is performed. All the inputs are packed and passed to
+ * starpu_task_insert() function. If task submission fails, this routines
+ * throws an std::runtime_error() exception.
+ * */
+{
+    // Codelet arguments
+    args_t *args = (args_t *)std::malloc(sizeof(*args));
+    args->m = m;
+    args->k = k;
+    // Submit task
+    int ret = task_insert(codelet<T>(),
+            STARPU_R, static_cast<starpu_data_handle_t>(src),
+            STARPU_W, static_cast<starpu_data_handle_t>(dst),
+            STARPU_CL_ARGS, args, sizeof(*args),
+            STARPU_PRIORITY, Config::task_priority,
+            0);
+    // Check submission
+    if(ret != 0)
+    {
+        throw std::runtime_error("Error in pack_panels task submission");
+    }
+}
+
+// Explicit instantiation
+template
+void submit<fp32_t>(Index m, Index k, Handle src, Handle dst);
+
+template
+void submit<bf16_t>(Index m, Index k, Handle src, Handle dst);
+
+template
+void submit<fp32_fast_tf32_t>(Index m, Index k, Handle src, Handle dst);
+
+template
+void submit<fp32_fast_fp16_t>(Index m, Index k, Handle src, Handle dst);
+
+template
+void submit<fp32_fast_bf16_t>(Index m, Index k, Handle src, Handle dst);
+
+template
+void submit<fp64_t>(Index m, Index k, Handle src, Handle dst);
+
+} // namespace nntile::starpu::pack_panels
@@ -107,9 +107,10 @@ void submit(Index nelems, Scalar alpha, Scalar exp, Handle data)
     args->alpha = alpha;
     args->exp = exp;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_RW, static_cast<starpu_data_handle_t>(data),
             STARPU_CL_ARGS, args, sizeof(*args),
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -128,12 +128,13 @@ void submit(Index nelems, Handle src1, Handle src2, Handle dst)
     Index *nelems_ = new Index{nelems};
     // Put amount of read-write bytes into flop count
     double nflops = sizeof(T) * 3 * nelems;
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(src1),
             STARPU_R, static_cast<starpu_data_handle_t>(src2),
             STARPU_W, static_cast<starpu_data_handle_t>(dst),
             STARPU_CL_ARGS, nelems_, sizeof(*nelems_),
             STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
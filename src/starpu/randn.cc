@@ -161,7 +161,7 @@ void submit(Index ndim, Index nelems, unsigned long long seed,
     int ret;
     if(ndim > 0)
     {
-        ret = starpu_task_insert(codelet<T>(),
+        ret = task_insert(codelet<T>(),
                 STARPU_VALUE, &ndim, sizeof(ndim),
                 STARPU_VALUE, &nelems, sizeof(nelems),
                 STARPU_VALUE, &seed, sizeof(seed),
@@ -175,16 +175,18 @@ void submit(Index ndim, Index nelems, unsigned long long seed,
                 STARPU_W, static_cast<starpu_data_handle_t>(data),
                 STARPU_SCRATCH, static_cast<starpu_data_handle_t>(tmp_index),
                 STARPU_FLOPS, nflops,
+                STARPU_PRIORITY, Config::task_priority,
                 0);
     }
     else
     {
-        ret = starpu_task_insert(codelet_ndim0<T>(),
+        ret = task_insert(codelet_ndim0<T>(),
                 STARPU_VALUE, &seed, sizeof(seed),
                 STARPU_VALUE, &mean, sizeof(mean),
                 STARPU_VALUE, &stddev, sizeof(stddev),
                 STARPU_W, static_cast<starpu_data_handle_t>(data),
                 STARPU_FLOPS, nflops,
+                STARPU_PRIORITY, Config::task_priority,
                 0);
     }
     // Check submission
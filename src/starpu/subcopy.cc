@@ -83,7 +83,7 @@ uint32_t footprint(struct starpu_task *task)
 
 //Codelet codelet_fp16;
 Codelet codelet_fp32, codelet_fp64, codelet_int64,
-        codelet_bool, codelet_fp32_fast_tf32, codelet_bf16,
+        codelet_bool, codelet_int8, codelet_fp32_fast_tf32, codelet_bf16,
         codelet_fp32_fast_fp16, codelet_fp32_fast_bf16;
 
 void init()
@@ -122,6 +122,15 @@ void init()
             {cuda<bool_t>}
 #else // NNTILE_USE_CUDA
             {}
+#endif // NNTILE_USE_CUDA
+            );
+    codelet_int8.init("nntile_subcopy_int8",
+            footprint,
+            {cpu<int8_t>},
+#ifdef NNTILE_USE_CUDA
+            {cuda<int8_t>}
+#else // NNTILE_USE_CUDA
+            {}
 #endif // NNTILE_USE_CUDA
             );
     codelet_fp32_fast_tf32.init("nntile_subcopy_fp32_fast_tf32",
@@ -169,6 +178,7 @@ void restrict_where(uint32_t where)
     codelet_fp64.restrict_where(where);
     codelet_int64.restrict_where(where);
     codelet_bool.restrict_where(where);
+    codelet_int8.restrict_where(where);
     codelet_fp32_fast_tf32.restrict_where(where);
     codelet_fp32_fast_fp16.restrict_where(where);
     codelet_fp32_fast_bf16.restrict_where(where);
@@ -182,6 +192,7 @@ void restore_where()
     codelet_fp64.restore_where();
     codelet_int64.restore_where();
     codelet_bool.restore_where();
+    codelet_int8.restore_where();
     codelet_fp32_fast_tf32.restore_where();
     codelet_fp32_fast_fp16.restore_where();
     codelet_fp32_fast_bf16.restore_where();
@@ -198,7 +209,7 @@ void submit(Index ndim, const std::vector<Index> &src_start,
 {
     constexpr double nflops = 0;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_VALUE, &(ndim), sizeof(ndim),
             STARPU_VALUE, &(src_start[0]), ndim*sizeof(src_start[0]),
             STARPU_VALUE, &(src_stride[0]), ndim*sizeof(src_stride[0]),
@@ -209,6 +220,7 @@ void submit(Index ndim, const std::vector<Index> &src_start,
             mode, static_cast<starpu_data_handle_t>(dst),
             STARPU_SCRATCH, static_cast<starpu_data_handle_t>(tmp_index),
             STARPU_FLOPS, nflops, // No floating point operations
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -282,6 +294,14 @@ void submit<bool_t>(Index ndim, const std::vector<Index> &src_start,
         const std::vector<Index> &copy_shape, Handle src, Handle dst,
         Handle tmp_index, starpu_data_access_mode mode);
 
+template
+void submit<int8_t>(Index ndim, const std::vector<Index> &src_start,
+        const std::vector<Index> &src_stride,
+        const std::vector<Index> &dst_start,
+        const std::vector<Index> &dst_stride,
+        const std::vector<Index> &copy_shape, Handle src, Handle dst,
+        Handle tmp_index, starpu_data_access_mode mode);
+
 template
 void submit<bf16_t>(Index ndim, const std::vector<Index> &src_start,
         const std::vector<Index> &src_stride,
@@ -173,12 +173,13 @@ void submit(Index n_labels, Index n_outputs, Scalar val, Handle labels, Handle d
     args->n_outputs = n_outputs;
     args->value = val;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(labels),
             STARPU_CL_ARGS, args, sizeof(*args),
             STARPU_RW, static_cast<starpu_data_handle_t>(dst),
             //Config::STARPU_RW_COMMUTE, static_cast<starpu_data_handle_t>(dst),
             //STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -127,11 +127,12 @@ void submit(Index m, Index n, Index k, Handle src, Handle dst)
     };
     //double nflops = m * n * k;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(src),
             STARPU_CL_ARGS, args, sizeof(*args),
             Config::STARPU_RW_COMMUTE, static_cast<starpu_data_handle_t>(dst),
             //STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -208,12 +208,13 @@ void submit(Index m, Index n, Index k, Scalar alpha, Handle src1, Handle src2,
     double nflops = beta == 0.0 ? 2*src1_nbytes + dst_nbytes :
         2 * (src1_nbytes+dst_nbytes);
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(src1),
             STARPU_R, static_cast<starpu_data_handle_t>(src2),
             STARPU_CL_ARGS, args, sizeof(*args),
             dst_mode, static_cast<starpu_data_handle_t>(dst),
             STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -181,12 +181,13 @@ void submit(Scalar alpha, Index n_labels, Index n_outputs, Handle logsumexp,
     args->n_labels = n_labels;
     args->n_outputs = n_outputs;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(logsumexp),
             STARPU_R, static_cast<starpu_data_handle_t>(src),
             STARPU_R, static_cast<starpu_data_handle_t>(class_labels),
             STARPU_CL_ARGS, args, sizeof(*args),
             Config::STARPU_RW_COMMUTE, static_cast<starpu_data_handle_t>(val),
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -175,11 +175,12 @@ void submit(Index m, Index n, Scalar alpha, Handle src, Handle dst)
     // Put amount of read-write bytes into flop count
     double nflops = sizeof(T) * 2 * m * n;
     // Submit task
-    int ret = starpu_task_insert(codelet<T>(),
+    int ret = task_insert(codelet<T>(),
             STARPU_R, static_cast<starpu_data_handle_t>(src),
             STARPU_W, static_cast<starpu_data_handle_t>(dst),
             STARPU_CL_ARGS, args, sizeof(*args),
             STARPU_FLOPS, nflops,
+            STARPU_PRIORITY, Config::task_priority,
             0);
     // Check submission
     if(ret != 0)
@@ -0,0 +1,214 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/tensor/beam_topk.cc
+ * Top-k largest elements of a tensor for beam search
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/beam_topk.hh"
+#include "nntile/starpu/beam_topk.hh"
+
+namespace nntile::tensor
+{
+
+//! Asynchronous tensor-wise beam search top-k operation
+/*! Find k largest elements among all elements of src (e.g., scores of all
+ * continuations of all beams) together with their positions. Index along the
+ * first axis of src is a token, while indices along all other axes, flattened
+ * in column-major order, form a beam. All tiles of src are reduced one after
+ * another into a single tile of output, so the output is exact for any tiling
+ * of src along the first and the last axes.
+ *
+ * @param[in] src: Input tensor of shape [vocab_size, ..., num_beams]. It may
+ *      be split into tiles only along the first and the last axes.
+ * @param[out] dst_val: Largest values in descending order. It is a tensor of
+ *      k elements of any shape (e.g., [1, k] to be used as an input of the
+ *      next decoding step), which is not split into tiles.
+ * @param[out] dst_idx: First-axis indices (tokens) of the largest values. It
+ *      has the same shape as dst_val.
+ * @param[out] dst_beam: Beams of the largest values. It has the same shape
+ *      as dst_val.
+ * */
+template<typename T>
+void beam_topk_async(const Tensor<T> &src, const Tensor<T> &dst_val,
+        const Tensor<int64_t> &dst_idx, const Tensor<int64_t> &dst_beam)
+{
+    // Check dimensions
+    if(src.ndim == 0)
+    {
+        throw std::runtime_error("Scalar input makes no sense");
+    }
+    if(dst_val.shape != dst_idx.shape)
+    {
+        throw std::runtime_error("dst_val.shape != dst_idx.shape");
+    }
+    if(dst_val.shape != dst_beam.shape)
+    {
+        throw std::runtime_error("dst_val.shape != dst_beam.shape");
+    }
+    // Check shapes
+    Index k = dst_val.nelems;
+    if(k <= 0)
+    {
+        throw std::runtime_error("dst_val.nelems <= 0");
+    }
+    if(k > src.nelems)
+    {
+        throw std::runtime_error("dst_val.nelems > src.nelems");
+    }
+    if(dst_val.grid.nelems != 1)
+    {
+        throw std::runtime_error("dst_val.grid.nelems != 1");
+    }
+    if(dst_idx.grid.nelems != 1)
+    {
+        throw std::runtime_error("dst_idx.grid.nelems != 1");
+    }
+    if(dst_beam.grid.nelems != 1)
+    {
+        throw std::runtime_error("dst_beam.grid.nelems != 1");
+    }
+    for(Index i = 1; i < src.ndim-1; ++i)
+    {
+        if(src.basetile_shape[i] != src.shape[i])
+        {
+            throw std::runtime_error("src.basetile_shape[i] != src.shape[i]");
+        }
+    }
+    // Number of beams within a single index along the last axis
+    Index beam_stride = 1;
+    for(Index i = 1; i < src.ndim-1; ++i)
+    {
+        beam_stride *= src.shape[i];
+    }
+    // Do actual calculations
+    int mpi_rank = starpu_mpi_world_rank();
+    auto dst_val_tile_handle = dst_val.get_tile_handle(0);
+    auto dst_idx_tile_handle = dst_idx.get_tile_handle(0);
+    auto dst_beam_tile_handle = dst_beam.get_tile_handle(0);
+    int dst_tile_rank = dst_val_tile_handle.mpi_get_rank();
+    if(dst_idx_tile_handle.mpi_get_rank() != dst_tile_rank
+            or dst_beam_tile_handle.mpi_get_rank() != dst_tile_rank)
+    {
+        throw std::runtime_error("Tiles of dst_val, dst_idx and dst_beam are "
+                "owned by different nodes");
+    }
+    // Reduce over all tiles of src
+    for(Index j = 0; j < src.grid.nelems; ++j)
+    {
+        auto src_tile_handle = src.get_tile_handle(j);
+        // Transfer data
+        src_tile_handle.mpi_transfer(dst_tile_rank, mpi_rank);
+        // Execute on destination node
+        if(mpi_rank == dst_tile_rank)
+        {
+            auto src_tile_index = src.grid.linear_to_index(j);
+            auto src_tile_traits = src.get_tile_traits(j);
+            Index m = src_tile_traits.shape[0];
+            Index n = src_tile_traits.matrix_shape[1][1];
+            Index row_offset = src_tile_index[0] * src.basetile_shape[0];
+            Index col_offset = 0;
+            if(src.ndim > 1)
+            {
+                col_offset = src_tile_index[src.ndim-1]
+                    * src.basetile_shape[src.ndim-1] * beam_stride;
+            }
+            starpu::beam_topk::submit<T>(m, n, k, row_offset, col_offset,
+                    j == 0, src_tile_handle, dst_val_tile_handle,
+                    dst_idx_tile_handle, dst_beam_tile_handle);
+        }
+    }
+    // Flush cache for the output tiles on every node
+    dst_val_tile_handle.mpi_flush();
+    dst_idx_tile_handle.mpi_flush();
+    dst_beam_tile_handle.mpi_flush();
+}
+
+//! Blocking version of tensor-wise beam search top-k operation
+/*! Find k largest elements among all elements of src together with their
+ * positions.
+ *
+ * @param[in] src: Input tensor of shape [vocab_size, ..., num_beams]
+ * @param[out] dst_val: Largest values in descending order
+ * @param[out] dst_idx: First-axis indices (tokens) of the largest values
+ * @param[out] dst_beam: Beams of the largest values
+ * */
+template<typename T>
+void beam_topk(const Tensor<T> &src, const Tensor<T> &dst_val,
+        const Tensor<int64_t> &dst_idx, const Tensor<int64_t> &dst_beam)
+{
+    beam_topk_async<T>(src, dst_val, dst_idx, dst_beam);
+    starpu_task_wait_for_all();
+    starpu_mpi_wait_for_all(MPI_COMM_WORLD);
+}
+
+// Explicit instantiation
+template
+void beam_topk_async<fp32_t>(const Tensor<fp32_t> &src,
+        const Tensor<fp32_t> &dst_val, const Tensor<int64_t> &dst_idx,
+        const Tensor<int64_t> &dst_beam);
+
+template
+void beam_topk_async<fp32_fast_tf32_t>(const Tensor<fp32_fast_tf32_t> &src,
+        const Tensor<fp32_fast_tf32_t> &dst_val,
+        const Tensor<int64_t> &dst_idx, const Tensor<int64_t> &dst_beam);
+
+template
+void beam_topk_async<fp32_fast_fp16_t>(const Tensor<fp32_fast_fp16_t> &src,
+        const Tensor<fp32_fast_fp16_t> &dst_val,
+        const Tensor<int64_t> &dst_idx, const Tensor<int64_t> &dst_beam);
+
+template
+void beam_topk_async<fp32_fast_bf16_t>(const Tensor<fp32_fast_bf16_t> &src,
+        const Tensor<fp32_fast_bf16_t> &dst_val,
+        const Tensor<int64_t> &dst_idx, const Tensor<int64_t> &dst_beam);
+
+template
+void beam_topk_async<fp64_t>(const Tensor<fp64_t> &src,
+        const Tensor<fp64_t> &dst_val, const Tensor<int64_t> &dst_idx,
+        const Tensor<int64_t> &dst_beam);
+
+template
+void beam_topk_async<bf16_t>(const Tensor<bf16_t> &src,
+        const Tensor<bf16_t> &dst_val, const Tensor<int64_t> &dst_idx,
+        const Tensor<int64_t> &dst_beam);
+
+// Explicit instantiation
+template
+void beam_topk<fp32_t>(const Tensor<fp32_t> &src,
+        const Tensor<fp32_t> &dst_val, const Tensor<int64_t> &dst_idx,
+        const Tensor<int64_t> &dst_beam);
+
+template
+void beam_topk<fp32_fast_tf32_t>(const Tensor<fp32_fast_tf32_t> &src,
+        const Tensor<fp32_fast_tf32_t> &dst_val,
+        const Tensor<int64_t> &dst_idx, const Tensor<int64_t> &dst_beam);
+
+template
+void beam_topk<fp32_fast_fp16_t>(const Tensor<fp32_fast_fp16_t> &src,
+        const Tensor<fp32_fast_fp16_t> &dst_val,
+        const Tensor<int64_t> &dst_idx, const Tensor<int64_t> &dst_beam);
+
+template
+void beam_topk<fp32_fast_bf16_t>(const Tensor<fp32_fast_bf16_t> &src,
+        const Tensor<fp32_fast_bf16_t> &dst_val,
+        const Tensor<int64_t> &dst_idx, const Tensor<int64_t> &dst_beam);
+
+template
+void beam_topk<fp64_t>(const Tensor<fp64_t> &src,
+        const Tensor<fp64_t> &dst_val, const Tensor<int64_t> &dst_idx,
+        const Tensor<int64_t> &dst_beam);
+
+template
+void beam_topk<bf16_t>(const Tensor<bf16_t> &src,
+        const Tensor<bf16_t> &dst_val, const Tensor<int64_t> &dst_idx,
+        const Tensor<int64_t> &dst_beam);
+
+} // namespace nntile::tensor
@@ -424,6 +424,11 @@ void copy_intersection_async<bool_t>(const Tensor<bool_t> &src,
         const std::vector<Index> &src_offset, const Tensor<bool_t> &dst,
         const std::vector<Index> &dst_offset);
 
+template
+void copy_intersection_async<int8_t>(const Tensor<int8_t> &src,
+        const std::vector<Index> &src_offset, const Tensor<int8_t> &dst,
+        const std::vector<Index> &dst_offset);
+
 template
 void copy_intersection_async<fp32_t>(const Tensor<fp32_t> &src,
         const std::vector<Index> &src_offset, const Tensor<fp32_t> &dst,
@@ -445,6 +450,11 @@ void copy_intersection<bool_t>(const Tensor<bool_t> &src,
         const std::vector<Index> &src_offset, const Tensor<bool_t> &dst,
         const std::vector<Index> &dst_offset);
 
+template
+void copy_intersection<int8_t>(const Tensor<int8_t> &src,
+        const std::vector<Index> &src_offset, const Tensor<int8_t> &dst,
+        const std::vector<Index> &dst_offset);
+
 template
 void copy_intersection<fp32_t>(const Tensor<fp32_t> &src,
         const std::vector<Index> &src_offset, const Tensor<fp32_t> &dst,
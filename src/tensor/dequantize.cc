@@ -0,0 +1,166 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/tensor/dequantize.cc
+ * Dequantization of an int8 tensor along the first axis
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/dequantize.hh"
+#include "nntile/starpu/dequantize.hh"
+
+namespace nntile::tensor
+{
+
+//! Asynchronous tensor-wise int8 dequantization
+/*! Inverse of quantize operation: every fiber along the first axis is
+ * multiplied by its own scale. See kernel::dequantize for details.
+ *
+ * @param[in] src: Quantized values, whose first axis is not split into tiles
+ * @param[in] scale: Scales of shape src.shape[1:]
+ * @param[out] dst: Output tensor of the same shape and tiling as src
+ * */
+template<typename T>
+void dequantize_async(const Tensor<int8_t> &src, const Tensor<T> &scale,
+        const Tensor<T> &dst)
+{
+    // Check dimensions
+    if(dst.ndim == 0)
+    {
+        throw std::runtime_error("Scalar input makes no sense");
+    }
+    if(dst.ndim != scale.ndim+1)
+    {
+        throw std::runtime_error("dst.ndim != scale.ndim+1");
+    }
+    // Check shapes
+    if(src.shape != dst.shape)
+    {
+        throw std::runtime_error("src.shape != dst.shape");
+    }
+    if(src.basetile_shape != dst.basetile_shape)
+    {
+        throw std::runtime_error("src.basetile_shape != dst.basetile_shape");
+    }
+    Index m = dst.shape[0];
+    if(dst.basetile_shape[0] != m)
+    {
+        throw std::runtime_error("dst.basetile_shape[0] != dst.shape[0]");
+    }
+    for(Index i = 0; i < scale.ndim; ++i)
+    {
+        if(dst.shape[i+1] != scale.shape[i])
+        {
+            throw std::runtime_error("dst.shape[i+1] != scale.shape[i]");
+        }
+        if(dst.basetile_shape[i+1] != scale.basetile_shape[i])
+        {
+            throw std::runtime_error("dst.basetile_shape[i+1] != "
+                    "scale.basetile_shape[i]");
+        }
+    }
+    // Do actual calculations
+    int mpi_rank = starpu_mpi_world_rank();
+    for(Index i = 0; i < dst.grid.nelems; ++i)
+    {
+        auto src_tile_handle = src.get_tile_handle(i);
+        auto dst_tile_handle = dst.get_tile_handle(i);
+        int dst_tile_rank = dst_tile_handle.mpi_get_rank();
+        auto tile_index = dst.grid.linear_to_index(i);
+        std::vector<Index> scale_tile_index(tile_index.cbegin()+1,
+                tile_index.cend());
+        auto scale_tile_handle = scale.get_tile_handle(scale_tile_index);
+        // Transfer data
+        src_tile_handle.mpi_transfer(dst_tile_rank, mpi_rank);
+        scale_tile_handle.mpi_transfer(dst_tile_rank, mpi_rank);
+        // Execute on destination node
+        if(mpi_rank == dst_tile_rank)
+        {
+            Index n = scale.get_tile_traits(scale_tile_index).nelems;
+            starpu::dequantize::submit<T>(m, n, src_tile_handle,
+                    scale_tile_handle, dst_tile_handle);
+        }
+        // Flush cache for the output tile on every node
+        dst_tile_handle.mpi_flush();
+    }
+}
+
+//! Blocking version of tensor-wise int8 dequantization
+/*! Every fiber along the first axis is multiplied by its own scale.
+ *
+ * @param[in] src: Quantized values
+ * @param[in] scale: Scales of fibers
+ * @param[out] dst: Output tensor
+ * */
+template<typename T>
+void dequantize(const Tensor<int8_t> &src, const Tensor<T> &scale,
+        const Tensor<T> &dst)
+{
+    dequantize_async<T>(src, scale, dst);
+    starpu_task_wait_for_all();
+    starpu_mpi_wait_for_all(MPI_COMM_WORLD);
+}
+
+// Explicit instantiation
+template
+void dequantize_async(const Tensor<int8_t> &src, const Tensor<fp32_t> &scale,
+        const Tensor<fp32_t> &dst);
+
+template
+void dequantize_async(const Tensor<int8_t> &src,
+        const Tensor<fp32_fast_tf32_t> &scale,
+        const Tensor<fp32_fast_tf32_t> &dst);
+
+template
+void dequantize_async(const Tensor<int8_t> &src,
+        const Tensor<fp32_fast_fp16_t> &scale,
+        const Tensor<fp32_fast_fp16_t> &dst);
+
+template
+void dequantize_async(const Tensor<int8_t> &src,
+        const Tensor<fp32_fast_bf16_t> &scale,
+        const Tensor<fp32_fast_bf16_t> &dst);
+
+template
+void dequantize_async(const Tensor<int8_t> &src, const Tensor<fp64_t> &scale,
+        const Tensor<fp64_t> &dst);
+
+template
+void dequantize_async(const Tensor<int8_t> &src, const Tensor<bf16_t> &scale,
+        const Tensor<bf16_t> &dst);
+
+// Explicit instantiation
+template
+void dequantize(const Tensor<int8_t> &src, const Tensor<fp32_t> &scale,
+        const Tensor<fp32_t> &dst);
+
+template
+void dequantize(const Tensor<int8_t> &src,
+        const Tensor<fp32_fast_tf32_t> &scale,
+        const Tensor<fp32_fast_tf32_t> &dst);
+
+template
+void dequantize(const Tensor<int8_t> &src,
+        const Tensor<fp32_fast_fp16_t> &scale,
+        const Tensor<fp32_fast_fp16_t> &dst);
+
+template
+void dequantize(const Tensor<int8_t> &src,
+        const Tensor<fp32_fast_bf16_t> &scale,
+        const Tensor<fp32_fast_bf16_t> &dst);
+
+template
+void dequantize(const Tensor<int8_t> &src, const Tensor<fp64_t> &scale,
+        const Tensor<fp64_t> &dst);
+
+template
+void dequantize(const Tensor<int8_t> &src, const Tensor<bf16_t> &scale,
+        const Tensor<bf16_t> &dst);
+
+} // namespace nntile::tensor
@@ -13,6 +13,7 @@
  * */
 
 #include "nntile/tensor/flash_maxsumexp.hh"
+#include "nntile/tensor/mask_tile_status.hh"
 #include "nntile/starpu/flash_maxsumexp.hh"
 #include <cmath>
 #include <limits>
@@ -24,7 +25,8 @@ namespace nntile::tensor
 template<typename T>
 void flash_maxsumexp_async(const Tensor<T> &Q, const Tensor<T> &K,
         const Tensor<bool_t> &mask, const Tensor<T> &maxsumexp,
-        const Tensor<T> &tmp, int redux)
+        const Tensor<T> &tmp, int redux,
+        const std::vector<int> &mask_tile_status)
 {
 //    // Check dimensions
 //    if(src.ndim != dst.ndim)
@@ -78,6 +80,7 @@ void flash_maxsumexp_async(const Tensor<T> &Q, const Tensor<T> &K,
 //                    "dst.basetile_shape[i]");
 //        }
 //    }
+    mask_tile_status_check(mask, mask_tile_status);
     // Do actual calculations
     int ret;
     Index head_size = Q.shape[0];
@@ -117,6 +120,12 @@ void flash_maxsumexp_async(const Tensor<T> &Q, const Tensor<T> &K,
             tmp_tile_index[0] = j;
             k_tile_index[1] = j;
             mask_tile_index[0] = j;
+            // Skip tiles of K, that are entirely masked out
+            if(mask_tile_status_get(mask, mask_tile_status, mask_tile_index)
+                    == MASK_TILE_EMPTY)
+            {
+                continue;
+            }
             auto tmp_tile_handle = tmp.get_tile_handle(tmp_tile_index);
             auto k_tile_handle = K.get_tile_handle(k_tile_index);
             auto mask_tile_handle = mask.get_tile_handle(mask_tile_index);
@@ -132,9 +141,11 @@ void flash_maxsumexp_async(const Tensor<T> &Q, const Tensor<T> &K,
 template<typename T>
 void flash_maxsumexp(const Tensor<T> &Q, const Tensor<T> &K,
         const Tensor<bool_t> &mask, const Tensor<T> &maxsumexp,
-        const Tensor<T> &tmp, int redux)
+        const Tensor<T> &tmp, int redux,
+        const std::vector<int> &mask_tile_status)
 {
-    flash_maxsumexp_async<T>(Q, K, mask, maxsumexp, tmp, redux);
+    flash_maxsumexp_async<T>(Q, K, mask, maxsumexp, tmp, redux,
+            mask_tile_status);
     starpu_task_wait_for_all();
     starpu_mpi_wait_for_all(MPI_COMM_WORLD);
 }
@@ -143,62 +154,74 @@ void flash_maxsumexp(const Tensor<T> &Q, const Tensor<T> &K,
 template
 void flash_maxsumexp_async(const Tensor<fp32_fast_tf32_t> &Q, const Tensor<fp32_fast_tf32_t> &K,
         const Tensor<bool_t> &mask, const Tensor<fp32_fast_tf32_t> &maxsumexp,
-        const Tensor<fp32_fast_tf32_t> &tmp, int redux);
+        const Tensor<fp32_fast_tf32_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_maxsumexp_async(const Tensor<fp32_fast_fp16_t> &Q, const Tensor<fp32_fast_fp16_t> &K,
         const Tensor<bool_t> &mask, const Tensor<fp32_fast_fp16_t> &maxsumexp,
-        const Tensor<fp32_fast_fp16_t> &tmp, int redux);
+        const Tensor<fp32_fast_fp16_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_maxsumexp_async(const Tensor<fp32_fast_bf16_t> &Q, const Tensor<fp32_fast_bf16_t> &K,
         const Tensor<bool_t> &mask, const Tensor<fp32_fast_bf16_t> &maxsumexp,
-        const Tensor<fp32_fast_bf16_t> &tmp, int redux);
+        const Tensor<fp32_fast_bf16_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_maxsumexp_async(const Tensor<fp32_t> &Q, const Tensor<fp32_t> &K,
         const Tensor<bool_t> &mask, const Tensor<fp32_t> &maxsumexp,
-        const Tensor<fp32_t> &tmp, int redux);
+        const Tensor<fp32_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_maxsumexp_async(const Tensor<fp64_t> &Q, const Tensor<fp64_t> &K,
         const Tensor<bool_t> &mask, const Tensor<fp64_t> &maxsumexp,
-        const Tensor<fp64_t> &tmp, int redux);
+        const Tensor<fp64_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_maxsumexp_async(const Tensor<bf16_t> &Q, const Tensor<bf16_t> &K,
         const Tensor<bool_t> &mask, const Tensor<bf16_t> &maxsumexp,
-        const Tensor<bf16_t> &tmp, int redux);
+        const Tensor<bf16_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 // Explicit instantiation
 template
 void flash_maxsumexp(const Tensor<fp32_t> &Q, const Tensor<fp32_t> &K,
         const Tensor<bool_t> &mask, const Tensor<fp32_t> &maxsumexp,
-        const Tensor<fp32_t> &tmp, int redux);
+        const Tensor<fp32_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_maxsumexp(const Tensor<fp32_fast_tf32_t> &Q, const Tensor<fp32_fast_tf32_t> &K,
         const Tensor<bool_t> &mask, const Tensor<fp32_fast_tf32_t> &maxsumexp,
-        const Tensor<fp32_fast_tf32_t> &tmp, int redux);
+        const Tensor<fp32_fast_tf32_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_maxsumexp(const Tensor<fp32_fast_fp16_t> &Q, const Tensor<fp32_fast_fp16_t> &K,
         const Tensor<bool_t> &mask, const Tensor<fp32_fast_fp16_t> &maxsumexp,
-        const Tensor<fp32_fast_fp16_t> &tmp, int redux);
+        const Tensor<fp32_fast_fp16_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_maxsumexp(const Tensor<fp32_fast_bf16_t> &Q, const Tensor<fp32_fast_bf16_t> &K,
         const Tensor<bool_t> &mask, const Tensor<fp32_fast_bf16_t> &maxsumexp,
-        const Tensor<fp32_fast_bf16_t> &tmp, int redux);
+        const Tensor<fp32_fast_bf16_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_maxsumexp(const Tensor<fp64_t> &Q, const Tensor<fp64_t> &K,
         const Tensor<bool_t> &mask, const Tensor<fp64_t> &maxsumexp,
-        const Tensor<fp64_t> &tmp, int redux);
+        const Tensor<fp64_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_maxsumexp(const Tensor<bf16_t> &Q, const Tensor<bf16_t> &K,
         const Tensor<bool_t> &mask, const Tensor<bf16_t> &maxsumexp,
-        const Tensor<bf16_t> &tmp, int redux);
+        const Tensor<bf16_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 } // namespace nntile::tensor
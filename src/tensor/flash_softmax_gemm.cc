@@ -13,6 +13,7 @@
  * */
 
 #include "nntile/tensor/flash_softmax_gemm.hh"
+#include "nntile/tensor/mask_tile_status.hh"
 #include "nntile/starpu/flash_softmax_gemm.hh"
 #include "nntile/starpu/gemm.hh"
 #include "nntile/starpu/mask_scalar.hh"
@@ -27,7 +28,8 @@ template<typename T>
 void flash_softmax_gemm_async(const Tensor<T> &Q, const Tensor<T> &K,
         const Tensor<T> &V, const Tensor<bool_t> &mask,
         const Tensor<T> &maxsumexp, const Tensor<T> &dst,
-        const Tensor<T> &tmp, int redux)
+        const Tensor<T> &tmp, int redux,
+        const std::vector<int> &mask_tile_status)
 {
 //    // Check dimensions
 //    if(src.ndim != dst.ndim)
@@ -81,6 +83,7 @@ void flash_softmax_gemm_async(const Tensor<T> &Q, const Tensor<T> &K,
 //                    "dst.basetile_shape[i]");
 //        }
 //    }
+    mask_tile_status_check(mask, mask_tile_status);
     // Do actual calculations
     int ret;
     Index head_size = Q.shape[0];
@@ -126,6 +129,12 @@ void flash_softmax_gemm_async(const Tensor<T> &Q, const Tensor<T> &K,
             k_tile_index[1] = j;
             v_tile_index[1] = j;
             mask_tile_index[0] = j;
+            // Skip tiles of K and V, that are entirely masked out
+            if(mask_tile_status_get(mask, mask_tile_status, mask_tile_index)
+                    == MASK_TILE_EMPTY)
+            {
+                continue;
+            }
             auto tmp_tile_handle = tmp.get_tile_handle(tmp_tile_index);
             auto k_tile_handle = K.get_tile_handle(k_tile_index);
             auto v_tile_handle = V.get_tile_handle(v_tile_index);
@@ -144,9 +153,11 @@ template<typename T>
 void flash_softmax_gemm(const Tensor<T> &Q, const Tensor<T> &K,
         const Tensor<T> &V, const Tensor<bool_t> &mask,
         const Tensor<T> &maxsumexp, const Tensor<T> &dst,
-        const Tensor<T> &tmp, int redux)
+        const Tensor<T> &tmp, int redux,
+        const std::vector<int> &mask_tile_status)
 {
-    flash_softmax_gemm_async<T>(Q, K, V, mask, maxsumexp, dst, tmp, redux);
+    flash_softmax_gemm_async<T>(Q, K, V, mask, maxsumexp, dst, tmp, redux,
+            mask_tile_status);
     starpu_task_wait_for_all();
     starpu_mpi_wait_for_all(MPI_COMM_WORLD);
 }
@@ -156,73 +167,85 @@ template
 void flash_softmax_gemm_async(const Tensor<fp32_t> &Q, const Tensor<fp32_t> &K,
         const Tensor<fp32_t> &V, const Tensor<bool_t> &mask,
         const Tensor<fp32_t> &maxsumexp, const Tensor<fp32_t> &dst,
-        const Tensor<fp32_t> &tmp, int redux);
+        const Tensor<fp32_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_async(const Tensor<fp32_fast_tf32_t> &Q, const Tensor<fp32_fast_tf32_t> &K,
         const Tensor<fp32_fast_tf32_t> &V, const Tensor<bool_t> &mask,
         const Tensor<fp32_fast_tf32_t> &maxsumexp, const Tensor<fp32_fast_tf32_t> &dst,
-        const Tensor<fp32_fast_tf32_t> &tmp, int redux);
+        const Tensor<fp32_fast_tf32_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_async(const Tensor<fp32_fast_fp16_t> &Q, const Tensor<fp32_fast_fp16_t> &K,
         const Tensor<fp32_fast_fp16_t> &V, const Tensor<bool_t> &mask,
         const Tensor<fp32_fast_fp16_t> &maxsumexp, const Tensor<fp32_fast_fp16_t> &dst,
-        const Tensor<fp32_fast_fp16_t> &tmp, int redux);
+        const Tensor<fp32_fast_fp16_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_async(const Tensor<fp32_fast_bf16_t> &Q, const Tensor<fp32_fast_bf16_t> &K,
         const Tensor<fp32_fast_bf16_t> &V, const Tensor<bool_t> &mask,
         const Tensor<fp32_fast_bf16_t> &maxsumexp, const Tensor<fp32_fast_bf16_t> &dst,
-        const Tensor<fp32_fast_bf16_t> &tmp, int redux);
+        const Tensor<fp32_fast_bf16_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_async(const Tensor<fp64_t> &Q, const Tensor<fp64_t> &K,
         const Tensor<fp64_t> &V, const Tensor<bool_t> &mask,
         const Tensor<fp64_t> &maxsumexp, const Tensor<fp64_t> &dst,
-        const Tensor<fp64_t> &tmp, int redux);
+        const Tensor<fp64_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_async(const Tensor<bf16_t> &Q, const Tensor<bf16_t> &K,
         const Tensor<bf16_t> &V, const Tensor<bool_t> &mask,
         const Tensor<bf16_t> &maxsumexp, const Tensor<bf16_t> &dst,
-        const Tensor<bf16_t> &tmp, int redux);
+        const Tensor<bf16_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 // Explicit instantiation
 template
 void flash_softmax_gemm(const Tensor<fp32_t> &Q, const Tensor<fp32_t> &K,
         const Tensor<fp32_t> &V, const Tensor<bool_t> &mask,
         const Tensor<fp32_t> &maxsumexp, const Tensor<fp32_t> &dst,
-        const Tensor<fp32_t> &tmp, int redux);
+        const Tensor<fp32_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm(const Tensor<fp32_fast_tf32_t> &Q, const Tensor<fp32_fast_tf32_t> &K,
         const Tensor<fp32_fast_tf32_t> &V, const Tensor<bool_t> &mask,
         const Tensor<fp32_fast_tf32_t> &maxsumexp, const Tensor<fp32_fast_tf32_t> &dst,
-        const Tensor<fp32_fast_tf32_t> &tmp, int redux);
+        const Tensor<fp32_fast_tf32_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm(const Tensor<fp32_fast_fp16_t> &Q, const Tensor<fp32_fast_fp16_t> &K,
         const Tensor<fp32_fast_fp16_t> &V, const Tensor<bool_t> &mask,
         const Tensor<fp32_fast_fp16_t> &maxsumexp, const Tensor<fp32_fast_fp16_t> &dst,
-        const Tensor<fp32_fast_fp16_t> &tmp, int redux);
+        const Tensor<fp32_fast_fp16_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm(const Tensor<fp32_fast_bf16_t> &Q, const Tensor<fp32_fast_bf16_t> &K,
         const Tensor<fp32_fast_bf16_t> &V, const Tensor<bool_t> &mask,
         const Tensor<fp32_fast_bf16_t> &maxsumexp, const Tensor<fp32_fast_bf16_t> &dst,
-        const Tensor<fp32_fast_bf16_t> &tmp, int redux);
+        const Tensor<fp32_fast_bf16_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm(const Tensor<fp64_t> &Q, const Tensor<fp64_t> &K,
         const Tensor<fp64_t> &V, const Tensor<bool_t> &mask,
         const Tensor<fp64_t> &maxsumexp, const Tensor<fp64_t> &dst,
-        const Tensor<fp64_t> &tmp, int redux);
+        const Tensor<fp64_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm(const Tensor<bf16_t> &Q, const Tensor<bf16_t> &K,
         const Tensor<bf16_t> &V, const Tensor<bool_t> &mask,
         const Tensor<bf16_t> &maxsumexp, const Tensor<bf16_t> &dst,
-        const Tensor<bf16_t> &tmp, int redux);
+        const Tensor<bf16_t> &tmp, int redux,
+        const std::vector<int> &mask_tile_status);
 
 } // namespace nntile::tensor
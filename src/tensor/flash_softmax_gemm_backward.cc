@@ -13,6 +13,7 @@
  * */
 
 #include "nntile/tensor/flash_softmax_gemm_backward.hh"
+#include "nntile/tensor/mask_tile_status.hh"
 #include "nntile/starpu/flash_softmax_gemm_backward_sumprod_slice.hh"
 #include "nntile/starpu/flash_softmax_gemm_backward_dq_dk.hh"
 #include <cmath>
@@ -27,7 +28,8 @@ void flash_softmax_gemm_backward_async(const Tensor<T> &Q, const Tensor<T> &dQ,
         const Tensor<T> &dV, const Tensor<bool_t> &mask,
         const Tensor<T> &maxsumexp, const Tensor<T> &dst_grad,
         const Tensor<T> &tmp, const Tensor<T> &tmp_grad,
-        const Tensor<T> &tmp_sumprod_slice, int redux)
+        const Tensor<T> &tmp_sumprod_slice, int redux,
+        const std::vector<int> &mask_tile_status)
 {
 //    // Check dimensions
 //    if(src.ndim != dst.ndim)
@@ -81,6 +83,7 @@ void flash_softmax_gemm_backward_async(const Tensor<T> &Q, const Tensor<T> &dQ,
 //                    "dst.basetile_shape[i]");
 //        }
 //    }
+    mask_tile_status_check(mask, mask_tile_status);
     // Do actual calculations
     int ret;
     Index head_size = Q.shape[0];
@@ -138,6 +141,12 @@ void flash_softmax_gemm_backward_async(const Tensor<T> &Q, const Tensor<T> &dQ,
             q_tile_index[1] = j;
             dst_grad_tile_index[1] = j;
             mask_tile_index[1] = j;
+            // Skip tiles of Q, that are entirely masked out
+            if(mask_tile_status_get(mask, mask_tile_status, mask_tile_index)
+                    == MASK_TILE_EMPTY)
+            {
+                continue;
+            }
             maxsumexp_tile_index[1] = j;
             tmp_sumprod_slice_tile_index[0] = j;
             auto tmp_tile_handle = tmp.get_tile_handle(tmp_tile_index);
@@ -189,6 +198,12 @@ void flash_softmax_gemm_backward_async(const Tensor<T> &Q, const Tensor<T> &dQ,
             q_tile_index[1] = j;
             dst_grad_tile_index[1] = j;
             mask_tile_index[1] = j;
+            // Skip tiles of Q, that are entirely masked out
+            if(mask_tile_status_get(mask, mask_tile_status, mask_tile_index)
+                    == MASK_TILE_EMPTY)
+            {
+                continue;
+            }
             maxsumexp_tile_index[1] = j;
             tmp_sumprod_slice_tile_index[0] = j;
             dq_tile_index[1] = j;
@@ -221,10 +236,11 @@ void flash_softmax_gemm_backward(const Tensor<T> &Q, const Tensor<T> &dQ,
         const Tensor<T> &dV, const Tensor<bool_t> &mask,
         const Tensor<T> &maxsumexp, const Tensor<T> &dst_grad,
         const Tensor<T> &tmp, const Tensor<T> &tmp_grad,
-        const Tensor<T> &tmp_sumprod_slice, int redux)
+        const Tensor<T> &tmp_sumprod_slice, int redux,
+        const std::vector<int> &mask_tile_status)
 {
     flash_softmax_gemm_backward_async<T>(Q, dQ, K, dK, V, dV, mask, maxsumexp,
-            dst_grad, tmp, tmp_grad, tmp_sumprod_slice, redux);
+            dst_grad, tmp, tmp_grad, tmp_sumprod_slice, redux, mask_tile_status);
     starpu_task_wait_for_all();
     starpu_mpi_wait_for_all(MPI_COMM_WORLD);
 }
@@ -236,7 +252,8 @@ void flash_softmax_gemm_backward_async(const Tensor<fp32_t> &Q, const Tensor<fp3
         const Tensor<fp32_t> &dV, const Tensor<bool_t> &mask,
         const Tensor<fp32_t> &maxsumexp, const Tensor<fp32_t> &dst_grad,
         const Tensor<fp32_t> &tmp, const Tensor<fp32_t> &tmp_grad,
-        const Tensor<fp32_t> &tmp_sumprod_slice, int redux);
+        const Tensor<fp32_t> &tmp_sumprod_slice, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_backward_async(const Tensor<fp32_fast_tf32_t> &Q, const Tensor<fp32_fast_tf32_t> &dQ,
@@ -244,7 +261,8 @@ void flash_softmax_gemm_backward_async(const Tensor<fp32_fast_tf32_t> &Q, const
         const Tensor<fp32_fast_tf32_t> &dV, const Tensor<bool_t> &mask,
         const Tensor<fp32_fast_tf32_t> &maxsumexp, const Tensor<fp32_fast_tf32_t> &dst_grad,
         const Tensor<fp32_fast_tf32_t> &tmp, const Tensor<fp32_fast_tf32_t> &tmp_grad,
-        const Tensor<fp32_fast_tf32_t> &tmp_sumprod_slice, int redux);
+        const Tensor<fp32_fast_tf32_t> &tmp_sumprod_slice, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_backward_async(const Tensor<fp32_fast_fp16_t> &Q, const Tensor<fp32_fast_fp16_t> &dQ,
@@ -252,7 +270,8 @@ void flash_softmax_gemm_backward_async(const Tensor<fp32_fast_fp16_t> &Q, const
         const Tensor<fp32_fast_fp16_t> &dV, const Tensor<bool_t> &mask,
         const Tensor<fp32_fast_fp16_t> &maxsumexp, const Tensor<fp32_fast_fp16_t> &dst_grad,
         const Tensor<fp32_fast_fp16_t> &tmp, const Tensor<fp32_fast_fp16_t> &tmp_grad,
-        const Tensor<fp32_fast_fp16_t> &tmp_sumprod_slice, int redux);
+        const Tensor<fp32_fast_fp16_t> &tmp_sumprod_slice, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_backward_async(const Tensor<fp32_fast_bf16_t> &Q, const Tensor<fp32_fast_bf16_t> &dQ,
@@ -260,7 +279,8 @@ void flash_softmax_gemm_backward_async(const Tensor<fp32_fast_bf16_t> &Q, const
         const Tensor<fp32_fast_bf16_t> &dV, const Tensor<bool_t> &mask,
         const Tensor<fp32_fast_bf16_t> &maxsumexp, const Tensor<fp32_fast_bf16_t> &dst_grad,
         const Tensor<fp32_fast_bf16_t> &tmp, const Tensor<fp32_fast_bf16_t> &tmp_grad,
-        const Tensor<fp32_fast_bf16_t> &tmp_sumprod_slice, int redux);
+        const Tensor<fp32_fast_bf16_t> &tmp_sumprod_slice, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_backward_async(const Tensor<fp64_t> &Q, const Tensor<fp64_t> &dQ,
@@ -268,7 +288,8 @@ void flash_softmax_gemm_backward_async(const Tensor<fp64_t> &Q, const Tensor<fp6
         const Tensor<fp64_t> &dV, const Tensor<bool_t> &mask,
         const Tensor<fp64_t> &maxsumexp, const Tensor<fp64_t> &dst_grad,
         const Tensor<fp64_t> &tmp, const Tensor<fp64_t> &tmp_grad,
-        const Tensor<fp64_t> &tmp_sumprod_slice, int redux);
+        const Tensor<fp64_t> &tmp_sumprod_slice, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_backward_async(const Tensor<bf16_t> &Q, const Tensor<bf16_t> &dQ,
@@ -276,7 +297,8 @@ void flash_softmax_gemm_backward_async(const Tensor<bf16_t> &Q, const Tensor<bf1
         const Tensor<bf16_t> &dV, const Tensor<bool_t> &mask,
         const Tensor<bf16_t> &maxsumexp, const Tensor<bf16_t> &dst_grad,
         const Tensor<bf16_t> &tmp, const Tensor<bf16_t> &tmp_grad,
-        const Tensor<bf16_t> &tmp_sumprod_slice, int redux);
+        const Tensor<bf16_t> &tmp_sumprod_slice, int redux,
+        const std::vector<int> &mask_tile_status);
 
 // Explicit instantiation
 template
@@ -285,7 +307,8 @@ void flash_softmax_gemm_backward(const Tensor<fp32_t> &Q, const Tensor<fp32_t> &
         const Tensor<fp32_t> &dV, const Tensor<bool_t> &mask,
         const Tensor<fp32_t> &maxsumexp, const Tensor<fp32_t> &dst_grad,
         const Tensor<fp32_t> &tmp, const Tensor<fp32_t> &tmp_grad,
-        const Tensor<fp32_t> &tmp_sumprod_slice, int redux);
+        const Tensor<fp32_t> &tmp_sumprod_slice, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_backward(const Tensor<fp32_fast_tf32_t> &Q, const Tensor<fp32_fast_tf32_t> &dQ,
@@ -293,7 +316,8 @@ void flash_softmax_gemm_backward(const Tensor<fp32_fast_tf32_t> &Q, const Tensor
         const Tensor<fp32_fast_tf32_t> &dV, const Tensor<bool_t> &mask,
         const Tensor<fp32_fast_tf32_t> &maxsumexp, const Tensor<fp32_fast_tf32_t> &dst_grad,
         const Tensor<fp32_fast_tf32_t> &tmp, const Tensor<fp32_fast_tf32_t> &tmp_grad,
-        const Tensor<fp32_fast_tf32_t> &tmp_sumprod_slice, int redux);
+        const Tensor<fp32_fast_tf32_t> &tmp_sumprod_slice, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_backward(const Tensor<fp32_fast_fp16_t> &Q, const Tensor<fp32_fast_fp16_t> &dQ,
@@ -301,7 +325,8 @@ void flash_softmax_gemm_backward(const Tensor<fp32_fast_fp16_t> &Q, const Tensor
         const Tensor<fp32_fast_fp16_t> &dV, const Tensor<bool_t> &mask,
         const Tensor<fp32_fast_fp16_t> &maxsumexp, const Tensor<fp32_fast_fp16_t> &dst_grad,
         const Tensor<fp32_fast_fp16_t> &tmp, const Tensor<fp32_fast_fp16_t> &tmp_grad,
-        const Tensor<fp32_fast_fp16_t> &tmp_sumprod_slice, int redux);
+        const Tensor<fp32_fast_fp16_t> &tmp_sumprod_slice, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_backward(const Tensor<fp32_fast_bf16_t> &Q, const Tensor<fp32_fast_bf16_t> &dQ,
@@ -309,7 +334,8 @@ void flash_softmax_gemm_backward(const Tensor<fp32_fast_bf16_t> &Q, const Tensor
         const Tensor<fp32_fast_bf16_t> &dV, const Tensor<bool_t> &mask,
         const Tensor<fp32_fast_bf16_t> &maxsumexp, const Tensor<fp32_fast_bf16_t> &dst_grad,
         const Tensor<fp32_fast_bf16_t> &tmp, const Tensor<fp32_fast_bf16_t> &tmp_grad,
-        const Tensor<fp32_fast_bf16_t> &tmp_sumprod_slice, int redux);
+        const Tensor<fp32_fast_bf16_t> &tmp_sumprod_slice, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_backward(const Tensor<fp64_t> &Q, const Tensor<fp64_t> &dQ,
@@ -317,7 +343,8 @@ void flash_softmax_gemm_backward(const Tensor<fp64_t> &Q, const Tensor<fp64_t> &
         const Tensor<fp64_t> &dV, const Tensor<bool_t> &mask,
         const Tensor<fp64_t> &maxsumexp, const Tensor<fp64_t> &dst_grad,
         const Tensor<fp64_t> &tmp, const Tensor<fp64_t> &tmp_grad,
-        const Tensor<fp64_t> &tmp_sumprod_slice, int redux);
+        const Tensor<fp64_t> &tmp_sumprod_slice, int redux,
+        const std::vector<int> &mask_tile_status);
 
 template
 void flash_softmax_gemm_backward(const Tensor<bf16_t> &Q, const Tensor<bf16_t> &dQ,
@@ -325,6 +352,7 @@ void flash_softmax_gemm_backward(const Tensor<bf16_t> &Q, const Tensor<bf16_t> &
         const Tensor<bf16_t> &dV, const Tensor<bool_t> &mask,
         const Tensor<bf16_t> &maxsumexp, const Tensor<bf16_t> &dst_grad,
         const Tensor<bf16_t> &tmp, const Tensor<bf16_t> &tmp_grad,
-        const Tensor<bf16_t> &tmp_sumprod_slice, int redux);
+        const Tensor<bf16_t> &tmp_sumprod_slice, int redux,
+        const std::vector<int> &mask_tile_status);
 
 } // namespace nntile::tensor
@@ -14,6 +14,7 @@
 
 #include "nntile/tensor/gemm.hh"
 #include "nntile/starpu/gemm.hh"
+#include "nntile/starpu/gemv.hh"
 
 namespace nntile::tensor
 {
@@ -392,6 +393,10 @@ void gemm_async(Scalar alpha, const TransOp &transA, const Tensor<T> &A,
                     C.ndim-batch_ndim][1];
                 Index tile_n = C_tile_traits.matrix_shape[
                     A.ndim-batch_ndim-ndim][1] / tile_batch;
+                // Product by a few columns (e.g., a decode step) is bound by
+                // reading A, so it is done by gemv tasks, that read A once
+                bool use_gemv = transB.value == TransOp::NoTrans
+                    and tile_n <= starpu::gemv::max_n;
                 // initialize C(i,j,b) = a*opA(i,0,b)*opB(0,j,b) + b*C(i,j,b)
                 Index A_tile_offset = opA_stride[0]*i + b*m*k;
                 Index B_tile_offset = opB_stride[1]*j + b*n*k;
@@ -421,10 +426,20 @@ void gemm_async(Scalar alpha, const TransOp &transA, const Tensor<T> &A,
                             tile_k = A_first_tile_traits.matrix_shape[ndim][0];
                             break;
                     }
-                    starpu::gemm::submit<T>(transA, transB, tile_m,
-                            tile_n,
-                            tile_k, tile_batch, alpha, A_first_tile_handle,
-                            B_first_tile_handle, beta, C_tile_handle, redux);
+                    if(use_gemv)
+                    {
+                        starpu::gemv::submit<T>(transA, tile_m, tile_n,
+                                tile_k, tile_batch, alpha,
+                                A_first_tile_handle, B_first_tile_handle,
+                                beta, C_tile_handle, redux);
+                    }
+                    else
+                    {
+                        starpu::gemm::submit<T>(transA, transB, tile_m,
+                                tile_n, tile_k, tile_batch, alpha,
+                                A_first_tile_handle, B_first_tile_handle,
+                                beta, C_tile_handle, redux);
+                    }
                 }
                 // all other l>0
                 for(Index l = 1; l < k; ++l)
@@ -457,10 +472,19 @@ void gemm_async(Scalar alpha, const TransOp &transA, const Tensor<T> &A,
                                 tile_k = A_tile_traits.matrix_shape[ndim][0];
                                 break;
                         }
-                        starpu::gemm::submit<T>(transA, transB, tile_m,
-                                tile_n,
-                                tile_k, tile_batch, alpha, A_tile_handle,
-                                B_tile_handle, one, C_tile_handle, redux);
+                        if(use_gemv)
+                        {
+                            starpu::gemv::submit<T>(transA, tile_m, tile_n,
+                                    tile_k, tile_batch, alpha, A_tile_handle,
+                                    B_tile_handle, one, C_tile_handle, redux);
+                        }
+                        else
+                        {
+                            starpu::gemm::submit<T>(transA, transB, tile_m,
+                                    tile_n, tile_k, tile_batch, alpha,
+                                    A_tile_handle, B_tile_handle, one,
+                                    C_tile_handle, redux);
+                        }
                     }
                 }
                 // Flush cache for the output tile on every node
@@ -0,0 +1,354 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/tensor/gemm_gqa.cc
+ * GEMM operation for Tensor<T> with an operand shared by a group of batches
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/gemm_gqa.hh"
+#include "nntile/tensor/gemm.hh"
+#include "nntile/starpu/gemm.hh"
+
+namespace nntile::tensor
+{
+
+//! Traits of a shared operand with an inserted group dimension
+/*! Shape and base tile of the group dimension are taken from a non-shared
+ * operand ref. Batch dimensions are the last ones for all operands.
+ * */
+static TensorTraits gemm_gqa_expand(const TensorTraits &X,
+        const TensorTraits &ref, Index batch_ndim, Index group_dim)
+{
+    if(X.ndim < batch_ndim-1)
+    {
+        throw std::runtime_error("Shared operand has less than batch_ndim-1 "
+                "dimensions");
+    }
+    if(ref.ndim < batch_ndim)
+    {
+        throw std::runtime_error("Non-shared operand has less than "
+                "batch_ndim dimensions");
+    }
+    Index axis = X.ndim - batch_ndim + 1 + group_dim;
+    Index ref_axis = ref.ndim - batch_ndim + group_dim;
+    std::vector<Index> shape(X.shape), basetile_shape(X.basetile_shape);
+    shape.insert(shape.begin()+axis, ref.shape[ref_axis]);
+    basetile_shape.insert(basetile_shape.begin()+axis,
+            ref.basetile_shape[ref_axis]);
+    return TensorTraits(shape, basetile_shape);
+}
+
+//! Check if tensors match gemm with an operand shared by a group
+void gemm_gqa_check(const TransOp &transA, const TensorTraits &A,
+        const TransOp &transB, const TensorTraits &B, const TensorTraits &C,
+        Index ndim, Index batch_ndim, Index group_dim, int bcast)
+{
+    if(batch_ndim < 1)
+    {
+        throw std::runtime_error("batch_ndim < 1");
+    }
+    if(group_dim < 0 or group_dim >= batch_ndim)
+    {
+        throw std::runtime_error("group_dim < 0 or group_dim >= batch_ndim");
+    }
+    // Shared operand with inserted group dimension must match usual gemm
+    switch(bcast)
+    {
+        case starpu::gemm::GROUP_BCAST_A:
+            gemm_check(transA, gemm_gqa_expand(A, C, batch_ndim, group_dim),
+                    transB, B, C, ndim, batch_ndim);
+            break;
+        case starpu::gemm::GROUP_BCAST_B:
+            gemm_check(transA, A, transB,
+                    gemm_gqa_expand(B, C, batch_ndim, group_dim), C, ndim,
+                    batch_ndim);
+            break;
+        case starpu::gemm::GROUP_BCAST_C:
+            gemm_check(transA, A, transB, B,
+                    gemm_gqa_expand(C, A, batch_ndim, group_dim), ndim,
+                    batch_ndim);
+            break;
+        default:
+            throw std::runtime_error("Invalid value of bcast");
+    }
+}
+
+//! Asynchronous version of tensor-wise gemm with an operand shared by a group
+/*! Matrix multiplication for tensors, which are virtually reshaped. One of
+ * the operands (defined by bcast) has no dimension group_dim among batch
+ * dimensions, so it is reused by all batches of a group. This is the way
+ * grouped-query attention multiplies queries by keys and values without
+ * repeating them kv_group_size times. If the shared operand is C, then
+ * results of all batches of a group are accumulated into it.
+ *
+ * @param[in] alpha: Alpha multiplier
+ * @param[in] transA: Transposition flag for the tensor A
+ * @param[in] A: Input tensor A
+ * @param[in] transB: Transposition flag for the tensor B
+ * @param[in] B: Input tensor B
+ * @param[in] beta: Beta multiplier
+ * @param[inout] C: Output tensor C
+ * @param[in] ndim: Number of dimensions used in gemm contraction
+ * @param[in] batch_ndim: Number of last dimensions used for batching of gemms
+ *      of non-shared operands
+ * @param[in] group_dim: Position of the group dimension among batch
+ *      dimensions
+ * @param[in] bcast: Shared operand, see starpu::gemm::GroupBcast
+ * @param[in] redux: Whether or not to use STARPU_REDUX
+ * */
+template<typename T>
+void gemm_gqa_async(Scalar alpha, const TransOp &transA, const Tensor<T> &A,
+        const TransOp &transB, const Tensor<T> &B, Scalar beta,
+        const Tensor<T> &C, Index ndim, Index batch_ndim, Index group_dim,
+        int bcast, int redux)
+{
+    // Check inputs (throw exception in case of an error)
+    gemm_gqa_check(transA, A, transB, B, C, ndim, batch_ndim, group_dim,
+            bcast);
+    // Traits of operands as if the shared one was repeated over group
+    using starpu::gemm::GROUP_BCAST_A;
+    using starpu::gemm::GROUP_BCAST_B;
+    using starpu::gemm::GROUP_BCAST_C;
+    TensorTraits A_full = bcast == GROUP_BCAST_A
+        ? gemm_gqa_expand(A, C, batch_ndim, group_dim)
+        : TensorTraits(A.shape, A.basetile_shape);
+    TensorTraits B_full = bcast == GROUP_BCAST_B
+        ? gemm_gqa_expand(B, C, batch_ndim, group_dim)
+        : TensorTraits(B.shape, B.basetile_shape);
+    TensorTraits C_full = bcast == GROUP_BCAST_C
+        ? gemm_gqa_expand(C, A, batch_ndim, group_dim)
+        : TensorTraits(C.shape, C.basetile_shape);
+    // Sizes of A, B and C as simple matrices (grids of tiles) for gemm
+    int mpi_rank = starpu_mpi_world_rank();
+    constexpr Scalar one = 1;
+    Index mdim = A_full.ndim - batch_ndim - ndim;
+    Index batch_axis = C_full.ndim - batch_ndim;
+    Index group_axis = batch_axis + group_dim;
+    Index m = C_full.grid.matrix_shape[mdim][0];
+    Index batch = C_full.grid.matrix_shape[batch_axis][1];
+    Index n = C_full.grid.matrix_shape[mdim][1] / batch;
+    Index k;
+    std::array<Index, 2> opA_stride, opB_stride;
+    switch(transA.value)
+    {
+        case TransOp::NoTrans:
+            k = A_full.grid.matrix_shape[mdim][1] / batch;
+            opA_stride = {1, m};
+            break;
+        // This parameter was already checked in gemm_check_opA_opB
+        //case TransOp::Trans:
+        default:
+            k = A_full.grid.matrix_shape[ndim][0];
+            opA_stride = {k, 1};
+            break;
+    }
+    switch(transB.value)
+    {
+        case TransOp::NoTrans:
+            opB_stride = {1, k};
+            break;
+        // This parameter was already checked in gemm_check_opA_opB
+        //case TransOp::Trans:
+        default:
+            opB_stride = {n, 1};
+            break;
+    }
+    // Batch of tiles is split into inner, group and outer parts
+    Index inner = C_full.grid.matrix_shape[group_axis][0]
+        / C_full.grid.matrix_shape[batch_axis][0];
+    Index group = C_full.grid.shape[group_axis];
+    // All per-tile starpu gemm calls shall appear here
+    for(Index b = 0; b < batch; ++b)
+    {
+        Index b_group = (b/inner) % group;
+        Index b_shared = b%inner + inner*(b/(inner*group));
+        Index b_A = bcast == GROUP_BCAST_A ? b_shared : b;
+        Index b_B = bcast == GROUP_BCAST_B ? b_shared : b;
+        Index b_C = bcast == GROUP_BCAST_C ? b_shared : b;
+        // Shared C accumulates results of all tiles of a group
+        Scalar C_beta = (bcast == GROUP_BCAST_C and b_group > 0) ? one : beta;
+        for(Index j = 0; j < n; ++j)
+        {
+            for(Index i = 0; i < m; ++i)
+            {
+                Index C_tile_offset = (b_C*n+j)*m + i;
+                auto C_tile_handle = C.get_tile_handle(C_tile_offset);
+                int C_tile_rank = C_tile_handle.mpi_get_rank();
+                // Shape of the tile of C as if it was repeated over group
+                tile::TileTraits C_tile_traits(C_full.get_tile_shape(
+                            C_full.grid.linear_to_index((b*n+j)*m+i)));
+                Index tile_m = C_tile_traits.matrix_shape[mdim][0];
+                Index tile_batch = C_tile_traits.matrix_shape[batch_axis][1];
+                Index tile_n = C_tile_traits.matrix_shape[mdim][1]
+                    / tile_batch;
+                Index tile_inner = C_tile_traits.matrix_shape[group_axis][0]
+                    / C_tile_traits.matrix_shape[batch_axis][0];
+                Index tile_group = C_tile_traits.shape[group_axis];
+                for(Index l = 0; l < k; ++l)
+                {
+                    // C(i,j,b) = a*opA(i,l,b)*opB(l,j,b) + C(i,j,b)
+                    Index A_tile_offset = opA_stride[0]*i + opA_stride[1]*l;
+                    Index B_tile_offset = opB_stride[0]*l + opB_stride[1]*j;
+                    auto A_tile_handle = A.get_tile_handle(
+                            A_tile_offset + b_A*m*k);
+                    auto B_tile_handle = B.get_tile_handle(
+                            B_tile_offset + b_B*n*k);
+                    // Transfer tiles A and B on node with tile C
+                    A_tile_handle.mpi_transfer(C_tile_rank, mpi_rank);
+                    B_tile_handle.mpi_transfer(C_tile_rank, mpi_rank);
+                    // Execute on node with tile C
+                    if(mpi_rank == C_tile_rank)
+                    {
+                        Index tile_k;
+                        tile::TileTraits A_tile_traits(A_full.get_tile_shape(
+                                    A_full.grid.linear_to_index(
+                                        A_tile_offset + b*m*k)));
+                        switch(transA.value)
+                        {
+                            case TransOp::NoTrans:
+                                tile_k = A_tile_traits.matrix_shape[mdim][1]
+                                    / tile_batch;
+                                break;
+                                // This parameter was already checked
+                                //case TransOp::Trans:
+                            default:
+                                tile_k = A_tile_traits.matrix_shape[ndim][0];
+                                break;
+                        }
+                        starpu::gemm::submit<T>(transA, transB, tile_m,
+                                tile_n, tile_k, tile_batch, alpha,
+                                A_tile_handle, B_tile_handle,
+                                l == 0 ? C_beta : one, C_tile_handle, redux,
+                                tile_inner, tile_group, bcast);
+                    }
+                }
+                // Flush cache for the output tile on every node
+                C_tile_handle.mpi_flush();
+            }
+        }
+    }
+}
+
+//! Blocking version of tensor-wise gemm with an operand shared by a group
+/*! Matrix multiplication for tensors, which are virtually reshaped
+ *
+ * @param[in] alpha: Alpha multiplier
+ * @param[in] transA: Transposition flag for the tensor A
+ * @param[in] A: Input tensor A
+ * @param[in] transB: Transposition flag for the tensor B
+ * @param[in] B: Input tensor B
+ * @param[in] beta: Beta multiplier
+ * @param[inout] C: Output tensor C
+ * @param[in] ndim: Number of dimensions used in gemm contraction
+ * @param[in] batch_ndim: Number of last dimensions used for batching of gemms
+ *      of non-shared operands
+ * @param[in] group_dim: Position of the group dimension among batch
+ *      dimensions
+ * @param[in] bcast: Shared operand, see starpu::gemm::GroupBcast
+ * @param[in] redux: Whether or not to use STARPU_REDUX
+ * */
+template<typename T>
+void gemm_gqa(Scalar alpha, const TransOp &transA, const Tensor<T> &A,
+        const TransOp &transB, const Tensor<T> &B, Scalar beta,
+        const Tensor<T> &C, Index ndim, Index batch_ndim, Index group_dim,
+        int bcast, int redux)
+{
+    gemm_gqa_async<T>(alpha, transA, A, transB, B, beta, C, ndim,
+            batch_ndim, group_dim, bcast, redux);
+    starpu_task_wait_for_all();
+    starpu_mpi_wait_for_all(MPI_COMM_WORLD);
+}
+
+// Explicit instantiation
+template
+void gemm_gqa_async<fp32_t>(Scalar alpha, const TransOp &transA,
+        const Tensor<fp32_t> &A, const TransOp &transB,
+        const Tensor<fp32_t> &B, Scalar beta,
+        const Tensor<fp32_t> &C, Index ndim, Index batch_ndim,
+        Index group_dim, int bcast, int redux);
+
+template
+void gemm_gqa_async<fp32_fast_tf32_t>(Scalar alpha, const TransOp &transA,
+        const Tensor<fp32_fast_tf32_t> &A, const TransOp &transB,
+        const Tensor<fp32_fast_tf32_t> &B, Scalar beta,
+        const Tensor<fp32_fast_tf32_t> &C, Index ndim, Index batch_ndim,
+        Index group_dim, int bcast, int redux);
+
+template
+void gemm_gqa_async<fp32_fast_fp16_t>(Scalar alpha, const TransOp &transA,
+        const Tensor<fp32_fast_fp16_t> &A, const TransOp &transB,
+        const Tensor<fp32_fast_fp16_t> &B, Scalar beta,
+        const Tensor<fp32_fast_fp16_t> &C, Index ndim, Index batch_ndim,
+        Index group_dim, int bcast, int redux);
+
+template
+void gemm_gqa_async<fp32_fast_bf16_t>(Scalar alpha, const TransOp &transA,
+        const Tensor<fp32_fast_bf16_t> &A, const TransOp &transB,
+        const Tensor<fp32_fast_bf16_t> &B, Scalar beta,
+        const Tensor<fp32_fast_bf16_t> &C, Index ndim, Index batch_ndim,
+        Index group_dim, int bcast, int redux);
+
+template
+void gemm_gqa_async<fp64_t>(Scalar alpha, const TransOp &transA,
+        const Tensor<fp64_t> &A, const TransOp &transB,
+        const Tensor<fp64_t> &B, Scalar beta,
+        const Tensor<fp64_t> &C, Index ndim, Index batch_ndim,
+        Index group_dim, int bcast, int redux);
+
+template
+void gemm_gqa_async<bf16_t>(Scalar alpha, const TransOp &transA,
+        const Tensor<bf16_t> &A, const TransOp &transB,
+        const Tensor<bf16_t> &B, Scalar beta,
+        const Tensor<bf16_t> &C, Index ndim, Index batch_ndim,
+        Index group_dim, int bcast, int redux);
+
+template
+void gemm_gqa<fp32_t>(Scalar alpha, const TransOp &transA,
+        const Tensor<fp32_t> &A, const TransOp &transB,
+        const Tensor<fp32_t> &B, Scalar beta,
+        const Tensor<fp32_t> &C, Index ndim, Index batch_ndim,
+        Index group_dim, int bcast, int redux);
+
+template
+void gemm_gqa<fp32_fast_tf32_t>(Scalar alpha, const TransOp &transA,
+        const Tensor<fp32_fast_tf32_t> &A, const TransOp &transB,
+        const Tensor<fp32_fast_tf32_t> &B, Scalar beta,
+        const Tensor<fp32_fast_tf32_t> &C, Index ndim, Index batch_ndim,
+        Index group_dim, int bcast, int redux);
+
+template
+void gemm_gqa<fp32_fast_fp16_t>(Scalar alpha, const TransOp &transA,
+        const Tensor<fp32_fast_fp16_t> &A, const TransOp &transB,
+        const Tensor<fp32_fast_fp16_t> &B, Scalar beta,
+        const Tensor<fp32_fast_fp16_t> &C, Index ndim, Index batch_ndim,
+        Index group_dim, int bcast, int redux);
+
+template
+void gemm_gqa<fp32_fast_bf16_t>(Scalar alpha, const TransOp &transA,
+        const Tensor<fp32_fast_bf16_t> &A, const TransOp &transB,
+        const Tensor<fp32_fast_bf16_t> &B, Scalar beta,
+        const Tensor<fp32_fast_bf16_t> &C, Index ndim, Index batch_ndim,
+        Index group_dim, int bcast, int redux);
+
+template
+void gemm_gqa<fp64_t>(Scalar alpha, const TransOp &transA,
+        const Tensor<fp64_t> &A, const TransOp &transB,
+        const Tensor<fp64_t> &B, Scalar beta,
+        const Tensor<fp64_t> &C, Index ndim, Index batch_ndim,
+        Index group_dim, int bcast, int redux);
+
+template
+void gemm_gqa<bf16_t>(Scalar alpha, const TransOp &transA,
+        const Tensor<bf16_t> &A, const TransOp &transB,
+        const Tensor<bf16_t> &B, Scalar beta,
+        const Tensor<bf16_t> &C, Index ndim, Index batch_ndim,
+        Index group_dim, int bcast, int redux);
+
+} // namespace nntile::tensor
@@ -0,0 +1,179 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/tensor/gemm_packed.cc
+ * Product of a packed tensor by a tensor
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/gemm_packed.hh"
+#include "nntile/tensor/gemm.hh"
+#include "nntile/starpu/gemm_packed.hh"
+
+namespace nntile::tensor
+{
+
+//! Asynchronous product of a packed tensor by a tensor
+/*! Computes C = alpha*A*op(B) + beta*C as gemm_async with transA=NoTrans and
+ * batch_ndim=0, while tiles of A are packed by pack_panels_async with the
+ * same ndim. Tasks are executed only on CPU, where a packed tile is read
+ * sequentially and is not packed again by every gemm call.
+ *
+ * @param[in] alpha: Alpha multiplier
+ * @param[in] A: Input tensor, packed by pack_panels_async
+ * @param[in] transB: Transposition flag for the tensor B
+ * @param[in] B: Input tensor B
+ * @param[in] beta: Beta multiplier
+ * @param[inout] C: Output tensor C
+ * @param[in] ndim: Number of dimensions used in gemm contraction
+ * @param[in] redux: Whether or not to use STARPU_REDUX
+ * */
+template<typename T>
+void gemm_packed_async(Scalar alpha, const Tensor<T> &A,
+        const TransOp &transB, const Tensor<T> &B, Scalar beta,
+        const Tensor<T> &C, Index ndim, int redux)
+{
+    // Check inputs (throw exception in case of an error)
+    gemm_check(TransOp(TransOp::NoTrans), A, transB, B, C, ndim, 0);
+    // Sizes of A, B and C as simple matrices (grids of tiles)
+    int mpi_rank = starpu_mpi_world_rank();
+    constexpr Scalar one = 1;
+    Index m = C.grid.matrix_shape[A.ndim-ndim][0];
+    Index n = C.grid.matrix_shape[A.ndim-ndim][1];
+    Index k = A.grid.matrix_shape[A.ndim-ndim][1];
+    std::array<Index, 2> opB_stride;
+    switch(transB.value)
+    {
+        case TransOp::NoTrans:
+            opB_stride = {1, k};
+            break;
+        case TransOp::Trans:
+            opB_stride = {n, 1};
+            break;
+    }
+    for(Index j = 0; j < n; ++j)
+    {
+        for(Index i = 0; i < m; ++i)
+        {
+            Index C_tile_offset = j*m + i;
+            auto C_tile_handle = C.get_tile_handle(C_tile_offset);
+            auto C_tile_traits = C.get_tile_traits(C_tile_offset);
+            int C_tile_rank = C_tile_handle.mpi_get_rank();
+            Index tile_m = C_tile_traits.matrix_shape[A.ndim-ndim][0];
+            Index tile_n = C_tile_traits.matrix_shape[A.ndim-ndim][1];
+            // C(i,j) = a*A(i,0)*opB(0,j) + b*C(i,j) and then
+            // C(i,j) = a*A(i,l)*opB(l,j) + C(i,j) for all other l>0
+            for(Index l = 0; l < k; ++l)
+            {
+                Index A_tile_offset = l*m + i;
+                Index B_tile_offset = opB_stride[0]*l + opB_stride[1]*j;
+                auto A_tile_handle = A.get_tile_handle(A_tile_offset);
+                auto B_tile_handle = B.get_tile_handle(B_tile_offset);
+                // Transfer tiles A and B on node with tile C
+                A_tile_handle.mpi_transfer(C_tile_rank, mpi_rank);
+                B_tile_handle.mpi_transfer(C_tile_rank, mpi_rank);
+                // Execute on node with tile C
+                if(mpi_rank == C_tile_rank)
+                {
+                    auto A_tile_traits = A.get_tile_traits(A_tile_offset);
+                    Index tile_k = A_tile_traits.matrix_shape[A.ndim-ndim][1];
+                    starpu::gemm_packed::submit<T>(transB, tile_m, tile_n,
+                            tile_k, alpha, A_tile_handle, B_tile_handle,
+                            l == 0 ? beta : one, C_tile_handle, redux);
+                }
+            }
+            // Flush cache for the output tile on every node
+            C_tile_handle.mpi_flush();
+        }
+    }
+}
+
+//! Blocking version of a product of a packed tensor by a tensor
+/*! @param[in] alpha: Alpha multiplier
+ * @param[in] A: Input tensor, packed by pack_panels_async
+ * @param[in] transB: Transposition flag for the tensor B
+ * @param[in] B: Input tensor B
+ * @param[in] beta: Beta multiplier
+ * @param[inout] C: Output tensor C
+ * @param[in] ndim: Number of dimensions used in gemm contraction
+ * @param[in] redux: Whether or not to use STARPU_REDUX
+ * */
+template<typename T>
+void gemm_packed(Scalar alpha, const Tensor<T> &A, const TransOp &transB,
+        const Tensor<T> &B, Scalar beta, const Tensor<T> &C, Index ndim,
+        int redux)
+{
+    gemm_packed_async<T>(alpha, A, transB, B, beta, C, ndim, redux);
+    starpu_task_wait_for_all();
+    starpu_mpi_wait_for_all(MPI_COMM_WORLD);
+}
+
+// Explicit instantiation
+template
+void gemm_packed_async(Scalar alpha, const Tensor<fp32_t> &A,
+        const TransOp &transB, const Tensor<fp32_t> &B, Scalar beta,
+        const Tensor<fp32_t> &C, Index ndim, int redux);
+
+template
+void gemm_packed_async(Scalar alpha, const Tensor<fp32_fast_tf32_t> &A,
+        const TransOp &transB, const Tensor<fp32_fast_tf32_t> &B, Scalar beta,
+        const Tensor<fp32_fast_tf32_t> &C, Index ndim, int redux);
+
+template
+void gemm_packed_async(Scalar alpha, const Tensor<fp32_fast_fp16_t> &A,
+        const TransOp &transB, const Tensor<fp32_fast_fp16_t> &B, Scalar beta,
+        const Tensor<fp32_fast_fp16_t> &C, Index ndim, int redux);
+
+template
+void gemm_packed_async(Scalar alpha, const Tensor<fp32_fast_bf16_t> &A,
+        const TransOp &transB, const Tensor<fp32_fast_bf16_t> &B, Scalar beta,
+        const Tensor<fp32_fast_bf16_t> &C, Index ndim, int redux);
+
+template
+void gemm_packed_async(Scalar alpha, const Tensor<fp64_t> &A,
+        const TransOp &transB, const Tensor<fp64_t> &B, Scalar beta,
+        const Tensor<fp64_t> &C, Index ndim, int redux);
+
+template
+void gemm_packed_async(Scalar alpha, const Tensor<bf16_t> &A,
+        const TransOp &transB, const Tensor<bf16_t> &B, Scalar beta,
+        const Tensor<bf16_t> &C, Index ndim, int redux);
+
+// Explicit instantiation
+template
+void gemm_packed(Scalar alpha, const Tensor<fp32_t> &A, const TransOp &transB,
+        const Tensor<fp32_t> &B, Scalar beta, const Tensor<fp32_t> &C,
+        Index ndim, int redux);
+
+template
+void gemm_packed(Scalar alpha, const Tensor<fp32_fast_tf32_t> &A,
+        const TransOp &transB, const Tensor<fp32_fast_tf32_t> &B, Scalar beta,
+        const Tensor<fp32_fast_tf32_t> &C, Index ndim, int redux);
+
+template
+void gemm_packed(Scalar alpha, const Tensor<fp32_fast_fp16_t> &A,
+        const TransOp &transB, const Tensor<fp32_fast_fp16_t> &B, Scalar beta,
+        const Tensor<fp32_fast_fp16_t> &C, Index ndim, int redux);
+
+template
+void gemm_packed(Scalar alpha, const Tensor<fp32_fast_bf16_t> &A,
+        const TransOp &transB, const Tensor<fp32_fast_bf16_t> &B, Scalar beta,
+        const Tensor<fp32_fast_bf16_t> &C, Index ndim, int redux);
+
+template
+void gemm_packed(Scalar alpha, const Tensor<fp64_t> &A, const TransOp &transB,
+        const Tensor<fp64_t> &B, Scalar beta, const Tensor<fp64_t> &C,
+        Index ndim, int redux);
+
+template
+void gemm_packed(Scalar alpha, const Tensor<bf16_t> &A, const TransOp &transB,
+        const Tensor<bf16_t> &B, Scalar beta, const Tensor<bf16_t> &C,
+        Index ndim, int redux);
+
+} // namespace nntile::tensor
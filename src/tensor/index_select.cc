@@ -0,0 +1,201 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/tensor/index_select.cc
+ * Selection of slices of a tensor along an axis by indices
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/index_select.hh"
+#include "nntile/starpu/index_select.hh"
+
+namespace nntile::tensor
+{
+
+//! Asynchronous tensor-wise selection of slices by indices
+/*! Slice j of dst along the axis is a copy of slice index[j] of src along the
+ * same axis. Indices are read on a device, so that they may be produced by
+ * previous tasks (e.g., parent beams of beam search) without any
+ * synchronization with the host. Any index may be selected several times.
+ *
+ * @param[in] index: Indices of slices of src. It is a tensor of
+ *      dst.shape[axis] elements of any shape, which is not split into tiles.
+ *      All the indices must be within [0, src.shape[axis]).
+ * @param[in] src: Input tensor, that is not split into tiles along the axis
+ * @param[out] dst: Output tensor, that is not split into tiles along the axis.
+ *      Its shape and tiling must coincide with those of src except the axis.
+ * @param[in] axis: Axis along which slices are selected
+ * */
+template<typename T>
+void index_select_async(const Tensor<int64_t> &index, const Tensor<T> &src,
+        const Tensor<T> &dst, Index axis)
+{
+    // Check dimensions
+    if(src.ndim != dst.ndim)
+    {
+        throw std::runtime_error("src.ndim != dst.ndim");
+    }
+    // Treat special case of ndim=0
+    if(src.ndim == 0)
+    {
+        throw std::runtime_error("Scalar input makes no sense");
+    }
+    // Check axis
+    if(axis < 0)
+    {
+        throw std::runtime_error("axis < 0");
+    }
+    if(axis >= src.ndim)
+    {
+        throw std::runtime_error("axis >= src.ndim");
+    }
+    // Check shapes of tensors
+    for(Index i = 0; i < src.ndim; ++i)
+    {
+        if(i == axis)
+        {
+            continue;
+        }
+        if(src.shape[i] != dst.shape[i])
+        {
+            throw std::runtime_error("src.shape[i] != dst.shape[i]");
+        }
+        if(src.basetile_shape[i] != dst.basetile_shape[i])
+        {
+            throw std::runtime_error("src.basetile_shape[i] != "
+                    "dst.basetile_shape[i]");
+        }
+    }
+    if(src.basetile_shape[axis] != src.shape[axis])
+    {
+        throw std::runtime_error("src.basetile_shape[axis] != "
+                "src.shape[axis]");
+    }
+    if(dst.basetile_shape[axis] != dst.shape[axis])
+    {
+        throw std::runtime_error("dst.basetile_shape[axis] != "
+                "dst.shape[axis]");
+    }
+    if(index.nelems != dst.shape[axis])
+    {
+        throw std::runtime_error("index.nelems != dst.shape[axis]");
+    }
+    if(index.grid.nelems != 1)
+    {
+        throw std::runtime_error("index.grid.nelems != 1");
+    }
+    // Do actual calculations
+    int mpi_rank = starpu_mpi_world_rank();
+    auto index_tile_handle = index.get_tile_handle(0);
+    for(Index i = 0; i < dst.grid.nelems; ++i)
+    {
+        // Source tile has the same index, as the axis is not split
+        auto src_tile_handle = src.get_tile_handle(i);
+        auto dst_tile_handle = dst.get_tile_handle(i);
+        int dst_tile_rank = dst_tile_handle.mpi_get_rank();
+        // Transfer data
+        index_tile_handle.mpi_transfer(dst_tile_rank, mpi_rank);
+        src_tile_handle.mpi_transfer(dst_tile_rank, mpi_rank);
+        // Execute on destination node
+        if(mpi_rank == dst_tile_rank)
+        {
+            auto dst_tile_traits = dst.get_tile_traits(i);
+            Index m = dst_tile_traits.stride[axis];
+            Index n = dst_tile_traits.shape[axis];
+            Index k = dst_tile_traits.matrix_shape[axis+1][1];
+            starpu::index_select::submit<T>(m, n, k, src.shape[axis],
+                    index_tile_handle, src_tile_handle, dst_tile_handle);
+        }
+        // Flush cache for the output tile on every node
+        dst_tile_handle.mpi_flush();
+    }
+}
+
+//! Blocking version of tensor-wise selection of slices by indices
+/*! Slice j of dst along the axis is a copy of slice index[j] of src.
+ *
+ * @param[in] index: Indices of slices of src
+ * @param[in] src: Input tensor
+ * @param[out] dst: Output tensor
+ * @param[in] axis: Axis along which slices are selected
+ * */
+template<typename T>
+void index_select(const Tensor<int64_t> &index, const Tensor<T> &src,
+        const Tensor<T> &dst, Index axis)
+{
+    index_select_async<T>(index, src, dst, axis);
+    starpu_task_wait_for_all();
+    starpu_mpi_wait_for_all(MPI_COMM_WORLD);
+}
+
+// Explicit instantiation
+template
+void index_select_async<fp32_t>(const Tensor<int64_t> &index,
+        const Tensor<fp32_t> &src, const Tensor<fp32_t> &dst, Index axis);
+
+template
+void index_select_async<fp32_fast_tf32_t>(const Tensor<int64_t> &index,
+        const Tensor<fp32_fast_tf32_t> &src,
+        const Tensor<fp32_fast_tf32_t> &dst, Index axis);
+
+template
+void index_select_async<fp32_fast_fp16_t>(const Tensor<int64_t> &index,
+        const Tensor<fp32_fast_fp16_t> &src,
+        const Tensor<fp32_fast_fp16_t> &dst, Index axis);
+
+template
+void index_select_async<fp32_fast_bf16_t>(const Tensor<int64_t> &index,
+        const Tensor<fp32_fast_bf16_t> &src,
+        const Tensor<fp32_fast_bf16_t> &dst, Index axis);
+
+template
+void index_select_async<fp64_t>(const Tensor<int64_t> &index,
+        const Tensor<fp64_t> &src, const Tensor<fp64_t> &dst, Index axis);
+
+template
+void index_select_async<bf16_t>(const Tensor<int64_t> &index,
+        const Tensor<bf16_t> &src, const Tensor<bf16_t> &dst, Index axis);
+
+template
+void index_select_async<int64_t>(const Tensor<int64_t> &index,
+        const Tensor<int64_t> &src, const Tensor<int64_t> &dst, Index axis);
+
+// Explicit instantiation
+template
+void index_select<fp32_t>(const Tensor<int64_t> &index,
+        const Tensor<fp32_t> &src, const Tensor<fp32_t> &dst, Index axis);
+
+template
+void index_select<fp32_fast_tf32_t>(const Tensor<int64_t> &index,
+        const Tensor<fp32_fast_tf32_t> &src,
+        const Tensor<fp32_fast_tf32_t> &dst, Index axis);
+
+template
+void index_select<fp32_fast_fp16_t>(const Tensor<int64_t> &index,
+        const Tensor<fp32_fast_fp16_t> &src,
+        const Tensor<fp32_fast_fp16_t> &dst, Index axis);
+
+template
+void index_select<fp32_fast_bf16_t>(const Tensor<int64_t> &index,
+        const Tensor<fp32_fast_bf16_t> &src,
+        const Tensor<fp32_fast_bf16_t> &dst, Index axis);
+
+template
+void index_select<fp64_t>(const Tensor<int64_t> &index,
+        const Tensor<fp64_t> &src, const Tensor<fp64_t> &dst, Index axis);
+
+template
+void index_select<bf16_t>(const Tensor<int64_t> &index,
+        const Tensor<bf16_t> &src, const Tensor<bf16_t> &dst, Index axis);
+
+template
+void index_select<int64_t>(const Tensor<int64_t> &index,
+        const Tensor<int64_t> &src, const Tensor<int64_t> &dst, Index axis);
+
+} // namespace nntile::tensor
@@ -13,7 +13,9 @@
  * */
 
 #include "nntile/tensor/mask_scalar.hh"
+#include "nntile/tensor/mask_tile_status.hh"
 #include "nntile/starpu/mask_scalar.hh"
+#include "nntile/starpu/fill.hh"
 
 namespace nntile::tensor
 {
@@ -23,7 +25,7 @@ namespace nntile::tensor
 // @param[inout] A: Tensor for the element-wise fill operation
 template<typename T>
 void mask_scalar_async(const Tensor<bool_t> &mask, Scalar val, const Tensor<T> &A,
-        Index batch_ndim)
+        Index batch_ndim, const std::vector<int> &mask_tile_status)
 {
     if(mask.ndim != A.ndim-batch_ndim)
     {
@@ -42,6 +44,7 @@ void mask_scalar_async(const Tensor<bool_t> &mask, Scalar val, const Tensor<T> &
                     "mask.basetile_shape[i]");
         }
     }
+    mask_tile_status_check(mask, mask_tile_status);
     // Run the code
     int mpi_rank = starpu_mpi_world_rank();
     for(Index i = 0; i < A.grid.nelems; ++i)
@@ -54,6 +57,26 @@ void mask_scalar_async(const Tensor<bool_t> &mask, Scalar val, const Tensor<T> &
         {
             mask_tile_index[j] = A_tile_index[j];
         }
+        int status = mask_tile_status_get(mask, mask_tile_status,
+                mask_tile_index);
+        // Nothing to do if no element of the tile is masked out
+        if(status == MASK_TILE_FULL)
+        {
+            continue;
+        }
+        // Fill entire tile without reading the mask if all of its elements
+        // are masked out
+        if(status == MASK_TILE_EMPTY)
+        {
+            if(mpi_rank == A_tile_rank)
+            {
+                auto tile_traits = A.get_tile_traits(i);
+                starpu::fill::submit<T>(tile_traits.nelems, val,
+                        A_tile_handle);
+            }
+            A_tile_handle.mpi_flush();
+            continue;
+        }
         auto mask_tile_handle = mask.get_tile_handle(mask_tile_index);
         int mask_tile_rank = mask_tile_handle.mpi_get_rank();
         mask_tile_handle.mpi_transfer(A_tile_rank, mpi_rank);
@@ -76,9 +99,9 @@ void mask_scalar_async(const Tensor<bool_t> &mask, Scalar val, const Tensor<T> &
 // @param[inout] A: Tensor for the element-wise mask scalar operation
 template<typename T>
 void mask_scalar(const Tensor<bool_t> &mask, Scalar val, const Tensor<T> &A,
-        Index batch_ndim)
+        Index batch_ndim, const std::vector<int> &mask_tile_status)
 {
-    mask_scalar_async<T>(mask, val, A, batch_ndim);
+    mask_scalar_async<T>(mask, val, A, batch_ndim, mask_tile_status);
     starpu_task_wait_for_all();
     starpu_mpi_wait_for_all(MPI_COMM_WORLD);
 }
@@ -86,51 +109,63 @@ void mask_scalar(const Tensor<bool_t> &mask, Scalar val, const Tensor<T> &A,
 // Explicit instantiation
 template
 void mask_scalar_async<fp32_t>(const Tensor<bool_t> &mask, Scalar val,
-        const Tensor<fp32_t> &A, Index batch_ndim);
+        const Tensor<fp32_t> &A, Index batch_ndim,
+        const std::vector<int> &mask_tile_status);
 
 template
 void mask_scalar_async<fp32_fast_tf32_t>(const Tensor<bool_t> &mask, Scalar val,
-        const Tensor<fp32_fast_tf32_t> &A, Index batch_ndim);
+        const Tensor<fp32_fast_tf32_t> &A, Index batch_ndim,
+        const std::vector<int> &mask_tile_status);
 
 template
 void mask_scalar_async<fp32_fast_fp16_t>(const Tensor<bool_t> &mask, Scalar val,
-        const Tensor<fp32_fast_fp16_t> &A, Index batch_ndim);
+        const Tensor<fp32_fast_fp16_t> &A, Index batch_ndim,
+        const std::vector<int> &mask_tile_status);
 
 template
 void mask_scalar_async<fp32_fast_bf16_t>(const Tensor<bool_t> &mask, Scalar val,
-        const Tensor<fp32_fast_bf16_t> &A, Index batch_ndim);
+        const Tensor<fp32_fast_bf16_t> &A, Index batch_ndim,
+        const std::vector<int> &mask_tile_status);
 
 template
 void mask_scalar_async<fp64_t>(const Tensor<bool_t> &mask, Scalar val,
-        const Tensor<fp64_t> &A, Index batch_ndim);
+        const Tensor<fp64_t> &A, Index batch_ndim,
+        const std::vector<int> &mask_tile_status);
 
 template
 void mask_scalar_async<bf16_t>(const Tensor<bool_t> &mask, Scalar val,
-        const Tensor<bf16_t> &A, Index batch_ndim);
+        const Tensor<bf16_t> &A, Index batch_ndim,
+        const std::vector<int> &mask_tile_status);
 
 // Explicit instantiation
 template
 void mask_scalar<fp32_t>(const Tensor<bool_t> &mask, Scalar val,
-        const Tensor<fp32_t> &A, Index batch_ndim);
+        const Tensor<fp32_t> &A, Index batch_ndim,
+        const std::vector<int> &mask_tile_status);
 
 template
 void mask_scalar<fp32_fast_tf32_t>(const Tensor<bool_t> &mask, Scalar val,
-        const Tensor<fp32_fast_tf32_t> &A, Index batch_ndim);
+        const Tensor<fp32_fast_tf32_t> &A, Index batch_ndim,
+        const std::vector<int> &mask_tile_status);
 
 template
 void mask_scalar<fp32_fast_fp16_t>(const Tensor<bool_t> &mask, Scalar val,
-        const Tensor<fp32_fast_fp16_t> &A, Index batch_ndim);
+        const Tensor<fp32_fast_fp16_t> &A, Index batch_ndim,
+        const std::vector<int> &mask_tile_status);
 
 template
 void mask_scalar<fp32_fast_bf16_t>(const Tensor<bool_t> &mask, Scalar val,
-        const Tensor<fp32_fast_bf16_t> &A, Index batch_ndim);
+        const Tensor<fp32_fast_bf16_t> &A, Index batch_ndim,
+        const std::vector<int> &mask_tile_status);
 
 template
 void mask_scalar<fp64_t>(const Tensor<bool_t> &mask, Scalar val,
-        const Tensor<fp64_t> &A, Index batch_ndim);
+        const Tensor<fp64_t> &A, Index batch_ndim,
+        const std::vector<int> &mask_tile_status);
 
 template
 void mask_scalar<bf16_t>(const Tensor<bool_t> &mask, Scalar val,
-        const Tensor<bf16_t> &A, Index batch_ndim);
+        const Tensor<bf16_t> &A, Index batch_ndim,
+        const std::vector<int> &mask_tile_status);
 
 } // namespace nntile::tensor
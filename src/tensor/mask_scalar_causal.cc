@@ -0,0 +1,138 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/tensor/mask_scalar_causal.cc
+ * Implicit causal mask with scalar on tensor
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/mask_scalar_causal.hh"
+#include "nntile/tensor/mask_tile_status.hh"
+#include "nntile/starpu/mask_scalar_causal.hh"
+#include "nntile/starpu/fill.hh"
+
+namespace nntile::tensor
+{
+
+//! Asynchronous tensor-wise implicit causal mask operation
+/*! Attention scores A of shape (n_seq_k, n_seq_q, batch...) are updated
+ * without any mask tensor: key k is masked out for query q if k > q+offset,
+ * or if q+offset-k >= window (window > 0), or if k >= kv_len (kv_len >= 0).
+ * Tiles with no masked element are skipped, and fully masked tiles are simply
+ * filled with val.
+ *
+ * @param[in] offset: Position of the first query relative to the first key
+ * @param[in] window: Size of sliding window or 0 to disable it
+ * @param[in] kv_len: Number of valid keys or -1 to disable padding
+ * @param[in] val: Value to set for masked out elements
+ * @param[inout] A: Tensor of attention scores
+ * @param[in] batch_ndim: Number of trailing batch dimensions of A
+ * */
+template<typename T>
+void mask_scalar_causal_async(Index offset, Index window, Index kv_len,
+        Scalar val, const Tensor<T> &A, Index batch_ndim)
+{
+    if(A.ndim-batch_ndim != 2)
+    {
+        throw std::runtime_error("A.ndim-batch_ndim != 2");
+    }
+    // Run the code
+    int mpi_rank = starpu_mpi_world_rank();
+    for(Index i = 0; i < A.grid.nelems; ++i)
+    {
+        auto A_tile_handle = A.get_tile_handle(i);
+        int A_tile_rank = A_tile_handle.mpi_get_rank();
+        // Execute only on node-owner
+        if(mpi_rank == A_tile_rank)
+        {
+            auto A_tile_index = A.grid.linear_to_index(i);
+            auto tile_traits = A.get_tile_traits(i);
+            Index m = tile_traits.shape[0], n = tile_traits.shape[1];
+            Index batch = tile_traits.matrix_shape[2][1];
+            Index k_start = A_tile_index[0] * A.basetile_shape[0];
+            Index q_start = A_tile_index[1]*A.basetile_shape[1] + offset;
+            int status = mask_causal_tile_status(k_start, k_start+m, q_start,
+                    q_start+n, window, kv_len);
+            if(status == MASK_TILE_EMPTY)
+            {
+                starpu::fill::submit<T>(tile_traits.nelems, val,
+                        A_tile_handle);
+            }
+            else if(status == MASK_TILE_PARTIAL)
+            {
+                starpu::mask_scalar_causal::submit<T>(m, n, batch, k_start,
+                        q_start, window, kv_len, val, A_tile_handle);
+            }
+        }
+        // Flush cache for the output tile on every node
+        A_tile_handle.mpi_flush();
+    }
+}
+
+//! Blocking version of tensor-wise implicit causal mask operation
+template<typename T>
+void mask_scalar_causal(Index offset, Index window, Index kv_len, Scalar val,
+        const Tensor<T> &A, Index batch_ndim)
+{
+    mask_scalar_causal_async<T>(offset, window, kv_len, val, A, batch_ndim);
+    starpu_task_wait_for_all();
+    starpu_mpi_wait_for_all(MPI_COMM_WORLD);
+}
+
+// Explicit instantiation
+template
+void mask_scalar_causal_async<fp32_t>(Index offset, Index window, Index kv_len,
+        Scalar val, const Tensor<fp32_t> &A, Index batch_ndim);
+
+template
+void mask_scalar_causal_async<fp32_fast_tf32_t>(Index offset, Index window, Index kv_len,
+        Scalar val, const Tensor<fp32_fast_tf32_t> &A, Index batch_ndim);
+
+template
+void mask_scalar_causal_async<fp32_fast_fp16_t>(Index offset, Index window, Index kv_len,
+        Scalar val, const Tensor<fp32_fast_fp16_t> &A, Index batch_ndim);
+
+template
+void mask_scalar_causal_async<fp32_fast_bf16_t>(Index offset, Index window, Index kv_len,
+        Scalar val, const Tensor<fp32_fast_bf16_t> &A, Index batch_ndim);
+
+template
+void mask_scalar_causal_async<fp64_t>(Index offset, Index window, Index kv_len,
+        Scalar val, const Tensor<fp64_t> &A, Index batch_ndim);
+
+template
+void mask_scalar_causal_async<bf16_t>(Index offset, Index window, Index kv_len,
+        Scalar val, const Tensor<bf16_t> &A, Index batch_ndim);
+
+// Explicit instantiation
+template
+void mask_scalar_causal<fp32_t>(Index offset, Index window, Index kv_len,
+        Scalar val, const Tensor<fp32_t> &A, Index batch_ndim);
+
+template
+void mask_scalar_causal<fp32_fast_tf32_t>(Index offset, Index window, Index kv_len,
+        Scalar val, const Tensor<fp32_fast_tf32_t> &A, Index batch_ndim);
+
+template
+void mask_scalar_causal<fp32_fast_fp16_t>(Index offset, Index window, Index kv_len,
+        Scalar val, const Tensor<fp32_fast_fp16_t> &A, Index batch_ndim);
+
+template
+void mask_scalar_causal<fp32_fast_bf16_t>(Index offset, Index window, Index kv_len,
+        Scalar val, const Tensor<fp32_fast_bf16_t> &A, Index batch_ndim);
+
+template
+void mask_scalar_causal<fp64_t>(Index offset, Index window, Index kv_len,
+        Scalar val, const Tensor<fp64_t> &A, Index batch_ndim);
+
+template
+void mask_scalar_causal<bf16_t>(Index offset, Index window, Index kv_len,
+        Scalar val, const Tensor<bf16_t> &A, Index batch_ndim);
+
+} // namespace nntile::tensor
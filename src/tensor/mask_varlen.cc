@@ -0,0 +1,211 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/tensor/mask_varlen.cc
+ * Boolean mask of packed sequences of variable lengths
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/mask_varlen.hh"
+#include "nntile/tensor/mask_tile_status.hh"
+#include "nntile/starpu/mask_varlen.hh"
+#include <algorithm>
+
+namespace nntile::tensor
+{
+
+//! Check descriptor of packed sequences against a mask
+static void mask_varlen_check(const std::vector<Index> &cu_seqlens_k,
+        const std::vector<Index> &cu_seqlens_q, const TensorTraits &mask)
+{
+    if(mask.ndim != 2)
+    {
+        throw std::runtime_error("mask.ndim != 2");
+    }
+    if(cu_seqlens_k.size() != cu_seqlens_q.size())
+    {
+        throw std::runtime_error("cu_seqlens_k.size() != "
+                "cu_seqlens_q.size()");
+    }
+    if(cu_seqlens_k.size() < 2)
+    {
+        throw std::runtime_error("cu_seqlens_k.size() < 2");
+    }
+    if(cu_seqlens_k[0] != 0 or cu_seqlens_q[0] != 0)
+    {
+        throw std::runtime_error("Packed sequences shall start at 0");
+    }
+    for(std::size_t s = 1; s < cu_seqlens_k.size(); ++s)
+    {
+        if(cu_seqlens_k[s] < cu_seqlens_k[s-1]
+                or cu_seqlens_q[s] < cu_seqlens_q[s-1])
+        {
+            throw std::runtime_error("Sequence of negative length");
+        }
+    }
+    if(cu_seqlens_k.back() > mask.shape[0])
+    {
+        throw std::runtime_error("cu_seqlens_k.back() > mask.shape[0]");
+    }
+    if(cu_seqlens_q.back() > mask.shape[1])
+    {
+        throw std::runtime_error("cu_seqlens_q.back() > mask.shape[1]");
+    }
+}
+
+//! Run over sequences, whose queries intersect a tile of a mask
+/*! For every run of queries [j_begin, j_end) of the tile, that belong to the
+ * same sequence, calls func(j_begin, j_end, i_lo, i_hi, diag) with arguments
+ * of the kernel::mask_varlen. Queries beyond the last sequence are padding
+ * and they see no keys at all.
+ * */
+template<typename F>
+static void mask_varlen_tile_runs(const std::vector<Index> &cu_seqlens_k,
+        const std::vector<Index> &cu_seqlens_q, Index k_start, Index q_start,
+        Index n, F func)
+{
+    Index nseq = cu_seqlens_q.size() - 1;
+    // Find the first sequence with a query at position q_start or later
+    Index s = std::upper_bound(cu_seqlens_q.begin(), cu_seqlens_q.end(),
+            q_start) - cu_seqlens_q.begin() - 1;
+    Index q = q_start;
+    for(; s < nseq and q < q_start+n; ++s)
+    {
+        Index q_end = std::min(cu_seqlens_q[s+1], q_start+n);
+        if(q_end <= q)
+        {
+            continue;
+        }
+        // Queries are aligned to the last keys of the sequence
+        Index shift = (cu_seqlens_k[s+1]-cu_seqlens_k[s])
+            - (cu_seqlens_q[s+1]-cu_seqlens_q[s]);
+        Index diag = (q-cu_seqlens_q[s]) + shift
+            - (k_start-cu_seqlens_k[s]);
+        func(q-q_start, q_end-q_start, cu_seqlens_k[s]-k_start,
+                cu_seqlens_k[s+1]-k_start, diag);
+        q = q_end;
+    }
+    if(q < q_start+n)
+    {
+        func(q-q_start, n, 0, 0, 0);
+    }
+}
+
+//! Asynchronous tensor-wise boolean mask of packed sequences
+/*! Several sequences are packed one after another along keys (rows of the
+ * mask) and queries (columns of the mask), sequence s takes keys
+ * [cu_seqlens_k[s], cu_seqlens_k[s+1]) and queries
+ * [cu_seqlens_q[s], cu_seqlens_q[s+1]). A query sees only keys of its own
+ * sequence, that are not in its future. Queries of a sequence are aligned to
+ * its last keys, so the same descriptor serves prefill (equal numbers of keys
+ * and queries) and decode (a few new queries over a long KV-cache). Keys and
+ * queries beyond the last sequence are padding and they are masked out.
+ *
+ * @param[in] cu_seqlens_k: Cumulative numbers of keys of sequences
+ * @param[in] cu_seqlens_q: Cumulative numbers of queries of sequences
+ * @param[out] mask: Boolean mask of shape (n_seq_k, n_seq_q)
+ * */
+void mask_varlen_async(const std::vector<Index> &cu_seqlens_k,
+        const std::vector<Index> &cu_seqlens_q, const Tensor<bool_t> &mask)
+{
+    mask_varlen_check(cu_seqlens_k, cu_seqlens_q, mask);
+    int mpi_rank = starpu_mpi_world_rank();
+    for(Index i = 0; i < mask.grid.nelems; ++i)
+    {
+        auto tile_handle = mask.get_tile_handle(i);
+        int tile_rank = tile_handle.mpi_get_rank();
+        // Execute only on node-owner
+        if(mpi_rank == tile_rank)
+        {
+            auto tile_index = mask.grid.linear_to_index(i);
+            auto tile_traits = mask.get_tile_traits(i);
+            Index m = tile_traits.shape[0], n = tile_traits.shape[1];
+            Index k_start = tile_index[0] * mask.basetile_shape[0];
+            Index q_start = tile_index[1] * mask.basetile_shape[1];
+            mask_varlen_tile_runs(cu_seqlens_k, cu_seqlens_q, k_start,
+                    q_start, n,
+                    [&](Index j_begin, Index j_end, Index i_lo, Index i_hi,
+                        Index diag)
+                    {
+                        starpu::mask_varlen::submit(m, j_end-j_begin,
+                                j_begin, i_lo, i_hi, diag, tile_handle);
+                    });
+        }
+        // Flush cache for the output tile on every node
+        tile_handle.mpi_flush();
+    }
+}
+
+//! Blocking version of tensor-wise boolean mask of packed sequences
+void mask_varlen(const std::vector<Index> &cu_seqlens_k,
+        const std::vector<Index> &cu_seqlens_q, const Tensor<bool_t> &mask)
+{
+    mask_varlen_async(cu_seqlens_k, cu_seqlens_q, mask);
+    starpu_task_wait_for_all();
+    starpu_mpi_wait_for_all(MPI_COMM_WORLD);
+}
+
+//! Status of every tile of a boolean mask of packed sequences
+/*! Statuses are evaluated from the descriptor without reading the mask, so
+ * attention operations skip tiles, where queries and keys belong to different
+ * sequences, right from the start.
+ *
+ * @param[in] cu_seqlens_k: Cumulative numbers of keys of sequences
+ * @param[in] cu_seqlens_q: Cumulative numbers of queries of sequences
+ * @param[in] mask: Traits of the mask
+ * */
+std::vector<int> mask_varlen_tile_status(
+        const std::vector<Index> &cu_seqlens_k,
+        const std::vector<Index> &cu_seqlens_q, const TensorTraits &mask)
+{
+    mask_varlen_check(cu_seqlens_k, cu_seqlens_q, mask);
+    std::vector<int> status(mask.grid.nelems);
+    for(Index i = 0; i < mask.grid.nelems; ++i)
+    {
+        auto tile_index = mask.grid.linear_to_index(i);
+        auto tile_shape = mask.get_tile_shape(tile_index);
+        Index m = tile_shape[0], n = tile_shape[1];
+        Index k_start = tile_index[0] * mask.basetile_shape[0];
+        Index q_start = tile_index[1] * mask.basetile_shape[1];
+        bool any_kept = false, all_kept = true;
+        mask_varlen_tile_runs(cu_seqlens_k, cu_seqlens_q, k_start, q_start,
+                n,
+                [&](Index j_begin, Index j_end, Index i_lo, Index i_hi,
+                    Index diag)
+                {
+                    // The last query of the run sees most of the keys
+                    Index lo = std::max<Index>(i_lo, 0);
+                    Index hi = std::min({i_hi, j_end-j_begin+diag, m});
+                    if(hi > lo)
+                    {
+                        any_kept = true;
+                    }
+                    // The first query of the run sees least of the keys
+                    if(i_lo > 0 or i_hi < m or diag < m-1)
+                    {
+                        all_kept = false;
+                    }
+                });
+        if(!any_kept)
+        {
+            status[i] = MASK_TILE_EMPTY;
+        }
+        else if(all_kept)
+        {
+            status[i] = MASK_TILE_FULL;
+        }
+        else
+        {
+            status[i] = MASK_TILE_PARTIAL;
+        }
+    }
+    return status;
+}
+
+} // namespace nntile::tensor
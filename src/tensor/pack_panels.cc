@@ -0,0 +1,133 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/tensor/pack_panels.cc
+ * Packing of a matrix into panels of rows
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/pack_panels.hh"
+#include "nntile/starpu/pack_panels.hh"
+
+namespace nntile::tensor
+{
+
+//! Asynchronous tensor-wise packing of matrices into panels of rows
+/*! Every tile of src is viewed as a matrix, whose columns are the last ndim
+ * dimensions, and is packed into the layout of kernel::pack_panels. The
+ * output is meant only for gemm_packed_async with the same ndim.
+ *
+ * @param[in] src: Input tensor
+ * @param[out] dst: Output tensor of the same shape and tiling as src
+ * @param[in] ndim: Number of last dimensions, that form columns of a matrix
+ * */
+template<typename T>
+void pack_panels_async(const Tensor<T> &src, const Tensor<T> &dst,
+        Index ndim)
+{
+    // Check inputs
+    if(ndim < 0 or ndim > src.ndim)
+    {
+        throw std::runtime_error("ndim < 0 or ndim > src.ndim");
+    }
+    if(src.shape != dst.shape)
+    {
+        throw std::runtime_error("src.shape != dst.shape");
+    }
+    if(src.basetile_shape != dst.basetile_shape)
+    {
+        throw std::runtime_error("src.basetile_shape != dst.basetile_shape");
+    }
+    // Do actual calculations
+    int mpi_rank = starpu_mpi_world_rank();
+    for(Index i = 0; i < dst.grid.nelems; ++i)
+    {
+        auto src_tile_handle = src.get_tile_handle(i);
+        auto dst_tile_handle = dst.get_tile_handle(i);
+        int dst_tile_rank = dst_tile_handle.mpi_get_rank();
+        // Transfer data
+        src_tile_handle.mpi_transfer(dst_tile_rank, mpi_rank);
+        // Execute on destination node
+        if(mpi_rank == dst_tile_rank)
+        {
+            auto tile_traits = dst.get_tile_traits(i);
+            Index m = tile_traits.matrix_shape[dst.ndim-ndim][0];
+            Index k = tile_traits.matrix_shape[dst.ndim-ndim][1];
+            starpu::pack_panels::submit<T>(m, k, src_tile_handle,
+                    dst_tile_handle);
+        }
+        // Flush cache for the output tile on every node
+        dst_tile_handle.mpi_flush();
+    }
+}
+
+//! Blocking version of tensor-wise packing of matrices into panels of rows
+/*! @param[in] src: Input tensor
+ * @param[out] dst: Output tensor of the same shape and tiling as src
+ * @param[in] ndim: Number of last dimensions, that form columns of a matrix
+ * */
+template<typename T>
+void pack_panels(const Tensor<T> &src, const Tensor<T> &dst, Index ndim)
+{
+    pack_panels_async<T>(src, dst, ndim);
+    starpu_task_wait_for_all();
+    starpu_mpi_wait_for_all(MPI_COMM_WORLD);
+}
+
+// Explicit instantiation
+template
+void pack_panels_async(const Tensor<fp32_t> &src, const Tensor<fp32_t> &dst,
+        Index ndim);
+
+template
+void pack_panels_async(const Tensor<fp32_fast_tf32_t> &src,
+        const Tensor<fp32_fast_tf32_t> &dst, Index ndim);
+
+template
+void pack_panels_async(const Tensor<fp32_fast_fp16_t> &src,
+        const Tensor<fp32_fast_fp16_t> &dst, Index ndim);
+
+template
+void pack_panels_async(const Tensor<fp32_fast_bf16_t> &src,
+        const Tensor<fp32_fast_bf16_t> &dst, Index ndim);
+
+template
+void pack_panels_async(const Tensor<fp64_t> &src, const Tensor<fp64_t> &dst,
+        Index ndim);
+
+template
+void pack_panels_async(const Tensor<bf16_t> &src, const Tensor<bf16_t> &dst,
+        Index ndim);
+
+// Explicit instantiation
+template
+void pack_panels(const Tensor<fp32_t> &src, const Tensor<fp32_t> &dst,
+        Index ndim);
+
+template
+void pack_panels(const Tensor<fp32_fast_tf32_t> &src,
+        const Tensor<fp32_fast_tf32_t> &dst, Index ndim);
+
+template
+void pack_panels(const Tensor<fp32_fast_fp16_t> &src,
+        const Tensor<fp32_fast_fp16_t> &dst, Index ndim);
+
+template
+void pack_panels(const Tensor<fp32_fast_bf16_t> &src,
+        const Tensor<fp32_fast_bf16_t> &dst, Index ndim);
+
+template
+void pack_panels(const Tensor<fp64_t> &src, const Tensor<fp64_t> &dst,
+        Index ndim);
+
+template
+void pack_panels(const Tensor<bf16_t> &src, const Tensor<bf16_t> &dst,
+        Index ndim);
+
+} // namespace nntile::tensor
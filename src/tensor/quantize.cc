@@ -0,0 +1,168 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/tensor/quantize.cc
+ * Symmetric int8 quantization of a tensor along the first axis
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/quantize.hh"
+#include "nntile/starpu/quantize.hh"
+
+namespace nntile::tensor
+{
+
+//! Asynchronous tensor-wise int8 quantization
+/*! Every fiber along the first axis (e.g., a single head of a single token
+ * of keys or values) is quantized with its own scale, so appending new
+ * fibers never requires to requantize old ones. See kernel::quantize for
+ * details.
+ *
+ * @param[in] src: Input tensor, whose first axis is not split into tiles
+ * @param[out] dst: Quantized values of the same shape and tiling as src
+ * @param[out] scale: Scales of shape src.shape[1:], that shall be placed on
+ *      the same nodes as dst
+ * */
+template<typename T>
+void quantize_async(const Tensor<T> &src, const Tensor<int8_t> &dst,
+        const Tensor<T> &scale)
+{
+    // Check dimensions
+    if(src.ndim == 0)
+    {
+        throw std::runtime_error("Scalar input makes no sense");
+    }
+    if(src.ndim != scale.ndim+1)
+    {
+        throw std::runtime_error("src.ndim != scale.ndim+1");
+    }
+    // Check shapes
+    if(src.shape != dst.shape)
+    {
+        throw std::runtime_error("src.shape != dst.shape");
+    }
+    if(src.basetile_shape != dst.basetile_shape)
+    {
+        throw std::runtime_error("src.basetile_shape != dst.basetile_shape");
+    }
+    Index m = src.shape[0];
+    if(src.basetile_shape[0] != m)
+    {
+        throw std::runtime_error("src.basetile_shape[0] != src.shape[0]");
+    }
+    for(Index i = 0; i < scale.ndim; ++i)
+    {
+        if(src.shape[i+1] != scale.shape[i])
+        {
+            throw std::runtime_error("src.shape[i+1] != scale.shape[i]");
+        }
+        if(src.basetile_shape[i+1] != scale.basetile_shape[i])
+        {
+            throw std::runtime_error("src.basetile_shape[i+1] != "
+                    "scale.basetile_shape[i]");
+        }
+    }
+    // Do actual calculations
+    int mpi_rank = starpu_mpi_world_rank();
+    for(Index i = 0; i < dst.grid.nelems; ++i)
+    {
+        auto src_tile_handle = src.get_tile_handle(i);
+        auto dst_tile_handle = dst.get_tile_handle(i);
+        int dst_tile_rank = dst_tile_handle.mpi_get_rank();
+        auto tile_index = dst.grid.linear_to_index(i);
+        std::vector<Index> scale_tile_index(tile_index.cbegin()+1,
+                tile_index.cend());
+        auto scale_tile_handle = scale.get_tile_handle(scale_tile_index);
+        if(scale_tile_handle.mpi_get_rank() != dst_tile_rank)
+        {
+            throw std::runtime_error("Tiles of dst and scale are placed on "
+                    "different nodes");
+        }
+        // Transfer data
+        src_tile_handle.mpi_transfer(dst_tile_rank, mpi_rank);
+        // Execute on destination node
+        if(mpi_rank == dst_tile_rank)
+        {
+            Index n = scale.get_tile_traits(scale_tile_index).nelems;
+            starpu::quantize::submit<T>(m, n, src_tile_handle,
+                    dst_tile_handle, scale_tile_handle);
+        }
+        // Flush cache for the output tiles on every node
+        dst_tile_handle.mpi_flush();
+        scale_tile_handle.mpi_flush();
+    }
+}
+
+//! Blocking version of tensor-wise int8 quantization
+/*! Every fiber along the first axis is quantized with its own scale.
+ *
+ * @param[in] src: Input tensor
+ * @param[out] dst: Quantized values
+ * @param[out] scale: Scales of fibers
+ * */
+template<typename T>
+void quantize(const Tensor<T> &src, const Tensor<int8_t> &dst,
+        const Tensor<T> &scale)
+{
+    quantize_async<T>(src, dst, scale);
+    starpu_task_wait_for_all();
+    starpu_mpi_wait_for_all(MPI_COMM_WORLD);
+}
+
+// Explicit instantiation
+template
+void quantize_async(const Tensor<fp32_t> &src, const Tensor<int8_t> &dst,
+        const Tensor<fp32_t> &scale);
+
+template
+void quantize_async(const Tensor<fp32_fast_tf32_t> &src,
+        const Tensor<int8_t> &dst, const Tensor<fp32_fast_tf32_t> &scale);
+
+template
+void quantize_async(const Tensor<fp32_fast_fp16_t> &src,
+        const Tensor<int8_t> &dst, const Tensor<fp32_fast_fp16_t> &scale);
+
+template
+void quantize_async(const Tensor<fp32_fast_bf16_t> &src,
+        const Tensor<int8_t> &dst, const Tensor<fp32_fast_bf16_t> &scale);
+
+template
+void quantize_async(const Tensor<fp64_t> &src, const Tensor<int8_t> &dst,
+        const Tensor<fp64_t> &scale);
+
+template
+void quantize_async(const Tensor<bf16_t> &src, const Tensor<int8_t> &dst,
+        const Tensor<bf16_t> &scale);
+
+// Explicit instantiation
+template
+void quantize(const Tensor<fp32_t> &src, const Tensor<int8_t> &dst,
+        const Tensor<fp32_t> &scale);
+
+template
+void quantize(const Tensor<fp32_fast_tf32_t> &src, const Tensor<int8_t> &dst,
+        const Tensor<fp32_fast_tf32_t> &scale);
+
+template
+void quantize(const Tensor<fp32_fast_fp16_t> &src, const Tensor<int8_t> &dst,
+        const Tensor<fp32_fast_fp16_t> &scale);
+
+template
+void quantize(const Tensor<fp32_fast_bf16_t> &src, const Tensor<int8_t> &dst,
+        const Tensor<fp32_fast_bf16_t> &scale);
+
+template
+void quantize(const Tensor<fp64_t> &src, const Tensor<int8_t> &dst,
+        const Tensor<fp64_t> &scale);
+
+template
+void quantize(const Tensor<bf16_t> &src, const Tensor<int8_t> &dst,
+        const Tensor<bf16_t> &scale);
+
+} // namespace nntile::tensor
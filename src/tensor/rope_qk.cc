@@ -0,0 +1,315 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/tensor/rope_qk.cc
+ * Fused in-place rotary positional embedding of queries and keys
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/rope_qk.hh"
+#include "nntile/starpu/rope_qk.hh"
+#include <algorithm>
+
+namespace nntile::tensor
+{
+
+//! Submit in-place rotation of q and k by angles from sin and cos tables
+template<typename T>
+static void rope_qk_submit(Index offset, const Tensor<T> &sin,
+        const Tensor<T> &cos, const Tensor<T> &q, const Tensor<T> &k,
+        bool inverse)
+{
+    // Check dimensions
+    if(sin.ndim != 3)
+    {
+        throw std::runtime_error("sin.ndim != 3");
+    }
+    if(q.ndim < 3)
+    {
+        throw std::runtime_error("q.ndim < 3");
+    }
+    if(k.ndim < 3)
+    {
+        throw std::runtime_error("k.ndim < 3");
+    }
+    // Check shapes of tables
+    if(sin.shape != cos.shape)
+    {
+        throw std::runtime_error("sin.shape != cos.shape");
+    }
+    if(sin.basetile_shape != cos.basetile_shape)
+    {
+        throw std::runtime_error("sin.basetile_shape != cos.basetile_shape");
+    }
+    // 0-th dimension is the head_size, which is halved for sin and cos
+    if(q.shape[0] != 2*sin.shape[0])
+    {
+        throw std::runtime_error("q.shape[0] != 2*sin.shape[0]");
+    }
+    if(q.basetile_shape[0] != 2*sin.basetile_shape[0])
+    {
+        throw std::runtime_error("q.basetile_shape[0] != "
+                "2*sin.basetile_shape[0]");
+    }
+    // Queries and keys share head, sequence and batch dimensions
+    for(Index i = 0; i < 3; ++i)
+    {
+        if(q.shape[i] != k.shape[i])
+        {
+            throw std::runtime_error("q.shape[i] != k.shape[i]");
+        }
+        if(q.basetile_shape[i] != k.basetile_shape[i])
+        {
+            throw std::runtime_error("q.basetile_shape[i] != "
+                    "k.basetile_shape[i]");
+        }
+    }
+    // Tiles of queries are paired with tiles of keys over trailing dimensions
+    if(q.grid.matrix_shape[3][1] != k.grid.matrix_shape[3][1])
+    {
+        throw std::runtime_error("q.grid.matrix_shape[3][1] != "
+                "k.grid.matrix_shape[3][1]");
+    }
+    // Positions of q and k are [offset, offset+q.shape[1]) in tables
+    if(offset < 0)
+    {
+        throw std::runtime_error("offset < 0");
+    }
+    if(offset+q.shape[1] > sin.shape[1])
+    {
+        throw std::runtime_error("offset+q.shape[1] > sin.shape[1]");
+    }
+    if(q.shape[2] > sin.shape[2])
+    {
+        throw std::runtime_error("q.shape[2] > sin.shape[2]");
+    }
+    // Apply per-tile rope asynchronously
+    int mpi_rank = starpu_mpi_world_rank();
+    for(Index i = 0; i < q.grid.nelems; ++i)
+    {
+        // Leading grids of q and k coincide and the number of trailing tiles
+        // is the same, so the paired key tile has the same linear index
+        auto q_tile_index = q.grid.linear_to_index(i);
+        auto q_tile_handle = q.get_tile_handle(i);
+        auto k_tile_handle = k.get_tile_handle(i);
+        int tile_rank = q_tile_handle.mpi_get_rank();
+        if(k_tile_handle.mpi_get_rank() != tile_rank)
+        {
+            throw std::runtime_error("Tiles of q and k are on different "
+                    "nodes");
+        }
+        auto q_tile_traits = q.get_tile_traits(i);
+        auto k_tile_traits = k.get_tile_traits(i);
+        Index m = q_tile_traits.shape[0] / 2;
+        Index ld_seq = q_tile_traits.shape[1];
+        Index ld_batch = q_tile_traits.shape[2];
+        Index nq = q_tile_traits.matrix_shape[3][1];
+        Index nk = k_tile_traits.matrix_shape[3][1];
+        // Range of positions and batches of the tile in tables
+        Index seq_begin = offset + q_tile_index[1]*q.basetile_shape[1];
+        Index seq_end = seq_begin + ld_seq;
+        Index batch_begin = q_tile_index[2] * q.basetile_shape[2];
+        Index batch_end = batch_begin + ld_batch;
+        // Loop over tiles of tables, that intersect the tile
+        std::vector<Index> sin_tile_index{q_tile_index[0], 0, 0};
+        for(Index tb = batch_begin/sin.basetile_shape[2];
+                tb*sin.basetile_shape[2] < batch_end; ++tb)
+        {
+            sin_tile_index[2] = tb;
+            for(Index ts = seq_begin/sin.basetile_shape[1];
+                    ts*sin.basetile_shape[1] < seq_end; ++ts)
+            {
+                sin_tile_index[1] = ts;
+                Index sin_tile_offset = sin.grid.index_to_linear(
+                        sin_tile_index);
+                auto sin_tile_handle = sin.get_tile_handle(sin_tile_offset);
+                auto cos_tile_handle = cos.get_tile_handle(sin_tile_offset);
+                auto sin_tile_traits = sin.get_tile_traits(sin_tile_offset);
+                // Intersection of the tile and the table tile
+                Index sin_seq_begin = ts * sin.basetile_shape[1];
+                Index sin_batch_begin = tb * sin.basetile_shape[2];
+                Index s0 = std::max(seq_begin, sin_seq_begin);
+                Index s1 = std::min(seq_end,
+                        sin_seq_begin+sin_tile_traits.shape[1]);
+                Index b0 = std::max(batch_begin, sin_batch_begin);
+                Index b1 = std::min(batch_end,
+                        sin_batch_begin+sin_tile_traits.shape[2]);
+                // Transfer data
+                sin_tile_handle.mpi_transfer(tile_rank, mpi_rank);
+                cos_tile_handle.mpi_transfer(tile_rank, mpi_rank);
+                // Execute only on destination node
+                if(mpi_rank == tile_rank)
+                {
+                    Index q_offset = 2 * m * ((s0-seq_begin)
+                            + ld_seq*(b0-batch_begin));
+                    Index sin_offset = m * ((s0-sin_seq_begin)
+                            + sin_tile_traits.shape[1]*(b0-sin_batch_begin));
+                    starpu::rope_qk::submit<T>(m, s1-s0, b1-b0, nq, nk,
+                            ld_seq, ld_batch, sin_tile_traits.shape[1],
+                            q_offset, sin_offset, inverse, sin_tile_handle,
+                            cos_tile_handle, q_tile_handle, k_tile_handle);
+                }
+            }
+        }
+        // Flush cache for the output tiles on every node
+        q_tile_handle.mpi_flush();
+        k_tile_handle.mpi_flush();
+    }
+}
+
+template<typename T>
+void rope_qk_async(Index offset, const Tensor<T> &sin, const Tensor<T> &cos,
+        const Tensor<T> &q, const Tensor<T> &k)
+//! Tensor<T> in-place Rotary Positional Embedding of queries and keys
+/*! Both q and k are rotated by a single pass over their tiles. The first
+ * three dimensions of q and k are head_size, sequence and batch, while the
+ * trailing dimensions (heads) may differ. Position s of q and k corresponds
+ * to position offset+s of sin and cos tables, that are read in place. This
+ * way decoding with a KV-cache does not need to copy parts of the tables.
+ *
+ * @param[in] offset: Position of the first element of q and k in tables
+ * @param[in] sin: Input sine table of shape (head_size/2, max_seq, batch)
+ * @param[in] cos: Input cosine table of the same shape as sin
+ * @param[inout] q: Queries to be rotated in-place
+ * @param[inout] k: Keys to be rotated in-place
+ * */
+{
+    rope_qk_submit<T>(offset, sin, cos, q, k, false);
+}
+
+template<typename T>
+void rope_qk(Index offset, const Tensor<T> &sin, const Tensor<T> &cos,
+        const Tensor<T> &q, const Tensor<T> &k)
+//! Blocking version of rope_qk_async<T>
+{
+    rope_qk_async<T>(offset, sin, cos, q, k);
+    starpu_task_wait_for_all();
+    starpu_mpi_wait_for_all(MPI_COMM_WORLD);
+}
+
+template<typename T>
+void rope_qk_backward_async(Index offset, const Tensor<T> &sin,
+        const Tensor<T> &cos, const Tensor<T> &dq, const Tensor<T> &dk)
+//! Tensor<T> in-place backward of rope_qk_async<T>
+/*! Gradients dq and dk are rotated by negated angles, which is the transposed
+ * rotation.
+ *
+ * @param[in] offset: Position of the first element of dq and dk in tables
+ * @param[in] sin: Input sine table of shape (head_size/2, max_seq, batch)
+ * @param[in] cos: Input cosine table of the same shape as sin
+ * @param[inout] dq: Gradient of queries to be rotated in-place
+ * @param[inout] dk: Gradient of keys to be rotated in-place
+ * */
+{
+    rope_qk_submit<T>(offset, sin, cos, dq, dk, true);
+}
+
+template<typename T>
+void rope_qk_backward(Index offset, const Tensor<T> &sin,
+        const Tensor<T> &cos, const Tensor<T> &dq, const Tensor<T> &dk)
+//! Blocking version of rope_qk_backward_async<T>
+{
+    rope_qk_backward_async<T>(offset, sin, cos, dq, dk);
+    starpu_task_wait_for_all();
+    starpu_mpi_wait_for_all(MPI_COMM_WORLD);
+}
+
+// Explicit instantiation of template
+template
+void rope_qk_async<fp32_t>(Index offset, const Tensor<fp32_t> &sin,
+        const Tensor<fp32_t> &cos, const Tensor<fp32_t> &q,
+        const Tensor<fp32_t> &k);
+
+template
+void rope_qk_async<fp64_t>(Index offset, const Tensor<fp64_t> &sin,
+        const Tensor<fp64_t> &cos, const Tensor<fp64_t> &q,
+        const Tensor<fp64_t> &k);
+
+template
+void rope_qk_async<fp32_fast_tf32_t>(Index offset,
+        const Tensor<fp32_fast_tf32_t> &sin,
+        const Tensor<fp32_fast_tf32_t> &cos,
+        const Tensor<fp32_fast_tf32_t> &q,
+        const Tensor<fp32_fast_tf32_t> &k);
+
+template
+void rope_qk_async<bf16_t>(Index offset, const Tensor<bf16_t> &sin,
+        const Tensor<bf16_t> &cos, const Tensor<bf16_t> &q,
+        const Tensor<bf16_t> &k);
+
+// Explicit instantiation of template
+template
+void rope_qk<fp32_t>(Index offset, const Tensor<fp32_t> &sin,
+        const Tensor<fp32_t> &cos, const Tensor<fp32_t> &q,
+        const Tensor<fp32_t> &k);
+
+template
+void rope_qk<fp64_t>(Index offset, const Tensor<fp64_t> &sin,
+        const Tensor<fp64_t> &cos, const Tensor<fp64_t> &q,
+        const Tensor<fp64_t> &k);
+
+template
+void rope_qk<fp32_fast_tf32_t>(Index offset,
+        const Tensor<fp32_fast_tf32_t> &sin,
+        const Tensor<fp32_fast_tf32_t> &cos,
+        const Tensor<fp32_fast_tf32_t> &q,
+        const Tensor<fp32_fast_tf32_t> &k);
+
+template
+void rope_qk<bf16_t>(Index offset, const Tensor<bf16_t> &sin,
+        const Tensor<bf16_t> &cos, const Tensor<bf16_t> &q,
+        const Tensor<bf16_t> &k);
+
+// Explicit instantiation of template
+template
+void rope_qk_backward_async<fp32_t>(Index offset, const Tensor<fp32_t> &sin,
+        const Tensor<fp32_t> &cos, const Tensor<fp32_t> &dq,
+        const Tensor<fp32_t> &dk);
+
+template
+void rope_qk_backward_async<fp64_t>(Index offset, const Tensor<fp64_t> &sin,
+        const Tensor<fp64_t> &cos, const Tensor<fp64_t> &dq,
+        const Tensor<fp64_t> &dk);
+
+template
+void rope_qk_backward_async<fp32_fast_tf32_t>(Index offset,
+        const Tensor<fp32_fast_tf32_t> &sin,
+        const Tensor<fp32_fast_tf32_t> &cos,
+        const Tensor<fp32_fast_tf32_t> &dq,
+        const Tensor<fp32_fast_tf32_t> &dk);
+
+template
+void rope_qk_backward_async<bf16_t>(Index offset, const Tensor<bf16_t> &sin,
+        const Tensor<bf16_t> &cos, const Tensor<bf16_t> &dq,
+        const Tensor<bf16_t> &dk);
+
+// Explicit instantiation of template
+template
+void rope_qk_backward<fp32_t>(Index offset, const Tensor<fp32_t> &sin,
+        const Tensor<fp32_t> &cos, const Tensor<fp32_t> &dq,
+        const Tensor<fp32_t> &dk);
+
+template
+void rope_qk_backward<fp64_t>(Index offset, const Tensor<fp64_t> &sin,
+        const Tensor<fp64_t> &cos, const Tensor<fp64_t> &dq,
+        const Tensor<fp64_t> &dk);
+
+template
+void rope_qk_backward<fp32_fast_tf32_t>(Index offset,
+        const Tensor<fp32_fast_tf32_t> &sin,
+        const Tensor<fp32_fast_tf32_t> &cos,
+        const Tensor<fp32_fast_tf32_t> &dq,
+        const Tensor<fp32_fast_tf32_t> &dk);
+
+template
+void rope_qk_backward<bf16_t>(Index offset, const Tensor<bf16_t> &sin,
+        const Tensor<bf16_t> &cos, const Tensor<bf16_t> &dq,
+        const Tensor<bf16_t> &dk);
+
+} // namespace nntile::tensor
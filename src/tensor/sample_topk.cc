@@ -0,0 +1,190 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/tensor/sample_topk.cc
+ * Sampling of tokens from top-k candidates of Tensor<T>
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/sample_topk.hh"
+#include "nntile/starpu/sample_topk.hh"
+
+namespace nntile::tensor
+{
+
+//! Asynchronous tensor-wise sampling from top-k candidates
+/*! Sample a single index out of candidates along the first axis of val and
+ * idx, as they are produced by topk operation. Only the sampled indices are
+ * written into dst, so that reading sampled tokens does not require to
+ * transfer logits. See kernel::sample_topk for details.
+ *
+ * @param[in] temperature: Temperature of sampling. If it is not positive, the
+ *      largest candidate is taken (greedy decoding)
+ * @param[in] top_p: Threshold of the cumulative probability. Value of 1 means
+ *      all the candidates are sampled from.
+ * @param[in] seed: Random seed. Every tile of dst gets its own random stream.
+ * @param[in] val: Values of candidates of shape [k, ...], where the first
+ *      axis is not split into tiles
+ * @param[in] idx: Indices of candidates of the same shape and tiling as val
+ * @param[out] dst: Sampled indices of shape val.shape[1:]
+ * */
+template<typename T>
+void sample_topk_async(Scalar temperature, Scalar top_p,
+        unsigned long long seed, const Tensor<T> &val,
+        const Tensor<int64_t> &idx, const Tensor<int64_t> &dst)
+{
+    // Check dimensions
+    if(val.ndim == 0)
+    {
+        throw std::runtime_error("Scalar input makes no sense");
+    }
+    if(val.ndim != dst.ndim+1)
+    {
+        throw std::runtime_error("val.ndim != dst.ndim+1");
+    }
+    // Check shapes
+    if(val.shape != idx.shape)
+    {
+        throw std::runtime_error("val.shape != idx.shape");
+    }
+    if(val.basetile_shape != idx.basetile_shape)
+    {
+        throw std::runtime_error("val.basetile_shape != idx.basetile_shape");
+    }
+    Index k = val.shape[0];
+    if(val.basetile_shape[0] != k)
+    {
+        throw std::runtime_error("val.basetile_shape[0] != val.shape[0]");
+    }
+    for(Index i = 0; i < dst.ndim; ++i)
+    {
+        if(val.shape[i+1] != dst.shape[i])
+        {
+            throw std::runtime_error("val.shape[i+1] != dst.shape[i]");
+        }
+        if(val.basetile_shape[i+1] != dst.basetile_shape[i])
+        {
+            throw std::runtime_error("val.basetile_shape[i+1] != "
+                    "dst.basetile_shape[i]");
+        }
+    }
+    // Do actual calculations
+    int mpi_rank = starpu_mpi_world_rank();
+    for(Index i = 0; i < dst.grid.nelems; ++i)
+    {
+        auto dst_tile_handle = dst.get_tile_handle(i);
+        int dst_tile_rank = dst_tile_handle.mpi_get_rank();
+        auto dst_tile_index = dst.grid.linear_to_index(i);
+        std::vector<Index> val_tile_index(val.ndim);
+        val_tile_index[0] = 0;
+        for(Index j = 0; j < dst.ndim; ++j)
+        {
+            val_tile_index[j+1] = dst_tile_index[j];
+        }
+        auto val_tile_handle = val.get_tile_handle(val_tile_index);
+        auto idx_tile_handle = idx.get_tile_handle(val_tile_index);
+        // Transfer data
+        val_tile_handle.mpi_transfer(dst_tile_rank, mpi_rank);
+        idx_tile_handle.mpi_transfer(dst_tile_rank, mpi_rank);
+        // Execute on destination node
+        if(mpi_rank == dst_tile_rank)
+        {
+            Index n = dst.get_tile_traits(i).nelems;
+            starpu::sample_topk::submit<T>(k, n, temperature, top_p, seed+i,
+                    val_tile_handle, idx_tile_handle, dst_tile_handle);
+        }
+        // Flush cache for the output tile on every node
+        dst_tile_handle.mpi_flush();
+    }
+}
+
+//! Blocking version of tensor-wise sampling from top-k candidates
+/*! Sample a single index out of candidates along the first axis of val and
+ * idx.
+ *
+ * @param[in] temperature: Temperature of sampling
+ * @param[in] top_p: Threshold of the cumulative probability
+ * @param[in] seed: Random seed
+ * @param[in] val: Values of candidates
+ * @param[in] idx: Indices of candidates
+ * @param[out] dst: Sampled indices
+ * */
+template<typename T>
+void sample_topk(Scalar temperature, Scalar top_p, unsigned long long seed,
+        const Tensor<T> &val, const Tensor<int64_t> &idx,
+        const Tensor<int64_t> &dst)
+{
+    sample_topk_async<T>(temperature, top_p, seed, val, idx, dst);
+    starpu_task_wait_for_all();
+    starpu_mpi_wait_for_all(MPI_COMM_WORLD);
+}
+
+// Explicit instantiation
+template
+void sample_topk_async<fp32_t>(Scalar temperature, Scalar top_p,
+        unsigned long long seed, const Tensor<fp32_t> &val,
+        const Tensor<int64_t> &idx, const Tensor<int64_t> &dst);
+
+template
+void sample_topk_async<fp32_fast_tf32_t>(Scalar temperature, Scalar top_p,
+        unsigned long long seed, const Tensor<fp32_fast_tf32_t> &val,
+        const Tensor<int64_t> &idx, const Tensor<int64_t> &dst);
+
+template
+void sample_topk_async<fp32_fast_fp16_t>(Scalar temperature, Scalar top_p,
+        unsigned long long seed, const Tensor<fp32_fast_fp16_t> &val,
+        const Tensor<int64_t> &idx, const Tensor<int64_t> &dst);
+
+template
+void sample_topk_async<fp32_fast_bf16_t>(Scalar temperature, Scalar top_p,
+        unsigned long long seed, const Tensor<fp32_fast_bf16_t> &val,
+        const Tensor<int64_t> &idx, const Tensor<int64_t> &dst);
+
+template
+void sample_topk_async<fp64_t>(Scalar temperature, Scalar top_p,
+        unsigned long long seed, const Tensor<fp64_t> &val,
+        const Tensor<int64_t> &idx, const Tensor<int64_t> &dst);
+
+template
+void sample_topk_async<bf16_t>(Scalar temperature, Scalar top_p,
+        unsigned long long seed, const Tensor<bf16_t> &val,
+        const Tensor<int64_t> &idx, const Tensor<int64_t> &dst);
+
+// Explicit instantiation
+template
+void sample_topk<fp32_t>(Scalar temperature, Scalar top_p,
+        unsigned long long seed, const Tensor<fp32_t> &val,
+        const Tensor<int64_t> &idx, const Tensor<int64_t> &dst);
+
+template
+void sample_topk<fp32_fast_tf32_t>(Scalar temperature, Scalar top_p,
+        unsigned long long seed, const Tensor<fp32_fast_tf32_t> &val,
+        const Tensor<int64_t> &idx, const Tensor<int64_t> &dst);
+
+template
+void sample_topk<fp32_fast_fp16_t>(Scalar temperature, Scalar top_p,
+        unsigned long long seed, const Tensor<fp32_fast_fp16_t> &val,
+        const Tensor<int64_t> &idx, const Tensor<int64_t> &dst);
+
+template
+void sample_topk<fp32_fast_bf16_t>(Scalar temperature, Scalar top_p,
+        unsigned long long seed, const Tensor<fp32_fast_bf16_t> &val,
+        const Tensor<int64_t> &idx, const Tensor<int64_t> &dst);
+
+template
+void sample_topk<fp64_t>(Scalar temperature, Scalar top_p,
+        unsigned long long seed, const Tensor<fp64_t> &val,
+        const Tensor<int64_t> &idx, const Tensor<int64_t> &dst);
+
+template
+void sample_topk<bf16_t>(Scalar temperature, Scalar top_p,
+        unsigned long long seed, const Tensor<bf16_t> &val,
+        const Tensor<int64_t> &idx, const Tensor<int64_t> &dst);
+
+} // namespace nntile::tensor
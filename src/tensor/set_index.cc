@@ -0,0 +1,183 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/tensor/set_index.cc
+ * Copy a single index along an axis from one Tensor<T> into another
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/set_index.hh"
+#include "nntile/starpu/subcopy.hh"
+
+namespace nntile::tensor
+{
+
+//! Asynchronous tensor-wise copy of a single index along an axis
+/*! Slice of src at index src_index along the given axis is copied into the
+ * slice of dst at index dst_index along the same axis, while all other
+ * elements of dst are kept intact. It allows to append tokens, that are
+ * sampled on device, to a preallocated output sequence and to put them into
+ * the input of the next step without reading them back.
+ *
+ * @param[in] src: Source tensor
+ * @param[in] src_index: Index of the slice of src along the axis
+ * @param[inout] dst: Destination tensor
+ * @param[in] dst_index: Index of the slice of dst along the axis
+ * @param[in] axis: Axis of the slices. Shapes and tilings of src and dst must
+ *      be the same for all other axes.
+ * */
+template<typename T>
+void set_index_async(const Tensor<T> &src, Index src_index,
+        const Tensor<T> &dst, Index dst_index, Index axis)
+{
+    // Check dimensions
+    if(src.ndim != dst.ndim)
+    {
+        throw std::runtime_error("src.ndim != dst.ndim");
+    }
+    // Check axis
+    if(axis < 0)
+    {
+        throw std::runtime_error("axis < 0");
+    }
+    if(axis >= src.ndim)
+    {
+        throw std::runtime_error("axis >= src.ndim");
+    }
+    // Check indices
+    if(src_index < 0 or src_index >= src.shape[axis])
+    {
+        throw std::runtime_error("src_index is out of bounds");
+    }
+    if(dst_index < 0 or dst_index >= dst.shape[axis])
+    {
+        throw std::runtime_error("dst_index is out of bounds");
+    }
+    // Check shapes
+    for(Index i = 0; i < src.ndim; ++i)
+    {
+        if(i == axis)
+        {
+            continue;
+        }
+        if(src.shape[i] != dst.shape[i])
+        {
+            throw std::runtime_error("src.shape[i] != dst.shape[i]");
+        }
+        if(src.basetile_shape[i] != dst.basetile_shape[i])
+        {
+            throw std::runtime_error("src.basetile_shape[i] != "
+                    "dst.basetile_shape[i]");
+        }
+    }
+    // Temporary buffer for indexing, that is allocated per-worker when needed
+    starpu::VariableHandle scratch(2*src.ndim*sizeof(Index), STARPU_SCRATCH);
+    int mpi_rank = starpu_mpi_world_rank();
+    Index ndim = src.ndim;
+    // Positions of slices within tiles
+    Index src_tile_axis = src_index / src.basetile_shape[axis];
+    Index dst_tile_axis = dst_index / dst.basetile_shape[axis];
+    std::vector<Index> src_tile_start(ndim, 0), dst_tile_start(ndim, 0);
+    src_tile_start[axis] = src_index - src_tile_axis*src.basetile_shape[axis];
+    dst_tile_start[axis] = dst_index - dst_tile_axis*dst.basetile_shape[axis];
+    // Cycle through destination tiles, that contain the slice
+    for(Index i = 0; i < dst.grid.nelems; ++i)
+    {
+        auto dst_tile_index = dst.grid.linear_to_index(i);
+        if(dst_tile_index[axis] != dst_tile_axis)
+        {
+            continue;
+        }
+        auto dst_tile_handle = dst.get_tile_handle(i);
+        auto dst_tile_traits = dst.get_tile_traits(i);
+        int dst_tile_rank = dst_tile_handle.mpi_get_rank();
+        // Corresponding source tile
+        auto src_tile_index(dst_tile_index);
+        src_tile_index[axis] = src_tile_axis;
+        Index src_tile_offset = src.grid.index_to_linear(src_tile_index);
+        auto src_tile_handle = src.get_tile_handle(src_tile_offset);
+        auto src_tile_traits = src.get_tile_traits(src_tile_offset);
+        // Transfer source tile to dest node
+        src_tile_handle.mpi_transfer(dst_tile_rank, mpi_rank);
+        // Execute on destination node
+        if(mpi_rank == dst_tile_rank)
+        {
+            std::vector<Index> copy_shape(dst_tile_traits.shape);
+            copy_shape[axis] = 1;
+            // Entire destination tile is overwritten only if it is a single
+            // slice
+            enum starpu_data_access_mode dst_tile_mode = STARPU_RW;
+            if(dst_tile_traits.shape[axis] == 1)
+            {
+                dst_tile_mode = STARPU_W;
+            }
+            starpu::subcopy::submit<T>(ndim, src_tile_start,
+                    src_tile_traits.stride, dst_tile_start,
+                    dst_tile_traits.stride, copy_shape, src_tile_handle,
+                    dst_tile_handle, scratch, dst_tile_mode);
+        }
+        // Flush cache for the output tile on every node
+        dst_tile_handle.mpi_flush();
+    }
+}
+
+//! Blocking version of tensor-wise copy of a single index along an axis
+/*! Slice of src at index src_index along the given axis is copied into the
+ * slice of dst at index dst_index along the same axis.
+ *
+ * @param[in] src: Source tensor
+ * @param[in] src_index: Index of the slice of src along the axis
+ * @param[inout] dst: Destination tensor
+ * @param[in] dst_index: Index of the slice of dst along the axis
+ * @param[in] axis: Axis of the slices
+ * */
+template<typename T>
+void set_index(const Tensor<T> &src, Index src_index, const Tensor<T> &dst,
+        Index dst_index, Index axis)
+{
+    set_index_async<T>(src, src_index, dst, dst_index, axis);
+    starpu_task_wait_for_all();
+    starpu_mpi_wait_for_all(MPI_COMM_WORLD);
+}
+
+// Explicit instantiation
+template
+void set_index_async<bool_t>(const Tensor<bool_t> &src, Index src_index,
+        const Tensor<bool_t> &dst, Index dst_index, Index axis);
+
+template
+void set_index_async<fp32_t>(const Tensor<fp32_t> &src, Index src_index,
+        const Tensor<fp32_t> &dst, Index dst_index, Index axis);
+
+template
+void set_index_async<fp64_t>(const Tensor<fp64_t> &src, Index src_index,
+        const Tensor<fp64_t> &dst, Index dst_index, Index axis);
+
+template
+void set_index_async<int64_t>(const Tensor<int64_t> &src, Index src_index,
+        const Tensor<int64_t> &dst, Index dst_index, Index axis);
+
+// Explicit instantiation
+template
+void set_index<bool_t>(const Tensor<bool_t> &src, Index src_index,
+        const Tensor<bool_t> &dst, Index dst_index, Index axis);
+
+template
+void set_index<fp32_t>(const Tensor<fp32_t> &src, Index src_index,
+        const Tensor<fp32_t> &dst, Index dst_index, Index axis);
+
+template
+void set_index<fp64_t>(const Tensor<fp64_t> &src, Index src_index,
+        const Tensor<fp64_t> &dst, Index dst_index, Index axis);
+
+template
+void set_index<int64_t>(const Tensor<int64_t> &src, Index src_index,
+        const Tensor<int64_t> &dst, Index dst_index, Index axis);
+
+} // namespace nntile::tensor
@@ -0,0 +1,199 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file src/tensor/topk.cc
+ * Top-k largest elements along the first axis of Tensor<T>
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/topk.hh"
+#include "nntile/starpu/topk.hh"
+
+namespace nntile::tensor
+{
+
+//! Asynchronous tensor-wise top-k operation
+/*! Find k largest elements of src along its first axis (e.g., logits along
+ * vocabulary) together with their indices. Tiles of src along the first axis
+ * are reduced one after another into a single tile of output along the first
+ * axis, so the output is exact for any tiling of src.
+ *
+ * @param[in] src: Input tensor of shape [m, ...]
+ * @param[out] dst_val: Largest values in descending order. Shape of tensor is
+ *      [k, ...], where k <= m and the first axis is not split into tiles.
+ * @param[out] dst_idx: Indices of the largest values along the first axis of
+ *      src. It has the same shape and tiling as dst_val and its tiles must be
+ *      owned by the same nodes as tiles of dst_val.
+ * */
+template<typename T>
+void topk_async(const Tensor<T> &src, const Tensor<T> &dst_val,
+        const Tensor<int64_t> &dst_idx)
+{
+    // Check dimensions
+    if(src.ndim == 0)
+    {
+        throw std::runtime_error("Scalar input makes no sense");
+    }
+    if(src.ndim != dst_val.ndim)
+    {
+        throw std::runtime_error("src.ndim != dst_val.ndim");
+    }
+    if(dst_val.ndim != dst_idx.ndim)
+    {
+        throw std::runtime_error("dst_val.ndim != dst_idx.ndim");
+    }
+    // Check shapes
+    Index k = dst_val.shape[0];
+    if(k <= 0)
+    {
+        throw std::runtime_error("dst_val.shape[0] <= 0");
+    }
+    if(k > src.shape[0])
+    {
+        throw std::runtime_error("dst_val.shape[0] > src.shape[0]");
+    }
+    if(dst_val.basetile_shape[0] != k)
+    {
+        throw std::runtime_error("dst_val.basetile_shape[0] != "
+                "dst_val.shape[0]");
+    }
+    for(Index i = 1; i < src.ndim; ++i)
+    {
+        if(src.shape[i] != dst_val.shape[i])
+        {
+            throw std::runtime_error("src.shape[i] != dst_val.shape[i]");
+        }
+        if(src.basetile_shape[i] != dst_val.basetile_shape[i])
+        {
+            throw std::runtime_error("src.basetile_shape[i] != "
+                    "dst_val.basetile_shape[i]");
+        }
+    }
+    if(dst_val.shape != dst_idx.shape)
+    {
+        throw std::runtime_error("dst_val.shape != dst_idx.shape");
+    }
+    if(dst_val.basetile_shape != dst_idx.basetile_shape)
+    {
+        throw std::runtime_error("dst_val.basetile_shape != "
+                "dst_idx.basetile_shape");
+    }
+    // Do actual calculations
+    int mpi_rank = starpu_mpi_world_rank();
+    for(Index i = 0; i < dst_val.grid.nelems; ++i)
+    {
+        auto dst_val_tile_handle = dst_val.get_tile_handle(i);
+        auto dst_idx_tile_handle = dst_idx.get_tile_handle(i);
+        int dst_tile_rank = dst_val_tile_handle.mpi_get_rank();
+        if(dst_idx_tile_handle.mpi_get_rank() != dst_tile_rank)
+        {
+            throw std::runtime_error("Tiles of dst_val and dst_idx are "
+                    "owned by different nodes");
+        }
+        auto src_tile_index = dst_val.grid.linear_to_index(i);
+        // Reduce over tiles of src along the first axis
+        for(Index j = 0; j < src.grid.shape[0]; ++j)
+        {
+            src_tile_index[0] = j;
+            Index src_tile_offset = src.grid.index_to_linear(src_tile_index);
+            auto src_tile_handle = src.get_tile_handle(src_tile_offset);
+            // Transfer data
+            src_tile_handle.mpi_transfer(dst_tile_rank, mpi_rank);
+            // Execute on destination node
+            if(mpi_rank == dst_tile_rank)
+            {
+                auto src_tile_traits = src.get_tile_traits(src_tile_offset);
+                Index m = src_tile_traits.shape[0];
+                Index n = src_tile_traits.matrix_shape[1][1];
+                Index offset = j * src.basetile_shape[0];
+                starpu::topk::submit<T>(m, n, k, offset, j == 0,
+                        src_tile_handle, dst_val_tile_handle,
+                        dst_idx_tile_handle);
+            }
+        }
+        // Flush cache for the output tiles on every node
+        dst_val_tile_handle.mpi_flush();
+        dst_idx_tile_handle.mpi_flush();
+    }
+}
+
+//! Blocking version of tensor-wise top-k operation
+/*! Find k largest elements of src along its first axis (e.g., logits along
+ * vocabulary) together with their indices.
+ *
+ * @param[in] src: Input tensor of shape [m, ...]
+ * @param[out] dst_val: Largest values in descending order
+ * @param[out] dst_idx: Indices of the largest values
+ * */
+template<typename T>
+void topk(const Tensor<T> &src, const Tensor<T> &dst_val,
+        const Tensor<int64_t> &dst_idx)
+{
+    topk_async<T>(src, dst_val, dst_idx);
+    starpu_task_wait_for_all();
+    starpu_mpi_wait_for_all(MPI_COMM_WORLD);
+}
+
+// Explicit instantiation
+template
+void topk_async<fp32_t>(const Tensor<fp32_t> &src,
+        const Tensor<fp32_t> &dst_val, const Tensor<int64_t> &dst_idx);
+
+template
+void topk_async<fp32_fast_tf32_t>(const Tensor<fp32_fast_tf32_t> &src,
+        const Tensor<fp32_fast_tf32_t> &dst_val,
+        const Tensor<int64_t> &dst_idx);
+
+template
+void topk_async<fp32_fast_fp16_t>(const Tensor<fp32_fast_fp16_t> &src,
+        const Tensor<fp32_fast_fp16_t> &dst_val,
+        const Tensor<int64_t> &dst_idx);
+
+template
+void topk_async<fp32_fast_bf16_t>(const Tensor<fp32_fast_bf16_t> &src,
+        const Tensor<fp32_fast_bf16_t> &dst_val,
+        const Tensor<int64_t> &dst_idx);
+
+template
+void topk_async<fp64_t>(const Tensor<fp64_t> &src,
+        const Tensor<fp64_t> &dst_val, const Tensor<int64_t> &dst_idx);
+
+template
+void topk_async<bf16_t>(const Tensor<bf16_t> &src,
+        const Tensor<bf16_t> &dst_val, const Tensor<int64_t> &dst_idx);
+
+// Explicit instantiation
+template
+void topk<fp32_t>(const Tensor<fp32_t> &src, const Tensor<fp32_t> &dst_val,
+        const Tensor<int64_t> &dst_idx);
+
+template
+void topk<fp32_fast_tf32_t>(const Tensor<fp32_fast_tf32_t> &src,
+        const Tensor<fp32_fast_tf32_t> &dst_val,
+        const Tensor<int64_t> &dst_idx);
+
+template
+void topk<fp32_fast_fp16_t>(const Tensor<fp32_fast_fp16_t> &src,
+        const Tensor<fp32_fast_fp16_t> &dst_val,
+        const Tensor<int64_t> &dst_idx);
+
+template
+void topk<fp32_fast_bf16_t>(const Tensor<fp32_fast_bf16_t> &src,
+        const Tensor<fp32_fast_bf16_t> &dst_val,
+        const Tensor<int64_t> &dst_idx);
+
+template
+void topk<fp64_t>(const Tensor<fp64_t> &src, const Tensor<fp64_t> &dst_val,
+        const Tensor<int64_t> &dst_idx);
+
+template
+void topk<bf16_t>(const Tensor<bf16_t> &src, const Tensor<bf16_t> &dst_val,
+        const Tensor<int64_t> &dst_idx);
+
+} // namespace nntile::tensor
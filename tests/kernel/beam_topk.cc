@@ -0,0 +1,176 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/kernel/beam_topk.cc
+ * Top-k largest elements of a matrix for beam search
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/beam_topk.hh"
+#include "../testing.hh"
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <iostream>
+
+using namespace nntile;
+using namespace nntile::kernel::beam_topk;
+
+#ifdef NNTILE_USE_CUDA
+template<typename T>
+void run_cuda(Index m, Index n, Index k, Index row_offset, Index col_offset,
+        bool init, const std::vector<T> &src, std::vector<T> &dst_val,
+        std::vector<nntile::int64_t> &dst_idx,
+        std::vector<nntile::int64_t> &dst_beam)
+{
+    // Alloc on device
+    T *dev_src, *dev_val;
+    nntile::int64_t *dev_idx, *dev_beam;
+    cudaError_t cuda_err = cudaMalloc(&dev_src, sizeof(T)*m*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_val, sizeof(T)*k);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_idx, sizeof(nntile::int64_t)*k);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_beam, sizeof(nntile::int64_t)*k);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy to device
+    cuda_err = cudaMemcpy(dev_src, &src[0], sizeof(T)*m*n,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(dev_val, &dst_val[0], sizeof(T)*k,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(dev_idx, &dst_idx[0], sizeof(nntile::int64_t)*k,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(dev_beam, &dst_beam[0], sizeof(nntile::int64_t)*k,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Init stream
+    cudaStream_t stream;
+    cuda_err = cudaStreamCreate(&stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Launch low-level kernel
+    cuda<T>(stream, m, n, k, row_offset, col_offset, init, dev_src, dev_val,
+            dev_idx, dev_beam);
+    cuda_err = cudaStreamSynchronize(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy result and deallocate device memory
+    cuda_err = cudaMemcpy(&dst_val[0], dev_val, sizeof(T)*k,
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(&dst_idx[0], dev_idx, sizeof(nntile::int64_t)*k,
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(&dst_beam[0], dev_beam, sizeof(nntile::int64_t)*k,
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_src);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_val);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_idx);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_beam);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaStreamDestroy(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+}
+#endif // NNTILE_USE_CUDA
+
+// Check result against sorting of the entire matrix
+template<typename T>
+void check(Index m, Index n, Index k, const std::vector<T> &src,
+        const std::vector<T> &dst_val,
+        const std::vector<nntile::int64_t> &dst_idx,
+        const std::vector<nntile::int64_t> &dst_beam)
+{
+    using Y = typename T::repr_t;
+    // Stable sort of elements in column-major order resolves ties in favor
+    // of the smaller column and then the smaller row
+    std::vector<Index> order(m*n);
+    for(Index e = 0; e < m*n; ++e)
+    {
+        order[e] = e;
+    }
+    std::stable_sort(order.begin(), order.end(),
+            [&](Index a, Index b)
+            {
+                return Y(src[a]) > Y(src[b]);
+            });
+    for(Index r = 0; r < k; ++r)
+    {
+        if(r < m*n)
+        {
+            TEST_ASSERT(Index(dst_idx[r]) == order[r]%m);
+            TEST_ASSERT(Index(dst_beam[r]) == order[r]/m);
+            TEST_ASSERT(Y(dst_val[r]) == Y(src[order[r]]));
+        }
+        else
+        {
+            TEST_ASSERT(Index(dst_idx[r]) == -1);
+        }
+    }
+}
+
+// Templated validation
+template<typename T>
+void validate(Index m, Index n, Index k, Index n_split)
+{
+    using Y = typename T::repr_t;
+    // Init test input with ties
+    std::vector<T> src(m*n);
+    for(Index i = 0; i < m*n; ++i)
+    {
+        src[i] = Y((i*37+11) % 23);
+    }
+    // Split columns of input into two parts, that are contiguous
+    Index n2 = n - n_split;
+    std::vector<T> src1(src.begin(), src.begin()+m*n_split),
+        src2(src.begin()+m*n_split, src.end());
+    std::vector<T> dst_val(k, T(Y(-1)));
+    std::vector<nntile::int64_t> dst_idx(k, nntile::int64_t(7)),
+        dst_beam(k, nntile::int64_t(7));
+#ifdef NNTILE_USE_CUDA
+    std::vector<T> dst_val_cuda(dst_val);
+    std::vector<nntile::int64_t> dst_idx_cuda(dst_idx),
+        dst_beam_cuda(dst_beam);
+#endif // NNTILE_USE_CUDA
+    // Check low-level kernel, the last columns go first
+    std::cout << "Run kernel::beam_topk::cpu<" << T::type_repr << ">\n";
+    cpu<T>(m, n2, k, 0, n_split, true, &src2[0], &dst_val[0], &dst_idx[0],
+            &dst_beam[0]);
+    cpu<T>(m, n_split, k, 0, 0, false, &src1[0], &dst_val[0], &dst_idx[0],
+            &dst_beam[0]);
+    check<T>(m, n, k, src, dst_val, dst_idx, dst_beam);
+    std::cout << "OK: kernel::beam_topk::cpu<" << T::type_repr << ">\n";
+#ifdef NNTILE_USE_CUDA
+    // Check low-level CUDA kernel
+    std::cout << "Run kernel::beam_topk::cuda<" << T::type_repr << ">\n";
+    run_cuda<T>(m, n2, k, 0, n_split, true, src2, dst_val_cuda, dst_idx_cuda,
+            dst_beam_cuda);
+    run_cuda<T>(m, n_split, k, 0, 0, false, src1, dst_val_cuda,
+            dst_idx_cuda, dst_beam_cuda);
+    check<T>(m, n, k, src, dst_val_cuda, dst_idx_cuda, dst_beam_cuda);
+    std::cout << "OK: kernel::beam_topk::cuda<" << T::type_repr << ">\n";
+#endif // NNTILE_USE_CUDA
+}
+
+int main(int argc, char **argv)
+{
+    validate<fp32_t>(100, 3, 1, 1);
+    validate<fp32_t>(100, 4, 4, 2);
+    validate<fp32_t>(1000, 8, 8, 5);
+    validate<fp32_t>(3, 2, 8, 1);
+    validate<fp64_t>(100, 3, 1, 1);
+    validate<fp64_t>(100, 4, 4, 2);
+    validate<fp64_t>(3, 2, 8, 1);
+    return 0;
+}
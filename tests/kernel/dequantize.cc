@@ -0,0 +1,124 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/kernel/dequantize.cc
+ * Dequantization of int8 columns
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/dequantize.hh"
+#include "../testing.hh"
+#include <vector>
+#include <stdexcept>
+#include <cmath>
+#include <iostream>
+
+using namespace nntile;
+using namespace nntile::kernel::dequantize;
+
+#ifdef NNTILE_USE_CUDA
+template<typename T>
+void run_cuda(Index m, Index n, const std::vector<nntile::int8_t> &src,
+        const std::vector<T> &scale, std::vector<T> &dst)
+{
+    // Alloc on device
+    nntile::int8_t *dev_src;
+    T *dev_scale, *dev_dst;
+    cudaError_t cuda_err = cudaMalloc(&dev_src, sizeof(nntile::int8_t)*m*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_scale, sizeof(T)*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_dst, sizeof(T)*m*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy to device
+    cuda_err = cudaMemcpy(dev_src, &src[0], sizeof(nntile::int8_t)*m*n,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(dev_scale, &scale[0], sizeof(T)*n,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Init stream
+    cudaStream_t stream;
+    cuda_err = cudaStreamCreate(&stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Launch low-level kernel
+    cuda<T>(stream, m, n, dev_src, dev_scale, dev_dst);
+    cuda_err = cudaStreamSynchronize(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy result and deallocate device memory
+    cuda_err = cudaMemcpy(&dst[0], dev_dst, sizeof(T)*m*n,
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_src);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_scale);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_dst);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaStreamDestroy(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+}
+#endif // NNTILE_USE_CUDA
+
+// Check result against explicitly evaluated values
+template<typename T>
+void check(Index m, Index n, const std::vector<nntile::int8_t> &src,
+        const std::vector<T> &scale, const std::vector<T> &dst)
+{
+    using Y = typename T::repr_t;
+    for(Index j = 0; j < n; ++j)
+    {
+        for(Index i = 0; i < m; ++i)
+        {
+            Y q = static_cast<std::int8_t>(src[j*m+i]);
+            TEST_ASSERT(Y(dst[j*m+i]) == q*Y(scale[j]));
+        }
+    }
+}
+
+// Templated validation
+template<typename T>
+void validate(Index m, Index n)
+{
+    using Y = typename T::repr_t;
+    // Init test input
+    std::vector<nntile::int8_t> src(m*n);
+    for(Index i = 0; i < m*n; ++i)
+    {
+        src[i] = static_cast<std::int8_t>(i%255 - 127);
+    }
+    std::vector<T> scale(n);
+    for(Index j = 0; j < n; ++j)
+    {
+        scale[j] = Y(0.25 * j);
+    }
+    std::vector<T> dst(m*n);
+    // Check low-level kernel
+    std::cout << "Run kernel::dequantize::cpu<" << T::type_repr << ">\n";
+    cpu<T>(m, n, &src[0], &scale[0], &dst[0]);
+    check<T>(m, n, src, scale, dst);
+    std::cout << "OK: kernel::dequantize::cpu<" << T::type_repr << ">\n";
+#ifdef NNTILE_USE_CUDA
+    // Check low-level CUDA kernel
+    std::cout << "Run kernel::dequantize::cuda<" << T::type_repr << ">\n";
+    std::vector<T> dst_cuda(m*n);
+    run_cuda<T>(m, n, src, scale, dst_cuda);
+    check<T>(m, n, src, scale, dst_cuda);
+    std::cout << "OK: kernel::dequantize::cuda<" << T::type_repr << ">\n";
+#endif // NNTILE_USE_CUDA
+}
+
+int main(int argc, char **argv)
+{
+    validate<fp32_t>(1, 3);
+    validate<fp32_t>(64, 20);
+    validate<fp64_t>(1, 3);
+    validate<fp64_t>(100, 7);
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/kernel/gemm_packed.cc
+ * Product of a packed matrix by a matrix
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/gemm_packed.hh"
+#include "nntile/kernel/pack_panels.hh"
+#include "../testing.hh"
+#include <vector>
+#include <stdexcept>
+#include <limits>
+#include <cmath>
+#include <iostream>
+
+using namespace nntile;
+using namespace nntile::kernel::gemm_packed;
+
+// Templated validation
+template<typename T>
+void validate(bool transB, Index m, Index n, Index k, Scalar beta)
+{
+    using Y = typename T::repr_t;
+    const Y eps = 10 * T::epsilon();
+    Scalar alpha = -0.5;
+    // Init test input
+    std::vector<T> A(m*k), A_packed(m*k), B(k*n), C(m*n);
+    for(Index i = 0; i < m*k; ++i)
+    {
+        A[i] = Y(1.0) / Y(i%7+1);
+    }
+    for(Index i = 0; i < k*n; ++i)
+    {
+        B[i] = Y(i%5) - Y(2);
+    }
+    for(Index i = 0; i < m*n; ++i)
+    {
+        C[i] = Y(i%3);
+    }
+    // Get reference result
+    std::vector<Y> C_ref(m*n);
+    for(Index j = 0; j < n; ++j)
+    {
+        for(Index i = 0; i < m; ++i)
+        {
+            Y sum = 0;
+            for(Index l = 0; l < k; ++l)
+            {
+                Y b = transB ? Y(B[l*n+j]) : Y(B[j*k+l]);
+                sum += Y(A[l*m+i]) * b;
+            }
+            C_ref[j*m+i] = Y(alpha)*sum + Y(beta)*Y(C[j*m+i]);
+        }
+    }
+    if(beta == 0.0)
+    {
+        // Output must not be read
+        for(Index i = 0; i < m*n; ++i)
+        {
+            C[i] = std::numeric_limits<Y>::quiet_NaN();
+        }
+    }
+    // Check low-level kernel
+    std::cout << "Run kernel::gemm_packed::cpu<" << T::type_repr << ">\n";
+    kernel::pack_panels::cpu<T>(m, k, &A[0], &A_packed[0]);
+    cpu<T>(transB, m, n, k, alpha, &A_packed[0], &B[0], beta, &C[0]);
+    for(Index i = 0; i < m*n; ++i)
+    {
+        Y diff = std::abs(Y(C[i]) - C_ref[i]);
+        TEST_ASSERT(diff <= eps*(std::abs(C_ref[i])+Y(k)));
+    }
+    std::cout << "OK: kernel::gemm_packed::cpu<" << T::type_repr << ">\n";
+}
+
+int main(int argc, char **argv)
+{
+    validate<fp32_t>(false, 1, 1, 1, 0.0);
+    validate<fp32_t>(false, 100, 3, 20, 0.0);
+    validate<fp32_t>(true, 130, 17, 9, 1.0);
+    validate<fp64_t>(false, 64, 8, 33, -1.0);
+    validate<fp64_t>(true, 70, 20, 5, 0.0);
+    return 0;
+}
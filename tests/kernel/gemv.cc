@@ -0,0 +1,147 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/kernel/gemv.cc
+ * Matrix times a few vectors
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/gemv.hh"
+#include "../testing.hh"
+#include <vector>
+#include <stdexcept>
+#include <cmath>
+#include <iostream>
+
+using namespace nntile;
+using namespace nntile::kernel::gemv;
+
+#ifdef NNTILE_USE_CUDA
+template<typename T>
+void run_cuda(bool transA, Index m, Index n, Index k, Scalar alpha,
+        const std::vector<T> &A, const std::vector<T> &B, Scalar beta,
+        std::vector<T> &C)
+{
+    // Alloc on device
+    T *dev_A, *dev_B, *dev_C;
+    cudaError_t cuda_err = cudaMalloc(&dev_A, sizeof(T)*m*k);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_B, sizeof(T)*k*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_C, sizeof(T)*m*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy to device
+    cuda_err = cudaMemcpy(dev_A, &A[0], sizeof(T)*m*k,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(dev_B, &B[0], sizeof(T)*k*n,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(dev_C, &C[0], sizeof(T)*m*n,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Init stream
+    cudaStream_t stream;
+    cuda_err = cudaStreamCreate(&stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Launch low-level kernel
+    cuda<T>(stream, transA, m, n, k, alpha, dev_A, dev_B, beta, dev_C);
+    cuda_err = cudaStreamSynchronize(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy result and deallocate device memory
+    cuda_err = cudaMemcpy(&C[0], dev_C, sizeof(T)*m*n,
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_A);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_B);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_C);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaStreamDestroy(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+}
+#endif // NNTILE_USE_CUDA
+
+// Check result against explicitly evaluated product
+template<typename T>
+void check(bool transA, Index m, Index n, Index k, Scalar alpha,
+        const std::vector<T> &A, const std::vector<T> &B, Scalar beta,
+        const std::vector<T> &C_init, const std::vector<T> &C)
+{
+    using Y = typename T::repr_t;
+    for(Index j = 0; j < n; ++j)
+    {
+        for(Index i = 0; i < m; ++i)
+        {
+            double ref = 0;
+            for(Index l = 0; l < k; ++l)
+            {
+                Index A_idx = transA ? i*k+l : l*m+i;
+                ref += double(Y(A[A_idx])) * double(Y(B[j*k+l]));
+            }
+            ref = alpha*ref + beta*double(Y(C_init[j*m+i]));
+            double val = Y(C[j*m+i]);
+            TEST_ASSERT(std::abs(val-ref) <= 1e-5*(std::abs(ref)+1));
+        }
+    }
+}
+
+// Templated validation
+template<typename T>
+void validate(Index m, Index n, Index k)
+{
+    using Y = typename T::repr_t;
+    Scalar alpha = 0.5;
+    // Init test input
+    std::vector<T> A(m*k), B(k*n), C_init(m*n);
+    for(Index i = 0; i < m*k; ++i)
+    {
+        A[i] = Y(i%7 - 3);
+    }
+    for(Index i = 0; i < k*n; ++i)
+    {
+        B[i] = Y(i%5) / Y{4};
+    }
+    for(Index i = 0; i < m*n; ++i)
+    {
+        C_init[i] = Y(i%3 - 1);
+    }
+    for(bool transA: {false, true})
+    {
+        for(Scalar beta: {0.0, 1.0, -2.0})
+        {
+            // Check low-level kernel
+            std::cout << "Run kernel::gemv::cpu<" << T::type_repr << ">\n";
+            std::vector<T> C(C_init);
+            cpu<T>(transA, m, n, k, alpha, &A[0], &B[0], beta, &C[0]);
+            check<T>(transA, m, n, k, alpha, A, B, beta, C_init, C);
+            std::cout << "OK: kernel::gemv::cpu<" << T::type_repr << ">\n";
+#ifdef NNTILE_USE_CUDA
+            // Check low-level CUDA kernel
+            std::cout << "Run kernel::gemv::cuda<" << T::type_repr << ">\n";
+            std::vector<T> C_cuda(C_init);
+            run_cuda<T>(transA, m, n, k, alpha, A, B, beta, C_cuda);
+            check<T>(transA, m, n, k, alpha, A, B, beta, C_init, C_cuda);
+            std::cout << "OK: kernel::gemv::cuda<" << T::type_repr << ">\n";
+#endif // NNTILE_USE_CUDA
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    validate<fp32_t>(1, 1, 1);
+    validate<fp32_t>(100, 1, 37);
+    validate<fp32_t>(130, 3, 64);
+    validate<fp32_t>(20, 11, 5);
+    validate<fp64_t>(100, 1, 37);
+    validate<fp64_t>(70, 9, 200);
+    return 0;
+}
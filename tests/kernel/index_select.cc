@@ -0,0 +1,133 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/kernel/index_select.cc
+ * Selection of slices along an axis by indices
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/index_select.hh"
+#include "../testing.hh"
+#include <vector>
+#include <stdexcept>
+#include <iostream>
+
+using namespace nntile;
+using namespace nntile::kernel::index_select;
+
+#ifdef NNTILE_USE_CUDA
+template<typename T>
+void run_cuda(Index m, Index n, Index k, Index src_n,
+        const std::vector<nntile::int64_t> &index, const std::vector<T> &src,
+        std::vector<T> &dst)
+{
+    // Alloc on device
+    T *dev_src, *dev_dst;
+    nntile::int64_t *dev_index;
+    cudaError_t cuda_err = cudaMalloc(&dev_src, sizeof(T)*m*src_n*k);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_dst, sizeof(T)*m*n*k);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_index, sizeof(nntile::int64_t)*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy to device
+    cuda_err = cudaMemcpy(dev_src, &src[0], sizeof(T)*m*src_n*k,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(dev_index, &index[0], sizeof(nntile::int64_t)*n,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Init stream
+    cudaStream_t stream;
+    cuda_err = cudaStreamCreate(&stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Launch low-level kernel
+    cuda<T>(stream, m, n, k, src_n, dev_index, dev_src, dev_dst);
+    cuda_err = cudaStreamSynchronize(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy result and deallocate device memory
+    cuda_err = cudaMemcpy(&dst[0], dev_dst, sizeof(T)*m*n*k,
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_src);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_dst);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_index);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaStreamDestroy(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+}
+#endif // NNTILE_USE_CUDA
+
+// Check result elementwise
+template<typename T>
+void check(Index m, Index n, Index k, Index src_n,
+        const std::vector<nntile::int64_t> &index, const std::vector<T> &src,
+        const std::vector<T> &dst)
+{
+    using Y = typename T::repr_t;
+    for(Index l = 0; l < k; ++l)
+    {
+        for(Index j = 0; j < n; ++j)
+        {
+            for(Index i = 0; i < m; ++i)
+            {
+                Index src_j = Index(index[j]);
+                TEST_ASSERT(Y(dst[(l*n+j)*m+i])
+                        == Y(src[(l*src_n+src_j)*m+i]));
+            }
+        }
+    }
+}
+
+// Templated validation
+template<typename T>
+void validate(Index m, Index n, Index k, Index src_n)
+{
+    using Y = typename T::repr_t;
+    // Init test input
+    std::vector<T> src(m*src_n*k), dst(m*n*k, T(Y(-1)));
+    for(Index i = 0; i < m*src_n*k; ++i)
+    {
+        src[i] = Y(i+1);
+    }
+    // Indices repeat and go in reverse order
+    std::vector<nntile::int64_t> index(n);
+    for(Index j = 0; j < n; ++j)
+    {
+        index[j] = nntile::int64_t((src_n-1-j%src_n+j/src_n) % src_n);
+    }
+#ifdef NNTILE_USE_CUDA
+    std::vector<T> dst_cuda(dst);
+#endif // NNTILE_USE_CUDA
+    // Check low-level kernel
+    std::cout << "Run kernel::index_select::cpu<" << T::type_repr << ">\n";
+    cpu<T>(m, n, k, src_n, &index[0], &src[0], &dst[0]);
+    check<T>(m, n, k, src_n, index, src, dst);
+    std::cout << "OK: kernel::index_select::cpu<" << T::type_repr << ">\n";
+#ifdef NNTILE_USE_CUDA
+    // Check low-level CUDA kernel
+    std::cout << "Run kernel::index_select::cuda<" << T::type_repr << ">\n";
+    run_cuda<T>(m, n, k, src_n, index, src, dst_cuda);
+    check<T>(m, n, k, src_n, index, src, dst_cuda);
+    std::cout << "OK: kernel::index_select::cuda<" << T::type_repr << ">\n";
+#endif // NNTILE_USE_CUDA
+}
+
+int main(int argc, char **argv)
+{
+    validate<fp32_t>(10, 4, 3, 4);
+    validate<fp32_t>(7, 8, 2, 1);
+    validate<fp32_t>(5, 3, 6, 9);
+    validate<fp64_t>(10, 4, 3, 4);
+    validate<fp64_t>(7, 8, 2, 1);
+    validate<nntile::int64_t>(5, 3, 6, 9);
+    return 0;
+}
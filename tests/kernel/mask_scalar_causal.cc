@@ -0,0 +1,134 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/kernel/mask_scalar_causal.cc
+ * Implicit causal mask with scalar
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/mask_scalar_causal.hh"
+#include "../testing.hh"
+#include <vector>
+#include <stdexcept>
+#include <cmath>
+#include <iostream>
+
+using namespace nntile;
+using namespace nntile::kernel::mask_scalar_causal;
+
+#ifdef NNTILE_USE_CUDA
+template<typename T>
+void run_cuda(Index m, Index n, Index batch, Index k_start, Index q_start,
+        Index window, Index kv_len, Scalar val, std::vector<T> &data)
+{
+    // Alloc on device
+    T *dev_data;
+    Index nelems = m * n * batch;
+    cudaError_t cuda_err = cudaMalloc(&dev_data, sizeof(T)*nelems);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy to device
+    cuda_err = cudaMemcpy(dev_data, &data[0], sizeof(T)*nelems,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Init stream
+    cudaStream_t stream;
+    cuda_err = cudaStreamCreate(&stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Launch low-level kernel
+    cuda<T>(stream, m, n, batch, k_start, q_start, window, kv_len, val,
+            dev_data);
+    cuda_err = cudaStreamSynchronize(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy result and deallocate device memory
+    cuda_err = cudaMemcpy(&data[0], dev_data, sizeof(T)*nelems,
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_data);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaStreamDestroy(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+}
+#endif // NNTILE_USE_CUDA
+
+// Check result against explicitly evaluated mask
+template<typename T>
+void check(Index m, Index n, Index batch, Index k_start, Index q_start,
+        Index window, Index kv_len, Scalar val, const std::vector<T> &data)
+{
+    using Y = typename T::repr_t;
+    for(Index b = 0; b < batch; ++b)
+    {
+        for(Index j = 0; j < n; ++j)
+        {
+            for(Index i = 0; i < m; ++i)
+            {
+                Index k = k_start + i, q = q_start + j;
+                bool keep = k <= q and (window <= 0 or q-k < window)
+                    and (kv_len < 0 or k < kv_len);
+                Index idx = (b*n+j)*m + i;
+                if(keep)
+                {
+                    TEST_ASSERT(Y(data[idx]) == Y(idx+1));
+                }
+                else
+                {
+                    TEST_ASSERT(Y(data[idx]) == Y(val));
+                }
+            }
+        }
+    }
+}
+
+// Templated validation
+template<typename T>
+void validate(Index m, Index n, Index batch, Index k_start, Index q_start,
+        Index window, Index kv_len)
+{
+    using Y = typename T::repr_t;
+    Scalar val = -1.0;
+    // Init test input
+    Index nelems = m * n * batch;
+    std::vector<T> data(nelems);
+    for(Index i = 0; i < nelems; ++i)
+    {
+        data[i] = Y(i+1);
+    }
+#ifdef NNTILE_USE_CUDA
+    std::vector<T> data_cuda(data);
+#endif // NNTILE_USE_CUDA
+    // Check low-level kernel
+    std::cout << "Run kernel::mask_scalar_causal::cpu<" << T::type_repr
+        << ">\n";
+    cpu<T>(m, n, batch, k_start, q_start, window, kv_len, val, &data[0]);
+    check<T>(m, n, batch, k_start, q_start, window, kv_len, val, data);
+    std::cout << "OK: kernel::mask_scalar_causal::cpu<" << T::type_repr
+        << ">\n";
+#ifdef NNTILE_USE_CUDA
+    // Check low-level CUDA kernel
+    std::cout << "Run kernel::mask_scalar_causal::cuda<" << T::type_repr
+        << ">\n";
+    run_cuda<T>(m, n, batch, k_start, q_start, window, kv_len, val,
+            data_cuda);
+    check<T>(m, n, batch, k_start, q_start, window, kv_len, val, data_cuda);
+    std::cout << "OK: kernel::mask_scalar_causal::cuda<" << T::type_repr
+        << ">\n";
+#endif // NNTILE_USE_CUDA
+}
+
+int main(int argc, char **argv)
+{
+    validate<fp32_t>(10, 10, 3, 0, 0, 0, -1);
+    validate<fp32_t>(20, 7, 2, 0, 13, 0, -1);
+    validate<fp32_t>(16, 16, 4, 16, 8, 5, -1);
+    validate<fp32_t>(32, 4, 1, 0, 28, 10, 30);
+    validate<fp64_t>(10, 10, 3, 0, 0, 0, -1);
+    validate<fp64_t>(20, 7, 2, 0, 13, 0, 15);
+    validate<fp64_t>(16, 16, 4, 16, 8, 5, -1);
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/kernel/mask_varlen.cc
+ * Boolean mask of packed sequences
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/mask_varlen.hh"
+#include "../testing.hh"
+#include <vector>
+#include <stdexcept>
+#include <iostream>
+
+using namespace nntile;
+using namespace nntile::kernel::mask_varlen;
+
+#ifdef NNTILE_USE_CUDA
+void run_cuda(Index m, Index n, Index i_lo, Index i_hi, Index diag,
+        std::vector<bool_t> &mask)
+{
+    // Alloc on device
+    bool_t *dev_mask;
+    Index nelems = m * n;
+    cudaError_t cuda_err = cudaMalloc(&dev_mask, sizeof(bool_t)*nelems);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Init stream
+    cudaStream_t stream;
+    cuda_err = cudaStreamCreate(&stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Launch low-level kernel
+    cuda(stream, m, n, i_lo, i_hi, diag, dev_mask);
+    cuda_err = cudaStreamSynchronize(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy result and deallocate device memory
+    cuda_err = cudaMemcpy(&mask[0], dev_mask, sizeof(bool_t)*nelems,
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_mask);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaStreamDestroy(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+}
+#endif // NNTILE_USE_CUDA
+
+// Check result against explicitly evaluated mask
+void check(Index m, Index n, Index i_lo, Index i_hi, Index diag,
+        const std::vector<bool_t> &mask)
+{
+    for(Index j = 0; j < n; ++j)
+    {
+        for(Index i = 0; i < m; ++i)
+        {
+            bool keep = i >= i_lo and i < i_hi and i <= j+diag;
+            TEST_ASSERT(bool(mask[j*m+i]) == keep);
+        }
+    }
+}
+
+void validate(Index m, Index n, Index i_lo, Index i_hi, Index diag)
+{
+    // Fill output with garbage, as every element shall be overwritten
+    std::vector<bool_t> mask(m*n, bool_t(true));
+    for(Index i = 0; i < m*n; i += 2)
+    {
+        mask[i] = bool_t(false);
+    }
+#ifdef NNTILE_USE_CUDA
+    std::vector<bool_t> mask_cuda(mask);
+#endif // NNTILE_USE_CUDA
+    // Check low-level kernel
+    std::cout << "Run kernel::mask_varlen::cpu\n";
+    cpu(m, n, i_lo, i_hi, diag, &mask[0]);
+    check(m, n, i_lo, i_hi, diag, mask);
+    std::cout << "OK: kernel::mask_varlen::cpu\n";
+#ifdef NNTILE_USE_CUDA
+    // Check low-level CUDA kernel
+    std::cout << "Run kernel::mask_varlen::cuda\n";
+    run_cuda(m, n, i_lo, i_hi, diag, mask_cuda);
+    check(m, n, i_lo, i_hi, diag, mask_cuda);
+    std::cout << "OK: kernel::mask_varlen::cuda\n";
+#endif // NNTILE_USE_CUDA
+}
+
+int main(int argc, char **argv)
+{
+    // Causal mask of a single sequence
+    validate(10, 10, 0, 10, 0);
+    // Sequence starts and ends inside of the tile
+    validate(16, 5, 3, 11, 4);
+    // Sequence covers the tile, decode of a single query
+    validate(8, 1, -20, 30, 25);
+    // Sequence does not intersect keys of the tile
+    validate(8, 4, 9, 12, 20);
+    validate(8, 4, -5, 0, 20);
+    // All keys are in the future
+    validate(8, 4, 0, 8, -6);
+    return 0;
+}
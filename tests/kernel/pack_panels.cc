@@ -0,0 +1,60 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/kernel/pack_panels.cc
+ * Packing of a matrix into panels of rows
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/pack_panels.hh"
+#include "../testing.hh"
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <iostream>
+
+using namespace nntile;
+using namespace nntile::kernel::pack_panels;
+
+// Templated validation
+template<typename T>
+void validate(Index m, Index k)
+{
+    using Y = typename T::repr_t;
+    // Init test input
+    std::vector<T> src(m*k), dst(m*k);
+    for(Index i = 0; i < m*k; ++i)
+    {
+        src[i] = Y(i+1);
+    }
+    // Check low-level kernel
+    std::cout << "Run kernel::pack_panels::cpu<" << T::type_repr << ">\n";
+    cpu<T>(m, k, &src[0], &dst[0]);
+    for(Index p0 = 0; p0 < m; p0 += PANEL_M)
+    {
+        Index pm = std::min(PANEL_M, m-p0);
+        for(Index l = 0; l < k; ++l)
+        {
+            for(Index i = 0; i < pm; ++i)
+            {
+                TEST_ASSERT(Y(dst[p0*k+l*pm+i]) == Y(src[l*m+p0+i]));
+            }
+        }
+    }
+    std::cout << "OK: kernel::pack_panels::cpu<" << T::type_repr << ">\n";
+}
+
+int main(int argc, char **argv)
+{
+    validate<fp32_t>(1, 1);
+    validate<fp32_t>(64, 10);
+    validate<fp32_t>(150, 7);
+    validate<fp64_t>(200, 3);
+    return 0;
+}
@@ -0,0 +1,134 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/kernel/quantize.cc
+ * Symmetric int8 quantization of columns
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/quantize.hh"
+#include "../testing.hh"
+#include <vector>
+#include <stdexcept>
+#include <cmath>
+#include <iostream>
+
+using namespace nntile;
+using namespace nntile::kernel::quantize;
+
+#ifdef NNTILE_USE_CUDA
+template<typename T>
+void run_cuda(Index m, Index n, const std::vector<T> &src,
+        std::vector<nntile::int8_t> &dst, std::vector<T> &scale)
+{
+    // Alloc on device
+    T *dev_src, *dev_scale;
+    nntile::int8_t *dev_dst;
+    cudaError_t cuda_err = cudaMalloc(&dev_src, sizeof(T)*m*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_dst, sizeof(nntile::int8_t)*m*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_scale, sizeof(T)*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy to device
+    cuda_err = cudaMemcpy(dev_src, &src[0], sizeof(T)*m*n,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Init stream
+    cudaStream_t stream;
+    cuda_err = cudaStreamCreate(&stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Launch low-level kernel
+    cuda<T>(stream, m, n, dev_src, dev_dst, dev_scale);
+    cuda_err = cudaStreamSynchronize(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy result and deallocate device memory
+    cuda_err = cudaMemcpy(&dst[0], dev_dst, sizeof(nntile::int8_t)*m*n,
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(&scale[0], dev_scale, sizeof(T)*n,
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_src);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_dst);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_scale);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaStreamDestroy(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+}
+#endif // NNTILE_USE_CUDA
+
+// Check scales and reconstruction error of every column
+template<typename T>
+void check(Index m, Index n, const std::vector<T> &src,
+        const std::vector<nntile::int8_t> &dst, const std::vector<T> &scale)
+{
+    using Y = typename T::repr_t;
+    for(Index j = 0; j < n; ++j)
+    {
+        Y amax = 0, s = Y(scale[j]);
+        for(Index i = 0; i < m; ++i)
+        {
+            amax = std::max(amax, std::abs(Y(src[j*m+i])));
+        }
+        TEST_ASSERT(std::abs(s-amax/127) <= 1e-6*amax);
+        for(Index i = 0; i < m; ++i)
+        {
+            Index q = static_cast<std::int8_t>(dst[j*m+i]);
+            TEST_ASSERT(q >= -127 and q <= 127);
+            TEST_ASSERT(std::abs(q*s-Y(src[j*m+i])) <= 0.5001*s);
+        }
+    }
+}
+
+// Templated validation
+template<typename T>
+void validate(Index m, Index n)
+{
+    using Y = typename T::repr_t;
+    // Init test input, the first column is zero
+    std::vector<T> src(m*n);
+    for(Index j = 0; j < n; ++j)
+    {
+        for(Index i = 0; i < m; ++i)
+        {
+            src[j*m+i] = Y(j == 0 ? 0.0 : (j+1)*std::sin(Y(i+j*m+1)));
+        }
+    }
+    std::vector<nntile::int8_t> dst(m*n);
+    std::vector<T> scale(n);
+    // Check low-level kernel
+    std::cout << "Run kernel::quantize::cpu<" << T::type_repr << ">\n";
+    cpu<T>(m, n, &src[0], &dst[0], &scale[0]);
+    check<T>(m, n, src, dst, scale);
+    TEST_ASSERT(Y(scale[0]) == 0);
+    std::cout << "OK: kernel::quantize::cpu<" << T::type_repr << ">\n";
+#ifdef NNTILE_USE_CUDA
+    // Check low-level CUDA kernel
+    std::cout << "Run kernel::quantize::cuda<" << T::type_repr << ">\n";
+    std::vector<nntile::int8_t> dst_cuda(m*n);
+    std::vector<T> scale_cuda(n);
+    run_cuda<T>(m, n, src, dst_cuda, scale_cuda);
+    check<T>(m, n, src, dst_cuda, scale_cuda);
+    std::cout << "OK: kernel::quantize::cuda<" << T::type_repr << ">\n";
+#endif // NNTILE_USE_CUDA
+}
+
+int main(int argc, char **argv)
+{
+    validate<fp32_t>(1, 3);
+    validate<fp32_t>(64, 20);
+    validate<fp32_t>(100, 7);
+    validate<fp64_t>(1, 3);
+    validate<fp64_t>(64, 20);
+    validate<fp64_t>(100, 7);
+    return 0;
+}
@@ -0,0 +1,222 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/kernel/rope_qk.cc
+ * Fused in-place rotary positional embedding of queries and keys
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/rope_qk.hh"
+#include "../testing.hh"
+#include <vector>
+#include <stdexcept>
+#include <cmath>
+#include <iostream>
+
+using namespace nntile;
+using namespace nntile::kernel::rope_qk;
+
+// Sizes of arrays and of their updated parts
+struct Sizes
+{
+    Index m, seq, batch, nq, nk, ld_seq, ld_batch, sin_ld_seq, sin_ld_batch;
+    // Offsets of the updated part in q, k and in tables
+    Index s0, b0, ts0, tb0;
+};
+
+#ifdef NNTILE_USE_CUDA
+template<typename T>
+void run_cuda(const Sizes &z, bool inverse, const std::vector<T> &sin,
+        const std::vector<T> &cos, std::vector<T> &q, std::vector<T> &k)
+{
+    // Alloc on device
+    T *dev_sin, *dev_cos, *dev_q, *dev_k;
+    cudaError_t cuda_err = cudaMalloc(&dev_sin, sizeof(T)*sin.size());
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_cos, sizeof(T)*cos.size());
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_q, sizeof(T)*q.size());
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_k, sizeof(T)*k.size());
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy to device
+    cuda_err = cudaMemcpy(dev_sin, &sin[0], sizeof(T)*sin.size(),
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(dev_cos, &cos[0], sizeof(T)*cos.size(),
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(dev_q, &q[0], sizeof(T)*q.size(),
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(dev_k, &k[0], sizeof(T)*k.size(),
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Init stream
+    cudaStream_t stream;
+    cuda_err = cudaStreamCreate(&stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Launch low-level kernel
+    Index offset = 2 * z.m * (z.s0+z.ld_seq*z.b0);
+    Index sin_offset = z.m * (z.ts0+z.sin_ld_seq*z.tb0);
+    cuda<T>(stream, z.m, z.seq, z.batch, z.nq, z.nk, z.ld_seq, z.ld_batch,
+            z.sin_ld_seq, inverse, dev_sin+sin_offset, dev_cos+sin_offset,
+            dev_q+offset, dev_k+offset);
+    cuda_err = cudaStreamSynchronize(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy result and deallocate device memory
+    cuda_err = cudaMemcpy(&q[0], dev_q, sizeof(T)*q.size(),
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(&k[0], dev_k, sizeof(T)*k.size(),
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_sin);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_cos);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_q);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_k);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaStreamDestroy(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+}
+#endif // NNTILE_USE_CUDA
+
+template<typename T>
+void run_cpu(const Sizes &z, bool inverse, const std::vector<T> &sin,
+        const std::vector<T> &cos, std::vector<T> &q, std::vector<T> &k)
+{
+    Index offset = 2 * z.m * (z.s0+z.ld_seq*z.b0);
+    Index sin_offset = z.m * (z.ts0+z.sin_ld_seq*z.tb0);
+    cpu<T>(z.m, z.seq, z.batch, z.nq, z.nk, z.ld_seq, z.ld_batch,
+            z.sin_ld_seq, inverse, &sin[sin_offset], &cos[sin_offset],
+            &q[offset], &k[offset]);
+}
+
+// Check a single rotated array (either q or k) against its initial values
+template<typename T>
+void check(const Sizes &z, Index n, const std::vector<T> &sin,
+        const std::vector<T> &cos, const std::vector<T> &src,
+        const std::vector<T> &dst)
+{
+    using Y = typename T::repr_t;
+    const Y eps = 4 * T::epsilon();
+    for(Index j = 0; j < n; ++j)
+    {
+        for(Index b = 0; b < z.ld_batch; ++b)
+        {
+            for(Index s = 0; s < z.ld_seq; ++s)
+            {
+                for(Index i = 0; i < z.m; ++i)
+                {
+                    Index l = 2 * (i+z.m*(s+z.ld_seq*(b+z.ld_batch*j)));
+                    bool updated = s >= z.s0 and s < z.s0+z.seq
+                        and b >= z.b0 and b < z.b0+z.batch;
+                    if(not updated)
+                    {
+                        TEST_ASSERT(Y(dst[l]) == Y(src[l]));
+                        TEST_ASSERT(Y(dst[l+1]) == Y(src[l+1]));
+                        continue;
+                    }
+                    Index t = i + z.m*(s-z.s0+z.ts0
+                            +z.sin_ld_seq*(b-z.b0+z.tb0));
+                    Y c{cos[t]}, sn{sin[t]};
+                    Y a{src[l]}, d{src[l+1]};
+                    Y val_ref_a{c*a - sn*d};
+                    Y val_ref_b{sn*a + c*d};
+                    TEST_ASSERT(std::abs(Y(dst[l])-val_ref_a) <= eps);
+                    TEST_ASSERT(std::abs(Y(dst[l+1])-val_ref_b) <= eps);
+                }
+            }
+        }
+    }
+}
+
+// Templated validation
+template<typename T>
+void validate(const Sizes &z)
+{
+    using Y = typename T::repr_t;
+    const Y eps = 4 * T::epsilon();
+    Index q_nelems = 2 * z.m * z.ld_seq * z.ld_batch * z.nq;
+    Index k_nelems = 2 * z.m * z.ld_seq * z.ld_batch * z.nk;
+    Index sin_nelems = z.m * z.sin_ld_seq * z.sin_ld_batch;
+    // Init test input
+    std::vector<T> sin(sin_nelems), cos(sin_nelems);
+    for(Index i = 0; i < sin_nelems; ++i)
+    {
+        Y angle = Y(i) / Y{7};
+        sin[i] = Y(std::sin(angle));
+        cos[i] = Y(std::cos(angle));
+    }
+    std::vector<T> q(q_nelems), k(k_nelems);
+    for(Index i = 0; i < q_nelems; ++i)
+    {
+        q[i] = Y(2*i+1-q_nelems) / Y(q_nelems);
+    }
+    for(Index i = 0; i < k_nelems; ++i)
+    {
+        k[i] = Y(k_nelems-2*i-1) / Y(k_nelems);
+    }
+    // Check low-level CPU kernel
+    std::cout << "Run kernel::rope_qk::cpu<" << T::type_repr << ">\n";
+    std::vector<T> q_dst(q), k_dst(k);
+    run_cpu<T>(z, false, sin, cos, q_dst, k_dst);
+    check<T>(z, z.nq, sin, cos, q, q_dst);
+    check<T>(z, z.nk, sin, cos, k, k_dst);
+    // Inverse rotation restores input
+    run_cpu<T>(z, true, sin, cos, q_dst, k_dst);
+    for(Index i = 0; i < q_nelems; ++i)
+    {
+        TEST_ASSERT(std::abs(Y(q_dst[i])-Y(q[i])) <= eps);
+    }
+    for(Index i = 0; i < k_nelems; ++i)
+    {
+        TEST_ASSERT(std::abs(Y(k_dst[i])-Y(k[i])) <= eps);
+    }
+    std::cout << "OK: kernel::rope_qk::cpu<" << T::type_repr << ">\n";
+#ifdef NNTILE_USE_CUDA
+    // Check low-level CUDA kernel
+    std::cout << "Run kernel::rope_qk::cuda<" << T::type_repr << ">\n";
+    q_dst = q;
+    k_dst = k;
+    run_cuda<T>(z, false, sin, cos, q_dst, k_dst);
+    check<T>(z, z.nq, sin, cos, q, q_dst);
+    check<T>(z, z.nk, sin, cos, k, k_dst);
+    run_cuda<T>(z, true, sin, cos, q_dst, k_dst);
+    for(Index i = 0; i < q_nelems; ++i)
+    {
+        TEST_ASSERT(std::abs(Y(q_dst[i])-Y(q[i])) <= eps);
+    }
+    for(Index i = 0; i < k_nelems; ++i)
+    {
+        TEST_ASSERT(std::abs(Y(k_dst[i])-Y(k[i])) <= eps);
+    }
+    std::cout << "OK: kernel::rope_qk::cuda<" << T::type_repr << ">\n";
+#endif // NNTILE_USE_CUDA
+}
+
+int main(int argc, char **argv)
+{
+    // Whole arrays with the same number of heads
+    Sizes full{4, 5, 2, 3, 3, 5, 2, 5, 2, 0, 0, 0, 0};
+    // Grouped queries, a single decoded position at an offset in tables
+    Sizes decode{8, 1, 3, 6, 2, 1, 3, 20, 3, 0, 0, 11, 0};
+    // Part of a tile intersecting a part of a tile of tables
+    Sizes part{3, 2, 2, 4, 2, 6, 4, 5, 3, 3, 1, 1, 0};
+    validate<fp32_t>(full);
+    validate<fp32_t>(decode);
+    validate<fp32_t>(part);
+    validate<fp64_t>(full);
+    validate<fp64_t>(decode);
+    validate<fp64_t>(part);
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/kernel/sample_topk.cc
+ * Sample tokens from top-k candidates
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/sample_topk.hh"
+#include "../testing.hh"
+#include <vector>
+#include <stdexcept>
+#include <cmath>
+#include <iostream>
+
+using namespace nntile;
+using namespace nntile::kernel::sample_topk;
+
+#ifdef NNTILE_USE_CUDA
+template<typename T>
+void run_cuda(Index k, Index n, Scalar temperature, Scalar top_p,
+        unsigned long long seed, const std::vector<T> &val,
+        const std::vector<nntile::int64_t> &idx,
+        std::vector<nntile::int64_t> &dst)
+{
+    // Alloc on device
+    T *dev_val;
+    nntile::int64_t *dev_idx, *dev_dst;
+    cudaError_t cuda_err = cudaMalloc(&dev_val, sizeof(T)*k*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_idx, sizeof(nntile::int64_t)*k*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_dst, sizeof(nntile::int64_t)*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy to device
+    cuda_err = cudaMemcpy(dev_val, &val[0], sizeof(T)*k*n,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(dev_idx, &idx[0], sizeof(nntile::int64_t)*k*n,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Init stream
+    cudaStream_t stream;
+    cuda_err = cudaStreamCreate(&stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Launch low-level kernel
+    cuda<T>(stream, k, n, temperature, top_p, seed, dev_val, dev_idx,
+            dev_dst);
+    cuda_err = cudaStreamSynchronize(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy result and deallocate device memory
+    cuda_err = cudaMemcpy(&dst[0], dev_dst, sizeof(nntile::int64_t)*n,
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_val);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_idx);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_dst);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaStreamDestroy(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+}
+#endif // NNTILE_USE_CUDA
+
+// Check frequencies of sampled tokens
+/*! All the n columns contain the same candidates with indices 10*r, so the
+ * frequencies of sampled tokens approximate probabilities of candidates.
+ * */
+template<typename T>
+void check(Index k, Index nvalid, Index n, Scalar temperature, Scalar top_p,
+        const std::vector<T> &val, const std::vector<nntile::int64_t> &dst)
+{
+    using Y = typename T::repr_t;
+    // Reference probabilities
+    std::vector<Y> prob(k, Y(0));
+    if(temperature <= 0)
+    {
+        prob[0] = 1;
+    }
+    else
+    {
+        Y total = 0, nucleus = 0;
+        for(Index r = 0; r < nvalid; ++r)
+        {
+            total += std::exp((Y(val[r])-Y(val[0])) / temperature);
+        }
+        Index nkeep = 0;
+        while(nkeep < nvalid and (nkeep == 0 or nucleus < top_p*total))
+        {
+            prob[nkeep] = std::exp((Y(val[nkeep])-Y(val[0])) / temperature);
+            nucleus += prob[nkeep];
+            ++nkeep;
+        }
+        for(Index r = 0; r < nkeep; ++r)
+        {
+            prob[r] /= nucleus;
+        }
+    }
+    std::vector<Index> count(k, 0);
+    for(Index j = 0; j < n; ++j)
+    {
+        Index token(dst[j]);
+        TEST_ASSERT(token % 10 == 0 and token >= 0 and token < 10*nvalid);
+        ++count[token/10];
+    }
+    for(Index r = 0; r < k; ++r)
+    {
+        Y freq = Y(count[r]) / Y(n);
+        if(prob[r] == 0)
+        {
+            TEST_ASSERT(count[r] == 0);
+        }
+        else
+        {
+            TEST_ASSERT(std::abs(freq-prob[r]) < 0.02);
+        }
+    }
+}
+
+// Templated validation
+template<typename T>
+void validate(Index k, Index nvalid, Scalar temperature, Scalar top_p)
+{
+    using Y = typename T::repr_t;
+    Index n = 10000;
+    unsigned long long seed = 123456789;
+    // Init candidates, sorted in descending order
+    std::vector<T> val(k*n);
+    std::vector<nntile::int64_t> idx(k*n);
+    for(Index j = 0; j < n; ++j)
+    {
+        for(Index r = 0; r < k; ++r)
+        {
+            val[j*k+r] = Y(-0.5*r);
+            idx[j*k+r] = nntile::int64_t(r < nvalid ? 10*r : -1);
+        }
+    }
+    std::vector<nntile::int64_t> dst(n);
+    // Check low-level kernel
+    std::cout << "Run kernel::sample_topk::cpu<" << T::type_repr << ">\n";
+    cpu<T>(k, n, temperature, top_p, seed, &val[0], &idx[0], &dst[0]);
+    check<T>(k, nvalid, n, temperature, top_p, val, dst);
+    std::cout << "OK: kernel::sample_topk::cpu<" << T::type_repr << ">\n";
+#ifdef NNTILE_USE_CUDA
+    // Check low-level CUDA kernel, that shall produce the same tokens
+    std::cout << "Run kernel::sample_topk::cuda<" << T::type_repr << ">\n";
+    std::vector<nntile::int64_t> dst_cuda(n);
+    run_cuda<T>(k, n, temperature, top_p, seed, val, idx, dst_cuda);
+    for(Index j = 0; j < n; ++j)
+    {
+        TEST_ASSERT(Index(dst[j]) == Index(dst_cuda[j]));
+    }
+    std::cout << "OK: kernel::sample_topk::cuda<" << T::type_repr << ">\n";
+#endif // NNTILE_USE_CUDA
+}
+
+int main(int argc, char **argv)
+{
+    validate<fp32_t>(1, 1, 1.0, 1.0);
+    validate<fp32_t>(8, 8, 0.0, 1.0);
+    validate<fp32_t>(8, 8, 1.0, 1.0);
+    validate<fp32_t>(8, 5, 0.7, 1.0);
+    validate<fp32_t>(8, 8, 1.0, 0.6);
+    validate<fp32_t>(8, 8, 2.0, 1e-6);
+    validate<fp64_t>(8, 8, 0.0, 1.0);
+    validate<fp64_t>(8, 3, 1.0, 1.0);
+    validate<fp64_t>(8, 8, 1.0, 0.8);
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/kernel/topk.cc
+ * Top-k largest elements along the first mode
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/kernel/topk.hh"
+#include "../testing.hh"
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <iostream>
+
+using namespace nntile;
+using namespace nntile::kernel::topk;
+
+#ifdef NNTILE_USE_CUDA
+template<typename T>
+void run_cuda(Index m, Index n, Index k, Index offset, bool init,
+        const std::vector<T> &src, std::vector<T> &dst_val,
+        std::vector<nntile::int64_t> &dst_idx)
+{
+    // Alloc on device
+    T *dev_src, *dev_val;
+    nntile::int64_t *dev_idx;
+    cudaError_t cuda_err = cudaMalloc(&dev_src, sizeof(T)*m*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_val, sizeof(T)*k*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMalloc(&dev_idx, sizeof(nntile::int64_t)*k*n);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy to device
+    cuda_err = cudaMemcpy(dev_src, &src[0], sizeof(T)*m*n,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(dev_val, &dst_val[0], sizeof(T)*k*n,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(dev_idx, &dst_idx[0], sizeof(nntile::int64_t)*k*n,
+            cudaMemcpyHostToDevice);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Init stream
+    cudaStream_t stream;
+    cuda_err = cudaStreamCreate(&stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Launch low-level kernel
+    cuda<T>(stream, m, n, k, offset, init, dev_src, dev_val, dev_idx);
+    cuda_err = cudaStreamSynchronize(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    // Copy result and deallocate device memory
+    cuda_err = cudaMemcpy(&dst_val[0], dev_val, sizeof(T)*k*n,
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaMemcpy(&dst_idx[0], dev_idx, sizeof(nntile::int64_t)*k*n,
+            cudaMemcpyDeviceToHost);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_src);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_val);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaFree(dev_idx);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+    cuda_err = cudaStreamDestroy(stream);
+    TEST_ASSERT(cuda_err == cudaSuccess);
+}
+#endif // NNTILE_USE_CUDA
+
+// Check result against sorting of the entire column
+template<typename T>
+void check(Index m, Index n, Index k, const std::vector<T> &src,
+        const std::vector<T> &dst_val,
+        const std::vector<nntile::int64_t> &dst_idx)
+{
+    using Y = typename T::repr_t;
+    for(Index j = 0; j < n; ++j)
+    {
+        std::vector<Index> order(m);
+        for(Index i = 0; i < m; ++i)
+        {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                [&](Index a, Index b)
+                {
+                    return Y(src[j*m+a]) > Y(src[j*m+b]);
+                });
+        for(Index r = 0; r < k; ++r)
+        {
+            if(r < m)
+            {
+                TEST_ASSERT(Index(dst_idx[j*k+r]) == order[r]);
+                TEST_ASSERT(Y(dst_val[j*k+r]) == Y(src[j*m+order[r]]));
+            }
+            else
+            {
+                TEST_ASSERT(Index(dst_idx[j*k+r]) == -1);
+            }
+        }
+    }
+}
+
+// Templated validation
+template<typename T>
+void validate(Index m, Index n, Index k, Index m_split)
+{
+    using Y = typename T::repr_t;
+    // Init test input with ties
+    std::vector<T> src(m*n);
+    for(Index i = 0; i < m*n; ++i)
+    {
+        src[i] = Y((i*37+11) % 23);
+    }
+    // Split columns of input into two parts
+    Index m2 = m - m_split;
+    std::vector<T> src1(m_split*n), src2(m2*n);
+    for(Index j = 0; j < n; ++j)
+    {
+        for(Index i = 0; i < m_split; ++i)
+        {
+            src1[j*m_split+i] = src[j*m+i];
+        }
+        for(Index i = 0; i < m2; ++i)
+        {
+            src2[j*m2+i] = src[j*m+m_split+i];
+        }
+    }
+    std::vector<T> dst_val(k*n, T(Y(-1)));
+    std::vector<nntile::int64_t> dst_idx(k*n, nntile::int64_t(7));
+#ifdef NNTILE_USE_CUDA
+    std::vector<T> dst_val_cuda(dst_val);
+    std::vector<nntile::int64_t> dst_idx_cuda(dst_idx);
+#endif // NNTILE_USE_CUDA
+    // Check low-level kernel
+    std::cout << "Run kernel::topk::cpu<" << T::type_repr << ">\n";
+    cpu<T>(m_split, n, k, 0, true, &src1[0], &dst_val[0], &dst_idx[0]);
+    cpu<T>(m2, n, k, m_split, false, &src2[0], &dst_val[0], &dst_idx[0]);
+    check<T>(m, n, k, src, dst_val, dst_idx);
+    std::cout << "OK: kernel::topk::cpu<" << T::type_repr << ">\n";
+#ifdef NNTILE_USE_CUDA
+    // Check low-level CUDA kernel
+    std::cout << "Run kernel::topk::cuda<" << T::type_repr << ">\n";
+    run_cuda<T>(m_split, n, k, 0, true, src1, dst_val_cuda, dst_idx_cuda);
+    run_cuda<T>(m2, n, k, m_split, false, src2, dst_val_cuda, dst_idx_cuda);
+    check<T>(m, n, k, src, dst_val_cuda, dst_idx_cuda);
+    std::cout << "OK: kernel::topk::cuda<" << T::type_repr << ">\n";
+#endif // NNTILE_USE_CUDA
+}
+
+int main(int argc, char **argv)
+{
+    validate<fp32_t>(100, 3, 1, 50);
+    validate<fp32_t>(100, 3, 10, 33);
+    validate<fp32_t>(1000, 2, 40, 700);
+    validate<fp32_t>(5, 4, 8, 2);
+    validate<fp64_t>(100, 3, 1, 50);
+    validate<fp64_t>(100, 3, 10, 33);
+    validate<fp64_t>(5, 4, 8, 2);
+    return 0;
+}
@@ -0,0 +1,139 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/starpu/graph.cc
+ * Capture and replay of a graph of StarPU tasks
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/starpu/graph.hh"
+#include "nntile/starpu/fill.hh"
+#include "nntile/starpu/add_inplace.hh"
+#include "../testing.hh"
+#include <vector>
+#include <iostream>
+
+using namespace nntile;
+using namespace nntile::starpu;
+
+// Check that all elements of a handle are equal to a given value
+template<typename T>
+void check_value(const Handle &handle, Index nelems, Scalar val)
+{
+    using Y = typename T::repr_t;
+    auto local = handle.acquire(STARPU_R);
+    auto ptr = reinterpret_cast<T *>(local.get_ptr());
+    for(Index i = 0; i < nelems; ++i)
+    {
+        TEST_ASSERT(Y(ptr[i]) == Y(val));
+    }
+    local.release();
+}
+
+template<typename T>
+void validate(Index nelems)
+{
+    VariableHandle src(sizeof(T)*nelems, STARPU_RW),
+        dst(sizeof(T)*nelems, STARPU_RW);
+    fill::submit<T>(nelems, 1.0, src);
+    fill::submit<T>(nelems, 0.0, dst);
+    // Captured tasks are executed as usual
+    TaskGraph graph;
+    graph.begin_capture();
+    add_inplace::submit<T>(nelems, 1.0, src, 1.0, dst);
+    add_inplace::submit<T>(nelems, 1.0, src, 1.0, dst);
+    TEST_ASSERT(graph.end_capture());
+    TEST_ASSERT(graph.size() == 2);
+    check_value<T>(dst, nelems, 2.0);
+    // Replayed tasks read current data and are ordered with other tasks
+    fill::submit<T>(nelems, 2.0, src);
+    graph.replay();
+    check_value<T>(dst, nelems, 6.0);
+    // Replays do not wait for each other
+    graph.replay();
+    graph.replay();
+    check_value<T>(dst, nelems, 14.0);
+    graph.wait();
+    // Intermediate data, registered before capture, is reused by replays,
+    // while accesses to it are ordered by explicit dependencies
+    VariableHandle tmp(sizeof(T)*nelems, STARPU_RW);
+    graph.begin_capture();
+    fill::submit<T>(nelems, 1.0, tmp);
+    add_inplace::submit<T>(nelems, 1.0, tmp, 1.0, dst);
+    fill::submit<T>(nelems, 2.0, tmp);
+    add_inplace::submit<T>(nelems, 1.0, tmp, 1.0, dst);
+    add_inplace::submit<T>(nelems, 1.0, src, 1.0, dst);
+    fill::submit<T>(nelems, -1.0, tmp);
+    TEST_ASSERT(graph.end_capture());
+    TEST_ASSERT(graph.size() == 6);
+    check_value<T>(dst, nelems, 19.0);
+    for(Index i = 0; i < 10; ++i)
+    {
+        graph.replay();
+    }
+    add_inplace::submit<T>(nelems, 1.0, tmp, 1.0, dst);
+    check_value<T>(dst, nelems, 68.0);
+    check_value<T>(tmp, nelems, -1.0);
+    // Only one graph is captured at a time
+    TaskGraph graph2;
+    graph2.begin_capture();
+    TEST_THROW(graph.begin_capture());
+    TEST_THROW(graph.replay());
+    TEST_ASSERT(graph2.end_capture());
+    TEST_ASSERT(graph2.size() == 0);
+    TEST_THROW(graph2.end_capture());
+    // Tasks on temporary data, unregistered during capture, are executed as
+    // usual, but cannot be replayed
+    graph.begin_capture();
+    {
+        VariableHandle tmp2(sizeof(T)*nelems, STARPU_RW);
+        fill::submit<T>(nelems, 1.0, tmp2);
+        add_inplace::submit<T>(nelems, 1.0, tmp2, 1.0, dst);
+    }
+    TEST_ASSERT(!graph.end_capture());
+    TEST_ASSERT(graph.size() == 0);
+    check_value<T>(dst, nelems, 69.0);
+    // Scratch data, released during capture, is kept by the graph as its
+    // workspace, so the tasks can be replayed
+    graph.begin_capture();
+    {
+        VariableHandle tmp3(sizeof(T)*nelems, STARPU_SCRATCH);
+        fill::submit<T>(nelems, 1.0, tmp3);
+        add_inplace::submit<T>(nelems, 1.0, tmp3, 1.0, dst);
+    }
+    TEST_ASSERT(graph.end_capture());
+    TEST_ASSERT(graph.size() == 2);
+    graph.replay();
+    check_value<T>(dst, nelems, 71.0);
+    graph.clear();
+    // Replay of an empty graph does nothing
+    graph.replay();
+    graph.wait();
+    check_value<T>(dst, nelems, 71.0);
+    src.unregister();
+    dst.unregister();
+    tmp.unregister();
+    std::cout << "OK: starpu::TaskGraph<" << T::type_repr << ">\n";
+}
+
+int main(int argc, char **argv)
+{
+    // Init StarPU for testing on CPU only
+    Config starpu(1, 0, 0);
+    // Init codelets
+    fill::init();
+    add_inplace::init();
+    fill::restrict_where(STARPU_CPU);
+    add_inplace::restrict_where(STARPU_CPU);
+    // Launch all tests
+    validate<fp32_t>(1);
+    validate<fp32_t>(1000);
+    validate<fp64_t>(1000);
+    return 0;
+}
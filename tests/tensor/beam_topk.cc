@@ -0,0 +1,145 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/tensor/beam_topk.cc
+ * Top-k largest elements of a tensor for beam search
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/beam_topk.hh"
+#include "nntile/starpu/beam_topk.hh"
+#include "nntile/tensor/scatter.hh"
+#include "nntile/starpu/subcopy.hh"
+#include "nntile/starpu/copy.hh"
+#include "../testing.hh"
+#include <algorithm>
+
+using namespace nntile;
+using namespace nntile::tensor;
+
+template<typename T>
+void check(const std::vector<Index> &shape, const std::vector<Index> &basetile,
+        Index k)
+{
+    using Y = typename T::repr_t;
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Some preparation
+    starpu_mpi_tag_t last_tag = 0;
+    int mpi_size = starpu_mpi_world_size();
+    int mpi_rank = starpu_mpi_world_rank();
+    int mpi_root = 0;
+    // Generate single-tile source tensor with ties and init it
+    TensorTraits src_single_traits(shape, shape);
+    std::vector<int> dist_root = {mpi_root};
+    Tensor<T> src_single(src_single_traits, dist_root, last_tag);
+    if(mpi_rank == mpi_root)
+    {
+        auto tile = src_single.get_tile(0);
+        auto tile_local = tile.acquire(STARPU_W);
+        for(Index i = 0; i < src_single.nelems; ++i)
+        {
+            tile_local[i] = Y((i*37+11) % 23);
+        }
+        tile_local.release();
+    }
+    // Scatter source tensor
+    TensorTraits src_traits(shape, basetile);
+    std::vector<int> src_distr(src_traits.grid.nelems);
+    for(Index i = 0; i < src_traits.grid.nelems; ++i)
+    {
+        src_distr[i] = (i+1) % mpi_size;
+    }
+    Tensor<T> src(src_traits, src_distr, last_tag);
+    scatter<T>(src_single, src);
+    // Generate single-tile dest tensors of shape [1, k] on the root node
+    std::vector<Index> dst_shape = {1, k};
+    TensorTraits dst_traits(dst_shape, dst_shape);
+    Tensor<T> dst_val(dst_traits, dist_root, last_tag);
+    Tensor<nntile::int64_t> dst_idx(dst_traits, dist_root, last_tag);
+    Tensor<nntile::int64_t> dst_beam(dst_traits, dist_root, last_tag);
+    beam_topk<T>(src, dst_val, dst_idx, dst_beam);
+    // Compare against sorting of the entire tensor
+    if(mpi_rank == mpi_root)
+    {
+        auto src_local = src_single.get_tile(0).acquire(STARPU_R);
+        auto val_local = dst_val.get_tile(0).acquire(STARPU_R);
+        auto idx_local = dst_idx.get_tile(0).acquire(STARPU_R);
+        auto beam_local = dst_beam.get_tile(0).acquire(STARPU_R);
+        Index m = shape[0], nelems = src_single.nelems;
+        std::vector<Index> order(nelems);
+        for(Index i = 0; i < nelems; ++i)
+        {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                [&](Index a, Index b)
+                {
+                    return Y(src_local[a]) > Y(src_local[b]);
+                });
+        for(Index r = 0; r < k; ++r)
+        {
+            TEST_ASSERT(Index(idx_local[r]) == order[r]%m);
+            TEST_ASSERT(Index(beam_local[r]) == order[r]/m);
+            TEST_ASSERT(Y(val_local[r]) == Y(src_local[order[r]]));
+        }
+        src_local.release();
+        val_local.release();
+        idx_local.release();
+        beam_local.release();
+    }
+}
+
+template<typename T>
+void validate()
+{
+    check<T>({11}, {5}, 1);
+    check<T>({11}, {5}, 7);
+    check<T>({11, 4}, {5, 4}, 4);
+    check<T>({11, 6}, {5, 4}, 6);
+    check<T>({11, 1, 4}, {4, 1, 3}, 4);
+    check<T>({100, 2, 3}, {30, 2, 2}, 10);
+    // Sync to guarantee old data tags are cleaned up and can be reused
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Check throwing exceptions
+    starpu_mpi_tag_t last_tag = 0;
+    std::vector<Index> sh343 = {3, 4, 3}, sh223 = {2, 2, 3}, sh34 = {3, 4},
+        sh4 = {4}, sh2 = {2}, sh5 = {5}, sh13 = {1, 13}, empty = {};
+    TensorTraits trA(sh343, sh223), trB(sh34, sh34), trC(sh4, sh4),
+        trD(sh4, sh2), trE(sh5, sh5), trF(sh13, sh13), trS(empty, empty);
+    std::vector<int> dist0000 = {0, 0, 0, 0}, dist0 = {0}, dist00 = {0, 0};
+    Tensor<T> A(trA, dist0000, last_tag), B(trB, dist0, last_tag),
+        C(trC, dist0, last_tag), D(trD, dist00, last_tag),
+        F(trF, dist0, last_tag), S(trS, dist0, last_tag);
+    Tensor<nntile::int64_t> C_idx(trC, dist0, last_tag),
+        D_idx(trD, dist00, last_tag), E_idx(trE, dist0, last_tag),
+        F_idx(trF, dist0, last_tag), S_idx(trS, dist0, last_tag);
+    TEST_THROW(beam_topk<T>(S, S, S_idx, S_idx));
+    TEST_THROW(beam_topk<T>(A, C, C_idx, C_idx));
+    TEST_THROW(beam_topk<T>(B, C, C_idx, E_idx));
+    TEST_THROW(beam_topk<T>(B, D, D_idx, D_idx));
+    TEST_THROW(beam_topk<T>(B, F, F_idx, F_idx));
+}
+
+int main(int argc, char **argv)
+{
+    // Init StarPU for testing on CPU only
+    starpu::Config starpu(1, 0, 0);
+    // Init codelet
+    starpu::beam_topk::init();
+    starpu::subcopy::init();
+    starpu::copy::init();
+    starpu::beam_topk::restrict_where(STARPU_CPU);
+    starpu::subcopy::restrict_where(STARPU_CPU);
+    starpu::copy::restrict_where(STARPU_CPU);
+    // Launch all tests
+    validate<fp32_t>();
+    validate<fp64_t>();
+    return 0;
+}
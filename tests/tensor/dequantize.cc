@@ -0,0 +1,142 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/tensor/dequantize.cc
+ * Dequantization of an int8 tensor
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/dequantize.hh"
+#include "nntile/tensor/quantize.hh"
+#include "nntile/starpu/dequantize.hh"
+#include "nntile/starpu/quantize.hh"
+#include "nntile/tensor/scatter.hh"
+#include "nntile/tensor/gather.hh"
+#include "nntile/starpu/subcopy.hh"
+#include "nntile/starpu/copy.hh"
+#include "../testing.hh"
+#include <cmath>
+
+using namespace nntile;
+using namespace nntile::tensor;
+
+template<typename T>
+void check(const std::vector<Index> &shape, const std::vector<Index> &basetile)
+{
+    using Y = typename T::repr_t;
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Some preparation
+    starpu_mpi_tag_t last_tag = 0;
+    int mpi_size = starpu_mpi_world_size();
+    int mpi_rank = starpu_mpi_world_rank();
+    int mpi_root = 0;
+    // Generate single-tile source
+    TensorTraits single_traits(shape, shape);
+    std::vector<int> dist_root = {mpi_root};
+    Tensor<T> src_single(single_traits, dist_root, last_tag);
+    Index m = shape[0], n = src_single.nelems / m;
+    if(mpi_rank == mpi_root)
+    {
+        auto src_local = src_single.get_tile(0).acquire(STARPU_W);
+        for(Index i = 0; i < m*n; ++i)
+        {
+            src_local[i] = Y((i%7+1) * std::sin(Y(i)));
+        }
+        src_local.release();
+    }
+    // Scatter source
+    TensorTraits traits(shape, basetile);
+    std::vector<int> distr(traits.grid.nelems);
+    for(Index i = 0; i < traits.grid.nelems; ++i)
+    {
+        distr[i] = (i+1) % mpi_size;
+    }
+    Tensor<T> src(traits, distr, last_tag);
+    scatter<T>(src_single, src);
+    // Quantize on the same nodes, where scales are placed
+    std::vector<Index> scale_shape(shape.begin()+1, shape.end()),
+        scale_basetile(basetile.begin()+1, basetile.end());
+    TensorTraits scale_traits(scale_shape, scale_basetile);
+    std::vector<int> dst_distr(traits.grid.nelems);
+    for(Index i = 0; i < traits.grid.nelems; ++i)
+    {
+        dst_distr[i] = (i*i+1) % mpi_size;
+    }
+    Tensor<nntile::int8_t> dst(traits, dst_distr, last_tag);
+    Tensor<T> scale(scale_traits, dst_distr, last_tag);
+    quantize<T>(src, dst, scale);
+    // Reference result is obtained on a single tile
+    TensorTraits scale_single_traits(scale_shape, scale_shape);
+    Tensor<nntile::int8_t> dst_single(single_traits, dist_root, last_tag);
+    Tensor<T> scale_single(scale_single_traits, dist_root, last_tag);
+    Tensor<T> ref_single(single_traits, dist_root, last_tag);
+    quantize<T>(src_single, dst_single, scale_single);
+    dequantize<T>(dst_single, scale_single, ref_single);
+    // Dequantize on other nodes, than quantized values are placed
+    Tensor<T> out(traits, distr, last_tag);
+    dequantize<T>(dst, scale, out);
+    Tensor<T> out_single(single_traits, dist_root, last_tag);
+    gather<T>(out, out_single);
+    if(mpi_rank == mpi_root)
+    {
+        auto ref_local = ref_single.get_tile(0).acquire(STARPU_R);
+        auto out_local = out_single.get_tile(0).acquire(STARPU_R);
+        for(Index i = 0; i < m*n; ++i)
+        {
+            TEST_ASSERT(Y(out_local[i]) == Y(ref_local[i]));
+        }
+        ref_local.release();
+        out_local.release();
+    }
+}
+
+template<typename T>
+void validate()
+{
+    check<T>({4}, {4});
+    check<T>({4, 12}, {4, 5});
+    check<T>({16, 11, 13}, {16, 6, 5});
+    // Sync to guarantee old data tags are cleaned up and can be reused
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Check throwing exceptions
+    starpu_mpi_tag_t last_tag = 0;
+    std::vector<Index> sh34 = {3, 4}, sh23 = {2, 3}, sh4 = {4},
+        sh3 = {3}, sh44 = {4, 4};
+    TensorTraits trA(sh34, sh23), trB(sh34, sh34), trC(sh4, sh4),
+        trD(sh3, sh3), trE(sh44, sh44);
+    std::vector<int> dist0000 = {0, 0, 0, 0}, dist0 = {0};
+    Tensor<T> A(trA, dist0000, last_tag), B(trB, dist0, last_tag),
+        C(trC, dist0, last_tag), D(trD, dist0, last_tag);
+    Tensor<nntile::int8_t> A_q(trA, dist0000, last_tag),
+        B_q(trB, dist0, last_tag), E_q(trE, dist0, last_tag);
+    TEST_THROW(dequantize<T>(A_q, C, A));
+    TEST_THROW(dequantize<T>(B_q, D, B));
+    TEST_THROW(dequantize<T>(E_q, C, B));
+    TEST_THROW(dequantize<T>(B_q, B, B));
+}
+
+int main(int argc, char **argv)
+{
+    // Init StarPU for testing on CPU only
+    starpu::Config starpu(1, 0, 0);
+    // Init codelet
+    starpu::quantize::init();
+    starpu::dequantize::init();
+    starpu::subcopy::init();
+    starpu::copy::init();
+    starpu::quantize::restrict_where(STARPU_CPU);
+    starpu::dequantize::restrict_where(STARPU_CPU);
+    starpu::subcopy::restrict_where(STARPU_CPU);
+    starpu::copy::restrict_where(STARPU_CPU);
+    // Launch all tests
+    validate<fp32_t>();
+    validate<fp64_t>();
+    return 0;
+}
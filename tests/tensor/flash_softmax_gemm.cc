@@ -0,0 +1,217 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/tensor/flash_softmax_gemm.cc
+ * Flash maxsumexp and softmax+gemm with skipping of masked out tiles
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/flash_maxsumexp.hh"
+#include "nntile/tensor/flash_softmax_gemm.hh"
+#include "nntile/tensor/mask_tile_status.hh"
+#include "nntile/tensor/clear.hh"
+#include "nntile/tensor/gather.hh"
+#include "nntile/tensor/scatter.hh"
+#include "nntile/starpu.hh"
+#include "../testing.hh"
+#include <algorithm>
+#include <cmath>
+
+using namespace nntile;
+using namespace nntile::tensor;
+
+// Causal mask: key i is kept for query j if it is not in the future
+static bool mask_keep(Index i, Index j)
+{
+    return i <= j;
+}
+
+// Fill single-tile tensor with some values
+template<typename T>
+void fill_single(const Tensor<T> &A, Index shift)
+{
+    using Y = typename T::repr_t;
+    auto tile = A.get_tile(0);
+    auto tile_local = tile.acquire(STARPU_W);
+    for(Index i = 0; i < tile.nelems; ++i)
+    {
+        tile_local[i] = Y(0.1 * ((i+shift) % 11) - 0.5);
+    }
+    tile_local.release();
+}
+
+// Run flash maxsumexp and softmax+gemm and gather results on root
+template<typename T>
+void run(const Tensor<T> &Q, const Tensor<T> &K, const Tensor<T> &V,
+        const Tensor<bool_t> &mask, const Tensor<T> &maxsumexp,
+        const Tensor<T> &dst, const Tensor<T> &tmp,
+        const std::vector<int> &mask_tile_status,
+        const Tensor<T> &maxsumexp_single, const Tensor<T> &dst_single)
+{
+    clear<T>(maxsumexp);
+    flash_maxsumexp<T>(Q, K, mask, maxsumexp, tmp, 0, mask_tile_status);
+    flash_softmax_gemm<T>(Q, K, V, mask, maxsumexp, dst, tmp, 0,
+            mask_tile_status);
+    gather<T>(maxsumexp, maxsumexp_single);
+    gather<T>(dst, dst_single);
+}
+
+// Check that two single-tile tensors are close
+template<typename T>
+void check_close(const Tensor<T> &A, const Tensor<T> &B)
+{
+    using Y = typename T::repr_t;
+    auto tile = A.get_tile(0), tile2 = B.get_tile(0);
+    auto tile_local = tile.acquire(STARPU_R);
+    auto tile2_local = tile2.acquire(STARPU_R);
+    for(Index i = 0; i < tile.nelems; ++i)
+    {
+        Y a = tile_local[i], b = tile2_local[i];
+        TEST_ASSERT(std::abs(a-b) <= 10*T::epsilon()*(1+std::abs(a)));
+    }
+    tile_local.release();
+    tile2_local.release();
+}
+
+template<typename T>
+void check(Index head_size, Index n_seq, Index n_seq_tile, Index n_batch,
+        Index n_head)
+{
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    starpu_mpi_tag_t last_tag = 0;
+    int mpi_size = starpu_mpi_world_size();
+    int mpi_rank = starpu_mpi_world_rank();
+    int mpi_root = 0;
+    std::vector<int> dist_root = {mpi_root};
+    // Q, K, V and dst are of shape (head_size, n_seq, n_batch, n_head)
+    std::vector<Index> qkv_shape{head_size, n_seq, n_batch, n_head},
+        qkv_basetile{head_size, n_seq_tile, n_batch, n_head},
+        mask_shape{n_seq, n_seq}, mask_basetile{n_seq_tile, n_seq_tile},
+        maxsumexp_shape{2, n_seq, n_batch, n_head},
+        maxsumexp_basetile{2, n_seq_tile, n_batch, n_head},
+        tmp_shape{n_seq, n_seq, n_batch, n_head},
+        tmp_basetile{n_seq_tile, n_seq_tile, n_batch, n_head};
+    TensorTraits qkv_single_traits(qkv_shape, qkv_shape),
+        mask_single_traits(mask_shape, mask_shape),
+        maxsumexp_single_traits(maxsumexp_shape, maxsumexp_shape),
+        qkv_traits(qkv_shape, qkv_basetile),
+        mask_traits(mask_shape, mask_basetile),
+        maxsumexp_traits(maxsumexp_shape, maxsumexp_basetile),
+        tmp_traits(tmp_shape, tmp_basetile);
+    auto distr = [&](const TensorTraits &traits)
+    {
+        std::vector<int> res(traits.grid.nelems);
+        for(Index i = 0; i < traits.grid.nelems; ++i)
+        {
+            res[i] = (i+1) % mpi_size;
+        }
+        return res;
+    };
+    Tensor<T> Q_single(qkv_single_traits, dist_root, last_tag),
+        K_single(qkv_single_traits, dist_root, last_tag),
+        V_single(qkv_single_traits, dist_root, last_tag);
+    Tensor<bool_t> mask_single(mask_single_traits, dist_root, last_tag);
+    if(mpi_rank == mpi_root)
+    {
+        fill_single<T>(Q_single, 0);
+        fill_single<T>(K_single, 3);
+        fill_single<T>(V_single, 7);
+        auto tile = mask_single.get_tile(0);
+        auto tile_local = tile.acquire(STARPU_W);
+        for(Index i = 0; i < n_seq; ++i)
+        {
+            for(Index j = 0; j < n_seq; ++j)
+            {
+                tile_local[j*n_seq+i] = bool_t(mask_keep(i, j));
+            }
+        }
+        tile_local.release();
+    }
+    Tensor<T> Q(qkv_traits, distr(qkv_traits), last_tag),
+        K(qkv_traits, distr(qkv_traits), last_tag),
+        V(qkv_traits, distr(qkv_traits), last_tag),
+        dst(qkv_traits, distr(qkv_traits), last_tag),
+        maxsumexp(maxsumexp_traits, distr(maxsumexp_traits), last_tag),
+        tmp(tmp_traits, distr(tmp_traits), last_tag);
+    Tensor<bool_t> mask(mask_traits, distr(mask_traits), last_tag);
+    scatter<T>(Q_single, Q);
+    scatter<T>(K_single, K);
+    scatter<T>(V_single, V);
+    scatter<bool_t>(mask_single, mask);
+    // Statuses of tiles of the causal mask
+    std::vector<int> mask_tile_status(mask_traits.grid.nelems);
+    for(Index t = 0; t < mask_traits.grid.nelems; ++t)
+    {
+        auto tile_index = mask_traits.grid.linear_to_index(t);
+        auto tile_traits = mask.get_tile_traits(t);
+        Index nkeep = 0;
+        for(Index i = 0; i < tile_traits.shape[0]; ++i)
+        {
+            for(Index j = 0; j < tile_traits.shape[1]; ++j)
+            {
+                if(mask_keep(tile_index[0]*n_seq_tile+i,
+                            tile_index[1]*n_seq_tile+j))
+                {
+                    ++nkeep;
+                }
+            }
+        }
+        if(nkeep == 0)
+        {
+            mask_tile_status[t] = MASK_TILE_EMPTY;
+        }
+        else if(nkeep == tile_traits.nelems)
+        {
+            mask_tile_status[t] = MASK_TILE_FULL;
+        }
+        else
+        {
+            mask_tile_status[t] = MASK_TILE_PARTIAL;
+        }
+    }
+    // Skipped tiles shall be present for the check to make sense
+    TEST_ASSERT(std::count(mask_tile_status.begin(), mask_tile_status.end(),
+                MASK_TILE_EMPTY) > 0);
+    // Reference: all tiles are processed
+    Tensor<T> maxsumexp_ref(maxsumexp_single_traits, dist_root, last_tag),
+        dst_ref(qkv_single_traits, dist_root, last_tag);
+    run<T>(Q, K, V, mask, maxsumexp, dst, tmp, {}, maxsumexp_ref, dst_ref);
+    // Tiles, that are entirely masked out, are skipped
+    Tensor<T> maxsumexp_skip(maxsumexp_single_traits, dist_root, last_tag),
+        dst_skip(qkv_single_traits, dist_root, last_tag);
+    run<T>(Q, K, V, mask, maxsumexp, dst, tmp, mask_tile_status,
+            maxsumexp_skip, dst_skip);
+    if(mpi_rank == mpi_root)
+    {
+        check_close<T>(maxsumexp_ref, maxsumexp_skip);
+        check_close<T>(dst_ref, dst_skip);
+    }
+}
+
+template<typename T>
+void validate()
+{
+    check<T>(4, 8, 2, 1, 2);
+    check<T>(2, 12, 4, 2, 1);
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+}
+
+int main(int argc, char **argv)
+{
+    // Init StarPU for testing on CPU only
+    starpu::Config starpu(1, 0, 0);
+    // Init all codelets
+    starpu::init();
+    // Launch all tests
+    validate<fp32_t>();
+    validate<fp64_t>();
+    return 0;
+}
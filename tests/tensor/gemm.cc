@@ -17,6 +17,8 @@
 #include "nntile/tensor/gather.hh"
 #include "nntile/tensor/scatter.hh"
 #include "nntile/starpu/gemm.hh"
+#include "nntile/starpu/gemv.hh"
+#include "nntile/starpu/add_inplace.hh"
 #include "nntile/starpu/subcopy.hh"
 #include "../testing.hh"
 
@@ -284,8 +286,12 @@ int main(int argc, char **argv)
     starpu::Config starpu(1, 0, 0);
     // Init codelet
     starpu::gemm::init();
+    starpu::gemv::init();
+    starpu::add_inplace::init();
     starpu::subcopy::init();
     starpu::gemm::restrict_where(STARPU_CPU);
+    starpu::gemv::restrict_where(STARPU_CPU);
+    starpu::add_inplace::restrict_where(STARPU_CPU);
     starpu::subcopy::restrict_where(STARPU_CPU);
     // Launch all tests
     validate<fp32_t>();
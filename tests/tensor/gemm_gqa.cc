@@ -0,0 +1,224 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/tensor/gemm_gqa.cc
+ * GEMM operation for Tensor<T> with an operand shared by a group of batches
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/gemm_gqa.hh"
+#include "nntile/tensor/gather.hh"
+#include "nntile/tensor/scatter.hh"
+#include "nntile/starpu/gemm.hh"
+#include "nntile/starpu/subcopy.hh"
+#include "../testing.hh"
+
+using namespace nntile;
+using namespace nntile::tensor;
+
+// Sizes of head, keys, queries, batch, group and number of KV heads
+constexpr Index H = 2, S = 3, L = 2, NB = 2, G = 2, NH = 2;
+
+//! Create a tiled tensor and fill it with a given function of linear index
+template<typename T, typename F>
+Tensor<T> make(const std::vector<Index> &shape,
+        const std::vector<Index> &basetile, F func,
+        starpu_mpi_tag_t &last_tag)
+{
+    using Y = typename T::repr_t;
+    int mpi_size = starpu_mpi_world_size();
+    int mpi_rank = starpu_mpi_world_rank();
+    int mpi_root = 0;
+    TensorTraits single_traits(shape, shape);
+    std::vector<int> dist_root = {mpi_root};
+    Tensor<T> single(single_traits, dist_root, last_tag);
+    if(mpi_rank == mpi_root)
+    {
+        auto tile = single.get_tile(0);
+        auto tile_local = tile.acquire(STARPU_W);
+        for(Index i = 0; i < tile.nelems; ++i)
+        {
+            tile_local[i] = Y(func(i));
+        }
+        tile_local.release();
+    }
+    TensorTraits traits(shape, basetile);
+    std::vector<int> distr(traits.grid.nelems);
+    for(Index i = 0; i < traits.grid.nelems; ++i)
+    {
+        distr[i] = (i+1) % mpi_size;
+    }
+    Tensor<T> dst(traits, distr, last_tag);
+    scatter<T>(single, dst);
+    return dst;
+}
+
+//! Gather a tiled tensor into a host vector on the root node
+template<typename T>
+std::vector<typename T::repr_t> get(const Tensor<T> &src,
+        starpu_mpi_tag_t &last_tag)
+{
+    using Y = typename T::repr_t;
+    int mpi_rank = starpu_mpi_world_rank();
+    int mpi_root = 0;
+    TensorTraits single_traits(src.shape, src.shape);
+    std::vector<int> dist_root = {mpi_root};
+    Tensor<T> single(single_traits, dist_root, last_tag);
+    gather<T>(src, single);
+    std::vector<Y> res(src.nelems);
+    if(mpi_rank == mpi_root)
+    {
+        auto tile = single.get_tile(0);
+        auto tile_local = tile.acquire(STARPU_R);
+        for(Index i = 0; i < tile.nelems; ++i)
+        {
+            res[i] = Y(tile_local[i]);
+        }
+        tile_local.release();
+    }
+    return res;
+}
+
+template<typename T>
+void check(Index h_tile, Index g_tile)
+{
+    using Y = typename T::repr_t;
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    starpu_mpi_tag_t last_tag = 0;
+    int mpi_rank = starpu_mpi_world_rank();
+    int mpi_root = 0;
+    TransOp opT(TransOp::Trans), opN(TransOp::NoTrans);
+    Scalar one = 1, zero = 0, mone = -1;
+    auto fk = [](Index i){return i%5 - 2;};
+    auto fq = [](Index i){return i%7 - 3;};
+    auto fa = [](Index i){return i%3 - 1;};
+    // K is shared by the group dimension of Q
+    auto K = make<T>({H, S, NB, NH}, {h_tile, 2, 1, 1}, fk, last_tag);
+    auto Q = make<T>({H, L, NB, G, NH}, {h_tile, 1, 1, g_tile, 1}, fq,
+            last_tag);
+    auto A = make<T>({S, L, NB, G, NH}, {2, 1, 1, g_tile, 1}, fa, last_tag);
+    auto C = make<T>({L, S, NB, G, NH}, {1, 2, 1, g_tile, 1}, fa, last_tag);
+    auto dK = make<T>({H, S, NB, NH}, {h_tile, 2, 1, 1}, fa, last_tag);
+    // Shared A: A = einsum('hsbn,hqbgn->sqbgn', K, Q)
+    gemm_gqa<T>(one, opT, K, opN, Q, zero, A, 1, 3, 1,
+            starpu::gemm::GROUP_BCAST_A);
+    // Shared B: C = einsum('hqbgn,hsbn->qsbgn', Q, K)
+    gemm_gqa<T>(one, opT, Q, opN, K, zero, C, 1, 3, 1,
+            starpu::gemm::GROUP_BCAST_B);
+    // Shared C: dK = -dK + einsum('hqbgn,sqbgn->hsbn', Q, A)
+    gemm_gqa<T>(one, opN, Q, opT, A, mone, dK, 1, 3, 1,
+            starpu::gemm::GROUP_BCAST_C);
+    auto A_res = get<T>(A, last_tag);
+    auto C_res = get<T>(C, last_tag);
+    auto dK_res = get<T>(dK, last_tag);
+    if(mpi_rank == mpi_root)
+    {
+        auto k_idx = [](Index h, Index s, Index b, Index n)
+        {
+            return h + H*(s + S*(b + NB*n));
+        };
+        auto q_idx = [](Index h, Index q, Index b, Index g, Index n)
+        {
+            return h + H*(q + L*(b + NB*(g + G*n)));
+        };
+        auto a_idx = [](Index s, Index q, Index b, Index g, Index n)
+        {
+            return s + S*(q + L*(b + NB*(g + G*n)));
+        };
+        auto c_idx = [](Index q, Index s, Index b, Index g, Index n)
+        {
+            return q + L*(s + S*(b + NB*(g + G*n)));
+        };
+        for(Index n = 0; n < NH; ++n)
+        {
+            for(Index b = 0; b < NB; ++b)
+            {
+                for(Index s = 0; s < S; ++s)
+                {
+                    for(Index h = 0; h < H; ++h)
+                    {
+                        Y dk_ref = -Y(fa(k_idx(h, s, b, n)));
+                        for(Index g = 0; g < G; ++g)
+                        {
+                            for(Index q = 0; q < L; ++q)
+                            {
+                                dk_ref += Y(fq(q_idx(h, q, b, g, n)))
+                                    * A_res[a_idx(s, q, b, g, n)];
+                            }
+                        }
+                        TEST_ASSERT(dK_res[k_idx(h, s, b, n)] == dk_ref);
+                    }
+                    for(Index g = 0; g < G; ++g)
+                    {
+                        for(Index q = 0; q < L; ++q)
+                        {
+                            Y a_ref = 0;
+                            for(Index h = 0; h < H; ++h)
+                            {
+                                a_ref += Y(fk(k_idx(h, s, b, n)))
+                                    * Y(fq(q_idx(h, q, b, g, n)));
+                            }
+                            TEST_ASSERT(A_res[a_idx(s, q, b, g, n)] == a_ref);
+                            TEST_ASSERT(C_res[c_idx(q, s, b, g, n)] == a_ref);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<typename T>
+void validate()
+{
+    // Group dimension is split into tiles
+    check<T>(1, 1);
+    // Group dimension is within a single tile
+    check<T>(2, 2);
+    check<T>(1, 2);
+    // Sync to guarantee old data tags are cleaned up and can be reused
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Check throwing exceptions
+    starpu_mpi_tag_t last_tag = 0;
+    TransOp opT(TransOp::Trans), opN(TransOp::NoTrans);
+    Scalar one = 1, zero = 0;
+    std::vector<int> dist0 = {0};
+    TensorTraits K_traits({H, S, NB, NH}, {H, S, NB, NH}),
+        Q_traits({H, L, NB, G, NH}, {H, L, NB, G, NH}),
+        A_traits({S, L, NB, G, NH}, {S, L, NB, G, NH});
+    Tensor<T> K(K_traits, dist0, last_tag), Q(Q_traits, dist0, last_tag),
+        A(A_traits, dist0, last_tag);
+    // Wrong position of the group dimension
+    TEST_THROW(gemm_gqa<T>(one, opT, K, opN, Q, zero, A, 1, 3, 3,
+                starpu::gemm::GROUP_BCAST_A));
+    TEST_THROW(gemm_gqa<T>(one, opT, K, opN, Q, zero, A, 1, 3, -1,
+                starpu::gemm::GROUP_BCAST_A));
+    // Q has the group dimension, so it can not be the shared operand
+    TEST_THROW(gemm_gqa<T>(one, opT, K, opN, Q, zero, A, 1, 3, 1,
+                starpu::gemm::GROUP_BCAST_B));
+    // Wrong value of the shared operand
+    TEST_THROW(gemm_gqa<T>(one, opT, K, opN, Q, zero, A, 1, 3, 1,
+                starpu::gemm::GROUP_BCAST_NONE));
+}
+
+int main(int argc, char **argv)
+{
+    // Init StarPU for testing on CPU only
+    starpu::Config starpu(1, 0, 0);
+    // Init codelet
+    starpu::gemm::init();
+    starpu::subcopy::init();
+    starpu::gemm::restrict_where(STARPU_CPU);
+    starpu::subcopy::restrict_where(STARPU_CPU);
+    // Launch all tests
+    validate<fp32_t>();
+    validate<fp64_t>();
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/tensor/gemm_packed.cc
+ * Product of a packed tensor by a tensor
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/gemm_packed.hh"
+#include "nntile/tensor/pack_panels.hh"
+#include "nntile/tensor/gemm.hh"
+#include "nntile/tensor/gather.hh"
+#include "nntile/tensor/scatter.hh"
+#include "nntile/starpu/gemm_packed.hh"
+#include "nntile/starpu/pack_panels.hh"
+#include "nntile/starpu/gemm.hh"
+#include "nntile/starpu/gemv.hh"
+#include "nntile/starpu/add_inplace.hh"
+#include "nntile/starpu/subcopy.hh"
+#include "../testing.hh"
+#include <cmath>
+
+using namespace nntile;
+using namespace nntile::tensor;
+
+// Compare gemm_packed against gemm of the same tensors
+template<typename T>
+void check(const TransOp &transB, const std::vector<Index> &A_shape,
+        const std::vector<Index> &A_basetile,
+        const std::vector<Index> &B_shape,
+        const std::vector<Index> &B_basetile,
+        const std::vector<Index> &C_shape,
+        const std::vector<Index> &C_basetile, Index ndim, Scalar beta)
+{
+    using Y = typename T::repr_t;
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    starpu_mpi_tag_t last_tag = 0;
+    int mpi_size = starpu_mpi_world_size();
+    int mpi_rank = starpu_mpi_world_rank();
+    int mpi_root = 0;
+    TransOp opN(TransOp::NoTrans);
+    // Generate single-tile tensors
+    TensorTraits A_single_traits(A_shape, A_shape),
+        B_single_traits(B_shape, B_shape), C_single_traits(C_shape, C_shape);
+    std::vector<int> dist_root = {mpi_root};
+    Tensor<T> A_single(A_single_traits, dist_root, last_tag),
+        B_single(B_single_traits, dist_root, last_tag),
+        C_single(C_single_traits, dist_root, last_tag);
+    if(mpi_rank == mpi_root)
+    {
+        auto A_local = A_single.get_tile(0).acquire(STARPU_W);
+        for(Index i = 0; i < A_single.nelems; ++i)
+        {
+            A_local[i] = Y(std::sin(Y(i)));
+        }
+        A_local.release();
+        auto B_local = B_single.get_tile(0).acquire(STARPU_W);
+        for(Index i = 0; i < B_single.nelems; ++i)
+        {
+            B_local[i] = Y(std::cos(Y(i)));
+        }
+        B_local.release();
+        auto C_local = C_single.get_tile(0).acquire(STARPU_W);
+        for(Index i = 0; i < C_single.nelems; ++i)
+        {
+            C_local[i] = Y(i%5);
+        }
+        C_local.release();
+    }
+    // Scatter tensors
+    TensorTraits A_traits(A_shape, A_basetile), B_traits(B_shape, B_basetile),
+        C_traits(C_shape, C_basetile);
+    std::vector<int> A_distr(A_traits.grid.nelems),
+        B_distr(B_traits.grid.nelems), C_distr(C_traits.grid.nelems);
+    for(Index i = 0; i < A_traits.grid.nelems; ++i)
+    {
+        A_distr[i] = (i+1) % mpi_size;
+    }
+    for(Index i = 0; i < B_traits.grid.nelems; ++i)
+    {
+        B_distr[i] = (i+2) % mpi_size;
+    }
+    for(Index i = 0; i < C_traits.grid.nelems; ++i)
+    {
+        C_distr[i] = (i*i+1) % mpi_size;
+    }
+    Tensor<T> A(A_traits, A_distr, last_tag), A_packed(A_traits, A_distr,
+            last_tag), B(B_traits, B_distr, last_tag), C(C_traits, C_distr,
+            last_tag), C_ref(C_traits, C_distr, last_tag);
+    scatter<T>(A_single, A);
+    scatter<T>(B_single, B);
+    scatter<T>(C_single, C);
+    scatter<T>(C_single, C_ref);
+    // Get reference and packed results
+    gemm<T>(-1.0, opN, A, transB, B, beta, C_ref, ndim, 0);
+    pack_panels<T>(A, A_packed, ndim);
+    gemm_packed<T>(-1.0, A_packed, transB, B, beta, C, ndim);
+    gather<T>(C_ref, C_single);
+    Tensor<T> C_out(C_single_traits, dist_root, last_tag);
+    gather<T>(C, C_out);
+    if(mpi_rank == mpi_root)
+    {
+        auto ref_local = C_single.get_tile(0).acquire(STARPU_R);
+        auto out_local = C_out.get_tile(0).acquire(STARPU_R);
+        for(Index i = 0; i < C_single.nelems; ++i)
+        {
+            Y diff = std::abs(Y(out_local[i]) - Y(ref_local[i]));
+            TEST_ASSERT(diff <= 100*T::epsilon()*(std::abs(Y(ref_local[i]))
+                        +Y(1)));
+        }
+        ref_local.release();
+        out_local.release();
+    }
+}
+
+template<typename T>
+void validate()
+{
+    TransOp opT(TransOp::Trans), opN(TransOp::NoTrans);
+    check<T>(opN, {100, 30}, {70, 11}, {30, 5}, {11, 2}, {100, 5}, {70, 2},
+            1, 0.0);
+    check<T>(opT, {100, 30}, {70, 11}, {5, 30}, {2, 11}, {100, 5}, {70, 2},
+            1, 1.0);
+    check<T>(opN, {10, 4, 6}, {10, 3, 4}, {4, 6, 20}, {3, 4, 9},
+            {10, 20}, {10, 9}, 2, -1.0);
+    // Sync to guarantee old data tags are cleaned up and can be reused
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Check throwing exceptions
+    starpu_mpi_tag_t last_tag = 0;
+    std::vector<Index> sh34 = {3, 4}, sh43 = {4, 3}, sh33 = {3, 3};
+    TensorTraits tr34(sh34, sh34), tr43(sh43, sh43), tr33(sh33, sh33);
+    std::vector<int> dist0 = {0};
+    Tensor<T> A(tr34, dist0, last_tag), B(tr43, dist0, last_tag),
+        C(tr33, dist0, last_tag);
+    TEST_THROW(pack_panels<T>(A, B, 1));
+    TEST_THROW(pack_panels<T>(A, A, 3));
+    TEST_THROW(gemm_packed<T>(1.0, A, opT, B, 0.0, C, 1));
+    TEST_THROW(gemm_packed<T>(1.0, A, opN, B, 0.0, A, 1));
+}
+
+int main(int argc, char **argv)
+{
+    // Init StarPU for testing on CPU only
+    starpu::Config starpu(1, 0, 0);
+    // Init codelet
+    starpu::gemm_packed::init();
+    starpu::pack_panels::init();
+    starpu::gemm::init();
+    starpu::gemv::init();
+    starpu::add_inplace::init();
+    starpu::subcopy::init();
+    starpu::gemm::restrict_where(STARPU_CPU);
+    starpu::gemv::restrict_where(STARPU_CPU);
+    starpu::add_inplace::restrict_where(STARPU_CPU);
+    starpu::subcopy::restrict_where(STARPU_CPU);
+    // Launch all tests
+    validate<fp32_t>();
+    validate<fp64_t>();
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/tensor/index_select.cc
+ * Selection of slices of a tensor along an axis by indices
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/index_select.hh"
+#include "nntile/starpu/index_select.hh"
+#include "nntile/tensor/scatter.hh"
+#include "nntile/tensor/gather.hh"
+#include "nntile/starpu/subcopy.hh"
+#include "nntile/starpu/copy.hh"
+#include "../testing.hh"
+
+using namespace nntile;
+using namespace nntile::tensor;
+
+template<typename T>
+void check(const std::vector<Index> &shape, const std::vector<Index> &basetile,
+        Index axis, const std::vector<Index> &index_values)
+{
+    using Y = typename T::repr_t;
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Some preparation
+    starpu_mpi_tag_t last_tag = 0;
+    int mpi_size = starpu_mpi_world_size();
+    int mpi_rank = starpu_mpi_world_rank();
+    int mpi_root = 0;
+    Index n = index_values.size();
+    // Generate single-tile source and index tensors and init them
+    TensorTraits src_single_traits(shape, shape);
+    std::vector<int> dist_root = {mpi_root};
+    Tensor<T> src_single(src_single_traits, dist_root, last_tag);
+    TensorTraits index_traits({n}, {n});
+    Tensor<nntile::int64_t> index(index_traits, dist_root, last_tag);
+    if(mpi_rank == mpi_root)
+    {
+        auto tile_local = src_single.get_tile(0).acquire(STARPU_W);
+        for(Index i = 0; i < src_single.nelems; ++i)
+        {
+            tile_local[i] = Y(i+1);
+        }
+        tile_local.release();
+        auto index_local = index.get_tile(0).acquire(STARPU_W);
+        for(Index j = 0; j < n; ++j)
+        {
+            index_local[j] = nntile::int64_t(index_values[j]);
+        }
+        index_local.release();
+    }
+    // Scatter source tensor
+    TensorTraits src_traits(shape, basetile);
+    std::vector<int> src_distr(src_traits.grid.nelems);
+    for(Index i = 0; i < src_traits.grid.nelems; ++i)
+    {
+        src_distr[i] = (i+1) % mpi_size;
+    }
+    Tensor<T> src(src_traits, src_distr, last_tag);
+    scatter<T>(src_single, src);
+    // Generate distributed destination tensor
+    std::vector<Index> dst_shape(shape), dst_basetile(basetile);
+    dst_shape[axis] = n;
+    dst_basetile[axis] = n;
+    TensorTraits dst_traits(dst_shape, dst_basetile);
+    std::vector<int> dst_distr(dst_traits.grid.nelems);
+    for(Index i = 0; i < dst_traits.grid.nelems; ++i)
+    {
+        dst_distr[i] = (i*i+1) % mpi_size;
+    }
+    Tensor<T> dst(dst_traits, dst_distr, last_tag);
+    index_select<T>(index, src, dst, axis);
+    // Gather results
+    TensorTraits dst_single_traits(dst_shape, dst_shape);
+    Tensor<T> dst_single(dst_single_traits, dist_root, last_tag);
+    gather<T>(dst, dst_single);
+    // Compare against explicit selection
+    if(mpi_rank == mpi_root)
+    {
+        auto src_local = src_single.get_tile(0).acquire(STARPU_R);
+        auto dst_local = dst_single.get_tile(0).acquire(STARPU_R);
+        auto &src_traits_single = src_single.get_tile_traits(0);
+        Index m = src_traits_single.stride[axis];
+        Index k = src_traits_single.matrix_shape[axis+1][1];
+        Index src_n = shape[axis];
+        for(Index l = 0; l < k; ++l)
+        {
+            for(Index j = 0; j < n; ++j)
+            {
+                for(Index i = 0; i < m; ++i)
+                {
+                    TEST_ASSERT(Y(dst_local[(l*n+j)*m+i])
+                            == Y(src_local[(l*src_n+index_values[j])*m+i]));
+                }
+            }
+        }
+        src_local.release();
+        dst_local.release();
+    }
+}
+
+template<typename T>
+void validate()
+{
+    check<T>({5}, {5}, 0, {4, 0, 0, 2});
+    check<T>({5, 4, 6}, {2, 4, 3}, 1, {3, 1, 1, 0, 2});
+    check<T>({5, 4, 6}, {5, 2, 6}, 2, {5, 5, 5});
+    check<T>({5, 4, 1}, {2, 3, 1}, 2, {0, 0, 0, 0});
+    // Sync to guarantee old data tags are cleaned up and can be reused
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Check throwing exceptions
+    starpu_mpi_tag_t last_tag = 0;
+    std::vector<Index> sh34 = {3, 4}, sh32 = {3, 2}, sh22 = {2, 2},
+        sh2 = {2}, sh3 = {3}, sh1 = {1}, sh44 = {4, 4};
+    TensorTraits trA(sh34, sh34), trB(sh32, sh32), trC(sh34, sh32),
+        trD(sh32, sh22), trI2(sh2, sh2), trI3(sh3, sh3),
+        trI21(sh2, sh1), trF(sh44, sh44);
+    std::vector<int> dist0 = {0}, dist00 = {0, 0};
+    Tensor<T> A(trA, dist0, last_tag), B(trB, dist0, last_tag),
+        C(trC, dist00, last_tag), D(trD, dist00, last_tag),
+        F(trF, dist0, last_tag);
+    Tensor<nntile::int64_t> I2(trI2, dist0, last_tag),
+        I3(trI3, dist0, last_tag), I21(trI21, dist00, last_tag);
+    TEST_THROW(index_select<T>(I2, A, B, -1));
+    TEST_THROW(index_select<T>(I2, A, B, 2));
+    TEST_THROW(index_select<T>(I2, A, F, 1));
+    TEST_THROW(index_select<T>(I2, C, B, 1));
+    TEST_THROW(index_select<T>(I2, A, D, 1));
+    TEST_THROW(index_select<T>(I3, A, B, 1));
+    TEST_THROW(index_select<T>(I21, A, B, 1));
+}
+
+int main(int argc, char **argv)
+{
+    // Init StarPU for testing on CPU only
+    starpu::Config starpu(1, 0, 0);
+    // Init codelet
+    starpu::index_select::init();
+    starpu::subcopy::init();
+    starpu::copy::init();
+    starpu::index_select::restrict_where(STARPU_CPU);
+    starpu::subcopy::restrict_where(STARPU_CPU);
+    starpu::copy::restrict_where(STARPU_CPU);
+    // Launch all tests
+    validate<fp32_t>();
+    validate<fp64_t>();
+    return 0;
+}
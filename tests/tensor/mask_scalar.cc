@@ -13,19 +13,36 @@
  * */
 
 #include "nntile/tensor/mask_scalar.hh"
+#include "nntile/tensor/mask_tile_status.hh"
 #include "nntile/tile/mask_scalar.hh"
 #include "nntile/starpu/mask_scalar.hh"
 #include "nntile/tensor/gather.hh"
 #include "nntile/tensor/scatter.hh"
 #include "nntile/starpu/subcopy.hh"
 #include "nntile/starpu/copy.hh"
+#include "nntile/starpu/fill.hh"
 #include "../testing.hh"
+#include <algorithm>
 
 using namespace nntile;
 using namespace nntile::tensor;
 
+// Original mask of this test, that keeps almost all elements
+static bool mask_keep_sparse(Index i, Index j)
+{
+    return !(i+j % 2 == 0);
+}
+
+// Causal mask: key i is kept for query j if it is not in the future, so tiles
+// below the diagonal are entirely masked out and tiles above it are kept
+static bool mask_keep_causal(Index i, Index j)
+{
+    return i <= j;
+}
+
 template<typename T>
-void check(const std::vector<Index> &shape, const std::vector<Index> &basetile)
+void check(const std::vector<Index> &shape, const std::vector<Index> &basetile,
+        bool (*mask_keep)(Index, Index))
 {
     using Y = typename T::repr_t;
     // Barrier to wait for cleanup of previously used tags
@@ -58,14 +75,7 @@ void check(const std::vector<Index> &shape, const std::vector<Index> &basetile)
         {
             for(Index j = 0; j < shape[1]; ++j)
             {
-                if(i+j % 2 == 0)
-                {
-                    tile_mask_local[j*shape[0]+i] = bool_t(false);
-                }
-                else
-                {
-                    tile_mask_local[j*shape[0]+i] = bool_t(true);
-                }
+                tile_mask_local[j*shape[0]+i] = bool_t(mask_keep(i, j));
             }
         }
         tile_mask_local.release();
@@ -114,14 +124,88 @@ void check(const std::vector<Index> &shape, const std::vector<Index> &basetile)
         tile_local.release();
         tile2_local.release();
     }
+    // Check that skipping tiles according to their statuses does not change
+    // the result
+    std::vector<int> mask_tile_status(mask_traits.grid.nelems);
+    for(Index t = 0; t < mask_traits.grid.nelems; ++t)
+    {
+        auto tile_index = mask_traits.grid.linear_to_index(t);
+        auto tile_traits = mask.get_tile_traits(t);
+        Index nkeep = 0;
+        for(Index i = 0; i < tile_traits.shape[0]; ++i)
+        {
+            for(Index j = 0; j < tile_traits.shape[1]; ++j)
+            {
+                Index gi = tile_index[0]*basetile[0] + i;
+                Index gj = tile_index[1]*basetile[1] + j;
+                if(mask_keep(gi, gj))
+                {
+                    ++nkeep;
+                }
+            }
+        }
+        if(nkeep == 0)
+        {
+            mask_tile_status[t] = MASK_TILE_EMPTY;
+        }
+        else if(nkeep == tile_traits.nelems)
+        {
+            mask_tile_status[t] = MASK_TILE_FULL;
+        }
+        else
+        {
+            mask_tile_status[t] = MASK_TILE_PARTIAL;
+        }
+    }
+    // All kinds of tiles of a causal mask are present as soon as the
+    // diagonal is split
+    if(mask_keep == mask_keep_causal && mask_traits.grid.shape[0] > 1
+            && mask_traits.grid.shape[1] > 1)
+    {
+        for(int status: {MASK_TILE_EMPTY, MASK_TILE_PARTIAL, MASK_TILE_FULL})
+        {
+            TEST_ASSERT(std::count(mask_tile_status.begin(),
+                        mask_tile_status.end(), status) > 0);
+        }
+    }
+    Tensor<T> data3_single(data_single_traits, dist_root, last_tag);
+    if(mpi_rank == mpi_root)
+    {
+        auto tile = data3_single.get_tile(0);
+        auto tile_local = tile.acquire(STARPU_W);
+        for(Index i = 0; i < tile.nelems; ++i)
+        {
+            tile_local[i] = Y(i);
+        }
+        tile_local.release();
+    }
+    Tensor<T> dst3(dst_traits, dst_distr, last_tag);
+    scatter<T>(data3_single, dst3);
+    mask_scalar<T>(mask, val, dst3, 1, mask_tile_status);
+    gather<T>(dst3, data3_single);
+    if(mpi_rank == mpi_root)
+    {
+        auto tile = data_single.get_tile(0);
+        auto tile3 = data3_single.get_tile(0);
+        auto tile_local = tile.acquire(STARPU_R);
+        auto tile3_local = tile3.acquire(STARPU_R);
+        for(Index i = 0; i < dst_traits.nelems; ++i)
+        {
+            TEST_ASSERT(Y(tile_local[i]) == Y(tile3_local[i]));
+        }
+        tile_local.release();
+        tile3_local.release();
+    }
 }
 
 template<typename T>
 void validate()
 {
     // check<T>({}, {});
-    check<T>({5, 5, 10}, {5, 5, 10});
-    check<T>({10, 10, 4}, {2, 2, 2});
+    check<T>({5, 5, 10}, {5, 5, 10}, mask_keep_sparse);
+    check<T>({10, 10, 4}, {2, 2, 2}, mask_keep_sparse);
+    check<T>({5, 5, 10}, {5, 5, 10}, mask_keep_causal);
+    check<T>({10, 10, 4}, {2, 2, 2}, mask_keep_causal);
     // Barrier to wait for cleanup of previously used tags
     starpu_mpi_barrier(MPI_COMM_WORLD);
     // No checks that throw exceptions
@@ -135,9 +219,11 @@ int main(int argc, char **argv)
     starpu::mask_scalar::init();
     starpu::subcopy::init();
     starpu::copy::init();
+    starpu::fill::init();
     starpu::mask_scalar::restrict_where(STARPU_CPU);
     starpu::subcopy::restrict_where(STARPU_CPU);
     starpu::copy::restrict_where(STARPU_CPU);
+    starpu::fill::restrict_where(STARPU_CPU);
     // Launch all tests
     validate<fp32_t>();
     validate<fp64_t>();
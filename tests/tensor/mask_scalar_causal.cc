@@ -0,0 +1,133 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/tensor/mask_scalar_causal.cc
+ * Implicit causal mask with scalar for Tensor<T>
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/mask_scalar_causal.hh"
+#include "nntile/starpu/mask_scalar_causal.hh"
+#include "nntile/tensor/gather.hh"
+#include "nntile/tensor/scatter.hh"
+#include "nntile/starpu/subcopy.hh"
+#include "nntile/starpu/copy.hh"
+#include "nntile/starpu/fill.hh"
+#include "../testing.hh"
+
+using namespace nntile;
+using namespace nntile::tensor;
+
+template<typename T>
+void check(const std::vector<Index> &shape, const std::vector<Index> &basetile,
+        Index offset, Index window, Index kv_len)
+{
+    using Y = typename T::repr_t;
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Some preparation
+    Scalar val = -0.5;
+    starpu_mpi_tag_t last_tag = 0;
+    int mpi_size = starpu_mpi_world_size();
+    int mpi_rank = starpu_mpi_world_rank();
+    int mpi_root = 0;
+    // Generate single-tile source tensor
+    TensorTraits single_traits(shape, shape);
+    std::vector<int> dist_root = {mpi_root};
+    Tensor<T> src_single(single_traits, dist_root, last_tag);
+    if(mpi_rank == mpi_root)
+    {
+        auto tile = src_single.get_tile(0);
+        auto tile_local = tile.acquire(STARPU_W);
+        for(Index i = 0; i < tile.nelems; ++i)
+        {
+            tile_local[i] = Y(i+1);
+        }
+        tile_local.release();
+    }
+    // Generate distributed-tile destination tensor
+    TensorTraits dst_traits(shape, basetile);
+    std::vector<int> dst_distr(dst_traits.grid.nelems);
+    for(Index i = 0; i < dst_traits.grid.nelems; ++i)
+    {
+        dst_distr[i] = (i+1) % mpi_size;
+    }
+    Tensor<T> dst(dst_traits, dst_distr, last_tag);
+    scatter<T>(src_single, dst);
+    // Apply implicit mask
+    mask_scalar_causal<T>(offset, window, kv_len, val, dst, dst.ndim-2);
+    // Compare results against explicitly evaluated mask
+    Tensor<T> dst_single(single_traits, dist_root, last_tag);
+    gather<T>(dst, dst_single);
+    if(mpi_rank == mpi_root)
+    {
+        auto tile = dst_single.get_tile(0);
+        auto tile_local = tile.acquire(STARPU_R);
+        Index batch = tile.nelems / shape[0] / shape[1];
+        for(Index b = 0; b < batch; ++b)
+        {
+            for(Index j = 0; j < shape[1]; ++j)
+            {
+                for(Index i = 0; i < shape[0]; ++i)
+                {
+                    Index q = j + offset;
+                    bool keep = i <= q and (window <= 0 or q-i < window)
+                        and (kv_len < 0 or i < kv_len);
+                    Index idx = (b*shape[1]+j)*shape[0] + i;
+                    if(keep)
+                    {
+                        TEST_ASSERT(Y(tile_local[idx]) == Y(idx+1));
+                    }
+                    else
+                    {
+                        TEST_ASSERT(Y(tile_local[idx]) == Y(val));
+                    }
+                }
+            }
+        }
+        tile_local.release();
+    }
+}
+
+template<typename T>
+void validate()
+{
+    check<T>({8, 8, 3}, {8, 8, 3}, 0, 0, -1);
+    check<T>({10, 10, 4}, {3, 3, 2}, 0, 0, -1);
+    check<T>({12, 4, 2, 2}, {4, 2, 1, 2}, 8, 0, -1);
+    check<T>({12, 6, 2}, {5, 4, 2}, 6, 4, -1);
+    check<T>({12, 6, 2}, {5, 4, 2}, 3, 0, 7);
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Check throwing exceptions
+    starpu_mpi_tag_t last_tag = 0;
+    TensorTraits traits({4, 4, 2, 2}, {2, 2, 2, 2});
+    std::vector<int> distr(traits.grid.nelems, 0);
+    Tensor<T> A(traits, distr, last_tag);
+    TEST_THROW(mask_scalar_causal<T>(0, 0, -1, -1.0, A, 1));
+}
+
+int main(int argc, char **argv)
+{
+    // Init StarPU for testing on CPU only
+    starpu::Config starpu(1, 0, 0);
+    // Init codelet
+    starpu::mask_scalar_causal::init();
+    starpu::fill::init();
+    starpu::subcopy::init();
+    starpu::copy::init();
+    starpu::mask_scalar_causal::restrict_where(STARPU_CPU);
+    starpu::fill::restrict_where(STARPU_CPU);
+    starpu::subcopy::restrict_where(STARPU_CPU);
+    starpu::copy::restrict_where(STARPU_CPU);
+    // Launch all tests
+    validate<fp32_t>();
+    validate<fp64_t>();
+    return 0;
+}
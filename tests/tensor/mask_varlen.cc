@@ -0,0 +1,145 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/tensor/mask_varlen.cc
+ * Boolean mask of packed sequences of variable lengths
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/mask_varlen.hh"
+#include "nntile/tensor/mask_tile_status.hh"
+#include "nntile/starpu/mask_varlen.hh"
+#include "nntile/tensor/gather.hh"
+#include "nntile/starpu/subcopy.hh"
+#include "nntile/starpu/copy.hh"
+#include "../testing.hh"
+
+using namespace nntile;
+using namespace nntile::tensor;
+
+// Explicitly evaluated mask element
+bool keep(const std::vector<Index> &cu_k, const std::vector<Index> &cu_q,
+        Index k, Index q)
+{
+    for(std::size_t s = 0; s+1 < cu_k.size(); ++s)
+    {
+        if(k >= cu_k[s] and k < cu_k[s+1] and q >= cu_q[s]
+                and q < cu_q[s+1])
+        {
+            Index shift = (cu_k[s+1]-cu_k[s]) - (cu_q[s+1]-cu_q[s]);
+            return k-cu_k[s] <= q-cu_q[s]+shift;
+        }
+    }
+    return false;
+}
+
+void check(const std::vector<Index> &shape, const std::vector<Index> &basetile,
+        const std::vector<Index> &cu_k, const std::vector<Index> &cu_q)
+{
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Some preparation
+    starpu_mpi_tag_t last_tag = 0;
+    int mpi_size = starpu_mpi_world_size();
+    int mpi_rank = starpu_mpi_world_rank();
+    int mpi_root = 0;
+    // Generate distributed-tile mask
+    TensorTraits traits(shape, basetile);
+    std::vector<int> distr(traits.grid.nelems);
+    for(Index i = 0; i < traits.grid.nelems; ++i)
+    {
+        distr[i] = (i+1) % mpi_size;
+    }
+    Tensor<bool_t> mask(traits, distr, last_tag);
+    mask_varlen(cu_k, cu_q, mask);
+    auto status = mask_varlen_tile_status(cu_k, cu_q, traits);
+    TEST_ASSERT(static_cast<Index>(status.size()) == traits.grid.nelems);
+    // Compare results against explicitly evaluated mask
+    TensorTraits single_traits(shape, shape);
+    std::vector<int> dist_root = {mpi_root};
+    Tensor<bool_t> mask_single(single_traits, dist_root, last_tag);
+    gather<bool_t>(mask, mask_single);
+    if(mpi_rank == mpi_root)
+    {
+        auto tile = mask_single.get_tile(0);
+        auto tile_local = tile.acquire(STARPU_R);
+        std::vector<int> nkept(traits.grid.nelems);
+        for(Index j = 0; j < shape[1]; ++j)
+        {
+            for(Index i = 0; i < shape[0]; ++i)
+            {
+                bool value = bool(tile_local[j*shape[0]+i]);
+                TEST_ASSERT(value == keep(cu_k, cu_q, i, j));
+                Index t = traits.grid.index_to_linear(
+                        {i/basetile[0], j/basetile[1]});
+                nkept[t] += value;
+            }
+        }
+        tile_local.release();
+        for(Index t = 0; t < traits.grid.nelems; ++t)
+        {
+            auto tile_shape = traits.get_tile_shape(
+                    traits.grid.linear_to_index(t));
+            Index tile_nelems = tile_shape[0] * tile_shape[1];
+            if(nkept[t] == 0)
+            {
+                TEST_ASSERT(status[t] == MASK_TILE_EMPTY);
+            }
+            else if(nkept[t] == tile_nelems)
+            {
+                TEST_ASSERT(status[t] == MASK_TILE_FULL);
+            }
+            else
+            {
+                TEST_ASSERT(status[t] == MASK_TILE_PARTIAL);
+            }
+        }
+    }
+}
+
+void validate()
+{
+    // Prefill of three sequences
+    check({16, 16}, {4, 4}, {0, 5, 12, 16}, {0, 5, 12, 16});
+    // Decode of three sequences with padding of keys and queries
+    check({16, 4}, {3, 2}, {0, 5, 12, 13}, {0, 1, 2, 3});
+    // Empty sequence and a few new queries per sequence
+    check({12, 8}, {5, 3}, {0, 3, 3, 10}, {0, 2, 2, 5});
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Check throwing exceptions
+    starpu_mpi_tag_t last_tag = 0;
+    TensorTraits traits({8, 8}, {4, 4});
+    std::vector<int> distr(traits.grid.nelems, 0);
+    Tensor<bool_t> mask(traits, distr, last_tag);
+    TEST_THROW(mask_varlen({0, 4}, {0, 4, 8}, mask));
+    TEST_THROW(mask_varlen({0}, {0}, mask));
+    TEST_THROW(mask_varlen({1, 4}, {0, 4}, mask));
+    TEST_THROW(mask_varlen({0, 4, 2}, {0, 4, 8}, mask));
+    TEST_THROW(mask_varlen({0, 9}, {0, 4}, mask));
+    TEST_THROW(mask_varlen({0, 4}, {0, 9}, mask));
+    TensorTraits traits3({8, 8, 2}, {4, 4, 2});
+    TEST_THROW(mask_varlen_tile_status({0, 4}, {0, 4}, traits3));
+}
+
+int main(int argc, char **argv)
+{
+    // Init StarPU for testing on CPU only
+    starpu::Config starpu(1, 0, 0);
+    // Init codelet
+    starpu::mask_varlen::init();
+    starpu::subcopy::init();
+    starpu::copy::init();
+    starpu::mask_varlen::restrict_where(STARPU_CPU);
+    starpu::subcopy::restrict_where(STARPU_CPU);
+    starpu::copy::restrict_where(STARPU_CPU);
+    // Launch all tests
+    validate();
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/tensor/quantize.cc
+ * Symmetric int8 quantization of a tensor
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/quantize.hh"
+#include "nntile/tensor/dequantize.hh"
+#include "nntile/starpu/quantize.hh"
+#include "nntile/starpu/dequantize.hh"
+#include "nntile/tensor/scatter.hh"
+#include "nntile/tensor/gather.hh"
+#include "nntile/starpu/subcopy.hh"
+#include "nntile/starpu/copy.hh"
+#include "../testing.hh"
+#include <cmath>
+
+using namespace nntile;
+using namespace nntile::tensor;
+
+template<typename T>
+void check(const std::vector<Index> &shape, const std::vector<Index> &basetile)
+{
+    using Y = typename T::repr_t;
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Some preparation
+    starpu_mpi_tag_t last_tag = 0;
+    int mpi_size = starpu_mpi_world_size();
+    int mpi_rank = starpu_mpi_world_rank();
+    int mpi_root = 0;
+    // Generate single-tile source
+    TensorTraits single_traits(shape, shape);
+    std::vector<int> dist_root = {mpi_root};
+    Tensor<T> src_single(single_traits, dist_root, last_tag);
+    Index m = shape[0], n = src_single.nelems / m;
+    if(mpi_rank == mpi_root)
+    {
+        auto src_local = src_single.get_tile(0).acquire(STARPU_W);
+        for(Index i = 0; i < m*n; ++i)
+        {
+            src_local[i] = Y((i%7+1) * std::sin(Y(i)));
+        }
+        src_local.release();
+    }
+    // Scatter source
+    TensorTraits traits(shape, basetile);
+    std::vector<int> distr(traits.grid.nelems);
+    for(Index i = 0; i < traits.grid.nelems; ++i)
+    {
+        distr[i] = (i+1) % mpi_size;
+    }
+    Tensor<T> src(traits, distr, last_tag);
+    scatter<T>(src_single, src);
+    // Quantize on the same nodes, where scales are placed
+    std::vector<Index> scale_shape(shape.begin()+1, shape.end()),
+        scale_basetile(basetile.begin()+1, basetile.end());
+    TensorTraits scale_traits(scale_shape, scale_basetile);
+    std::vector<int> dst_distr(traits.grid.nelems);
+    for(Index i = 0; i < traits.grid.nelems; ++i)
+    {
+        dst_distr[i] = (i*i+1) % mpi_size;
+    }
+    Tensor<nntile::int8_t> dst(traits, dst_distr, last_tag);
+    Tensor<T> scale(scale_traits, dst_distr, last_tag);
+    quantize<T>(src, dst, scale);
+    // Reconstruct and check error against scales of fibers
+    Tensor<T> out(traits, distr, last_tag);
+    dequantize<T>(dst, scale, out);
+    Tensor<T> out_single(single_traits, dist_root, last_tag);
+    TensorTraits scale_single_traits(scale_shape, scale_shape);
+    Tensor<T> scale_single(scale_single_traits, dist_root, last_tag);
+    gather<T>(out, out_single);
+    gather<T>(scale, scale_single);
+    if(mpi_rank == mpi_root)
+    {
+        auto src_local = src_single.get_tile(0).acquire(STARPU_R);
+        auto out_local = out_single.get_tile(0).acquire(STARPU_R);
+        auto scale_local = scale_single.get_tile(0).acquire(STARPU_R);
+        for(Index j = 0; j < n; ++j)
+        {
+            Y amax = 0, s = Y(scale_local[j]);
+            for(Index i = 0; i < m; ++i)
+            {
+                Y diff = Y(out_local[j*m+i]) - Y(src_local[j*m+i]);
+                TEST_ASSERT(std::abs(diff) <= 0.5001*s);
+                amax = std::max(amax, std::abs(Y(src_local[j*m+i])));
+            }
+            TEST_ASSERT(std::abs(s-amax/127) <= 1e-6*amax);
+        }
+        src_local.release();
+        out_local.release();
+        scale_local.release();
+    }
+}
+
+template<typename T>
+void validate()
+{
+    check<T>({4}, {4});
+    check<T>({4, 12}, {4, 5});
+    check<T>({16, 11, 13}, {16, 6, 5});
+    // Sync to guarantee old data tags are cleaned up and can be reused
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Check throwing exceptions
+    starpu_mpi_tag_t last_tag = 0;
+    std::vector<Index> sh34 = {3, 4}, sh23 = {2, 3}, sh4 = {4},
+        sh3 = {3}, sh44 = {4, 4};
+    TensorTraits trA(sh34, sh23), trB(sh34, sh34), trC(sh4, sh4),
+        trD(sh3, sh3), trE(sh44, sh44);
+    std::vector<int> dist0000 = {0, 0, 0, 0}, dist0 = {0};
+    Tensor<T> A(trA, dist0000, last_tag), B(trB, dist0, last_tag),
+        C(trC, dist0, last_tag), D(trD, dist0, last_tag);
+    Tensor<nntile::int8_t> A_q(trA, dist0000, last_tag),
+        B_q(trB, dist0, last_tag), E_q(trE, dist0, last_tag);
+    TEST_THROW(quantize<T>(A, A_q, C));
+    TEST_THROW(quantize<T>(B, B_q, D));
+    TEST_THROW(quantize<T>(B, E_q, C));
+    TEST_THROW(quantize<T>(B, B_q, B));
+}
+
+int main(int argc, char **argv)
+{
+    // Init StarPU for testing on CPU only
+    starpu::Config starpu(1, 0, 0);
+    // Init codelet
+    starpu::quantize::init();
+    starpu::dequantize::init();
+    starpu::subcopy::init();
+    starpu::copy::init();
+    starpu::quantize::restrict_where(STARPU_CPU);
+    starpu::dequantize::restrict_where(STARPU_CPU);
+    starpu::subcopy::restrict_where(STARPU_CPU);
+    starpu::copy::restrict_where(STARPU_CPU);
+    // Launch all tests
+    validate<fp32_t>();
+    validate<fp64_t>();
+    return 0;
+}
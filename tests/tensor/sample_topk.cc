@@ -0,0 +1,137 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/tensor/sample_topk.cc
+ * Sampling of tokens from top-k candidates of Tensor<T>
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/sample_topk.hh"
+#include "nntile/starpu/sample_topk.hh"
+#include "nntile/tensor/scatter.hh"
+#include "nntile/tensor/gather.hh"
+#include "nntile/starpu/subcopy.hh"
+#include "nntile/starpu/copy.hh"
+#include "../testing.hh"
+
+using namespace nntile;
+using namespace nntile::tensor;
+
+template<typename T>
+void check(const std::vector<Index> &shape, const std::vector<Index> &basetile,
+        Scalar temperature, Scalar top_p)
+{
+    using Y = typename T::repr_t;
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Some preparation
+    starpu_mpi_tag_t last_tag = 0;
+    int mpi_size = starpu_mpi_world_size();
+    int mpi_rank = starpu_mpi_world_rank();
+    int mpi_root = 0;
+    // Generate single-tile candidates, sorted in descending order
+    TensorTraits single_traits(shape, shape);
+    std::vector<int> dist_root = {mpi_root};
+    Tensor<T> val_single(single_traits, dist_root, last_tag);
+    Tensor<nntile::int64_t> idx_single(single_traits, dist_root, last_tag);
+    Index k = shape[0], n = val_single.nelems / k;
+    if(mpi_rank == mpi_root)
+    {
+        auto val_local = val_single.get_tile(0).acquire(STARPU_W);
+        auto idx_local = idx_single.get_tile(0).acquire(STARPU_W);
+        for(Index j = 0; j < n; ++j)
+        {
+            for(Index r = 0; r < k; ++r)
+            {
+                val_local[j*k+r] = Y(-10*r);
+                idx_local[j*k+r] = nntile::int64_t(r < k-1 ? j+r : -1);
+            }
+        }
+        val_local.release();
+        idx_local.release();
+    }
+    // Scatter candidates
+    TensorTraits traits(shape, basetile);
+    std::vector<int> distr(traits.grid.nelems);
+    for(Index i = 0; i < traits.grid.nelems; ++i)
+    {
+        distr[i] = (i+1) % mpi_size;
+    }
+    Tensor<T> val(traits, distr, last_tag);
+    Tensor<nntile::int64_t> idx(traits, distr, last_tag);
+    scatter<T>(val_single, val);
+    scatter<nntile::int64_t>(idx_single, idx);
+    // Generate distributed output tensor
+    std::vector<Index> dst_shape(shape.begin()+1, shape.end()),
+        dst_basetile(basetile.begin()+1, basetile.end());
+    TensorTraits dst_traits(dst_shape, dst_basetile);
+    std::vector<int> dst_distr(dst_traits.grid.nelems);
+    for(Index i = 0; i < dst_traits.grid.nelems; ++i)
+    {
+        dst_distr[i] = (i*i+1) % mpi_size;
+    }
+    Tensor<nntile::int64_t> dst(dst_traits, dst_distr, last_tag);
+    sample_topk<T>(temperature, top_p, 1234, val, idx, dst);
+    // Gather result and check that the largest candidates are taken
+    TensorTraits dst_single_traits(dst_shape, dst_shape);
+    Tensor<nntile::int64_t> dst_single(dst_single_traits, dist_root, last_tag);
+    gather<nntile::int64_t>(dst, dst_single);
+    if(mpi_rank == mpi_root)
+    {
+        auto dst_local = dst_single.get_tile(0).acquire(STARPU_R);
+        for(Index j = 0; j < n; ++j)
+        {
+            TEST_ASSERT(Index(dst_local[j]) == j);
+        }
+        dst_local.release();
+    }
+}
+
+template<typename T>
+void validate()
+{
+    check<T>({4}, {4}, 0.0, 1.0);
+    check<T>({4, 12}, {4, 5}, 0.0, 1.0);
+    check<T>({4, 11, 13}, {4, 6, 5}, 1.0, 0.5);
+    check<T>({8, 11, 13}, {8, 4, 4}, 0.5, 0.9);
+    // Sync to guarantee old data tags are cleaned up and can be reused
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Check throwing exceptions
+    starpu_mpi_tag_t last_tag = 0;
+    std::vector<Index> sh34 = {3, 4}, sh23 = {2, 3}, sh4 = {4},
+        sh3 = {3}, sh44 = {4, 4};
+    TensorTraits trA(sh34, sh23), trB(sh34, sh34), trC(sh4, sh4),
+        trD(sh3, sh3), trE(sh44, sh44);
+    std::vector<int> dist0000 = {0, 0, 0, 0}, dist0 = {0};
+    Tensor<T> A(trA, dist0000, last_tag), B(trB, dist0, last_tag);
+    Tensor<nntile::int64_t> A_idx(trA, dist0000, last_tag),
+        B_idx(trB, dist0, last_tag), C(trC, dist0, last_tag),
+        D(trD, dist0, last_tag), E_idx(trE, dist0, last_tag);
+    TEST_THROW(sample_topk<T>(0.0, 1.0, 0, A, A_idx, C));
+    TEST_THROW(sample_topk<T>(0.0, 1.0, 0, B, B_idx, D));
+    TEST_THROW(sample_topk<T>(0.0, 1.0, 0, B, E_idx, C));
+    TEST_THROW(sample_topk<T>(0.0, 1.0, 0, B, B_idx, B_idx));
+}
+
+int main(int argc, char **argv)
+{
+    // Init StarPU for testing on CPU only
+    starpu::Config starpu(1, 0, 0);
+    // Init codelet
+    starpu::sample_topk::init();
+    starpu::subcopy::init();
+    starpu::copy::init();
+    starpu::sample_topk::restrict_where(STARPU_CPU);
+    starpu::subcopy::restrict_where(STARPU_CPU);
+    starpu::copy::restrict_where(STARPU_CPU);
+    // Launch all tests
+    validate<fp32_t>();
+    validate<fp64_t>();
+    return 0;
+}
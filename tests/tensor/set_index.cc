@@ -0,0 +1,146 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/tensor/set_index.cc
+ * Copy a single index along an axis from one Tensor<T> into another
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/set_index.hh"
+#include "nntile/tensor/scatter.hh"
+#include "nntile/tensor/gather.hh"
+#include "nntile/starpu/subcopy.hh"
+#include "nntile/starpu/copy.hh"
+#include "../testing.hh"
+
+using namespace nntile;
+using namespace nntile::tensor;
+
+template<typename T>
+void check(const std::vector<Index> &src_shape,
+        const std::vector<Index> &src_basetile,
+        const std::vector<Index> &dst_shape,
+        const std::vector<Index> &dst_basetile, Index src_index,
+        Index dst_index, Index axis)
+{
+    using Y = typename T::repr_t;
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Some preparation
+    starpu_mpi_tag_t last_tag = 0;
+    int mpi_size = starpu_mpi_world_size();
+    int mpi_rank = starpu_mpi_world_rank();
+    int mpi_root = 0;
+    std::vector<int> dist_root = {mpi_root};
+    // Init single-tile source and destination tensors
+    TensorTraits src_single_traits(src_shape, src_shape),
+                 dst_single_traits(dst_shape, dst_shape);
+    Tensor<T> src_single(src_single_traits, dist_root, last_tag),
+        dst_single(dst_single_traits, dist_root, last_tag);
+    if(mpi_rank == mpi_root)
+    {
+        auto src_local = src_single.get_tile(0).acquire(STARPU_W);
+        for(Index i = 0; i < src_single.nelems; ++i)
+        {
+            src_local[i] = Y(i+1);
+        }
+        src_local.release();
+        auto dst_local = dst_single.get_tile(0).acquire(STARPU_W);
+        for(Index i = 0; i < dst_single.nelems; ++i)
+        {
+            dst_local[i] = Y(-1);
+        }
+        dst_local.release();
+    }
+    // Scatter tensors
+    TensorTraits src_traits(src_shape, src_basetile),
+                 dst_traits(dst_shape, dst_basetile);
+    std::vector<int> src_distr(src_traits.grid.nelems),
+        dst_distr(dst_traits.grid.nelems);
+    for(Index i = 0; i < src_traits.grid.nelems; ++i)
+    {
+        src_distr[i] = (i+1) % mpi_size;
+    }
+    for(Index i = 0; i < dst_traits.grid.nelems; ++i)
+    {
+        dst_distr[i] = (i*i+2) % mpi_size;
+    }
+    Tensor<T> src(src_traits, src_distr, last_tag),
+        dst(dst_traits, dst_distr, last_tag);
+    scatter<T>(src_single, src);
+    scatter<T>(dst_single, dst);
+    // Perform operation and gather result
+    set_index<T>(src, src_index, dst, dst_index, axis);
+    gather<T>(dst, dst_single);
+    if(mpi_rank == mpi_root)
+    {
+        auto dst_local = dst_single.get_tile(0).acquire(STARPU_R);
+        for(Index i = 0; i < dst_single.nelems; ++i)
+        {
+            auto index = dst_single_traits.linear_to_index(i);
+            if(index[axis] == dst_index)
+            {
+                index[axis] = src_index;
+                Index j = src_single_traits.index_to_linear(index);
+                TEST_ASSERT(Y(dst_local[i]) == Y(j+1));
+            }
+            else
+            {
+                TEST_ASSERT(Y(dst_local[i]) == Y(-1));
+            }
+        }
+        dst_local.release();
+    }
+}
+
+template<typename T>
+void validate()
+{
+    check<T>({7}, {3}, {10}, {4}, 6, 9, 0);
+    check<T>({3, 1}, {2, 1}, {20, 1}, {20, 1}, 2, 7, 0);
+    check<T>({5, 1}, {5, 1}, {20, 1}, {8, 1}, 4, 17, 0);
+    check<T>({7, 5, 6}, {3, 2, 4}, {7, 9, 6}, {3, 4, 4}, 3, 8, 1);
+    check<T>({7, 5, 6}, {3, 2, 4}, {7, 5, 1}, {3, 2, 1}, 5, 0, 2);
+    // Sync to guarantee old data tags are cleaned up and can be reused
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Check throwing exceptions
+    starpu_mpi_tag_t last_tag = 0;
+    std::vector<Index> sh34 = {3, 4}, sh23 = {2, 3}, sh33 = {3, 3},
+        sh24 = {2, 4}, sh4 = {4};
+    TensorTraits trA(sh34, sh23), trB(sh24, sh23), trC(sh33, sh23),
+        trD(sh24, sh24), trE(sh4, sh4);
+    std::vector<int> dist0000 = {0, 0, 0, 0}, dist00 = {0, 0},
+        dist0 = {0};
+    Tensor<T> A(trA, dist0000, last_tag), B(trB, dist00, last_tag),
+        C(trC, dist0000, last_tag), D(trD, dist0, last_tag),
+        E(trE, dist0, last_tag);
+    TEST_THROW(set_index<T>(A, 0, E, 0, 0));
+    TEST_THROW(set_index<T>(A, 0, B, 0, -1));
+    TEST_THROW(set_index<T>(A, 0, B, 0, 2));
+    TEST_THROW(set_index<T>(A, 3, B, 0, 0));
+    TEST_THROW(set_index<T>(A, 0, B, 2, 0));
+    TEST_THROW(set_index<T>(A, 0, C, 0, 0));
+    TEST_THROW(set_index<T>(A, 0, D, 0, 0));
+}
+
+int main(int argc, char **argv)
+{
+    // Init StarPU for testing on CPU only
+    starpu::Config starpu(1, 0, 0);
+    // Init codelet
+    starpu::subcopy::init();
+    starpu::copy::init();
+    starpu::subcopy::restrict_where(STARPU_CPU);
+    starpu::copy::restrict_where(STARPU_CPU);
+    // Launch all tests
+    validate<fp32_t>();
+    validate<fp64_t>();
+    validate<nntile::int64_t>();
+    return 0;
+}
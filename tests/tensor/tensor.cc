@@ -87,6 +87,79 @@ void validate()
         TEST_ASSERT(t5d2.get_tile(i).mpi_get_rank() == i+3);
     }
     check<T>(t5d2);
+    // View of leading tiles shares handles with the parent tensor
+    Tensor<T> t5d2_view(t5d2, {2, 4, 1, 3, 2});
+    TEST_ASSERT(t5d2_view.shape == std::vector<Index>({22, 40, 15, 40, 38}));
+    TEST_ASSERT(t5d2_view.basetile_shape == t5d2.basetile_shape);
+    check<T>(t5d2_view);
+    for(Index i = 0; i < t5d2_view.grid.nelems; ++i)
+    {
+        auto tile_index = t5d2_view.grid.linear_to_index(i);
+        auto view_handle = static_cast<starpu_data_handle_t>(
+                t5d2_view.get_tile_handle(i));
+        auto parent_handle = static_cast<starpu_data_handle_t>(
+                t5d2.get_tile_handle(tile_index));
+        TEST_ASSERT(view_handle == parent_handle);
+        TEST_ASSERT(t5d2_view.get_tile(i).mpi_get_rank()
+                == t5d2.get_tile(tile_index).mpi_get_rank());
+    }
+    TEST_THROW(Tensor<T>(t5d2, {2, 4, 1, 3}));
+    TEST_THROW(Tensor<T>(t5d2, {2, 4, 0, 3, 2}));
+    TEST_THROW(Tensor<T>(t5d2, {2, 5, 1, 3, 2}));
+    // View of selected tiles along a dimension
+    TensorTraits pool_traits({5, 12, 7}, {5, 3, 4});
+    std::vector<int> pool_distr(8);
+    for(Index i = 0; i < pool_distr.size(); ++i)
+    {
+        pool_distr[i] = i;
+    }
+    Tensor<T> pool(pool_traits, pool_distr, last_tag);
+    std::vector<Index> table{3, 0, 2};
+    Tensor<T> pool_view(pool, 1, table);
+    TEST_ASSERT(pool_view.shape == std::vector<Index>({5, 9, 7}));
+    check<T>(pool_view);
+    for(Index i = 0; i < pool_view.grid.nelems; ++i)
+    {
+        auto tile_index = pool_view.grid.linear_to_index(i);
+        tile_index[1] = table[tile_index[1]];
+        auto view_handle = static_cast<starpu_data_handle_t>(
+                pool_view.get_tile_handle(i));
+        auto parent_handle = static_cast<starpu_data_handle_t>(
+                pool.get_tile_handle(tile_index));
+        TEST_ASSERT(view_handle == parent_handle);
+        TEST_ASSERT(pool_view.get_tile(i).mpi_get_rank()
+                == pool.get_tile(tile_index).mpi_get_rank());
+    }
+    // The last partial tile may only end a view
+    Tensor<T> pool_tail(pool, 2, {0, 1});
+    TEST_ASSERT(pool_tail.shape == std::vector<Index>({5, 12, 7}));
+    check<T>(pool_tail);
+    Tensor<T> pool_last(pool, 2, {1});
+    TEST_ASSERT(pool_last.shape == std::vector<Index>({5, 12, 3}));
+    check<T>(pool_last);
+    TEST_THROW(Tensor<T>(pool, 3, table));
+    TEST_THROW(Tensor<T>(pool, 2, {1, 0}));
+    TEST_THROW(Tensor<T>(pool, 1, {}));
+    TEST_THROW(Tensor<T>(pool, 1, {4}));
+    // View with unit dimensions removed and inserted
+    Tensor<T> pool_unit(pool_view, {1, 5, 9, 1, 7}, {1, 5, 3, 1, 4});
+    TEST_ASSERT(pool_unit.grid.nelems == pool_view.grid.nelems);
+    for(Index i = 0; i < pool_unit.grid.nelems; ++i)
+    {
+        auto view_handle = static_cast<starpu_data_handle_t>(
+                pool_unit.get_tile_handle(i));
+        auto parent_handle = static_cast<starpu_data_handle_t>(
+                pool_view.get_tile_handle(i));
+        TEST_ASSERT(view_handle == parent_handle);
+        TEST_ASSERT(pool_unit.get_tile_traits(i).nelems
+                == pool_view.get_tile_traits(i).nelems);
+    }
+    Tensor<T> pool_squeezed(pool_unit, {5, 9, 7}, {5, 3, 4});
+    TEST_ASSERT(pool_squeezed.shape == pool_view.shape);
+    TEST_THROW(Tensor<T>(pool_view, {5, 7, 9}, {5, 4, 3}));
+    TEST_THROW(Tensor<T>(pool_view, {5, 9, 7}, {5, 9, 4}));
+    TEST_THROW(Tensor<T>(pool_view, {1, 5, 9, 7}, {2, 5, 3, 4}));
+    TEST_THROW(Tensor<T>(pool_view, {5, 9, 7}, {5, 3}));
 }
 
 int main(int argc, char ** argv)
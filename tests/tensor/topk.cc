@@ -0,0 +1,158 @@
+/*! @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+ *                              (Skoltech), Russia. All rights reserved.
+ *                 2023-present Artificial Intelligence Research Institute
+ *                              (AIRI), Russia. All rights reserved.
+ *
+ * NNTile is software framework for fast training of big neural networks on
+ * distributed-memory heterogeneous systems based on StarPU runtime system.
+ *
+ * @file tests/tensor/topk.cc
+ * Top-k largest elements along the first axis of Tensor<T>
+ *
+ * @version 1.1.0
+ * */
+
+#include "nntile/tensor/topk.hh"
+#include "nntile/starpu/topk.hh"
+#include "nntile/tensor/scatter.hh"
+#include "nntile/tensor/gather.hh"
+#include "nntile/starpu/subcopy.hh"
+#include "nntile/starpu/copy.hh"
+#include "../testing.hh"
+#include <algorithm>
+
+using namespace nntile;
+using namespace nntile::tensor;
+
+template<typename T>
+void check(const std::vector<Index> &shape, const std::vector<Index> &basetile,
+        Index k)
+{
+    using Y = typename T::repr_t;
+    // Barrier to wait for cleanup of previously used tags
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Some preparation
+    starpu_mpi_tag_t last_tag = 0;
+    int mpi_size = starpu_mpi_world_size();
+    int mpi_rank = starpu_mpi_world_rank();
+    int mpi_root = 0;
+    // Generate single-tile source tensor with ties and init it
+    TensorTraits src_single_traits(shape, shape);
+    std::vector<int> dist_root = {mpi_root};
+    Tensor<T> src_single(src_single_traits, dist_root, last_tag);
+    if(mpi_rank == mpi_root)
+    {
+        auto tile = src_single.get_tile(0);
+        auto tile_local = tile.acquire(STARPU_W);
+        for(Index i = 0; i < src_single.nelems; ++i)
+        {
+            tile_local[i] = Y((i*37+11) % 23);
+        }
+        tile_local.release();
+    }
+    // Scatter source tensor
+    TensorTraits src_traits(shape, basetile);
+    std::vector<int> src_distr(src_traits.grid.nelems);
+    for(Index i = 0; i < src_traits.grid.nelems; ++i)
+    {
+        src_distr[i] = (i+1) % mpi_size;
+    }
+    Tensor<T> src(src_traits, src_distr, last_tag);
+    scatter<T>(src_single, src);
+    // Generate distributed dest tensors
+    std::vector<Index> dst_shape(shape), dst_basetile(basetile);
+    dst_shape[0] = k;
+    dst_basetile[0] = k;
+    TensorTraits dst_traits(dst_shape, dst_basetile);
+    std::vector<int> dst_distr(dst_traits.grid.nelems);
+    for(Index i = 0; i < dst_traits.grid.nelems; ++i)
+    {
+        dst_distr[i] = (i*i+1) % mpi_size;
+    }
+    Tensor<T> dst_val(dst_traits, dst_distr, last_tag);
+    Tensor<nntile::int64_t> dst_idx(dst_traits, dst_distr, last_tag);
+    topk<T>(src, dst_val, dst_idx);
+    // Gather results
+    TensorTraits dst_single_traits(dst_shape, dst_shape);
+    Tensor<T> dst_val_single(dst_single_traits, dist_root, last_tag);
+    Tensor<nntile::int64_t> dst_idx_single(dst_single_traits, dist_root,
+            last_tag);
+    gather<T>(dst_val, dst_val_single);
+    gather<nntile::int64_t>(dst_idx, dst_idx_single);
+    // Compare against sorting of the entire fibers
+    if(mpi_rank == mpi_root)
+    {
+        auto src_local = src_single.get_tile(0).acquire(STARPU_R);
+        auto val_local = dst_val_single.get_tile(0).acquire(STARPU_R);
+        auto idx_local = dst_idx_single.get_tile(0).acquire(STARPU_R);
+        Index m = shape[0], n = src_single.nelems / m;
+        for(Index j = 0; j < n; ++j)
+        {
+            std::vector<Index> order(m);
+            for(Index i = 0; i < m; ++i)
+            {
+                order[i] = i;
+            }
+            std::stable_sort(order.begin(), order.end(),
+                    [&](Index a, Index b)
+                    {
+                        return Y(src_local[j*m+a]) > Y(src_local[j*m+b]);
+                    });
+            for(Index r = 0; r < k; ++r)
+            {
+                TEST_ASSERT(Index(idx_local[j*k+r]) == order[r]);
+                TEST_ASSERT(Y(val_local[j*k+r])
+                        == Y(src_local[j*m+order[r]]));
+            }
+        }
+        src_local.release();
+        val_local.release();
+        idx_local.release();
+    }
+}
+
+template<typename T>
+void validate()
+{
+    check<T>({11}, {5}, 1);
+    check<T>({11}, {5}, 7);
+    check<T>({11, 12}, {5, 6}, 3);
+    check<T>({11, 12, 13}, {4, 6, 5}, 11);
+    check<T>({100, 3}, {30, 2}, 10);
+    // Sync to guarantee old data tags are cleaned up and can be reused
+    starpu_mpi_barrier(MPI_COMM_WORLD);
+    // Check throwing exceptions
+    starpu_mpi_tag_t last_tag = 0;
+    std::vector<Index> sh34 = {3, 4}, sh23 = {2, 3}, sh24 = {2, 4},
+        sh44 = {4, 4}, sh22 = {2, 2}, sh4 = {4};
+    TensorTraits trA(sh34, sh23), trB(sh24, sh24), trC(sh44, sh44),
+        trD(sh24, sh22), trE(sh4, sh4);
+    std::vector<int> dist0000 = {0, 0, 0, 0}, dist0 = {0}, dist00 = {0, 0};
+    Tensor<T> A(trA, dist0000, last_tag), B(trB, dist0, last_tag),
+        C(trC, dist0, last_tag), D(trD, dist00, last_tag),
+        E(trE, dist0, last_tag);
+    Tensor<nntile::int64_t> B_idx(trB, dist0, last_tag),
+        C_idx(trC, dist0, last_tag), D_idx(trD, dist00, last_tag),
+        E_idx(trE, dist0, last_tag);
+    TEST_THROW(topk<T>(A, C, C_idx));
+    TEST_THROW(topk<T>(A, E, E_idx));
+    TEST_THROW(topk<T>(A, D, D_idx));
+    TEST_THROW(topk<T>(A, B, D_idx));
+}
+
+int main(int argc, char **argv)
+{
+    // Init StarPU for testing on CPU only
+    starpu::Config starpu(1, 0, 0);
+    // Init codelet
+    starpu::topk::init();
+    starpu::subcopy::init();
+    starpu::copy::init();
+    starpu::topk::restrict_where(STARPU_CPU);
+    starpu::subcopy::restrict_where(STARPU_CPU);
+    starpu::copy::restrict_where(STARPU_CPU);
+    // Launch all tests
+    validate<fp32_t>();
+    validate<fp64_t>();
+    return 0;
+}
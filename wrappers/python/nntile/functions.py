@@ -24,7 +24,8 @@ import nntile.nntile_core.tensor as ops
 from nntile.nntile_core import TransOp, tensor as core_tensor
 from nntile.nntile_core.tensor import (
     Tensor_bf16, Tensor_bool, Tensor_fp32, Tensor_fp32_fast_bf16,
-    Tensor_fp32_fast_fp16, Tensor_fp32_fast_tf32, Tensor_fp64, Tensor_int64)
+    Tensor_fp32_fast_fp16, Tensor_fp32_fast_tf32, Tensor_fp64, Tensor_int8,
+    Tensor_int64, TensorTraits)
 from nntile.types import Tensor, TensorFloatOrInt, TensorOrFloat
 
 T = TypeVar('T')
@@ -92,6 +93,70 @@ def gemm_async(
         raise TypeError
 
 
+# Operand of gemm_gqa_async, that is shared by a group of batches
+GEMM_GQA_BCAST_A = 1
+GEMM_GQA_BCAST_B = 2
+GEMM_GQA_BCAST_C = 3
+
+
+def gemm_gqa_async(
+    alpha: float,
+    trans_A: TransOp,
+    A: Tensor,
+    trans_B: TransOp,
+    B: Tensor,
+    beta: float,
+    C: Tensor,
+    ndim: int,
+    batch_ndim: int,
+    group_dim: int,
+    bcast: int,
+    redux: int = 0,
+) -> None:
+    """
+    Wrapper for multiprecision gemm with an operand shared by a group
+
+    The shared operand (GEMM_GQA_BCAST_A, GEMM_GQA_BCAST_B or
+    GEMM_GQA_BCAST_C) lacks batch dimension group_dim, so grouped-query
+    attention does not need to repeat K and V. Shared C accumulates results
+    over the group.
+    """
+    if type(A) is not type(B) or type(A) is not type(C):
+        raise TypeError
+    if type(A) is core_tensor.Tensor_fp32:
+        core_tensor.gemm_gqa_async_fp32(
+            alpha, trans_A, A, trans_B, B, beta, C, ndim, batch_ndim,
+            group_dim, bcast, redux
+        )
+    elif type(A) is core_tensor.Tensor_fp64:
+        core_tensor.gemm_gqa_async_fp64(
+            alpha, trans_A, A, trans_B, B, beta, C, ndim, batch_ndim,
+            group_dim, bcast, redux
+        )
+    elif type(A) is core_tensor.Tensor_fp32_fast_tf32:
+        core_tensor.gemm_gqa_async_fp32_fast_tf32(
+            alpha, trans_A, A, trans_B, B, beta, C, ndim, batch_ndim,
+            group_dim, bcast, redux
+        )
+    elif type(A) is core_tensor.Tensor_fp32_fast_fp16:
+        core_tensor.gemm_gqa_async_fp32_fast_fp16(
+            alpha, trans_A, A, trans_B, B, beta, C, ndim, batch_ndim,
+            group_dim, bcast, redux
+        )
+    elif type(A) is core_tensor.Tensor_fp32_fast_bf16:
+        core_tensor.gemm_gqa_async_fp32_fast_bf16(
+            alpha, trans_A, A, trans_B, B, beta, C, ndim, batch_ndim,
+            group_dim, bcast, redux
+        )
+    elif type(A) is core_tensor.Tensor_bf16:
+        core_tensor.gemm_gqa_async_bf16(
+            alpha, trans_A, A, trans_B, B, beta, C, ndim, batch_ndim,
+            group_dim, bcast, redux
+        )
+    else:
+        raise TypeError
+
+
 def relu_async(x: Tensor) -> None:
     """
     Wrapper for multiprecision ReLU
@@ -480,9 +545,13 @@ def flash_softmax_gemm_async(
     tmp: Tensor,
     redux: int = 0,
     fp32_fast_tf32: int = 0,
+    mask_tile_status: Sequence[int] = (),
 ) -> None:
     """
     Wrapper for multiprecision fast fused softmax+gemm
+
+    Tiles of K and V, marked as entirely masked out in mask_tile_status, are
+    skipped.
     """
     if type(Q) is not type(K):
         raise TypeError
@@ -496,27 +565,27 @@ def flash_softmax_gemm_async(
         raise TypeError
     if type(Q) is core_tensor.Tensor_fp32:
         core_tensor.flash_softmax_gemm_async_fp32(
-            Q, K, V, mask, maxsumexp, dst, tmp, redux
+            Q, K, V, mask, maxsumexp, dst, tmp, redux, mask_tile_status
         )
     elif type(Q) is core_tensor.Tensor_fp32_fast_tf32:
         core_tensor.flash_softmax_gemm_async_fp32_fast_tf32(
-            Q, K, V, mask, maxsumexp, dst, tmp, redux
+            Q, K, V, mask, maxsumexp, dst, tmp, redux, mask_tile_status
         )
     elif type(Q) is core_tensor.Tensor_fp32_fast_fp16:
         core_tensor.flash_softmax_gemm_async_fp32_fast_fp16(
-            Q, K, V, mask, maxsumexp, dst, tmp, redux
+            Q, K, V, mask, maxsumexp, dst, tmp, redux, mask_tile_status
         )
     elif type(Q) is core_tensor.Tensor_fp32_fast_bf16:
         core_tensor.flash_softmax_gemm_async_fp32_fast_bf16(
-            Q, K, V, mask, maxsumexp, dst, tmp, redux
+            Q, K, V, mask, maxsumexp, dst, tmp, redux, mask_tile_status
         )
     elif type(Q) is core_tensor.Tensor_fp64:
         core_tensor.flash_softmax_gemm_async_fp64(
-            Q, K, V, mask, maxsumexp, dst, tmp, redux
+            Q, K, V, mask, maxsumexp, dst, tmp, redux, mask_tile_status
         )
     elif type(Q) is core_tensor.Tensor_bf16:
         core_tensor.flash_softmax_gemm_async_bf16(
-            Q, K, V, mask, maxsumexp, dst, tmp, redux
+            Q, K, V, mask, maxsumexp, dst, tmp, redux, mask_tile_status
         )
     else:
         raise TypeError
@@ -536,6 +605,7 @@ def flash_softmax_gemm_backward_async(
     tmp_grad: Tensor,
     tmp_sumprod_slice: Tensor,
     redux: int = 0,
+    mask_tile_status: Sequence[int] = (),
 ) -> None:
     """
     Wrapper for multiprecision fast fused softmax+gemm
@@ -575,6 +645,7 @@ def flash_softmax_gemm_backward_async(
             tmp_grad,
             tmp_sumprod_slice,
             redux,
+            mask_tile_status,
         )
     elif type(Q) is core_tensor.Tensor_fp32_fast_tf32:
         core_tensor.flash_softmax_gemm_backward_async_fp32_fast_tf32(
@@ -591,6 +662,7 @@ def flash_softmax_gemm_backward_async(
             tmp_grad,
             tmp_sumprod_slice,
             redux,
+            mask_tile_status,
         )
     elif type(Q) is core_tensor.Tensor_fp32_fast_fp16:
         core_tensor.flash_softmax_gemm_backward_async_fp32_fast_fp16(
@@ -607,6 +679,7 @@ def flash_softmax_gemm_backward_async(
             tmp_grad,
             tmp_sumprod_slice,
             redux,
+            mask_tile_status,
         )
     elif type(Q) is core_tensor.Tensor_fp32_fast_bf16:
         core_tensor.flash_softmax_gemm_backward_async_fp32_fast_bf16(
@@ -623,6 +696,7 @@ def flash_softmax_gemm_backward_async(
             tmp_grad,
             tmp_sumprod_slice,
             redux,
+            mask_tile_status,
         )
     elif type(Q) is core_tensor.Tensor_fp64:
         core_tensor.flash_softmax_gemm_backward_async_fp64(
@@ -639,6 +713,7 @@ def flash_softmax_gemm_backward_async(
             tmp_grad,
             tmp_sumprod_slice,
             redux,
+            mask_tile_status,
         )
     elif type(Q) is core_tensor.Tensor_bf16:
         core_tensor.flash_softmax_gemm_backward_async_bf16(
@@ -655,6 +730,7 @@ def flash_softmax_gemm_backward_async(
             tmp_grad,
             tmp_sumprod_slice,
             redux,
+            mask_tile_status,
         )
     else:
         raise TypeError
@@ -885,6 +961,7 @@ def flash_maxsumexp_async(
     maxsumexp: Tensor,
     tmp: Tensor,
     redux: int = 0,
+    mask_tile_status: Sequence[int] = (),
 ) -> None:
     """
     Wrapper for multiprecision fast maxsumexp
@@ -897,27 +974,27 @@ def flash_maxsumexp_async(
         raise TypeError
     if type(Q) is core_tensor.Tensor_fp32:
         core_tensor.flash_maxsumexp_async_fp32(
-            Q, K, mask, maxsumexp, tmp, redux
+            Q, K, mask, maxsumexp, tmp, redux, mask_tile_status
         )
     elif type(Q) is core_tensor.Tensor_fp32_fast_tf32:
         core_tensor.flash_maxsumexp_async_fp32_fast_tf32(
-            Q, K, mask, maxsumexp, tmp, redux
+            Q, K, mask, maxsumexp, tmp, redux, mask_tile_status
         )
     elif type(Q) is core_tensor.Tensor_fp32_fast_fp16:
         core_tensor.flash_maxsumexp_async_fp32_fast_fp16(
-            Q, K, mask, maxsumexp, tmp, redux
+            Q, K, mask, maxsumexp, tmp, redux, mask_tile_status
         )
     elif type(Q) is core_tensor.Tensor_fp32_fast_bf16:
         core_tensor.flash_maxsumexp_async_fp32_fast_bf16(
-            Q, K, mask, maxsumexp, tmp, redux
+            Q, K, mask, maxsumexp, tmp, redux, mask_tile_status
         )
     elif type(Q) is core_tensor.Tensor_fp64:
         core_tensor.flash_maxsumexp_async_fp64(
-            Q, K, mask, maxsumexp, tmp, redux
+            Q, K, mask, maxsumexp, tmp, redux, mask_tile_status
         )
     elif type(Q) is core_tensor.Tensor_bf16:
         core_tensor.flash_maxsumexp_async_bf16(
-            Q, K, mask, maxsumexp, tmp, redux
+            Q, K, mask, maxsumexp, tmp, redux, mask_tile_status
         )
     else:
         raise TypeError
@@ -1202,6 +1279,32 @@ def copy_intersection_async(
         core_tensor.copy_intersection_async_int64(x, x_offset, y, y_offset)
     elif type(x) is core_tensor.Tensor_bool:
         core_tensor.copy_intersection_async_bool(x, x_offset, y, y_offset)
+    elif type(x) is core_tensor.Tensor_int8:
+        core_tensor.copy_intersection_async_int8(x, x_offset, y, y_offset)
+    else:
+        raise TypeError
+
+
+def set_index_async(
+    x: TensorFloatOrInt, x_index: int, y: TensorFloatOrInt, y_index: int,
+    axis: int
+) -> None:
+    """
+    Wrapper for multiprecision set_index
+
+    Slice of x at index x_index along axis is copied into the slice of y at
+    index y_index, e.g., to append a sampled token to a sequence on device.
+    """
+    if type(x) is not type(y):
+        raise TypeError
+    if type(x) is core_tensor.Tensor_fp32:
+        core_tensor.set_index_async_fp32(x, x_index, y, y_index, axis)
+    elif type(x) is core_tensor.Tensor_fp64:
+        core_tensor.set_index_async_fp64(x, x_index, y, y_index, axis)
+    elif type(x) is core_tensor.Tensor_int64:
+        core_tensor.set_index_async_int64(x, x_index, y, y_index, axis)
+    elif type(x) is core_tensor.Tensor_bool:
+        core_tensor.set_index_async_bool(x, x_index, y, y_index, axis)
     else:
         raise TypeError
 
@@ -1536,24 +1639,308 @@ def scal_inplace_async(alpha: float, x: Tensor) -> None:
 
 
 def mask_scalar_async(mask: Tensor_bool, alpha: float, x: Tensor,
-                      batch_ndim: int) -> None:
+                      batch_ndim: int,
+                      mask_tile_status: Sequence[int] = ()) -> None:
     """Wrapper for multiprecision scaling."""
     if isinstance(x, Tensor_bf16):
-        ops.mask_scalar_async_bf16(mask, alpha, x, batch_ndim)
+        ops.mask_scalar_async_bf16(mask, alpha, x, batch_ndim,
+                                   mask_tile_status)
     elif isinstance(x, Tensor_fp32):
-        ops.mask_scalar_async_fp32(mask, alpha, x, batch_ndim)
+        ops.mask_scalar_async_fp32(mask, alpha, x, batch_ndim,
+                                   mask_tile_status)
     elif isinstance(x, Tensor_fp32_fast_tf32):
-        ops.mask_scalar_async_fp32_fast_tf32(mask, alpha, x, batch_ndim)
+        ops.mask_scalar_async_fp32_fast_tf32(mask, alpha, x, batch_ndim,
+                                             mask_tile_status)
     elif isinstance(x, Tensor_fp32_fast_fp16):
-        ops.mask_scalar_async_fp32_fast_fp16(mask, alpha, x, batch_ndim)
+        ops.mask_scalar_async_fp32_fast_fp16(mask, alpha, x, batch_ndim,
+                                             mask_tile_status)
     elif isinstance(x, Tensor_fp32_fast_bf16):
-        ops.mask_scalar_async_fp32_fast_bf16(mask, alpha, x, batch_ndim)
+        ops.mask_scalar_async_fp32_fast_bf16(mask, alpha, x, batch_ndim,
+                                             mask_tile_status)
     elif isinstance(x, Tensor_fp64):
-        ops.mask_scalar_async_fp64(mask, alpha, x, batch_ndim)
+        ops.mask_scalar_async_fp64(mask, alpha, x, batch_ndim,
+                                   mask_tile_status)
     else:
         raise TypeError('Wrong tensor type {type(x)}.')
 
 
+def mask_scalar_causal_async(offset: int, window: int, kv_len: int,
+                             alpha: float, x: Tensor,
+                             batch_ndim: int) -> None:
+    """Wrapper for multiprecision implicit causal mask.
+
+    Key k is masked out for query q, if k > q+offset, q+offset-k >= window
+    (only if window > 0) or k >= kv_len (only if kv_len >= 0). The mask itself
+    is never stored in memory.
+    """
+    if isinstance(x, Tensor_bf16):
+        ops.mask_scalar_causal_async_bf16(offset, window, kv_len, alpha, x,
+                                          batch_ndim)
+    elif isinstance(x, Tensor_fp32):
+        ops.mask_scalar_causal_async_fp32(offset, window, kv_len, alpha, x,
+                                          batch_ndim)
+    elif isinstance(x, Tensor_fp32_fast_tf32):
+        ops.mask_scalar_causal_async_fp32_fast_tf32(offset, window, kv_len,
+                                                    alpha, x, batch_ndim)
+    elif isinstance(x, Tensor_fp32_fast_fp16):
+        ops.mask_scalar_causal_async_fp32_fast_fp16(offset, window, kv_len,
+                                                    alpha, x, batch_ndim)
+    elif isinstance(x, Tensor_fp32_fast_bf16):
+        ops.mask_scalar_causal_async_fp32_fast_bf16(offset, window, kv_len,
+                                                    alpha, x, batch_ndim)
+    elif isinstance(x, Tensor_fp64):
+        ops.mask_scalar_causal_async_fp64(offset, window, kv_len, alpha, x,
+                                          batch_ndim)
+    else:
+        raise TypeError('Wrong tensor type {type(x)}.')
+
+
+def mask_varlen_async(cu_seqlens_k: Sequence[int],
+                      cu_seqlens_q: Sequence[int], mask: Tensor) -> None:
+    """Boolean mask of several sequences packed one after another.
+
+    Sequence s takes keys [cu_seqlens_k[s], cu_seqlens_k[s+1]) and queries
+    [cu_seqlens_q[s], cu_seqlens_q[s+1]). A query sees only keys of its own
+    sequence, that are not in its future, while queries are aligned to the
+    last keys of the sequence. Use mask_varlen_tile_status to skip tiles with
+    keys and queries of different sequences.
+    """
+    if isinstance(mask, Tensor_bool):
+        ops.mask_varlen_async(cu_seqlens_k, cu_seqlens_q, mask)
+    else:
+        raise TypeError(f'Wrong tensor type {type(mask)}.')
+
+
+def mask_varlen_tile_status(cu_seqlens_k: Sequence[int],
+                            cu_seqlens_q: Sequence[int],
+                            mask: TensorTraits) -> list[int]:
+    """Status of every tile of a boolean mask of packed sequences."""
+    return ops.mask_varlen_tile_status(cu_seqlens_k, cu_seqlens_q, mask)
+
+
+def topk_async(src: Tensor, dst_val: Tensor, dst_idx: Tensor_int64) -> None:
+    """Wrapper for multiprecision top-k along the first axis.
+
+    Largest values of src along the first axis (e.g., logits along vocabulary)
+    are stored in descending order into dst_val, while their indices are
+    stored into dst_idx. The number of values k is dst_val.shape[0]. Tiles of
+    src along the first axis are reduced one after another, so only k values
+    per fiber leave a tile.
+    """
+    if type(src) is not type(dst_val):
+        raise TypeError
+    if isinstance(src, Tensor_bf16):
+        ops.topk_async_bf16(src, dst_val, dst_idx)
+    elif isinstance(src, Tensor_fp32):
+        ops.topk_async_fp32(src, dst_val, dst_idx)
+    elif isinstance(src, Tensor_fp32_fast_tf32):
+        ops.topk_async_fp32_fast_tf32(src, dst_val, dst_idx)
+    elif isinstance(src, Tensor_fp32_fast_fp16):
+        ops.topk_async_fp32_fast_fp16(src, dst_val, dst_idx)
+    elif isinstance(src, Tensor_fp32_fast_bf16):
+        ops.topk_async_fp32_fast_bf16(src, dst_val, dst_idx)
+    elif isinstance(src, Tensor_fp64):
+        ops.topk_async_fp64(src, dst_val, dst_idx)
+    else:
+        raise TypeError(f'Wrong tensor type {type(src)}.')
+
+
+def sample_topk_async(temperature: float, top_p: float, seed: int,
+                      val: Tensor, idx: Tensor_int64,
+                      dst: Tensor_int64) -> None:
+    """Wrapper for multiprecision sampling from top-k candidates.
+
+    Candidates are given by outputs of topk_async. A token is sampled with
+    probability proportional to exp(val/temperature) out of the smallest
+    prefix of candidates with the total probability of at least top_p. If
+    temperature is not positive, the largest candidate is taken.
+    """
+    if isinstance(val, Tensor_bf16):
+        ops.sample_topk_async_bf16(temperature, top_p, seed, val, idx, dst)
+    elif isinstance(val, Tensor_fp32):
+        ops.sample_topk_async_fp32(temperature, top_p, seed, val, idx, dst)
+    elif isinstance(val, Tensor_fp32_fast_tf32):
+        ops.sample_topk_async_fp32_fast_tf32(temperature, top_p, seed, val,
+                                             idx, dst)
+    elif isinstance(val, Tensor_fp32_fast_fp16):
+        ops.sample_topk_async_fp32_fast_fp16(temperature, top_p, seed, val,
+                                             idx, dst)
+    elif isinstance(val, Tensor_fp32_fast_bf16):
+        ops.sample_topk_async_fp32_fast_bf16(temperature, top_p, seed, val,
+                                             idx, dst)
+    elif isinstance(val, Tensor_fp64):
+        ops.sample_topk_async_fp64(temperature, top_p, seed, val, idx, dst)
+    else:
+        raise TypeError(f'Wrong tensor type {type(val)}.')
+
+
+def quantize_async(src: Tensor, dst: Tensor_int8, scale: Tensor) -> None:
+    """Wrapper for multiprecision int8 quantization along the first axis.
+
+    Every fiber of src along the first axis (e.g., a head of a token of keys)
+    is stored into dst as int8 values with its own scale of shape
+    src.shape[1:], so that src is approximated by dst*scale.
+    """
+    if type(src) is not type(scale):
+        raise TypeError
+    if isinstance(src, Tensor_bf16):
+        ops.quantize_async_bf16(src, dst, scale)
+    elif isinstance(src, Tensor_fp32):
+        ops.quantize_async_fp32(src, dst, scale)
+    elif isinstance(src, Tensor_fp32_fast_tf32):
+        ops.quantize_async_fp32_fast_tf32(src, dst, scale)
+    elif isinstance(src, Tensor_fp32_fast_fp16):
+        ops.quantize_async_fp32_fast_fp16(src, dst, scale)
+    elif isinstance(src, Tensor_fp32_fast_bf16):
+        ops.quantize_async_fp32_fast_bf16(src, dst, scale)
+    elif isinstance(src, Tensor_fp64):
+        ops.quantize_async_fp64(src, dst, scale)
+    else:
+        raise TypeError(f'Wrong tensor type {type(src)}.')
+
+
+def dequantize_async(src: Tensor_int8, scale: Tensor, dst: Tensor) -> None:
+    """Wrapper for multiprecision dequantization of outputs of quantize_async.
+    """
+    if type(scale) is not type(dst):
+        raise TypeError
+    if isinstance(dst, Tensor_bf16):
+        ops.dequantize_async_bf16(src, scale, dst)
+    elif isinstance(dst, Tensor_fp32):
+        ops.dequantize_async_fp32(src, scale, dst)
+    elif isinstance(dst, Tensor_fp32_fast_tf32):
+        ops.dequantize_async_fp32_fast_tf32(src, scale, dst)
+    elif isinstance(dst, Tensor_fp32_fast_fp16):
+        ops.dequantize_async_fp32_fast_fp16(src, scale, dst)
+    elif isinstance(dst, Tensor_fp32_fast_bf16):
+        ops.dequantize_async_fp32_fast_bf16(src, scale, dst)
+    elif isinstance(dst, Tensor_fp64):
+        ops.dequantize_async_fp64(src, scale, dst)
+    else:
+        raise TypeError(f'Wrong tensor type {type(dst)}.')
+
+
+def pack_panels_async(src: Tensor, dst: Tensor, ndim: int) -> None:
+    """Wrapper for multiprecision packing of tiles of src into panels of rows.
+
+    The output is meant only for gemm_packed_async with the same ndim.
+    """
+    if type(src) is not type(dst):
+        raise TypeError
+    if isinstance(dst, Tensor_bf16):
+        ops.pack_panels_async_bf16(src, dst, ndim)
+    elif isinstance(dst, Tensor_fp32):
+        ops.pack_panels_async_fp32(src, dst, ndim)
+    elif isinstance(dst, Tensor_fp32_fast_tf32):
+        ops.pack_panels_async_fp32_fast_tf32(src, dst, ndim)
+    elif isinstance(dst, Tensor_fp32_fast_fp16):
+        ops.pack_panels_async_fp32_fast_fp16(src, dst, ndim)
+    elif isinstance(dst, Tensor_fp32_fast_bf16):
+        ops.pack_panels_async_fp32_fast_bf16(src, dst, ndim)
+    elif isinstance(dst, Tensor_fp64):
+        ops.pack_panels_async_fp64(src, dst, ndim)
+    else:
+        raise TypeError(f'Wrong tensor type {type(dst)}.')
+
+
+def gemm_packed_async(
+    alpha: float,
+    A: Tensor,
+    trans_B: TransOp,
+    B: Tensor,
+    beta: float,
+    C: Tensor,
+    ndim: int,
+    redux: int = 0,
+) -> None:
+    """Wrapper for multiprecision gemm by a tensor A, that is packed by
+    pack_panels_async. Tasks are executed only on CPU.
+    """
+    if type(A) is not type(B) or type(A) is not type(C):
+        raise TypeError
+    if isinstance(A, Tensor_bf16):
+        ops.gemm_packed_async_bf16(
+            alpha, A, trans_B, B, beta, C, ndim, redux
+        )
+    elif isinstance(A, Tensor_fp32):
+        ops.gemm_packed_async_fp32(
+            alpha, A, trans_B, B, beta, C, ndim, redux
+        )
+    elif isinstance(A, Tensor_fp32_fast_tf32):
+        ops.gemm_packed_async_fp32_fast_tf32(
+            alpha, A, trans_B, B, beta, C, ndim, redux
+        )
+    elif isinstance(A, Tensor_fp32_fast_fp16):
+        ops.gemm_packed_async_fp32_fast_fp16(
+            alpha, A, trans_B, B, beta, C, ndim, redux
+        )
+    elif isinstance(A, Tensor_fp32_fast_bf16):
+        ops.gemm_packed_async_fp32_fast_bf16(
+            alpha, A, trans_B, B, beta, C, ndim, redux
+        )
+    elif isinstance(A, Tensor_fp64):
+        ops.gemm_packed_async_fp64(
+            alpha, A, trans_B, B, beta, C, ndim, redux
+        )
+    else:
+        raise TypeError(f'Wrong tensor type {type(A)}.')
+
+
+def beam_topk_async(src: Tensor, dst_val: Tensor, dst_idx: Tensor_int64,
+                    dst_beam: Tensor_int64) -> None:
+    """Wrapper for multiprecision top-k over all beams.
+
+    The k largest elements among all elements of src of shape
+    (vocab_size, ..., num_beams) are stored in descending order into dst_val
+    together with their tokens (indices along the first axis) in dst_idx and
+    their beams (flattened indices along other axes) in dst_beam. Outputs
+    are single-tile tensors of k elements each.
+    """
+    if type(src) is not type(dst_val):
+        raise TypeError
+    if isinstance(src, Tensor_bf16):
+        ops.beam_topk_async_bf16(src, dst_val, dst_idx, dst_beam)
+    elif isinstance(src, Tensor_fp32):
+        ops.beam_topk_async_fp32(src, dst_val, dst_idx, dst_beam)
+    elif isinstance(src, Tensor_fp32_fast_tf32):
+        ops.beam_topk_async_fp32_fast_tf32(src, dst_val, dst_idx, dst_beam)
+    elif isinstance(src, Tensor_fp32_fast_fp16):
+        ops.beam_topk_async_fp32_fast_fp16(src, dst_val, dst_idx, dst_beam)
+    elif isinstance(src, Tensor_fp32_fast_bf16):
+        ops.beam_topk_async_fp32_fast_bf16(src, dst_val, dst_idx, dst_beam)
+    elif isinstance(src, Tensor_fp64):
+        ops.beam_topk_async_fp64(src, dst_val, dst_idx, dst_beam)
+    else:
+        raise TypeError(f'Wrong tensor type {type(src)}.')
+
+
+def index_select_async(index: Tensor_int64, src: TensorFloatOrInt,
+                       dst: TensorFloatOrInt, axis: int) -> None:
+    """Wrapper for multiprecision selection of slices by indices.
+
+    Slice j of dst along axis is a copy of slice index[j] of src, e.g., to
+    reorder caches of beams by their parents. Indices are read on device.
+    """
+    if type(src) is not type(dst):
+        raise TypeError
+    if isinstance(src, Tensor_bf16):
+        ops.index_select_async_bf16(index, src, dst, axis)
+    elif isinstance(src, Tensor_fp32):
+        ops.index_select_async_fp32(index, src, dst, axis)
+    elif isinstance(src, Tensor_fp32_fast_tf32):
+        ops.index_select_async_fp32_fast_tf32(index, src, dst, axis)
+    elif isinstance(src, Tensor_fp32_fast_fp16):
+        ops.index_select_async_fp32_fast_fp16(index, src, dst, axis)
+    elif isinstance(src, Tensor_fp32_fast_bf16):
+        ops.index_select_async_fp32_fast_bf16(index, src, dst, axis)
+    elif isinstance(src, Tensor_fp64):
+        ops.index_select_async_fp64(index, src, dst, axis)
+    elif isinstance(src, Tensor_int64):
+        ops.index_select_async_int64(index, src, dst, axis)
+    else:
+        raise TypeError(f'Wrong tensor type {type(src)}.')
+
+
 def embedding_async(
     index: Tensor_int64, vocab: Tensor, embed: Tensor, axis: int
 ) -> None:
@@ -1909,6 +2296,58 @@ def rope_backward_async(
         raise TypeError
 
 
+def rope_qk_async(
+        offset: int,
+        sin: Tensor,
+        cos: Tensor,
+        q: Tensor,
+        k: Tensor
+) -> None:
+    """
+    Wrapper for multiprecision in-place rope of queries and keys
+
+    Positions of q and k start at offset in sin and cos tables.
+    """
+    if type(q) is not type(k):
+        raise TypeError
+    if type(q) is core_tensor.Tensor_fp32:
+        core_tensor.rope_qk_async_fp32(offset, sin, cos, q, k)
+    elif type(q) is core_tensor.Tensor_fp64:
+        core_tensor.rope_qk_async_fp64(offset, sin, cos, q, k)
+    elif type(q) is core_tensor.Tensor_fp32_fast_tf32:
+        core_tensor.rope_qk_async_fp32_fast_tf32(offset, sin, cos, q, k)
+    elif type(q) is core_tensor.Tensor_bf16:
+        core_tensor.rope_qk_async_bf16(offset, sin, cos, q, k)
+    else:
+        raise TypeError
+
+
+def rope_qk_backward_async(
+        offset: int,
+        sin: Tensor,
+        cos: Tensor,
+        dq: Tensor,
+        dk: Tensor
+) -> None:
+    """
+    Wrapper for multiprecision in-place backward rope of queries and keys
+    """
+    if type(dq) is not type(dk):
+        raise TypeError
+    if type(dq) is core_tensor.Tensor_fp32:
+        core_tensor.rope_qk_backward_async_fp32(offset, sin, cos, dq, dk)
+    elif type(dq) is core_tensor.Tensor_fp64:
+        core_tensor.rope_qk_backward_async_fp64(offset, sin, cos, dq, dk)
+    elif type(dq) is core_tensor.Tensor_fp32_fast_tf32:
+        core_tensor.rope_qk_backward_async_fp32_fast_tf32(
+            offset, sin, cos, dq, dk
+        )
+    elif type(dq) is core_tensor.Tensor_bf16:
+        core_tensor.rope_qk_backward_async_bf16(offset, sin, cos, dq, dk)
+    else:
+        raise TypeError
+
+
 def conv2d_inplace_async(
         alpha: float,
         X: Tensor,
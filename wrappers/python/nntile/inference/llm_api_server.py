@@ -11,11 +11,13 @@
 # @version 1.1.0
 
 import inspect
+import json
 import logging
-from dataclasses import dataclass
+from dataclasses import asdict, dataclass
 from typing import Annotated
 
-from fastapi import Body, FastAPI
+from fastapi import Body, FastAPI, HTTPException
+from fastapi.responses import StreamingResponse
 from pydantic import BaseModel, Field
 
 from nntile.inference.api_server_base import (
@@ -54,11 +56,34 @@ class SimpleLlmApiServerGenerateRequest(BaseModel):
     )
 
 
+def _generation_params(request: SimpleLlmApiServerGenerateRequest):
+    return GenerationParams(
+        max_tokens=request.max_tokens,
+        use_cache=request.use_cache,
+        need_static_padding=request.need_static_padding,
+        top_k=request.top_k,
+        top_p_thr=request.top_p_thr,
+    )
+
+
+def _sse_event(data, event=None):
+    """Server-sent event with JSON data"""
+    prefix = "" if event is None else f"event: {event}\n"
+    return f"{prefix}data: {json.dumps(data)}\n\n"
+
+
 class SimpleLlmApiServer(SimpleApiServerBase):
     def __init__(self, llm_engine, params: SimpleLlmApiServerParams):
         super().__init__(params)
         self.llm_engine = llm_engine
 
+    def _check_streaming(self):
+        if not hasattr(self.llm_engine, "generate_stream"):
+            raise HTTPException(
+                status_code=501,
+                detail="Streaming requires an asynchronous engine",
+            )
+
     def get_app(self):
         app = FastAPI()
 
@@ -77,13 +102,7 @@ class SimpleLlmApiServer(SimpleApiServerBase):
             )
             generated_text = self.llm_engine.generate(
                 request.text,
-                params=GenerationParams(
-                    max_tokens=request.max_tokens,
-                    use_cache=request.use_cache,
-                    need_static_padding=request.need_static_padding,
-                    top_k=request.top_k,
-                    top_p_thr=request.top_p_thr,
-                ),
+                params=_generation_params(request),
                 mode=request.mode,
             )
             if inspect.isawaitable(generated_text):
@@ -91,4 +110,48 @@ class SimpleLlmApiServer(SimpleApiServerBase):
 
             return generated_text
 
+        @app.post("/generate_stream")
+        async def generate_stream(
+            request: Annotated[
+                SimpleLlmApiServerGenerateRequest, Body(embed=True)
+            ],
+        ):
+            """
+            Stream generated text as server-sent events
+
+            Every event carries a piece of text, its token and latency. The
+            final "done" event carries time to first token and latencies of
+            the following tokens of the request.
+            """
+            self._check_streaming()
+            logger.info(
+                f"Start streaming for request: {request.model_dump()}"
+            )
+
+            async def events():
+                latencies = []
+                async for chunk in self.llm_engine.generate_stream(
+                    request.text,
+                    params=_generation_params(request),
+                    mode=request.mode,
+                ):
+                    latencies.append(chunk.latency)
+                    yield _sse_event(asdict(chunk))
+                metrics = {
+                    "num_tokens": len(latencies),
+                    "ttft": latencies[0] if latencies else None,
+                    "token_latency": latencies[1:],
+                }
+                yield _sse_event(metrics, event="done")
+
+            return StreamingResponse(
+                events(), media_type="text/event-stream"
+            )
+
+        @app.get("/metrics")
+        async def metrics():
+            """Latencies of the last streamed requests"""
+            self._check_streaming()
+            return self.llm_engine.metrics.summary()
+
         return app
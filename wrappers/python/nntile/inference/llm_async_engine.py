@@ -6,27 +6,180 @@
 # NNTile is software framework for fast training of big neural networks on
 # distributed-memory heterogeneous systems based on StarPU runtime system.
 #
-# @file wrappers/python/nntile/inference/llm_sync_engine.py
+# @file wrappers/python/nntile/inference/llm_async_engine.py
 #
 # @version 1.1.0
 
+import asyncio
+import time
+import warnings
+from collections import deque
+from contextlib import contextmanager
+from dataclasses import dataclass, field
+
 import numpy as np
 
 import nntile.utils.constructors as nnt_constructors
+from nntile.layer.cache_utils import BatchKVCacheStorage, KVCacheStorage
 from nntile.model.generation.llm import GenerationMode, GenerationParams
+from nntile.model.generation.llm_samplers import get_sampler
+from nntile.nntile_core import starpu
+from nntile.tensor import TensorMoments
+
+
+@contextmanager
+def _task_priority(priority):
+    """Submit tasks of the block with a given StarPU priority"""
+    prev = starpu.get_task_priority()
+    starpu.set_task_priority(priority)
+    try:
+        yield
+    finally:
+        starpu.set_task_priority(prev)
+
+
+@dataclass
+class _SequenceState:
+    """
+    State of a single request inside of the scheduler
+    """
+
+    output_ids: list
+    max_tokens: int
+    sampler: object
+    future: asyncio.Future
+    kv_caches: KVCacheStorage = field(default_factory=KVCacheStorage)
+    # Number of prompt tokens, that are already in kv-cache
+    num_prefilled: int = 0
+    # Sampled tokens of the last chunk of the prompt, not read back yet
+    pending_tokens: object = None
+    # Generated tokens of a streamed request, None if it is not streamed
+    stream: asyncio.Queue | None = None
+
+    def push(self, token, eos_token_id):
+        """
+        Add a sampled token, returns True if the sequence is finished
+        """
+        if token == eos_token_id:
+            return True
+        self.output_ids.append(token)
+        if self.stream is not None:
+            self.stream.put_nowait(token)
+        return len(self.output_ids) >= self.max_tokens
+
+
+@dataclass
+class StreamChunk:
+    """
+    A piece of a streamed generation
+
+    latency is time in seconds since the previous chunk or since the request
+    for the first chunk, i.e., time to first token (TTFT)
+    """
+
+    text: str
+    token: int | None
+    latency: float
+
+
+def _percentiles(values):
+    if len(values) == 0:
+        return None
+    values = np.array(values)
+    return {
+        "mean": float(values.mean()),
+        "p50": float(np.percentile(values, 50)),
+        "p99": float(np.percentile(values, 99)),
+    }
+
+
+class StreamMetrics:
+    """Latencies of the last streamed requests in seconds"""
+
+    def __init__(self, window: int = 10000):
+        self.ttft = deque(maxlen=window)
+        self.token_latency = deque(maxlen=window)
+
+    def add(self, chunk: StreamChunk, is_first: bool):
+        if is_first:
+            self.ttft.append(chunk.latency)
+        else:
+            self.token_latency.append(chunk.latency)
+
+    def summary(self):
+        return {
+            "ttft": _percentiles(self.ttft),
+            "token_latency": _percentiles(self.token_latency),
+        }
 
 
 class LlmAsyncInferenceEngine:
-    def __init__(self, model, tokenizer, input_seq_size: int):
+    # StarPU priorities of tasks: decode steps are latency-critical, while
+    # prefill is bulk work, that fills idle workers
+    decode_priority = 1
+    prefill_priority = 0
+    # StarPU schedulers, that sort ready tasks by their priorities
+    priority_sched_policies = (
+        "dmdas",
+        "prio",
+        "modular-prio",
+        "modular-prio-prefetching",
+        "modular-heft-prio",
+    )
+
+    def __init__(
+        self,
+        model,
+        tokenizer,
+        input_seq_size: int,
+        max_batch_size: int = 8,
+        prefill_chunk_size: int | None = 256,
+    ):
         """
         model - nntile model
         tokenizer - huggingface-like tokenizer
         input_seq_size - static size of input sequence.
         For now, need to manually pad sequence to it
+        max_batch_size - maximal number of sequences in a single decode step
+        prefill_chunk_size - maximal number of prompt tokens, that are
+        prefilled per iteration, None means the whole prompt at once
+
+        Requests with kv-cache are served by continuous batching: new
+        requests are prefilled by chunks as soon as there is a free slot,
+        while all running requests share a single batched decode step per
+        iteration. Decode tasks are submitted with a higher priority than
+        prefill tasks, so a long prompt does not delay tokens of running
+        requests by more than a single chunk. Priorities are honored only by
+        a priority-aware scheduler, e.g. starpu.Config(sched_policy="dmdas")
+        or STARPU_SCHED=dmdas environment variable, so the engine warns
+        about any other scheduler.
         """
+        sched_policy = starpu.get_sched_policy()
+        if sched_policy not in self.priority_sched_policies:
+            warnings.warn(
+                f"StarPU scheduler {sched_policy} ignores task priorities, "
+                "so prefill may delay decode steps. Use "
+                'starpu.Config(sched_policy="dmdas") or STARPU_SCHED=dmdas.'
+            )
         self.model = model
         self.tokenizer = tokenizer
         self.input_seq_size = input_seq_size
+        self.max_batch_size = max_batch_size
+        self.prefill_chunk_size = prefill_chunk_size
+        self.waiting = deque()
+        self.prefilling = deque()
+        self.running = []
+        self._scheduler_task = None
+        self.metrics = StreamMetrics()
+
+    def _tokenize(self, prompt, params):
+        inputs = self.tokenizer(prompt, return_tensors="np")
+        input_ids = inputs["input_ids"]
+
+        # transform to compatible input
+        if params.need_static_padding:
+            raise Exception("static async inference is not supported")
+        return np.asfortranarray(input_ids).astype(np.int64)
 
     async def generate(
         self,
@@ -34,17 +187,71 @@ class LlmAsyncInferenceEngine:
         params: GenerationParams,
         mode: GenerationMode = GenerationMode.Greedy,
     ):
-        # tokenize
-        inputs = self.tokenizer(prompt, return_tensors="np")
-        input_ids = inputs["input_ids"]
-        prefill_size = input_ids.shape[1]
+        input_ids_np = self._tokenize(prompt, params)
+        prefill_size = input_ids_np.shape[1]
 
-        # transform to compatible input
-        if params.need_static_padding:
-            raise Exception("static async inference is not supported")
+        if params.use_cache and params.num_beams == 1:
+            output_ids_np = await self._generate_batched(
+                input_ids_np, params, mode
+            )
         else:
-            input_ids_np = np.asfortranarray(input_ids).astype(np.int64)
+            output_ids_np = await self._generate_single(
+                input_ids_np, prefill_size, params, mode
+            )
 
+        # construct generation result
+        generated_text = self.tokenizer.decode(output_ids_np.flatten())
+        return generated_text
+
+    async def generate_stream(
+        self,
+        prompt: str,
+        params: GenerationParams,
+        mode: GenerationMode = GenerationMode.Greedy,
+    ):
+        """
+        Asynchronous generator of StreamChunk with generated text
+
+        Requests with kv-cache and a single beam yield a chunk as soon as a
+        decode step produces a token, while other requests yield all the
+        generated text at once. Concatenation of the prompt and texts of all
+        the chunks is the output of generate. Latencies are also collected
+        into self.metrics.
+        """
+        start = time.perf_counter()
+        input_ids_np = self._tokenize(prompt, params)
+        prompt_ids = input_ids_np.flatten().tolist()
+        if params.use_cache and params.num_beams == 1:
+            seq = self._submit(input_ids_np, params, mode)
+            seq.stream = asyncio.Queue()
+            seq.future.add_done_callback(lambda _: seq.stream.put_nowait(None))
+            tokens = _iterate_queue(seq.stream)
+        else:
+            output_ids_np = await self._generate_single(
+                input_ids_np, input_ids_np.shape[1], params, mode
+            )
+            tokens = _iterate_list(
+                output_ids_np.flatten()[len(prompt_ids):].tolist()
+            )
+
+        # Text is decoded incrementally, so that a character of several
+        # tokens is yielded only when it is complete
+        output_ids = list(prompt_ids)
+        text = self.tokenizer.decode(output_ids)
+        async for token in tokens:
+            token = int(token)
+            output_ids.append(token)
+            new_text = self.tokenizer.decode(output_ids)
+            now = time.perf_counter()
+            chunk = StreamChunk(new_text[len(text):], token, now - start)
+            self.metrics.add(chunk, len(output_ids) == len(prompt_ids) + 1)
+            text, start = new_text, now
+            yield chunk
+        if params.use_cache and params.num_beams == 1:
+            # Propagate an exception of the scheduler
+            seq.future.result()
+
+    async def _generate_single(self, input_ids_np, prefill_size, params, mode):
         input_ids_nnt = nnt_constructors.from_array(input_ids_np.T)
 
         # generate ids
@@ -59,8 +266,164 @@ class LlmAsyncInferenceEngine:
         output_ids_np = (
             await nnt_constructors.to_numpy_async(output_ids)
         ).astype(int)
-        output_ids_np = output_ids_np[:effective_size]
+        return output_ids_np[:effective_size]
 
-        # construct generation result
-        generated_text = self.tokenizer.decode(output_ids_np.flatten())
-        return generated_text
+    async def _generate_batched(self, input_ids_np, params, mode):
+        seq = self._submit(input_ids_np, params, mode)
+        return np.array(await seq.future, dtype=int)
+
+    def _submit(self, input_ids_np, params, mode):
+        """Put a request into the queue of the scheduler"""
+        seq = _SequenceState(
+            output_ids=input_ids_np.flatten().tolist(),
+            max_tokens=params.max_tokens,
+            sampler=get_sampler(mode, params),
+            future=asyncio.get_running_loop().create_future(),
+            kv_caches=KVCacheStorage(
+                quantized=params.kv_cache_quantized,
+                window_size=params.kv_cache_window,
+                sink_size=params.kv_cache_sink_size,
+            ),
+        )
+        self.waiting.append(seq)
+        if self._scheduler_task is None or self._scheduler_task.done():
+            self._scheduler_task = asyncio.create_task(self._schedule())
+        return seq
+
+    async def _schedule(self):
+        """
+        Iteration-level scheduler
+
+        Every iteration admits waiting requests into free slots, submits a
+        single chunk of a prompt and a single batched decode step for all
+        running requests and retires finished ones, so that a long request
+        does not block short ones.
+        """
+        try:
+            while self.waiting or self.prefilling or self.running:
+                while self.waiting and (
+                    len(self.prefilling) + len(self.running)
+                    < self.max_batch_size
+                ):
+                    seq = self.waiting.popleft()
+                    if len(seq.output_ids) >= seq.max_tokens:
+                        seq.future.set_result(seq.output_ids)
+                    else:
+                        self.prefilling.append(seq)
+                prefilled = None
+                if self.prefilling and self._prefill_chunk(
+                    self.prefilling[0]
+                ):
+                    prefilled = self.prefilling.popleft()
+                if self.running:
+                    await self._decode()
+                # The first token of a prefilled request is read only after
+                # the decode step is submitted
+                if prefilled is not None:
+                    await self._finish_prefill(prefilled)
+                # Let new requests arrive
+                await asyncio.sleep(0)
+        except Exception as e:
+            pending = list(self.waiting) + list(self.prefilling)
+            for seq in pending + self.running:
+                if not seq.future.done():
+                    seq.future.set_exception(e)
+            self.waiting.clear()
+            self.prefilling.clear()
+            self.running = []
+
+    def _prefill_chunk(self, seq):
+        """
+        Submit the next chunk of the prompt of a sequence
+
+        Returns True if it is the last chunk, then the first token is sampled
+        on device into seq.pending_tokens.
+        """
+        start = seq.num_prefilled
+        end = len(seq.output_ids)
+        chunk_size = self.prefill_chunk_size
+        window_size = seq.kv_caches.window_size
+        if window_size is not None:
+            # Bounded kvcache takes at most window_size tokens at once
+            chunk_size = min(chunk_size or window_size, window_size)
+        if chunk_size is not None:
+            end = min(end, start + chunk_size)
+        input_ids_np = np.asfortranarray(
+            np.array(seq.output_ids[start:end], dtype=np.int64)[:, None]
+        )
+        with _task_priority(self.prefill_priority):
+            logits, seq.kv_caches = self.model.forward_dynamic(
+                TensorMoments(
+                    nnt_constructors.from_array(input_ids_np), None, False
+                ),
+                use_cache=True,
+                kv_caches=seq.kv_caches,
+            )
+            seq.num_prefilled = end
+            if end < len(seq.output_ids):
+                logits.value.unregister()
+                return False
+            seq.pending_tokens = seq.sampler.submit_tensor(logits.value)
+        return True
+
+    async def _finish_prefill(self, seq):
+        tokens = seq.pending_tokens
+        seq.pending_tokens = None
+        token = (await nnt_constructors.to_numpy_async(tokens))[-1, 0]
+        tokens.unregister()
+        if seq.push(token, self.model.eos_token_id):
+            seq.future.set_result(seq.output_ids)
+        else:
+            self.running.append(seq)
+
+    async def _decode(self):
+        # Last tokens of all running sequences as a single batch
+        input_ids_np = np.asfortranarray(
+            np.array(
+                [seq.output_ids[-1] for seq in self.running], dtype=np.int64
+            )[None, :]
+        )
+        kv_caches = BatchKVCacheStorage(
+            [seq.kv_caches for seq in self.running]
+        )
+        # Tokens are sampled on device once per distinct sampler config, so
+        # only sampled tokens are read back instead of the entire logits
+        tokens = {}
+        with _task_priority(self.decode_priority):
+            logits, _ = self.model.forward_dynamic(
+                TensorMoments(
+                    nnt_constructors.from_array(input_ids_np), None, False
+                ),
+                use_cache=True,
+                kv_caches=kv_caches,
+            )
+            for seq in self.running:
+                config = seq.sampler.config()
+                if config not in tokens:
+                    tokens[config] = seq.sampler.submit_tensor(logits.value)
+        for config in tokens:
+            tokens_nnt = tokens[config]
+            tokens[config] = await nnt_constructors.to_numpy_async(tokens_nnt)
+            tokens_nnt.unregister()
+        running = []
+        for i, seq in enumerate(self.running):
+            token = tokens[seq.sampler.config()][-1, i]
+            if seq.push(token, self.model.eos_token_id):
+                seq.future.set_result(seq.output_ids)
+            else:
+                running.append(seq)
+        self.running = running
+
+
+async def _iterate_queue(queue):
+    """Yield items of a queue until None"""
+    while True:
+        item = await queue.get()
+        if item is None:
+            return
+        yield item
+
+
+async def _iterate_list(items):
+    for item in items:
+        yield item
@@ -17,16 +17,21 @@ from nntile.model.generation.llm import GenerationMode, GenerationParams
 
 
 class LlmSyncInferenceEngine:
-    def __init__(self, model, tokenizer, input_seq_size: int):
+    def __init__(
+        self, model, tokenizer, input_seq_size: int, prefix_cache=None
+    ):
         """
         model - nntile model
         tokenizer - huggingface-like tokenizer
         input_seq_size - static size of input sequence.
         For now, need to manually pad sequence to it
+        prefix_cache - optional PrefixCache shared by all requests, so that
+        a common prefix of prompts (e.g., a system prompt) is prefilled once
         """
         self.model = model
         self.tokenizer = tokenizer
         self.input_seq_size = input_seq_size
+        self.prefix_cache = prefix_cache
 
     def generate(
         self,
@@ -55,6 +60,7 @@ class LlmSyncInferenceEngine:
             prefill_size=prefill_size,
             params=params,
             mode=mode,
+            prefix_cache=self.prefix_cache,
         )
 
         # decode
@@ -50,15 +50,19 @@ class Act(BaseLayer):
 
     # Simple generator for the normalization layer
     @staticmethod
-    def generate_simple(x: TensorMoments, funcname: str, next_tag: int):
+    def generate_simple(x: TensorMoments, funcname: str, next_tag: int,
+            inference: bool = False):
         # Get traits of X
         x_traits = TensorTraits(x.value.shape, x.value.basetile_shape)
         # Create Y with the same traits and distribution as X
         y_value = type(x.value)(x_traits, x.value.distribution, next_tag)
         next_tag = y_value.next_tag
-        y_grad = type(x.value)(x_traits, x.value.distribution, next_tag)
-        next_tag = y_grad.next_tag
-        y = TensorMoments(y_value, y_grad, True)
+        if inference:
+            y = TensorMoments(y_value, None, False)
+        else:
+            y_grad = type(x.value)(x_traits, x.value.distribution, next_tag)
+            next_tag = y_grad.next_tag
+            y = TensorMoments(y_value, y_grad, True)
         # Create activation layer with all the provided tensors
         layer = Act(x, y, funcname)
         # Return layer and next tag to be used
@@ -79,7 +83,7 @@ class Act(BaseLayer):
         self.y.value.wont_use()
 
     def forward_dynamic(self, x: TensorMoments):
-        y = nntc.zeros(
+        y = nntc.scratch(
             x.value.shape,
             dtype=type(x.value),
             basetile_shape=x.value.basetile_shape,
@@ -26,14 +26,18 @@ class Add(BaseLayer):
         super().__init__([x, y], [res], [], [])
 
     @staticmethod
-    def generate_simple(x: TensorMoments, y: TensorMoments, next_tag: int):
+    def generate_simple(x: TensorMoments, y: TensorMoments, next_tag: int,
+            inference: bool = False):
         res_traits = TensorTraits(y.value.shape, y.value.basetile_shape)
         res_distr = [0] * res_traits.grid.nelems
         res_value = type(y.value)(res_traits, res_distr, next_tag)
         next_tag = res_value.next_tag
-        res_grad = type(y.value)(res_traits, res_distr, next_tag)
-        next_tag = res_grad.next_tag
-        res = TensorMoments(res_value, res_grad, True)
+        if inference:
+            res = TensorMoments(res_value, None, False)
+        else:
+            res_grad = type(y.value)(res_traits, res_distr, next_tag)
+            next_tag = res_grad.next_tag
+            res = TensorMoments(res_value, res_grad, True)
         return Add(x, y, res), next_tag
 
     def forward_async(self):
@@ -43,7 +47,7 @@ class Add(BaseLayer):
         self.res.value.wont_use()
 
     def forward_dynamic(self, x1: TensorMoments, x2: TensorMoments):
-        y = nntc.empty_like(x1.value)
+        y = nntc.scratch_like(x1.value)
         add_async(1.0, x1.value, 1.0, x2.value, y)
         return TensorMoments(y, None, False)
 
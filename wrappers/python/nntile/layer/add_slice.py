@@ -32,7 +32,8 @@ class AddSlice(BaseLayer):
         # Set up local named parameters
         self.x = x
         self.y = y
-        self.y.grad.set_reduction_add()
+        if self.y.grad is not None:
+            self.y.grad.set_reduction_add()
         self.u = u
         self.axis = axis
         if redux:
@@ -72,15 +73,19 @@ class AddSlice(BaseLayer):
         axis: int,
         next_tag: int,
         redux: bool = False,
+        inference: bool = False,
     ):
         # Get traits of X
         u_traits = TensorTraits(x.value.shape, x.value.basetile_shape)
         # Create Y with the same traits and distribution as X
         u_value = type(x.value)(u_traits, x.value.distribution, next_tag)
         next_tag = u_value.next_tag
-        u_grad = type(x.value)(u_traits, x.value.distribution, next_tag)
-        next_tag = u_grad.next_tag
-        u = TensorMoments(u_value, u_grad, True)
+        if inference:
+            u = TensorMoments(u_value, None, False)
+        else:
+            u_grad = type(x.value)(u_traits, x.value.distribution, next_tag)
+            next_tag = u_grad.next_tag
+            u = TensorMoments(u_value, u_grad, True)
         # Create activation layer with all the provided tensors
         layer = AddSlice(x, y, u, axis, redux)
         # Return layer and next tag to be used
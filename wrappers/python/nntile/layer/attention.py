@@ -17,13 +17,13 @@ import numpy as np
 
 import nntile.utils.constructors as nntc
 from nntile.layer.base_layer import BaseLayer
-from nntile.layer.cache_utils import KVCache
+from nntile.layer.cache_utils import BatchKVCache, KVCache
 from nntile.tensor import (
     Tensor, Tensor_bool, TensorMoments, TensorTraits, add_fiber_inplace_async,
     add_slice_inplace_async, clear_async, copy_intersection_async, gemm_async,
-    mask_scalar_async, maxsumexp_async, notrans, prod_inplace_async,
-    softmax_inplace_async, sum_fiber_async, sumprod_slice_async, trans,
-    transpose_async)
+    mask_scalar_async, mask_scalar_causal_async, maxsumexp_async, notrans,
+    prod_inplace_async, softmax_inplace_async, sum_fiber_async,
+    sumprod_slice_async, trans, transpose_async)
 
 
 # Multi-head attention
@@ -88,16 +88,20 @@ class Attention(BaseLayer):
         qkv_bias_list = []
         if in_proj_bias_q:
             qkv_bias_list.append(in_proj_bias_q)
-            in_proj_bias_q.grad.set_reduction_add()
+            if in_proj_bias_q.grad is not None:
+                in_proj_bias_q.grad.set_reduction_add()
         if in_proj_bias_k:
             qkv_bias_list.append(in_proj_bias_k)
-            in_proj_bias_k.grad.set_reduction_add()
+            if in_proj_bias_k.grad is not None:
+                in_proj_bias_k.grad.set_reduction_add()
         if in_proj_bias_v:
             qkv_bias_list.append(in_proj_bias_v)
-            in_proj_bias_v.grad.set_reduction_add()
+            if in_proj_bias_v.grad is not None:
+                in_proj_bias_v.grad.set_reduction_add()
         if out_proj_bias:
             bias_list_out_proj = [out_proj_bias]
-            out_proj_bias.grad.set_reduction_add()
+            if out_proj_bias.grad is not None:
+                out_proj_bias.grad.set_reduction_add()
         else:
             bias_list_out_proj = []
         # Redirect to BaseClass initialization
@@ -120,44 +124,57 @@ class Attention(BaseLayer):
             ],
         )
         self.x_q = x_q
-        self.x_q.grad.set_reduction_add()
+        if self.x_q.grad is not None:
+            self.x_q.grad.set_reduction_add()
         self.x_k = x_k
-        self.x_k.grad.set_reduction_add()
+        if self.x_k.grad is not None:
+            self.x_k.grad.set_reduction_add()
         self.x_v = x_v
-        self.x_v.grad.set_reduction_add()
+        if self.x_v.grad is not None:
+            self.x_v.grad.set_reduction_add()
         self.y = y
         self.y.value.set_reduction_add()
         self.w_q = w_q
-        self.w_q.grad.set_reduction_add()
+        if self.w_q.grad is not None:
+            self.w_q.grad.set_reduction_add()
         self.w_k = w_k
-        self.w_k.grad.set_reduction_add()
+        if self.w_k.grad is not None:
+            self.w_k.grad.set_reduction_add()
         self.w_v = w_v
-        self.w_v.grad.set_reduction_add()
+        if self.w_v.grad is not None:
+            self.w_v.grad.set_reduction_add()
         self.w = w
-        self.w.grad.set_reduction_add()
+        if self.w.grad is not None:
+            self.w.grad.set_reduction_add()
         self.q_transposed = q_transposed
         self.q_transposed.value.set_reduction_add()
         self.q = q
-        self.q.grad.set_reduction_add()
+        if self.q.grad is not None:
+            self.q.grad.set_reduction_add()
         self.k_transposed = k_transposed
         self.k_transposed.value.set_reduction_add()
         self.k = k
-        self.k.grad.set_reduction_add()
+        if self.k.grad is not None:
+            self.k.grad.set_reduction_add()
         self.v_transposed = v_transposed
         self.v_transposed.value.set_reduction_add()
         self.v = v
-        self.v.grad.set_reduction_add()
+        if self.v.grad is not None:
+            self.v.grad.set_reduction_add()
         self.a = a
         self.a.value.set_reduction_add()
-        self.a.grad.set_reduction_add()
+        if self.a.grad is not None:
+            self.a.grad.set_reduction_add()
         self.a_maxsumexp = a_maxsumexp
         self.a_maxsumexp.set_reduction_maxsumexp()
         self.a_sumprod_slice = a_sumprod_slice
-        self.a_sumprod_slice.set_reduction_add()
+        if self.a_sumprod_slice is not None:
+            self.a_sumprod_slice.set_reduction_add()
         self.b = b
         self.b.value.set_reduction_add()
         self.b_transposed = b_transposed
-        self.b_transposed.grad.set_reduction_add()
+        if self.b_transposed.grad is not None:
+            self.b_transposed.grad.set_reduction_add()
         self.in_proj_bias_q = in_proj_bias_q
         self.in_proj_bias_k = in_proj_bias_k
         self.in_proj_bias_v = in_proj_bias_v
@@ -197,6 +214,7 @@ class Attention(BaseLayer):
         bias=False,
         mask=None,
         redux: bool = False,
+        inference: bool = False,
     ):
         # Get sizes
         n_emb, n_seq, n_batch = x_q.value.shape
@@ -320,160 +338,132 @@ class Attention(BaseLayer):
                 [head_size, n_head], [head_size_tile, n_head_tile]
             )
             in_proj_bias_qkv_distr = [0] * in_proj_bias_qkv_traits.grid.nelems
+        # Gradients are not allocated in the inference mode
+        def moments(value, traits, distr):
+            nonlocal next_tag
+            if inference:
+                return TensorMoments(value, None, False)
+            grad = type(x_q.value)(traits, distr, next_tag)
+            next_tag = grad.next_tag
+            return TensorMoments(value, grad, True)
+
         # Define all the lists
         # w_q
         w_q_value = type(x_q.value)(w_q_traits, w_q_distr, next_tag)
         next_tag = w_q_value.next_tag
-        w_q_grad = type(x_q.value)(w_q_traits, w_q_distr, next_tag)
-        next_tag = w_q_grad.next_tag
-        w_q = TensorMoments(w_q_value, w_q_grad, True)
+        w_q = moments(w_q_value, w_q_traits, w_q_distr)
         if bias:
             in_proj_bias_q_value = type(x_q.value)(
                 in_proj_bias_qkv_traits, in_proj_bias_qkv_distr, next_tag
             )
             next_tag = in_proj_bias_q_value.next_tag
-            in_proj_bias_q_grad = type(x_q.value)(
-                in_proj_bias_qkv_traits, in_proj_bias_qkv_distr, next_tag
-            )
-            next_tag = in_proj_bias_q_grad.next_tag
-            bias_inproj_q = TensorMoments(
-                in_proj_bias_q_value, in_proj_bias_q_grad, True
+            bias_inproj_q = moments(
+                in_proj_bias_q_value,
+                in_proj_bias_qkv_traits,
+                in_proj_bias_qkv_distr,
             )
         else:
             bias_inproj_q = None
         # w_k
         w_k_value = type(x_q.value)(w_k_traits, w_k_distr, next_tag)
         next_tag = w_k_value.next_tag
-        w_k_grad = type(x_q.value)(w_k_traits, w_k_distr, next_tag)
-        next_tag = w_k_grad.next_tag
-        w_k = TensorMoments(w_k_value, w_k_grad, True)
+        w_k = moments(w_k_value, w_k_traits, w_k_distr)
         if bias:
             in_proj_bias_k_value = type(x_q.value)(
                 in_proj_bias_qkv_traits, in_proj_bias_qkv_distr, next_tag
             )
             next_tag = in_proj_bias_k_value.next_tag
-            in_proj_bias_k_grad = type(x_q.value)(
-                in_proj_bias_qkv_traits, in_proj_bias_qkv_distr, next_tag
-            )
-            next_tag = in_proj_bias_k_grad.next_tag
-            bias_inproj_k = TensorMoments(
-                in_proj_bias_k_value, in_proj_bias_k_grad, True
+            bias_inproj_k = moments(
+                in_proj_bias_k_value,
+                in_proj_bias_qkv_traits,
+                in_proj_bias_qkv_distr,
             )
         else:
             bias_inproj_k = None
         # w_v
         w_v_value = type(x_q.value)(w_v_traits, w_v_distr, next_tag)
         next_tag = w_v_value.next_tag
-        w_v_grad = type(x_q.value)(w_v_traits, w_v_distr, next_tag)
-        next_tag = w_v_grad.next_tag
-        w_v = TensorMoments(w_v_value, w_v_grad, True)
+        w_v = moments(w_v_value, w_v_traits, w_v_distr)
         if bias:
             in_proj_bias_v_value = type(x_q.value)(
                 in_proj_bias_qkv_traits, in_proj_bias_qkv_distr, next_tag
             )
             next_tag = in_proj_bias_v_value.next_tag
-            in_proj_bias_v_grad = type(x_q.value)(
-                in_proj_bias_qkv_traits, in_proj_bias_qkv_distr, next_tag
-            )
-            next_tag = in_proj_bias_v_grad.next_tag
-            bias_inproj_v = TensorMoments(
-                in_proj_bias_v_value, in_proj_bias_v_grad, True
+            bias_inproj_v = moments(
+                in_proj_bias_v_value,
+                in_proj_bias_qkv_traits,
+                in_proj_bias_qkv_distr,
             )
         else:
             bias_inproj_v = None
         # w
         w_value = type(x_q.value)(w_traits, w_distr, next_tag)
         next_tag = w_value.next_tag
-        w_grad = type(x_q.value)(w_traits, w_distr, next_tag)
-        next_tag = w_grad.next_tag
-        w = TensorMoments(w_value, w_grad, True)
+        w = moments(w_value, w_traits, w_distr)
         # q_transposed
         q_transposed_value = type(x_q.value)(
             q_transposed_traits, q_transposed_distr, next_tag
         )
         next_tag = q_transposed_value.next_tag
-        q_transposed_grad = type(x_q.value)(
-            q_transposed_traits, q_transposed_distr, next_tag
-        )
-        next_tag = q_transposed_grad.next_tag
-        q_transposed = TensorMoments(
-            q_transposed_value, q_transposed_grad, True
+        q_transposed = moments(
+            q_transposed_value, q_transposed_traits, q_transposed_distr
         )
         # q
         q_value = type(x_q.value)(q_traits, q_distr, next_tag)
         next_tag = q_value.next_tag
-        q_grad = type(x_q.value)(q_traits, q_distr, next_tag)
-        next_tag = q_grad.next_tag
-        q = TensorMoments(q_value, q_grad, True)
+        q = moments(q_value, q_traits, q_distr)
         # k_transposed
         k_transposed_value = type(x_q.value)(
             k_transposed_traits, k_transposed_distr, next_tag
         )
         next_tag = k_transposed_value.next_tag
-        k_transposed_grad = type(x_q.value)(
-            k_transposed_traits, k_transposed_distr, next_tag
-        )
-        next_tag = k_transposed_grad.next_tag
-        k_transposed = TensorMoments(
-            k_transposed_value, k_transposed_grad, True
+        k_transposed = moments(
+            k_transposed_value, k_transposed_traits, k_transposed_distr
         )
         # k
         k_value = type(x_q.value)(k_traits, k_distr, next_tag)
         next_tag = k_value.next_tag
-        k_grad = type(x_q.value)(k_traits, k_distr, next_tag)
-        next_tag = k_grad.next_tag
-        k = TensorMoments(k_value, k_grad, True)
+        k = moments(k_value, k_traits, k_distr)
         # v_transposed
         v_transposed_value = type(x_q.value)(
             v_transposed_traits, v_transposed_distr, next_tag
         )
         next_tag = v_transposed_value.next_tag
-        v_transposed_grad = type(x_q.value)(
-            v_transposed_traits, v_transposed_distr, next_tag
-        )
-        next_tag = v_transposed_grad.next_tag
-        v_transposed = TensorMoments(
-            v_transposed_value, v_transposed_grad, True
+        v_transposed = moments(
+            v_transposed_value, v_transposed_traits, v_transposed_distr
         )
         # v
         v_value = type(x_q.value)(v_traits, v_distr, next_tag)
         next_tag = v_value.next_tag
-        v_grad = type(x_q.value)(v_traits, v_distr, next_tag)
-        next_tag = v_grad.next_tag
-        v = TensorMoments(v_value, v_grad, True)
+        v = moments(v_value, v_traits, v_distr)
         # a
         a_value = type(x_q.value)(a_traits, a_distr, next_tag)
         next_tag = a_value.next_tag
-        a_grad = type(x_q.value)(a_traits, a_distr, next_tag)
-        next_tag = a_grad.next_tag
-        a = TensorMoments(a_value, a_grad, True)
+        a = moments(a_value, a_traits, a_distr)
         # a_maxsumexp
         a_maxsumexp = type(x_q.value)(
             a_maxsumexp_traits, a_maxsumexp_distr, next_tag
         )
         next_tag = a_maxsumexp.next_tag
-        # a_sumprod_slice
-        a_sumprod_slice = type(x_q.value)(
-            a_sumprod_slice_traits, a_sumprod_slice_distr, next_tag
-        )
-        next_tag = a_sumprod_slice.next_tag
+        # a_sumprod_slice is needed only by backward
+        if inference:
+            a_sumprod_slice = None
+        else:
+            a_sumprod_slice = type(x_q.value)(
+                a_sumprod_slice_traits, a_sumprod_slice_distr, next_tag
+            )
+            next_tag = a_sumprod_slice.next_tag
         # b
         b_value = type(x_q.value)(b_traits, b_distr, next_tag)
         next_tag = b_value.next_tag
-        b_grad = type(x_q.value)(b_traits, b_distr, next_tag)
-        next_tag = b_grad.next_tag
-        b = TensorMoments(b_value, b_grad, True)
+        b = moments(b_value, b_traits, b_distr)
         # b_transposed
         b_transposed_value = type(x_q.value)(
             b_transposed_traits, b_transposed_distr, next_tag
         )
         next_tag = b_transposed_value.next_tag
-        b_transposed_grad = type(x_q.value)(
-            b_transposed_traits, b_transposed_distr, next_tag
-        )
-        next_tag = b_transposed_grad.next_tag
-        b_transposed = TensorMoments(
-            b_transposed_value, b_transposed_grad, True
+        b_transposed = moments(
+            b_transposed_value, b_transposed_traits, b_transposed_distr
         )
         # Allocate tensors for bias for q, k, v and output projection
         if bias:
@@ -483,12 +473,8 @@ class Attention(BaseLayer):
                 out_proj_bias_traits, out_proj_bias_distr, next_tag
             )
             next_tag = out_proj_bias_value.next_tag
-            out_proj_bias_grad = type(x_q.value)(
-                out_proj_bias_traits, out_proj_bias_distr, next_tag
-            )
-            next_tag = out_proj_bias_grad.next_tag
-            out_proj_bias = TensorMoments(
-                out_proj_bias_value, out_proj_bias_grad, True
+            out_proj_bias = moments(
+                out_proj_bias_value, out_proj_bias_traits, out_proj_bias_distr
             )
         else:
             out_proj_bias = None
@@ -496,9 +482,7 @@ class Attention(BaseLayer):
         y_traits = TensorTraits(x_q.value.shape, x_q.value.basetile_shape)
         y_value = type(x_q.value)(y_traits, x_q.value.distribution, next_tag)
         next_tag = y_value.next_tag
-        y_grad = type(x_q.value)(y_traits, x_q.value.distribution, next_tag)
-        next_tag = y_grad.next_tag
-        y = TensorMoments(y_value, y_grad, True)
+        y = moments(y_value, y_traits, x_q.value.distribution)
         # Create attention layer with all the provided data
         layer = Attention(
             x_q,
@@ -811,11 +795,19 @@ class Attention(BaseLayer):
             self.out_proj_bias.value.wont_use()
         self.y.value.wont_use()
 
-    def _forward_attn_dynamic(self, q, k, v):
+    def _forward_attn_dynamic(self, q, k, v, kv_len=None):
+        b_tmp = self._forward_attn_core_dynamic(q, k, v, kv_len)
+        return self._forward_out_dynamic(b_tmp)
+
+    def _forward_attn_core_dynamic(self, q, k, v, kv_len=None):
+        # Only the first kv_len keys and values are valid, the rest is padding
+        # of a view of the KV-cache
+        if kv_len is None:
+            kv_len = k.shape[1]
         a_tmp = nntc.empty(
             (k.shape[1],) + (q.shape[1],) + tuple(k.shape[2:]),
             dtype=type(q),
-            basetile_shape=(k.shape[1],)
+            basetile_shape=(k.basetile_shape[1],)
             + (q.shape[1],)
             + (k.shape[2],)
             + (self.n_head_tile,),
@@ -832,18 +824,6 @@ class Attention(BaseLayer):
             dtype=type(q),
             basetile_shape=tuple(q.shape[:-1]) + (self.n_head_tile,),
         )  # (head_size, n_seq, n_batch, n_head)
-        b_tr_tmp = nntc.empty(
-            (self.n_head, self.head_size) + tuple(q.shape[1:3]),
-            dtype=type(q),
-            basetile_shape=(self.n_head_tile, self.head_size)
-            + tuple(q.shape[1:3]),
-        )  # (n_head, head_size, n_seq, n_batch)
-        self.y_tensor = nntc.empty(
-            (self.n_emb,) + tuple(q.shape[1:3]),
-            dtype=type(q),
-            basetile_shape=(self.n_emb_tile,) + tuple(q.shape[1:3]),
-        )  # (n_emb, n_seq, n_batch)
-        y_tensor = self.y_tensor
         # Get tensor for softmax
         # A = 1.0/sqrt(head_size) * einsum('jklb,jmlb->kmlb', K, Q)
         # single batched gemm (head_size, n_seq, batch=n_batch, batch=n_head)
@@ -871,11 +851,21 @@ class Attention(BaseLayer):
         # A = softmax(A, axis=0)
         # Apply mask if needed
         if self.mask:
-            mask_tmp = nntc.empty(a_tmp.shape[:2], dtype=Tensor_bool)
+            mask_tmp = nntc.empty(
+                a_tmp.shape[:2],
+                basetile_shape=a_tmp.basetile_shape[:2],
+                dtype=Tensor_bool,
+            )
             copy_intersection_async(
-                self.mask, [0, 0], mask_tmp, [0, k.shape[1] - q.shape[1]]
+                self.mask, [0, 0], mask_tmp, [0, kv_len - q.shape[1]]
             )
             mask_scalar_async(mask_tmp, self.val, a_tmp, 2)
+        if kv_len < k.shape[1]:
+            # All keys are in the past of shifted queries, so only the
+            # padding is masked out
+            mask_scalar_causal_async(
+                k.shape[1], 0, kv_len, self.val, a_tmp, 2
+            )
 
         # Calculate max and sumexp along axis
         maxsumexp_async(a_tmp, a_maxsumexp_tmp, 0, redux=self.redux)
@@ -895,6 +885,21 @@ class Attention(BaseLayer):
         # V and A can be offloaded from GPU
         v.wont_use()
         a_tmp.wont_use()
+        return b_tmp
+
+    def _forward_out_dynamic(self, b_tmp):
+        b_tr_tmp = nntc.empty(
+            (self.n_head, self.head_size) + tuple(b_tmp.shape[1:3]),
+            dtype=type(b_tmp),
+            basetile_shape=(self.n_head_tile, self.head_size)
+            + tuple(b_tmp.shape[1:3]),
+        )  # (n_head, head_size, n_seq, n_batch)
+        self.y_tensor = nntc.empty(
+            (self.n_emb,) + tuple(b_tmp.shape[1:3]),
+            dtype=type(b_tmp),
+            basetile_shape=(self.n_emb_tile,) + tuple(b_tmp.shape[1:3]),
+        )  # (n_emb, n_seq, n_batch)
+        y_tensor = self.y_tensor
 
         # Accumulate result from all the heads
         # rotate axes (head_size, n_seq, n_batch, n_head) into
@@ -942,6 +947,9 @@ class Attention(BaseLayer):
     def forward_dynamic(
             self, x: TensorMoments, kv_cache: Optional[KVCache] = None
         ):
+        if isinstance(kv_cache, BatchKVCache):
+            return self._forward_dynamic_batch(x, kv_cache)
+
         if (kv_cache is not None) and (x.value.shape[1] + len(kv_cache) > self.x_v.value.shape[1]):  # noqa: E501
             raise Exception(
                 "Overload internal state: "
@@ -956,14 +964,60 @@ class Attention(BaseLayer):
 
         if kv_cache is not None:
             kv_cache.append(k_partial, v_partial)
-            k = kv_cache.k_partial
-            v = kv_cache.v_partial
+            # Views of the cache may be longer than len(kv_cache)
+            k = kv_cache.k_view
+            v = kv_cache.v_view
+            kv_len = len(kv_cache)
         else:
             k = k_partial
             v = v_partial
+            kv_len = None
 
         # compute attention and weight result
-        y_tensor = self._forward_attn_dynamic(q_partial, k, v)
+        y_tensor = self._forward_attn_dynamic(q_partial, k, v, kv_len)
+        return TensorMoments(y_tensor, None, False), kv_cache
+
+    def _forward_dynamic_batch(self, x: TensorMoments, kv_cache: BatchKVCache):
+        # Projections are shared by all sequences of the batch, while every
+        # sequence attends to its own cache
+        q_partial = self._forward_mlp_q_dynamic(x.value)
+        k_partial = self._forward_mlp_k_dynamic(x.value)
+        v_partial = self._forward_mlp_v_dynamic(x.value)
+        b_tmp = nntc.empty(
+            q_partial.shape,
+            dtype=type(q_partial),
+            basetile_shape=tuple(q_partial.shape[:-1]) + (self.n_head_tile,),
+        )  # (head_size, n_seq, n_batch, n_head)
+        b_offset = [0] * len(b_tmp.shape)
+
+        for i, cache in enumerate(kv_cache.caches):
+            if x.value.shape[1] + len(cache) > self.x_v.value.shape[1]:
+                raise Exception(
+                    "Overload internal state: "
+                    f"try add {x.value.shape[1]} "
+                    f"to {len(cache)}, max: {self.x_v.value.shape[1]}. "
+                )
+            q_seq = nntc.slice_copy(q_partial, 2, i)
+            k_seq = nntc.slice_copy(k_partial, 2, i)
+            v_seq = nntc.slice_copy(v_partial, 2, i)
+            cache.append(k_seq, v_seq)
+            k_seq.invalidate_submit()
+            v_seq.invalidate_submit()
+            b_seq = self._forward_attn_core_dynamic(
+                q_seq, cache.k_view, cache.v_view, len(cache)
+            )
+            q_seq.invalidate_submit()
+            b_offset[2] = i
+            copy_intersection_async(
+                b_seq, b_offset, b_tmp, [0] * len(b_offset)
+            )
+            b_seq.invalidate_submit()
+
+        q_partial.invalidate_submit()
+        k_partial.invalidate_submit()
+        v_partial.invalidate_submit()
+        y_tensor = self._forward_out_dynamic(b_tmp)
+        b_tmp.invalidate_submit()
         return TensorMoments(y_tensor, None, False), kv_cache
 
     # Backward propagation of the linear layer
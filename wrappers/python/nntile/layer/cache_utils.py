@@ -12,7 +12,9 @@
 # @version 1.1.0
 
 import nntile.utils.constructors as nntc
-from nntile.tensor import copy_intersection_async
+from nntile.tensor import (
+    Tensor_int8, copy_intersection_async, dequantize_async, index_select_async,
+    quantize_async)
 
 
 class KVCacheStorage:
@@ -22,8 +24,20 @@ class KVCacheStorage:
     Passed explicitly to model
     """
 
-    def __init__(self, kv_caches=None):
+    def __init__(
+        self, kv_caches=None, quantized=False, window_size=None, sink_size=4
+    ):
+        """
+        quantized - store keys and values as int8 (see QuantizedKVCache)
+        window_size - keep only sink_size first and window_size last
+        positions, so that memory does not grow (see SinkKVCache)
+        """
+        if quantized and window_size is not None:
+            raise Exception("No support for quantized sliding window cache")
         self.kv_caches = kv_caches
+        self.quantized = quantized
+        self.window_size = window_size
+        self.sink_size = sink_size
         if kv_caches is not None:
             self._is_initialized = True
         else:
@@ -32,20 +46,112 @@ class KVCacheStorage:
     def is_initialized(self):
         return self._is_initialized
 
-    def init(self, num_layers, max_cache_size, seq_size_dim=1):
+    def init(
+        self, num_layers, max_cache_size, seq_size_dim=1, block_size=None
+    ):
         """
         Used for first initialization from inside the model
         So model explicitly sets number of cached layers
         """
-        self.kv_caches = [
-            KVCache(max_cache_size, seq_size_dim) for _ in range(num_layers)
-        ]
+        if self.window_size is not None:
+            self.kv_caches = [
+                SinkKVCache(
+                    max_cache_size,
+                    seq_size_dim,
+                    block_size,
+                    self.sink_size,
+                    self.window_size,
+                )
+                for _ in range(num_layers)
+            ]
+        else:
+            cache_type = QuantizedKVCache if self.quantized else KVCache
+            self.kv_caches = [
+                cache_type(max_cache_size, seq_size_dim, block_size)
+                for _ in range(num_layers)
+            ]
         self._is_initialized = True
 
     def get_cache(self):
         assert self.kv_caches
         return self.kv_caches
 
+    def __len__(self):
+        """
+        Number of cached positions
+        """
+        if not self._is_initialized:
+            return 0
+        return len(self.kv_caches[0])
+
+    def truncate(self, size):
+        """
+        Drop all cached positions starting from size in all layers
+        Used to roll back rejected tokens (e.g., of speculative decoding)
+        """
+        if self._is_initialized:
+            for kv_cache in self.kv_caches:
+                kv_cache.truncate(size)
+
+    def reorder(self, index):
+        """
+        Gather caches of sequences of a batch in all layers on device
+        Used to follow parent beams of beam search (see KVCache.reorder)
+        """
+        if self._is_initialized:
+            for kv_cache in self.kv_caches:
+                kv_cache.reorder(index)
+
+
+class BatchKVCacheStorage(KVCacheStorage):
+    """
+    Joins kv cache storages of independent sequences
+    Used for a single batched forward pass over several sequences, each of
+    them continues from its own cache size. Sequence i of the batch uses
+    storage i.
+    Passed explicitly to model
+    """
+
+    def __init__(self, storages):
+        self.storages = storages
+        super().__init__()
+
+    def init(
+        self, num_layers, max_cache_size, seq_size_dim=1, block_size=None
+    ):
+        """
+        Used for first initialization from inside the model
+        Storages of new sequences are initialized here as well
+        """
+        for storage in self.storages:
+            if not storage.is_initialized():
+                storage.init(
+                    num_layers, max_cache_size, seq_size_dim, block_size
+                )
+        caches = [storage.get_cache() for storage in self.storages]
+        self.kv_caches = [
+            BatchKVCache([cache[i] for cache in caches])
+            for i in range(num_layers)
+        ]
+        self._is_initialized = True
+
+    def __len__(self):
+        raise TypeError("Sequences of a batch have different cache sizes")
+
+    def cache_sizes(self):
+        return [len(storage) for storage in self.storages]
+
+
+class BatchKVCache:
+    """
+    Caches of a single layer for all sequences of a batch
+    Attention splits its input along the batch dimension and appends keys
+    and values of sequence i to caches[i]
+    """
+
+    def __init__(self, caches):
+        self.caches = caches
+
 
 class ParallelSamplingCacheStorage(KVCacheStorage):
     """
@@ -59,7 +165,9 @@ class ParallelSamplingCacheStorage(KVCacheStorage):
         self.num_layers = 0
         super().__init__()
 
-    def init(self, num_layers, max_cache_size, seq_size_dim=1):
+    def init(
+        self, num_layers, max_cache_size, seq_size_dim=1, block_size=None
+    ):
         """
         Used for first initialization from inside the model
         So model explicitly sets number of cached layers
@@ -72,6 +180,7 @@ class ParallelSamplingCacheStorage(KVCacheStorage):
                 num_beams=self.num_beams,
                 max_cache_size=max_cache_size,
                 seq_size_dim=seq_size_dim,
+                block_size=block_size,
             )
             for _ in range(self.num_layers)
         ]
@@ -113,17 +222,351 @@ class ParallelSamplingCacheStorage(KVCacheStorage):
             self.kv_caches[i].reduce(beams_ids)
 
 
+class PagedKVCacheStorage(KVCacheStorage):
+    """
+    Stores kv caches for all layers of model in blocks of a shared pool
+    Block table of a sequence is shared by all layers
+    Passed explicitly to model
+    """
+
+    def __init__(self, pool):
+        self.pool = pool
+        self.block_table = []
+        self.num_prefix_tokens = 0
+        super().__init__()
+
+    def init(
+        self, num_layers, max_cache_size, seq_size_dim=1, block_size=None
+    ):
+        """
+        Used for first initialization from inside the model
+        Size of cache is limited only by the number of free blocks of pool
+        """
+        assert seq_size_dim == self.pool.seq_size_dim
+        self.kv_caches = [
+            PagedKVCache(
+                self.pool, layer, self.block_table, self.num_prefix_tokens
+            )
+            for layer in range(num_layers)
+        ]
+        self._is_initialized = True
+
+    def reuse_prefix(self, prefix_cache, token_ids):
+        """
+        Start the sequence from the longest cached prefix of token_ids
+
+        Shall be called before the first forward pass. Returns the number of
+        reused tokens, only the rest of token_ids needs to be prefilled.
+        """
+        assert not self._is_initialized and not self.block_table
+        assert prefix_cache.pool is self.pool
+        self.block_table.extend(prefix_cache.match(token_ids))
+        self.num_prefix_tokens = len(self.block_table) * self.pool.block_size
+        return self.num_prefix_tokens
+
+    def __len__(self):
+        if not self._is_initialized:
+            return self.num_prefix_tokens
+        return len(self.kv_caches[0])
+
+    def clear(self):
+        """
+        Return all blocks of the sequence to the pool
+        """
+        self.pool.free(self.block_table)
+        self.block_table.clear()
+        self.num_prefix_tokens = 0
+        if self.kv_caches is not None:
+            for kv_cache in self.kv_caches:
+                kv_cache.k_cache_size = 0
+                kv_cache.v_cache_size = 0
+
+
+class KVBlockPool:
+    """
+    Global pool of fixed size blocks of keys and values
+
+    Keys and values of every layer are stored in a single preallocated tensor
+    with num_blocks tiles of block_size positions. A block id refers to the
+    same tile in every layer. Sequences take blocks from the pool as they grow
+    and return them back when they are finished, so memory is not reserved
+    for the worst case of every sequence.
+
+    Blocks are reference counted, as a full block may be shared by several
+    sequences and a prefix cache. A block returns to the pool only when its
+    last reference is freed.
+    """
+
+    def __init__(self, num_blocks, block_size, seq_size_dim=1):
+        self.num_blocks = num_blocks
+        self.block_size = block_size
+        self.seq_size_dim = seq_size_dim
+        self.free_blocks = list(range(num_blocks - 1, -1, -1))
+        self.ref_counts = [0] * num_blocks
+        self.prefix_cache = None
+        self.k = {}
+        self.v = {}
+
+    def num_free_blocks(self):
+        return len(self.free_blocks)
+
+    def allocate(self):
+        # Blocks, that are kept only by a prefix cache, can be reclaimed
+        if not self.free_blocks and self.prefix_cache is not None:
+            self.prefix_cache.evict(1, unused_only=True)
+        if not self.free_blocks:
+            raise RuntimeError("KV block pool is exhausted")
+        block = self.free_blocks.pop()
+        self.ref_counts[block] = 1
+        return block
+
+    def share(self, blocks):
+        for block in blocks:
+            assert self.ref_counts[block] > 0
+            self.ref_counts[block] += 1
+
+    def free(self, blocks):
+        for block in reversed(blocks):
+            self.ref_counts[block] -= 1
+            if self.ref_counts[block] == 0:
+                self.free_blocks.append(block)
+
+    def _init_from_tensor(self, tensor):
+        pool_shape = tensor.shape
+        pool_shape[self.seq_size_dim] = self.num_blocks * self.block_size
+
+        pool_basetile_shape = tensor.basetile_shape
+        pool_basetile_shape[self.seq_size_dim] = self.block_size
+
+        # Padding of the last block of a sequence is masked out in attention,
+        # but it shall never hold NaNs
+        return nntc.zeros(
+            pool_shape,
+            dtype=type(tensor),
+            basetile_shape=pool_basetile_shape,
+        )
+
+    def get_layer(self, layer, k_partial, v_partial):
+        if layer not in self.k:
+            self.k[layer] = self._init_from_tensor(k_partial)
+            self.v[layer] = self._init_from_tensor(v_partial)
+        return self.k[layer], self.v[layer]
+
+    def unregister(self):
+        for tensor in list(self.k.values()) + list(self.v.values()):
+            tensor.unregister()
+        self.k = {}
+        self.v = {}
+
+
+class PagedKVCache:
+    """
+    Stores keys and values of a single layer in blocks of a shared pool
+
+    Views k_view and v_view gather blocks of the block table without copying,
+    so they may hold a few more positions than len(cache). Attention shall
+    mask out keys at positions len(cache) and beyond.
+    """
+
+    def __init__(self, pool, layer, block_table=None, cache_size=0):
+        self.pool = pool
+        self.layer = layer
+        self.seq_size_dim = pool.seq_size_dim
+        self.block_table = [] if block_table is None else block_table
+
+        # Leading blocks of the table may be already filled (e.g., by a
+        # prefix cache)
+        self.k_cache_size = cache_size
+        self.v_cache_size = cache_size
+
+    def append(self, k_partial, v_partial):
+        assert (
+            k_partial.shape[self.seq_size_dim]
+            == v_partial.shape[self.seq_size_dim]
+        )
+        new_size = self.k_cache_size + k_partial.shape[self.seq_size_dim]
+        num_blocks = (
+            new_size + self.pool.block_size - 1
+        ) // self.pool.block_size
+        # Block table is shared by layers, so only the first layer to reach
+        # a new block allocates it
+        while len(self.block_table) < num_blocks:
+            self.block_table.append(self.pool.allocate())
+
+        k, v = self.pool.get_layer(self.layer, k_partial, v_partial)
+        offset = [0] * len(k.shape)
+        offset[self.seq_size_dim] = self.k_cache_size
+        copy_intersection_async(
+            k_partial, offset, self._view(k, num_blocks), [0] * len(offset)
+        )
+        copy_intersection_async(
+            v_partial, offset, self._view(v, num_blocks), [0] * len(offset)
+        )
+        self.k_cache_size = new_size
+        self.v_cache_size = new_size
+
+    def _view(self, tensor, num_blocks):
+        return type(tensor)(
+            tensor, self.seq_size_dim, self.block_table[:num_blocks]
+        )
+
+    def _num_blocks(self):
+        return (
+            self.k_cache_size + self.pool.block_size - 1
+        ) // self.pool.block_size
+
+    @property
+    def k_view(self):
+        # Blocks of the sequence, shared with the pool
+        return self._view(self.pool.k[self.layer], self._num_blocks())
+
+    @property
+    def v_view(self):
+        # Blocks of the sequence, shared with the pool
+        return self._view(self.pool.v[self.layer], self._num_blocks())
+
+    def truncate(self, size):
+        # Blocks stay in the block table and are filled again by append
+        self.k_cache_size = min(self.k_cache_size, size)
+        self.v_cache_size = min(self.v_cache_size, size)
+
+    def __len__(self):
+        return self.k_cache_size
+
+
+class PrefixCache:
+    """
+    Cache of keys and values of common prompt prefixes
+
+    Radix tree over full blocks of tokens of a KVBlockPool: a node keeps a
+    block with keys and values of all layers for its tokens, given the tokens
+    of all its ancestors. Blocks are shared with sequences by reference
+    counting, so a new sequence takes blocks of its longest cached prefix
+    without any copy and prefills only the rest of the prompt.
+
+    At most max_blocks blocks are kept. Least recently used leaves are
+    evicted first, both to meet the budget and to give blocks back to the
+    exhausted pool.
+    """
+
+    class _Node:
+        def __init__(self, parent, tokens, block):
+            self.parent = parent
+            self.tokens = tokens
+            self.block = block
+            self.children = {}
+            self.last_access = 0
+
+    def __init__(self, pool, max_blocks=None):
+        self.pool = pool
+        self.max_blocks = pool.num_blocks if max_blocks is None else max_blocks
+        self.root = self._Node(None, (), None)
+        self.num_blocks = 0
+        self._clock = 0
+        pool.prefix_cache = self
+
+    def _touch(self, node):
+        self._clock += 1
+        node.last_access = self._clock
+
+    def _blocks(self, token_ids, num_tokens):
+        block_size = self.pool.block_size
+        for i in range(num_tokens // block_size):
+            yield tuple(
+                int(t) for t in token_ids[i * block_size:(i + 1) * block_size]
+            )
+
+    def match(self, token_ids):
+        """
+        Blocks of the longest cached prefix of token_ids
+
+        The last token is never matched, as its logits are required to
+        continue generation. A reference to every returned block is taken on
+        behalf of the caller.
+        """
+        node = self.root
+        blocks = []
+        for tokens in self._blocks(token_ids, len(token_ids) - 1):
+            node = node.children.get(tokens)
+            if node is None:
+                break
+            self._touch(node)
+            blocks.append(node.block)
+        self.pool.share(blocks)
+        return blocks
+
+    def insert(self, token_ids, block_table):
+        """
+        Remember full blocks of token_ids, that are stored in block_table
+
+        Keys and values of all token_ids shall be already computed. Blocks,
+        that are already cached for the same prefix, are kept as is.
+        """
+        node = self.root
+        for tokens, block in zip(
+            self._blocks(token_ids, len(token_ids)), block_table
+        ):
+            child = node.children.get(tokens)
+            if child is None:
+                child = self._Node(node, tokens, block)
+                node.children[tokens] = child
+                self.pool.share([block])
+                self.num_blocks += 1
+            self._touch(child)
+            node = child
+        self.evict(self.num_blocks - self.max_blocks)
+
+    def evict(self, num_blocks, unused_only=False):
+        """
+        Drop up to num_blocks least recently used leaves of the tree
+
+        If unused_only is set, only leaves, that are not shared with any
+        sequence, are dropped, so that their blocks return to the pool.
+        """
+        ref_counts = self.pool.ref_counts
+        while num_blocks > 0:
+            leaves = []
+            stack = [self.root]
+            while stack:
+                node = stack.pop()
+                stack.extend(node.children.values())
+                if node.children or node is self.root:
+                    continue
+                if not unused_only or ref_counts[node.block] == 1:
+                    leaves.append(node)
+            if not leaves:
+                return
+            leaves.sort(key=lambda node: node.last_access)
+            for leaf in leaves[:num_blocks]:
+                del leaf.parent.children[leaf.tokens]
+                self.pool.free([leaf.block])
+                self.num_blocks -= 1
+                num_blocks -= 1
+
+    def clear(self):
+        self.evict(self.num_blocks)
+
+
 class KVCache:
     """
     Stores all keys and values in preallocated tensors of big size
+
+    Preallocated tensors are split into tiles of block_size positions. Views
+    k_view and v_view share leading tiles with the cache without copying, so
+    they may hold a few more positions than len(cache). Attention shall mask
+    out keys at positions len(cache) and beyond.
     """
 
-    def __init__(self, max_cache_size, seq_size_dim):
+    def __init__(self, max_cache_size, seq_size_dim, block_size=None):
         self.max_cache_size = max_cache_size
         self.seq_size_dim = seq_size_dim
+        self.block_size = block_size or max_cache_size
 
         self.k = None
         self.v = None
+        # Buffers to reorder the cache into, see reorder
+        self.k_spare = None
+        self.v_spare = None
 
         self.k_cache_size = 0
         self.v_cache_size = 0
@@ -133,7 +576,7 @@ class KVCache:
         cached_shape[self.seq_size_dim] = self.max_cache_size
 
         cached_basetile_shape = tensor.basetile_shape
-        cached_basetile_shape[self.seq_size_dim] = self.max_cache_size
+        cached_basetile_shape[self.seq_size_dim] = self.block_size
 
         init_cache_tensor = nntc.zeros(
             cached_shape,
@@ -164,6 +607,23 @@ class KVCache:
         )
         self.v_cache_size += v_partial.shape[self.seq_size_dim]
 
+    def _view(self, tensor, cache_size):
+        grid_shape = tensor.grid.shape
+        grid_shape[self.seq_size_dim] = (
+            cache_size + self.block_size - 1
+        ) // self.block_size
+        return type(tensor)(tensor, grid_shape)
+
+    @property
+    def k_view(self):
+        # Leading tiles of the cache, shared with the cache itself
+        return self._view(self.k, self.k_cache_size)
+
+    @property
+    def v_view(self):
+        # Leading tiles of the cache, shared with the cache itself
+        return self._view(self.v, self.v_cache_size)
+
     @property
     def k_partial(self):
         # For correct softmax we should next use only currently cached seq_size
@@ -200,16 +660,396 @@ class KVCache:
         copy_intersection_async(self.v, [0, 0, 0, 0], v_partial, [0, 0, 0, 0])
         return v_partial
 
+    def _reorder(self, tensor, spare, cache_size, index, batch_dim):
+        shape = tensor.shape
+        shape[batch_dim] = index.shape[0]
+        if spare is None or spare.shape != shape:
+            if spare is not None:
+                spare.unregister()
+            basetile_shape = tensor.basetile_shape
+            basetile_shape[batch_dim] = shape[batch_dim]
+            # Tiles beyond cached positions are not copied, so they are
+            # zeroed once to keep masked out values finite
+            spare = nntc.zeros(
+                shape, dtype=type(tensor), basetile_shape=basetile_shape
+            )
+        index_select_async(
+            index,
+            self._view(tensor, cache_size),
+            self._view(spare, cache_size),
+            batch_dim,
+        )
+        # The old cache becomes a buffer for the next reorder
+        return spare, tensor
+
+    def reorder(self, index, batch_dim=2):
+        """
+        Gather caches of sequences of a batch by indices on device
+
+        Sequence j of the new batch continues sequence index[j] of the old
+        one, e.g., a beam continues its parent beam. index is an int64 tensor
+        of shape (new_batch_size,), that is usually produced by tasks, so the
+        host does not wait for it. Keys and values are of shape
+        (head_size, seq_size, batch_size, n_head), only tiles with cached
+        positions are copied and two buffers are swapped instead of
+        allocating a new cache for every reorder.
+        """
+        self.k, self.k_spare = self._reorder(
+            self.k, self.k_spare, self.k_cache_size, index, batch_dim
+        )
+        self.v, self.v_spare = self._reorder(
+            self.v, self.v_spare, self.v_cache_size, index, batch_dim
+        )
+
+    def clear(self):
+        self.k = None
+        self.v = None
+        self.k_spare = None
+        self.v_spare = None
+        self.k_cache_size = 0
+        self.v_cache_size = 0
+
+    def truncate(self, size):
+        # Positions beyond size are masked out and overwritten by append
+        self.k_cache_size = min(self.k_cache_size, size)
+        self.v_cache_size = min(self.v_cache_size, size)
+
+    def __len__(self):
+        return self.k_cache_size
+
+
+class QuantizedKVCache:
+    """
+    Stores all keys and values in preallocated int8 tensors of big size
+
+    Every head of every token is quantized with its own scale on append, so
+    old positions are never requantized and the cache takes a quarter (or a
+    half for 16-bit types) of the memory of KVCache plus a scale per head.
+    Views k_view and v_view share leading tiles of a full precision buffer,
+    that is kept between steps. Only tiles with positions appended since the
+    previous view are dequantized into it, so a decoding step does not pass
+    over the whole cache. Attention shall mask out keys at positions
+    len(cache) and beyond.
+    """
+
+    def __init__(self, max_cache_size, seq_size_dim, block_size=None):
+        self.max_cache_size = max_cache_size
+        self.seq_size_dim = seq_size_dim
+        self.block_size = block_size or max_cache_size
+
+        self.k = None
+        self.v = None
+        self.k_scale = None
+        self.v_scale = None
+        # Dequantized keys and values, up to date for first *_ready positions
+        self.k_fp = None
+        self.v_fp = None
+        self.k_ready = 0
+        self.v_ready = 0
+
+        self.k_cache_size = 0
+        self.v_cache_size = 0
+
+    def _init_from_tensor(self, tensor):
+        cached_shape = tensor.shape
+        cached_shape[self.seq_size_dim] = self.max_cache_size
+
+        cached_basetile_shape = tensor.basetile_shape
+        cached_basetile_shape[self.seq_size_dim] = self.block_size
+
+        # Garbage in padding is multiplied by zero scales
+        cache = nntc.empty(
+            cached_shape,
+            dtype=Tensor_int8,
+            basetile_shape=cached_basetile_shape,
+        )
+        scale = nntc.zeros(
+            cached_shape[1:],
+            dtype=type(tensor),
+            basetile_shape=cached_basetile_shape[1:],
+        )
+        return cache, scale
+
+    def _append(self, cache, scale, partial, cache_size):
+        # Quantize new positions as is and put them into the cache
+        partial_q = nntc.empty(
+            partial.shape,
+            dtype=Tensor_int8,
+            basetile_shape=partial.basetile_shape,
+        )
+        partial_scale = nntc.empty(
+            partial.shape[1:],
+            dtype=type(partial),
+            basetile_shape=partial.basetile_shape[1:],
+        )
+        quantize_async(partial, partial_q, partial_scale)
+        offset = [0] * len(partial.shape)
+        offset[self.seq_size_dim] = cache_size
+        copy_intersection_async(partial_q, offset, cache, [0] * len(offset))
+        copy_intersection_async(
+            partial_scale, offset[1:], scale, [0] * (len(offset) - 1)
+        )
+        partial_q.unregister()
+        partial_scale.unregister()
+
+    def append(self, k_partial, v_partial):
+        assert (
+            k_partial.shape[self.seq_size_dim]
+            == v_partial.shape[self.seq_size_dim]
+        )
+
+        if not self.k:
+            self.k, self.k_scale = self._init_from_tensor(k_partial)
+            self.v, self.v_scale = self._init_from_tensor(v_partial)
+
+        self._append(self.k, self.k_scale, k_partial, self.k_cache_size)
+        self.k_cache_size += k_partial.shape[self.seq_size_dim]
+
+        self._append(self.v, self.v_scale, v_partial, self.v_cache_size)
+        self.v_cache_size += v_partial.shape[self.seq_size_dim]
+
+    def _view(self, cache, scale, buffer, cache_size, ready):
+        if buffer is None:
+            buffer = nntc.empty(
+                cache.shape,
+                dtype=type(scale),
+                basetile_shape=cache.basetile_shape,
+            )
+        num_tiles = (cache_size + self.block_size - 1) // self.block_size
+        # A tile, that was only partially appended, is dequantized again
+        tiles = list(range(ready // self.block_size, num_tiles))
+        if tiles:
+            dim = self.seq_size_dim
+            dequantize_async(
+                type(cache)(cache, dim, tiles),
+                type(scale)(scale, dim - 1, tiles),
+                type(buffer)(buffer, dim, tiles),
+            )
+        grid_shape = buffer.grid.shape
+        grid_shape[self.seq_size_dim] = num_tiles
+        return buffer, type(buffer)(buffer, grid_shape)
+
+    @property
+    def k_view(self):
+        # Leading tiles of the dequantized buffer, shared with the buffer
+        self.k_fp, view = self._view(
+            self.k, self.k_scale, self.k_fp, self.k_cache_size, self.k_ready
+        )
+        self.k_ready = self.k_cache_size
+        return view
+
+    @property
+    def v_view(self):
+        # Leading tiles of the dequantized buffer, shared with the buffer
+        self.v_fp, view = self._view(
+            self.v, self.v_scale, self.v_fp, self.v_cache_size, self.v_ready
+        )
+        self.v_ready = self.v_cache_size
+        return view
+
     def clear(self):
         self.k = None
         self.v = None
+        self.k_scale = None
+        self.v_scale = None
+        self.k_fp = None
+        self.v_fp = None
+        self.k_ready = 0
+        self.v_ready = 0
         self.k_cache_size = 0
         self.v_cache_size = 0
 
+    def truncate(self, size):
+        # Positions beyond size are masked out and overwritten by append
+        self.k_cache_size = min(self.k_cache_size, size)
+        self.v_cache_size = min(self.v_cache_size, size)
+        self.k_ready = min(self.k_ready, size)
+        self.v_ready = min(self.v_ready, size)
+
     def __len__(self):
         return self.k_cache_size
 
 
+class SinkKVCache:
+    """
+    Bounded cache of attention sinks and a sliding window (StreamingLLM)
+
+    The first sink_size positions of a sequence are kept forever, and only
+    the last window_size positions are kept after them, so memory and cost
+    of attention per token stay constant for arbitrarily long generation.
+    Positions of tokens change on eviction, so keys are stored before RoPE
+    and attention rotates them by their slots in the cache. The window is a
+    ring buffer, views k_view and v_view gather the sinks and the window in
+    order of positions into new tensors. A single append shall not exceed
+    window_size positions (see prefill_chunk_size of GenerationParams).
+    """
+
+    def __init__(
+        self,
+        max_cache_size,
+        seq_size_dim,
+        block_size=None,
+        sink_size=4,
+        window_size=None,
+    ):
+        if window_size is None:
+            window_size = max_cache_size - sink_size
+        if sink_size < 0 or window_size <= 0:
+            raise Exception("sink_size < 0 or window_size <= 0")
+        if sink_size + window_size > max_cache_size:
+            raise Exception(
+                f"sink_size + window_size > max_cache_size: {sink_size} + "
+                f"{window_size} > {max_cache_size}"
+            )
+        self.max_cache_size = max_cache_size
+        self.seq_size_dim = seq_size_dim
+        self.block_size = min(block_size or window_size, window_size)
+        self.sink_size = sink_size
+        self.window_size = window_size
+
+        self.k_sink = None
+        self.v_sink = None
+        self.k_window = None
+        self.v_window = None
+
+        # Number of positions ever appended
+        self.num_tokens = 0
+
+    def _init_from_tensor(self, tensor, size):
+        shape = tensor.shape
+        shape[self.seq_size_dim] = size
+        basetile_shape = tensor.basetile_shape
+        basetile_shape[self.seq_size_dim] = min(self.block_size, size)
+        return nntc.zeros(
+            shape, dtype=type(tensor), basetile_shape=basetile_shape
+        )
+
+    def _offset(self, tensor, position):
+        offset = [0] * len(tensor.shape)
+        offset[self.seq_size_dim] = position
+        return offset
+
+    def _append(self, sink, window, partial):
+        size = partial.shape[self.seq_size_dim]
+        zero = self._offset(partial, 0)
+        # Position i of the sequence is position i of the sinks
+        num_sink = min(size, max(self.sink_size - self.num_tokens, 0))
+        if num_sink > 0:
+            copy_intersection_async(
+                partial, self._offset(partial, self.num_tokens), sink, zero
+            )
+        num_window = size - num_sink
+        if num_window == 0:
+            return
+        # Position sink_size+i of the sequence is slot i%window_size of the
+        # window, so new positions are split into two copies on wrap
+        slot = (self.num_tokens + num_sink - self.sink_size) % self.window_size
+        copy_intersection_async(
+            partial, self._offset(partial, slot - num_sink), window, zero
+        )
+        if slot + num_window > self.window_size:
+            copy_intersection_async(
+                partial,
+                self._offset(partial, slot - num_sink - self.window_size),
+                window,
+                zero,
+            )
+
+    def append(self, k_partial, v_partial):
+        assert (
+            k_partial.shape[self.seq_size_dim]
+            == v_partial.shape[self.seq_size_dim]
+        )
+        size = k_partial.shape[self.seq_size_dim]
+        num_sink = max(self.sink_size - self.num_tokens, 0)
+        if size - num_sink > self.window_size:
+            raise Exception(
+                f"Can not append {size} positions to a window of "
+                f"{self.window_size} positions, split the input into chunks"
+            )
+
+        if not self.k_window:
+            if self.sink_size > 0:
+                self.k_sink = self._init_from_tensor(k_partial, self.sink_size)
+                self.v_sink = self._init_from_tensor(v_partial, self.sink_size)
+            self.k_window = self._init_from_tensor(k_partial, self.window_size)
+            self.v_window = self._init_from_tensor(v_partial, self.window_size)
+
+        self._append(self.k_sink, self.k_window, k_partial)
+        self._append(self.v_sink, self.v_window, v_partial)
+        self.num_tokens += size
+
+    def len_after_append(self, size):
+        """Number of cached positions after append of size positions"""
+        return min(self.num_tokens + size, self.sink_size + self.window_size)
+
+    def _view(self, sink, window):
+        cache_size = len(self)
+        shape = window.shape
+        shape[self.seq_size_dim] = cache_size
+        basetile_shape = window.basetile_shape
+        basetile_shape[self.seq_size_dim] = min(self.block_size, cache_size)
+        view = nntc.empty(
+            shape, dtype=type(window), basetile_shape=basetile_shape
+        )
+        zero = self._offset(view, 0)
+        num_window = cache_size - min(self.num_tokens, self.sink_size)
+        if num_window > 0:
+            # The oldest position of a full window is at the next slot, so
+            # the window is gathered by two copies. The first one also puts
+            # garbage into positions of sinks, that are overwritten later.
+            start = 0
+            if self.num_tokens > self.sink_size + self.window_size:
+                start = (
+                    self.num_tokens - self.sink_size
+                ) % self.window_size
+            copy_intersection_async(
+                window, self._offset(window, self.sink_size - start), view,
+                zero
+            )
+            if start > 0:
+                copy_intersection_async(
+                    window,
+                    self._offset(
+                        window, self.sink_size + self.window_size - start
+                    ),
+                    view,
+                    zero,
+                )
+        if self.sink_size > 0:
+            copy_intersection_async(sink, zero, view, zero)
+        return view
+
+    @property
+    def k_view(self):
+        # Keys of all the cached positions before RoPE in a new tensor
+        return self._view(self.k_sink, self.k_window)
+
+    @property
+    def v_view(self):
+        # Values of all the cached positions in a new tensor
+        return self._view(self.v_sink, self.v_window)
+
+    def clear(self):
+        self.k_sink = None
+        self.v_sink = None
+        self.k_window = None
+        self.v_window = None
+        self.num_tokens = 0
+
+    def truncate(self, size):
+        # Evicted positions can not be restored, so only positions of the
+        # last append may be dropped
+        if size < self.num_tokens and (
+            self.num_tokens > self.sink_size + self.window_size
+        ):
+            raise Exception("Can not truncate a cache with evicted positions")
+        self.num_tokens = min(self.num_tokens, size)
+
+    def __len__(self):
+        return min(self.num_tokens, self.sink_size + self.window_size)
+
+
 class DynamicKVCache:
     """
     Stores all keys and values in python list
@@ -270,7 +1110,7 @@ class DynamicKVCache:
         k_partial_shape[self.seq_size_dim] = self.k_cache_size
         k_partial_basetile_shape[self.seq_size_dim] = self.k_cache_size
 
-        k_partial = nntc.zeros(
+        k_partial = nntc.empty(
             k_partial_shape,
             basetile_shape=k_partial_basetile_shape,
             dtype=type(self.k_buff[0]),
@@ -294,7 +1134,7 @@ class DynamicKVCache:
         v_partial_shape[self.seq_size_dim] = self.v_cache_size
         v_partial_basetile_shape[self.seq_size_dim] = self.v_cache_size
 
-        v_partial = nntc.zeros(
+        v_partial = nntc.empty(
             v_partial_shape,
             basetile_shape=v_partial_basetile_shape,
             dtype=type(self.v_buff[0]),
@@ -309,6 +1149,16 @@ class DynamicKVCache:
 
         return v_partial
 
+    @property
+    def k_view(self):
+        # Blocks are stored separately, so they are merged into a new tensor
+        return self.k_partial
+
+    @property
+    def v_view(self):
+        # Blocks are stored separately, so they are merged into a new tensor
+        return self.v_partial
+
     def clear(self):
         self.k_buff = []
         self.v_buff = []
@@ -350,7 +1200,7 @@ class DynamicKVCacheWithBase:
             self.base
         ) + len(self.head)
 
-        k_partial = nntc.zeros(
+        k_partial = nntc.empty(
             k_partial_shape,
             basetile_shape=k_partial_basetile_shape,
             dtype=type(self.base.k),
@@ -380,7 +1230,7 @@ class DynamicKVCacheWithBase:
             self.base
         ) + len(self.head)
 
-        v_partial = nntc.zeros(
+        v_partial = nntc.empty(
             v_partial_shape,
             basetile_shape=v_partial_basetile_shape,
             dtype=type(self.base.v),
@@ -399,6 +1249,16 @@ class DynamicKVCacheWithBase:
 
         return v_partial
 
+    @property
+    def k_view(self):
+        # Base and head are stored separately, so they are merged
+        return self.k_partial
+
+    @property
+    def v_view(self):
+        # Base and head are stored separately, so they are merged
+        return self.v_partial
+
 
 class ParallelSamplingKVCache:
     """
@@ -407,9 +1267,14 @@ class ParallelSamplingKVCache:
     """
 
     def __init__(
-        self, num_beams, max_cache_size, seq_size_dim, clone_input=False
+        self,
+        num_beams,
+        max_cache_size,
+        seq_size_dim,
+        clone_input=False,
+        block_size=None,
     ):
-        self.base = KVCache(max_cache_size, seq_size_dim)
+        self.base = KVCache(max_cache_size, seq_size_dim, block_size)
         self.num_beams = num_beams
         self.beams = [
             DynamicKVCacheWithBase(
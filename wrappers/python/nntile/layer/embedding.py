@@ -36,7 +36,8 @@ class Embedding(BaseLayer):
         self.x = x
         self.y = y
         self.w = w
-        self.w.grad.set_reduction_add()
+        if self.w.grad is not None:
+            self.w.grad.set_reduction_add()
         self.axis = axis
 
     # Simple generator for the embedding layer
@@ -50,6 +51,7 @@ class Embedding(BaseLayer):
         y_emb_tile: int,
         w_emb_tile: int,
         next_tag: int,
+        inference: bool = False,
     ):
         # Check embedding tile sizes
         if y_emb_tile % w_emb_tile != 0:
@@ -61,9 +63,12 @@ class Embedding(BaseLayer):
         w_distr = [0] * w_traits.grid.nelems
         w_value = TensorType(w_traits, w_distr, next_tag)
         next_tag = w_value.next_tag
-        w_grad = TensorType(w_traits, w_distr, next_tag)
-        next_tag = w_grad.next_tag
-        w = TensorMoments(w_value, w_grad, True)
+        if inference:
+            w = TensorMoments(w_value, None, False)
+        else:
+            w_grad = TensorType(w_traits, w_distr, next_tag)
+            next_tag = w_grad.next_tag
+            w = TensorMoments(w_value, w_grad, True)
         # Output embeddings
         y_shape = x.shape.copy()
         y_shape.insert(axis, emb_size)
@@ -73,9 +78,12 @@ class Embedding(BaseLayer):
         y_distr = [0] * y_traits.grid.nelems
         y_value = TensorType(y_traits, y_distr, next_tag)
         next_tag = y_value.next_tag
-        y_grid = TensorType(y_traits, y_distr, next_tag)
-        next_tag = y_grid.next_tag
-        y = TensorMoments(y_value, y_grid, True)
+        if inference:
+            y = TensorMoments(y_value, None, False)
+        else:
+            y_grid = TensorType(y_traits, y_distr, next_tag)
+            next_tag = y_grid.next_tag
+            y = TensorMoments(y_value, y_grid, True)
         # Create embedding layer with all the provided data
         layer = Embedding(x, y, w, axis)
         # Return layer and next tag to be used
@@ -96,7 +104,7 @@ class Embedding(BaseLayer):
         y_basetile = x.value.basetile_shape.copy()
         y_basetile.insert(self.axis, self.y.value.basetile_shape[self.axis])
 
-        y = nntc.empty(
+        y = nntc.scratch(
             y_shape, basetile_shape=y_basetile, dtype=type(self.w.value)
         )
         embedding_async(x.value, self.w.value, y, self.axis)
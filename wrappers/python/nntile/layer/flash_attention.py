@@ -84,16 +84,20 @@ class FlashAttention(BaseLayer):
         qkv_bias_list = []
         if in_proj_bias_q:
             qkv_bias_list.append(in_proj_bias_q)
-            in_proj_bias_q.grad.set_reduction_add()
+            if in_proj_bias_q.grad is not None:
+                in_proj_bias_q.grad.set_reduction_add()
         if in_proj_bias_k:
             qkv_bias_list.append(in_proj_bias_k)
-            in_proj_bias_k.grad.set_reduction_add()
+            if in_proj_bias_k.grad is not None:
+                in_proj_bias_k.grad.set_reduction_add()
         if in_proj_bias_v:
             qkv_bias_list.append(in_proj_bias_v)
-            in_proj_bias_v.grad.set_reduction_add()
+            if in_proj_bias_v.grad is not None:
+                in_proj_bias_v.grad.set_reduction_add()
         if out_proj_bias:
             bias_list_out_proj = [out_proj_bias]
-            out_proj_bias.grad.set_reduction_add()
+            if out_proj_bias.grad is not None:
+                out_proj_bias.grad.set_reduction_add()
         else:
             bias_list_out_proj = []
         # Redirect to BaseClass initialization
@@ -116,44 +120,57 @@ class FlashAttention(BaseLayer):
             ],
         )
         self.x_q = x_q
-        self.x_q.grad.set_reduction_add()
+        if self.x_q.grad is not None:
+            self.x_q.grad.set_reduction_add()
         self.x_k = x_k
-        self.x_k.grad.set_reduction_add()
+        if self.x_k.grad is not None:
+            self.x_k.grad.set_reduction_add()
         self.x_v = x_v
-        self.x_v.grad.set_reduction_add()
+        if self.x_v.grad is not None:
+            self.x_v.grad.set_reduction_add()
         self.y = y
         self.y.value.set_reduction_add()
         self.w_q = w_q
-        self.w_q.grad.set_reduction_add()
+        if self.w_q.grad is not None:
+            self.w_q.grad.set_reduction_add()
         self.w_k = w_k
-        self.w_k.grad.set_reduction_add()
+        if self.w_k.grad is not None:
+            self.w_k.grad.set_reduction_add()
         self.w_v = w_v
-        self.w_v.grad.set_reduction_add()
+        if self.w_v.grad is not None:
+            self.w_v.grad.set_reduction_add()
         self.w = w
-        self.w.grad.set_reduction_add()
+        if self.w.grad is not None:
+            self.w.grad.set_reduction_add()
         self.q_transposed = q_transposed
         self.q_transposed.value.set_reduction_add()
         self.q = q
-        self.q.grad.set_reduction_add()
+        if self.q.grad is not None:
+            self.q.grad.set_reduction_add()
         self.k_transposed = k_transposed
         self.k_transposed.value.set_reduction_add()
         self.k = k
-        self.k.grad.set_reduction_add()
+        if self.k.grad is not None:
+            self.k.grad.set_reduction_add()
         self.v_transposed = v_transposed
         self.v_transposed.value.set_reduction_add()
         self.v = v
-        self.v.grad.set_reduction_add()
+        if self.v.grad is not None:
+            self.v.grad.set_reduction_add()
         self.a = a
         self.a.value.set_reduction_add()
-        self.a.grad.set_reduction_add()
+        if self.a.grad is not None:
+            self.a.grad.set_reduction_add()
         self.a_maxsumexp = a_maxsumexp
         self.a_maxsumexp.set_reduction_maxsumexp()
         self.a_sumprod_slice = a_sumprod_slice
-        self.a_sumprod_slice.set_reduction_add()
+        if self.a_sumprod_slice is not None:
+            self.a_sumprod_slice.set_reduction_add()
         self.b = b
         self.b.value.set_reduction_add()
         self.b_transposed = b_transposed
-        self.b_transposed.grad.set_reduction_add()
+        if self.b_transposed.grad is not None:
+            self.b_transposed.grad.set_reduction_add()
         self.in_proj_bias_q = in_proj_bias_q
         self.in_proj_bias_k = in_proj_bias_k
         self.in_proj_bias_v = in_proj_bias_v
@@ -185,6 +202,7 @@ class FlashAttention(BaseLayer):
         bias=False,
         mask=None,
         redux: bool = False,
+        inference: bool = False,
     ):
         # Get sizes
         n_emb, n_seq, n_batch = x_q.value.shape
@@ -309,160 +327,132 @@ class FlashAttention(BaseLayer):
                 [head_size, n_head], [head_size_tile, n_head_tile]
             )
             in_proj_bias_qkv_distr = [0] * in_proj_bias_qkv_traits.grid.nelems
+        # Gradients are not allocated in the inference mode
+        def moments(value, traits, distr):
+            nonlocal next_tag
+            if inference:
+                return TensorMoments(value, None, False)
+            grad = type(x_q.value)(traits, distr, next_tag)
+            next_tag = grad.next_tag
+            return TensorMoments(value, grad, True)
+
         # Define all the lists
         # w_q
         w_q_value = type(x_q.value)(w_q_traits, w_q_distr, next_tag)
         next_tag = w_q_value.next_tag
-        w_q_grad = type(x_q.value)(w_q_traits, w_q_distr, next_tag)
-        next_tag = w_q_grad.next_tag
-        w_q = TensorMoments(w_q_value, w_q_grad, True)
+        w_q = moments(w_q_value, w_q_traits, w_q_distr)
         if bias:
             in_proj_bias_q_value = type(x_q.value)(
                 in_proj_bias_qkv_traits, in_proj_bias_qkv_distr, next_tag
             )
             next_tag = in_proj_bias_q_value.next_tag
-            in_proj_bias_q_grad = type(x_q.value)(
-                in_proj_bias_qkv_traits, in_proj_bias_qkv_distr, next_tag
-            )
-            next_tag = in_proj_bias_q_grad.next_tag
-            bias_inproj_q = TensorMoments(
-                in_proj_bias_q_value, in_proj_bias_q_grad, True
+            bias_inproj_q = moments(
+                in_proj_bias_q_value,
+                in_proj_bias_qkv_traits,
+                in_proj_bias_qkv_distr,
             )
         else:
             bias_inproj_q = None
         # w_k
         w_k_value = type(x_q.value)(w_k_traits, w_k_distr, next_tag)
         next_tag = w_k_value.next_tag
-        w_k_grad = type(x_q.value)(w_k_traits, w_k_distr, next_tag)
-        next_tag = w_k_grad.next_tag
-        w_k = TensorMoments(w_k_value, w_k_grad, True)
+        w_k = moments(w_k_value, w_k_traits, w_k_distr)
         if bias:
             in_proj_bias_k_value = type(x_q.value)(
                 in_proj_bias_qkv_traits, in_proj_bias_qkv_distr, next_tag
             )
             next_tag = in_proj_bias_k_value.next_tag
-            in_proj_bias_k_grad = type(x_q.value)(
-                in_proj_bias_qkv_traits, in_proj_bias_qkv_distr, next_tag
-            )
-            next_tag = in_proj_bias_k_grad.next_tag
-            bias_inproj_k = TensorMoments(
-                in_proj_bias_k_value, in_proj_bias_k_grad, True
+            bias_inproj_k = moments(
+                in_proj_bias_k_value,
+                in_proj_bias_qkv_traits,
+                in_proj_bias_qkv_distr,
             )
         else:
             bias_inproj_k = None
         # w_v
         w_v_value = type(x_q.value)(w_v_traits, w_v_distr, next_tag)
         next_tag = w_v_value.next_tag
-        w_v_grad = type(x_q.value)(w_v_traits, w_v_distr, next_tag)
-        next_tag = w_v_grad.next_tag
-        w_v = TensorMoments(w_v_value, w_v_grad, True)
+        w_v = moments(w_v_value, w_v_traits, w_v_distr)
         if bias:
             in_proj_bias_v_value = type(x_q.value)(
                 in_proj_bias_qkv_traits, in_proj_bias_qkv_distr, next_tag
             )
             next_tag = in_proj_bias_v_value.next_tag
-            in_proj_bias_v_grad = type(x_q.value)(
-                in_proj_bias_qkv_traits, in_proj_bias_qkv_distr, next_tag
-            )
-            next_tag = in_proj_bias_v_grad.next_tag
-            bias_inproj_v = TensorMoments(
-                in_proj_bias_v_value, in_proj_bias_v_grad, True
+            bias_inproj_v = moments(
+                in_proj_bias_v_value,
+                in_proj_bias_qkv_traits,
+                in_proj_bias_qkv_distr,
             )
         else:
             bias_inproj_v = None
         # w
         w_value = type(x_q.value)(w_traits, w_distr, next_tag)
         next_tag = w_value.next_tag
-        w_grad = type(x_q.value)(w_traits, w_distr, next_tag)
-        next_tag = w_grad.next_tag
-        w = TensorMoments(w_value, w_grad, True)
+        w = moments(w_value, w_traits, w_distr)
         # q_transposed
         q_transposed_value = type(x_q.value)(
             q_transposed_traits, q_transposed_distr, next_tag
         )
         next_tag = q_transposed_value.next_tag
-        q_transposed_grad = type(x_q.value)(
-            q_transposed_traits, q_transposed_distr, next_tag
-        )
-        next_tag = q_transposed_grad.next_tag
-        q_transposed = TensorMoments(
-            q_transposed_value, q_transposed_grad, True
+        q_transposed = moments(
+            q_transposed_value, q_transposed_traits, q_transposed_distr
         )
         # q
         q_value = type(x_q.value)(q_traits, q_distr, next_tag)
         next_tag = q_value.next_tag
-        q_grad = type(x_q.value)(q_traits, q_distr, next_tag)
-        next_tag = q_grad.next_tag
-        q = TensorMoments(q_value, q_grad, True)
+        q = moments(q_value, q_traits, q_distr)
         # k_transposed
         k_transposed_value = type(x_q.value)(
             k_transposed_traits, k_transposed_distr, next_tag
         )
         next_tag = k_transposed_value.next_tag
-        k_transposed_grad = type(x_q.value)(
-            k_transposed_traits, k_transposed_distr, next_tag
-        )
-        next_tag = k_transposed_grad.next_tag
-        k_transposed = TensorMoments(
-            k_transposed_value, k_transposed_grad, True
+        k_transposed = moments(
+            k_transposed_value, k_transposed_traits, k_transposed_distr
         )
         # k
         k_value = type(x_q.value)(k_traits, k_distr, next_tag)
         next_tag = k_value.next_tag
-        k_grad = type(x_q.value)(k_traits, k_distr, next_tag)
-        next_tag = k_grad.next_tag
-        k = TensorMoments(k_value, k_grad, True)
+        k = moments(k_value, k_traits, k_distr)
         # v_transposed
         v_transposed_value = type(x_q.value)(
             v_transposed_traits, v_transposed_distr, next_tag
         )
         next_tag = v_transposed_value.next_tag
-        v_transposed_grad = type(x_q.value)(
-            v_transposed_traits, v_transposed_distr, next_tag
-        )
-        next_tag = v_transposed_grad.next_tag
-        v_transposed = TensorMoments(
-            v_transposed_value, v_transposed_grad, True
+        v_transposed = moments(
+            v_transposed_value, v_transposed_traits, v_transposed_distr
         )
         # v
         v_value = type(x_q.value)(v_traits, v_distr, next_tag)
         next_tag = v_value.next_tag
-        v_grad = type(x_q.value)(v_traits, v_distr, next_tag)
-        next_tag = v_grad.next_tag
-        v = TensorMoments(v_value, v_grad, True)
+        v = moments(v_value, v_traits, v_distr)
         # a
         a_value = type(x_q.value)(a_traits, a_distr, next_tag)
         next_tag = a_value.next_tag
-        a_grad = type(x_q.value)(a_traits, a_distr, next_tag)
-        next_tag = a_grad.next_tag
-        a = TensorMoments(a_value, a_grad, True)
+        a = moments(a_value, a_traits, a_distr)
         # a_maxsumexp
         a_maxsumexp = type(x_q.value)(
             a_maxsumexp_traits, a_maxsumexp_distr, next_tag
         )
         next_tag = a_maxsumexp.next_tag
-        # a_sumprod_slice
-        a_sumprod_slice = type(x_q.value)(
-            a_sumprod_slice_traits, a_sumprod_slice_distr, next_tag
-        )
-        next_tag = a_sumprod_slice.next_tag
+        # a_sumprod_slice is needed only by backward
+        if inference:
+            a_sumprod_slice = None
+        else:
+            a_sumprod_slice = type(x_q.value)(
+                a_sumprod_slice_traits, a_sumprod_slice_distr, next_tag
+            )
+            next_tag = a_sumprod_slice.next_tag
         # b
         b_value = type(x_q.value)(b_traits, b_distr, next_tag)
         next_tag = b_value.next_tag
-        b_grad = type(x_q.value)(b_traits, b_distr, next_tag)
-        next_tag = b_grad.next_tag
-        b = TensorMoments(b_value, b_grad, True)
+        b = moments(b_value, b_traits, b_distr)
         # b_transposed
         b_transposed_value = type(x_q.value)(
             b_transposed_traits, b_transposed_distr, next_tag
         )
         next_tag = b_transposed_value.next_tag
-        b_transposed_grad = type(x_q.value)(
-            b_transposed_traits, b_transposed_distr, next_tag
-        )
-        next_tag = b_transposed_grad.next_tag
-        b_transposed = TensorMoments(
-            b_transposed_value, b_transposed_grad, True
+        b_transposed = moments(
+            b_transposed_value, b_transposed_traits, b_transposed_distr
         )
         # Allocate tensors for bias for q, k, v and output projection
         if bias:
@@ -472,12 +462,8 @@ class FlashAttention(BaseLayer):
                 out_proj_bias_traits, out_proj_bias_distr, next_tag
             )
             next_tag = out_proj_bias_value.next_tag
-            out_proj_bias_grad = type(x_q.value)(
-                out_proj_bias_traits, out_proj_bias_distr, next_tag
-            )
-            next_tag = out_proj_bias_grad.next_tag
-            out_proj_bias = TensorMoments(
-                out_proj_bias_value, out_proj_bias_grad, True
+            out_proj_bias = moments(
+                out_proj_bias_value, out_proj_bias_traits, out_proj_bias_distr
             )
         else:
             out_proj_bias = None
@@ -485,9 +471,7 @@ class FlashAttention(BaseLayer):
         y_traits = TensorTraits(x_q.value.shape, x_q.value.basetile_shape)
         y_value = type(x_q.value)(y_traits, x_q.value.distribution, next_tag)
         next_tag = y_value.next_tag
-        y_grad = type(x_q.value)(y_traits, x_q.value.distribution, next_tag)
-        next_tag = y_grad.next_tag
-        y = TensorMoments(y_value, y_grad, True)
+        y = moments(y_value, y_traits, x_q.value.distribution)
         # Create attention layer with all the provided data
         layer = FlashAttention(
             x_q,
@@ -16,12 +16,14 @@ import torch
 from transformers.models.gpt2.modeling_gpt2 import (
     GPT2Attention as GPT2Attention_torch, GPT2Config as GPT2Config_torch)
 
+import nntile.utils.constructors as nntc
 from nntile.layer.base_layer import BaseLayer
 from nntile.tensor import (
     Tensor, Tensor_bool, TensorMoments, TensorTraits, add_fiber_inplace_async,
     add_slice_inplace_async, clear_async, gemm_async, mask_scalar_async,
-    maxsumexp_async, notrans, prod_inplace_async, softmax_inplace_async,
-    sum_fiber_async, sumprod_slice_async, to_numpy, trans, transpose_async)
+    mask_scalar_causal_async, maxsumexp_async, notrans, prod_inplace_async,
+    softmax_inplace_async, sum_fiber_async, sumprod_slice_async, to_numpy,
+    trans, transpose_async)
 
 from ..model.gpt2_config import GPT2ConfigNNTile
 
@@ -83,7 +85,8 @@ class GPT2Attention(BaseLayer):
         in_proj_bias_v: TensorMoments,
         out_proj_bias: TensorMoments,
         mask=None,
-        redux: bool = False
+        redux: bool = False,
+        mask_causal: bool = False,
         ):
         qkv_bias_list = []
         if in_proj_bias_q:
@@ -171,8 +174,16 @@ class GPT2Attention(BaseLayer):
             raise RuntimeError
         self.head_size = head_size
         self.mask = mask
-        if mask:
+        # Causal mask is evaluated arithmetically from positions of keys and
+        # queries, so it is neither stored nor read
+        self.mask_causal = mask_causal
+        self.mask_tile_status = []
+        if mask or mask_causal:
             self.val = -np.float32(np.inf)
+        if mask:
+            # Tasks for entirely masked out tiles (e.g., upper blocks of a
+            # causal mask) are not submitted at all
+            self.mask_tile_status = nntc.mask_tile_status(mask)
         if redux:
             self.redux = 1
         else:
@@ -562,7 +573,11 @@ class GPT2Attention(BaseLayer):
         next_tag = y_grad.next_tag
         y = TensorMoments(y_value, y_grad, True)
         # Mask
-        if mask is not None:
+        mask_causal = mask is not None and np.array_equal(
+            np.asarray(mask, dtype=bool),
+            np.triu(np.ones((n_seq, n_seq), dtype=bool))
+        )
+        if mask is not None and not mask_causal:
             layer_mask_shape = [n_seq, n_seq]
             layer_mask_basetile = [n_seq_tile, n_seq_tile]
             layer_mask_traits = TensorTraits(
@@ -583,7 +598,7 @@ class GPT2Attention(BaseLayer):
                 q_transposed, q, k_transposed, k, v_transposed,
                 v, a, a_maxsumexp, a_sumprod_slice, b, b_transposed,
                 bias_inproj_q, bias_inproj_k, bias_inproj_v, out_proj_bias,
-                layer_mask, redux=redux)
+                layer_mask, redux=redux, mask_causal=mask_causal)
         # Return layer and next tag to be used
         return (layer, next_tag)
 
@@ -665,8 +680,11 @@ class GPT2Attention(BaseLayer):
         # Calculate softmax inplace
         # A = softmax(A, axis=0)
         # Apply mask if needed
-        if self.mask:
-            mask_scalar_async(self.mask, self.val, self.a.value, 2)
+        if self.mask_causal:
+            mask_scalar_causal_async(0, 0, -1, self.val, self.a.value, 2)
+        elif self.mask:
+            mask_scalar_async(self.mask, self.val, self.a.value, 2,
+                              self.mask_tile_status)
             self.mask.wont_use()
         # Calculate max and sumexp along axis
         maxsumexp_async(self.a.value, self.a_maxsumexp, 0, redux=self.redux)
@@ -774,8 +792,11 @@ class GPT2Attention(BaseLayer):
         # self.a.value.wont_use()
         self.a.value.invalidate_submit()
         # Backward for mask if needed
-        if self.mask:
-            mask_scalar_async(self.mask, 0, self.a.grad, 2)
+        if self.mask_causal:
+            mask_scalar_causal_async(0, 0, -1, 0, self.a.grad, 2)
+        elif self.mask:
+            mask_scalar_async(self.mask, 0, self.a.grad, 2,
+                              self.mask_tile_status)
             self.mask.wont_use()
         # Backward for:
         # A = 1.0/sqrt(head_size) * einsum('jklb,jmlb->kmlb', K, Q)
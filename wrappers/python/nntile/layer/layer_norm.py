@@ -61,9 +61,11 @@ class LayerNorm(BaseLayer):
         self.x = x
         self.y = y
         self.gamma = gamma
-        self.gamma.grad.set_reduction_add()
+        if self.gamma.grad is not None:
+            self.gamma.grad.set_reduction_add()
         self.beta = beta
-        self.beta.grad.set_reduction_add()
+        if self.beta.grad is not None:
+            self.beta.grad.set_reduction_add()
         self.tmp_y_value = tmp_y_value
         self.tmp_y_grad = tmp_y_grad
         self.mean = mean
@@ -73,6 +75,9 @@ class LayerNorm(BaseLayer):
         self.axis = axis
         self.l = self.x.value.shape[axis]
         self.eps = eps**0.5  # This value is used to init deviation
+        # Gamma and beta are not applied if they are folded into the next
+        # layers
+        self.affine = True
         if redux:
             self.redux = 1
         else:
@@ -86,6 +91,7 @@ class LayerNorm(BaseLayer):
         eps: float,
         next_tag: int,
         redux: bool = False,
+        inference: bool = False,
     ):
         # Get traits of X
         x_traits = TensorTraits(x.value.shape, x.value.basetile_shape)
@@ -93,11 +99,14 @@ class LayerNorm(BaseLayer):
         x_distr = x.value.distribution
         y_value = type(x.value)(x_traits, x_distr, next_tag)
         next_tag = y_value.next_tag
-        # Create grad Y with the same traits and distribution as X
-        y_grad = type(x.value)(x_traits, x_distr, next_tag)
-        next_tag = y_grad.next_tag
-        # Wrap Y
-        y = TensorMoments(y_value, y_grad, True)
+        if inference:
+            y = TensorMoments(y_value, None, False)
+        else:
+            # Create grad Y with the same traits and distribution as X
+            y_grad = type(x.value)(x_traits, x_distr, next_tag)
+            next_tag = y_grad.next_tag
+            # Wrap Y
+            y = TensorMoments(y_value, y_grad, True)
         # Gamma parameter
         gamma_shape = [x.value.shape[axis]]
         gamma_basetile = [x.value.basetile_shape[axis]]
@@ -107,21 +116,30 @@ class LayerNorm(BaseLayer):
             gamma_distr.append(x_distr[x.value.grid.stride[axis] * i])
         gamma_value = type(x.value)(gamma_traits, gamma_distr, next_tag)
         next_tag = gamma_value.next_tag
-        gamma_grad = type(x.value)(gamma_traits, gamma_distr, next_tag)
-        next_tag = gamma_grad.next_tag
-        gamma = TensorMoments(gamma_value, gamma_grad, True)
+        if inference:
+            gamma = TensorMoments(gamma_value, None, False)
+        else:
+            gamma_grad = type(x.value)(gamma_traits, gamma_distr, next_tag)
+            next_tag = gamma_grad.next_tag
+            gamma = TensorMoments(gamma_value, gamma_grad, True)
         # Beta parameter
         beta_value = type(x.value)(gamma_traits, gamma_distr, next_tag)
         next_tag = beta_value.next_tag
-        beta_grad = type(x.value)(gamma_traits, gamma_distr, next_tag)
-        next_tag = beta_grad.next_tag
-        beta = TensorMoments(beta_value, beta_grad, True)
+        if inference:
+            beta = TensorMoments(beta_value, None, False)
+        else:
+            beta_grad = type(x.value)(gamma_traits, gamma_distr, next_tag)
+            next_tag = beta_grad.next_tag
+            beta = TensorMoments(beta_value, beta_grad, True)
         # Temporary tensor for normalized input
         tmp_y_value = type(x.value)(x_traits, x_distr, next_tag)
         next_tag = tmp_y_value.next_tag
         # Temporary tensor for gradient of normalized input
-        tmp_y_grad = type(x.value)(x_traits, x_distr, next_tag)
-        next_tag = tmp_y_grad.next_tag
+        if inference:
+            tmp_y_grad = None
+        else:
+            tmp_y_grad = type(x.value)(x_traits, x_distr, next_tag)
+            next_tag = tmp_y_grad.next_tag
         # Define auxiliary tensors to hold mean, inverse of stddev and scalar
         # products along given axis
         mean_shape = x.value.shape[:axis] + x.value.shape[axis + 1 :]
@@ -174,9 +192,10 @@ class LayerNorm(BaseLayer):
             self.axis,
             redux=self.redux,
         )
-        # Y = X - mean
+        # Y = X - mean (directly into Y if gamma and beta are folded)
+        tmp_y_value = self.tmp_y_value if self.affine else self.y.value
         add_slice_async(
-            -1.0, self.mean, 1.0, self.x.value, self.tmp_y_value, self.axis
+            -1.0, self.mean, 1.0, self.x.value, tmp_y_value, self.axis
         )
         # mean can be offloaded from GPU
         self.mean.wont_use()
@@ -186,7 +205,7 @@ class LayerNorm(BaseLayer):
         # fill_async(self.eps, self.inv_stddev)
         norm_slice_async(
             1.0 / self.l**0.5,
-            self.tmp_y_value,
+            tmp_y_value,
             0.0,
             self.inv_stddev,
             self.axis,
@@ -196,9 +215,13 @@ class LayerNorm(BaseLayer):
         # Invert stddev (to multiply by it instead of dividing)
         # pow_async(1.0, -1.0, self.inv_stddev)
         # Finally, normalize input
-        prod_slice_async(self.inv_stddev, 1.0, self.tmp_y_value, self.axis)
+        prod_slice_async(self.inv_stddev, 1.0, tmp_y_value, self.axis)
         # inv_stddev can be offloaded from GPU
         self.inv_stddev.wont_use()
+        if not self.affine:
+            # Y can be offloaded from GPU
+            self.y.value.wont_use()
+            return
         # Scale normalized input for the backward phase
         prod_fiber3_async(
             self.gamma.value, 1.0, self.tmp_y_value, self.y.value, self.axis
@@ -226,8 +249,11 @@ class LayerNorm(BaseLayer):
             + x.value.basetile_shape[self.axis + 1 :]
         )
 
-        tmp_y_value = nntc.empty_like(x.value)
         y = TensorMoments(nntc.empty_like(x.value), None, False)
+        if self.affine:
+            tmp_y_value = nntc.empty_like(x.value)
+        else:
+            tmp_y_value = y.value
         mean = nntc.empty(mean_shape, mean_basetile, dtype=type(x.value))
         inv_stddev = nntc.empty(mean_shape, mean_basetile, dtype=type(x.value))
 
@@ -256,6 +282,8 @@ class LayerNorm(BaseLayer):
         prod_slice_async(inv_stddev, 1.0, tmp_y_value, self.axis)
         # inv_stddev can be offloaded from GPU
         inv_stddev.wont_use()
+        if not self.affine:
+            return y
         # Scale normalized input for the backward phase
         prod_fiber3_async(
             self.gamma.value, 1.0, tmp_y_value, y.value, self.axis
@@ -351,11 +379,12 @@ class LayerNorm(BaseLayer):
     @classmethod
     def from_torch(cls,
         torch_layer: LayerNormTorch, x: TensorMoments,
-        next_tag: int, redux: bool = False
+        next_tag: int, redux: bool = False, inference: bool = False
     ):
         eps = torch_layer.eps
         nntile_layer, next_tag = cls.generate_simple(x, 0, eps,
-                                                     next_tag, redux)
+                                                     next_tag, redux,
+                                                     inference)
         nntile_layer.gamma.value.from_array(
             torch_layer.weight.data.cpu().detach().numpy())
         nntile_layer.beta.value.from_array(
@@ -19,9 +19,11 @@ import torch.nn as nn
 
 import nntile.utils.constructors as nntc
 from nntile.layer.base_layer import BaseLayer
+from nntile.nntile_core import starpu
 from nntile.tensor import (
-    TensorMoments, TensorTraits, TransOp, add_fiber_inplace_async, gemm_async,
-    notrans, sum_fiber_async, to_numpy, trans)
+    Tensor, TensorMoments, TensorTraits, TransOp, add_fiber_inplace_async,
+    gemm_async, gemm_packed_async, notrans, pack_panels_async,
+    sum_fiber_async, to_numpy, trans)
 
 
 class Linear(BaseLayer):
@@ -53,7 +55,8 @@ class Linear(BaseLayer):
         else:
             super().__init__([x], [y], [w, b], [])
             self.b = b
-            self.b.grad.set_reduction_add()
+            if self.b.grad is not None:
+                self.b.grad.set_reduction_add()
         # Set up local named parameters
         self.side = side
         self.trans_x = trans_x
@@ -64,9 +67,15 @@ class Linear(BaseLayer):
         self.y = y
         self.y.value.set_reduction_add()
         self.w = w
-        self.w.grad.set_reduction_add()
+        if self.w.grad is not None:
+            self.w.grad.set_reduction_add()
         self.out_features_shape = out_features_shape
         self.out_features_basetile_shape = out_features_basetile_shape
+        # Copy of weights, packed by pack_weight() for inference on CPU
+        self.w_packed = None
+        # Function, that updates a stacked copy of weights of several layers
+        # (e.g., LlamaMLP.fuse_gate_up) after the weights change
+        self.restack_weight = None
         if redux:
             self.redux = 1
         else:
@@ -78,7 +87,8 @@ class Linear(BaseLayer):
             in_features_ndim: int, out_features_shape: List[int],
             out_features_basetile_shape: List[int], next_tag: int,
             bias: bool = True,
-            redux: bool = False):
+            redux: bool = False,
+            inference: bool = False):
         # Define shapes
         ndim = in_features_ndim
         add_shape = out_features_shape
@@ -111,11 +121,15 @@ class Linear(BaseLayer):
         w_distr = [0] * w_traits.grid.nelems
         w_value = type(x.value)(w_traits, w_distr, next_tag)
         next_tag = w_value.next_tag
-        # Create gradient of W with the same traits and distribution as W
-        w_grad = type(x.value)(w_traits, w_distr, next_tag)
-        next_tag = w_grad.next_tag
-        # Define W as TensorMoments
-        w = TensorMoments(w_value, w_grad, True)
+        if inference:
+            # No gradients are needed for inference
+            w = TensorMoments(w_value, None, False)
+        else:
+            # Create gradient of W with the same traits and distribution as W
+            w_grad = type(x.value)(w_traits, w_distr, next_tag)
+            next_tag = w_grad.next_tag
+            # Define W as TensorMoments
+            w = TensorMoments(w_value, w_grad, True)
         if bias:
             if len(add_shape) > 1:
                 raise ValueError("Bias is not yet supported for "
@@ -125,11 +139,15 @@ class Linear(BaseLayer):
             b_distr = [0] * b_traits.grid.nelems
             b_value = type(x.value)(b_traits, b_distr, next_tag)
             next_tag = b_value.next_tag
-            # Create gradient of b with the same traits and distribution as b
-            b_grad = type(x.value)(b_traits, b_distr, next_tag)
-            next_tag = b_grad.next_tag
-            # Define b as TensorMoments
-            b = TensorMoments(b_value, b_grad, True)
+            if inference:
+                b = TensorMoments(b_value, None, False)
+            else:
+                # Create gradient of b with the same traits and distribution
+                # as b
+                b_grad = type(x.value)(b_traits, b_distr, next_tag)
+                next_tag = b_grad.next_tag
+                # Define b as TensorMoments
+                b = TensorMoments(b_value, b_grad, True)
         else:
             b = None
         # Define Y
@@ -138,11 +156,14 @@ class Linear(BaseLayer):
         y_distr = [0] * y_traits.grid.nelems
         y_value = type(x.value)(y_traits, y_distr, next_tag)
         next_tag = y_value.next_tag
-        # Create gradient of Y with the same traits and distribution as Y
-        y_grad = type(x.value)(y_traits, y_distr, next_tag)
-        next_tag = y_grad.next_tag
-        # Define Y as TensorMoments
-        y = TensorMoments(y_value, y_grad, True)
+        if inference:
+            y = TensorMoments(y_value, None, False)
+        else:
+            # Create gradient of Y with the same traits and distribution as Y
+            y_grad = type(x.value)(y_traits, y_distr, next_tag)
+            next_tag = y_grad.next_tag
+            # Define Y as TensorMoments
+            y = TensorMoments(y_value, y_grad, True)
         # Create linear layer with all the provided data
         layer = Linear(
             side,
@@ -159,6 +180,42 @@ class Linear(BaseLayer):
         # Return layer and next tag to be used
         return (layer, next_tag)
 
+    # Pack a copy of weights into panels of rows for repeated products on CPU
+    def pack_weight(self):
+        """Pack a copy of weights for forward passes of an inference.
+
+        Packing is opt-in, as the packed copy doubles the memory of weights.
+        Products of the packed copy by at most `starpu.gemv_max_n` columns
+        (e.g., a decode step) are done by gemm_packed tasks, that run only on
+        CPU and read the weight once without packing it on every call, as
+        BLAS gemm does. Wider products still go to gemm with the original
+        weights. The copy is not updated by changes of weights, so
+        pack_weight() shall be called again after such changes.
+        """
+        if self.side != 'R':
+            raise ValueError("Packed weights are implemented only for side "
+                    "'R'")
+        if self.w_packed is None:
+            self.w_packed = nntc.empty_like(self.w.value)
+        pack_panels_async(self.w.value, self.w_packed, self.ndim)
+        self.w.value.wont_use()
+
+    # Drop the packed copy of weights
+    def unpack_weight(self):
+        if self.w_packed is not None:
+            self.w_packed.unregister()
+            self.w_packed = None
+
+    def unregister(self):
+        super().unregister()
+        self.unpack_weight()
+
+    # Packed weights are used only for products by a few columns, as the
+    # gemm_packed kernel is a plain loop on CPU
+    def _use_packed(self, y: Tensor) -> bool:
+        ncols = np.prod(y.shape[self.w.value.ndim - self.ndim:])
+        return self.w_packed is not None and ncols <= starpu.gemv_max_n
+
     # Forward propagation of the linear layer
     def forward_async(self):
         # Perform actual gemm
@@ -178,9 +235,14 @@ class Linear(BaseLayer):
             # 'i' is a multi-index of dimension W.ndim-ndim
             # 'j' is a multi-index of dimension ndim
             # 'k' is a multi-index of dimension X.ndim-ndim
-            gemm_async(1.0, notrans, self.w.value, self.trans_x,
-                        self.x.value, 0.0, self.y.value, self.ndim, 0,
+            if self._use_packed(self.y.value):
+                gemm_packed_async(1.0, self.w_packed, self.trans_x,
+                        self.x.value, 0.0, self.y.value, self.ndim,
                         redux=self.redux)
+            else:
+                gemm_async(1.0, notrans, self.w.value, self.trans_x,
+                            self.x.value, 0.0, self.y.value, self.ndim, 0,
+                            redux=self.redux)
             if self.b is not None:
                 add_fiber_inplace_async(
                     1.0, self.b.value, 1.0, self.y.value, 0, 0
@@ -200,7 +262,7 @@ class Linear(BaseLayer):
                 "Implemented only for from_torch version:"
                 "self.side == 'R' and self.trans_x == notrans"
             )
-        y = nntc.empty(
+        y = nntc.scratch(
             self.out_features_shape + x.value.shape[self.ndim :],
             dtype=type(x.value),
             basetile_shape=self.out_features_basetile_shape
@@ -210,18 +272,30 @@ class Linear(BaseLayer):
         # 'i' is a multi-index of dimension W.ndim-ndim
         # 'j' is a multi-index of dimension ndim
         # 'k' is a multi-index of dimension X.ndim-ndim
-        gemm_async(
-            1.0,
-            notrans,
-            self.w.value,
-            self.trans_x,
-            x.value,
-            0.0,
-            y,
-            self.ndim,
-            0,
-            redux=self.redux,
-        )
+        if self._use_packed(y):
+            gemm_packed_async(
+                1.0,
+                self.w_packed,
+                self.trans_x,
+                x.value,
+                0.0,
+                y,
+                self.ndim,
+                redux=self.redux,
+            )
+        else:
+            gemm_async(
+                1.0,
+                notrans,
+                self.w.value,
+                self.trans_x,
+                x.value,
+                0.0,
+                y,
+                self.ndim,
+                0,
+                redux=self.redux,
+            )
         if self.b is not None:
             add_fiber_inplace_async(1.0, self.b.value, 1.0, y, 0, 0)
 
@@ -343,7 +417,8 @@ class Linear(BaseLayer):
         return lin_torch
 
     @staticmethod
-    def from_torch(torch_linear, x, hidden_dim_tile, redux, next_tag):
+    def from_torch(torch_linear, x, hidden_dim_tile, redux, next_tag,
+            inference=False):
         gemm_ndim = 1
         hidden_dim = torch_linear.weight.shape[0]
         linear_nntile, next_tag = Linear.generate_simple(
@@ -355,7 +430,8 @@ class Linear(BaseLayer):
             [hidden_dim_tile],
             next_tag,
             redux=redux,
-            bias=torch_linear.bias is not None
+            bias=torch_linear.bias is not None,
+            inference=inference,
         )
 
         linear_nntile.w.value.from_array(torch_linear.weight.data.cpu().detach().numpy())
@@ -20,15 +20,18 @@ from transformers.models.llama.modeling_llama import (
 
 import nntile.utils.constructors as nntc
 from nntile.layer.base_layer import BaseLayer
-from nntile.layer.cache_utils import KVCache
+from nntile.layer.cache_utils import BatchKVCache, KVCache, SinkKVCache
 from nntile.tensor import (
-    Tensor, Tensor_bool, TensorMoments, TensorOrNone, TensorTraits,
-    add_fiber_inplace_async, add_slice_inplace_async, clear_async,
-    copy_intersection_async, flash_maxsumexp_async, flash_softmax_gemm_async,
-    flash_softmax_gemm_backward_async, gemm_async, mask_scalar_async,
-    maxsumexp_async, notrans, prod_inplace_async, rope_async,
-    rope_backward_async, softmax_inplace_async, sum_fiber_async,
-    sum_slice_async, sumprod_slice_async, to_numpy, trans, transpose_async)
+    GEMM_GQA_BCAST_A, GEMM_GQA_BCAST_C, Tensor, Tensor_bool, TensorMoments,
+    TensorOrNone, TensorTraits, add_fiber_inplace_async,
+    add_slice_inplace_async, clear_async, copy_intersection_async,
+    flash_maxsumexp_async, flash_softmax_gemm_async,
+    flash_softmax_gemm_backward_async, gemm_async, gemm_gqa_async,
+    mask_scalar_async, mask_scalar_causal_async, mask_varlen_async,
+    mask_varlen_tile_status, maxsumexp_async, notrans, prod_inplace_async,
+    rope_async, rope_backward_async, rope_qk_async,
+    softmax_inplace_async, sum_fiber_async, sum_slice_async,
+    sumprod_slice_async, to_numpy, trans, transpose_async)
 
 from ..model.llama_config import LlamaConfigNNTile
 
@@ -106,20 +109,25 @@ class LlamaAttention(BaseLayer):
         mask: TensorOrNone = None,
         flash_attention: bool = True,
         redux: bool = False,
+        mask_causal: bool = False,
     ):
         qkv_bias_list = []
         if in_proj_bias_q:
             qkv_bias_list.append(in_proj_bias_q)
-            in_proj_bias_q.grad.set_reduction_add()
+            if in_proj_bias_q.grad is not None:
+                in_proj_bias_q.grad.set_reduction_add()
         if in_proj_bias_k:
             qkv_bias_list.append(in_proj_bias_k)
-            in_proj_bias_k.grad.set_reduction_add()
+            if in_proj_bias_k.grad is not None:
+                in_proj_bias_k.grad.set_reduction_add()
         if in_proj_bias_v:
             qkv_bias_list.append(in_proj_bias_v)
-            in_proj_bias_v.grad.set_reduction_add()
+            if in_proj_bias_v.grad is not None:
+                in_proj_bias_v.grad.set_reduction_add()
         if out_proj_bias:
             bias_list_out_proj = [out_proj_bias]
-            out_proj_bias.grad.set_reduction_add()
+            if out_proj_bias.grad is not None:
+                out_proj_bias.grad.set_reduction_add()
         else:
             bias_list_out_proj = []
         # Redirect to BaseClass initialization
@@ -150,7 +158,8 @@ class LlamaAttention(BaseLayer):
         if mask is not None:
             self.temporaries.append(mask)
         self.x = x
-        self.x.grad.set_reduction_add()
+        if self.x.grad is not None:
+            self.x.grad.set_reduction_add()
         # Aliases
         self.x_q = x
         self.x_k = x
@@ -158,42 +167,57 @@ class LlamaAttention(BaseLayer):
         self.y = y
         self.y.value.set_reduction_add()
         self.w_q = w_q
-        self.w_q.grad.set_reduction_add()
+        if self.w_q.grad is not None:
+            self.w_q.grad.set_reduction_add()
         self.w_k = w_k
-        self.w_k.grad.set_reduction_add()
+        if self.w_k.grad is not None:
+            self.w_k.grad.set_reduction_add()
         self.w_v = w_v
-        self.w_v.grad.set_reduction_add()
+        if self.w_v.grad is not None:
+            self.w_v.grad.set_reduction_add()
+        # Weights of Q, K and V stacked tile by tile, so that the dynamic
+        # forward needs a single gemm
+        self.w_qkv = None
         self.w = w
-        self.w.grad.set_reduction_add()
+        if self.w.grad is not None:
+            self.w.grad.set_reduction_add()
         self.q_transposed = q_transposed
         self.q_transposed.value.set_reduction_add()
         self.q = q
         self.q_rope = q_rope
-        self.q.grad.set_reduction_add()
+        if self.q.grad is not None:
+            self.q.grad.set_reduction_add()
         self.k_transposed = k_transposed
         self.k_transposed.value.set_reduction_add()
         self.k = k
         self.k_rope = k_rope
-        self.k.grad.set_reduction_add()
+        if self.k.grad is not None:
+            self.k.grad.set_reduction_add()
         self.k_rep = k_rep
-        self.k_rep.grad.set_reduction_add()
+        if self.k_rep.grad is not None:
+            self.k_rep.grad.set_reduction_add()
         self.v_transposed = v_transposed
         self.v_transposed.value.set_reduction_add()
         self.v = v
-        self.v.grad.set_reduction_add()
+        if self.v.grad is not None:
+            self.v.grad.set_reduction_add()
         self.v_rep = v_rep
-        self.v_rep.grad.set_reduction_add()
+        if self.v_rep.grad is not None:
+            self.v_rep.grad.set_reduction_add()
         self.a = a
         self.a.value.set_reduction_add()
-        self.a.grad.set_reduction_add()
+        if self.a.grad is not None:
+            self.a.grad.set_reduction_add()
         self.a_maxsumexp = a_maxsumexp
         self.a_maxsumexp.set_reduction_maxsumexp()
         self.a_sumprod_slice = a_sumprod_slice
-        self.a_sumprod_slice.set_reduction_add()
+        if self.a_sumprod_slice is not None:
+            self.a_sumprod_slice.set_reduction_add()
         self.b = b
         self.b.value.set_reduction_add()
         self.b_transposed = b_transposed
-        self.b_transposed.grad.set_reduction_add()
+        if self.b_transposed.grad is not None:
+            self.b_transposed.grad.set_reduction_add()
         self.sin = sin
         self.cos = cos
         self.in_proj_bias_q = in_proj_bias_q
@@ -216,13 +240,23 @@ class LlamaAttention(BaseLayer):
         self.n_batch = n_batch
         self.head_size = head_size
         self.mask = mask
-        if mask:
+        # Causal mask is evaluated arithmetically from positions of keys and
+        # queries, so it is neither stored nor copied
+        self.mask_causal = mask_causal
+        self.mask_tile_status = []
+        if mask or mask_causal:
             self.val = -np.float32(np.inf)
+        if mask:
+            # Tasks for entirely masked out tiles (e.g., upper blocks of a
+            # causal mask) are not submitted at all
+            self.mask_tile_status = nntc.mask_tile_status(mask)
         if redux:
             self.redux = 1
         else:
             self.redux = 0
         self.flash_attention = flash_attention
+        # Slices of sin and cos tables for positions in a bounded KV-cache
+        self._rope_slices = {}
 
         # need to fill with valid values for dynamic api usage
         clear_async(self.q.value)
@@ -243,6 +277,7 @@ class LlamaAttention(BaseLayer):
         mask: np.ndarray = None,
         flash_attention: bool = True,
         redux: bool = False,
+        inference: bool = False,
     ):
         # Get sizes
         n_emb, n_seq, n_batch = x.value.shape
@@ -469,184 +504,148 @@ class LlamaAttention(BaseLayer):
             in_proj_bias_kv_distr = [0] * in_proj_bias_kv_traits.grid.nelems
         cos_distr = [0] * cos_traits.grid.nelems
         sin_distr = [0] * sin_traits.grid.nelems
+        # Gradients are not allocated in the inference mode
+        def moments(value, traits, distr):
+            nonlocal next_tag
+            if inference:
+                return TensorMoments(value, None, False)
+            grad = type(x.value)(traits, distr, next_tag)
+            next_tag = grad.next_tag
+            return TensorMoments(value, grad, True)
+
         # Define all the lists
         # w_q
         w_q_value = type(x.value)(w_q_traits, w_q_distr, next_tag)
         next_tag = w_q_value.next_tag
-        w_q_grad = type(x.value)(w_q_traits, w_q_distr, next_tag)
-        next_tag = w_q_grad.next_tag
-        w_q = TensorMoments(w_q_value, w_q_grad, True)
+        w_q = moments(w_q_value, w_q_traits, w_q_distr)
         if bias:
             in_proj_bias_q_value = type(x.value)(
                 in_proj_bias_q_traits, in_proj_bias_q_distr, next_tag
             )
             next_tag = in_proj_bias_q_value.next_tag
-            in_proj_bias_q_grad = type(x.value)(
-                in_proj_bias_q_traits, in_proj_bias_q_distr, next_tag
-            )
-            next_tag = in_proj_bias_q_grad.next_tag
-            bias_inproj_q = TensorMoments(
-                in_proj_bias_q_value, in_proj_bias_q_grad, True
+            bias_inproj_q = moments(
+                in_proj_bias_q_value,
+                in_proj_bias_q_traits,
+                in_proj_bias_q_distr,
             )
         else:
             bias_inproj_q = None
         # w_k
         w_k_value = type(x.value)(w_k_traits, w_k_distr, next_tag)
         next_tag = w_k_value.next_tag
-        w_k_grad = type(x.value)(w_k_traits, w_k_distr, next_tag)
-        next_tag = w_k_grad.next_tag
-        w_k = TensorMoments(w_k_value, w_k_grad, True)
+        w_k = moments(w_k_value, w_k_traits, w_k_distr)
         if bias:
             in_proj_bias_k_value = type(x.value)(
                 in_proj_bias_kv_traits, in_proj_bias_kv_distr, next_tag
             )
             next_tag = in_proj_bias_k_value.next_tag
-            in_proj_bias_k_grad = type(x.value)(
-                in_proj_bias_kv_traits, in_proj_bias_kv_distr, next_tag
-            )
-            next_tag = in_proj_bias_k_grad.next_tag
-            bias_inproj_k = TensorMoments(
-                in_proj_bias_k_value, in_proj_bias_k_grad, True
+            bias_inproj_k = moments(
+                in_proj_bias_k_value,
+                in_proj_bias_kv_traits,
+                in_proj_bias_kv_distr,
             )
         else:
             bias_inproj_k = None
         # w_v
         w_v_value = type(x.value)(w_v_traits, w_v_distr, next_tag)
         next_tag = w_v_value.next_tag
-        w_v_grad = type(x.value)(w_v_traits, w_v_distr, next_tag)
-        next_tag = w_v_grad.next_tag
-        w_v = TensorMoments(w_v_value, w_v_grad, True)
+        w_v = moments(w_v_value, w_v_traits, w_v_distr)
         if bias:
             in_proj_bias_v_value = type(x.value)(
                 in_proj_bias_kv_traits, in_proj_bias_kv_distr, next_tag
             )
             next_tag = in_proj_bias_v_value.next_tag
-            in_proj_bias_v_grad = type(x.value)(
-                in_proj_bias_kv_traits, in_proj_bias_kv_distr, next_tag
-            )
-            next_tag = in_proj_bias_v_grad.next_tag
-            bias_inproj_v = TensorMoments(
-                in_proj_bias_v_value, in_proj_bias_v_grad, True
+            bias_inproj_v = moments(
+                in_proj_bias_v_value,
+                in_proj_bias_kv_traits,
+                in_proj_bias_kv_distr,
             )
         else:
             bias_inproj_v = None
         # w
         w_value = type(x.value)(w_traits, w_distr, next_tag)
         next_tag = w_value.next_tag
-        w_grad = type(x.value)(w_traits, w_distr, next_tag)
-        next_tag = w_grad.next_tag
-        w = TensorMoments(w_value, w_grad, True)
+        w = moments(w_value, w_traits, w_distr)
         # q_transposed
         q_transposed_value = type(x.value)(
             q_transposed_traits, q_transposed_distr, next_tag
         )
         next_tag = q_transposed_value.next_tag
-        q_transposed_grad = type(x.value)(
-            q_transposed_traits, q_transposed_distr, next_tag
-        )
-        next_tag = q_transposed_grad.next_tag
-        q_transposed = TensorMoments(
-            q_transposed_value, q_transposed_grad, True
+        q_transposed = moments(
+            q_transposed_value, q_transposed_traits, q_transposed_distr
         )
         # q
         q_value = type(x.value)(q_traits, q_distr, next_tag)
         next_tag = q_value.next_tag
-        q_grad = type(x.value)(q_traits, q_distr, next_tag)
-        next_tag = q_grad.next_tag
-        q = TensorMoments(q_value, q_grad, True)
+        q = moments(q_value, q_traits, q_distr)
         # q_rope
         q_rope_value = type(x.value)(q_rope_traits, q_rope_distr, next_tag)
         next_tag = q_rope_value.next_tag
-        q_rope_grad = type(x.value)(q_rope_traits, q_rope_distr, next_tag)
-        next_tag = q_rope_grad.next_tag
-        q_rope = TensorMoments(q_rope_value, q_rope_grad, True)
+        q_rope = moments(q_rope_value, q_rope_traits, q_rope_distr)
         # k_transposed
         k_transposed_value = type(x.value)(
             k_transposed_traits, k_transposed_distr, next_tag
         )
         next_tag = k_transposed_value.next_tag
-        k_transposed_grad = type(x.value)(
-            k_transposed_traits, k_transposed_distr, next_tag
-        )
-        next_tag = k_transposed_grad.next_tag
-        k_transposed = TensorMoments(
-            k_transposed_value, k_transposed_grad, True
+        k_transposed = moments(
+            k_transposed_value, k_transposed_traits, k_transposed_distr
         )
         # k
         k_value = type(x.value)(k_traits, k_distr, next_tag)
         next_tag = k_value.next_tag
-        k_grad = type(x.value)(k_traits, k_distr, next_tag)
-        next_tag = k_grad.next_tag
-        k = TensorMoments(k_value, k_grad, True)
+        k = moments(k_value, k_traits, k_distr)
         # k_rope
         k_rope_value = type(x.value)(k_rope_traits, k_rope_distr, next_tag)
         next_tag = k_rope_value.next_tag
-        k_rope_grad = type(x.value)(k_rope_traits, k_rope_distr, next_tag)
-        next_tag = k_rope_grad.next_tag
-        k_rope = TensorMoments(k_rope_value, k_rope_grad, True)
+        k_rope = moments(k_rope_value, k_rope_traits, k_rope_distr)
         # k_rep
         k_rep_value = type(x.value)(k_rep_traits, k_rep_distr, next_tag)
         next_tag = k_rep_value.next_tag
-        k_rep_grad = type(x.value)(k_rep_traits, k_rep_distr, next_tag)
-        next_tag = k_rep_grad.next_tag
-        k_rep = TensorMoments(k_rep_value, k_rep_grad, True)
+        k_rep = moments(k_rep_value, k_rep_traits, k_rep_distr)
         # v_transposed
         v_transposed_value = type(x.value)(
             v_transposed_traits, v_transposed_distr, next_tag
         )
         next_tag = v_transposed_value.next_tag
-        v_transposed_grad = type(x.value)(
-            v_transposed_traits, v_transposed_distr, next_tag
-        )
-        next_tag = v_transposed_grad.next_tag
-        v_transposed = TensorMoments(
-            v_transposed_value, v_transposed_grad, True
+        v_transposed = moments(
+            v_transposed_value, v_transposed_traits, v_transposed_distr
         )
         # v
         v_value = type(x.value)(v_traits, v_distr, next_tag)
         next_tag = v_value.next_tag
-        v_grad = type(x.value)(v_traits, v_distr, next_tag)
-        next_tag = v_grad.next_tag
-        v = TensorMoments(v_value, v_grad, True)
+        v = moments(v_value, v_traits, v_distr)
         # v_rep
         v_rep_value = type(x.value)(v_rep_traits, v_rep_distr, next_tag)
         next_tag = v_rep_value.next_tag
-        v_rep_grad = type(x.value)(v_rep_traits, v_rep_distr, next_tag)
-        next_tag = v_rep_grad.next_tag
-        v_rep = TensorMoments(v_rep_value, v_rep_grad, True)
+        v_rep = moments(v_rep_value, v_rep_traits, v_rep_distr)
         # a
         a_value = type(x.value)(a_traits, a_distr, next_tag)
         next_tag = a_value.next_tag
-        a_grad = type(x.value)(a_traits, a_distr, next_tag)
-        next_tag = a_grad.next_tag
-        a = TensorMoments(a_value, a_grad, True)
+        a = moments(a_value, a_traits, a_distr)
         # a_maxsumexp
         a_maxsumexp = type(x.value)(
             a_maxsumexp_traits, a_maxsumexp_distr, next_tag
         )
         next_tag = a_maxsumexp.next_tag
-        # a_sumprod_slice
-        a_sumprod_slice = type(x.value)(
-            a_sumprod_slice_traits, a_sumprod_slice_distr, next_tag
-        )
-        next_tag = a_sumprod_slice.next_tag
+        # a_sumprod_slice is needed only by backward
+        if inference:
+            a_sumprod_slice = None
+        else:
+            a_sumprod_slice = type(x.value)(
+                a_sumprod_slice_traits, a_sumprod_slice_distr, next_tag
+            )
+            next_tag = a_sumprod_slice.next_tag
         # b
         b_value = type(x.value)(b_traits, b_distr, next_tag)
         next_tag = b_value.next_tag
-        b_grad = type(x.value)(b_traits, b_distr, next_tag)
-        next_tag = b_grad.next_tag
-        b = TensorMoments(b_value, b_grad, True)
+        b = moments(b_value, b_traits, b_distr)
         # b_transposed
         b_transposed_value = type(x.value)(
             b_transposed_traits, b_transposed_distr, next_tag
         )
         next_tag = b_transposed_value.next_tag
-        b_transposed_grad = type(x.value)(
-            b_transposed_traits, b_transposed_distr, next_tag
-        )
-        next_tag = b_transposed_grad.next_tag
-        b_transposed = TensorMoments(
-            b_transposed_value, b_transposed_grad, True
+        b_transposed = moments(
+            b_transposed_value, b_transposed_traits, b_transposed_distr
         )
         cos = type(x.value)(cos_traits, cos_distr, next_tag)
         next_tag = cos.next_tag
@@ -661,12 +660,8 @@ class LlamaAttention(BaseLayer):
                 out_proj_bias_traits, out_proj_bias_distr, next_tag
             )
             next_tag = out_proj_bias_value.next_tag
-            out_proj_bias_grad = type(x.value)(
-                out_proj_bias_traits, out_proj_bias_distr, next_tag
-            )
-            next_tag = out_proj_bias_grad.next_tag
-            out_proj_bias = TensorMoments(
-                out_proj_bias_value, out_proj_bias_grad, True
+            out_proj_bias = moments(
+                out_proj_bias_value, out_proj_bias_traits, out_proj_bias_distr
             )
         else:
             out_proj_bias = None
@@ -674,9 +669,7 @@ class LlamaAttention(BaseLayer):
         y_traits = TensorTraits(x.value.shape, x.value.basetile_shape)
         y_value = type(x.value)(y_traits, x.value.distribution, next_tag)
         next_tag = y_value.next_tag
-        y_grad = type(x.value)(y_traits, x.value.distribution, next_tag)
-        next_tag = y_grad.next_tag
-        y = TensorMoments(y_value, y_grad, True)
+        y = moments(y_value, y_traits, x.value.distribution)
 
         # Fill sin, cos tensors:
         inv_freq = 1.0 / (theta
@@ -692,7 +685,12 @@ class LlamaAttention(BaseLayer):
         sin.from_array(np_sin)
 
         # Mask
-        if mask is not None:
+        mask_causal = mask is not None and np.array_equal(
+            np.asarray(mask, dtype=bool),
+            np.triu(np.ones((n_seq, n_seq), dtype=bool))
+        )
+        # Flash attention still requires a materialized mask
+        if mask is not None and (flash_attention or not mask_causal):
             layer_mask_shape = [n_seq, n_seq]
             layer_mask_basetile = [n_seq_tile, n_seq_tile]
             layer_mask_traits = TensorTraits(
@@ -741,6 +739,7 @@ class LlamaAttention(BaseLayer):
             layer_mask,
             flash_attention=flash_attention,
             redux=redux,
+            mask_causal=mask_causal,
         )
         # Return layer and next tag to be used
         return (layer, next_tag)
@@ -820,12 +819,13 @@ class LlamaAttention(BaseLayer):
         rope_async(self.sin, self.cos, self.k.value, self.k_rope.value)
         # K can be deleted
         self.k.value.invalidate_submit()
-        # Repeat K_rope along fibers of proper axis
+        # Repeat K_rope along fibers of proper axis for flash attention
         # from (head_size, n_seq, n_batch, n_head_kv)
         # into (head_size, n_seq, n_batch, kv_group_size, n_head_kv)
-        add_slice_inplace_async(
-            1.0, self.k_rope.value, 0.0, self.k_rep.value, 3
-        )
+        if self.flash_attention:
+            add_slice_inplace_async(
+                1.0, self.k_rope.value, 0.0, self.k_rep.value, 3
+            )
         # K_rope can be offloaded from GPU
         self.k_rope.value.wont_use()
         # V_transposed = einsum('jkl,lmn->jkmn', W_V, X_V)
@@ -858,21 +858,25 @@ class LlamaAttention(BaseLayer):
                 1, self.in_proj_bias_v.value, 1, self.v.value, 0, 1
             )
             self.in_proj_bias_v.value.wont_use()
-        # Repeat V along fibers of proper axis
+        # Repeat V along fibers of proper axis for flash attention
         # from (head_size, n_seq, n_batch, n_head_kv)
         # into (head_size, n_seq, n_batch, kv_group_size, n_head_kv)
-        add_slice_inplace_async(1.0, self.v.value, 0.0, self.v_rep.value, 3)
+        if self.flash_attention:
+            add_slice_inplace_async(
+                1.0, self.v.value, 0.0, self.v_rep.value, 3
+            )
         # V can be offloaded from GPU
         self.v.value.wont_use()
 
-        # Apply attention to Q_rope, K_rep and V_rep into B
+        # Apply attention to Q_rope, K and V into B
         if self.flash_attention:
             self._flash_attention_fwd()
+            # Repeated tensors can be deleted now
+            self.k_rep.value.invalidate_submit()
+            self.v_rep.value.invalidate_submit()
         else:
+            # Grouped-query attention reads K_rope and V once per group
             self._attention_fwd()
-        # Repeated tensors can be deleted now
-        self.k_rep.value.invalidate_submit()
-        self.v_rep.value.invalidate_submit()
 
         # Rotate axes (head_size, n_seq, n_batch, kv_group_size, n_head_kv)
         # into (kv_group_size, n_head_kv, head_size, n_seq, n_batch)
@@ -913,26 +917,12 @@ class LlamaAttention(BaseLayer):
         q_partial_tr_shape = tuple(self.q_transposed.value.shape[:-2]) + tuple(
             x.shape[-2:]
         )
-        q_partial_tr = nntc.empty(
+        q_partial_tr = nntc.scratch(
             q_partial_tr_shape,
             basetile_shape=q_partial_tr_bt_shape,
             dtype=type(x),
         )  # (kv_group_size, n_head_kv, head_size, n_seq_dyn, n_batch_dyn)
 
-        q_partial_bt_shape = (
-            (self.q.value.basetile_shape[0],)
-            + tuple(x.shape[-2:])
-            + tuple(self.q.value.basetile_shape[-2:])
-        )
-        q_partial_shape = (
-            (self.q.value.shape[0],)
-            + tuple(x.shape[-2:])
-            + tuple(self.q.value.shape[-2:])
-        )
-        q_partial = nntc.empty(
-            q_partial_shape, basetile_shape=q_partial_bt_shape, dtype=type(x)
-        )  # (head_size, n_seq_dyn, n_batch_dyn, kv_group_size, n_head_kv)
-
         # Q_transposed = einsum('ijkl,lmn->ijkmn', W_Q, X_Q_dyn)
         # gemm (kv_group_size, n_head_kv, head_size, n_emb)
         # by (n_emb, n_seq_dyn, n_batch_dyn)
@@ -949,11 +939,30 @@ class LlamaAttention(BaseLayer):
             0,
             redux=self.redux,
         )
+        q_partial = self._transpose_q_dynamic(q_partial_tr)
+        q_partial_tr.invalidate_submit()
+        return q_partial
+
+    def _transpose_q_dynamic(self, q_partial_tr):
+        q_partial_bt_shape = (
+            (self.q.value.basetile_shape[0],)
+            + tuple(q_partial_tr.shape[-2:])
+            + tuple(self.q.value.basetile_shape[-2:])
+        )
+        q_partial_shape = (
+            (self.q.value.shape[0],)
+            + tuple(q_partial_tr.shape[-2:])
+            + tuple(self.q.value.shape[-2:])
+        )
+        q_partial = nntc.scratch(
+            q_partial_shape,
+            basetile_shape=q_partial_bt_shape,
+            dtype=type(q_partial_tr),
+        )  # (head_size, n_seq_dyn, n_batch_dyn, kv_group_size, n_head_kv)
 
         # Rotate axes into
         # (head_size, n_seq_dyn, n_batch_dyn, kv_group_size, n_head_kv)
         transpose_async(1.0, q_partial_tr, q_partial, 2)
-        q_partial_tr.invalidate_submit()
 
         if self.in_proj_bias_q is not None:
             # batched add_fiber_inplace
@@ -967,153 +976,223 @@ class LlamaAttention(BaseLayer):
         return q_partial
 
     def _forward_mlp_k_dynamic(self, x):
-        k_partial_tr_bt_shape = tuple(
-            self.k_transposed.value.basetile_shape[:-2]
+        k_partial_tr = self._forward_mlp_kv_tr_dynamic(
+            x, self.w_k.value, self.k_transposed.value
+        )
+        k_partial = self._transpose_kv_dynamic(
+            k_partial_tr, self.k.value, self.in_proj_bias_k
+        )
+        k_partial_tr.invalidate_submit()
+        return k_partial
+
+    def _forward_mlp_v_dynamic(self, x):
+        v_partial_tr = self._forward_mlp_kv_tr_dynamic(
+            x, self.w_v.value, self.v_transposed.value
+        )
+        v_partial = self._transpose_kv_dynamic(
+            v_partial_tr, self.v.value, self.in_proj_bias_v
+        )
+        v_partial_tr.invalidate_submit()
+        return v_partial
+
+    def _forward_mlp_kv_tr_dynamic(self, x, w, kv_transposed):
+        kv_partial_tr_bt_shape = tuple(
+            kv_transposed.basetile_shape[:-2]
         ) + tuple(x.shape[-2:])
-        k_partial_tr_shape = tuple(self.k_transposed.value.shape[:-2]) + tuple(
+        kv_partial_tr_shape = tuple(kv_transposed.shape[:-2]) + tuple(
             x.shape[-2:]
         )
-        k_partial_tr = nntc.empty(
-            k_partial_tr_shape,
-            basetile_shape=k_partial_tr_bt_shape,
+        kv_partial_tr = nntc.scratch(
+            kv_partial_tr_shape,
+            basetile_shape=kv_partial_tr_bt_shape,
             dtype=type(x),
         )  # (n_head_kv, head_size, n_seq_dyn, n_batch_dyn)
 
-        k_partial_bt_shape = (
-            (self.k.value.basetile_shape[0],)
-            + tuple(x.shape[-2:])
-            + (self.k.value.basetile_shape[-1],)
-        )
-        k_partial_shape = (
-            (self.k.value.shape[0],)
-            + tuple(x.shape[-2:])
-            + (self.k.value.shape[-1],)
-        )
-        k_partial = nntc.empty(
-            k_partial_shape, basetile_shape=k_partial_bt_shape, dtype=type(x)
-        )  # (head_size, n_seq_dyn, n_batch_dyn, n_head_kv)
-
         # K_transposed = einsum('jkl,lmn->jkmn', W_K, X_K_dyn)
         # gemm (n_head_kv, head_size, n_emb) by (n_emb, n_seq_dyn, n_batch_dyn) into # noqa: E501
         # (n_head_kv, head_size, n_seq_dyn, n_batch_dyn)
         gemm_async(
             1.0,
             notrans,
-            self.w_k.value,
+            w,
             notrans,
             x,
             0.0,
-            k_partial_tr,
+            kv_partial_tr,
             1,
             0,
             redux=self.redux,
         )
+        return kv_partial_tr
+
+    def _transpose_kv_dynamic(self, kv_partial_tr, kv, bias):
+        kv_partial_bt_shape = (
+            (kv.basetile_shape[0],)
+            + tuple(kv_partial_tr.shape[-2:])
+            + (kv.basetile_shape[-1],)
+        )
+        kv_partial_shape = (
+            (kv.shape[0],)
+            + tuple(kv_partial_tr.shape[-2:])
+            + (kv.shape[-1],)
+        )
+        kv_partial = nntc.scratch(
+            kv_partial_shape,
+            basetile_shape=kv_partial_bt_shape,
+            dtype=type(kv_partial_tr),
+        )  # (head_size, n_seq_dyn, n_batch_dyn, n_head_kv)
+
         # Rotate axes into (head_size, n_seq_dyn, n_batch_dyn, n_head_kv)
-        transpose_async(1.0, k_partial_tr, k_partial, 1)
-        if self.in_proj_bias_k is not None:
+        transpose_async(1.0, kv_partial_tr, kv_partial, 1)
+        if bias is not None:
             # batched add_fiber_inplace (head_size, batch=n_head_kv) into
             # (head_size, n_seq_dyn, n_batch_dyn, batch=n_head_kv)
-            add_fiber_inplace_async(
-                1.0, self.in_proj_bias_k.value, 1.0, k_partial, 0, 1
-            )
-
-        return k_partial
+            add_fiber_inplace_async(1.0, bias.value, 1.0, kv_partial, 0, 1)
 
-    def _forward_mlp_v_dynamic(self, x):
-        v_partial_tr_bt_shape = tuple(
-            self.v_transposed.value.basetile_shape[:-2]
-        ) + tuple(x.shape[-2:])
-        v_partial_tr_shape = tuple(self.v_transposed.value.shape[:-2]) + tuple(
-            x.shape[-2:]
-        )
-        v_partial_tr = nntc.empty(
-            v_partial_tr_shape,
-            basetile_shape=v_partial_tr_bt_shape,
-            dtype=type(x),
-        )  # (n_head_kv, head_size, n_seq_dyn, n_batch_dyn)
+        return kv_partial
 
-        v_partial_bt_shape = (
-            (self.v.value.basetile_shape[0],)
-            + tuple(x.shape[-2:])
-            + (self.v.value.basetile_shape[-1],)
-        )
-        v_partial_shape = (
-            (self.v.value.shape[0],)
-            + tuple(x.shape[-2:])
-            + (self.v.value.shape[-1],)
-        )
-        v_partial = nntc.empty(
-            v_partial_shape, basetile_shape=v_partial_bt_shape, dtype=type(x)
-        )  # (head_size, n_seq_dyn, n_batch_dyn, n_head_kv)
+    def _forward_mlp_qkv_dynamic(self, x):
+        """Project input into Q, K and V
 
-        # V_transposed = einsum('jkl,lmn->jkmn', W_V, X_V_dyn)
-        # gemm (n_head_kv, head_size, n_emb) by (n_emb, n_seq_dyn, n_batch_dyn) into # noqa: E501
-        # (n_head_kv, head_size, n_seq_dyn, n_batch_dyn)
+        With stacked weights (see fuse_qkv) a single gemm computes all the
+        projections tile by tile, and Q, K and V are copied out of the tiles
+        of the result by their offsets.
+        """
+        if self.w_qkv is None:
+            return (
+                self._forward_mlp_q_dynamic(x),
+                self._forward_mlp_k_dynamic(x),
+                self._forward_mlp_v_dynamic(x),
+            )
+        w = self.w_qkv
+        kv_group_size = w.shape[0] - 2
+        qkv_partial_tr = nntc.scratch(
+            tuple(w.shape[:3]) + tuple(x.shape[-2:]),
+            basetile_shape=tuple(w.basetile_shape[:3]) + tuple(x.shape[-2:]),
+            dtype=type(x),
+        )  # (kv_group_size+2, n_head_kv, head_size, n_seq_dyn, n_batch_dyn)
+        # gemm (kv_group_size+2, n_head_kv, head_size, n_emb)
+        # by (n_emb, n_seq_dyn, n_batch_dyn)
+        # into (kv_group_size+2, n_head_kv, head_size, n_seq_dyn, n_batch_dyn)
         gemm_async(
             1.0,
             notrans,
-            self.w_v.value,
+            w,
             notrans,
             x,
             0.0,
-            v_partial_tr,
+            qkv_partial_tr,
             1,
             0,
             redux=self.redux,
         )
-        # Rotate axes into (head_size, n_seq_dyn, n_batch_dyn, n_head_kv)
-        transpose_async(1.0, v_partial_tr, v_partial, 1)
-        if self.in_proj_bias_v is not None:
-            # batched add_fiber_inplace (head_size, batch=n_head_kv) into
-            # (head_size, n_seq_dyn, n_batch_dyn, batch=n_head_kv)
-            add_fiber_inplace_async(
-                1.0, self.in_proj_bias_v.value, 1.0, v_partial, 0, 1
+        offset = [0] * 5
+        q_partial_tr = nntc.scratch(
+            (kv_group_size,) + tuple(qkv_partial_tr.shape[1:]),
+            basetile_shape=(kv_group_size,)
+            + tuple(qkv_partial_tr.basetile_shape[1:]),
+            dtype=type(x),
+        )  # (kv_group_size, n_head_kv, head_size, n_seq_dyn, n_batch_dyn)
+        copy_intersection_async(qkv_partial_tr, offset, q_partial_tr, offset)
+        q_partial = self._transpose_q_dynamic(q_partial_tr)
+        q_partial_tr.invalidate_submit()
+        kv_shape = qkv_partial_tr.shape[1:]
+        kv_basetile = qkv_partial_tr.basetile_shape[1:]
+        kv_partials = []
+        for i, kv, bias in (
+            (kv_group_size, self.k.value, self.in_proj_bias_k),
+            (kv_group_size + 1, self.v.value, self.in_proj_bias_v),
+        ):
+            # K or V is copied out of every tile by its offset
+            kv_partial_tr = nntc.scratch(
+                [1] + kv_shape,
+                basetile_shape=[1] + kv_basetile,
+                dtype=type(x),
+            )  # (1, n_head_kv, head_size, n_seq_dyn, n_batch_dyn)
+            copy_intersection_async(
+                qkv_partial_tr, offset, kv_partial_tr, [i, 0, 0, 0, 0]
             )
-
-        v_partial_tr.invalidate_submit()
-
-        return v_partial
-
-    def _forward_attn_dynamic(self, q, k, v):
-        a_tmp = nntc.empty(
-            (k.shape[1],) + tuple(q.shape[1:3]) + tuple(k.shape[3:]),
+            kv_partials.append(
+                self._transpose_kv_dynamic(
+                    type(x)(kv_partial_tr, kv_shape, kv_basetile), kv, bias
+                )
+            )
+            kv_partial_tr.invalidate_submit()
+        qkv_partial_tr.invalidate_submit()
+        return q_partial, kv_partials[0], kv_partials[1]
+
+    def fuse_qkv(self):
+        """Stack projection weights for a single gemm in dynamic forward
+
+        Weights of Q, K and V are copied into one tensor of shape
+        (kv_group_size+2, n_head_kv, head_size, n_emb), whose base tile spans
+        the whole leading axis. Every tile of the stacked weights holds all
+        the projections of the same heads, so a single gemm task per tile
+        reads a tile of input once. The stacked tensor is a copy of the
+        weights for inference, that is updated again by this method after
+        the weights change. Fusion is opt-in, as the copy doubles the memory
+        of projection weights, and Q, K and V are copied out of the tiles of
+        the result by extra copy tasks.
+        """
+        w_q = self.w_q.value
+        w_k = self.w_k.value
+        kv_group_size = w_q.shape[0]
+        if self.w_qkv is None:
+            self.w_qkv = nntc.empty(
+                [kv_group_size + 2] + w_k.shape,
+                basetile_shape=[kv_group_size + 2] + w_k.basetile_shape,
+                dtype=type(w_k),
+            )
+        offset = [0] * 4
+        copy_intersection_async(w_q, offset, self.w_qkv, offset)
+        for i, w in (
+            (kv_group_size, self.w_k.value),
+            (kv_group_size + 1, self.w_v.value),
+        ):
+            # View of weights of K or V with a leading unit axis
+            w_view = type(w)(w, [1] + w.shape, [1] + w.basetile_shape)
+            copy_intersection_async(w_view, [i, 0, 0, 0], self.w_qkv, offset)
+
+    def unregister(self):
+        super().unregister()
+        if self.w_qkv is not None:
+            self.w_qkv.unregister()
+            self.w_qkv = None
+
+    def _forward_attn_dynamic(self, q, k, v, kv_len=None):
+        b_tmp = self._forward_attn_core_dynamic(q, k, v, kv_len)
+        return self._forward_out_dynamic(b_tmp)
+
+    def _forward_attn_core_dynamic(self, q, k, v, kv_len=None):
+        # Only the first kv_len keys and values are valid, the rest is padding
+        # of a view of the KV-cache
+        if kv_len is None:
+            kv_len = k.shape[1]
+        a_tmp = nntc.scratch(
+            (k.shape[1],) + tuple(q.shape[1:]),
             dtype=type(q),
             basetile_shape=(k.basetile_shape[1],)
-            + tuple(q.basetile_shape[1:3])
-            + tuple(k.basetile_shape[3:]),
+            + tuple(q.basetile_shape[1:]),
         )  # (n_seq_kvcached, n_seq_dyn, n_batch_dyn, kv_group_size, n_head_kv)
-        a_maxsumexp_tmp = nntc.empty(
+        a_maxsumexp_tmp = nntc.scratch(
             (2,) + tuple(a_tmp.shape[1:]),
             dtype=type(q),
             basetile_shape=(2,) + tuple(a_tmp.basetile_shape[1:]),
         )  # (2, n_seq_dyn, n_batch_dyn, kv_group_size, n_head_kv)
-        b_tmp = nntc.empty(
+        b_tmp = nntc.scratch(
             q.shape,
             dtype=type(q),
             basetile_shape=q.basetile_shape,
         )  # (head_size, n_seq_dyn, n_batch_dyn, kv_group_size, n_head_kv)
-        b_tr_tmp = nntc.empty(
-            tuple(b_tmp.shape[3:]) + tuple(b_tmp.shape[:3]),
-            dtype=type(q),
-            basetile_shape=tuple(b_tmp.basetile_shape[3:])
-            + tuple(b_tmp.basetile_shape[:3]),
-        )  # (n_head, head_size, n_seq_dyn, n_batch_dyn)
-
-        y_tensor = nntc.empty(
-            (self.w.value.shape[0],) + tuple(q.shape[1:3]),
-            dtype=type(q),
-            basetile_shape=(self.w.value.basetile_shape[0],)
-            + tuple(q.basetile_shape[1:3]),
-        )  # [n_emb, n_seq_dyn, n_batch_dyn] == x.shape
 
         # Get tensor for softmax
-        # A = 1.0/sqrt(head_size) * einsum('jklbi,jmlbi->kmlbi', K_rep, Q_rope)
-        # single batched gemm
-        # (head_size, n_seq_cached, batch=(n_batch_cached, kv_group_size, n_head_kv)) # noqa: E501
+        # A = 1.0/sqrt(head_size) * einsum('jkli,jmlbi->kmlbi', K_rope, Q_rope)
+        # single batched gemm, where K_rope is shared by kv_group_size
+        # (head_size, n_seq_cached, batch=(n_batch_cached, n_head_kv))
         # by (head_size, n_seq_dyn, batch=(n_batch_dyn, kv_group_size, n_head_kv)) # noqa: E501
         # into (n_seq_cached, n_seq_dyn, batch=(n_batch_dyn, kv_group_size, n_head_kv)) # noqa: E501
         # note: n_batch_cached == n_batch_dyn
-        gemm_async(
+        gemm_gqa_async(
             1.0 / self.head_size**0.5,
             trans,
             k,
@@ -1123,26 +1202,43 @@ class LlamaAttention(BaseLayer):
             a_tmp,
             1,
             3,
+            1,
+            GEMM_GQA_BCAST_A,
             redux=self.redux,
         )
         clear_async(a_maxsumexp_tmp)
-        if self.mask:
-            mask_tmp = nntc.empty(a_tmp.shape[:2], dtype=Tensor_bool)
+        kv_pad = kv_len if kv_len < k.shape[1] else -1
+        if self.mask_causal:
+            mask_scalar_causal_async(
+                kv_len - q.shape[1], 0, kv_pad, self.val, a_tmp, 3
+            )
+        elif self.mask:
+            mask_tmp = nntc.scratch(
+                a_tmp.shape[:2],
+                basetile_shape=a_tmp.basetile_shape[:2],
+                dtype=Tensor_bool,
+            )
             copy_intersection_async(
-                self.mask, [0, 0], mask_tmp, [0, k.shape[1] - q.shape[1]]
+                self.mask, [0, 0], mask_tmp, [0, kv_len - q.shape[1]]
             )
             mask_scalar_async(mask_tmp, self.val, a_tmp, 3)
+        if kv_pad >= 0 and not self.mask_causal:
+            # All keys are in the past of shifted queries, so only the
+            # padding is masked out
+            mask_scalar_causal_async(
+                k.shape[1], 0, kv_pad, self.val, a_tmp, 3
+            )
 
         maxsumexp_async(a_tmp, a_maxsumexp_tmp, 0, redux=self.redux)
         softmax_inplace_async(a_maxsumexp_tmp, 1.0, a_tmp, 0)
 
         # Apply value tensor
-        # B = einsum('jklbi,kmlbi->jmlbi', V_rep, A)
-        # batched gemm
-        # (head_size, n_seq_cached, batch=(n_batch_cached, kv_group_size, n_head_kv)) # noqa: E501
+        # B = einsum('jkli,kmlbi->jmlbi', V, A)
+        # batched gemm, where V is shared by kv_group_size
+        # (head_size, n_seq_cached, batch=(n_batch_cached, n_head_kv))
         # by (n_seq_cached, n_seq_dyn, batch=(n_batch_dyn, kv_group_size, n_head_kv)) # noqa: E501
         # into (head_size, n_seq_dyn, batch=(n_batch_dyn, kv_group_size, n_head_kv)) # noqa: E501
-        gemm_async(
+        gemm_gqa_async(
             1.0,
             notrans,
             v,
@@ -1152,9 +1248,28 @@ class LlamaAttention(BaseLayer):
             b_tmp,
             1,
             3,
+            1,
+            GEMM_GQA_BCAST_A,
             redux=self.redux,
         )
 
+        return b_tmp
+
+    def _forward_out_dynamic(self, b_tmp):
+        b_tr_tmp = nntc.scratch(
+            tuple(b_tmp.shape[3:]) + tuple(b_tmp.shape[:3]),
+            dtype=type(b_tmp),
+            basetile_shape=tuple(b_tmp.basetile_shape[3:])
+            + tuple(b_tmp.basetile_shape[:3]),
+        )  # (n_head, head_size, n_seq_dyn, n_batch_dyn)
+
+        y_tensor = nntc.scratch(
+            (self.w.value.shape[0],) + tuple(b_tmp.shape[1:3]),
+            dtype=type(b_tmp),
+            basetile_shape=(self.w.value.basetile_shape[0],)
+            + tuple(b_tmp.basetile_shape[1:3]),
+        )  # [n_emb, n_seq_dyn, n_batch_dyn] == x.shape
+
         # Rotate axes (head_size, n_seq_dyn, n_batch_dyn, kv_group_size, n_head_kv) # noqa: E501
         # into (kv_group_size, n_head_kv, head_size, n_seq_dyn, n_batch_dyn)
         transpose_async(1.0, b_tmp, b_tr_tmp, 3)
@@ -1185,37 +1300,55 @@ class LlamaAttention(BaseLayer):
 
     def _apply_rope_dynamic(
         self,
-        x: Tensor,
         q_partial: Tensor,
         k_partial: Tensor,
-        kv_cache_size: int
+        kv_cache: Optional[KVCache]
     ):
-        q_rope_partial = nntc.empty(
-            q_partial.shape,
-            basetile_shape=q_partial.basetile_shape,
-            dtype=type(x),
-        )
-        k_rope_partial = nntc.empty(
-            k_partial.shape,
-            basetile_shape=k_partial.basetile_shape,
-            dtype=type(x),
-        )
-
-        sin_partial = nntc.zeros((self.sin.shape[0],) + tuple(x.shape[-2:]))
-        cos_partial = nntc.zeros((self.cos.shape[0],) + tuple(x.shape[-2:]))
-        copy_intersection_async(
-            self.sin, [0, 0, 0], sin_partial, [0, kv_cache_size, 0]
-        )
-        copy_intersection_async(
-            self.cos, [0, 0, 0], cos_partial, [0, kv_cache_size, 0]
-        )
-
-        rope_async(sin_partial, cos_partial, q_partial, q_rope_partial)
-        rope_async(sin_partial, cos_partial, k_partial, k_rope_partial)
+        if isinstance(kv_cache, SinkKVCache):
+            # Positions of a bounded cache are its slots, that change on
+            # eviction, so keys are cached before RoPE and rotated on load,
+            # while queries take the last slots after append
+            n_seq = q_partial.shape[1]
+            offset = kv_cache.len_after_append(n_seq) - n_seq
+            q_rope_partial = self._rope_at(q_partial, offset, "q")
+            q_partial.invalidate_submit()
+            return q_rope_partial, k_partial
+        # Tables are read in place starting at position kv_cache_size, and
+        # both Q and K are rotated in place by a single pass
+        kv_cache_size = len(kv_cache) if kv_cache is not None else 0
+        rope_qk_async(kv_cache_size, self.sin, self.cos, q_partial, k_partial)
+        return q_partial, k_partial
+
+    def _rope_at(self, x: Tensor, offset: int, name: str):
+        """
+        Rotate x out of place as if its positions start at offset
 
-        sin_partial.invalidate_submit()
-        cos_partial.invalidate_submit()
-        return q_rope_partial, k_rope_partial
+        Slices of sin and cos tables are kept per name, as a full bounded
+        cache takes the same positions on every step.
+        """
+        key = (offset, tuple(x.shape[1:3]), tuple(x.basetile_shape[1:3]))
+        cached = self._rope_slices.get(name)
+        if cached is None or cached[0] != key:
+            if cached is not None:
+                for table in cached[1]:
+                    table.unregister()
+            tables = []
+            for table in (self.sin, self.cos):
+                table_slice = nntc.empty(
+                    [table.shape[0]] + x.shape[1:3],
+                    basetile_shape=[table.basetile_shape[0]]
+                    + x.basetile_shape[1:3],
+                    dtype=type(table),
+                )
+                copy_intersection_async(
+                    table, [0, 0, 0], table_slice, [0, offset, 0]
+                )
+                tables.append(table_slice)
+            cached = (key, tables)
+            self._rope_slices[name] = cached
+        y = nntc.scratch_like(x)
+        rope_async(cached[1][0], cached[1][1], x, y)
+        return y
 
     def _storeload_kvcache(
         self,
@@ -1238,6 +1371,14 @@ class LlamaAttention(BaseLayer):
         if kv_cache is None:
             return k_rope_partial, v_partial, kv_cache
 
+        if isinstance(kv_cache, SinkKVCache):
+            # Cache is bounded, keys are rotated by their slots
+            kv_cache.append(k_rope_partial, v_partial)
+            k_view = kv_cache.k_view
+            k_cached = self._rope_at(k_view, 0, "k")
+            k_view.invalidate_submit()
+            return k_cached, kv_cache.v_view, kv_cache
+
         if (v_partial.shape[1] + len(kv_cache) > self.x_v.value.shape[1]):
             raise Exception(
                 "Overload internal state: "
@@ -1246,75 +1387,221 @@ class LlamaAttention(BaseLayer):
             )
 
         kv_cache.append(k_rope_partial, v_partial)
-        k_partial_cached = kv_cache.k_partial
-        v_partial_cached = kv_cache.v_partial
-        return k_partial_cached, v_partial_cached, kv_cache
-
-    def _broadcast_kv_dynamic(
-        self, x: Tensor, k_rope_partial: Tensor, v_partial: Tensor
-    ):
-        k_rep_bt_shape = (
-            (self.q_rope.value.basetile_shape[0],)
-            + tuple(k_rope_partial.shape[-3:-1])
-            + tuple(self.q_rope.value.basetile_shape[-2:])
-        )
-        K_rep_shape = (
-            (self.q_rope.value.shape[0],)
-            + tuple(k_rope_partial.shape[-3:-1])
-            + tuple(self.q_rope.value.shape[-2:])
-        )
-        k_rep_partial = nntc.empty(
-            K_rep_shape, basetile_shape=k_rep_bt_shape, dtype=type(x)
-        )
-
-        v_rep_bt_shape = (
-            (self.v_rep.value.basetile_shape[0],)
-            + tuple(v_partial.shape[-3:-1])
-            + tuple(self.v_rep.value.basetile_shape[-2:])
-        )
-        v_rep_shape = (
-            (self.v_rep.value.shape[0],)
-            + tuple(v_partial.shape[-3:-1])
-            + tuple(self.v_rep.value.shape[-2:])
-        )
-        v_rep_partial = nntc.empty(
-            v_rep_shape, basetile_shape=v_rep_bt_shape, dtype=type(x)
-        )
-        add_slice_inplace_async(1.0, k_rope_partial, 0.0, k_rep_partial, 3)
-        add_slice_inplace_async(1.0, v_partial, 0.0, v_rep_partial, 3)
-
-        return k_rep_partial, v_rep_partial
+        # Views of the cache may be longer than len(kv_cache)
+        return kv_cache.k_view, kv_cache.v_view, kv_cache
 
     def forward_dynamic(
         self,
         x: TensorMoments,
         kv_cache: Optional[KVCache] = None
     ):
-        q_partial = self._forward_mlp_q_dynamic(x.value)
-        k_partial = self._forward_mlp_k_dynamic(x.value)
-        v_partial = self._forward_mlp_v_dynamic(x.value)
+        if isinstance(kv_cache, BatchKVCache):
+            return self._forward_dynamic_batch(x, kv_cache)
 
+        q_partial, k_partial, v_partial = self._forward_mlp_qkv_dynamic(
+            x.value
+        )
+
+        # Q and K are rotated in place
         q_rope_partial, k_rope_partial = self._apply_rope_dynamic(
-            x.value, q_partial, k_partial, len(kv_cache) if kv_cache else 0
+            q_partial, k_partial, kv_cache
         )
-        q_partial.invalidate_submit()
-        k_partial.invalidate_submit()
 
-        k_rope_partial, v_partial, kv_cache = self._storeload_kvcache(
+        k_cached, v_cached, kv_cache = self._storeload_kvcache(
             x.value, k_rope_partial, v_partial, kv_cache
         )
+        # New K and V are already stored in the cache
+        if kv_cache is not None:
+            k_rope_partial.invalidate_submit()
+            v_partial.invalidate_submit()
 
-        k_rep_partial, v_rep_partial = self._broadcast_kv_dynamic(
-            x.value, k_rope_partial, v_partial
+        # K and V are shared by kv_group_size heads of Q without repeating
+        y_tensor = self._forward_attn_dynamic(
+            q_rope_partial,
+            k_cached,
+            v_cached,
+            len(kv_cache) if kv_cache is not None else None,
         )
+        q_rope_partial.invalidate_submit()
+        # Views share data with the cache and shall not be invalidated
+        if kv_cache is None or isinstance(kv_cache, SinkKVCache):
+            v_cached.invalidate_submit()
+            k_cached.invalidate_submit()
+
+        return TensorMoments(y_tensor, None, False), kv_cache
+
+    def _forward_dynamic_batch(self, x: TensorMoments, kv_cache: BatchKVCache):
+        # Projections are shared by all sequences of the batch, while every
+        # sequence is rotated and attends to its own cache
+        q_partial, k_partial, v_partial = self._forward_mlp_qkv_dynamic(
+            x.value
+        )
+        b_tmp = nntc.scratch_like(q_partial)
+        b_offset = [0] * len(b_tmp.shape)
+
+        q_seqs = []
+        kv_seqs = []
+        for i, cache in enumerate(kv_cache.caches):
+            q_seq = nntc.slice_copy(q_partial, 2, i)
+            k_seq = nntc.slice_copy(k_partial, 2, i)
+            v_seq = nntc.slice_copy(v_partial, 2, i)
+            q_seq, k_seq = self._apply_rope_dynamic(q_seq, k_seq, cache)
+            k_cached, v_cached, _ = self._storeload_kvcache(
+                x.value, k_seq, v_seq, cache
+            )
+            k_seq.invalidate_submit()
+            v_seq.invalidate_submit()
+            if self.mask_causal:
+                q_seqs.append(q_seq)
+                kv_seqs.append((k_cached, v_cached, len(cache)))
+                continue
+            b_seq = self._forward_attn_core_dynamic(
+                q_seq, k_cached, v_cached, len(cache)
+            )
+            q_seq.invalidate_submit()
+            if isinstance(cache, SinkKVCache):
+                k_cached.invalidate_submit()
+                v_cached.invalidate_submit()
+            b_offset[2] = i
+            copy_intersection_async(
+                b_seq, b_offset, b_tmp, [0] * len(b_offset)
+            )
+            b_seq.invalidate_submit()
+
+        # Causal attention of all the sequences is done at once, without
+        # padding sequences to the longest cache
+        if self.mask_causal:
+            self._forward_attn_varlen_dynamic(q_seqs, kv_seqs, b_tmp)
+            for q_seq in q_seqs:
+                q_seq.invalidate_submit()
+            for cache, (k_cached, v_cached, _) in zip(
+                kv_cache.caches, kv_seqs
+            ):
+                if isinstance(cache, SinkKVCache):
+                    k_cached.invalidate_submit()
+                    v_cached.invalidate_submit()
+
+        q_partial.invalidate_submit()
+        k_partial.invalidate_submit()
         v_partial.invalidate_submit()
-        k_rope_partial.invalidate_submit()
+        y_tensor = self._forward_out_dynamic(b_tmp)
+        b_tmp.invalidate_submit()
+        return TensorMoments(y_tensor, None, False), kv_cache
 
-        y_tensor = self._forward_attn_dynamic(
-            q_rope_partial, k_rep_partial, v_rep_partial
+    def _forward_attn_varlen_dynamic(self, q_seqs, kv_seqs, b_tmp):
+        """
+        Causal attention of sequences with different lengths of KV-caches
+
+        kv_seqs is a list of (keys, values, length) of cached positions of
+        every sequence, keys and values may hold a few more positions.
+
+        Queries and keys of all the sequences are packed one after another
+        along the sequence axis and processed by a single set of flash
+        attention tasks. Tiles of the mask, that pair queries and keys of
+        different sequences, are skipped, so no work is spent on padding to
+        the longest sequence. Result for the i-th sequence is put into
+        b_tmp[:, :, i].
+        """
+        q = q_seqs[0]
+        head_size, n_seq, _, kv_group_size, n_head_kv = q.shape
+        # Flash attention tasks work with square tiles of the mask
+        seq_tile = self.q.value.basetile_shape[1]
+        cu_seqlens_q = [0]
+        cu_seqlens_k = [0]
+        for _, _, kv_len in kv_seqs:
+            cu_seqlens_q.append(cu_seqlens_q[-1] + n_seq)
+            cu_seqlens_k.append(cu_seqlens_k[-1] + kv_len)
+        n_seq_q = -(-cu_seqlens_q[-1] // seq_tile) * seq_tile
+        n_seq_k = -(-cu_seqlens_k[-1] // seq_tile) * seq_tile
+        head_bt = tuple(q.basetile_shape[3:])
+        q_pack = nntc.scratch(
+            (head_size, n_seq_q, 1, kv_group_size, n_head_kv),
+            basetile_shape=(q.basetile_shape[0], seq_tile, 1) + head_bt,
+            dtype=type(q),
+        )  # (head_size, n_seq_packed, 1, kv_group_size, n_head_kv)
+        k_pack = nntc.scratch(
+            (head_size, n_seq_k, 1, n_head_kv),
+            basetile_shape=(q.basetile_shape[0], seq_tile, 1, head_bt[1]),
+            dtype=type(q),
+        )  # (head_size, n_kv_packed, 1, n_head_kv)
+        clear_async(k_pack)
+        v_pack = nntc.scratch_like(k_pack)
+        clear_async(v_pack)
+        offset = [0] * 4
+        for q_seq, (k_seq, v_seq, _), start_q, start_k in zip(
+            q_seqs, kv_seqs, cu_seqlens_q, cu_seqlens_k
+        ):
+            copy_intersection_async(
+                q_seq, [0, start_q, 0, 0, 0], q_pack, [0] * 5
+            )
+            # Views of caches are longer than caches themselves, so a tail of
+            # a view is overwritten by the next sequence
+            offset[1] = start_k
+            copy_intersection_async(k_seq, offset, k_pack, [0] * 4)
+            copy_intersection_async(v_seq, offset, v_pack, [0] * 4)
+
+        # Repeat K and V for every head of a query group
+        k_rep = nntc.scratch(
+            (head_size, n_seq_k, 1, kv_group_size, n_head_kv),
+            basetile_shape=(q.basetile_shape[0], seq_tile, 1) + head_bt,
+            dtype=type(q),
+        )  # (head_size, n_kv_packed, 1, kv_group_size, n_head_kv)
+        v_rep = nntc.scratch_like(k_rep)
+        add_slice_inplace_async(1.0, k_pack, 0.0, k_rep, 3)
+        add_slice_inplace_async(1.0, v_pack, 0.0, v_rep, 3)
+        k_pack.invalidate_submit()
+        v_pack.invalidate_submit()
+
+        mask = nntc.scratch(
+            (n_seq_k, n_seq_q),
+            basetile_shape=(seq_tile, seq_tile),
+            dtype=Tensor_bool,
+        )
+        mask_varlen_async(cu_seqlens_k, cu_seqlens_q, mask)
+        mask_tile_status = mask_varlen_tile_status(
+            cu_seqlens_k, cu_seqlens_q, mask
+        )
+        maxsumexp = nntc.scratch(
+            (2, n_seq_q, 1, kv_group_size, n_head_kv),
+            basetile_shape=(2, seq_tile, 1) + head_bt,
+            dtype=type(q),
+        )
+        clear_async(maxsumexp)
+        a_tmp = nntc.scratch(
+            (n_seq_k, n_seq_q, 1, kv_group_size, n_head_kv),
+            basetile_shape=(seq_tile, seq_tile, 1) + head_bt,
+            dtype=type(q),
+        )
+        b_pack = nntc.scratch_like(q_pack)
+        flash_maxsumexp_async(
+            q_pack,
+            k_rep,
+            mask,
+            maxsumexp,
+            a_tmp,
+            redux=self.redux,
+            mask_tile_status=mask_tile_status,
         )
+        flash_softmax_gemm_async(
+            q_pack,
+            k_rep,
+            v_rep,
+            mask,
+            maxsumexp,
+            b_pack,
+            a_tmp,
+            redux=self.redux,
+            mask_tile_status=mask_tile_status,
+        )
+        for tensor in (q_pack, k_rep, v_rep, mask, maxsumexp, a_tmp):
+            tensor.invalidate_submit()
 
-        return TensorMoments(y_tensor, None, False), kv_cache
+        # Unpack queries of the i-th sequence into b_tmp[:, :, i]
+        for i, start_q in enumerate(cu_seqlens_q[:-1]):
+            copy_intersection_async(
+                b_pack, [0, 0, i, 0, 0], b_tmp, [0, start_q, 0, 0, 0]
+            )
+        b_pack.invalidate_submit()
 
     # Backward propagation of the linear layer
     def backward_async(self):
@@ -1375,30 +1662,34 @@ class LlamaAttention(BaseLayer):
         # self.b_transposed.grad.wont_use()
         self.b_transposed.grad.invalidate_submit()
 
-        # Repeat K along fibers of proper axis
-        # from (head_size, n_seq, n_batch, n_head_kv)
-        # into (head_size, n_seq, n_batch, kv_group_size, n_head_kv)
-        add_slice_inplace_async(
-            1.0, self.k_rope.value, 0.0, self.k_rep.value, 3
-        )
-        # K_rope can be deleted
-        self.k_rope.value.invalidate_submit()
-        # Repeat V along fibers of proper axis
-        # from (head_size, n_seq, n_batch, n_head_kv)
-        # into (head_size, n_seq, n_batch, kv_group_size, n_head_kv)
-        add_slice_inplace_async(1.0, self.v.value, 0.0, self.v_rep.value, 3)
-        # V can be deleted
-        self.v.value.invalidate_submit()
-        # Apply backward to (attention to Q_rope, K_rep and V_rep into B)
         if self.flash_attention:
+            # Repeat K along fibers of proper axis
+            # from (head_size, n_seq, n_batch, n_head_kv)
+            # into (head_size, n_seq, n_batch, kv_group_size, n_head_kv)
+            add_slice_inplace_async(
+                1.0, self.k_rope.value, 0.0, self.k_rep.value, 3
+            )
+            # K_rope can be deleted
+            self.k_rope.value.invalidate_submit()
+            # Repeat V along fibers of proper axis
+            # from (head_size, n_seq, n_batch, n_head_kv)
+            # into (head_size, n_seq, n_batch, kv_group_size, n_head_kv)
+            add_slice_inplace_async(
+                1.0, self.v.value, 0.0, self.v_rep.value, 3
+            )
+            # V can be deleted
+            self.v.value.invalidate_submit()
+            # Apply backward to (attention to Q_rope, K_rep and V_rep into B)
             self._flash_attention_bwd()
+            # Backward for repeating V along fibers of proper axis
+            sum_slice_async(1.0, self.v_rep.grad, 0.0, self.v.grad, 3)
+            # dV_rep can be deleted
+            self.v_rep.grad.invalidate_submit()
         else:
+            # Apply backward to (attention to Q_rope, K_rope and V into B),
+            # gradients over the group are accumulated directly into dK_rope
+            # and dV
             self._attention_bwd()
-
-        # Backward for repeating V along fibers of proper axis
-        sum_slice_async(1.0, self.v_rep.grad, 0.0, self.v.grad, 3)
-        # dV_rep can be deleted
-        self.v_rep.grad.invalidate_submit()
         # Backward for bias of V
         if self.in_proj_bias_v is not None:
             if self.in_proj_bias_v.grad_required:
@@ -1460,7 +1751,7 @@ class LlamaAttention(BaseLayer):
         self.v_transposed.grad.invalidate_submit()
 
         # Backward for repeating K along fibers of proper axis
-        if self.k_rope.grad_required:
+        if self.flash_attention and self.k_rope.grad_required:
             sum_slice_async(1.0, self.k_rep.grad, 0.0, self.k_rope.grad, 3)
         # Backward for RoPE
         if self.k.grad_required:
@@ -1643,7 +1934,8 @@ class LlamaAttention(BaseLayer):
         position_ids: np.ndarray,
         mask: np.ndarray,
         config: LlamaConfigNNTile,
-        next_tag: int
+        next_tag: int,
+        inference: bool = False,
     ):  # -> Self: does not work with Python 3.10
         layer, next_tag = cls.generate_simple(
             x,
@@ -1657,6 +1949,7 @@ class LlamaAttention(BaseLayer):
             mask=mask,
             flash_attention=config.flash_attention,
             redux=config.redux,
+            inference=inference,
         )
         tmp_q_shape = layer.w_q.value.shape.copy()
         tmp_q_shape[:2] = tmp_q_shape[1::-1]
@@ -1997,6 +2290,7 @@ class LlamaAttention(BaseLayer):
             self.a_maxsumexp,
             self.a.value,
             redux=self.redux,
+            mask_tile_status=self.mask_tile_status,
         )
         # Use flash-like softmax+gemm
         flash_softmax_gemm_async(
@@ -2008,6 +2302,7 @@ class LlamaAttention(BaseLayer):
             self.b.value,
             self.a.value,
             redux=self.redux,
+            mask_tile_status=self.mask_tile_status,
         )
         # Q_rope, K_rep, V_rep, mask and A_maxsumexp can be offloaded from GPU
         self.q_rope.value.wont_use()
@@ -2035,6 +2330,7 @@ class LlamaAttention(BaseLayer):
             self.a.grad,
             self.a_sumprod_slice,
             redux=self.redux,
+            mask_tile_status=self.mask_tile_status,
         )
         # Q_rope can be deleted
         self.q_rope.value.invalidate_submit()
@@ -2057,32 +2353,37 @@ class LlamaAttention(BaseLayer):
 
     def _attention_fwd(self):
         # Get tensor for softmax
-        # A = 1.0/sqrt(head_size) * einsum('jklbi,jmlbi->kmlbi', K_rep, Q_rope)
-        # single batched gemm
-        # (head_size, n_seq, batch=(n_batch, kv_group_size, n_head_kv))
+        # A = 1.0/sqrt(head_size) * einsum('jkli,jmlbi->kmlbi', K_rope, Q_rope)
+        # single batched gemm, where K_rope is shared by kv_group_size
+        # (head_size, n_seq, batch=(n_batch, n_head_kv))
         # by (head_size, n_seq, batch=(n_batch, kv_group_size, n_head_kv))
         # into (n_seq, n_seq, batch=(n_batch, kv_group_size, n_head_kv))
-        gemm_async(
+        gemm_gqa_async(
             1.0 / self.head_size**0.5,
             trans,
-            self.k_rep.value,
+            self.k_rope.value,
             notrans,
             self.q_rope.value,
             0.0,
             self.a.value,
             1,
             3,
+            1,
+            GEMM_GQA_BCAST_A,
             redux=self.redux,
         )
         clear_async(self.a_maxsumexp)
-        # Q_rope, K_rep can be offloaded from GPU
+        # Q_rope, K_rope can be offloaded from GPU
         self.q_rope.value.wont_use()
-        self.k_rep.value.wont_use()
+        self.k_rope.value.wont_use()
         # Calculate softmax inplace
         # A = softmax(A, axis=0)
         # Apply mask if needed
-        if self.mask:
-            mask_scalar_async(self.mask, self.val, self.a.value, 3)
+        if self.mask_causal:
+            mask_scalar_causal_async(0, 0, -1, self.val, self.a.value, 3)
+        elif self.mask:
+            mask_scalar_async(self.mask, self.val, self.a.value, 3,
+                              self.mask_tile_status)
             self.mask.wont_use()
         # Calculate max and sumexp along axis
         maxsumexp_async(self.a.value, self.a_maxsumexp, 0, redux=self.redux)
@@ -2091,57 +2392,63 @@ class LlamaAttention(BaseLayer):
         # A_maxsumexp can be deleted
         self.a_maxsumexp.invalidate_submit()
         # Apply value tensor
-        # B = einsum('jklbi,kmlbi->jmlbi', V_rep, A)
-        # batched gemm
-        # (head_size, n_seq, batch=(n_batch, kv_group_size, n_head_kv))
+        # B = einsum('jkli,kmlbi->jmlbi', V, A)
+        # batched gemm, where V is shared by kv_group_size
+        # (head_size, n_seq, batch=(n_batch, n_head_kv))
         # by (n_seq, n_seq, batch=(n_batch, kv_group_size, n_head_kv))
         # into (head_size, n_seq, batch=(n_batch, kv_group_size, n_head_kv))
-        gemm_async(
+        gemm_gqa_async(
             1.0,
             notrans,
-            self.v_rep.value,
+            self.v.value,
             notrans,
             self.a.value,
             0.0,
             self.b.value,
             1,
             3,
+            1,
+            GEMM_GQA_BCAST_A,
             redux=self.redux,
         )
-        # V_rep and A can be offloaded from GPU
-        self.v_rep.value.wont_use()
+        # V and A can be offloaded from GPU
+        self.v.value.wont_use()
         self.a.value.wont_use()
 
     def _attention_bwd(self):
-        # Backward for B = einsum('jklbi,kmlbi->jmlbi', V_rep, A)
+        # Backward for B = einsum('jkli,kmlbi->jmlbi', V, A)
         if self.a.grad_required:
-            # dA = einsum('jklbi,jmlbi->kmlbi', V_rep, dB)
-            gemm_async(
+            # dA = einsum('jkli,jmlbi->kmlbi', V, dB)
+            gemm_gqa_async(
                 1.0,
                 trans,
-                self.v_rep.value,
+                self.v.value,
                 notrans,
                 self.b.grad,
                 0.0,
                 self.a.grad,
                 1,
                 3,
+                1,
+                GEMM_GQA_BCAST_A,
                 redux=self.redux,
             )
-        # V_rep can be deleted
-        self.v_rep.value.invalidate_submit()
-        if self.v_rep.grad_required:
-            # dV_rep = einsum('jmlbi,kmlbi->jklbi', dB, A)
-            gemm_async(
+        # V can be deleted
+        self.v.value.invalidate_submit()
+        if self.v.grad_required:
+            # dV = einsum('jmlbi,kmlbi->jkli', dB, A)
+            gemm_gqa_async(
                 1.0,
                 notrans,
                 self.b.grad,
                 trans,
                 self.a.value,
                 0.0,
-                self.v_rep.grad,
+                self.v.grad,
                 1,
                 3,
+                1,
+                GEMM_GQA_BCAST_C,
                 redux=self.redux,
             )
         # dB can be deleted
@@ -2169,44 +2476,51 @@ class LlamaAttention(BaseLayer):
         # A can be deleted
         self.a.value.invalidate_submit()
         # Backward for mask if needed
-        if self.mask:
-            mask_scalar_async(self.mask, 0.0, self.a.grad, 3)
+        if self.mask_causal:
+            mask_scalar_causal_async(0, 0, -1, 0.0, self.a.grad, 3)
+        elif self.mask:
+            mask_scalar_async(self.mask, 0.0, self.a.grad, 3,
+                              self.mask_tile_status)
             self.mask.wont_use()
         # Backward for:
-        # A = 1.0/sqrt(head_size) * einsum('jklbi,jmlbi->kmlbi', K_rep, Q_rope)
-        if self.k_rep.grad_required:
-            # dK_rep = 1.0/sqrt(head_size)
-            #          * einsum('jmlbi,kmlbi->jklbi', Q_rope, dA)
-            gemm_async(
+        # A = 1.0/sqrt(head_size) * einsum('jkli,jmlbi->kmlbi', K_rope, Q_rope)
+        if self.k_rope.grad_required:
+            # dK_rope = 1.0/sqrt(head_size)
+            #          * einsum('jmlbi,kmlbi->jkli', Q_rope, dA)
+            gemm_gqa_async(
                 1.0 / self.head_size**0.5,
                 notrans,
                 self.q_rope.value,
                 trans,
                 self.a.grad,
                 0.0,
-                self.k_rep.grad,
+                self.k_rope.grad,
                 1,
                 3,
+                1,
+                GEMM_GQA_BCAST_C,
                 redux=self.redux,
             )
         # Q_rope can be deleted
         self.q_rope.value.invalidate_submit()
         if self.q_rope.grad_required:
             # dQ_rope = 1.0/sqrt(head_size)
-            #      * einsum('jklbi,kmlbi->jmlbi', K_rep, dA)
-            gemm_async(
+            #      * einsum('jkli,kmlbi->jmlbi', K_rope, dA)
+            gemm_gqa_async(
                 1.0 / self.head_size**0.5,
                 notrans,
-                self.k_rep.value,
+                self.k_rope.value,
                 notrans,
                 self.a.grad,
                 0.0,
                 self.q_rope.grad,
                 1,
                 3,
+                1,
+                GEMM_GQA_BCAST_A,
                 redux=self.redux,
             )
-        # K_rep can be deleted
-        self.k_rep.value.invalidate_submit()
+        # K_rope can be deleted
+        self.k_rope.value.invalidate_submit()
         # dA can be deleted
         self.a.grad.invalidate_submit()
@@ -25,14 +25,18 @@ class Prod(BaseLayer):
         super().__init__([x, y], [res], [], [])
 
     @staticmethod
-    def generate_simple(x: TensorMoments, y: TensorMoments, next_tag: int):
+    def generate_simple(x: TensorMoments, y: TensorMoments, next_tag: int,
+            inference: bool = False):
         res_traits = TensorTraits(y.value.shape, y.value.basetile_shape)
         res_distr = [0] * res_traits.grid.nelems
         res_value = type(y.value)(res_traits, res_distr, next_tag)
         next_tag = res_value.next_tag
-        res_grad = type(y.value)(res_traits, res_distr, next_tag)
-        next_tag = res_grad.next_tag
-        res = TensorMoments(res_value, res_grad, True)
+        if inference:
+            res = TensorMoments(res_value, None, False)
+        else:
+            res_grad = type(y.value)(res_traits, res_distr, next_tag)
+            next_tag = res_grad.next_tag
+            res = TensorMoments(res_value, res_grad, True)
         return Prod(x, y, res), next_tag
 
     def forward_async(self):
@@ -42,7 +46,7 @@ class Prod(BaseLayer):
         self.res.value.wont_use()
 
     def forward_dynamic(self, x: TensorMoments, y: TensorMoments):
-        res = nntc.empty(x.value.shape, basetile_shape=x.value.basetile_shape)
+        res = nntc.scratch_like(x.value)
         prod_async(x.value, y.value, res)
         return TensorMoments(res, None, False)
 
@@ -46,16 +46,20 @@ class RMSNorm(BaseLayer):
         self.x = x
         self.y = y
         self.gamma = gamma
-        self.gamma.grad.set_reduction_add()
+        if self.gamma.grad is not None:
+            self.gamma.grad.set_reduction_add()
         self.tmp_y_value = tmp_y_value
         self.tmp_y_grad = tmp_y_grad
         self.inv_stddev = inv_stddev
         self.inv_stddev.set_reduction_hypot()
         self.mean = mean
-        self.mean.set_reduction_add()
+        if self.mean is not None:
+            self.mean.set_reduction_add()
         self.axis = axis
         self.l = self.x.value.shape[axis]
         self.eps = eps ** 0.5  # This value is used to init deviation
+        # Gamma is not applied if it is folded into the next layers
+        self.affine = True
         if redux:
             self.redux = 1
         else:
@@ -64,18 +68,21 @@ class RMSNorm(BaseLayer):
     # Simple generator for the normalization layer
     @staticmethod
     def generate_simple(x: TensorMoments, axis: int, eps: float,
-            next_tag: int, redux: bool = False):
+            next_tag: int, redux: bool = False, inference: bool = False):
         # Get traits of X
         x_traits = TensorTraits(x.value.shape, x.value.basetile_shape)
         # Create Y with the same traits and distribution as X
         x_distr = x.value.distribution
         y_value = type(x.value)(x_traits, x_distr, next_tag)
         next_tag = y_value.next_tag
-        # Create grad Y with the same traits and distribution as X
-        y_grad = type(x.value)(x_traits, x_distr, next_tag)
-        next_tag = y_grad.next_tag
-        # Wrap Y
-        y = TensorMoments(y_value, y_grad, True)
+        if inference:
+            y = TensorMoments(y_value, None, False)
+        else:
+            # Create grad Y with the same traits and distribution as X
+            y_grad = type(x.value)(x_traits, x_distr, next_tag)
+            next_tag = y_grad.next_tag
+            # Wrap Y
+            y = TensorMoments(y_value, y_grad, True)
         # Gamma parameter
         gamma_shape = [x.value.shape[axis]]
         gamma_basetile = [x.value.basetile_shape[axis]]
@@ -85,15 +92,21 @@ class RMSNorm(BaseLayer):
             gamma_distr.append(x_distr[x.value.grid.stride[axis] * i])
         gamma_value = type(x.value)(gamma_traits, gamma_distr, next_tag)
         next_tag = gamma_value.next_tag
-        gamma_grad = type(x.value)(gamma_traits, gamma_distr, next_tag)
-        next_tag = gamma_grad.next_tag
-        gamma = TensorMoments(gamma_value, gamma_grad, True)
+        if inference:
+            gamma = TensorMoments(gamma_value, None, False)
+        else:
+            gamma_grad = type(x.value)(gamma_traits, gamma_distr, next_tag)
+            next_tag = gamma_grad.next_tag
+            gamma = TensorMoments(gamma_value, gamma_grad, True)
         # Temporary tensor for normalized input
         tmp_y_value = type(x.value)(x_traits, x_distr, next_tag)
         next_tag = tmp_y_value.next_tag
         # Temporary tensor for gradient of normalized input
-        tmp_y_grad = type(x.value)(x_traits, x_distr, next_tag)
-        next_tag = tmp_y_grad.next_tag
+        if inference:
+            tmp_y_grad = None
+        else:
+            tmp_y_grad = type(x.value)(x_traits, x_distr, next_tag)
+            next_tag = tmp_y_grad.next_tag
         inv_stddev_shape = x.value.shape[:axis] + x.value.shape[axis + 1:]
         inv_stddev_basetile = x.value.basetile_shape[:axis] \
                 + x.value.basetile_shape[axis + 1:]
@@ -110,8 +123,13 @@ class RMSNorm(BaseLayer):
         inv_stddev = type(x.value)(inv_stddev_traits, inv_stddev_distr,
                                    next_tag)
         next_tag = inv_stddev.next_tag
-        mean = type(x.value)(inv_stddev_traits, inv_stddev_distr, next_tag)
-        next_tag = mean.next_tag
+        # Mean is used only by backward
+        if inference:
+            mean = None
+        else:
+            mean = type(x.value)(inv_stddev_traits, inv_stddev_distr,
+                    next_tag)
+            next_tag = mean.next_tag
 
         # Create RMSNorm object with all the provided tensors
         layer = RMSNorm(x, y, gamma, tmp_y_value, tmp_y_grad, mean,
@@ -127,31 +145,36 @@ class RMSNorm(BaseLayer):
         norm_slice_async(1.0 / self.l**0.5, self.x.value, 0.0,
                 self.inv_stddev, self.axis, redux=self.redux)
         hypot_scalar_inverse_async(self.eps, 1.0, self.inv_stddev)
-        # Finally, normalize input
-        copy_async(self.x.value, self.tmp_y_value)
-        prod_slice_async(self.inv_stddev, 1.0, self.tmp_y_value, self.axis)
+        # Finally, normalize input (directly into Y if gamma is folded)
+        tmp_y_value = self.tmp_y_value if self.affine else self.y.value
+        copy_async(self.x.value, tmp_y_value)
+        prod_slice_async(self.inv_stddev, 1.0, tmp_y_value, self.axis)
         # inv_stddev can be offloaded from GPU
         self.inv_stddev.wont_use()
-        # Scale normalized input for the backward phase
-        prod_fiber3_async(self.gamma.value, 1.0, self.tmp_y_value,
-                self.y.value, self.axis)
-        # tmp_Y_value can be offloaded from GPU
-        self.tmp_y_value.wont_use()
-        # gamma can be offloaded from GPU
-        self.gamma.value.wont_use()
+        if self.affine:
+            # Scale normalized input for the backward phase
+            prod_fiber3_async(self.gamma.value, 1.0, self.tmp_y_value,
+                    self.y.value, self.axis)
+            # tmp_Y_value can be offloaded from GPU
+            self.tmp_y_value.wont_use()
+            # gamma can be offloaded from GPU
+            self.gamma.value.wont_use()
         # Y can be offloaded from GPU
         self.y.value.wont_use()
 
     # Dynamic forward propagation of the normalization layer
     def forward_dynamic(self, x: TensorMoments):
-        inv_stddev = nntc.empty(
+        inv_stddev = nntc.scratch(
             x.value.shape[: self.axis] + x.value.shape[self.axis + 1 :],
             basetile_shape=x.value.basetile_shape[: self.axis]
             + x.value.basetile_shape[self.axis + 1 :],
             dtype=type(x.value),
         )
-        tmp_y_value = nntc.empty_like(x.value)
-        y_value = nntc.empty_like(x.value)
+        y_value = nntc.scratch_like(x.value)
+        if self.affine:
+            tmp_y_value = nntc.scratch_like(x.value)
+        else:
+            tmp_y_value = y_value
 
         # Finally, normalize input
         norm_slice_async(
@@ -168,10 +191,11 @@ class RMSNorm(BaseLayer):
         copy_async(x.value, tmp_y_value)
         prod_slice_async(inv_stddev, 1.0, tmp_y_value, self.axis)
 
-        # Scale normalized input for the backward phase
-        prod_fiber3_async(
-            self.gamma.value, 1.0, tmp_y_value, y_value, self.axis
-        )
+        if self.affine:
+            # Scale normalized input
+            prod_fiber3_async(
+                self.gamma.value, 1.0, tmp_y_value, y_value, self.axis
+            )
 
         return TensorMoments(y_value, None, False)
 
@@ -214,10 +238,11 @@ class RMSNorm(BaseLayer):
     @staticmethod
     def from_torch(torch_rmsnorm, x: TensorMoments,
                    axis: int, eps: float,
-                   next_tag: int, redux: bool = False):
+                   next_tag: int, redux: bool = False,
+                   inference: bool = False):
         rmsnorm_layer, next_tag = RMSNorm.generate_simple(x, axis,
                                                           eps, next_tag,
-                                                          redux)
+                                                          redux, inference)
         rmsnorm_layer.parameters[0].value.from_array(
             torch_rmsnorm.weight.data.cpu().detach().numpy())
 
@@ -13,8 +13,14 @@
 
 from typing import List
 
+import nntile.utils.constructors as nntc
 from nntile.layer.base_layer import BaseLayer
-from nntile.tensor import TensorMoments, clear_async
+from nntile.layer.layer_norm import LayerNorm
+from nntile.layer.linear import Linear
+from nntile.layer.rms_norm import RMSNorm
+from nntile.tensor import (
+    Tensor, TensorMoments, clear_async, fill_async, gemm_async, notrans,
+    prod_fiber_async)
 
 
 class BaseModel:
@@ -79,6 +85,55 @@ class BaseModel:
         for x in self.activations:
             x.unregister()
 
+    # Fold affine parameters of normalization layers into linear layers
+    def optimize_for_inference(self):
+        """Fold gamma and beta of normalization layers into the linear
+        layers, that consume their outputs.
+
+        For Y = W (gamma * X + beta) + b weights become W diag(gamma) and
+        biases become b + W beta, so that a folded normalization layer only
+        normalizes its input without prod_fiber3 and add_fiber_inplace. A
+        layer is folded only if it normalizes along axis 0 and all its
+        consumers in the list of layers are linear layers with side 'R',
+        trans_x=notrans, ndim=1 and 2-dimensional weights. Gradients of a
+        folded model are not valid, so it is meant only for inference.
+
+        Returns the number of folded normalization layers.
+        """
+        nfolded = 0
+        for norm in self.layers:
+            if not isinstance(norm, (LayerNorm, RMSNorm)) or not norm.affine:
+                continue
+            y = norm.activations_output[0]
+            consumers = [layer for layer in self.layers
+                    if any(x is y for x in
+                        getattr(layer, "activations_input", []))]
+            if norm.axis != 0 or not consumers or not all(
+                    _is_foldable_linear(layer) for layer in consumers):
+                continue
+            beta = norm.beta.value if isinstance(norm, LayerNorm) else None
+            for layer in consumers:
+                _fold_affine_into_linear(norm.gamma.value, beta, layer)
+            # Folded parameters are now identity
+            fill_async(1.0, norm.gamma.value)
+            if beta is not None:
+                clear_async(beta)
+            norm.affine = False
+            nfolded += 1
+        return nfolded
+
+    # Pack copies of weights of linear layers for inference on CPU
+    def pack_weights(self):
+        for layer in self.layers:
+            if isinstance(layer, Linear) and layer.side == 'R':
+                layer.pack_weight()
+
+    # Drop packed copies of weights of linear layers
+    def unpack_weights(self):
+        for layer in self.layers:
+            if isinstance(layer, Linear):
+                layer.unpack_weight()
+
     def get_parameters(self):
         return self.parameters
 
@@ -93,3 +148,29 @@ class BaseModel:
         for layer in self.layers:
             flops += layer.get_backward_flops()
         return flops
+
+
+def _is_foldable_linear(layer: BaseLayer) -> bool:
+    return (isinstance(layer, Linear) and layer.side == 'R'
+            and layer.trans_x == notrans and layer.ndim == 1
+            and layer.w.value.ndim == 2)
+
+
+def _fold_affine_into_linear(gamma: Tensor, beta: Tensor | None,
+        layer: Linear):
+    w = layer.w.value
+    if beta is not None:
+        if layer.b is None:
+            b_value = nntc.zeros(w.shape[:1], w.basetile_shape[:1],
+                    dtype=type(w))
+            layer.b = TensorMoments(b_value, None, False)
+            layer.parameters.append(layer.b)
+        # b += W beta (before W is scaled)
+        gemm_async(1.0, notrans, w, notrans, beta, 1.0, layer.b.value, 1, 0)
+    # W = W diag(gamma)
+    prod_fiber_async(gamma, 1.0, w, 1)
+    # Packed and stacked copies of weights are outdated now
+    if layer.w_packed is not None:
+        layer.pack_weight()
+    if layer.restack_weight is not None:
+        layer.restack_weight()
@@ -10,15 +10,19 @@
 #
 # @version 1.1.0
 
+from contextlib import nullcontext
+
 import numpy as np
 
 import nntile
 import nntile.utils.constructors as nntc
-from nntile.layer.cache_utils import KVCacheStorage
+from nntile.layer.cache_utils import KVCacheStorage, PagedKVCacheStorage
 from nntile.model.generation.llm_beamsearch import generate_parallel
 from nntile.model.generation.llm_params import GenerationMode, GenerationParams
-from nntile.model.generation.llm_samplers import get_sampler
-from nntile.tensor import Tensor
+from nntile.model.generation.llm_samplers import (
+    GreedySampler, get_sampler, sample_greedy)
+from nntile.nntile_core.tensor import Tensor_int64
+from nntile.tensor import Tensor, copy_intersection_async, set_index_async
 from nntile.utils import constructors as nnt_constructors
 
 
@@ -29,11 +33,27 @@ class LLMGenerationMixin:
         prefill_size: int,
         params: GenerationParams,
         mode: GenerationMode = GenerationMode.Greedy,
+        prefix_cache=None,
     ):
+        """
+        prefix_cache - optional PrefixCache, that lets the prompt reuse keys
+        and values of previously seen prompts with the same prefix (only with
+        use_cache and a single beam)
+        """
         sampler = get_sampler(mode, params)
+        if params.seq_len_buckets is not None and (
+            not params.use_cache
+            or params.need_static_padding
+            or params.num_beams > 1
+            or params.draft_model is not None
+        ):
+            raise Exception(
+                "Bucketed shapes require kvcache and a single beam"
+            )
         if params.need_static_padding:
             # This path only for compatibility with statically defined
-            # model and not efficient on small examples
+            # model and not efficient on small examples, seq_len_buckets
+            # gives fixed shapes without padding and with kvcache
             if params.use_cache:
                 raise Exception("No support for kvcache for static inference")
             if params.num_beams > 1:
@@ -47,6 +67,24 @@ class LLMGenerationMixin:
                 max_tokens=params.max_tokens,
                 eos_token_id=self.eos_token_id,
             )
+        elif params.draft_model is not None:
+            if not params.use_cache or params.num_beams > 1:
+                raise Exception(
+                    "Speculative decoding requires kvcache and a single beam"
+                )
+            if params.kv_cache_window is not None:
+                raise Exception(
+                    "No support for bounded kvcache in speculative decoding"
+                )
+            output_ids = generate_speculative(
+                model=self,
+                draft_model=params.draft_model,
+                input_ids=input_ids,
+                max_tokens=params.max_tokens,
+                eos_token_id=self.eos_token_id,
+                num_speculative_tokens=params.num_speculative_tokens,
+                sampler=sampler,
+            )
         else:
             if params.num_beams == 1:
                 output_ids = generate_autoregress_dynamic(
@@ -56,6 +94,13 @@ class LLMGenerationMixin:
                     eos_token_id=self.eos_token_id,
                     use_cache=params.use_cache,
                     sampler=sampler,
+                    prefix_cache=prefix_cache,
+                    kv_cache_quantized=params.kv_cache_quantized,
+                    prefill_chunk_size=params.prefill_chunk_size,
+                    kv_cache_window=params.kv_cache_window,
+                    kv_cache_sink_size=params.kv_cache_sink_size,
+                    tensor_arena=params.tensor_arena,
+                    seq_len_buckets=params.seq_len_buckets,
                 )
             else:
                 output_ids = generate_parallel(
@@ -87,7 +132,16 @@ class LLMGenerationMixin:
             raise Exception("No support for async static inference")
         else:
             output_ids = await generate_autoregress_dynamic_async(
-                self, input_ids, self.eos_token_id, params, sampler
+                model=self,
+                input_ids=input_ids,
+                max_tokens=params.max_tokens,
+                eos_token_id=self.eos_token_id,
+                use_cache=params.use_cache,
+                sampler=sampler,
+                kv_cache_quantized=params.kv_cache_quantized,
+                prefill_chunk_size=params.prefill_chunk_size,
+                kv_cache_window=params.kv_cache_window,
+                kv_cache_sink_size=params.kv_cache_sink_size,
             )
 
         return output_ids
@@ -98,101 +152,341 @@ def generate_autoregress(
 ):
     cur_seq_size = prefill_size
 
-    output_ids = input_ids
+    sampler = GreedySampler()
+    output_ids = nntc.clone(input_ids)
+    pending = None
     while cur_seq_size < max_tokens:
         logits = model.forward(output_ids)
 
-        # TODO: add starpu function for argmax
-        logits_np = nnt_constructors.to_numpy(logits)
-        pred_token = np.argmax(logits_np[:, cur_seq_size - 1, :])
-
-        if pred_token == eos_token_id:
-            return output_ids, cur_seq_size
-
-        # TODO: add starpu function for scalar assign
-        output_ids_np = nnt_constructors.to_numpy(output_ids)
-        output_ids_np[cur_seq_size, 0] = pred_token
-        output_ids = nntc.from_array(output_ids_np)
+        # Greedy token after the last valid position is written into the
+        # padded sequence on device
+        tokens = sampler.submit_tensor(logits)
+        set_index_async(tokens, cur_seq_size - 1, output_ids, cur_seq_size, 0)
+        if pending is not None and _read_token(*pending) == eos_token_id:
+            return output_ids, cur_seq_size - 1
+        pending = (tokens, cur_seq_size - 1)
         cur_seq_size += 1
 
+    if pending is not None and _read_token(*pending) == eos_token_id:
+        return output_ids, cur_seq_size - 1
     return output_ids, cur_seq_size
 
 
+def _read_token(tokens, index):
+    """Read a sampled token back to host, waiting for sampling to finish"""
+    return nntc.to_numpy(tokens)[index, 0]
+
+
+async def _read_token_async(tokens, index):
+    """Asynchronous version of _read_token"""
+    return (await nntc.to_numpy_async(tokens))[index, 0]
+
+
+def _alloc_output_ids(output_ids_np, max_tokens):
+    """Output sequence, that is padded to max_tokens to append tokens"""
+    num_pad = max(max_tokens - output_ids_np.shape[0], 0)
+    output_ids_np = np.pad(output_ids_np, ((0, num_pad), (0, 0)))
+    return nntc.from_array(np.asfortranarray(output_ids_np))
+
+
+def _append_token(tokens, output_ids, cur_seq_size, next_ids):
+    """
+    Append the last sampled token to the output on device
+
+    The token is also put into next_ids, that is the input of the next step
+    with kv-cache, or a new input with the whole sequence is created without
+    kv-cache. No data is read back to host.
+    """
+    last = tokens.shape[0] - 1
+    set_index_async(tokens, last, output_ids, cur_seq_size, 0)
+    if next_ids is not None:
+        set_index_async(tokens, last, next_ids, 0, 0)
+        return next_ids
+    input_ids = nntc.empty([cur_seq_size + 1, 1], dtype=Tensor_int64)
+    copy_intersection_async(output_ids, [0, 0], input_ids, [0, 0])
+    return input_ids
+
+
+def prefill_chunks(model, input_ids_np, kv_caches, chunk_size, buckets=None):
+    """
+    Prefill all the chunks of a prompt but the last one into kv-caches
+
+    Chunks of at most chunk_size tokens share kv-caches, so a long prompt is
+    submitted as several smaller task graphs instead of a single large one.
+    With buckets (BucketedArenas) chunks are of power-of-two sizes and each
+    one is submitted within a step of the arena of its size.
+    Returns the last chunk, logits of which give the first token.
+    """
+    seq_size = input_ids_np.shape[0]
+    if buckets is not None:
+        sizes = buckets.split(seq_size, chunk_size)
+    elif chunk_size is not None:
+        num_full = (seq_size - 1) // chunk_size
+        sizes = [chunk_size] * num_full + [seq_size - num_full * chunk_size]
+    else:
+        sizes = [seq_size]
+    start = 0
+    for size in sizes[:-1]:
+        chunk = nntc.from_array(input_ids_np[start : start + size])
+        with buckets.step(size) if buckets else nullcontext():
+            logits, _ = model.forward_dynamic(
+                nntile.tensor.TensorMoments(chunk, None, False),
+                use_cache=True,
+                kv_caches=kv_caches,
+            )
+            logits.value.unregister()
+        chunk.unregister()
+        start += size
+    return nntc.from_array(input_ids_np[start:])
+
+
+def _step_arena(input_ids, tensor_arena, seq_len_buckets):
+    """Step of the arena, that serves temporaries of a forward pass"""
+    if seq_len_buckets is not None:
+        return seq_len_buckets.step(input_ids.shape[0])
+    if tensor_arena is not None:
+        return tensor_arena.step()
+    return nullcontext()
+
+
+def _bounded_chunk_size(prefill_chunk_size, kv_cache_window):
+    """
+    Prompt does not fit into a bounded kvcache at once, so it is prefilled
+    by chunks of at most kv_cache_window tokens
+    """
+    if kv_cache_window is None:
+        return prefill_chunk_size
+    if prefill_chunk_size is None:
+        return kv_cache_window
+    return min(prefill_chunk_size, kv_cache_window)
+
+
 def generate_autoregress_dynamic(
-    model, input_ids, max_tokens, eos_token_id, use_cache, sampler
+    model,
+    input_ids,
+    max_tokens,
+    eos_token_id,
+    use_cache,
+    sampler,
+    prefix_cache=None,
+    kv_cache_quantized=False,
+    prefill_chunk_size=None,
+    kv_cache_window=None,
+    kv_cache_sink_size=4,
+    tensor_arena=None,
+    seq_len_buckets=None,
 ):
     cur_seq_size = input_ids.shape[0]
+    if seq_len_buckets is not None and not use_cache:
+        raise Exception("Bucketed shapes require kvcache")
 
     kv_caches = None
     if use_cache:
-        kv_caches = KVCacheStorage()
+        if prefix_cache is not None:
+            if kv_cache_quantized or kv_cache_window is not None:
+                raise Exception(
+                    "No support for quantized or bounded kvcache with prefix "
+                    "cache"
+                )
+            kv_caches = PagedKVCacheStorage(prefix_cache.pool)
+        else:
+            kv_caches = KVCacheStorage(
+                quantized=kv_cache_quantized,
+                window_size=kv_cache_window,
+                sink_size=kv_cache_sink_size,
+            )
+        prefill_chunk_size = _bounded_chunk_size(
+            prefill_chunk_size, kv_cache_window
+        )
+    else:
+        prefix_cache = None
 
     output_ids_np = nntc.to_numpy(input_ids)
 
-    while cur_seq_size < max_tokens:
-        logits_nnt, kv_caches = model.forward_dynamic(
-            nntile.tensor.TensorMoments(input_ids, None, False),
-            use_cache=use_cache,
-            kv_caches=kv_caches,
+    num_cached = 0
+    if prefix_cache is not None:
+        # Only the part of the prompt, that is not cached, is prefilled
+        prompt_ids_np = output_ids_np[:, 0]
+        num_cached = kv_caches.reuse_prefix(prefix_cache, prompt_ids_np)
+        if num_cached > 0:
+            input_ids = nntc.from_array(output_ids_np[num_cached:])
+    if use_cache and (
+        prefill_chunk_size is not None or seq_len_buckets is not None
+    ):
+        input_ids = prefill_chunks(
+            model,
+            output_ids_np[num_cached:],
+            kv_caches,
+            prefill_chunk_size,
+            seq_len_buckets,
         )
-        output_value_np = nntc.to_numpy(logits_nnt.value)
 
-        # TODO: add starpu function for argmax
-        pred_token = sampler.sample(output_value_np[:, -1, :])
-        pred_token = pred_token[0, 0]
-        if pred_token == eos_token_id:
-            return nntc.from_array(output_ids_np), cur_seq_size
+    # Sampled tokens never leave the device: they are appended to the output
+    # and put into the input of the next step by tasks, while the host checks
+    # a token for EOS only after the next step is submitted
+    output_ids = _alloc_output_ids(output_ids_np, max_tokens)
+    next_ids = nntc.empty([1, 1], dtype=Tensor_int64) if use_cache else None
+    pending = None
+    is_prefill = True
+    try:
+        while cur_seq_size < max_tokens:
+            # Temporaries of a step, including logits, go back to the arena
+            # once the token is sampled
+            with _step_arena(input_ids, tensor_arena, seq_len_buckets):
+                logits_nnt, kv_caches = model.forward_dynamic(
+                    nntile.tensor.TensorMoments(input_ids, None, False),
+                    use_cache=use_cache,
+                    kv_caches=kv_caches,
+                )
+                # Full blocks of the prompt are ready right after the prefill
+                if prefix_cache is not None and is_prefill:
+                    prefix_cache.insert(prompt_ids_np, kv_caches.block_table)
+                is_prefill = False
+                tokens = sampler.submit_tensor(logits_nnt.value)
+                logits_nnt = None
+            input_ids = _append_token(
+                tokens, output_ids, cur_seq_size, next_ids
+            )
+            if pending is not None and _read_token(*pending) == eos_token_id:
+                return output_ids, cur_seq_size - 1
+            pending = (tokens, tokens.shape[0] - 1)
+            cur_seq_size += 1
+        if pending is not None and _read_token(*pending) == eos_token_id:
+            return output_ids, cur_seq_size - 1
+    finally:
+        # Blocks of the sequence go back to the pool, while blocks of the
+        # prompt are still referenced by the prefix cache
+        if prefix_cache is not None:
+            kv_caches.clear()
+
+    return output_ids, cur_seq_size
 
-        # TODO: add starpu function for concatenation
-        output_ids_np = np.concatenate(
-            [output_ids_np, pred_token[None, None]], axis=0
+
+def generate_speculative(
+    model,
+    draft_model,
+    input_ids,
+    max_tokens,
+    eos_token_id,
+    num_speculative_tokens,
+    sampler,
+):
+    """
+    Speculative decoding with a draft model
+
+    Draft model greedily proposes up to num_speculative_tokens tokens one by
+    one, then the main model evaluates all of them by a single forward pass.
+    A proposed token is accepted only if it coincides with the token, that
+    the sampler takes from logits of the main model at the same position.
+    Hence output is the same as of generate_autoregress_dynamic, while the
+    main model makes a forward pass per several tokens. KV-caches of both
+    models are truncated to the accepted tokens.
+    """
+    output_ids = nntc.to_numpy(input_ids)[:, 0].tolist()
+    kv_caches = KVCacheStorage()
+    draft_kv_caches = KVCacheStorage()
+
+    def forward(m, caches, token_ids):
+        # Feed all tokens, that are not in caches yet
+        inp_np = np.array(token_ids[len(caches):], dtype=np.int64)
+        logits, _ = m.forward_dynamic(
+            nntile.tensor.TensorMoments(
+                nntc.from_array(inp_np[:, None]), None, False
+            ),
+            use_cache=True,
+            kv_caches=caches,
         )
-        if use_cache:
-            input_ids = nntc.from_array(
-                pred_token[None, None].astype(np.int64)
+        return nntc.to_numpy(logits.value)
+
+    # Prefill
+    logits_np = forward(model, kv_caches, output_ids)
+    next_token = sampler.sample(logits_np[:, -1, :])[0, 0]
+    while next_token != eos_token_id:
+        output_ids.append(next_token)
+        if len(output_ids) >= max_tokens:
+            break
+
+        # Draft model proposes tokens
+        draft_ids = list(output_ids)
+        num_draft = min(num_speculative_tokens, max_tokens - len(output_ids))
+        for _ in range(num_draft):
+            draft_logits_np = forward(
+                draft_model, draft_kv_caches, draft_ids
             )
-        else:
-            input_ids = nntc.from_array(output_ids_np)
-        cur_seq_size += 1
+            draft_ids.append(sample_greedy(draft_logits_np[:, -1, :])[0, 0])
+
+        # Main model checks all proposed tokens at once, the last position
+        # gives a new token if all the proposed ones are accepted
+        logits_np = forward(model, kv_caches, draft_ids)
+        for i in range(num_draft + 1):
+            next_token = sampler.sample(logits_np[:, i, :])[0, 0]
+            if i == num_draft or next_token != draft_ids[len(output_ids)]:
+                break
+            if next_token == eos_token_id or len(output_ids) + 1 >= max_tokens:
+                break
+            output_ids.append(next_token)
 
-    return nntc.from_array(output_ids_np), cur_seq_size
+        # Roll back caches to the accepted tokens
+        kv_caches.truncate(len(output_ids))
+        draft_kv_caches.truncate(len(output_ids))
+
+    output_ids_np = np.array(output_ids, dtype=np.int64)[:, None]
+    return nntc.from_array(output_ids_np), len(output_ids)
 
 
 async def generate_autoregress_dynamic_async(
-    model, input_ids, max_tokens, eos_token_id, use_cache, sampler
+    model,
+    input_ids,
+    max_tokens,
+    eos_token_id,
+    use_cache,
+    sampler,
+    kv_cache_quantized=False,
+    prefill_chunk_size=None,
+    kv_cache_window=None,
+    kv_cache_sink_size=4,
 ):
     cur_seq_size = input_ids.shape[0]
 
     kv_caches = None
     if use_cache:
-        kv_caches = KVCacheStorage()
+        kv_caches = KVCacheStorage(
+            quantized=kv_cache_quantized,
+            window_size=kv_cache_window,
+            sink_size=kv_cache_sink_size,
+        )
+        prefill_chunk_size = _bounded_chunk_size(
+            prefill_chunk_size, kv_cache_window
+        )
 
     output_ids_np = await nntc.to_numpy_async(input_ids)
+    if use_cache and prefill_chunk_size is not None:
+        input_ids = prefill_chunks(
+            model, output_ids_np, kv_caches, prefill_chunk_size
+        )
 
+    output_ids = _alloc_output_ids(output_ids_np, max_tokens)
+    next_ids = nntc.empty([1, 1], dtype=Tensor_int64) if use_cache else None
+    pending = None
     while cur_seq_size < max_tokens:
         logits_nnt, kv_caches = model.forward_dynamic(
             nntile.tensor.TensorMoments(input_ids, None, False),
             use_cache=use_cache,
             kv_caches=kv_caches,
         )
-        output_value_np = await nntc.to_numpy_async(logits_nnt.value)
-
-        # TODO: add starpu function for argmax
-        pred_token = sampler.sample(output_value_np[:, -1, :])
-        pred_token = pred_token[0, 0]
-        if pred_token == eos_token_id:
-            return nntc.from_array(output_ids_np), cur_seq_size
-
-        # TODO: add starpu function for concatenation
-        output_ids_np = np.concatenate(
-            [output_ids_np, pred_token[None, None]], axis=0
-        )
-        if use_cache:
-            input_ids = nntc.from_array(
-                pred_token[None, None].astype(np.int64)
-            )
-        else:
-            input_ids = nntc.from_array(output_ids_np)
+        tokens = sampler.submit_tensor(logits_nnt.value)
+        input_ids = _append_token(tokens, output_ids, cur_seq_size, next_ids)
+        if (
+            pending is not None
+            and await _read_token_async(*pending) == eos_token_id
+        ):
+            return output_ids, cur_seq_size - 1
+        pending = (tokens, tokens.shape[0] - 1)
         cur_seq_size += 1
 
-    return nntc.from_array(output_ids_np), cur_seq_size
+    if (
+        pending is not None
+        and await _read_token_async(*pending) == eos_token_id
+    ):
+        return output_ids, cur_seq_size - 1
+    return output_ids, cur_seq_size
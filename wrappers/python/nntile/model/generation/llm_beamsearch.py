@@ -11,31 +11,63 @@
 # @version 1.1.0
 
 import numpy as np
-import scipy
 
 import nntile.utils.constructors as nntc
-from nntile.layer.cache_utils import ParallelSamplingCacheStorage
+from nntile.layer.cache_utils import KVCacheStorage
 from nntile.model.generation.llm_params import ParallelSamplingMode
-from nntile.tensor import TensorMoments
+from nntile.nntile_core.tensor import Tensor_int64
+from nntile.tensor import (
+    TensorMoments, add_inplace_async, add_slice_inplace_async,
+    beam_topk_async, clear_async, copy_intersection_async, index_select_async,
+    logsumexp_async, maxsumexp_async, set_index_async)
+
+
+def _last_logits(logits):
+    """Logits of the last position of shape (vocab_size, 1, batch_size)"""
+    if logits.shape[1] == 1:
+        return logits
+    shape = logits.shape
+    basetile_shape = logits.basetile_shape
+    shape[1] = 1
+    basetile_shape[1] = 1
+    last = nntc.empty(shape, basetile_shape=basetile_shape, dtype=type(logits))
+    copy_intersection_async(
+        logits, [0, 0, 0], last, [0, logits.shape[1] - 1, 0]
+    )
+    return last
 
 
-def reduce_parallel(beams_logits, sampler):
-    logits = np.vstack(beams_logits)
-    indexes = sampler.sample(logits.T).flatten()
-    beams = list(range(indexes.shape[0]))
-    return indexes.tolist(), beams
+def _log_softmax_inplace(logits):
+    """Turn logits into log-probabilities along vocabulary on device"""
+    shape = logits.shape
+    basetile_shape = logits.basetile_shape
+    maxsumexp = nntc.empty(
+        [2] + shape[1:], basetile_shape=[2] + basetile_shape[1:],
+        dtype=type(logits)
+    )
+    logsumexp = nntc.empty(
+        shape[1:], basetile_shape=basetile_shape[1:], dtype=type(logits)
+    )
+    clear_async(maxsumexp)
+    maxsumexp_async(logits, maxsumexp, 0)
+    logsumexp_async(maxsumexp, logsumexp)
+    add_slice_inplace_async(-1.0, logsumexp, 1.0, logits, 0)
+    maxsumexp.unregister()
+    logsumexp.unregister()
 
 
-def reduce_global(beams_logits, sampler):
-    logits = np.vstack(beams_logits)
-    flat_logits = logits.flatten()
-    indexes_sorted = sampler.sample(
-        flat_logits, num_samples=logits.shape[0]
-    ).flatten()
+def _select_beams(logprobs, num_beams):
+    """
+    Best continuations among all beams on device
 
-    beams = [index // logits.shape[1] for index in indexes_sorted]
-    indexes = [index % logits.shape[1] for index in indexes_sorted]
-    return indexes, beams
+    Returns scores and tokens of shape (1, num_beams), that are sorted in
+    descending order of scores, and parent beams of shape (num_beams,)
+    """
+    scores = nntc.empty([1, num_beams], dtype=type(logprobs))
+    tokens = nntc.empty([1, num_beams], dtype=Tensor_int64)
+    parents = nntc.empty([num_beams], dtype=Tensor_int64)
+    beam_topk_async(logprobs, scores, tokens, parents)
+    return scores, tokens, parents
 
 
 def generate_parallel(
@@ -47,94 +79,74 @@ def generate_parallel(
     sampler,
     sampling_mode=ParallelSamplingMode.BeamSearch,
 ):
+    """
+    Beam search or parallel sampling of num_beams sequences with kv-cache
+
+    All beams are decoded by a single batched forward pass. Accumulation of
+    scores, selection of the best continuations among all beams and
+    reordering of kv-caches and outputs by parent beams are done by tasks, so
+    that the host only checks the best token of the previous step for EOS
+    after the next step is submitted.
+
+    BeamSearch scores a beam by the sum of log-probabilities of its tokens,
+    BeamSearchBigrams only by the last two tokens, while Parallel samples
+    every beam independently with the sampler and never reorders beams.
+
+    Returns output of shape (max_tokens, num_beams), beams are sorted by
+    their scores, and the number of valid positions.
+    """
     assert input_ids.shape[1] == 1
     cur_seq_size = input_ids.shape[0]
-    output_ids_np = nntc.to_numpy(input_ids)
-
-    cache_storage = ParallelSamplingCacheStorage(num_beams)
-
-    out_prefill = model.forward_dynamic(
-        TensorMoments(input_ids, False, None), False, cache_storage
+    output_ids_np = nntc.to_numpy(input_ids).repeat(num_beams, axis=1)
+    num_pad = max(max_tokens - cur_seq_size, 0)
+    output_ids_np = np.pad(output_ids_np, ((0, num_pad), (0, 0)))
+    output_ids = nntc.from_array(np.asfortranarray(output_ids_np))
+    if cur_seq_size >= max_tokens:
+        return output_ids, cur_seq_size
+    kv_caches = KVCacheStorage()
+
+    # Prefill a single sequence, its best tokens start all the beams
+    logits, _ = model.forward_dynamic(
+        TensorMoments(input_ids, None, False), True, kv_caches
     )
-    logits, _ = out_prefill
-    logits_np = nntc.to_numpy(logits.value)
-    last_logits = logits_np[:, -1, :]
-
-    next_tokens = np.argpartition(last_logits[:, 0], -num_beams)[-num_beams:]
-
-    beams_outs = [next_tokens]
-    if sampling_mode == ParallelSamplingMode.BeamSearch:
-        logits = [
-            [scipy.special.softmax(last_logits) for _ in range(num_beams)]
-        ]
-    else:
-        logits = [[last_logits for _ in range(num_beams)]]
+    logprobs = _last_logits(logits.value)
+    _log_softmax_inplace(logprobs)
+    scores, tokens, parents = _select_beams(logprobs, num_beams)
+    kv_caches.reorder(parents)
+    set_index_async(tokens, 0, output_ids, cur_seq_size, 0)
+    pending = (tokens, output_ids)
     cur_seq_size += 1
 
     while cur_seq_size < max_tokens:
-        beams_logits = []
-
-        for beam, t in enumerate(next_tokens):
-            beam_kv_caches = cache_storage.get_beam(beam)
-
-            next_token = np.asfortranarray([t]).astype(np.int64)[:, None]
-            next_token_nnt = nntc.from_array(next_token)
-
-            out_decode = model.forward_dynamic(
-                TensorMoments(next_token_nnt, False, None),
-                True,
-                beam_kv_caches,
-            )
-
-            logits_decode, _ = out_decode
-            logits_decode_np = nntc.to_numpy(logits_decode.value)
-            last_decode_logits = logits_decode_np[:, -1, :]
-            beams_logits.append(last_decode_logits)
+        logits, _ = model.forward_dynamic(
+            TensorMoments(tokens, None, False), True, kv_caches
+        )
         if sampling_mode == ParallelSamplingMode.Parallel:
-            tokens, beams_ids = reduce_parallel(
-                [bl[:, 0] for bl in beams_logits], sampler=sampler
-            )
+            tokens = sampler.submit_tensor(logits.value)
         else:
-            prev_logits = logits[-1]
-            if sampling_mode == ParallelSamplingMode.BeamSearch:
-                weighted_logits = [
-                    scipy.special.softmax(bl[:, 0])
-                    * prev_logits[beam].flatten()[
-                        np.array(next_tokens).flatten()[beam]
-                    ]
-                    for beam, bl in enumerate(beams_logits)
-                ]
-                beams_logits = [el[:, None] for el in weighted_logits]
-            else:
-                weighted_logits = [
-                    scipy.special.softmax(bl[:, 0])
-                    * scipy.special.softmax(prev_logits[beam].flatten())[
-                        np.array(next_tokens).flatten()[beam]
-                    ]
-                    for beam, bl in enumerate(beams_logits)
-                ]
-
-            tokens, beams_ids = reduce_global(weighted_logits, sampler=sampler)
-
-        cache_storage.reduce(beams_ids)
-
-        beams_outs = [np.array(b)[np.array(beams_ids)] for b in beams_outs]
-        beams_logits_save = [beams_logits[beam] for beam in beams_ids]
-
-        next_tokens = tokens
-        beams_outs.append(next_tokens)
-        logits.append(beams_logits_save)
-
+            logprobs = logits.value
+            _log_softmax_inplace(logprobs)
+            add_slice_inplace_async(1.0, scores, 1.0, logprobs, 0)
+            prev_scores = scores
+            scores, tokens, parents = _select_beams(logprobs, num_beams)
+            if sampling_mode == ParallelSamplingMode.BeamSearchBigrams:
+                # Score of a beam is log-probability of its last token
+                parent_scores = nntc.empty_like(prev_scores)
+                index_select_async(parents, prev_scores, parent_scores, 1)
+                add_inplace_async(-1.0, parent_scores, 1.0, scores)
+                parent_scores.unregister()
+            # Beams follow their parents, while outputs of the previous step
+            # stay intact until the EOS check below
+            kv_caches.reorder(parents)
+            new_output_ids = nntc.empty_like(output_ids)
+            index_select_async(parents, output_ids, new_output_ids, 1)
+            output_ids = new_output_ids
+        set_index_async(tokens, 0, output_ids, cur_seq_size, 0)
+        if nntc.to_numpy(pending[0])[0, 0] == eos_token_id:
+            return pending[1], cur_seq_size - 1
+        pending = (tokens, output_ids)
         cur_seq_size += 1
 
-        if tokens[-1] == eos_token_id:
-            break
-
-    result_sequences = np.concatenate(
-        [
-            output_ids_np.repeat(num_beams, axis=1),
-        ]
-        + [np.array(el)[None, :] for el in beams_outs]
-    )
-
-    return nntc.from_array(result_sequences), cur_seq_size
+    if nntc.to_numpy(pending[0])[0, 0] == eos_token_id:
+        return pending[1], cur_seq_size - 1
+    return output_ids, cur_seq_size
@@ -33,8 +33,40 @@ class GenerationParams:
     need_static_padding: bool = False
     top_k: int | None = None
     top_p_thr: float | None = None
+    # Top-p sampling on device among this number of the largest logits,
+    # that approximates the nucleus, None means the exact nucleus on device
+    top_p_max_candidates: int | None = None
+    # Exact top-p sampling on host, that reads all the logits back
+    top_p_on_host: bool = False
     temperature: float = 1
     num_beams: int = 1
     parallel_sampling_mode: ParallelSamplingMode = (
         ParallelSamplingMode.BeamSearch
     )
+    # Speculative decoding: a small model with the same vocabulary proposes
+    # num_speculative_tokens tokens, that are checked by a single forward
+    # pass of the main model
+    draft_model: object | None = None
+    num_speculative_tokens: int = 4
+    # Keys and values are stored in kvcache as int8 with a scale per head of
+    # a token, so that more sequences fit into memory
+    kv_cache_quantized: bool = False
+    # Prompt is prefilled by chunks of at most prefill_chunk_size tokens,
+    # that share kvcache, instead of a single forward pass (only with
+    # use_cache). None means the whole prompt at once.
+    prefill_chunk_size: int | None = None
+    # Bounded kvcache for unbounded generation: only kv_cache_sink_size first
+    # tokens and kv_cache_window last tokens are kept (StreamingLLM-style),
+    # None means all tokens are kept
+    kv_cache_window: int | None = None
+    kv_cache_sink_size: int = 4
+    # Arena of temporary tensors (nntile.utils.arena.TensorArena), that are
+    # reused by all decoding steps instead of being registered anew, None
+    # means new temporaries for every step
+    tensor_arena: object | None = None
+    # Bucketed static shapes (nntile.utils.arena.BucketedArenas): prompt is
+    # prefilled by chunks of power-of-two sizes, so that forward passes take
+    # a few fixed shapes without padding, and every bucket reuses its own
+    # activations and temporaries across steps and calls (only with
+    # use_cache and a single beam)
+    seq_len_buckets: object | None = None
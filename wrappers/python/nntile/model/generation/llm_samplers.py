@@ -15,7 +15,12 @@ from abc import ABC, abstractmethod
 import numpy as np
 from scipy.special import softmax
 
+import nntile.utils.constructors as nntc
+from nntile.functions import (
+    clear_async, logsumexp_async, maxsumexp_async, sample_topk_async,
+    scal_async, topk_async)
 from nntile.model.generation.llm_params import GenerationMode
+from nntile.nntile_core.tensor import Tensor_int64
 
 
 def sample_topk(logits, k, temperature, num_samples=1, with_replace=False):
@@ -88,12 +93,74 @@ def sample_greedy(logits, num_samples=1):
 
 
 class BaseSampler(ABC):
+    # Number of the largest logits, that are selected on device to sample a
+    # token out of them. None means all the logits are sampled on host.
+    num_candidates = None
+    temperature = 0.0
+    top_p = 1.0
+
     @abstractmethod
     def sample(logits):
         pass
 
+    def config(self):
+        """Samplers with the same config sample tokens the same way"""
+        return (type(self), self.num_candidates, self.temperature, self.top_p)
+
+    def submit_tensor(self, logits):
+        """
+        Submit sampling of tokens for all positions of logits
+
+        logits - tensor of shape (vocab_size, seq_size, batch_size)
+
+        Top candidates are selected by a reduction over vocabulary tiles and
+        a token is sampled out of them on device, so only the sampled tokens
+        of shape (seq_size, batch_size) have to be read back. Samplers
+        without a device path sample the last position on host and return
+        a tensor of shape (1, batch_size).
+        """
+        if self.num_candidates is None:
+            tokens_np = self.sample(nntc.to_numpy(logits)[:, -1, :])
+            return nntc.from_array(
+                np.asfortranarray(tokens_np.T.astype(np.int64))
+            )
+        shape = logits.shape
+        basetile = logits.basetile_shape
+        k = min(self.num_candidates, shape[0])
+        val = nntc.empty([k] + shape[1:], [k] + basetile[1:], type(logits))
+        idx = nntc.empty([k] + shape[1:], [k] + basetile[1:], Tensor_int64)
+        tokens = nntc.empty(shape[1:], basetile[1:], Tensor_int64)
+        topk_async(logits, val, idx)
+        seed = int(np.random.default_rng().integers(2**63))
+        sample_topk_async(self.temperature, self.top_p, seed, val, idx, tokens)
+        val.unregister()
+        idx.unregister()
+        return tokens
+
+    def sample_tensor(self, logits):
+        """Sample tokens for the last position of logits of shape
+        (vocab_size, seq_size, batch_size), returns array (batch_size, 1)"""
+        if self.num_candidates is None:
+            return self.sample(nntc.to_numpy(logits)[:, -1, :])
+        tokens = self.submit_tensor(logits)
+        tokens_np = nntc.to_numpy(tokens)
+        tokens.unregister()
+        return tokens_np[-1, :, None]
+
+    async def sample_tensor_async(self, logits):
+        """Asynchronous version of sample_tensor"""
+        if self.num_candidates is None:
+            logits_np = await nntc.to_numpy_async(logits)
+            return self.sample(logits_np[:, -1, :])
+        tokens = self.submit_tensor(logits)
+        tokens_np = await nntc.to_numpy_async(tokens)
+        tokens.unregister()
+        return tokens_np[-1, :, None]
+
 
 class GreedySampler(BaseSampler):
+    num_candidates = 1
+
     def sample(self, logits, num_samples=1):
         return sample_greedy(logits, num_samples=num_samples)
 
@@ -102,6 +169,7 @@ class TopKSampler(BaseSampler):
     def __init__(self, k, temperature):
         self.k = k
         self.temperature = temperature
+        self.num_candidates = k
 
     def sample(self, logits, num_samples=1):
         return sample_topk(
@@ -110,9 +178,102 @@ class TopKSampler(BaseSampler):
 
 
 class TopPSampler(BaseSampler):
-    def __init__(self, p_thr, temperature):
+    # Initial number of candidates of the exact nucleus search on device
+    initial_candidates = 256
+
+    def __init__(
+        self, p_thr, temperature, max_candidates=None, on_host=False
+    ):
+        """
+        max_candidates - number of the largest logits, among which the nucleus
+        is searched for on device. Probabilities are normalized over these
+        candidates only, so tokens come from a different distribution than
+        the one of sample_topp, if the candidates do not cover p_thr of the
+        whole vocabulary (e.g., at a high temperature). None means the exact
+        nucleus, that is found on device by doubling the number of candidates
+        until they cover p_thr of the whole vocabulary.
+        on_host - sample over the whole vocabulary on host like sample_topp,
+        which reads all the logits back.
+        """
         self.p_thr = p_thr
         self.temperature = temperature
+        self.top_p = p_thr
+        self.exact = max_candidates is None
+        if on_host:
+            self.num_candidates = None
+        elif self.exact:
+            self.num_candidates = self.initial_candidates
+        else:
+            self.num_candidates = max_candidates
+
+    def config(self):
+        return super().config() + (self.exact,)
+
+    def submit_tensor(self, logits):
+        """
+        Submit exact top-p sampling of tokens for all positions of logits
+
+        Only the log-normalizer of probabilities and values of the candidates
+        are read back to check that the candidates cover p_thr of the whole
+        vocabulary. Candidates beyond the nucleus of each position are then
+        dropped and a token is sampled out of the rest on device.
+        """
+        if (
+            not self.exact
+            or self.num_candidates is None
+            or self.temperature <= 0
+        ):
+            return super().submit_tensor(logits)
+        shape = logits.shape
+        basetile = logits.basetile_shape
+        # Log-normalizer of softmax(logits/temperature) along vocabulary
+        scaled = nntc.empty_like(logits)
+        scal_async(1.0 / self.temperature, logits, scaled)
+        maxsumexp = nntc.empty(
+            [2] + shape[1:], basetile_shape=[2] + basetile[1:],
+            dtype=type(logits)
+        )
+        logsumexp = nntc.empty(
+            shape[1:], basetile_shape=basetile[1:], dtype=type(logits)
+        )
+        clear_async(maxsumexp)
+        maxsumexp_async(scaled, maxsumexp, 0)
+        logsumexp_async(maxsumexp, logsumexp)
+        scaled.unregister()
+        maxsumexp.unregister()
+        logsumexp_np = nntc.to_numpy(logsumexp).astype(np.float64)
+        logsumexp.unregister()
+        # Grow candidates until they cover the nucleus of every position
+        k = min(self.num_candidates, shape[0])
+        while True:
+            val = nntc.empty([k] + shape[1:], [k] + basetile[1:], type(logits))
+            idx = nntc.empty([k] + shape[1:], [k] + basetile[1:], Tensor_int64)
+            topk_async(logits, val, idx)
+            val_np = nntc.to_numpy(val).astype(np.float64)
+            mass = np.cumsum(
+                np.exp(val_np / self.temperature - logsumexp_np), axis=0
+            )
+            if k == shape[0] or np.all(mass[-1] >= self.p_thr):
+                break
+            val.unregister()
+            idx.unregister()
+            k = min(2 * k, shape[0])
+        # Smallest prefix of candidates with the total probability of at least
+        # p_thr, the rest is marked empty
+        nkeep = np.minimum(np.sum(mass < self.p_thr, axis=0) + 1, k)
+        rank = np.arange(k).reshape((k,) + (1,) * nkeep.ndim)
+        idx_np = nntc.to_numpy(idx)
+        idx_np[rank >= nkeep] = -1
+        idx.unregister()
+        nucleus = nntc.from_array(
+            np.asfortranarray(idx_np), basetile_shape=[k] + basetile[1:]
+        )
+        tokens = nntc.empty(shape[1:], basetile[1:], Tensor_int64)
+        seed = int(np.random.default_rng().integers(2**63))
+        sample_topk_async(self.temperature, 1.0, seed, val, nucleus, tokens)
+        val.unregister()
+        nucleus.unregister()
+        return tokens
 
     def sample(self, logits, num_samples=1):
         return sample_topp(
@@ -126,6 +287,11 @@ def get_sampler(mode, params):
     elif mode == GenerationMode.TopK:
         return TopKSampler(params.top_k, params.temperature)
     elif mode == GenerationMode.TopP:
-        return TopPSampler(params.top_p_thr, params.temperature)
+        return TopPSampler(
+            params.top_p_thr,
+            params.temperature,
+            params.top_p_max_candidates,
+            params.top_p_on_host,
+        )
     else:
         raise Exception("Unknown sampler")
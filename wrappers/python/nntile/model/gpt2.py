@@ -22,13 +22,13 @@ from nntile.layer import (
     Act, AddSlice, Attention, AttentionSingleHead, Embedding, FlashAttention,
     LayerNorm, Linear)
 from nntile.layer.add import Add
-from nntile.layer.cache_utils import KVCacheStorage
+from nntile.layer.cache_utils import BatchKVCacheStorage, KVCacheStorage
 from nntile.model.base_model import BaseModel
 from nntile.model.generation.llm import LLMGenerationMixin
 from nntile.tensor import (
     Tensor, Tensor_bf16, Tensor_bool, Tensor_fp32, Tensor_fp32_fast_bf16,
     Tensor_fp32_fast_fp16, Tensor_fp32_fast_tf32, Tensor_int64, TensorMoments,
-    TensorTraits, notrans)
+    TensorTraits, add_inplace_async, notrans)
 
 
 class GPT2Config(Dict):
@@ -76,7 +76,8 @@ class GPT2MLP(BaseModel):
     next_tag: int
 
     # Construct model with all the provided data
-    def __init__(self, x: TensorMoments, config: GPT2Config, next_tag: int):
+    def __init__(self, x: TensorMoments, config: GPT2Config, next_tag: int,
+            inference: bool = False):
         # Init activations and list of layers
         activations = [x]
         layers = []
@@ -97,12 +98,13 @@ class GPT2MLP(BaseModel):
             [inner_dim_tile],
             next_tag,
             redux=redux,
+            inference=inference,
         )
         layers.append(new_layer)
         activations.extend(new_layer.activations_output)
 
         new_layer, next_tag = Act.generate_simple(
-            activations[-1], activation_function, next_tag
+            activations[-1], activation_function, next_tag, inference
         )
         layers.append(new_layer)
         activations.extend(new_layer.activations_output)
@@ -116,6 +118,7 @@ class GPT2MLP(BaseModel):
             [embed_dim_tile],
             next_tag,
             redux=redux,
+            inference=inference,
         )
         layers.append(new_layer)
         activations.extend(new_layer.activations_output)
@@ -131,12 +134,13 @@ class GPT2MLP(BaseModel):
 
     @staticmethod
     def from_torch(
-        torch_mlp, x: TensorMoments, config: GPT2Config, next_tag: int
+        torch_mlp, x: TensorMoments, config: GPT2Config, next_tag: int,
+        inference: bool = False
     ):
         """
         torch_mlp is PyTorch MLP where no biases in linear layers
         """
-        gpt2mlp_nntile = GPT2MLP(x, config, next_tag)
+        gpt2mlp_nntile = GPT2MLP(x, config, next_tag, inference)
         torch_params = list(torch_mlp.parameters())
         for i, p in enumerate(gpt2mlp_nntile.parameters):
             p.value.from_array(torch_params[i].cpu().detach().numpy().T)
@@ -153,6 +157,7 @@ class GPT2Model(BaseModel, LLMGenerationMixin):
         positional_ids: TensorMoments,
         config: GPT2Config,
         next_tag: int,
+        inference: bool = False,
     ):
         # Check parameter side
         vocab_size = config["vocab_size"]
@@ -214,6 +219,7 @@ class GPT2Model(BaseModel, LLMGenerationMixin):
                                 embed_dim_tile,
                                 vocab_embed_dim_tile,
                                 next_tag,
+                                inference=inference,
                             )
         layers.append(wte_layer)
         activations.extend(wte_layer.activations_output)
@@ -227,20 +233,23 @@ class GPT2Model(BaseModel, LLMGenerationMixin):
                 embed_dim_tile,
                 vocab_embed_dim_tile,
                 next_tag,
+                inference=inference,
             )
 
         layers.append(wpe_layer)
         activations.extend(wpe_layer.activations_output)
 
         add_slice_layer, next_tag = AddSlice.generate_simple(
-            activations[-2], activations[-1], 2, next_tag, redux=redux
+            activations[-2], activations[-1], 2, next_tag, redux=redux,
+            inference=inference,
         )
         layers.append(add_slice_layer)
         activations.extend(add_slice_layer.activations_output)
 
         for h_idx in range(num_hidden_layers):
             l_norm, next_tag = LayerNorm.generate_simple(
-                activations[-1], 0, layer_norm_epsilon, next_tag, redux=redux
+                activations[-1], 0, layer_norm_epsilon, next_tag, redux=redux,
+                inference=inference,
             )
             layers.append(l_norm)
             activations.extend(l_norm.activations_output)
@@ -254,6 +263,7 @@ class GPT2Model(BaseModel, LLMGenerationMixin):
                     True,
                     self.mask,
                     redux=redux,
+                    inference=inference,
                 )
             else:
                 attn_layer, next_tag = AttLayer.generate_simple(
@@ -266,36 +276,39 @@ class GPT2Model(BaseModel, LLMGenerationMixin):
                     True,
                     self.mask,
                     redux=redux,
+                    inference=inference,
                 )
             layers.append(attn_layer)
             activations.extend(attn_layer.activations_output)
 
             new_layer, next_tag = Add.generate_simple(
-                activations[-3], activations[-1], next_tag
+                activations[-3], activations[-1], next_tag, inference
             )
             layers.append(new_layer)
             activations.extend(new_layer.activations_output)
 
             l_norm, next_tag = LayerNorm.generate_simple(
-                activations[-1], 0, layer_norm_epsilon, next_tag, redux=redux
+                activations[-1], 0, layer_norm_epsilon, next_tag, redux=redux,
+                inference=inference,
             )
             layers.append(l_norm)
             activations.extend(l_norm.activations_output)
 
-            gpt_block = GPT2MLP(activations[-1], config, next_tag)
+            gpt_block = GPT2MLP(activations[-1], config, next_tag, inference)
             next_tag = gpt_block.next_tag
 
             activations.extend(gpt_block.activations[1:])
             layers.extend(gpt_block.layers)
 
             new_layer, next_tag = Add.generate_simple(
-                activations[-5], activations[-1], next_tag
+                activations[-5], activations[-1], next_tag, inference
             )
             layers.append(new_layer)
             activations.extend(new_layer.activations_output)
 
         l_norm, next_tag = LayerNorm.generate_simple(
-            activations[-1], 0, layer_norm_epsilon, next_tag, redux=redux
+            activations[-1], 0, layer_norm_epsilon, next_tag, redux=redux,
+            inference=inference,
         )
 
         layers.append(l_norm)
@@ -311,12 +324,14 @@ class GPT2Model(BaseModel, LLMGenerationMixin):
             next_tag,
             False,
             redux=redux,
+            inference=inference,
         )
 
         layers.append(lm_head_layer)
         activations.extend(lm_head_layer.activations_output)
 
         self.seq_len = seq_len
+        self.seq_len_tile = seq_len_tile
         self.num_hidden_layers = num_hidden_layers
         self.next_tag = next_tag
         # Fill Base Model with the generated data
@@ -425,6 +440,7 @@ class GPT2Model(BaseModel, LLMGenerationMixin):
         seq_len_tile: int,
         config: GPT2Config,
         next_tag: int,
+        inference: bool = False,
     ):
         positional_ids_traits = TensorTraits([seq_len], [seq_len_tile])
         positional_ids_distr = [0] * positional_ids_traits.grid.nelems
@@ -447,7 +463,8 @@ class GPT2Model(BaseModel, LLMGenerationMixin):
         x_grad_required = False
         x_moments = TensorMoments(x, x_grad, x_grad_required)
 
-        gpt2_nntile = GPT2Model(x_moments, positional_ids, config, next_tag)
+        gpt2_nntile = GPT2Model(x_moments, positional_ids, config, next_tag,
+                inference)
         nntile_p_idx = 0
         attn_embed_dim = config["embed_dim"]
         attn_nheads = config["n_head"]
@@ -538,6 +555,7 @@ class GPT2Model(BaseModel, LLMGenerationMixin):
         seq_len_tile: int,
         next_tag: int,
         cache_dir: str | None = None,
+        inference: bool = False,
     ):
         # TODO: where should be global repo with all this logic.
         # We need to design it.
@@ -549,6 +567,7 @@ class GPT2Model(BaseModel, LLMGenerationMixin):
             seq_len_tile,
             next_tag,
             cache_dir=cache_dir,
+            inference=inference,
         )
 
     def set_input(self, x: Tensor):
@@ -593,23 +612,45 @@ class GPT2Model(BaseModel, LLMGenerationMixin):
         inp_emb, pos_emb, add_l = self.layers[0:3]
         seq_size = x.value.shape[0]
 
-        kvcache_size = len(kv_caches) if kv_caches else 0
-        pos_ids_np = np.asfortranarray(
-            np.arange(
-                kvcache_size, kvcache_size + seq_size, dtype=np.int64
+        if isinstance(kv_caches, BatchKVCacheStorage):
+            # Every sequence of the batch continues from its own position
+            pos_ids_np = np.asfortranarray(
+                np.stack(
+                    [
+                        np.arange(size, size + seq_size, dtype=np.int64)
+                        for size in kv_caches.cache_sizes()
+                    ],
+                    axis=1,
+                )
             )
-        )
-        pos_ids_nnt_tm = TensorMoments(
-            nntc.from_array(
-                pos_ids_np, basetile_shape=(x.value.basetile_shape[0],)
-            ),
-            None,
-            False,
-        )
-
-        outs_inp = inp_emb.forward_dynamic(x)
-        outs_pos = pos_emb.forward_dynamic(pos_ids_nnt_tm)
-        embedded_input = add_l.forward_dynamic(outs_inp, outs_pos)
+            pos_ids_nnt_tm = TensorMoments(
+                nntc.from_array(
+                    pos_ids_np, basetile_shape=x.value.basetile_shape
+                ),
+                None,
+                False,
+            )
+            outs_inp = inp_emb.forward_dynamic(x)
+            outs_pos = pos_emb.forward_dynamic(pos_ids_nnt_tm)
+            add_inplace_async(1.0, outs_pos.value, 1.0, outs_inp.value)
+            embedded_input = outs_inp
+        else:
+            kvcache_size = len(kv_caches) if kv_caches else 0
+            pos_ids_np = np.asfortranarray(
+                np.arange(
+                    kvcache_size, kvcache_size + seq_size, dtype=np.int64
+                )
+            )
+            pos_ids_nnt_tm = TensorMoments(
+                nntc.from_array(
+                    pos_ids_np, basetile_shape=(x.value.basetile_shape[0],)
+                ),
+                None,
+                False,
+            )
+            outs_inp = inp_emb.forward_dynamic(x)
+            outs_pos = pos_emb.forward_dynamic(pos_ids_nnt_tm)
+            embedded_input = add_l.forward_dynamic(outs_inp, outs_pos)
 
         layers_in_block = 8
         blocks_start = 3
@@ -618,7 +659,12 @@ class GPT2Model(BaseModel, LLMGenerationMixin):
         cache_list = None
         if kv_caches is not None:
             if not kv_caches.is_initialized():
-                kv_caches.init(self.num_hidden_layers, self.seq_len, 1)
+                kv_caches.init(
+                    self.num_hidden_layers,
+                    self.seq_len,
+                    1,
+                    self.seq_len_tile,
+                )
             cache_list = kv_caches.get_cache()
 
         for hidden_id in range(self.num_hidden_layers):
@@ -693,6 +739,7 @@ def create_gpt2_model_from_torch_pretrained(
     seq_len_tile: int,
     next_tag: int,
     cache_dir: str | None = None,
+    inference: bool = False,
 ):
     if model_name not in PretrainedGpt2Configs:
         raise Exception(
@@ -734,6 +781,7 @@ def create_gpt2_model_from_torch_pretrained(
         seq_len_tile,
         nntile_model_config,
         next_tag,
+        inference,
     )
 
     return nntile_model, next_tag
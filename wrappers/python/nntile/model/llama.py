@@ -55,6 +55,7 @@ class Llama(BaseModel):
         self.embd_layer = emb_layer_
         self.final_rmsnorm = rms_norm_layer
         self.seq_len = input_ids.value.shape[0]
+        self.seq_len_tile = input_ids.value.basetile_shape[0]
 
         for dec_layer in decoders:
             activations.extend(dec_layer.activations[1:])
@@ -74,7 +75,9 @@ class Llama(BaseModel):
         cache_list = None
         if kv_caches is not None:
             if not kv_caches.is_initialized():
-                kv_caches.init(len(self.decoders), self.seq_len, 1)
+                kv_caches.init(
+                    len(self.decoders), self.seq_len, 1, self.seq_len_tile
+                )
             cache_list = kv_caches.get_cache()
 
         x_emb = self.embd_layer.forward_dynamic(x)
@@ -97,7 +100,8 @@ class Llama(BaseModel):
                    position_ids: np.ndarray,
                    mask: np.ndarray,
                    config: LlamaConfigNNTile,
-                   next_tag: int):
+                   next_tag: int,
+                   inference: bool = False):
 
         if config.dtype not in ["fp32", "fp32_fast_tf32", "bf16"]:
             raise TypeError("Only fp32, fp32_fast_tf32 and bf16 are"
@@ -122,7 +126,7 @@ class Llama(BaseModel):
                                     config.hidden_size,
                                     config.hidden_size_tile,
                                     config.hidden_size_tile,
-                                    next_tag)
+                                    next_tag, inference)
 
         embed_layer.w.value.from_array(torch_llama.embed_tokens.weight.cpu().detach().numpy().T)
         U = embed_layer.activations_output[0]
@@ -130,7 +134,8 @@ class Llama(BaseModel):
 
         for decoder_llama_torch in torch_llama.layers:
             decoder_nntile_layer, next_tag = LlamaDecoder.from_torch(
-                decoder_llama_torch, U, position_ids, mask, config, next_tag)
+                decoder_llama_torch, U, position_ids, mask, config, next_tag,
+                inference)
             U = decoder_nntile_layer.activations[-1]
             decoders_list.append(decoder_nntile_layer)
 
@@ -139,7 +144,7 @@ class Llama(BaseModel):
                                     decoders_list[-1].activations[-1],
                                     0,
                                     config.rms_norm_eps,
-                                    next_tag, config.redux)
+                                    next_tag, config.redux, inference)
         X = TensorMoments(x_value, None, False)
         llama_nntile = Llama(X,
                              embed_layer,
@@ -102,6 +102,7 @@ class LlamaForCausalLM(BaseModel, LLMGenerationMixin):
         dtype: str = 'fp32',
         flash_attention: bool = False,
         cache_dir: str | None = None,
+        inference: bool = False,
     ):
         # TODO: where should be global repo with all this logic.
         # We need to design it.
@@ -118,6 +119,7 @@ class LlamaForCausalLM(BaseModel, LLMGenerationMixin):
             dtype=dtype,
             flash_attention=flash_attention,
             cache_dir=cache_dir,
+            inference=inference,
         )
 
     @staticmethod
@@ -127,7 +129,8 @@ class LlamaForCausalLM(BaseModel, LLMGenerationMixin):
                    position_ids: np.ndarray,
                    mask: np.ndarray,
                    config: LlamaConfigNNTile,
-                   next_tag: int):
+                   next_tag: int,
+                   inference: bool = False):
 
         if config.dtype not in ["fp32", "fp32_fast_tf32", "bf16"]:
             raise TypeError("Only fp32, fp32_fast_tf32 and bf16 are"
@@ -140,11 +143,13 @@ class LlamaForCausalLM(BaseModel, LLMGenerationMixin):
                    position_ids,
                    mask,
                    config,
-                   next_tag)
+                   next_tag,
+                   inference)
         lin_head, next_tag = Linear.from_torch(torch_llama_causal.lm_head,
                                                llama_model.activations[-1],
                                                config.vocab_size,
-                                               config.redux, next_tag)
+                                               config.redux, next_tag,
+                                               inference)
 
         causal_llama_nntile = LlamaForCausalLM(llama_model,
                                                lin_head,
@@ -195,7 +200,8 @@ def create_llama_model_from_torch_pretrained(
     n_head_tile: int | None,
     dtype: str,
     flash_attention: bool,
-    cache_dir: str | None = None
+    cache_dir: str | None = None,
+    inference: bool = False
 ):
     model_torch = LlamaCausalModel_torch.from_pretrained(
         model_name, cache_dir=cache_dir
@@ -235,7 +241,8 @@ def create_llama_model_from_torch_pretrained(
         pos_ids,
         mask,
         llama_config_nntile,
-        next_tag
+        next_tag,
+        inference
     )
 
     return llama_causal_nntile, next_tag
@@ -84,38 +84,43 @@ class LlamaDecoder(BaseModel):
         torch_llama_decoder, x: TensorMoments,
         position_ids: np.ndarray,
         mask: np.ndarray,
-        config: LlamaConfigNNTile, next_tag: int):
+        config: LlamaConfigNNTile, next_tag: int,
+        inference: bool = False):
         """
         torch_llama_decoder is HF module for LlamaDecoder block
+
+        With inference=True no gradients or temporaries of backward are
+        allocated, so only forward passes are available.
         """
         rms_norm_input_layer, next_tag = RMSNorm.from_torch(
             torch_llama_decoder.input_layernorm, x,
             0, config.rms_norm_eps,
-            next_tag, config.redux)
+            next_tag, config.redux, inference)
         attention_layer, next_tag = LlamaAttention.from_torch(
             torch_llama_decoder.self_attn,
             rms_norm_input_layer.activations_output[0],
             position_ids,
             mask,
             config,
-            next_tag)
+            next_tag,
+            inference)
         post_attn_add, next_tag = Add.generate_simple(
             x, attention_layer.activations_output[0],
-            next_tag)
+            next_tag, inference)
 
         rms_norm_post_attn_layer, next_tag = RMSNorm.from_torch(
             torch_llama_decoder.post_attention_layernorm,
             post_attn_add.activations_output[0],
             0, config.rms_norm_eps,
-            next_tag, config.redux)
+            next_tag, config.redux, inference)
         llama_mlp_module, next_tag = LlamaMLP_nntile.from_torch(
             torch_llama_decoder.mlp,
             rms_norm_post_attn_layer.activations_output[0],
-            config, next_tag)
+            config, next_tag, inference)
         post_mlp_add, next_tag = Add.generate_simple(
             llama_mlp_module.activations[-1],
             post_attn_add.activations_output[0],
-            next_tag)
+            next_tag, inference)
 
         nntile_llama_decoder = LlamaDecoder(x, attention_layer,
                                             llama_mlp_module,
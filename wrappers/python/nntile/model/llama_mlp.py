@@ -15,7 +15,10 @@ import torch
 from transformers import LlamaConfig as LlamaConfig_torch
 from transformers.models.llama.modeling_llama import LlamaMLP as LlamaMLP_torch
 
-from nntile.tensor import TensorMoments, notrans, to_numpy
+import nntile.utils.constructors as nntc
+from nntile.tensor import (
+    TensorMoments, add_fiber_inplace_async, copy_intersection_async,
+    gemm_async, notrans, to_numpy)
 
 from ..layer.act import Act
 from ..layer.linear import Linear
@@ -29,7 +32,7 @@ class LlamaMLP(BaseModel):
 
     # Construct model with all the provided data
     def __init__(self, x: TensorMoments, config: LlamaConfigNNTile,
-                 next_tag: int):
+                 next_tag: int, inference: bool = False):
         # Init activations and list of layers
         activations = [x]
         layers = []
@@ -51,13 +54,14 @@ class LlamaMLP(BaseModel):
             [intermediate_size_tile],
             next_tag,
             redux=redux,
-            bias=self.bias
+            bias=self.bias,
+            inference=inference,
         )
         layers.append(gate_proj)
         activations.extend(gate_proj.activations_output)
 
         new_layer, next_tag = Act.generate_simple(
-            activations[-1], activation_function, next_tag
+            activations[-1], activation_function, next_tag, inference
         )
         layers.append(new_layer)
         activations.extend(new_layer.activations_output)
@@ -71,14 +75,15 @@ class LlamaMLP(BaseModel):
             [intermediate_size_tile],
             next_tag,
             redux=redux,
-            bias=self.bias
+            bias=self.bias,
+            inference=inference,
         )
         layers.append(up_proj)
         activations.extend(up_proj.activations_output)
         self.next_tag = next_tag
 
         prod_layer, next_tag = Prod.generate_simple(
-            activations[-2], activations[-1], next_tag
+            activations[-2], activations[-1], next_tag, inference
         )
         layers.append(prod_layer)
         activations.extend(prod_layer.activations_output)
@@ -92,11 +97,15 @@ class LlamaMLP(BaseModel):
             [hidden_size_tile],
             next_tag,
             redux=redux,
-            bias=self.bias
+            bias=self.bias,
+            inference=inference,
         )
         layers.append(down_proj)
         activations.extend(down_proj.activations_output)
         self.next_tag = next_tag
+        # Weights of gate_proj and up_proj stacked tile by tile, so that the
+        # dynamic forward needs a single gemm
+        self.w_gate_up = None
         # Fill Base Model with the generated data
         super().__init__(activations, layers)
 
@@ -106,12 +115,93 @@ class LlamaMLP(BaseModel):
             if type(layer) is Linear:
                 layer.init_randn_async()
 
+    def fuse_gate_up(self):
+        """Stack weights of gate_proj and up_proj for a single gemm
+
+        Weights are copied into one tensor of shape (intermediate_size, 2,
+        hidden_size), whose base tile spans both projections. Every tile of
+        the stacked weights holds rows of gate_proj and up_proj for the same
+        features, so a single gemm task per tile reads a tile of input once.
+        The stacked tensor is a copy of the weights for inference, that is
+        updated again by this method, e.g., when a normalization layer is
+        folded into the projections by optimize_for_inference(). Fusion is
+        opt-in, as the copy doubles the memory of both projections, and the
+        outputs are copied out of the tiles of the result by extra copy
+        tasks.
+        """
+        gate_proj, up_proj = self.layers[0], self.layers[2]
+        w = gate_proj.w.value
+        if self.w_gate_up is None:
+            self.w_gate_up = nntc.empty(
+                w.shape[:1] + [2] + w.shape[1:],
+                basetile_shape=w.basetile_shape[:1] + [2]
+                + w.basetile_shape[1:],
+                dtype=type(w),
+            )
+        for i, layer in enumerate((gate_proj, up_proj)):
+            w = layer.w.value
+            # View of weights with a unit axis at the place of projection
+            w_view = type(w)(
+                w,
+                w.shape[:1] + [1] + w.shape[1:],
+                w.basetile_shape[:1] + [1] + w.basetile_shape[1:],
+            )
+            copy_intersection_async(w_view, [0, i, 0], self.w_gate_up,
+                    [0, 0, 0])
+            layer.restack_weight = self.fuse_gate_up
+
+    def unregister(self):
+        super().unregister()
+        if self.w_gate_up is not None:
+            self.w_gate_up.unregister()
+            self.w_gate_up = None
+
+    def _forward_gate_up_dynamic(self, x: TensorMoments):
+        gate_proj, up_proj = self.layers[0], self.layers[2]
+        # Packed weights are faster than the stacked ones on CPU
+        if self.w_gate_up is None or gate_proj.w_packed is not None:
+            return gate_proj.forward_dynamic(x), up_proj.forward_dynamic(x)
+        out_shape = gate_proj.out_features_shape + x.value.shape[1:]
+        out_basetile = gate_proj.out_features_basetile_shape \
+            + x.value.shape[1:]
+        gate_up = nntc.scratch(
+            out_shape[:1] + [2] + out_shape[1:],
+            basetile_shape=out_basetile[:1] + [2] + out_basetile[1:],
+            dtype=type(x.value),
+        )  # (intermediate_size, 2, n_seq_dyn, n_batch_dyn)
+        gemm_async(
+            1.0,
+            notrans,
+            self.w_gate_up,
+            notrans,
+            x.value,
+            0.0,
+            gate_up,
+            1,
+            0,
+            redux=gate_proj.redux,
+        )
+        outs = []
+        for i, layer in enumerate((gate_proj, up_proj)):
+            # Projection i is copied out of every tile by its offset
+            y = nntc.scratch(
+                out_shape[:1] + [1] + out_shape[1:],
+                basetile_shape=out_basetile[:1] + [1] + out_basetile[1:],
+                dtype=type(x.value),
+            )
+            copy_intersection_async(gate_up, [0] * 4, y, [0, i, 0, 0])
+            y = type(y)(y, out_shape, out_basetile)
+            if layer.b is not None:
+                add_fiber_inplace_async(1.0, layer.b.value, 1.0, y, 0, 0)
+            outs.append(TensorMoments(y, None, False))
+        gate_up.invalidate_submit()
+        return outs
+
     def forward_dynamic(self, x: TensorMoments):
         gate_proj, gate_proj_act, up_proj, prod, down_proj = self.layers
-        gate_outs = gate_proj.forward_dynamic(x)
+        gate_outs, up_proj_outs = self._forward_gate_up_dynamic(x)
 
         gate_act_outs = gate_proj_act.forward_dynamic(gate_outs)
-        up_proj_outs = up_proj.forward_dynamic(x)
 
         prod_outs = prod.forward_dynamic(gate_act_outs, up_proj_outs)
         down_proj_outs = down_proj.forward_dynamic(prod_outs)
@@ -120,12 +210,13 @@ class LlamaMLP(BaseModel):
 
     @staticmethod
     def from_torch(
-        torch_mlp, x: TensorMoments, config: LlamaConfigNNTile, next_tag: int
+        torch_mlp, x: TensorMoments, config: LlamaConfigNNTile, next_tag: int,
+        inference: bool = False
     ):
         """
         torch_mlp is PyTorch MLP where no biases in linear layers
         """
-        llama_mlp_nntile = LlamaMLP(x, config, next_tag)
+        llama_mlp_nntile = LlamaMLP(x, config, next_tag, inference)
         torch_params = list(torch_mlp.parameters())
         for i, p in enumerate(llama_mlp_nntile.parameters):
             p.value.from_array(torch_params[i].cpu().detach().numpy())
@@ -33,11 +33,13 @@ void def_mod_starpu(py::module_ &m)
     using namespace nntile::starpu;
     using namespace std::chrono_literals;
     py::class_<Config>(m, "Config").
-        def(py::init<int, int, int, int, const char *, int>(),
+        def(py::init<int, int, int, int, const char *, int, int,
+                const char *>(),
                 py::arg("ncpus_")=-1, py::arg("ncuda_")=-1,
                 py::arg("cublas_")=-1, py::arg("logger")=0,
                 py::arg("logger_server_addr")="",
-                py::arg("logger_server_port")=5001).
+                py::arg("logger_server_port")=5001, py::arg("verbose")=0,
+                py::arg("sched_policy")="dmda").
         def("shutdown", &Config::shutdown);
     m.def("init", init);
     m.def("pause", starpu_pause);
@@ -66,6 +68,25 @@ void def_mod_starpu(py::module_ &m)
     m.def("restrict_cuda", [](){restrict_where(STARPU_CUDA);});
     m.def("restrict_cpu", [](){restrict_where(STARPU_CPU);});
     m.def("restrict_restore", [](){restore_where();});
+    m.def("set_task_priority", [](int priority){
+            Config::task_priority = priority;});
+    m.def("get_task_priority", [](){return Config::task_priority;});
+    // Name of the scheduling policy, that StarPU actually uses
+    m.def("get_sched_policy", [](){
+            auto policy = starpu_sched_get_sched_policy();
+            return std::string(policy == nullptr ? "" : policy->policy_name);
+            });
+    // Maximal number of columns, for which gemm is done by gemv tasks
+    m.attr("gemv_max_n") = gemv::max_n;
+    py::class_<TaskGraph>(m, "TaskGraph").
+        def(py::init<>()).
+        def("begin_capture", &TaskGraph::begin_capture).
+        def("end_capture", &TaskGraph::end_capture).
+        def("replay", &TaskGraph::replay).
+        def("wait", &TaskGraph::wait).
+        def("clear", &TaskGraph::clear).
+        def("count", &TaskGraph::count).
+        def("__len__", &TaskGraph::size);
     m.def("profiling_init", [](){
             //starpu_profiling_init();
             });
@@ -420,6 +441,13 @@ void def_class_tensor(py::module_ &m, const char *name)
     py::class_<Tensor<T>, TensorTraits>(m, name, py::multiple_inheritance()).
         def(py::init<const TensorTraits &, const std::vector<int> &,
                 starpu_mpi_tag_t &>()).
+        // View of leading tiles, that shares tiles with the parent tensor
+        def(py::init<const Tensor<T> &, const std::vector<Index> &>()).
+        // View of tiles, selected along a dimension by a list of indices
+        def(py::init<const Tensor<T> &, Index, const std::vector<Index> &>()).
+        // View with unit dimensions removed or inserted
+        def(py::init<const Tensor<T> &, const std::vector<Index> &,
+                const std::vector<Index> &>()).
         def_readonly("next_tag", &Tensor<T>::next_tag).
         def("unregister", &Tensor<T>::unregister).
         // Temporary disable invalidate_submit and use wont_use instead
@@ -478,6 +506,7 @@ void def_mod_tensor(py::module_ &m)
     // Define wrappers for Tensor<T>
     def_class_tensor<nntile::int64_t>(m, "Tensor_int64");
     def_class_tensor<bool_t>(m, "Tensor_bool");
+    def_class_tensor<nntile::int8_t>(m, "Tensor_int8");
     def_class_tensor<fp64_t>(m, "Tensor_fp64");
     def_class_tensor<fp32_fast_tf32_t>(m, "Tensor_fp32_fast_tf32");
     def_class_tensor<fp32_fast_fp16_t>(m, "Tensor_fp32_fast_fp16");
@@ -506,6 +535,20 @@ void def_mod_tensor(py::module_ &m)
     m.def("gemm_bf16", &gemm<bf16_t>);
     //m.def("gemm_fp16", &gemm<fp16_t>);
 
+    m.def("gemm_gqa_async_fp64", &gemm_gqa_async<fp64_t>);
+    m.def("gemm_gqa_async_fp32", &gemm_gqa_async<fp32_t>);
+    m.def("gemm_gqa_async_fp32_fast_tf32", &gemm_gqa_async<fp32_fast_tf32_t>);
+    m.def("gemm_gqa_async_fp32_fast_fp16", &gemm_gqa_async<fp32_fast_fp16_t>);
+    m.def("gemm_gqa_async_fp32_fast_bf16", &gemm_gqa_async<fp32_fast_bf16_t>);
+    m.def("gemm_gqa_async_bf16", &gemm_gqa_async<bf16_t>);
+
+    m.def("gemm_gqa_fp64", &gemm_gqa<fp64_t>);
+    m.def("gemm_gqa_fp32", &gemm_gqa<fp32_t>);
+    m.def("gemm_gqa_fp32_fast_tf32", &gemm_gqa<fp32_fast_tf32_t>);
+    m.def("gemm_gqa_fp32_fast_fp16", &gemm_gqa<fp32_fast_fp16_t>);
+    m.def("gemm_gqa_fp32_fast_bf16", &gemm_gqa<fp32_fast_bf16_t>);
+    m.def("gemm_gqa_bf16", &gemm_gqa<bf16_t>);
+
     // Add activation functions for Tensor<T>
     m.def("relu_async_fp64", &relu_async<fp64_t>);
     m.def("relu_async_fp32_fast_tf32", &relu_async<fp32_fast_tf32_t>);
@@ -626,31 +669,91 @@ void def_mod_tensor(py::module_ &m)
     m.def("sumnorm_fp64", &sumnorm<fp64_t>);
     m.def("sumnorm_fp32", &sumnorm<fp32_t>);
 
-    m.def("flash_softmax_gemm_async_fp64", &flash_softmax_gemm_async<fp64_t>);
-    m.def("flash_softmax_gemm_async_bf16", &flash_softmax_gemm_async<bf16_t>);
-    m.def("flash_softmax_gemm_async_fp32", &flash_softmax_gemm_async<fp32_t>);
-    m.def("flash_softmax_gemm_async_fp32_fast_tf32", &flash_softmax_gemm_async<fp32_fast_tf32_t>);
-    m.def("flash_softmax_gemm_async_fp32_fast_fp16", &flash_softmax_gemm_async<fp32_fast_fp16_t>);
-    m.def("flash_softmax_gemm_async_fp32_fast_bf16", &flash_softmax_gemm_async<fp32_fast_bf16_t>);
-    m.def("flash_softmax_gemm_fp64", &flash_softmax_gemm<fp64_t>);
-    m.def("flash_softmax_gemm_bf16", &flash_softmax_gemm<bf16_t>);
-    m.def("flash_softmax_gemm_fp32", &flash_softmax_gemm<fp32_t>);
-    m.def("flash_softmax_gemm_fp32_fast_tf32", &flash_softmax_gemm<fp32_fast_tf32_t>);
-    m.def("flash_softmax_gemm_fp32_fast_fp16", &flash_softmax_gemm<fp32_fast_fp16_t>);
-    m.def("flash_softmax_gemm_fp32_fast_bf16", &flash_softmax_gemm<fp32_fast_bf16_t>);
-
-    m.def("flash_softmax_gemm_backward_async_fp64", &flash_softmax_gemm_backward_async<fp64_t>);
-    m.def("flash_softmax_gemm_backward_async_bf16", &flash_softmax_gemm_backward_async<bf16_t>);
-    m.def("flash_softmax_gemm_backward_async_fp32", &flash_softmax_gemm_backward_async<fp32_t>);
-    m.def("flash_softmax_gemm_backward_async_fp32_fast_tf32", &flash_softmax_gemm_backward_async<fp32_fast_tf32_t>);
-    m.def("flash_softmax_gemm_backward_async_fp32_fast_fp16", &flash_softmax_gemm_backward_async<fp32_fast_fp16_t>);
-    m.def("flash_softmax_gemm_backward_async_fp32_fast_bf16", &flash_softmax_gemm_backward_async<fp32_fast_bf16_t>);
-    m.def("flash_softmax_gemm_backward_fp64", &flash_softmax_gemm_backward<fp64_t>);
-    m.def("flash_softmax_gemm_backward_fp32", &flash_softmax_gemm_backward<fp32_t>);
-    m.def("flash_softmax_gemm_backward_bf16", &flash_softmax_gemm_backward<bf16_t>);
-    m.def("flash_softmax_gemm_backward_fp32_fast_tf32", &flash_softmax_gemm_backward<fp32_fast_tf32_t>);
-    m.def("flash_softmax_gemm_backward_fp32_fast_fp16", &flash_softmax_gemm_backward<fp32_fast_fp16_t>);
-    m.def("flash_softmax_gemm_backward_fp32_fast_bf16", &flash_softmax_gemm_backward<fp32_fast_bf16_t>);
+    m.def("flash_softmax_gemm_async_fp64", &flash_softmax_gemm_async<fp64_t>, "Q"_a, "K"_a, "V"_a, "mask"_a,
+            "maxsumexp"_a, "dst"_a, "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_async_bf16", &flash_softmax_gemm_async<bf16_t>, "Q"_a, "K"_a, "V"_a, "mask"_a,
+            "maxsumexp"_a, "dst"_a, "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_async_fp32", &flash_softmax_gemm_async<fp32_t>, "Q"_a, "K"_a, "V"_a, "mask"_a,
+            "maxsumexp"_a, "dst"_a, "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_async_fp32_fast_tf32", &flash_softmax_gemm_async<fp32_fast_tf32_t>, "Q"_a, "K"_a, "V"_a, "mask"_a,
+            "maxsumexp"_a, "dst"_a, "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_async_fp32_fast_fp16", &flash_softmax_gemm_async<fp32_fast_fp16_t>, "Q"_a, "K"_a, "V"_a, "mask"_a,
+            "maxsumexp"_a, "dst"_a, "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_async_fp32_fast_bf16", &flash_softmax_gemm_async<fp32_fast_bf16_t>, "Q"_a, "K"_a, "V"_a, "mask"_a,
+            "maxsumexp"_a, "dst"_a, "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_fp64", &flash_softmax_gemm<fp64_t>, "Q"_a, "K"_a, "V"_a, "mask"_a,
+            "maxsumexp"_a, "dst"_a, "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_bf16", &flash_softmax_gemm<bf16_t>, "Q"_a, "K"_a, "V"_a, "mask"_a,
+            "maxsumexp"_a, "dst"_a, "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_fp32", &flash_softmax_gemm<fp32_t>, "Q"_a, "K"_a, "V"_a, "mask"_a,
+            "maxsumexp"_a, "dst"_a, "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_fp32_fast_tf32", &flash_softmax_gemm<fp32_fast_tf32_t>, "Q"_a, "K"_a, "V"_a, "mask"_a,
+            "maxsumexp"_a, "dst"_a, "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_fp32_fast_fp16", &flash_softmax_gemm<fp32_fast_fp16_t>, "Q"_a, "K"_a, "V"_a, "mask"_a,
+            "maxsumexp"_a, "dst"_a, "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_fp32_fast_bf16", &flash_softmax_gemm<fp32_fast_bf16_t>, "Q"_a, "K"_a, "V"_a, "mask"_a,
+            "maxsumexp"_a, "dst"_a, "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+
+    m.def("flash_softmax_gemm_backward_async_fp64", &flash_softmax_gemm_backward_async<fp64_t>, "Q"_a, "dQ"_a, "K"_a, "dK"_a,
+            "V"_a, "dV"_a, "mask"_a, "maxsumexp"_a, "dst_grad"_a, "tmp"_a,
+            "tmp_grad"_a, "tmp_sumprod_slice"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_backward_async_bf16", &flash_softmax_gemm_backward_async<bf16_t>, "Q"_a, "dQ"_a, "K"_a, "dK"_a,
+            "V"_a, "dV"_a, "mask"_a, "maxsumexp"_a, "dst_grad"_a, "tmp"_a,
+            "tmp_grad"_a, "tmp_sumprod_slice"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_backward_async_fp32", &flash_softmax_gemm_backward_async<fp32_t>, "Q"_a, "dQ"_a, "K"_a, "dK"_a,
+            "V"_a, "dV"_a, "mask"_a, "maxsumexp"_a, "dst_grad"_a, "tmp"_a,
+            "tmp_grad"_a, "tmp_sumprod_slice"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_backward_async_fp32_fast_tf32", &flash_softmax_gemm_backward_async<fp32_fast_tf32_t>, "Q"_a, "dQ"_a, "K"_a, "dK"_a,
+            "V"_a, "dV"_a, "mask"_a, "maxsumexp"_a, "dst_grad"_a, "tmp"_a,
+            "tmp_grad"_a, "tmp_sumprod_slice"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_backward_async_fp32_fast_fp16", &flash_softmax_gemm_backward_async<fp32_fast_fp16_t>, "Q"_a, "dQ"_a, "K"_a, "dK"_a,
+            "V"_a, "dV"_a, "mask"_a, "maxsumexp"_a, "dst_grad"_a, "tmp"_a,
+            "tmp_grad"_a, "tmp_sumprod_slice"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_backward_async_fp32_fast_bf16", &flash_softmax_gemm_backward_async<fp32_fast_bf16_t>, "Q"_a, "dQ"_a, "K"_a, "dK"_a,
+            "V"_a, "dV"_a, "mask"_a, "maxsumexp"_a, "dst_grad"_a, "tmp"_a,
+            "tmp_grad"_a, "tmp_sumprod_slice"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_backward_fp64", &flash_softmax_gemm_backward<fp64_t>, "Q"_a, "dQ"_a, "K"_a, "dK"_a,
+            "V"_a, "dV"_a, "mask"_a, "maxsumexp"_a, "dst_grad"_a, "tmp"_a,
+            "tmp_grad"_a, "tmp_sumprod_slice"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_backward_fp32", &flash_softmax_gemm_backward<fp32_t>, "Q"_a, "dQ"_a, "K"_a, "dK"_a,
+            "V"_a, "dV"_a, "mask"_a, "maxsumexp"_a, "dst_grad"_a, "tmp"_a,
+            "tmp_grad"_a, "tmp_sumprod_slice"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_backward_bf16", &flash_softmax_gemm_backward<bf16_t>, "Q"_a, "dQ"_a, "K"_a, "dK"_a,
+            "V"_a, "dV"_a, "mask"_a, "maxsumexp"_a, "dst_grad"_a, "tmp"_a,
+            "tmp_grad"_a, "tmp_sumprod_slice"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_backward_fp32_fast_tf32", &flash_softmax_gemm_backward<fp32_fast_tf32_t>, "Q"_a, "dQ"_a, "K"_a, "dK"_a,
+            "V"_a, "dV"_a, "mask"_a, "maxsumexp"_a, "dst_grad"_a, "tmp"_a,
+            "tmp_grad"_a, "tmp_sumprod_slice"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_backward_fp32_fast_fp16", &flash_softmax_gemm_backward<fp32_fast_fp16_t>, "Q"_a, "dQ"_a, "K"_a, "dK"_a,
+            "V"_a, "dV"_a, "mask"_a, "maxsumexp"_a, "dst_grad"_a, "tmp"_a,
+            "tmp_grad"_a, "tmp_sumprod_slice"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_softmax_gemm_backward_fp32_fast_bf16", &flash_softmax_gemm_backward<fp32_fast_bf16_t>, "Q"_a, "dQ"_a, "K"_a, "dK"_a,
+            "V"_a, "dV"_a, "mask"_a, "maxsumexp"_a, "dst_grad"_a, "tmp"_a,
+            "tmp_grad"_a, "tmp_sumprod_slice"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
 
     m.def("softmax_async_fp64", &softmax_async<fp64_t>);
     m.def("softmax_async_bf16", &softmax_async<bf16_t>);
@@ -739,18 +842,42 @@ void def_mod_tensor(py::module_ &m)
     m.def("normalize_fp64", &normalize<fp64_t>, "gamma_beta"_a, "src"_a, "dst"_a, "size"_a, "eps"_a, "axis"_a);
     m.def("normalize_fp32", &normalize<fp32_t>, "gamma_beta"_a, "src"_a, "dst"_a, "size"_a, "eps"_a, "axis"_a);
 
-    m.def("flash_maxsumexp_async_fp64", &flash_maxsumexp_async<fp64_t>);
-    m.def("flash_maxsumexp_async_bf16", &flash_maxsumexp_async<bf16_t>);
-    m.def("flash_maxsumexp_async_fp32", &flash_maxsumexp_async<fp32_t>);
-    m.def("flash_maxsumexp_async_fp32_fast_tf32", &flash_maxsumexp_async<fp32_fast_tf32_t>);
-    m.def("flash_maxsumexp_async_fp32_fast_fp16", &flash_maxsumexp_async<fp32_fast_fp16_t>);
-    m.def("flash_maxsumexp_async_fp32_fast_bf16", &flash_maxsumexp_async<fp32_fast_bf16_t>);
-    m.def("flash_maxsumexp_fp64", &flash_maxsumexp<fp64_t>);
-    m.def("flash_maxsumexp_fp32", &flash_maxsumexp<fp32_t>);
-    m.def("flash_maxsumexp_bf16", &flash_maxsumexp<bf16_t>);
-    m.def("flash_maxsumexp_fp32_fast_tf32", &flash_maxsumexp<fp32_fast_tf32_t>);
-    m.def("flash_maxsumexp_fp32_fast_fp16", &flash_maxsumexp<fp32_fast_fp16_t>);
-    m.def("flash_maxsumexp_fp32_fast_bf16", &flash_maxsumexp<fp32_fast_bf16_t>);
+    m.def("flash_maxsumexp_async_fp64", &flash_maxsumexp_async<fp64_t>, "Q"_a, "K"_a, "mask"_a, "maxsumexp"_a,
+            "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_maxsumexp_async_bf16", &flash_maxsumexp_async<bf16_t>, "Q"_a, "K"_a, "mask"_a, "maxsumexp"_a,
+            "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_maxsumexp_async_fp32", &flash_maxsumexp_async<fp32_t>, "Q"_a, "K"_a, "mask"_a, "maxsumexp"_a,
+            "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_maxsumexp_async_fp32_fast_tf32", &flash_maxsumexp_async<fp32_fast_tf32_t>, "Q"_a, "K"_a, "mask"_a, "maxsumexp"_a,
+            "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_maxsumexp_async_fp32_fast_fp16", &flash_maxsumexp_async<fp32_fast_fp16_t>, "Q"_a, "K"_a, "mask"_a, "maxsumexp"_a,
+            "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_maxsumexp_async_fp32_fast_bf16", &flash_maxsumexp_async<fp32_fast_bf16_t>, "Q"_a, "K"_a, "mask"_a, "maxsumexp"_a,
+            "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_maxsumexp_fp64", &flash_maxsumexp<fp64_t>, "Q"_a, "K"_a, "mask"_a, "maxsumexp"_a,
+            "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_maxsumexp_fp32", &flash_maxsumexp<fp32_t>, "Q"_a, "K"_a, "mask"_a, "maxsumexp"_a,
+            "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_maxsumexp_bf16", &flash_maxsumexp<bf16_t>, "Q"_a, "K"_a, "mask"_a, "maxsumexp"_a,
+            "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_maxsumexp_fp32_fast_tf32", &flash_maxsumexp<fp32_fast_tf32_t>, "Q"_a, "K"_a, "mask"_a, "maxsumexp"_a,
+            "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_maxsumexp_fp32_fast_fp16", &flash_maxsumexp<fp32_fast_fp16_t>, "Q"_a, "K"_a, "mask"_a, "maxsumexp"_a,
+            "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("flash_maxsumexp_fp32_fast_bf16", &flash_maxsumexp<fp32_fast_bf16_t>, "Q"_a, "K"_a, "mask"_a, "maxsumexp"_a,
+            "tmp"_a, "redux"_a=0,
+            "mask_tile_status"_a=std::vector<int>());
 
     m.def("maxsumexp_async_fp64", &maxsumexp_async<fp64_t>);
     m.def("maxsumexp_async_bf16", &maxsumexp_async<bf16_t>);
@@ -896,11 +1023,22 @@ void def_mod_tensor(py::module_ &m)
     m.def("copy_intersection_async_fp64", &copy_intersection_async<fp64_t>);
     m.def("copy_intersection_async_fp32", &copy_intersection_async<fp32_t>);
     m.def("copy_intersection_async_int64", &copy_intersection_async<nntile::int64_t>);
+    m.def("copy_intersection_async_int8", &copy_intersection_async<nntile::int8_t>);
 
     m.def("copy_intersection_bool", &copy_intersection<bool_t>);
     m.def("copy_intersection_fp64", &copy_intersection<fp64_t>);
     m.def("copy_intersection_fp32", &copy_intersection<fp32_t>);
     m.def("copy_intersection_int64", &copy_intersection<nntile::int64_t>);
+    m.def("copy_intersection_int8", &copy_intersection<nntile::int8_t>);
+
+    m.def("set_index_async_bool", &set_index_async<bool_t>);
+    m.def("set_index_async_fp64", &set_index_async<fp64_t>);
+    m.def("set_index_async_fp32", &set_index_async<fp32_t>);
+    m.def("set_index_async_int64", &set_index_async<nntile::int64_t>);
+    m.def("set_index_bool", &set_index<bool_t>);
+    m.def("set_index_fp64", &set_index<fp64_t>);
+    m.def("set_index_fp32", &set_index<fp32_t>);
+    m.def("set_index_int64", &set_index<nntile::int64_t>);
 
     m.def("copy_async_fp64", &copy_async<fp64_t>);
     m.def("copy_async_bf16", &copy_async<bf16_t>);
@@ -1177,18 +1315,153 @@ void def_mod_tensor(py::module_ &m)
     //m.def("fp32_to_fp16_async", &fp32_to_fp16_async);
     //m.def("fp16_to_fp32_async", &fp16_to_fp32_async);
 
-    m.def("mask_scalar_async_fp64", &mask_scalar_async<fp64_t>);
-    m.def("mask_scalar_async_bf16", &mask_scalar_async<bf16_t>);
-    m.def("mask_scalar_async_fp32", &mask_scalar_async<fp32_t>);
-    m.def("mask_scalar_async_fp32_fast_tf32", &mask_scalar_async<fp32_fast_tf32_t>);
-    m.def("mask_scalar_async_fp32_fast_fp16", &mask_scalar_async<fp32_fast_fp16_t>);
-    m.def("mask_scalar_async_fp32_fast_bf16", &mask_scalar_async<fp32_fast_bf16_t>);
-    m.def("mask_scalar_fp64", &mask_scalar<fp64_t>);
-    m.def("mask_scalar_fp32", &mask_scalar<fp32_t>);
-    m.def("mask_scalar_bf16", &mask_scalar<bf16_t>);
-    m.def("mask_scalar_fp32_fast_tf32", &mask_scalar<fp32_fast_tf32_t>);
-    m.def("mask_scalar_fp32_fast_fp16", &mask_scalar<fp32_fast_fp16_t>);
-    m.def("mask_scalar_fp32_fast_bf16", &mask_scalar<fp32_fast_bf16_t>);
+    m.def("mask_scalar_async_fp64", &mask_scalar_async<fp64_t>, "mask"_a, "val"_a, "A"_a, "batch_ndim"_a,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("mask_scalar_async_bf16", &mask_scalar_async<bf16_t>, "mask"_a, "val"_a, "A"_a, "batch_ndim"_a,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("mask_scalar_async_fp32", &mask_scalar_async<fp32_t>, "mask"_a, "val"_a, "A"_a, "batch_ndim"_a,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("mask_scalar_async_fp32_fast_tf32", &mask_scalar_async<fp32_fast_tf32_t>, "mask"_a, "val"_a, "A"_a, "batch_ndim"_a,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("mask_scalar_async_fp32_fast_fp16", &mask_scalar_async<fp32_fast_fp16_t>, "mask"_a, "val"_a, "A"_a, "batch_ndim"_a,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("mask_scalar_async_fp32_fast_bf16", &mask_scalar_async<fp32_fast_bf16_t>, "mask"_a, "val"_a, "A"_a, "batch_ndim"_a,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("mask_scalar_fp64", &mask_scalar<fp64_t>, "mask"_a, "val"_a, "A"_a, "batch_ndim"_a,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("mask_scalar_fp32", &mask_scalar<fp32_t>, "mask"_a, "val"_a, "A"_a, "batch_ndim"_a,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("mask_scalar_bf16", &mask_scalar<bf16_t>, "mask"_a, "val"_a, "A"_a, "batch_ndim"_a,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("mask_scalar_fp32_fast_tf32", &mask_scalar<fp32_fast_tf32_t>, "mask"_a, "val"_a, "A"_a, "batch_ndim"_a,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("mask_scalar_fp32_fast_fp16", &mask_scalar<fp32_fast_fp16_t>, "mask"_a, "val"_a, "A"_a, "batch_ndim"_a,
+            "mask_tile_status"_a=std::vector<int>());
+    m.def("mask_scalar_fp32_fast_bf16", &mask_scalar<fp32_fast_bf16_t>, "mask"_a, "val"_a, "A"_a, "batch_ndim"_a,
+            "mask_tile_status"_a=std::vector<int>());
+
+    m.def("mask_scalar_causal_async_fp64", &mask_scalar_causal_async<fp64_t>);
+    m.def("mask_scalar_causal_async_bf16", &mask_scalar_causal_async<bf16_t>);
+    m.def("mask_scalar_causal_async_fp32", &mask_scalar_causal_async<fp32_t>);
+    m.def("mask_scalar_causal_async_fp32_fast_tf32", &mask_scalar_causal_async<fp32_fast_tf32_t>);
+    m.def("mask_scalar_causal_async_fp32_fast_fp16", &mask_scalar_causal_async<fp32_fast_fp16_t>);
+    m.def("mask_scalar_causal_async_fp32_fast_bf16", &mask_scalar_causal_async<fp32_fast_bf16_t>);
+    m.def("mask_scalar_causal_fp64", &mask_scalar_causal<fp64_t>);
+    m.def("mask_scalar_causal_bf16", &mask_scalar_causal<bf16_t>);
+    m.def("mask_scalar_causal_fp32", &mask_scalar_causal<fp32_t>);
+    m.def("mask_scalar_causal_fp32_fast_tf32", &mask_scalar_causal<fp32_fast_tf32_t>);
+    m.def("mask_scalar_causal_fp32_fast_fp16", &mask_scalar_causal<fp32_fast_fp16_t>);
+    m.def("mask_scalar_causal_fp32_fast_bf16", &mask_scalar_causal<fp32_fast_bf16_t>);
+
+    m.def("mask_varlen_async", &mask_varlen_async);
+    m.def("mask_varlen", &mask_varlen);
+    m.def("mask_varlen_tile_status", &mask_varlen_tile_status);
+
+    m.def("topk_async_fp64", &topk_async<fp64_t>);
+    m.def("topk_async_bf16", &topk_async<bf16_t>);
+    m.def("topk_async_fp32", &topk_async<fp32_t>);
+    m.def("topk_async_fp32_fast_tf32", &topk_async<fp32_fast_tf32_t>);
+    m.def("topk_async_fp32_fast_fp16", &topk_async<fp32_fast_fp16_t>);
+    m.def("topk_async_fp32_fast_bf16", &topk_async<fp32_fast_bf16_t>);
+    m.def("topk_fp64", &topk<fp64_t>);
+    m.def("topk_bf16", &topk<bf16_t>);
+    m.def("topk_fp32", &topk<fp32_t>);
+    m.def("topk_fp32_fast_tf32", &topk<fp32_fast_tf32_t>);
+    m.def("topk_fp32_fast_fp16", &topk<fp32_fast_fp16_t>);
+    m.def("topk_fp32_fast_bf16", &topk<fp32_fast_bf16_t>);
+
+    m.def("sample_topk_async_fp64", &sample_topk_async<fp64_t>);
+    m.def("sample_topk_async_bf16", &sample_topk_async<bf16_t>);
+    m.def("sample_topk_async_fp32", &sample_topk_async<fp32_t>);
+    m.def("sample_topk_async_fp32_fast_tf32", &sample_topk_async<fp32_fast_tf32_t>);
+    m.def("sample_topk_async_fp32_fast_fp16", &sample_topk_async<fp32_fast_fp16_t>);
+    m.def("sample_topk_async_fp32_fast_bf16", &sample_topk_async<fp32_fast_bf16_t>);
+    m.def("sample_topk_fp64", &sample_topk<fp64_t>);
+    m.def("sample_topk_bf16", &sample_topk<bf16_t>);
+    m.def("sample_topk_fp32", &sample_topk<fp32_t>);
+    m.def("sample_topk_fp32_fast_tf32", &sample_topk<fp32_fast_tf32_t>);
+    m.def("sample_topk_fp32_fast_fp16", &sample_topk<fp32_fast_fp16_t>);
+    m.def("sample_topk_fp32_fast_bf16", &sample_topk<fp32_fast_bf16_t>);
+
+    m.def("quantize_async_fp64", &quantize_async<fp64_t>);
+    m.def("quantize_async_bf16", &quantize_async<bf16_t>);
+    m.def("quantize_async_fp32", &quantize_async<fp32_t>);
+    m.def("quantize_async_fp32_fast_tf32", &quantize_async<fp32_fast_tf32_t>);
+    m.def("quantize_async_fp32_fast_fp16", &quantize_async<fp32_fast_fp16_t>);
+    m.def("quantize_async_fp32_fast_bf16", &quantize_async<fp32_fast_bf16_t>);
+    m.def("quantize_fp64", &quantize<fp64_t>);
+    m.def("quantize_bf16", &quantize<bf16_t>);
+    m.def("quantize_fp32", &quantize<fp32_t>);
+    m.def("quantize_fp32_fast_tf32", &quantize<fp32_fast_tf32_t>);
+    m.def("quantize_fp32_fast_fp16", &quantize<fp32_fast_fp16_t>);
+    m.def("quantize_fp32_fast_bf16", &quantize<fp32_fast_bf16_t>);
+
+    m.def("dequantize_async_fp64", &dequantize_async<fp64_t>);
+    m.def("dequantize_async_bf16", &dequantize_async<bf16_t>);
+    m.def("dequantize_async_fp32", &dequantize_async<fp32_t>);
+    m.def("dequantize_async_fp32_fast_tf32", &dequantize_async<fp32_fast_tf32_t>);
+    m.def("dequantize_async_fp32_fast_fp16", &dequantize_async<fp32_fast_fp16_t>);
+    m.def("dequantize_async_fp32_fast_bf16", &dequantize_async<fp32_fast_bf16_t>);
+    m.def("dequantize_fp64", &dequantize<fp64_t>);
+    m.def("dequantize_bf16", &dequantize<bf16_t>);
+    m.def("dequantize_fp32", &dequantize<fp32_t>);
+    m.def("dequantize_fp32_fast_tf32", &dequantize<fp32_fast_tf32_t>);
+    m.def("dequantize_fp32_fast_fp16", &dequantize<fp32_fast_fp16_t>);
+    m.def("dequantize_fp32_fast_bf16", &dequantize<fp32_fast_bf16_t>);
+
+    m.def("pack_panels_async_fp64", &pack_panels_async<fp64_t>);
+    m.def("pack_panels_async_bf16", &pack_panels_async<bf16_t>);
+    m.def("pack_panels_async_fp32", &pack_panels_async<fp32_t>);
+    m.def("pack_panels_async_fp32_fast_tf32", &pack_panels_async<fp32_fast_tf32_t>);
+    m.def("pack_panels_async_fp32_fast_fp16", &pack_panels_async<fp32_fast_fp16_t>);
+    m.def("pack_panels_async_fp32_fast_bf16", &pack_panels_async<fp32_fast_bf16_t>);
+    m.def("pack_panels_fp64", &pack_panels<fp64_t>);
+    m.def("pack_panels_bf16", &pack_panels<bf16_t>);
+    m.def("pack_panels_fp32", &pack_panels<fp32_t>);
+    m.def("pack_panels_fp32_fast_tf32", &pack_panels<fp32_fast_tf32_t>);
+    m.def("pack_panels_fp32_fast_fp16", &pack_panels<fp32_fast_fp16_t>);
+    m.def("pack_panels_fp32_fast_bf16", &pack_panels<fp32_fast_bf16_t>);
+
+    m.def("gemm_packed_async_fp64", &gemm_packed_async<fp64_t>);
+    m.def("gemm_packed_async_bf16", &gemm_packed_async<bf16_t>);
+    m.def("gemm_packed_async_fp32", &gemm_packed_async<fp32_t>);
+    m.def("gemm_packed_async_fp32_fast_tf32", &gemm_packed_async<fp32_fast_tf32_t>);
+    m.def("gemm_packed_async_fp32_fast_fp16", &gemm_packed_async<fp32_fast_fp16_t>);
+    m.def("gemm_packed_async_fp32_fast_bf16", &gemm_packed_async<fp32_fast_bf16_t>);
+    m.def("gemm_packed_fp64", &gemm_packed<fp64_t>);
+    m.def("gemm_packed_bf16", &gemm_packed<bf16_t>);
+    m.def("gemm_packed_fp32", &gemm_packed<fp32_t>);
+    m.def("gemm_packed_fp32_fast_tf32", &gemm_packed<fp32_fast_tf32_t>);
+    m.def("gemm_packed_fp32_fast_fp16", &gemm_packed<fp32_fast_fp16_t>);
+    m.def("gemm_packed_fp32_fast_bf16", &gemm_packed<fp32_fast_bf16_t>);
+
+    m.def("beam_topk_async_fp64", &beam_topk_async<fp64_t>);
+    m.def("beam_topk_async_bf16", &beam_topk_async<bf16_t>);
+    m.def("beam_topk_async_fp32", &beam_topk_async<fp32_t>);
+    m.def("beam_topk_async_fp32_fast_tf32", &beam_topk_async<fp32_fast_tf32_t>);
+    m.def("beam_topk_async_fp32_fast_fp16", &beam_topk_async<fp32_fast_fp16_t>);
+    m.def("beam_topk_async_fp32_fast_bf16", &beam_topk_async<fp32_fast_bf16_t>);
+    m.def("beam_topk_fp64", &beam_topk<fp64_t>);
+    m.def("beam_topk_bf16", &beam_topk<bf16_t>);
+    m.def("beam_topk_fp32", &beam_topk<fp32_t>);
+    m.def("beam_topk_fp32_fast_tf32", &beam_topk<fp32_fast_tf32_t>);
+    m.def("beam_topk_fp32_fast_fp16", &beam_topk<fp32_fast_fp16_t>);
+    m.def("beam_topk_fp32_fast_bf16", &beam_topk<fp32_fast_bf16_t>);
+
+    m.def("index_select_async_fp64", &index_select_async<fp64_t>);
+    m.def("index_select_async_bf16", &index_select_async<bf16_t>);
+    m.def("index_select_async_fp32", &index_select_async<fp32_t>);
+    m.def("index_select_async_fp32_fast_tf32", &index_select_async<fp32_fast_tf32_t>);
+    m.def("index_select_async_fp32_fast_fp16", &index_select_async<fp32_fast_fp16_t>);
+    m.def("index_select_async_fp32_fast_bf16", &index_select_async<fp32_fast_bf16_t>);
+    m.def("index_select_async_int64", &index_select_async<nntile::int64_t>);
+    m.def("index_select_fp64", &index_select<fp64_t>);
+    m.def("index_select_bf16", &index_select<bf16_t>);
+    m.def("index_select_fp32", &index_select<fp32_t>);
+    m.def("index_select_fp32_fast_tf32", &index_select<fp32_fast_tf32_t>);
+    m.def("index_select_fp32_fast_fp16", &index_select<fp32_fast_fp16_t>);
+    m.def("index_select_fp32_fast_bf16", &index_select<fp32_fast_bf16_t>);
+    m.def("index_select_int64", &index_select<nntile::int64_t>);
 
     m.def("hypot_async_fp64", &hypot_async<fp64_t>);
     m.def("hypot_async_bf16", &hypot_async<bf16_t>);
@@ -1292,6 +1565,26 @@ void def_mod_tensor(py::module_ &m)
     m.def("rope_backward_fp32_fast_tf32", &rope_backward<fp32_fast_tf32_t>);
     m.def("rope_backward_bf16", &rope_backward<bf16_t>);
 
+    m.def("rope_qk_async_fp64", &rope_qk_async<fp64_t>);
+    m.def("rope_qk_async_fp32", &rope_qk_async<fp32_t>);
+    m.def("rope_qk_async_fp32_fast_tf32", &rope_qk_async<fp32_fast_tf32_t>);
+    m.def("rope_qk_async_bf16", &rope_qk_async<bf16_t>);
+    m.def("rope_qk_fp64", &rope_qk<fp64_t>);
+    m.def("rope_qk_fp32", &rope_qk<fp32_t>);
+    m.def("rope_qk_fp32_fast_tf32", &rope_qk<fp32_fast_tf32_t>);
+    m.def("rope_qk_bf16", &rope_qk<bf16_t>);
+
+    m.def("rope_qk_backward_async_fp64", &rope_qk_backward_async<fp64_t>);
+    m.def("rope_qk_backward_async_fp32", &rope_qk_backward_async<fp32_t>);
+    m.def("rope_qk_backward_async_fp32_fast_tf32",
+            &rope_qk_backward_async<fp32_fast_tf32_t>);
+    m.def("rope_qk_backward_async_bf16", &rope_qk_backward_async<bf16_t>);
+    m.def("rope_qk_backward_fp64", &rope_qk_backward<fp64_t>);
+    m.def("rope_qk_backward_fp32", &rope_qk_backward<fp32_t>);
+    m.def("rope_qk_backward_fp32_fast_tf32",
+            &rope_qk_backward<fp32_fast_tf32_t>);
+    m.def("rope_qk_backward_bf16", &rope_qk_backward<bf16_t>);
+
     m.def("log_scalar_async_fp64", &log_scalar_async<fp64_t>);
     m.def("log_scalar_async_fp32", &log_scalar_async<fp32_t>);
     m.def("log_scalar_async_fp32_fast_tf32", &log_scalar_async<fp32_fast_tf32_t>);
@@ -12,8 +12,9 @@
 
 class Config:
     def __init__(self, ncpus: int = ..., ncuda: int = ..., cublas: int = ...,
-                 logger_server_addr: str = ...,
-                 logger_server_port: int = ...) -> None: ...
+                 logger: int = ..., logger_server_addr: str = ...,
+                 logger_server_port: int = ..., verbose: int = ...,
+                 sched_policy: str = ...) -> None: ...
     def shutdown(self) -> None: ...
 
 def init() -> None: ...
@@ -28,3 +29,19 @@ def profiling_init() -> None: ...
 def restrict_cpu() -> None: ...
 def restrict_cuda() -> None: ...
 def restrict_restore() -> None: ...
+
+def set_task_priority(priority: int) -> None: ...
+def get_task_priority() -> int: ...
+def get_sched_policy() -> str: ...
+
+gemv_max_n: int
+
+class TaskGraph:
+    def __init__(self) -> None: ...
+    def begin_capture(self) -> None: ...
+    def end_capture(self) -> bool: ...
+    def replay(self) -> None: ...
+    def wait(self) -> None: ...
+    def clear(self) -> None: ...
+    def count(self, prefix: str) -> int: ...
+    def __len__(self) -> int: ...
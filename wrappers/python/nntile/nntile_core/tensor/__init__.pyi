@@ -34,8 +34,17 @@ class TensorTraits(TileTraits):
     def get_grid_shape(self) -> list[int]: ...
 
 class Tensor(Protocol):
+    @overload
     def __init__(self, traits: TensorTraits, distribution: Sequence[int],
                  last_tag: int): ...
+    @overload
+    def __init__(self, parent: Tensor, grid_shape: Sequence[int]): ...
+    @overload
+    def __init__(self, parent: Tensor, dim: int,
+                 tile_indices: Sequence[int]): ...
+    @overload
+    def __init__(self, parent: Tensor, shape: Sequence[int],
+                 basetile_shape: Sequence[int]): ...
 
     @property
     def distribution(self) -> list[int]: ...
@@ -65,6 +74,7 @@ class Tensor_fp32(Tensor, TensorTraits): ...
 class Tensor_fp32_fast_tf32(Tensor, TensorTraits): ...
 class Tensor_fp64(Tensor, TensorTraits): ...
 class Tensor_int64(Tensor, TensorTraits): ...
+class Tensor_int8(Tensor, TensorTraits): ...
 
 # NOTE Recommended linw width is 130 according to stubs style guide but we
 # stick to 80 everywhere except the rest of this file since it is much easier
@@ -187,9 +197,19 @@ def copy_fp64(src: Tensor_fp64, dst: Tensor_fp64) -> None: ...
 def copy_intersection_async_bool(src: Tensor_bool, src_offset: Sequence[int], dst: Tensor_bool, dst_offset: Sequence[int]) -> None: ...
 def copy_intersection_async_fp32(src: Tensor_fp32, src_offset: Sequence[int], dst: Tensor_fp32, dst_offset: Sequence[int]) -> None: ...
 def copy_intersection_async_fp64(src: Tensor_fp64, src_offset: Sequence[int], dst: Tensor_fp64, dst_offset: Sequence[int]) -> None: ...
+def copy_intersection_async_int8(src: Tensor_int8, src_offset: Sequence[int], dst: Tensor_int8, dst_offset: Sequence[int]) -> None: ...
 def copy_intersection_bool(src: Tensor_fp32, src_offset: Sequence[int], dst: Tensor_fp32, dst_offset: Sequence[int]) -> None: ...
 def copy_intersection_fp32(src: Tensor_fp32, src_offset: Sequence[int], dst: Tensor_fp32, dst_offset: Sequence[int]) -> None: ...
 def copy_intersection_fp64(src: Tensor_fp64, src_offset: Sequence[int], dst: Tensor_fp64, dst_offset: Sequence[int]) -> None: ...
+def copy_intersection_int8(src: Tensor_int8, src_offset: Sequence[int], dst: Tensor_int8, dst_offset: Sequence[int]) -> None: ...
+def set_index_async_bool(src: Tensor_bool, src_index: int, dst: Tensor_bool, dst_index: int, axis: int) -> None: ...
+def set_index_async_fp32(src: Tensor_fp32, src_index: int, dst: Tensor_fp32, dst_index: int, axis: int) -> None: ...
+def set_index_async_fp64(src: Tensor_fp64, src_index: int, dst: Tensor_fp64, dst_index: int, axis: int) -> None: ...
+def set_index_async_int64(src: Tensor_int64, src_index: int, dst: Tensor_int64, dst_index: int, axis: int) -> None: ...
+def set_index_bool(src: Tensor_bool, src_index: int, dst: Tensor_bool, dst_index: int, axis: int) -> None: ...
+def set_index_fp32(src: Tensor_fp32, src_index: int, dst: Tensor_fp32, dst_index: int, axis: int) -> None: ...
+def set_index_fp64(src: Tensor_fp64, src_index: int, dst: Tensor_fp64, dst_index: int, axis: int) -> None: ...
+def set_index_int64(src: Tensor_int64, src_index: int, dst: Tensor_int64, dst_index: int, axis: int) -> None: ...
 
 def dgelu_async_fp32(A: Tensor_fp32) -> None: ...
 def dgelu_async_fp64(A: Tensor_fp64) -> None: ...
@@ -233,32 +253,32 @@ def fill_fp32(val: float, A: Tensor_fp32) -> None: ...
 def fill_fp32_fast_tf32(val: float, A: Tensor_fp32_fast_tf32) -> None: ...
 def fill_fp64(val: float, A: Tensor_fp64) -> None: ...
 
-def flash_maxsumexp_async_bf16(Q: Tensor_bf16, K: Tensor_bf16, mask: Tensor_bool, maxsumexp: Tensor_bf16, tmp: Tensor_bf16, redux: int) -> None: ...
-def flash_maxsumexp_async_fp32(Q: Tensor_fp32, K: Tensor_fp32, mask: Tensor_bool, maxsumexp: Tensor_fp32, tmp: Tensor_fp32, redux: int) -> None: ...
-def flash_maxsumexp_async_fp32_fast_tf32(Q: Tensor_fp32_fast_tf32, K: Tensor_fp32_fast_tf32, mask: Tensor_bool, maxsumexp: Tensor_fp32_fast_tf32, tmp: Tensor_fp32_fast_tf32, redux: int) -> None: ...
-def flash_maxsumexp_async_fp64(Q: Tensor_fp64, K: Tensor_fp64, mask: Tensor_bool, maxsumexp: Tensor_fp64, tmp: Tensor_fp64, redux: int) -> None: ...
-def flash_maxsumexp_bf16(Q: Tensor_bf16, K: Tensor_bf16, mask: Tensor_bool, maxsumexp: Tensor_bf16, tmp: Tensor_bf16, redux: int) -> None: ...
-def flash_maxsumexp_fp32(Q: Tensor_fp32, K: Tensor_fp32, mask: Tensor_bool, maxsumexp: Tensor_fp32, tmp: Tensor_fp32, redux: int) -> None: ...
-def flash_maxsumexp_fp32_fast_tf32(Q: Tensor_fp32_fast_tf32, K: Tensor_fp32_fast_tf32, mask: Tensor_bool, maxsumexp: Tensor_fp32_fast_tf32, tmp: Tensor_fp32_fast_tf32, redux: int) -> None: ...
-def flash_maxsumexp_fp64(Q: Tensor_fp64, K: Tensor_fp64, mask: Tensor_bool, maxsumexp: Tensor_fp64, tmp: Tensor_fp64, redux: int) -> None: ...
-
-def flash_softmax_gemm_async_bf16(Q: Tensor_bf16, K: Tensor_bf16, V: Tensor_bf16, mask: Tensor_bool, maxsumexp: Tensor_bf16, dst: Tensor_bf16, tmp: Tensor_bf16, redux: int) -> None: ...
-def flash_softmax_gemm_async_fp32(Q: Tensor_fp32, K: Tensor_fp32, V: Tensor_fp32, mask: Tensor_bool, maxsumexp: Tensor_fp32, dst: Tensor_fp32, tmp: Tensor_fp32, redux: int) -> None: ...
-def flash_softmax_gemm_async_fp32_fast_tf32(Q: Tensor_fp32_fast_tf32, K: Tensor_fp32_fast_tf32, V: Tensor_fp32_fast_tf32, mask: Tensor_bool, maxsumexp: Tensor_fp32_fast_tf32, dst: Tensor_fp32_fast_tf32, tmp: Tensor_fp32_fast_tf32, redux: int) -> None: ...
-def flash_softmax_gemm_async_fp64(Q: Tensor_fp64, K: Tensor_fp64, V: Tensor_fp64, mask: Tensor_bool, maxsumexp: Tensor_fp64, dst: Tensor_fp64, tmp: Tensor_fp64, redux: int) -> None: ...
-def flash_softmax_gemm_bf16(Q: Tensor_bf16, K: Tensor_bf16, V: Tensor_bf16, mask: Tensor_bool, maxsumexp: Tensor_bf16, dst: Tensor_bf16, tmp: Tensor_bf16, redux: int) -> None: ...
-def flash_softmax_gemm_fp32(Q: Tensor_fp32, K: Tensor_fp32, V: Tensor_fp32, mask: Tensor_bool, maxsumexp: Tensor_fp32, dst: Tensor_fp32, tmp: Tensor_fp32, redux: int) -> None: ...
-def flash_softmax_gemm_fp32_fast_tf32(Q: Tensor_fp32_fast_tf32, K: Tensor_fp32_fast_tf32, V: Tensor_fp32_fast_tf32, mask: Tensor_bool, maxsumexp: Tensor_fp32_fast_tf32, dst: Tensor_fp32_fast_tf32, tmp: Tensor_fp32_fast_tf32, redux: int) -> None: ...
-def flash_softmax_gemm_fp64(Q: Tensor_fp64, K: Tensor_fp64, V: Tensor_fp64, mask: Tensor_bool, maxsumexp: Tensor_fp64, dst: Tensor_fp64, tmp: Tensor_fp64, redux: int) -> None: ...
-
-def flash_softmax_gemm_backward_async_bf16(Q: Tensor_bf16, dQ: Tensor_bf16, K: Tensor_bf16, dK: Tensor_bf16, V: Tensor_bf16, dV: Tensor_bf16, mask: Tensor_bool, maxsumexp: Tensor_bf16, dst_grad: Tensor_bf16, tmp: Tensor_bf16, tmp_grad: Tensor_bf16, tmp_sumprod_slice: Tensor_bf16, redux: int) -> None: ...
-def flash_softmax_gemm_backward_async_fp32(Q: Tensor_fp32, dQ: Tensor_fp32, K: Tensor_fp32, dK: Tensor_fp32, V: Tensor_fp32, dV: Tensor_fp32, mask: Tensor_bool, maxsumexp: Tensor_fp32, dst_grad: Tensor_fp32, tmp: Tensor_fp32, tmp_grad: Tensor_fp32, tmp_sumprod_slice: Tensor_fp32, redux: int) -> None: ...
-def flash_softmax_gemm_backward_async_fp32_fast_tf32(Q: Tensor_fp32_fast_tf32, dQ: Tensor_fp32_fast_tf32, K: Tensor_fp32_fast_tf32, dK: Tensor_fp32_fast_tf32, V: Tensor_fp32_fast_tf32, dV: Tensor_fp32_fast_tf32, mask: Tensor_bool, maxsumexp: Tensor_fp32_fast_tf32, dst_grad: Tensor_fp32_fast_tf32, tmp: Tensor_fp32_fast_tf32, tmp_grad: Tensor_fp32_fast_tf32, tmp_sumprod_slice: Tensor_fp32_fast_tf32, redux: int) -> None: ...
-def flash_softmax_gemm_backward_async_fp64(Q: Tensor_fp64, dQ: Tensor_fp64, K: Tensor_fp64, dK: Tensor_fp64, V: Tensor_fp64, dV: Tensor_fp64, mask: Tensor_bool, maxsumexp: Tensor_fp64, dst_grad: Tensor_fp64, tmp: Tensor_fp64, tmp_grad: Tensor_fp64, tmp_sumprod_slice: Tensor_fp64, redux: int) -> None: ...
-def flash_softmax_gemm_backward_bf16(Q: Tensor_bf16, dQ: Tensor_bf16, K: Tensor_bf16, dK: Tensor_bf16, V: Tensor_bf16, dV: Tensor_bf16, mask: Tensor_bool, maxsumexp: Tensor_bf16, dst_grad: Tensor_bf16, tmp: Tensor_bf16, tmp_grad: Tensor_bf16, tmp_sumprod_slice: Tensor_bf16, redux: int) -> None: ...
-def flash_softmax_gemm_backward_fp32(Q: Tensor_fp32, dQ: Tensor_fp32, K: Tensor_fp32, dK: Tensor_fp32, V: Tensor_fp32, dV: Tensor_fp32, mask: Tensor_bool, maxsumexp: Tensor_fp32, dst_grad: Tensor_fp32, tmp: Tensor_fp32, tmp_grad: Tensor_fp32, tmp_sumprod_slice: Tensor_fp32, redux: int) -> None: ...
-def flash_softmax_gemm_backward_fp32_fast_tf32(Q: Tensor_fp32_fast_tf32, dQ: Tensor_fp32_fast_tf32, K: Tensor_fp32_fast_tf32, dK: Tensor_fp32_fast_tf32, V: Tensor_fp32_fast_tf32, dV: Tensor_fp32_fast_tf32, mask: Tensor_bool, maxsumexp: Tensor_fp32_fast_tf32, dst_grad: Tensor_fp32_fast_tf32, tmp: Tensor_fp32_fast_tf32, tmp_grad: Tensor_fp32_fast_tf32, tmp_sumprod_slice: Tensor_fp32_fast_tf32, redux: int) -> None: ...
-def flash_softmax_gemm_backward_fp64(Q: Tensor_fp64, dQ: Tensor_fp64, K: Tensor_fp64, dK: Tensor_fp64, V: Tensor_fp64, dV: Tensor_fp64, mask: Tensor_bool, maxsumexp: Tensor_fp64, dst_grad: Tensor_fp64, tmp: Tensor_fp64, tmp_grad: Tensor_fp64, tmp_sumprod_slice: Tensor_fp64, redux: int) -> None: ...
+def flash_maxsumexp_async_bf16(Q: Tensor_bf16, K: Tensor_bf16, mask: Tensor_bool, maxsumexp: Tensor_bf16, tmp: Tensor_bf16, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_maxsumexp_async_fp32(Q: Tensor_fp32, K: Tensor_fp32, mask: Tensor_bool, maxsumexp: Tensor_fp32, tmp: Tensor_fp32, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_maxsumexp_async_fp32_fast_tf32(Q: Tensor_fp32_fast_tf32, K: Tensor_fp32_fast_tf32, mask: Tensor_bool, maxsumexp: Tensor_fp32_fast_tf32, tmp: Tensor_fp32_fast_tf32, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_maxsumexp_async_fp64(Q: Tensor_fp64, K: Tensor_fp64, mask: Tensor_bool, maxsumexp: Tensor_fp64, tmp: Tensor_fp64, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_maxsumexp_bf16(Q: Tensor_bf16, K: Tensor_bf16, mask: Tensor_bool, maxsumexp: Tensor_bf16, tmp: Tensor_bf16, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_maxsumexp_fp32(Q: Tensor_fp32, K: Tensor_fp32, mask: Tensor_bool, maxsumexp: Tensor_fp32, tmp: Tensor_fp32, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_maxsumexp_fp32_fast_tf32(Q: Tensor_fp32_fast_tf32, K: Tensor_fp32_fast_tf32, mask: Tensor_bool, maxsumexp: Tensor_fp32_fast_tf32, tmp: Tensor_fp32_fast_tf32, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_maxsumexp_fp64(Q: Tensor_fp64, K: Tensor_fp64, mask: Tensor_bool, maxsumexp: Tensor_fp64, tmp: Tensor_fp64, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+
+def flash_softmax_gemm_async_bf16(Q: Tensor_bf16, K: Tensor_bf16, V: Tensor_bf16, mask: Tensor_bool, maxsumexp: Tensor_bf16, dst: Tensor_bf16, tmp: Tensor_bf16, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_softmax_gemm_async_fp32(Q: Tensor_fp32, K: Tensor_fp32, V: Tensor_fp32, mask: Tensor_bool, maxsumexp: Tensor_fp32, dst: Tensor_fp32, tmp: Tensor_fp32, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_softmax_gemm_async_fp32_fast_tf32(Q: Tensor_fp32_fast_tf32, K: Tensor_fp32_fast_tf32, V: Tensor_fp32_fast_tf32, mask: Tensor_bool, maxsumexp: Tensor_fp32_fast_tf32, dst: Tensor_fp32_fast_tf32, tmp: Tensor_fp32_fast_tf32, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_softmax_gemm_async_fp64(Q: Tensor_fp64, K: Tensor_fp64, V: Tensor_fp64, mask: Tensor_bool, maxsumexp: Tensor_fp64, dst: Tensor_fp64, tmp: Tensor_fp64, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_softmax_gemm_bf16(Q: Tensor_bf16, K: Tensor_bf16, V: Tensor_bf16, mask: Tensor_bool, maxsumexp: Tensor_bf16, dst: Tensor_bf16, tmp: Tensor_bf16, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_softmax_gemm_fp32(Q: Tensor_fp32, K: Tensor_fp32, V: Tensor_fp32, mask: Tensor_bool, maxsumexp: Tensor_fp32, dst: Tensor_fp32, tmp: Tensor_fp32, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_softmax_gemm_fp32_fast_tf32(Q: Tensor_fp32_fast_tf32, K: Tensor_fp32_fast_tf32, V: Tensor_fp32_fast_tf32, mask: Tensor_bool, maxsumexp: Tensor_fp32_fast_tf32, dst: Tensor_fp32_fast_tf32, tmp: Tensor_fp32_fast_tf32, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_softmax_gemm_fp64(Q: Tensor_fp64, K: Tensor_fp64, V: Tensor_fp64, mask: Tensor_bool, maxsumexp: Tensor_fp64, dst: Tensor_fp64, tmp: Tensor_fp64, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+
+def flash_softmax_gemm_backward_async_bf16(Q: Tensor_bf16, dQ: Tensor_bf16, K: Tensor_bf16, dK: Tensor_bf16, V: Tensor_bf16, dV: Tensor_bf16, mask: Tensor_bool, maxsumexp: Tensor_bf16, dst_grad: Tensor_bf16, tmp: Tensor_bf16, tmp_grad: Tensor_bf16, tmp_sumprod_slice: Tensor_bf16, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_softmax_gemm_backward_async_fp32(Q: Tensor_fp32, dQ: Tensor_fp32, K: Tensor_fp32, dK: Tensor_fp32, V: Tensor_fp32, dV: Tensor_fp32, mask: Tensor_bool, maxsumexp: Tensor_fp32, dst_grad: Tensor_fp32, tmp: Tensor_fp32, tmp_grad: Tensor_fp32, tmp_sumprod_slice: Tensor_fp32, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_softmax_gemm_backward_async_fp32_fast_tf32(Q: Tensor_fp32_fast_tf32, dQ: Tensor_fp32_fast_tf32, K: Tensor_fp32_fast_tf32, dK: Tensor_fp32_fast_tf32, V: Tensor_fp32_fast_tf32, dV: Tensor_fp32_fast_tf32, mask: Tensor_bool, maxsumexp: Tensor_fp32_fast_tf32, dst_grad: Tensor_fp32_fast_tf32, tmp: Tensor_fp32_fast_tf32, tmp_grad: Tensor_fp32_fast_tf32, tmp_sumprod_slice: Tensor_fp32_fast_tf32, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_softmax_gemm_backward_async_fp64(Q: Tensor_fp64, dQ: Tensor_fp64, K: Tensor_fp64, dK: Tensor_fp64, V: Tensor_fp64, dV: Tensor_fp64, mask: Tensor_bool, maxsumexp: Tensor_fp64, dst_grad: Tensor_fp64, tmp: Tensor_fp64, tmp_grad: Tensor_fp64, tmp_sumprod_slice: Tensor_fp64, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_softmax_gemm_backward_bf16(Q: Tensor_bf16, dQ: Tensor_bf16, K: Tensor_bf16, dK: Tensor_bf16, V: Tensor_bf16, dV: Tensor_bf16, mask: Tensor_bool, maxsumexp: Tensor_bf16, dst_grad: Tensor_bf16, tmp: Tensor_bf16, tmp_grad: Tensor_bf16, tmp_sumprod_slice: Tensor_bf16, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_softmax_gemm_backward_fp32(Q: Tensor_fp32, dQ: Tensor_fp32, K: Tensor_fp32, dK: Tensor_fp32, V: Tensor_fp32, dV: Tensor_fp32, mask: Tensor_bool, maxsumexp: Tensor_fp32, dst_grad: Tensor_fp32, tmp: Tensor_fp32, tmp_grad: Tensor_fp32, tmp_sumprod_slice: Tensor_fp32, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_softmax_gemm_backward_fp32_fast_tf32(Q: Tensor_fp32_fast_tf32, dQ: Tensor_fp32_fast_tf32, K: Tensor_fp32_fast_tf32, dK: Tensor_fp32_fast_tf32, V: Tensor_fp32_fast_tf32, dV: Tensor_fp32_fast_tf32, mask: Tensor_bool, maxsumexp: Tensor_fp32_fast_tf32, dst_grad: Tensor_fp32_fast_tf32, tmp: Tensor_fp32_fast_tf32, tmp_grad: Tensor_fp32_fast_tf32, tmp_sumprod_slice: Tensor_fp32_fast_tf32, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def flash_softmax_gemm_backward_fp64(Q: Tensor_fp64, dQ: Tensor_fp64, K: Tensor_fp64, dK: Tensor_fp64, V: Tensor_fp64, dV: Tensor_fp64, mask: Tensor_bool, maxsumexp: Tensor_fp64, dst_grad: Tensor_fp64, tmp: Tensor_fp64, tmp_grad: Tensor_fp64, tmp_sumprod_slice: Tensor_fp64, redux: int, mask_tile_status: Sequence[int] = ...) -> None: ...
 
 def gather_async_bf16(src: Tensor_bf16, dst: Tensor_bf16) -> None: ...
 def gather_async_fp32(src: Tensor_fp32, dst: Tensor_fp32) -> None: ...
@@ -308,6 +328,14 @@ def gemm_bf16(alpha: float, transA: TransOp, A: Tensor_bf16, transB: TransOp, B:
 def gemm_fp32(alpha: float, transA: TransOp, A: Tensor_fp32, transB: TransOp, B: Tensor_fp32, beta: float, C: Tensor_fp32, ndim: int, batch_ndim: int, redux: int) -> None: ...
 def gemm_fp32_fast_tf32(alpha: float, transA: TransOp, A: Tensor_fp32_fast_tf32, transB: TransOp, B: Tensor_fp32_fast_tf32, beta: float, C: Tensor_fp32_fast_tf32, ndim: int, batch_ndim: int, redux: int) -> None: ...
 def gemm_fp64(alpha: float, transA: TransOp, A: Tensor_fp64, transB: TransOp, B: Tensor_fp64, beta: float, C: Tensor_fp64, ndim: int, batch_ndim: int, redux: int) -> None: ...
+def gemm_gqa_async_bf16(alpha: float, transA: TransOp, A: Tensor_bf16, transB: TransOp, B: Tensor_bf16, beta: float, C: Tensor_bf16, ndim: int, batch_ndim: int, group_dim: int, bcast: int, redux: int) -> None: ...
+def gemm_gqa_async_fp32(alpha: float, transA: TransOp, A: Tensor_fp32, transB: TransOp, B: Tensor_fp32, beta: float, C: Tensor_fp32, ndim: int, batch_ndim: int, group_dim: int, bcast: int, redux: int) -> None: ...
+def gemm_gqa_async_fp32_fast_tf32(alpha: float, transA: TransOp, A: Tensor_fp32_fast_tf32, transB: TransOp, B: Tensor_fp32_fast_tf32, beta: float, C: Tensor_fp32_fast_tf32, ndim: int, batch_ndim: int, group_dim: int, bcast: int, redux: int) -> None: ...
+def gemm_gqa_async_fp64(alpha: float, transA: TransOp, A: Tensor_fp64, transB: TransOp, B: Tensor_fp64, beta: float, C: Tensor_fp64, ndim: int, batch_ndim: int, group_dim: int, bcast: int, redux: int) -> None: ...
+def gemm_gqa_bf16(alpha: float, transA: TransOp, A: Tensor_bf16, transB: TransOp, B: Tensor_bf16, beta: float, C: Tensor_bf16, ndim: int, batch_ndim: int, group_dim: int, bcast: int, redux: int) -> None: ...
+def gemm_gqa_fp32(alpha: float, transA: TransOp, A: Tensor_fp32, transB: TransOp, B: Tensor_fp32, beta: float, C: Tensor_fp32, ndim: int, batch_ndim: int, group_dim: int, bcast: int, redux: int) -> None: ...
+def gemm_gqa_fp32_fast_tf32(alpha: float, transA: TransOp, A: Tensor_fp32_fast_tf32, transB: TransOp, B: Tensor_fp32_fast_tf32, beta: float, C: Tensor_fp32_fast_tf32, ndim: int, batch_ndim: int, group_dim: int, bcast: int, redux: int) -> None: ...
+def gemm_gqa_fp64(alpha: float, transA: TransOp, A: Tensor_fp64, transB: TransOp, B: Tensor_fp64, beta: float, C: Tensor_fp64, ndim: int, batch_ndim: int, group_dim: int, bcast: int, redux: int) -> None: ...
 
 def hypot_async_bf16(alpha: float, src: Tensor_bf16, beta: float, dst: Tensor_bf16) -> None: ...
 def hypot_async_fp32(alpha: float, src: Tensor_fp32, beta: float, dst: Tensor_fp32) -> None: ...
@@ -335,14 +363,95 @@ def logsumexp_fp32(src: Tensor_fp32, dst: Tensor_fp32) -> None: ...
 def logsumexp_fp32_fast_tf32(src: Tensor_fp32_fast_tf32, dst: Tensor_fp32_fast_tf32) -> None: ...
 def logsumexp_fp64(src: Tensor_fp64, dst: Tensor_fp64) -> None: ...
 
-def mask_scalar_async_bf16(mask: Tensor_bool, val: float, A: Tensor_bf16, batch_ndim: int) -> None: ...
-def mask_scalar_async_fp32(mask: Tensor_bool, val: float, A: Tensor_fp32, batch_ndim: int) -> None: ...
-def mask_scalar_async_fp32_fast_tf32(mask: Tensor_bool, val: float, A: Tensor_fp32_fast_tf32, batch_ndim: int) -> None: ...
-def mask_scalar_async_fp64(mask: Tensor_bool, val: float, A: Tensor_fp64, batch_ndim: int) -> None: ...
-def mask_scalar_bf16(mask: Tensor_bool, val: float, A: Tensor_bf16, batch_ndim: int) -> None: ...
-def mask_scalar_fp32(mask: Tensor_bool, val: float, A: Tensor_fp32, batch_ndim: int) -> None: ...
-def mask_scalar_fp32_fast_tf32(mask: Tensor_bool, val: float, A: Tensor_fp32_fast_tf32, batch_ndim: int) -> None: ...
-def mask_scalar_fp64(mask: Tensor_bool, val: float, A: Tensor_fp64, batch_ndim: int) -> None: ...
+def mask_scalar_async_bf16(mask: Tensor_bool, val: float, A: Tensor_bf16, batch_ndim: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def mask_scalar_async_fp32(mask: Tensor_bool, val: float, A: Tensor_fp32, batch_ndim: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def mask_scalar_async_fp32_fast_tf32(mask: Tensor_bool, val: float, A: Tensor_fp32_fast_tf32, batch_ndim: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def mask_scalar_async_fp64(mask: Tensor_bool, val: float, A: Tensor_fp64, batch_ndim: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def mask_scalar_bf16(mask: Tensor_bool, val: float, A: Tensor_bf16, batch_ndim: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def mask_scalar_fp32(mask: Tensor_bool, val: float, A: Tensor_fp32, batch_ndim: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def mask_scalar_fp32_fast_tf32(mask: Tensor_bool, val: float, A: Tensor_fp32_fast_tf32, batch_ndim: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def mask_scalar_fp64(mask: Tensor_bool, val: float, A: Tensor_fp64, batch_ndim: int, mask_tile_status: Sequence[int] = ...) -> None: ...
+def mask_scalar_causal_async_bf16(offset: int, window: int, kv_len: int, val: float, A: Tensor_bf16, batch_ndim: int) -> None: ...
+def mask_scalar_causal_async_fp32(offset: int, window: int, kv_len: int, val: float, A: Tensor_fp32, batch_ndim: int) -> None: ...
+def mask_scalar_causal_async_fp32_fast_tf32(offset: int, window: int, kv_len: int, val: float, A: Tensor_fp32_fast_tf32, batch_ndim: int) -> None: ...
+def mask_scalar_causal_async_fp64(offset: int, window: int, kv_len: int, val: float, A: Tensor_fp64, batch_ndim: int) -> None: ...
+def mask_scalar_causal_bf16(offset: int, window: int, kv_len: int, val: float, A: Tensor_bf16, batch_ndim: int) -> None: ...
+def mask_scalar_causal_fp32(offset: int, window: int, kv_len: int, val: float, A: Tensor_fp32, batch_ndim: int) -> None: ...
+def mask_scalar_causal_fp32_fast_tf32(offset: int, window: int, kv_len: int, val: float, A: Tensor_fp32_fast_tf32, batch_ndim: int) -> None: ...
+def mask_scalar_causal_fp64(offset: int, window: int, kv_len: int, val: float, A: Tensor_fp64, batch_ndim: int) -> None: ...
+def mask_varlen(cu_seqlens_k: Sequence[int], cu_seqlens_q: Sequence[int], mask: Tensor_bool) -> None: ...
+def mask_varlen_async(cu_seqlens_k: Sequence[int], cu_seqlens_q: Sequence[int], mask: Tensor_bool) -> None: ...
+def mask_varlen_tile_status(cu_seqlens_k: Sequence[int], cu_seqlens_q: Sequence[int], mask: TensorTraits) -> list[int]: ...
+def topk_async_bf16(src: Tensor_bf16, dst_val: Tensor_bf16, dst_idx: Tensor_int64) -> None: ...
+def topk_async_fp32(src: Tensor_fp32, dst_val: Tensor_fp32, dst_idx: Tensor_int64) -> None: ...
+def topk_async_fp32_fast_tf32(src: Tensor_fp32_fast_tf32, dst_val: Tensor_fp32_fast_tf32, dst_idx: Tensor_int64) -> None: ...
+def topk_async_fp64(src: Tensor_fp64, dst_val: Tensor_fp64, dst_idx: Tensor_int64) -> None: ...
+def topk_bf16(src: Tensor_bf16, dst_val: Tensor_bf16, dst_idx: Tensor_int64) -> None: ...
+def topk_fp32(src: Tensor_fp32, dst_val: Tensor_fp32, dst_idx: Tensor_int64) -> None: ...
+def topk_fp32_fast_tf32(src: Tensor_fp32_fast_tf32, dst_val: Tensor_fp32_fast_tf32, dst_idx: Tensor_int64) -> None: ...
+def topk_fp64(src: Tensor_fp64, dst_val: Tensor_fp64, dst_idx: Tensor_int64) -> None: ...
+def sample_topk_async_bf16(temperature: float, top_p: float, seed: int, val: Tensor_bf16, idx: Tensor_int64, dst: Tensor_int64) -> None: ...
+def sample_topk_async_fp32(temperature: float, top_p: float, seed: int, val: Tensor_fp32, idx: Tensor_int64, dst: Tensor_int64) -> None: ...
+def sample_topk_async_fp32_fast_tf32(temperature: float, top_p: float, seed: int, val: Tensor_fp32_fast_tf32, idx: Tensor_int64, dst: Tensor_int64) -> None: ...
+def sample_topk_async_fp64(temperature: float, top_p: float, seed: int, val: Tensor_fp64, idx: Tensor_int64, dst: Tensor_int64) -> None: ...
+def sample_topk_bf16(temperature: float, top_p: float, seed: int, val: Tensor_bf16, idx: Tensor_int64, dst: Tensor_int64) -> None: ...
+def sample_topk_fp32(temperature: float, top_p: float, seed: int, val: Tensor_fp32, idx: Tensor_int64, dst: Tensor_int64) -> None: ...
+def sample_topk_fp32_fast_tf32(temperature: float, top_p: float, seed: int, val: Tensor_fp32_fast_tf32, idx: Tensor_int64, dst: Tensor_int64) -> None: ...
+def sample_topk_fp64(temperature: float, top_p: float, seed: int, val: Tensor_fp64, idx: Tensor_int64, dst: Tensor_int64) -> None: ...
+
+def quantize_async_bf16(src: Tensor_bf16, dst: Tensor_int8, scale: Tensor_bf16) -> None: ...
+def quantize_async_fp32(src: Tensor_fp32, dst: Tensor_int8, scale: Tensor_fp32) -> None: ...
+def quantize_async_fp32_fast_tf32(src: Tensor_fp32_fast_tf32, dst: Tensor_int8, scale: Tensor_fp32_fast_tf32) -> None: ...
+def quantize_async_fp64(src: Tensor_fp64, dst: Tensor_int8, scale: Tensor_fp64) -> None: ...
+def quantize_bf16(src: Tensor_bf16, dst: Tensor_int8, scale: Tensor_bf16) -> None: ...
+def quantize_fp32(src: Tensor_fp32, dst: Tensor_int8, scale: Tensor_fp32) -> None: ...
+def quantize_fp32_fast_tf32(src: Tensor_fp32_fast_tf32, dst: Tensor_int8, scale: Tensor_fp32_fast_tf32) -> None: ...
+def quantize_fp64(src: Tensor_fp64, dst: Tensor_int8, scale: Tensor_fp64) -> None: ...
+
+def dequantize_async_bf16(src: Tensor_int8, scale: Tensor_bf16, dst: Tensor_bf16) -> None: ...
+def dequantize_async_fp32(src: Tensor_int8, scale: Tensor_fp32, dst: Tensor_fp32) -> None: ...
+def dequantize_async_fp32_fast_tf32(src: Tensor_int8, scale: Tensor_fp32_fast_tf32, dst: Tensor_fp32_fast_tf32) -> None: ...
+def dequantize_async_fp64(src: Tensor_int8, scale: Tensor_fp64, dst: Tensor_fp64) -> None: ...
+def dequantize_bf16(src: Tensor_int8, scale: Tensor_bf16, dst: Tensor_bf16) -> None: ...
+def dequantize_fp32(src: Tensor_int8, scale: Tensor_fp32, dst: Tensor_fp32) -> None: ...
+def dequantize_fp32_fast_tf32(src: Tensor_int8, scale: Tensor_fp32_fast_tf32, dst: Tensor_fp32_fast_tf32) -> None: ...
+def dequantize_fp64(src: Tensor_int8, scale: Tensor_fp64, dst: Tensor_fp64) -> None: ...
+def pack_panels_async_bf16(src: Tensor_bf16, dst: Tensor_bf16, ndim: int) -> None: ...
+def pack_panels_async_fp32(src: Tensor_fp32, dst: Tensor_fp32, ndim: int) -> None: ...
+def pack_panels_async_fp32_fast_tf32(src: Tensor_fp32_fast_tf32, dst: Tensor_fp32_fast_tf32, ndim: int) -> None: ...
+def pack_panels_async_fp64(src: Tensor_fp64, dst: Tensor_fp64, ndim: int) -> None: ...
+def pack_panels_bf16(src: Tensor_bf16, dst: Tensor_bf16, ndim: int) -> None: ...
+def pack_panels_fp32(src: Tensor_fp32, dst: Tensor_fp32, ndim: int) -> None: ...
+def pack_panels_fp32_fast_tf32(src: Tensor_fp32_fast_tf32, dst: Tensor_fp32_fast_tf32, ndim: int) -> None: ...
+def pack_panels_fp64(src: Tensor_fp64, dst: Tensor_fp64, ndim: int) -> None: ...
+def gemm_packed_async_bf16(alpha: float, A: Tensor_bf16, transB: TransOp, B: Tensor_bf16, beta: float, C: Tensor_bf16, ndim: int, redux: int) -> None: ...
+def gemm_packed_async_fp32(alpha: float, A: Tensor_fp32, transB: TransOp, B: Tensor_fp32, beta: float, C: Tensor_fp32, ndim: int, redux: int) -> None: ...
+def gemm_packed_async_fp32_fast_tf32(alpha: float, A: Tensor_fp32_fast_tf32, transB: TransOp, B: Tensor_fp32_fast_tf32, beta: float, C: Tensor_fp32_fast_tf32, ndim: int, redux: int) -> None: ...
+def gemm_packed_async_fp64(alpha: float, A: Tensor_fp64, transB: TransOp, B: Tensor_fp64, beta: float, C: Tensor_fp64, ndim: int, redux: int) -> None: ...
+def gemm_packed_bf16(alpha: float, A: Tensor_bf16, transB: TransOp, B: Tensor_bf16, beta: float, C: Tensor_bf16, ndim: int, redux: int) -> None: ...
+def gemm_packed_fp32(alpha: float, A: Tensor_fp32, transB: TransOp, B: Tensor_fp32, beta: float, C: Tensor_fp32, ndim: int, redux: int) -> None: ...
+def gemm_packed_fp32_fast_tf32(alpha: float, A: Tensor_fp32_fast_tf32, transB: TransOp, B: Tensor_fp32_fast_tf32, beta: float, C: Tensor_fp32_fast_tf32, ndim: int, redux: int) -> None: ...
+def gemm_packed_fp64(alpha: float, A: Tensor_fp64, transB: TransOp, B: Tensor_fp64, beta: float, C: Tensor_fp64, ndim: int, redux: int) -> None: ...
+
+def beam_topk_async_bf16(src: Tensor_bf16, dst_val: Tensor_bf16, dst_idx: Tensor_int64, dst_beam: Tensor_int64) -> None: ...
+def beam_topk_async_fp32(src: Tensor_fp32, dst_val: Tensor_fp32, dst_idx: Tensor_int64, dst_beam: Tensor_int64) -> None: ...
+def beam_topk_async_fp32_fast_tf32(src: Tensor_fp32_fast_tf32, dst_val: Tensor_fp32_fast_tf32, dst_idx: Tensor_int64, dst_beam: Tensor_int64) -> None: ...
+def beam_topk_async_fp64(src: Tensor_fp64, dst_val: Tensor_fp64, dst_idx: Tensor_int64, dst_beam: Tensor_int64) -> None: ...
+def beam_topk_bf16(src: Tensor_bf16, dst_val: Tensor_bf16, dst_idx: Tensor_int64, dst_beam: Tensor_int64) -> None: ...
+def beam_topk_fp32(src: Tensor_fp32, dst_val: Tensor_fp32, dst_idx: Tensor_int64, dst_beam: Tensor_int64) -> None: ...
+def beam_topk_fp32_fast_tf32(src: Tensor_fp32_fast_tf32, dst_val: Tensor_fp32_fast_tf32, dst_idx: Tensor_int64, dst_beam: Tensor_int64) -> None: ...
+def beam_topk_fp64(src: Tensor_fp64, dst_val: Tensor_fp64, dst_idx: Tensor_int64, dst_beam: Tensor_int64) -> None: ...
+
+def index_select_async_bf16(index: Tensor_int64, src: Tensor_bf16, dst: Tensor_bf16, axis: int) -> None: ...
+def index_select_async_fp32(index: Tensor_int64, src: Tensor_fp32, dst: Tensor_fp32, axis: int) -> None: ...
+def index_select_async_fp32_fast_tf32(index: Tensor_int64, src: Tensor_fp32_fast_tf32, dst: Tensor_fp32_fast_tf32, axis: int) -> None: ...
+def index_select_async_fp64(index: Tensor_int64, src: Tensor_fp64, dst: Tensor_fp64, axis: int) -> None: ...
+def index_select_async_int64(index: Tensor_int64, src: Tensor_int64, dst: Tensor_int64, axis: int) -> None: ...
+def index_select_bf16(index: Tensor_int64, src: Tensor_bf16, dst: Tensor_bf16, axis: int) -> None: ...
+def index_select_fp32(index: Tensor_int64, src: Tensor_fp32, dst: Tensor_fp32, axis: int) -> None: ...
+def index_select_fp32_fast_tf32(index: Tensor_int64, src: Tensor_fp32_fast_tf32, dst: Tensor_fp32_fast_tf32, axis: int) -> None: ...
+def index_select_fp64(index: Tensor_int64, src: Tensor_fp64, dst: Tensor_fp64, axis: int) -> None: ...
+def index_select_int64(index: Tensor_int64, src: Tensor_int64, dst: Tensor_int64, axis: int) -> None: ...
 
 def maximum_async_fp32(src: Tensor_fp32, dst: Tensor_fp32) -> None: ...
 def maximum_async_fp64(src: Tensor_fp64, dst: Tensor_fp64) -> None: ...
@@ -457,6 +566,23 @@ def rope_fp32(sin: Tensor_fp32, cos: Tensor_fp32, src: Tensor_fp32, dst: Tensor_
 def rope_fp32_fast_tf32(sin: Tensor_fp32_fast_tf32, cos: Tensor_fp32_fast_tf32, src: Tensor_fp32_fast_tf32, dst: Tensor_fp32_fast_tf32) -> None: ...
 def rope_fp64(sin: Tensor_fp64, cos: Tensor_fp64, src: Tensor_fp64, dst: Tensor_fp64) -> None: ...
 
+def rope_qk_async_bf16(offset: int, sin: Tensor_bf16, cos: Tensor_bf16, q: Tensor_bf16, k: Tensor_bf16) -> None: ...
+def rope_qk_async_fp32(offset: int, sin: Tensor_fp32, cos: Tensor_fp32, q: Tensor_fp32, k: Tensor_fp32) -> None: ...
+def rope_qk_async_fp32_fast_tf32(offset: int, sin: Tensor_fp32_fast_tf32, cos: Tensor_fp32_fast_tf32, q: Tensor_fp32_fast_tf32, k: Tensor_fp32_fast_tf32) -> None: ...
+def rope_qk_async_fp64(offset: int, sin: Tensor_fp64, cos: Tensor_fp64, q: Tensor_fp64, k: Tensor_fp64) -> None: ...
+def rope_qk_backward_async_bf16(offset: int, sin: Tensor_bf16, cos: Tensor_bf16, dq: Tensor_bf16, dk: Tensor_bf16) -> None: ...
+def rope_qk_backward_async_fp32(offset: int, sin: Tensor_fp32, cos: Tensor_fp32, dq: Tensor_fp32, dk: Tensor_fp32) -> None: ...
+def rope_qk_backward_async_fp32_fast_tf32(offset: int, sin: Tensor_fp32_fast_tf32, cos: Tensor_fp32_fast_tf32, dq: Tensor_fp32_fast_tf32, dk: Tensor_fp32_fast_tf32) -> None: ...
+def rope_qk_backward_async_fp64(offset: int, sin: Tensor_fp64, cos: Tensor_fp64, dq: Tensor_fp64, dk: Tensor_fp64) -> None: ...
+def rope_qk_backward_bf16(offset: int, sin: Tensor_bf16, cos: Tensor_bf16, dq: Tensor_bf16, dk: Tensor_bf16) -> None: ...
+def rope_qk_backward_fp32(offset: int, sin: Tensor_fp32, cos: Tensor_fp32, dq: Tensor_fp32, dk: Tensor_fp32) -> None: ...
+def rope_qk_backward_fp32_fast_tf32(offset: int, sin: Tensor_fp32_fast_tf32, cos: Tensor_fp32_fast_tf32, dq: Tensor_fp32_fast_tf32, dk: Tensor_fp32_fast_tf32) -> None: ...
+def rope_qk_backward_fp64(offset: int, sin: Tensor_fp64, cos: Tensor_fp64, dq: Tensor_fp64, dk: Tensor_fp64) -> None: ...
+def rope_qk_bf16(offset: int, sin: Tensor_bf16, cos: Tensor_bf16, q: Tensor_bf16, k: Tensor_bf16) -> None: ...
+def rope_qk_fp32(offset: int, sin: Tensor_fp32, cos: Tensor_fp32, q: Tensor_fp32, k: Tensor_fp32) -> None: ...
+def rope_qk_fp32_fast_tf32(offset: int, sin: Tensor_fp32_fast_tf32, cos: Tensor_fp32_fast_tf32, q: Tensor_fp32_fast_tf32, k: Tensor_fp32_fast_tf32) -> None: ...
+def rope_qk_fp64(offset: int, sin: Tensor_fp64, cos: Tensor_fp64, q: Tensor_fp64, k: Tensor_fp64) -> None: ...
+
 def scal_async_bf16(alpha: float, src: Tensor_bf16, dst: Tensor_bf16) -> None: ...
 def scal_async_fp32(alpha: float, src: Tensor_fp32, dst: Tensor_fp32) -> None: ...
 def scal_async_fp32_fast_tf32(alpha: float, src: Tensor_fp32_fast_tf32, dst: Tensor_fp32_fast_tf32) -> None: ...
@@ -11,9 +11,11 @@
 #
 # @version 1.1.0
 
+import warnings
 from typing import Any, List
 
 from nntile.model.base_model import BaseModel
+from nntile.nntile_core.starpu import TaskGraph
 from nntile.tensor import Tensor, clear_async, copy_async, log_scalar_async
 
 
@@ -27,7 +29,7 @@ class Pipeline(object):
     lr: float
 
     def __init__(self, x: List[List[Tensor]], y: List[List[Tensor]],
-            model: BaseModel, opt, loss, n_epochs):
+            model: BaseModel, opt, loss, n_epochs, capture_graph=False):
         self.x = x
         self.y = y
         self.model = model
@@ -35,6 +37,23 @@ class Pipeline(object):
         self.loss = loss
         self.n_epochs = n_epochs
         self.loss_hist = []
+        # Tasks of a minibatch are the same for all minibatches, so they are
+        # captured into a graph once and then replayed without parsing
+        # arguments of every task
+        self.task_graph = TaskGraph() if capture_graph else None
+
+    def minibatch_async(self):
+        """Submit tasks of a minibatch, that was copied into the model"""
+        # Clear gradients of inter-layer activations
+        self.model.clear_activations_grads()
+        # Perform forward pass
+        self.model.forward_async()
+        # Loss function shall be instatiated to read X from
+        # activations[-1].value of the model and write gradient into
+        # activations[-1].grad
+        self.loss.calc_async()
+        # Now do the backward pass
+        self.model.backward_async()
 
     def train_async(self, log_loss=True):
         for i_epoch in range(self.n_epochs):
@@ -46,20 +65,27 @@ class Pipeline(object):
                 clear_async(self.loss.val)
                 # Accumulate gradients from subbatches
                 for x_minibatch, y_minibatch in zip(x_batch, y_batch):
-                    # Clear gradients of inter-layer activations
-                    self.model.clear_activations_grads()
                     # Copy input batch into activation[0] of the model
                     copy_async(x_minibatch, self.model.activations[0].value)
-                    # Perform forward pass
-                    self.model.forward_async()
                     # Copy true result into loss function
                     copy_async(y_minibatch, self.loss.y)
-                    # Loss function shall be instatiated to read X from
-                    # activations[-1].value of the model and write gradient
-                    # into activations[-1].grad
-                    self.loss.calc_async()
-                    # Now do the backward pass
-                    self.model.backward_async()
+                    # Tasks on the data of a minibatch are submitted as is or
+                    # replayed from the graph, captured at the first one
+                    if self.task_graph is None:
+                        self.minibatch_async()
+                    elif len(self.task_graph) == 0:
+                        self.task_graph.begin_capture()
+                        try:
+                            self.minibatch_async()
+                        finally:
+                            captured = self.task_graph.end_capture()
+                        if not captured:
+                            warnings.warn("Tasks of a minibatch access "
+                                    "temporary data and cannot be replayed, "
+                                    "they are submitted as usual")
+                            self.task_graph = None
+                    else:
+                        self.task_graph.replay()
                     # Invalidate activations[2:]. We have to keep
                     # activations[1] as it holds positional embedding indices,
                     # that are computed once
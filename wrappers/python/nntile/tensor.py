@@ -18,7 +18,7 @@ from .functions import *
 from .nntile_core import TransOp, notrans, trans
 from .nntile_core.tensor import (
     Tensor_bf16, Tensor_bool, Tensor_fp32, Tensor_fp32_fast_bf16,
-    Tensor_fp32_fast_fp16, Tensor_fp32_fast_tf32, Tensor_fp64, Tensor_int64,
-    TensorTraits)
+    Tensor_fp32_fast_fp16, Tensor_fp32_fast_tf32, Tensor_fp64, Tensor_int8,
+    Tensor_int64, TensorTraits)
 from .types import *
 from .utils.constructors import *
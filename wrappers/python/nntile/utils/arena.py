@@ -0,0 +1,166 @@
+# @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+#                              (Skoltech), Russia. All rights reserved.
+#                2023-present Artificial Intelligence Research Institute
+#                              (AIRI), Russia. All rights reserved.
+#
+# NNTile is software framework for fast training of big neural networks on
+# distributed-memory heterogeneous systems based on StarPU runtime system.
+#
+# @file wrappers/python/nntile/utils/arena.py
+# Arena of temporary tensors, that are reused by steps of dynamic forward
+#
+# @version 1.1.0
+
+from contextlib import contextmanager
+from typing import Sequence
+
+from nntile.nntile_core.tensor import Tensor_fp32, TensorTraits
+from nntile.types import Tensor
+
+# Stack of arenas of the active steps, the innermost one is used
+_active_arenas = []
+
+
+class TensorArena:
+    """
+    Pool of temporary tensors of forward_dynamic, keyed by type, shape and
+    base tile shape
+
+    Temporaries of a step, requested by scratch() within `with arena.step()`,
+    are taken from the pool and returned to it at the end of the step, so
+    that repeated steps (e.g., decoding of tokens) register no new StarPU
+    handles. Tensors of a step are valid only until the end of the step,
+    so its results shall be read or copied within the step. Shapes, that
+    were not requested by a step, are dropped at its end.
+    """
+
+    def __init__(self):
+        self._free = {}
+        self._used = []
+        # Number of tensors registered by the arena
+        self.num_allocs = 0
+        # Number of requests served by tensors of the pool
+        self.num_reuses = 0
+        # Number of tensors registered by the last (or current) step
+        self.step_allocs = 0
+
+    def get(
+        self,
+        shape: Sequence[int],
+        basetile_shape: Sequence[int],
+        dtype: Tensor,
+    ) -> Tensor:
+        key = (dtype, tuple(shape), tuple(basetile_shape))
+        free = self._free.get(key)
+        if free:
+            tensor = free.pop()
+            self.num_reuses += 1
+        else:
+            traits = TensorTraits(list(shape), list(basetile_shape))
+            tensor = dtype(traits, [0] * traits.grid.nelems, 0)
+            self.num_allocs += 1
+            self.step_allocs += 1
+        self._used.append((key, tensor))
+        # Caller gets a view of all the tiles, so that unregistering it (e.g.,
+        # by TensorMoments) keeps the tensor of the pool alive
+        return dtype(tensor, tensor.grid.shape)
+
+    def release(self):
+        """Return all tensors of the step to the pool"""
+        used_keys = set()
+        for key, tensor in self._used:
+            tensor.invalidate_submit()
+            self._free.setdefault(key, []).append(tensor)
+            used_keys.add(key)
+        self._used = []
+        for key in list(self._free):
+            if key not in used_keys:
+                for tensor in self._free.pop(key):
+                    tensor.unregister()
+
+    @contextmanager
+    def step(self):
+        self.step_allocs = 0
+        _active_arenas.append(self)
+        try:
+            yield self
+        finally:
+            _active_arenas.pop()
+            self.release()
+
+    def unregister(self):
+        for _, tensor in self._used:
+            tensor.unregister()
+        self._used = []
+        for tensors in self._free.values():
+            for tensor in tensors:
+                tensor.unregister()
+        self._free = {}
+
+
+class BucketedArenas:
+    """
+    Tensor arenas of forward passes over power-of-two numbers of tokens
+
+    A sequence is split into chunks of power-of-two sizes in decreasing
+    order, e.g., 13 tokens into 8, 4 and 1, so that forward passes take only
+    a few distinct shapes without padding. Every bucket size keeps its own
+    arena, that is why activations and temporaries of a bucket survive
+    passes over other buckets and are reused by later calls.
+    """
+
+    def __init__(self, max_bucket_size: int | None = None):
+        # Largest bucket is the largest power of two within the limit
+        self.max_bucket_size = None
+        if max_bucket_size is not None:
+            self.max_bucket_size = 1 << (max_bucket_size.bit_length() - 1)
+        self.arenas = {}
+
+    def split(
+        self, num_tokens: int, max_size: int | None = None
+    ) -> list[int]:
+        """Bucket sizes of chunks of num_tokens tokens, at most max_size"""
+        max_bucket_size = self.max_bucket_size
+        if max_size is not None:
+            max_bucket_size = min(
+                max_bucket_size or max_size,
+                1 << (max_size.bit_length() - 1),
+            )
+        sizes = []
+        while num_tokens > 0:
+            size = 1 << (num_tokens.bit_length() - 1)
+            if max_bucket_size is not None:
+                size = min(size, max_bucket_size)
+            sizes.append(size)
+            num_tokens -= size
+        return sizes
+
+    def step(self, num_tokens: int):
+        """Step of the arena of a bucket"""
+        if num_tokens & (num_tokens - 1) != 0:
+            raise ValueError(f"{num_tokens} tokens is not a bucket size")
+        if num_tokens not in self.arenas:
+            self.arenas[num_tokens] = TensorArena()
+        return self.arenas[num_tokens].step()
+
+    def unregister(self):
+        for arena in self.arenas.values():
+            arena.unregister()
+        self.arenas = {}
+
+
+def scratch(
+    shape: Sequence[int],
+    basetile_shape: Sequence[int] | None = None,
+    dtype: Tensor = Tensor_fp32,
+) -> Tensor:
+    """Temporary tensor of a step of an active arena or a new tensor"""
+    basetile_shape = basetile_shape or shape
+    if _active_arenas:
+        return _active_arenas[-1].get(shape, basetile_shape, dtype)
+    traits = TensorTraits(list(shape), list(basetile_shape))
+    return dtype(traits, [0] * traits.grid.nelems, 0)
+
+
+def scratch_like(A: Tensor) -> Tensor:
+    return scratch(A.shape, A.basetile_shape, type(A))
@@ -16,12 +16,14 @@ from typing import Sequence
 
 import numpy as np
 
-from nntile.functions import clear_async, copy_async, fill_async, gather_async
+from nntile.functions import (
+    clear_async, copy_async, copy_intersection_async, fill_async, gather_async)
 from nntile.nntile_core.tensor import (
     Tensor_bf16, Tensor_bool, Tensor_fp32, Tensor_fp32_fast_bf16,
-    Tensor_fp32_fast_fp16, Tensor_fp32_fast_tf32, Tensor_fp64, Tensor_int64,
-    TensorTraits)
+    Tensor_fp32_fast_fp16, Tensor_fp32_fast_tf32, Tensor_fp64, Tensor_int8,
+    Tensor_int64, TensorTraits)
 from nntile.types import Tensor
+from nntile.utils.arena import scratch, scratch_like  # noqa: F401
 
 nnt2np_type_mapping = {
     Tensor_fp32: np.float32,
@@ -29,6 +31,7 @@ nnt2np_type_mapping = {
     Tensor_bf16: np.float32,
     Tensor_fp64: np.float64,
     Tensor_int64: np.int64,
+    Tensor_int8: np.int8,
     Tensor_bool: bool,
     Tensor_fp32_fast_fp16: np.float32,
     Tensor_fp32_fast_bf16: np.float32,
@@ -39,6 +42,7 @@ np2nnt_type_mapping = {
     'float64': Tensor_fp64,
     'int32': Tensor_int64,
     'int64': Tensor_int64,
+    'int8': Tensor_int8,
     'bool': Tensor_bool
 }
 
@@ -84,6 +88,32 @@ def to_numpy(tensor_nnt):
     return np_res
 
 
+def mask_tile_status(mask: Tensor_bool) -> list[int]:
+    """Status of every tile of a boolean mask in the order of mask.grid.
+
+    0 means the tile is entirely masked out, 1 means it is partially masked
+    and 2 means no element of the tile is masked out. Attention operations use
+    it to skip tasks for masked out tiles (e.g., upper blocks of a causal
+    mask). This is a blocking call, as it reads the mask.
+    """
+    mask_np = to_numpy(mask)
+    status = []
+    for i in range(mask.grid.nelems):
+        tile_index = mask.grid.linear_to_index(i)
+        tile_slice = tuple(
+            slice(j * tile, (j + 1) * tile)
+            for j, tile in zip(tile_index, mask.basetile_shape)
+        )
+        mask_tile = mask_np[tile_slice]
+        if not mask_tile.any():
+            status.append(0)
+        elif mask_tile.all():
+            status.append(2)
+        else:
+            status.append(1)
+    return status
+
+
 async def to_numpy_async(tensor):
     dtype = nnt2np_type_mapping[type(tensor)]
     dest_np = np.zeros(tensor.shape, dtype=dtype, order='F')
@@ -152,6 +182,25 @@ def ones_like(A: Tensor, next_tag: int = 0):
     return ones(A.shape, A.basetile_shape, type(A), A.distribution, next_tag)
 
 
+def slice_copy(
+    A: Tensor, axis: int, start: int, size: int = 1, next_tag: int = 0
+):
+    """Copy of A[..., start:start+size, ...] along a given axis.
+
+    Tiling of all other axes is kept, so the copy can be put back into a
+    tensor of the same tiling by copy_intersection_async.
+    """
+    shape = list(A.shape)
+    shape[axis] = size
+    basetile_shape = list(A.basetile_shape)
+    basetile_shape[axis] = min(basetile_shape[axis], size)
+    A_slice = empty(shape, basetile_shape, type(A), next_tag=next_tag)
+    offset = [0] * len(shape)
+    offset[axis] = start
+    copy_intersection_async(A, [0] * len(shape), A_slice, offset)
+    return A_slice
+
+
 def clone(A: Tensor, next_tag: int = 0):
     A_clone = empty_like(A, next_tag)
     copy_async(A, A_clone)
@@ -42,7 +42,12 @@ def generate_greedy_logits_padding(
 
 
 def generate_greedy_logits_dynamic_kvcache(
-    attn_layer, input_ids, prefill_size, max_tokens
+    attn_layer,
+    input_ids,
+    prefill_size,
+    max_tokens,
+    block_size=None,
+    kv_cache=None,
 ):
     cur_seq_size = prefill_size
 
@@ -50,10 +55,12 @@ def generate_greedy_logits_dynamic_kvcache(
 
     is_prefill = True
 
-    kv_cache = KVCache(
-        max_cache_size=attn_layer.k.value.shape[1],
-        seq_size_dim=1
-    )
+    if kv_cache is None:
+        kv_cache = KVCache(
+            max_cache_size=attn_layer.k.value.shape[1],
+            seq_size_dim=1,
+            block_size=block_size,
+        )
 
     while cur_seq_size < max_tokens:
         output_ids_np = nntc.to_numpy(output_ids)
@@ -108,7 +108,8 @@ def generate_inputs(dtype: str, params: LayerNormTestParams):
     return torch_layer, nntile_layer, x_torch, y_grad_torch
 
 
-def generate_inputs_dynamic(dtype: str, params: LayerNormTestParams):
+def generate_inputs_dynamic(dtype: str, params: LayerNormTestParams,
+                            inference: bool = False):
     rng = np.random.default_rng(42)
     eps = params.eps
 
@@ -129,7 +130,8 @@ def generate_inputs_dynamic(dtype: str, params: LayerNormTestParams):
     )
     x_torch = torch.Tensor(x_nntile.T)
 
-    nntile_layer, _ = nntile.layer.LayerNorm.from_torch(torch_layer, X, 0)
+    nntile_layer, _ = nntile.layer.LayerNorm.from_torch(torch_layer, X, 0,
+                                                        inference=inference)
 
     x_shape = [params.n_size, params.m_size_dyn]
     x_basetile_shape = [params.n_size_tile, params.m_size_dyn_tile]
@@ -200,6 +202,31 @@ class TestLayerNorm:
         nntile_layer.y.unregister()
         assert torch.norm(y - y_nntile) <= rtol * torch.norm(y)
 
+    def test_forward_inference(self, starpu_simple, torch_rng, dtype: str,
+                               params: LayerNormTestParams):
+        torch_layer, nntile_layer, torch_inputs, nntile_inputs = \
+            generate_inputs_dynamic(dtype, params, inference=True)
+        # No gradients and backward-only temporaries are allocated
+        assert nntile_layer.y.grad is None
+        assert nntile_layer.gamma.grad is None
+        assert nntile_layer.beta.grad is None
+        assert nntile_layer.tmp_y_grad is None
+        x_torch, x_torch_other = torch_inputs
+        x_nntile, x_nntile_other = nntile_inputs
+        y = torch_layer(x_torch)
+        nntile_layer.forward_async()
+        y_nntile = torch.Tensor(to_numpy(nntile_layer.y.value).T)
+        rtol = dtype2tol[dtype]['rtol']
+        assert torch.norm(y - y_nntile) <= rtol * torch.norm(y)
+
+        y = torch_layer(x_torch_other)
+        outs_nnt = nntile_layer.forward_dynamic(x_nntile_other)
+        y_nntile = torch.Tensor(nntc.to_numpy(outs_nnt.value).T)
+        nntile_layer.unregister()
+        nntile_layer.x.unregister()
+        nntile_layer.y.unregister()
+        assert torch.norm(y - y_nntile) <= rtol * torch.norm(y)
+
     def test_backward(self, starpu_simple, torch_rng, dtype: str,
                               params: LayerNormTestParams):
         torch_layer, nntile_layer, x, y_grad = generate_inputs(dtype, params)
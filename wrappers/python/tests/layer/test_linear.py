@@ -386,6 +386,42 @@ def test_dynamic(numpy_rng, x_shape, w_shape):
     layer.unregister()
 
 
+@pytest.mark.parametrize(
+    "x_shape,w_shape",
+    [
+        ([3, 100], [100, 10]),
+        ([64, 100], [100, 130]),
+    ],
+)
+def test_dynamic_packed(numpy_rng, x_shape, w_shape):
+    """Forward pass with weights packed by `Linear.pack_weight`."""
+    linear_layer = nn.Linear(*w_shape)
+    x_nntile_tm_for_build = nntile.tensor.TensorMoments(
+        nntc.zeros(x_shape[::-1], dtype=nntile.tensor.Tensor_fp32), None, False
+    )
+    layer, _ = Linear.from_torch(
+        linear_layer, x_nntile_tm_for_build, w_shape[1] // 2, False, 0
+    )
+    layer.pack_weight()
+
+    x_np = np.asfortranarray(numpy_rng.random(x_shape, dtype=np.float32))
+    torch_output = linear_layer(torch.Tensor(x_np)).detach().numpy()
+    x_nntile_tm = nntile.tensor.TensorMoments(
+        nntc.from_array(np.transpose(x_np)), None, False
+    )
+    nntile_res_tm = layer.forward_dynamic(x_nntile_tm)
+    nntile_res = np.transpose(nntc.to_numpy(nntile_res_tm.value))
+    output_rel_error = np.linalg.norm(
+        nntile_res - torch_output
+    ) / np.linalg.norm(torch_output)
+    assert output_rel_error <= 1e-5
+
+    x_nntile_tm_for_build.value.unregister()
+    x_nntile_tm.value.unregister()
+    nntile_res_tm.value.unregister()
+    layer.unregister()
+
+
 @pytest.mark.parametrize('side,x_shape,w_shape,b_shape,n_contracted_dim', [
     ('L', [20, 10], [10, 5], [5], 1),
     ('L', [20, 10, 5], [10, 5, 7], [7], 2),
@@ -25,8 +25,12 @@ from transformers.models.llama.modeling_llama import (
 
 import nntile
 import nntile.utils.constructors as nntc
+from nntile.layer.cache_utils import (
+    BatchKVCache, KVBlockPool, KVCache, PagedKVCache, PrefixCache,
+    QuantizedKVCache, SinkKVCache)
 from nntile.model.llama_config import LlamaConfigNNTile
 from nntile.tensor import TensorMoments, TensorTraits, clear_async
+from nntile.utils.arena import TensorArena
 from nntile.utils.constructors import to_numpy, zeros_like
 
 # NNTile dtype via corresponding Tensor type
@@ -99,7 +103,7 @@ multiple_tiles = LlamaAttentionTestParams(
 
 
 def generate_inputs(dtype: str, params: LlamaAttentionTestParams, bias: bool,
-                    flash_attention: bool):
+                    flash_attention: bool, causal: bool = False):
     rng = np.random.default_rng(42)
     torch_layer_config = LlamaConfig_torch(
         hidden_size=params.n_emb,
@@ -148,6 +152,8 @@ def generate_inputs(dtype: str, params: LlamaAttentionTestParams, bias: bool,
             dtype=np.int64)
     pos_ids_torch = torch.tensor(pos_ids, dtype=torch.long)
     mask = rng.integers(2, size=(params.n_seq, params.n_seq))
+    if causal:
+        mask = np.triu(np.ones((params.n_seq, params.n_seq), dtype=int))
     mask_np = np.array(mask, dtype=bool, order='F')
     mask_torch = torch.Tensor(np.array(1 - mask, dtype=np.float32)).T \
             * torch.finfo(torch.float32).min
@@ -265,6 +271,7 @@ class TestLlamaAttention:
     "params",
     [
         pytest.param(single_tile, id="single_tile"),
+        pytest.param(single_tile_trivial, id="single_tile_trivial"),
     ],
 )
 @pytest.mark.parametrize(
@@ -286,6 +293,11 @@ def test_llama_attn_forward_dynamic(
         dtype, params, bias, flash_attention
     )
 
+    # Q of all the query groups, K and V are stacked along the leading axis
+    nntile_layer.fuse_qkv()
+    kv_group_size = params.n_head // params.n_head_kv
+    assert nntile_layer.w_qkv.shape[0] == kv_group_size + 2
+
     y, _, _ = torch_layer(x, position_ids=pos_ids, attention_mask=mask)
 
     input_x = x.cpu().detach().numpy().T
@@ -321,6 +333,86 @@ def test_llama_attn_forward_dynamic(
     nntile_layer.y.unregister()
 
 
+@pytest.mark.parametrize(
+    "params",
+    [
+        pytest.param(single_tile, id="single_tile"),
+        pytest.param(single_tile_trivial, id="single_tile_trivial"),
+    ],
+)
+def test_llama_attn_fuse_qkv_gemm_tasks(
+    starpu_simple, torch_rng, params: LlamaAttentionTestParams
+):
+    _, nntile_layer, x, *_ = generate_inputs("fp32", params, False, False)
+    x_nntile = nntc.from_array(x.cpu().detach().numpy().T)
+    # Tasks of projections are captured to be counted, while temporaries of
+    # the arena survive the capture
+    arena = TensorArena()
+    graph = nntile.starpu.TaskGraph()
+    n_gemm = []
+    qkv = []
+    for fused in (False, True):
+        if fused:
+            nntile_layer.fuse_qkv()
+        graph.begin_capture()
+        with arena.step():
+            qkv.append([
+                to_numpy(t)
+                for t in nntile_layer._forward_mlp_qkv_dynamic(x_nntile)
+            ])
+        assert graph.end_capture()
+        n_gemm.append(graph.count("nntile_gemm"))
+    graph.clear()
+    arena.unregister()
+    x_nntile.unregister()
+    nntile_layer.unregister()
+    nntile_layer.x.unregister()
+    nntile_layer.y.unregister()
+    # A single gemm task per tile of heads computes Q, K and V at once
+    assert n_gemm[0] == 3 * n_gemm[1]
+    for t, t_fused in zip(*qkv):
+        assert np.linalg.norm(t - t_fused) <= 1e-6 * np.linalg.norm(t)
+
+
+@pytest.mark.parametrize(
+    "params",
+    [
+        pytest.param(single_tile, id="single_tile"),
+        pytest.param(single_tile_trivial, id="single_tile_trivial"),
+    ],
+)
+def test_llama_attn_forward_dynamic_arena(
+    starpu_simple, torch_rng, params: LlamaAttentionTestParams
+):
+    torch_layer, nntile_layer, x, pos_ids, mask, *_ = generate_inputs(
+        "fp32", params, False, False
+    )
+    y, _, _ = torch_layer(x, position_ids=pos_ids, attention_mask=mask)
+    x_nntile = nntc.from_array(x.cpu().detach().numpy().T)
+
+    arena = TensorArena()
+    for step in range(2):
+        with arena.step():
+            y_nntile, _ = nntile_layer.forward_dynamic(
+                TensorMoments(x_nntile, None, False)
+            )
+            # Output of the step is valid only until its end
+            y_np = nntc.to_numpy(y_nntile.value)
+        # The second step reuses all temporaries of the first one
+        if step > 0:
+            assert arena.step_allocs == 0
+            assert arena.num_reuses > 0
+        rtol = dtype2tol["fp32"]["rtol"]
+        y_nntile = torch.Tensor(y_np.T)
+        assert torch.norm(y - y_nntile) <= rtol * torch.norm(y)
+
+    arena.unregister()
+    x_nntile.unregister()
+    nntile_layer.unregister()
+    nntile_layer.x.unregister()
+    nntile_layer.y.unregister()
+
+
 @pytest.mark.parametrize("bias", [False])
 @pytest.mark.parametrize(
     "params",
@@ -336,6 +428,7 @@ def test_llama_attn_forward_dynamic(
     ],
 )
 @pytest.mark.parametrize("flash_attention", [False])
+@pytest.mark.parametrize("kv_block_size", [None, 3])
 def test_llama_attn_kvcache(
     starpu_simple,
     torch_rng,
@@ -343,6 +436,7 @@ def test_llama_attn_kvcache(
     params: LlamaAttentionTestParams,
     bias: bool,
     flash_attention: bool,
+    kv_block_size: int | None,
 ):
     _, nntile_layer, x, _, _, *_ = generate_inputs(
         dtype, params, bias, flash_attention
@@ -355,7 +449,7 @@ def test_llama_attn_kvcache(
     inp_prefill = nntc.from_array(inp_np[:, :prefill_size, 0:1])
 
     outs_dyn = generate_greedy_logits_dynamic_kvcache(
-        nntile_layer, inp_prefill, prefill_size, max_tokens
+        nntile_layer, inp_prefill, prefill_size, max_tokens, kv_block_size
     )
     outs_dyn_np = nntc.to_numpy(outs_dyn)
 
@@ -376,3 +470,405 @@ def test_llama_attn_kvcache(
     nntile_layer.unregister()
     nntile_layer.x.unregister()
     nntile_layer.y.unregister()
+
+
+@pytest.mark.parametrize("bias", [False])
+@pytest.mark.parametrize(
+    "params",
+    [
+        pytest.param(single_tile, id="single_tile"),
+    ],
+)
+@pytest.mark.parametrize(
+    "dtype",
+    [
+        "fp32",
+    ],
+)
+@pytest.mark.parametrize("flash_attention", [False])
+def test_llama_attn_paged_kvcache(
+    starpu_simple,
+    torch_rng,
+    dtype: str,
+    params: LlamaAttentionTestParams,
+    bias: bool,
+    flash_attention: bool,
+):
+    _, nntile_layer, x, _, _, *_ = generate_inputs(
+        dtype, params, bias, flash_attention
+    )
+
+    prefill_size = 4
+    max_tokens = 8
+    block_size = 3
+
+    inp_np = x.cpu().detach().numpy().T
+
+    # Pool is shared by two sequences, so blocks of a sequence are not
+    # contiguous in the pool
+    pool = KVBlockPool(num_blocks=6, block_size=block_size)
+    other = PagedKVCache(pool, 0)
+    kv_cache = PagedKVCache(pool, 0)
+    inp_prefill = nntc.from_array(inp_np[:, :prefill_size, 0:1])
+    y_other, other = nntile_layer.forward_dynamic(
+        TensorMoments(inp_prefill, None, False), kv_cache=other
+    )
+    y_other.unregister()
+    outs_paged = generate_greedy_logits_dynamic_kvcache(
+        nntile_layer,
+        inp_prefill,
+        prefill_size,
+        max_tokens,
+        kv_cache=kv_cache,
+    )
+    outs_paged_np = nntc.to_numpy(outs_paged)
+    assert kv_cache.block_table == [2, 3, 4]
+    assert pool.num_free_blocks() == 1
+
+    inp_prefill = nntc.from_array(inp_np[:, :prefill_size, 0:1])
+    outs_stat = generate_greedy_logits_padding(
+        nntile_layer, inp_prefill, prefill_size, max_tokens
+    )
+    outs_stat_np = nntc.to_numpy(outs_stat)
+
+    np.testing.assert_allclose(
+        outs_stat_np,
+        outs_paged_np,
+        err_msg="test_paged_kvcache: Dynamic does not match static",
+        rtol=dtype2tol[dtype]["rtol"],
+        atol=dtype2tol[dtype]["rtol"],
+    )
+
+    pool.unregister()
+    nntile_layer.unregister()
+    nntile_layer.x.unregister()
+    nntile_layer.y.unregister()
+
+
+@pytest.mark.parametrize("bias", [False])
+@pytest.mark.parametrize(
+    "params",
+    [
+        pytest.param(single_tile, id="single_tile"),
+    ],
+)
+@pytest.mark.parametrize(
+    "dtype",
+    [
+        "fp32",
+    ],
+)
+@pytest.mark.parametrize("flash_attention", [False])
+def test_llama_attn_quantized_kvcache(
+    starpu_simple,
+    torch_rng,
+    dtype: str,
+    params: LlamaAttentionTestParams,
+    bias: bool,
+    flash_attention: bool,
+):
+    _, nntile_layer, x, _, _, *_ = generate_inputs(
+        dtype, params, bias, flash_attention
+    )
+
+    prefill_size = 4
+    max_tokens = 8
+
+    inp_np = x.cpu().detach().numpy().T
+    inp_prefill = nntc.from_array(inp_np[:, :prefill_size, 0:1])
+
+    kv_cache = QuantizedKVCache(
+        max_cache_size=nntile_layer.k.value.shape[1],
+        seq_size_dim=1,
+        block_size=3,
+    )
+    outs_quant = generate_greedy_logits_dynamic_kvcache(
+        nntile_layer,
+        inp_prefill,
+        prefill_size,
+        max_tokens,
+        kv_cache=kv_cache,
+    )
+    outs_quant_np = nntc.to_numpy(outs_quant)
+    assert len(kv_cache) == max_tokens - 1
+
+    inp_prefill = nntc.from_array(inp_np[:, :prefill_size, 0:1])
+    outs_stat = generate_greedy_logits_padding(
+        nntile_layer, inp_prefill, prefill_size, max_tokens
+    )
+    outs_stat_np = nntc.to_numpy(outs_stat)
+
+    # Every head of a token is rounded to 8 bits
+    np.testing.assert_allclose(
+        outs_stat_np,
+        outs_quant_np,
+        err_msg="test_quantized_kvcache: Dynamic does not match static",
+        rtol=5e-2,
+        atol=5e-2,
+    )
+
+    nntile_layer.unregister()
+    nntile_layer.x.unregister()
+    nntile_layer.y.unregister()
+
+
+@pytest.mark.parametrize("bias", [False])
+@pytest.mark.parametrize(
+    "params",
+    [
+        pytest.param(single_tile, id="single_tile"),
+    ],
+)
+@pytest.mark.parametrize(
+    "dtype",
+    [
+        "fp32",
+    ],
+)
+@pytest.mark.parametrize("flash_attention", [False])
+def test_llama_attn_sink_kvcache(
+    starpu_simple,
+    torch_rng,
+    dtype: str,
+    params: LlamaAttentionTestParams,
+    bias: bool,
+    flash_attention: bool,
+):
+    _, nntile_layer, x, _, _, *_ = generate_inputs(
+        dtype, params, bias, flash_attention
+    )
+
+    prefill_size = 4
+    max_tokens = 8
+
+    inp_np = x.cpu().detach().numpy().T
+    inp_prefill = nntc.from_array(inp_np[:, :prefill_size, 0:1])
+
+    # Window is large enough to keep all the tokens
+    kv_cache = SinkKVCache(
+        max_cache_size=nntile_layer.k.value.shape[1],
+        seq_size_dim=1,
+        block_size=3,
+        sink_size=2,
+        window_size=max_tokens,
+    )
+    outs_sink = generate_greedy_logits_dynamic_kvcache(
+        nntile_layer,
+        inp_prefill,
+        prefill_size,
+        max_tokens,
+        kv_cache=kv_cache,
+    )
+    outs_sink_np = nntc.to_numpy(outs_sink)
+    assert len(kv_cache) == max_tokens - 1
+
+    inp_prefill = nntc.from_array(inp_np[:, :prefill_size, 0:1])
+    outs_stat = generate_greedy_logits_padding(
+        nntile_layer, inp_prefill, prefill_size, max_tokens
+    )
+    outs_stat_np = nntc.to_numpy(outs_stat)
+
+    np.testing.assert_allclose(
+        outs_stat_np,
+        outs_sink_np,
+        err_msg="test_sink_kvcache: Dynamic does not match static",
+        rtol=1e-5,
+        atol=1e-5,
+    )
+
+    # Generation goes beyond the size of the cache, evicted tokens are not
+    # attended to any more
+    inp_prefill = nntc.from_array(inp_np[:, :prefill_size, 0:1])
+    kv_cache = SinkKVCache(
+        max_cache_size=nntile_layer.k.value.shape[1],
+        seq_size_dim=1,
+        block_size=3,
+        sink_size=2,
+        window_size=3,
+    )
+    outs_evict = generate_greedy_logits_dynamic_kvcache(
+        nntile_layer,
+        inp_prefill,
+        prefill_size,
+        2 * max_tokens,
+        kv_cache=kv_cache,
+    )
+    assert len(kv_cache) == 5
+    assert np.all(np.isfinite(nntc.to_numpy(outs_evict)))
+
+    nntile_layer.unregister()
+    nntile_layer.x.unregister()
+    nntile_layer.y.unregister()
+
+
+@pytest.mark.parametrize("bias", [False])
+@pytest.mark.parametrize(
+    "params",
+    [
+        pytest.param(single_tile, id="single_tile"),
+    ],
+)
+@pytest.mark.parametrize(
+    "dtype",
+    [
+        "fp32",
+    ],
+)
+@pytest.mark.parametrize("flash_attention", [False])
+def test_llama_attn_prefix_cache(
+    starpu_simple,
+    torch_rng,
+    dtype: str,
+    params: LlamaAttentionTestParams,
+    bias: bool,
+    flash_attention: bool,
+):
+    _, nntile_layer, x, _, _, *_ = generate_inputs(
+        dtype, params, bias, flash_attention
+    )
+
+    block_size = 3
+    inp_np = x.cpu().detach().numpy().T
+    # Token ids only identify prompts, inputs of the layer are embeddings
+    prompt_ids = list(range(10))
+
+    pool = KVBlockPool(num_blocks=10, block_size=block_size)
+    prefix_cache = PrefixCache(pool, max_blocks=4)
+
+    # The first prompt is a prefix of the second one
+    first = PagedKVCache(pool, 0)
+    inp = nntc.from_array(inp_np[:, :8, 0:1])
+    y, first = nntile_layer.forward_dynamic(
+        TensorMoments(inp, None, False), kv_cache=first
+    )
+    y.unregister()
+    prefix_cache.insert(prompt_ids[:8], first.block_table)
+    assert prefix_cache.num_blocks == 2
+    pool.free(first.block_table)
+
+    # Only the rest of the second prompt is prefilled
+    blocks = prefix_cache.match(prompt_ids)
+    assert blocks == first.block_table[:2]
+    second = PagedKVCache(pool, 0, blocks, len(blocks) * block_size)
+    inp = nntc.from_array(inp_np[:, len(second):10, 0:1])
+    y, second = nntile_layer.forward_dynamic(
+        TensorMoments(inp, None, False), kv_cache=second
+    )
+    y_np = nntc.to_numpy(y.value)
+    y.unregister()
+
+    # Reference prefills the whole second prompt
+    reference = PagedKVCache(pool, 0)
+    inp = nntc.from_array(inp_np[:, :10, 0:1])
+    y, reference = nntile_layer.forward_dynamic(
+        TensorMoments(inp, None, False), kv_cache=reference
+    )
+    y_ref_np = nntc.to_numpy(y.value)[:, 6:, :]
+    y.unregister()
+
+    np.testing.assert_allclose(
+        y_np,
+        y_ref_np,
+        err_msg="test_prefix_cache: Cached prefix does not match prefill",
+        rtol=dtype2tol[dtype]["rtol"],
+        atol=dtype2tol[dtype]["rtol"],
+    )
+
+    # Cached blocks are returned to the pool only after eviction
+    pool.free(second.block_table)
+    pool.free(reference.block_table)
+    assert pool.num_free_blocks() == pool.num_blocks - 2
+    prefix_cache.clear()
+    assert pool.num_free_blocks() == pool.num_blocks
+
+    pool.unregister()
+    nntile_layer.unregister()
+    nntile_layer.x.unregister()
+    nntile_layer.y.unregister()
+
+
+@pytest.mark.parametrize("bias", [False])
+@pytest.mark.parametrize(
+    "params",
+    [
+        pytest.param(multiple_tiles, id="multiple_tiles"),
+    ],
+)
+@pytest.mark.parametrize(
+    "dtype",
+    [
+        "fp32",
+    ],
+)
+@pytest.mark.parametrize("flash_attention", [False])
+def test_llama_attn_varlen_batch(
+    starpu_simple,
+    torch_rng,
+    dtype: str,
+    params: LlamaAttentionTestParams,
+    bias: bool,
+    flash_attention: bool,
+):
+    _, nntile_layer, x, _, _, *_ = generate_inputs(
+        dtype, params, bias, flash_attention, causal=True
+    )
+    assert nntile_layer.mask_causal
+
+    # Sequences of different lengths, the longest one spans several tiles
+    prefill_sizes = [20, 5, 11]
+    n_new = 2
+    inp_np = x.cpu().detach().numpy().T
+
+    def prefill():
+        caches = []
+        for i, size in enumerate(prefill_sizes):
+            cache = KVCache(
+                max_cache_size=nntile_layer.k.value.shape[1], seq_size_dim=1
+            )
+            inp = nntc.from_array(inp_np[:, :size, i:i + 1])
+            y, cache = nntile_layer.forward_dynamic(
+                TensorMoments(inp, None, False), kv_cache=cache
+            )
+            y.unregister()
+            inp.unregister()
+            caches.append(cache)
+        return caches
+
+    # Reference: every sequence is processed on its own
+    inp_new_np = np.asfortranarray(
+        inp_np[:, -n_new:, :len(prefill_sizes)]
+    )
+    y_ref_np = np.zeros_like(inp_new_np)
+    for i, cache in enumerate(prefill()):
+        inp = nntc.from_array(np.asfortranarray(inp_new_np[:, :, i:i + 1]))
+        y, _ = nntile_layer.forward_dynamic(
+            TensorMoments(inp, None, False), kv_cache=cache
+        )
+        y_ref_np[:, :, i:i + 1] = nntc.to_numpy(y.value)
+        y.unregister()
+        inp.unregister()
+
+    # All sequences at once as a single packed batch
+    kv_cache = BatchKVCache(prefill())
+    inp = nntc.from_array(inp_new_np)
+    y, _ = nntile_layer.forward_dynamic(
+        TensorMoments(inp, None, False), kv_cache=kv_cache
+    )
+    y_np = nntc.to_numpy(y.value)
+    y.unregister()
+    inp.unregister()
+    assert [len(cache) for cache in kv_cache.caches] == [
+        size + n_new for size in prefill_sizes
+    ]
+
+    np.testing.assert_allclose(
+        y_np,
+        y_ref_np,
+        err_msg="test_varlen_batch: Batch does not match single sequences",
+        rtol=dtype2tol[dtype]["rtol"],
+        atol=dtype2tol[dtype]["rtol"],
+    )
+
+    nntile_layer.unregister()
+    nntile_layer.x.unregister()
+    nntile_layer.y.unregister()
@@ -0,0 +1,158 @@
+# @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+#                              (Skoltech), Russia. All rights reserved.
+#                2023-present Artificial Intelligence Research Institute
+#                              (AIRI), Russia. All rights reserved.
+#
+# NNTile is software framework for fast training of big neural networks on
+# distributed-memory heterogeneous systems based on StarPU runtime system.
+#
+# @file wrappers/python/tests/model/generation/test_llm_beamsearch.py
+#
+# @version 1.1.0
+
+import numpy as np
+import pytest
+import scipy
+
+import nntile.utils.constructors as nntc
+from nntile.model.generation.llm_beamsearch import generate_parallel
+from nntile.model.generation.llm_params import ParallelSamplingMode
+from nntile.tensor import TensorMoments
+
+
+class CacheModel:
+    """
+    Toy model, whose logits depend on all the tokens in kvcache
+
+    Keys and values of a token are its embedding. Logits of a position are a
+    linear map of the mean of keys of all cached positions up to it, so a
+    beam, that does not follow its parent in kvcache, gets other logits.
+    """
+
+    def __init__(self, rng, vocab_size, head_size, max_cache_size):
+        self.emb = rng.standard_normal((head_size, vocab_size))
+        self.out = rng.standard_normal((vocab_size, head_size))
+        self.max_cache_size = max_cache_size
+
+    def forward_dynamic(self, x, use_cache, kv_caches):
+        tokens = nntc.to_numpy(x.value)
+        seq_size = tokens.shape[0]
+        kv_np = np.asfortranarray(self.emb[:, tokens][..., None])
+        k = nntc.from_array(kv_np)
+        v = nntc.from_array(kv_np)
+        if not kv_caches.is_initialized():
+            kv_caches.init(1, self.max_cache_size, seq_size_dim=1)
+        cache = kv_caches.get_cache()[0]
+        cache.append(k, v)
+        k.unregister()
+        v.unregister()
+        cache_size = len(cache)
+        keys = nntc.to_numpy(cache.k_view)[:, :cache_size, :, 0]
+        prefix_mean = np.cumsum(keys, axis=1) / np.arange(
+            1, cache_size + 1
+        ).reshape(1, -1, 1)
+        hidden = prefix_mean[:, cache_size - seq_size :]
+        logits = np.einsum("vh,hsb->vsb", self.out, hidden)
+        return (
+            TensorMoments(nntc.from_array(np.asfortranarray(logits)), None,
+                          False),
+            kv_caches,
+        )
+
+
+def reference_beam_search(model, prompt, max_tokens, num_beams, mode):
+    """Beam search on host, returns sequences of beams in order of scores"""
+
+    def logprobs(seq):
+        hidden = model.emb[:, seq].mean(axis=1)
+        return scipy.special.log_softmax(model.out @ hidden)
+
+    vocab_size = model.emb.shape[1]
+    lp = logprobs(prompt)
+    order = np.argsort(-lp, kind="stable")[:num_beams]
+    beams = [list(prompt) + [token] for token in order]
+    scores = lp[order]
+    while len(beams[0]) < max_tokens:
+        total = np.stack(
+            [scores[b] + logprobs(beams[b]) for b in range(num_beams)],
+            axis=1,
+        )
+        flat = total.flatten(order="F")
+        order = np.argsort(-flat, kind="stable")[:num_beams]
+        parents = order // vocab_size
+        tokens = order % vocab_size
+        new_scores = flat[order]
+        if mode == ParallelSamplingMode.BeamSearchBigrams:
+            new_scores = new_scores - scores[parents]
+        beams = [beams[p] + [t] for p, t in zip(parents, tokens)]
+        scores = new_scores
+    return np.array(beams).T
+
+
+@pytest.mark.parametrize(
+    "mode",
+    [ParallelSamplingMode.BeamSearch, ParallelSamplingMode.BeamSearchBigrams],
+)
+@pytest.mark.parametrize("num_beams", [1, 3])
+def test_generate_parallel_beam_search(starpu_simple, numpy_rng, mode,
+                                       num_beams):
+    vocab_size, head_size, prompt_size, max_tokens = 11, 4, 3, 8
+    model = CacheModel(numpy_rng, vocab_size, head_size, max_tokens)
+    prompt = numpy_rng.integers(0, vocab_size, prompt_size)
+    input_ids = nntc.from_array(
+        np.asfortranarray(prompt.reshape(-1, 1).astype(np.int64))
+    )
+
+    # EOS is never generated
+    output_ids, num_tokens = generate_parallel(
+        model, input_ids, max_tokens, -1, num_beams, None, mode
+    )
+    output_np = nntc.to_numpy(output_ids)
+    input_ids.unregister()
+    output_ids.unregister()
+
+    ref = reference_beam_search(model, prompt, max_tokens, num_beams, mode)
+    assert num_tokens == max_tokens
+    np.testing.assert_equal(output_np, ref)
+
+
+def test_generate_parallel_kvcache_reorder(starpu_simple, numpy_rng):
+    """Caches of beams shall hold keys of their own sequences"""
+    vocab_size, head_size, prompt_size, max_tokens = 11, 4, 3, 8
+    num_beams = 3
+    model = CacheModel(numpy_rng, vocab_size, head_size, max_tokens)
+    prompt = numpy_rng.integers(0, vocab_size, prompt_size)
+    input_ids = nntc.from_array(
+        np.asfortranarray(prompt.reshape(-1, 1).astype(np.int64))
+    )
+
+    caches = []
+    forward_dynamic = model.forward_dynamic
+
+    def forward_keep_cache(x, use_cache, kv_caches):
+        caches.append(kv_caches)
+        return forward_dynamic(x, use_cache, kv_caches)
+
+    model.forward_dynamic = forward_keep_cache
+    output_ids, _ = generate_parallel(
+        model, input_ids, max_tokens, -1, num_beams, None,
+        ParallelSamplingMode.BeamSearch,
+    )
+    output_np = nntc.to_numpy(output_ids)
+    input_ids.unregister()
+    output_ids.unregister()
+
+    # The last token of every beam is not fed to the model yet
+    cache = caches[-1].get_cache()[0]
+    cache_size = len(cache)
+    assert cache_size == max_tokens - 1
+    keys = nntc.to_numpy(cache.k_view)[:, :cache_size, :, 0]
+    values = nntc.to_numpy(cache.v_view)[:, :cache_size, :, 0]
+    ref = reference_beam_search(
+        model, prompt, max_tokens, num_beams, ParallelSamplingMode.BeamSearch
+    )
+    np.testing.assert_equal(output_np, ref)
+    for beam in range(num_beams):
+        expected = model.emb[:, ref[:cache_size, beam]]
+        np.testing.assert_equal(keys[:, :, beam], expected)
+        np.testing.assert_equal(values[:, :, beam], expected)
@@ -14,7 +14,7 @@ import numpy as np
 import pytest
 import scipy
 
-# import nntile.utils.constructors as nntc
+import nntile.utils.constructors as nntc
 from nntile.model.generation.llm_params import GenerationMode, GenerationParams
 from nntile.model.generation.llm_samplers import (
     TopKSampler, TopPSampler, get_sampler)
@@ -135,3 +135,75 @@ def test_topp(n_resamples):
 
         assert unique0.sort() == expected0[-k0:].sort()
         assert unique1.sort() == expected1[-k1:].sort()
+
+
+@pytest.mark.parametrize("max_candidates,on_host", [
+    (None, False),
+    (None, True),
+    (1000, False),
+])
+def test_topp_flat_tensor(starpu_simple, numpy_rng, max_candidates, on_host):
+    """
+    Nucleus of a flat distribution (high temperature) spans most of the
+    vocabulary, so tokens sampled out of a tensor of logits shall come from
+    the whole nucleus of sample_topp and not only from a few largest logits.
+    By default the number of candidates on device grows from 256 until they
+    cover the nucleus.
+    """
+    vocab_size, p_thr, temperature, n_resamples = 1000, 0.9, 10.0, 50
+    logits_np = numpy_rng.random([vocab_size, 1, 1]).astype(np.float32)
+
+    # Nucleus as in sample_topp, including the token crossing the threshold
+    argsorted = np.argsort(logits_np[:, 0, 0])
+    probas = scipy.special.softmax(
+        logits_np[argsorted, 0, 0] / temperature, axis=0
+    )
+    topp_k = np.searchsorted(np.cumsum(probas[::-1]), p_thr)
+    nucleus = set(argsorted[-topp_k - 1 :])
+    assert topp_k > 256
+
+    logits = nntc.from_array(np.asfortranarray(logits_np))
+    sampler = TopPSampler(p_thr, temperature, max_candidates, on_host)
+    sampled = set()
+    for _ in range(n_resamples):
+        sampled.add(sampler.sample_tensor(logits)[0, 0])
+    logits.unregister()
+
+    assert sampled <= nucleus
+    assert not sampled <= set(argsorted[-256:])
+
+
+def test_topp_tensor_nucleus(starpu_simple, numpy_rng):
+    """
+    Tokens sampled on device for every position of a tensor of logits shall
+    belong to the exact nucleus of the position, that differs in size
+    """
+    vocab_size, seq_size, batch_size = 600, 2, 3
+    p_thr, temperature, n_resamples = 0.7, 1.0, 20
+    logits_np = numpy_rng.standard_normal(
+        [vocab_size, seq_size, batch_size]
+    ).astype(np.float32)
+    logits_np[:, 0, 0] *= 10.0
+
+    nuclei = {}
+    for s in range(seq_size):
+        for b in range(batch_size):
+            argsorted = np.argsort(logits_np[:, s, b])
+            probas = scipy.special.softmax(
+                logits_np[argsorted, s, b] / temperature, axis=0
+            )
+            topp_k = np.searchsorted(np.cumsum(probas[::-1]), p_thr)
+            nuclei[s, b] = set(argsorted[-topp_k - 1 :])
+
+    logits = nntc.from_array(
+        np.asfortranarray(logits_np), basetile_shape=[200, 1, 2]
+    )
+    sampler = TopPSampler(p_thr, temperature)
+    for _ in range(n_resamples):
+        tokens = sampler.submit_tensor(logits)
+        tokens_np = nntc.to_numpy(tokens)
+        tokens.unregister()
+        for s in range(seq_size):
+            for b in range(batch_size):
+                assert tokens_np[s, b] in nuclei[s, b]
+    logits.unregister()
@@ -0,0 +1,171 @@
+# @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+#                              (Skoltech), Russia. All rights reserved.
+#                2023-present Artificial Intelligence Research Institute
+#                              (AIRI), Russia. All rights reserved.
+#
+# NNTile is software framework for fast training of big neural networks on
+# distributed-memory heterogeneous systems based on StarPU runtime system.
+#
+# @file wrappers/python/tests/model/test_async_llm_engine.py
+# Continuous batching of concurrent GPT2 requests
+#
+# @version 1.1.0
+
+import asyncio
+import json
+from dataclasses import dataclass
+
+import pytest
+from fastapi.testclient import TestClient
+from transformers import GPT2Tokenizer
+
+from nntile.inference.llm_api_server import (
+    SimpleLlmApiServer, SimpleLlmApiServerParams)
+from nntile.inference.llm_async_engine import LlmAsyncInferenceEngine
+from nntile.inference.llm_sync_engine import LlmSyncInferenceEngine
+from nntile.model.generation.llm import GenerationMode, GenerationParams
+from nntile.model.gpt2 import GPT2Model as GPT2Model_nnt
+
+
+@dataclass
+class AsyncLlmInferenceEngineTestParams:
+    model_name: str
+    prompts: list[str]
+    max_tokens: list[int]
+    max_batch_size: int
+    prefill_chunk_size: int | None = None
+
+    minibatch_size: int = 1
+    minibatch_size_tile: int = 1
+    seq_len_tile: int = 1024
+
+
+TEST_LLM_INF_ENGINE_INPUT_PARAMS = [
+    AsyncLlmInferenceEngineTestParams(
+        "gpt2",
+        ["Are you big?\n", "The quick brown fox", "Hello"],
+        max_tokens=[8, 12, 10],
+        max_batch_size=2,
+    ),
+    AsyncLlmInferenceEngineTestParams(
+        "gpt2",
+        ["Are you big?\n", "The quick brown fox", "Hello"],
+        max_tokens=[8, 12, 10],
+        max_batch_size=2,
+        prefill_chunk_size=2,
+    ),
+]
+
+
+@pytest.mark.slow
+@pytest.mark.parametrize("params", TEST_LLM_INF_ENGINE_INPUT_PARAMS)
+def test_async_llm_inference_engine_batching(starpu_simple, params):
+    tokenizer = GPT2Tokenizer.from_pretrained(params.model_name)
+    next_tag = 0
+    model_nnt, next_tag = GPT2Model_nnt.from_pretrained(
+        params.model_name,
+        params.minibatch_size,
+        params.minibatch_size_tile,
+        params.seq_len_tile,
+        next_tag,
+    )
+
+    sync_engine = LlmSyncInferenceEngine(
+        model_nnt, tokenizer, params.seq_len_tile
+    )
+    expected = [
+        sync_engine.generate(
+            prompt,
+            params=GenerationParams(max_tokens=max_tokens),
+            mode=GenerationMode.Greedy,
+        )
+        for prompt, max_tokens in zip(params.prompts, params.max_tokens)
+    ]
+
+    async_engine = LlmAsyncInferenceEngine(
+        model_nnt,
+        tokenizer,
+        params.seq_len_tile,
+        max_batch_size=params.max_batch_size,
+        prefill_chunk_size=params.prefill_chunk_size,
+    )
+
+    async def generate_all():
+        # Requests of different lengths join and leave the running batch
+        return await asyncio.gather(
+            *[
+                async_engine.generate(
+                    prompt,
+                    params=GenerationParams(max_tokens=max_tokens),
+                    mode=GenerationMode.Greedy,
+                )
+                for prompt, max_tokens in zip(
+                    params.prompts, params.max_tokens
+                )
+            ]
+        )
+
+    generated = asyncio.run(generate_all())
+
+    assert generated == expected, f"Got: {generated}. Expected {expected}"
+
+
+@pytest.mark.slow
+@pytest.mark.parametrize("params", TEST_LLM_INF_ENGINE_INPUT_PARAMS[:1])
+def test_async_llm_inference_engine_streaming(starpu_simple, params):
+    tokenizer = GPT2Tokenizer.from_pretrained(params.model_name)
+    next_tag = 0
+    model_nnt, next_tag = GPT2Model_nnt.from_pretrained(
+        params.model_name,
+        params.minibatch_size,
+        params.minibatch_size_tile,
+        params.seq_len_tile,
+        next_tag,
+    )
+
+    async_engine = LlmAsyncInferenceEngine(
+        model_nnt,
+        tokenizer,
+        params.seq_len_tile,
+        max_batch_size=params.max_batch_size,
+    )
+    prompt, max_tokens = params.prompts[1], params.max_tokens[1]
+    expected = asyncio.run(
+        async_engine.generate(
+            prompt,
+            params=GenerationParams(max_tokens=max_tokens),
+            mode=GenerationMode.Greedy,
+        )
+    )
+
+    # Stream through the API server by an in-process client
+    server = SimpleLlmApiServer(async_engine, SimpleLlmApiServerParams())
+    client = TestClient(server.get_app())
+    request = {"text": prompt, "max_tokens": max_tokens, "mode": "Greedy"}
+    chunks = []
+    done = None
+    with client.stream(
+        "POST", "/generate_stream", json={"request": request}
+    ) as response:
+        assert response.status_code == 200
+        event = None
+        for line in response.iter_lines():
+            if line.startswith("event: "):
+                event = line[len("event: ") :]
+            elif line.startswith("data: "):
+                data = json.loads(line[len("data: ") :])
+                if event == "done":
+                    done = data
+                else:
+                    chunks.append(data)
+                event = None
+
+    generated = prompt + "".join(chunk["text"] for chunk in chunks)
+    assert generated == expected, f"Got: {generated}. Expected {expected}"
+    assert done is not None
+    assert done["num_tokens"] == len(chunks)
+    assert done["ttft"] == chunks[0]["latency"]
+    assert len(done["token_latency"]) == len(chunks) - 1
+
+    metrics = client.get("/metrics").json()
+    assert metrics["ttft"] is not None
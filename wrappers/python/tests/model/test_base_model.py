@@ -0,0 +1,61 @@
+# @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+#                              (Skoltech), Russia. All rights reserved.
+#                2023-present Artificial Intelligence Research Institute
+#                              (AIRI), Russia. All rights reserved.
+#
+# NNTile is software framework for fast training of big neural networks on
+# distributed-memory heterogeneous systems based on StarPU runtime system.
+#
+# @file wrappers/python/tests/model/test_base_model.py
+# Test for nntile.model.BaseModel
+#
+# @version 1.1.0
+
+import numpy as np
+import pytest
+import torch
+
+import nntile
+from nntile.model.base_model import BaseModel
+from nntile.tensor import TensorMoments, TensorTraits
+from nntile.utils.constructors import to_numpy
+
+
+@pytest.mark.parametrize('n_size,n_size_tile,m_size,m_size_tile', [
+    (10, 10, 30, 30),
+    (10, 5, 30, 15),
+])
+@pytest.mark.parametrize('out_size,out_size_tile', [(12, 12), (12, 4)])
+@pytest.mark.parametrize('bias', [False, True])
+def test_optimize_for_inference_layer_norm_linear(starpu_simple,
+        n_size, n_size_tile, m_size, m_size_tile, out_size, out_size_tile,
+        bias):
+    rng = np.random.default_rng(42)
+    torch_norm = torch.nn.LayerNorm(n_size)
+    torch_norm.weight.data = torch.tensor(
+            rng.standard_normal(n_size), dtype=torch.float32)
+    torch_norm.bias.data = torch.tensor(
+            rng.standard_normal(n_size), dtype=torch.float32)
+    torch_linear = torch.nn.Linear(n_size, out_size, bias=bias)
+    x_traits = TensorTraits([n_size, m_size], [n_size_tile, m_size_tile])
+    x_value = nntile.tensor.Tensor_fp32(x_traits, [0] * x_traits.grid.nelems,
+            0)
+    next_tag = x_value.next_tag
+    x_value.from_array(np.array(rng.standard_normal([n_size, m_size]),
+            dtype=np.float32, order='F'))
+    x = TensorMoments(x_value, None, False)
+    norm, next_tag = nntile.layer.LayerNorm.from_torch(torch_norm, x,
+            next_tag)
+    linear, next_tag = nntile.layer.Linear.from_torch(torch_linear, norm.y,
+            out_size_tile, False, next_tag)
+    model = BaseModel([x, norm.y, linear.y], [norm, linear])
+    model.forward_async()
+    y_ref = to_numpy(linear.y.value)
+    # Beta of the norm becomes a bias of the linear layer if it had none
+    assert model.optimize_for_inference() == 1
+    assert not norm.affine
+    assert linear.b is not None
+    model.forward_async()
+    y = to_numpy(linear.y.value)
+    model.unregister()
+    assert np.linalg.norm(y - y_ref) <= 1e-5 * np.linalg.norm(y_ref)
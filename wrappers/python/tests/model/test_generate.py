@@ -19,6 +19,7 @@ from transformers import GPT2Tokenizer
 import nntile.utils.constructors as nnt_constructors
 from nntile.model.generation.llm import GenerationMode, GenerationParams
 from nntile.model.gpt2 import GPT2Model as GPT2Model_nnt
+from nntile.utils.arena import BucketedArenas
 
 
 @dataclass
@@ -76,3 +77,146 @@ def test_generation_from_pretrained(starpu_simple, params):
     assert (
         generated_text == params.expected
     ), f"Got: {generated_text}. Expected {params.expected}"
+
+
+@pytest.mark.slow
+@pytest.mark.parametrize("params", TEST_GENERATE_INPUT_PARAMS)
+@pytest.mark.parametrize("draft_model_name", ["gpt2", "distilgpt2"])
+@pytest.mark.parametrize("num_speculative_tokens", [1, 3])
+def test_speculative_generation_from_pretrained(
+    starpu_simple, params, draft_model_name, num_speculative_tokens
+):
+    tokenizer = GPT2Tokenizer.from_pretrained(params.model_name)
+    next_tag = 0
+    model_nnt, next_tag = GPT2Model_nnt.from_pretrained(
+        params.model_name,
+        params.minibatch_size,
+        params.minibatch_size_tile,
+        params.seq_len_tile,
+        next_tag,
+    )
+    draft_model_nnt, next_tag = GPT2Model_nnt.from_pretrained(
+        draft_model_name,
+        params.minibatch_size,
+        params.minibatch_size_tile,
+        params.seq_len_tile,
+        next_tag,
+    )
+
+    inputs = tokenizer(params.prompt, return_tensors="np")
+    input_ids = inputs["input_ids"]
+
+    padded_input = nnt_constructors.from_array(input_ids.T)
+    output_ids, effective_size = model_nnt.generate(
+        padded_input,
+        prefill_size=input_ids.shape[1],
+        params=GenerationParams(
+            max_tokens=params.max_tokens,
+            draft_model=draft_model_nnt,
+            num_speculative_tokens=num_speculative_tokens,
+        ),
+        mode=GenerationMode.Greedy,
+    )
+
+    output_ids_np = nnt_constructors.to_numpy(output_ids).astype(int)
+    output_ids_np = output_ids_np[:effective_size]
+
+    generation_result_list = tokenizer.batch_decode(output_ids_np)
+    generated_text = "".join(generation_result_list)
+
+    # Output of the main model does not depend on the draft model
+    assert (
+        generated_text == params.expected
+    ), f"Got: {generated_text}. Expected {params.expected}"
+
+
+@pytest.mark.slow
+@pytest.mark.parametrize("params", TEST_GENERATE_INPUT_PARAMS)
+@pytest.mark.parametrize("prefill_chunk_size", [1, 2, 4])
+def test_chunked_prefill_generation_from_pretrained(
+    starpu_simple, params, prefill_chunk_size
+):
+    tokenizer = GPT2Tokenizer.from_pretrained(params.model_name)
+    next_tag = 0
+    model_nnt, next_tag = GPT2Model_nnt.from_pretrained(
+        params.model_name,
+        params.minibatch_size,
+        params.minibatch_size_tile,
+        params.seq_len_tile,
+        next_tag,
+    )
+
+    inputs = tokenizer(params.prompt, return_tensors="np")
+    input_ids = inputs["input_ids"]
+
+    padded_input = nnt_constructors.from_array(input_ids.T)
+    output_ids, effective_size = model_nnt.generate(
+        padded_input,
+        prefill_size=input_ids.shape[1],
+        params=GenerationParams(
+            max_tokens=params.max_tokens,
+            prefill_chunk_size=prefill_chunk_size,
+        ),
+        mode=GenerationMode.Greedy,
+    )
+
+    output_ids_np = nnt_constructors.to_numpy(output_ids).astype(int)
+    output_ids_np = output_ids_np[:effective_size]
+
+    generation_result_list = tokenizer.batch_decode(output_ids_np)
+    generated_text = "".join(generation_result_list)
+
+    # Chunks of the prompt share kvcache, so output does not depend on them
+    assert (
+        generated_text == params.expected
+    ), f"Got: {generated_text}. Expected {params.expected}"
+
+
+@pytest.mark.slow
+@pytest.mark.parametrize("params", TEST_GENERATE_INPUT_PARAMS)
+@pytest.mark.parametrize("max_bucket_size", [None, 2])
+def test_bucketed_generation_from_pretrained(
+    starpu_simple, params, max_bucket_size
+):
+    tokenizer = GPT2Tokenizer.from_pretrained(params.model_name)
+    next_tag = 0
+    model_nnt, next_tag = GPT2Model_nnt.from_pretrained(
+        params.model_name,
+        params.minibatch_size,
+        params.minibatch_size_tile,
+        params.seq_len_tile,
+        next_tag,
+    )
+
+    inputs = tokenizer(params.prompt, return_tensors="np")
+    input_ids = inputs["input_ids"]
+
+    buckets = BucketedArenas(max_bucket_size)
+    # Second call reuses activations and temporaries of the first one
+    for _ in range(2):
+        padded_input = nnt_constructors.from_array(input_ids.T)
+        output_ids, effective_size = model_nnt.generate(
+            padded_input,
+            prefill_size=input_ids.shape[1],
+            params=GenerationParams(
+                max_tokens=params.max_tokens,
+                seq_len_buckets=buckets,
+            ),
+            mode=GenerationMode.Greedy,
+        )
+
+        output_ids_np = nnt_constructors.to_numpy(output_ids).astype(int)
+        output_ids_np = output_ids_np[:effective_size]
+
+        generation_result_list = tokenizer.batch_decode(output_ids_np)
+        generated_text = "".join(generation_result_list)
+
+        # Buckets of the prompt share kvcache, so output does not depend on
+        # them
+        assert (
+            generated_text == params.expected
+        ), f"Got: {generated_text}. Expected {params.expected}"
+
+    assert all(size & (size - 1) == 0 for size in buckets.arenas)
+    assert sum(arena.num_reuses for arena in buckets.arenas.values()) > 0
+    buckets.unregister()
@@ -80,7 +80,8 @@ multiple_tiles = LlamaDecoderTestParams(
 def generate_inputs(params: LlamaDecoderTestParams,
                     dtype: str,
                     att_bias: bool,
-                    flash_attention: bool):
+                    flash_attention: bool,
+                    inference: bool = False):
     torch_layer_config = LlamaConfig(
         hidden_size=params.hidden_size,
         intermediate_size=params.intermediate_size,
@@ -127,11 +128,13 @@ def generate_inputs(params: LlamaDecoderTestParams,
                     dtype=bool, order="F")
     nntile_layer, _ = LlamaDecoder_nntile.from_torch(torch_layer, X,
                                                      pos_ids, mask,
-                                                     nntile_config, 0)
+                                                     nntile_config, 0,
+                                                     inference)
     nntile_layer.clear_gradients()
     y_grad_random = gen.standard_normal(x_shape, dtype=np.float32)
     y_grad_nntile = np.array(y_grad_random, dtype=np.float32, order="F")
-    nntile_layer.activations[-1].grad.from_array(y_grad_nntile)
+    if not inference:
+        nntile_layer.activations[-1].grad.from_array(y_grad_nntile)
     y_grad_torch = torch.Tensor(y_grad_nntile.T)
     return torch_layer, nntile_layer, x_torch, y_grad_torch, pos_ids, mask
 
@@ -184,6 +187,50 @@ class TestLlamaMLP:
         rtol = dtype2tol[dtype]['rtol']
         assert torch.norm(y - y_nntile) <= rtol * torch.norm(y)
 
+    def test_forward_optimized(self, starpu_simple, torch_rng,
+                               params: LlamaDecoderTestParams,
+                               dtype: str,
+                               att_bias: bool,
+                               flash_attention: bool):
+        torch_layer, nntile_layer, x, _, pos_ids, mask = generate_inputs(
+                params, dtype, att_bias, flash_attention)
+        mask_torch = torch.Tensor(np.array(1 - mask, dtype=np.float32)).T \
+            * torch.finfo(torch.float32).min
+        mask_torch = mask_torch[None, None, :, :].expand(params.n_batch,
+                                                         1, -1, -1)
+        y = torch_layer(x, position_ids=torch.tensor(pos_ids),
+                        attention_mask=mask_torch)[0]
+        # Only the norm before MLP is folded, as attention consumes the
+        # output of the input norm
+        assert nntile_layer.optimize_for_inference() == 1
+        nntile_layer.forward_async()
+        y_nntile = torch.Tensor(to_numpy(nntile_layer.activations[-1].value).T)
+        nntile_layer.unregister()
+        rtol = dtype2tol[dtype]['rtol']
+        assert torch.norm(y - y_nntile) <= rtol * torch.norm(y)
+
+    def test_forward_inference(self, starpu_simple, torch_rng,
+                               params: LlamaDecoderTestParams,
+                               dtype: str,
+                               att_bias: bool,
+                               flash_attention: bool):
+        torch_layer, nntile_layer, x, _, pos_ids, mask = generate_inputs(
+                params, dtype, att_bias, flash_attention, inference=True)
+        # Neither parameters nor outputs of layers have gradients
+        for t in nntile_layer.parameters + nntile_layer.activations[1:]:
+            assert t.grad is None
+        mask_torch = torch.Tensor(np.array(1 - mask, dtype=np.float32)).T \
+            * torch.finfo(torch.float32).min
+        mask_torch = mask_torch[None, None, :, :].expand(params.n_batch,
+                                                         1, -1, -1)
+        y = torch_layer(x, position_ids=torch.tensor(pos_ids),
+                        attention_mask=mask_torch)[0]
+        nntile_layer.forward_async()
+        y_nntile = torch.Tensor(to_numpy(nntile_layer.activations[-1].value).T)
+        nntile_layer.unregister()
+        rtol = dtype2tol[dtype]['rtol']
+        assert torch.norm(y - y_nntile) <= rtol * torch.norm(y)
+
     def test_backward(self, starpu_simple, torch_rng,
                       params: LlamaDecoderTestParams, dtype: str,
                       att_bias: bool, flash_attention: bool):
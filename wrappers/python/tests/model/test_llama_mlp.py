@@ -24,7 +24,8 @@ import nntile
 from nntile.model.llama_config import LlamaConfigNNTile
 from nntile.model.llama_mlp import LlamaMLP as LlamaMLP_nntile
 from nntile.tensor import TensorMoments, TensorTraits
-from nntile.utils.constructors import to_numpy
+from nntile.utils.arena import TensorArena
+from nntile.utils.constructors import empty_like, to_numpy
 
 # NNTile dtype via corresponding Tensor type
 dtype2nntile = {
@@ -159,6 +160,42 @@ class TestLlamaMLP:
         rtol = dtype2tol[dtype]['rtol']
         assert torch.norm(y - y_nntile) <= rtol * torch.norm(y)
 
+    def test_forward_dynamic(self, starpu_simple, torch_rng,
+                             params: LlamaMLPTestParams, dtype: str):
+        torch_layer, nntile_layer, x, _ = generate_inputs(params, dtype)
+        y = torch_layer(x)
+        x_value = nntile_layer.activations[0].value
+        x_dyn = TensorMoments(empty_like(x_value), None, False)
+        nntile.tensor.copy_async(x_value, x_dyn.value)
+        # Tasks are captured to be counted, while temporaries of the arena
+        # survive the capture
+        arena = TensorArena()
+        graph = nntile.starpu.TaskGraph()
+        graph.begin_capture()
+        with arena.step():
+            nntile_layer.layers[0].forward_dynamic(x_dyn)
+        assert graph.end_capture()
+        n_gemm_gate = graph.count("nntile_gemm")
+        n_gemm = []
+        rtol = dtype2tol[dtype]['rtol']
+        for fused in (False, True):
+            if fused:
+                nntile_layer.fuse_gate_up()
+            graph.begin_capture()
+            with arena.step():
+                y_dyn = nntile_layer.forward_dynamic(x_dyn)
+                y_nntile = torch.Tensor(to_numpy(y_dyn.value).T)
+            assert graph.end_capture()
+            n_gemm.append(graph.count("nntile_gemm"))
+            assert torch.norm(y - y_nntile) <= rtol * torch.norm(y)
+        graph.clear()
+        arena.unregister()
+        x_dyn.unregister()
+        nntile_layer.unregister()
+        # A single gemm task per tile of stacked weights computes both
+        # gate_proj and up_proj
+        assert n_gemm[0] == n_gemm[1] + n_gemm_gate
+
     def test_forward_backward(self, starpu_simple, torch_rng,
                               params: LlamaMLPTestParams,
                               dtype: str):
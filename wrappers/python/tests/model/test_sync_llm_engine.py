@@ -17,6 +17,7 @@ import pytest
 from transformers import GPT2Tokenizer
 
 from nntile.inference.llm_sync_engine import LlmSyncInferenceEngine
+from nntile.layer.cache_utils import KVBlockPool, PrefixCache
 from nntile.model.generation.llm import GenerationMode, GenerationParams
 from nntile.model.gpt2 import GPT2Model as GPT2Model_nnt
 
@@ -68,3 +69,38 @@ def test_sync_llm_inference_engine_from_pretrained(starpu_simple, params):
     assert (
         generated_text == params.expected
     ), f"Got: {generated_text}. Expected {params.expected}"
+
+
+@pytest.mark.slow
+@pytest.mark.parametrize("params", TEST_LLM_INF_ENGINE_INPUT_PARAMS)
+def test_sync_llm_inference_engine_prefix_cache(starpu_simple, params):
+    tokenizer = GPT2Tokenizer.from_pretrained(params.model_name)
+    next_tag = 0
+    model_nnt, next_tag = GPT2Model_nnt.from_pretrained(
+        params.model_name,
+        params.minibatch_size,
+        params.minibatch_size_tile,
+        params.seq_len_tile,
+        next_tag,
+    )
+
+    pool = KVBlockPool(num_blocks=16, block_size=2)
+    prefix_cache = PrefixCache(pool, max_blocks=8)
+    llm_engine = LlmSyncInferenceEngine(
+        model_nnt, tokenizer, params.seq_len_tile, prefix_cache=prefix_cache
+    )
+    # The second request reuses the prompt of the first one
+    for _ in range(2):
+        generated_text = llm_engine.generate(
+            params.prompt,
+            params=GenerationParams(max_tokens=params.max_tokens),
+            mode=GenerationMode.Greedy,
+        )
+        assert (
+            generated_text == params.expected
+        ), f"Got: {generated_text}. Expected {params.expected}"
+        assert prefix_cache.num_blocks > 0
+
+    # Only blocks of the prefix cache are still taken
+    assert pool.num_free_blocks() == pool.num_blocks - prefix_cache.num_blocks
+    pool.unregister()
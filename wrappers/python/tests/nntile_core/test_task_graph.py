@@ -0,0 +1,114 @@
+# @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+#                              (Skoltech), Russia. All rights reserved.
+#                2023-present Artificial Intelligence Research Institute
+#                              (AIRI), Russia. All rights reserved.
+#
+# NNTile is software framework for fast training of big neural networks on
+# distributed-memory heterogeneous systems based on StarPU runtime system.
+#
+# @file wrappers/python/tests/nntile_core/test_task_graph.py
+# Test for capture and replay of a graph of StarPU tasks
+#
+# @version 1.1.0
+
+import numpy as np
+import pytest
+from numpy.testing import assert_equal
+
+import nntile
+from nntile.utils.arena import TensorArena, scratch_like
+
+config = nntile.starpu.Config(1, 0, 0)
+nntile.starpu.init()
+
+# Define mapping between numpy and nntile types
+Tensor = {np.float32: nntile.tensor.Tensor_fp32,
+          np.float64: nntile.tensor.Tensor_fp64}
+
+# Define mapping between tested function and numpy type
+add_inplace = {np.float32: nntile.nntile_core.tensor.add_inplace_fp32,
+       np.float64: nntile.nntile_core.tensor.add_inplace_fp64}
+
+
+@pytest.mark.parametrize('dtype', [np.float32, np.float64])
+def test_task_graph(dtype):
+    # Describe multi-tile tensors, located at node 0
+    shape = [4, 6]
+    basetile = [2, 3]
+    next_tag = 0
+    traits = nntile.tensor.TensorTraits(shape, basetile)
+    mpi_distr = [0] * traits.grid.nelems
+    A = Tensor[dtype](traits, mpi_distr, next_tag)
+    next_tag = A.next_tag
+    B = Tensor[dtype](traits, mpi_distr, next_tag)
+    rng = np.random.default_rng(42)
+    np_A = np.array(rng.standard_normal(shape), dtype=dtype, order='F')
+    np_B = np.array(rng.standard_normal(shape), dtype=dtype, order='F')
+    A.from_array(np_A)
+    B.from_array(np_B)
+    # Captured tasks are executed once during capture
+    graph = nntile.starpu.TaskGraph()
+    graph.begin_capture()
+    add_inplace[dtype](1.0, A, 2.0, B)
+    assert graph.end_capture()
+    assert len(graph) == traits.grid.nelems
+    # Every replay executes them again on the current data
+    np_A2 = np.array(rng.standard_normal(shape), dtype=dtype, order='F')
+    A.from_array(np_A2)
+    graph.replay()
+    np_C = np.zeros(shape, dtype=dtype, order='F')
+    B.to_array(np_C)
+    nntile.starpu.wait_for_all()
+    graph.clear()
+    assert len(graph) == 0
+    A.unregister()
+    B.unregister()
+    # Compare results
+    assert_equal(np_A2 + 2.0 * (np_A + 2.0 * np_B), np_C)
+
+
+@pytest.mark.parametrize('dtype', [np.float32, np.float64])
+def test_task_graph_temporaries(dtype):
+    shape = [4, 6]
+    basetile = [2, 3]
+    traits = nntile.tensor.TensorTraits(shape, basetile)
+    mpi_distr = [0] * traits.grid.nelems
+    A = Tensor[dtype](traits, mpi_distr, 0)
+    B = Tensor[dtype](traits, mpi_distr, 0)
+    rng = np.random.default_rng(42)
+    # Integers are summed without rounding errors
+    np_A = np.array(rng.integers(-10, 10, shape), dtype=dtype, order='F')
+    A.from_array(np_A)
+    B.from_array(np.zeros(shape, dtype=dtype, order='F'))
+
+    # Step of computations with a temporary tensor
+    def step():
+        tmp = scratch_like(A)
+        nntile.tensor.copy_async(A, tmp)
+        add_inplace[dtype](1.0, tmp, 1.0, B)
+
+    # Temporary tensor is unregistered at the end of the captured step, so
+    # the step is executed as usual, but the graph cannot be replayed
+    graph = nntile.starpu.TaskGraph()
+    graph.begin_capture()
+    step()
+    assert not graph.end_capture()
+    assert len(graph) == 0
+    graph.replay()
+    # Temporary tensors of an arena survive the step and can be replayed
+    arena = TensorArena()
+    graph.begin_capture()
+    with arena.step():
+        step()
+    assert graph.end_capture()
+    assert len(graph) == 2 * traits.grid.nelems
+    for _ in range(3):
+        graph.replay()
+    np_B = np.zeros(shape, dtype=dtype, order='F')
+    B.to_array(np_B)
+    graph.wait()
+    graph.clear()
+    arena.unregister()
+    A.unregister()
+    B.unregister()
+    assert_equal(5 * np_A, np_B)
@@ -43,3 +43,31 @@ class TestTensor:
         nntile.starpu.wait_for_all()
         tensor.unregister()
         assert_equal(dst, src)
+
+    @pytest.mark.parametrize('dtype', [np.float32, np.float64])
+    def test_leading_tiles_view(self, dtype):
+        shape = [7, 10]
+        basetile = [3, 4]
+        traits = nntile.tensor.TensorTraits(shape, basetile)
+        mpi_distr = [0] * traits.grid.nelems
+        tensor = Tensor[dtype](traits, mpi_distr, 0)
+        src = np.random.default_rng(42) \
+            .standard_normal(shape) \
+            .astype(dtype, 'F')
+        tensor.from_array(src)
+        # View shares the first 2x2 tiles with the tensor
+        view = Tensor[dtype](tensor, [2, 2])
+        assert view.shape == [6, 8]
+        assert view.basetile_shape == basetile
+        dst = np.zeros((6, 8), dtype=dtype, order='F')
+        view.to_array(dst)
+        assert_equal(dst, src[:6, :8])
+        # Update through the view is visible in the tensor
+        view.from_array(np.zeros_like(dst))
+        tensor.to_array(src)
+        nntile.starpu.wait_for_all()
+        with pytest.raises(Exception):
+            Tensor[dtype](tensor, [3, 4])
+        del view
+        tensor.unregister()
+        assert_equal(src[:6, :8], 0)
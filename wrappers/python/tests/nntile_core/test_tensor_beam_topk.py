@@ -0,0 +1,61 @@
+# @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+#                              (Skoltech), Russia. All rights reserved.
+#                2023-present Artificial Intelligence Research Institute
+#                              (AIRI), Russia. All rights reserved.
+#
+# NNTile is software framework for fast training of big neural networks on
+# distributed-memory heterogeneous systems based on StarPU runtime system.
+#
+# @file wrappers/python/tests/nntile_core/test_tensor_beam_topk.py
+# Test for tensor::beam_topk<T> Python wrapper
+#
+# @version 1.1.0
+
+import numpy as np
+import pytest
+from numpy.testing import assert_equal
+
+import nntile
+
+config = nntile.starpu.Config(1, 0, 0)
+nntile.starpu.init()
+
+Tensor = {np.float32: nntile.tensor.Tensor_fp32,
+          np.float64: nntile.tensor.Tensor_fp64}
+
+
+@pytest.mark.parametrize('dtype', [np.float32, np.float64])
+@pytest.mark.parametrize('basetile', [[30, 1, 4], [8, 1, 3]])
+@pytest.mark.parametrize('k', [1, 4, 7])
+def test_beam_topk(dtype, basetile, k):
+    vocab_size, num_beams = 30, 4
+    shape = [vocab_size, 1, num_beams]
+    rng = np.random.default_rng(42)
+    # Distinct values make the order of the top-k unique
+    src_np = np.array(rng.permutation(vocab_size * num_beams), dtype=dtype)
+    src_np = np.asfortranarray(src_np.reshape(shape, order='F'))
+    src_traits = nntile.tensor.TensorTraits(shape, basetile)
+    src = Tensor[dtype](src_traits, [0] * src_traits.grid.nelems, 0)
+    src.from_array(src_np)
+    dst_traits = nntile.tensor.TensorTraits([1, k], [1, k])
+    dst_val = Tensor[dtype](dst_traits, [0], 0)
+    dst_idx = nntile.tensor.Tensor_int64(dst_traits, [0], 0)
+    dst_beam = nntile.tensor.Tensor_int64(dst_traits, [0], 0)
+    nntile.tensor.beam_topk_async(src, dst_val, dst_idx, dst_beam)
+    val_np = np.zeros([1, k], dtype=dtype, order='F')
+    idx_np = np.zeros([1, k], dtype=np.int64, order='F')
+    beam_np = np.zeros([1, k], dtype=np.int64, order='F')
+    dst_val.to_array(val_np)
+    dst_idx.to_array(idx_np)
+    dst_beam.to_array(beam_np)
+    nntile.starpu.wait_for_all()
+    src.unregister()
+    dst_val.unregister()
+    dst_idx.unregister()
+    dst_beam.unregister()
+    # Token is the index along the first axis, beam is along the other axes
+    flat = src_np.flatten(order='F')
+    order = np.argsort(-flat)[:k]
+    assert_equal(val_np[0], flat[order])
+    assert_equal(idx_np[0], order % vocab_size)
+    assert_equal(beam_np[0], order // vocab_size)
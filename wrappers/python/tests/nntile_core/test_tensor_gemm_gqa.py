@@ -0,0 +1,84 @@
+# @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+#                              (Skoltech), Russia. All rights reserved.
+#                2023-present Artificial Intelligence Research Institute
+#                              (AIRI), Russia. All rights reserved.
+#
+# NNTile is software framework for fast training of big neural networks on
+# distributed-memory heterogeneous systems based on StarPU runtime system.
+#
+# @file wrappers/python/tests/nntile_core/test_tensor_gemm_gqa.py
+# Test for tensor::gemm_gqa<T> Python wrapper
+#
+# @version 1.1.0
+
+import numpy as np
+import pytest
+
+import nntile
+from nntile.functions import (
+    GEMM_GQA_BCAST_A, GEMM_GQA_BCAST_B, GEMM_GQA_BCAST_C)
+
+config = nntile.starpu.Config(1, 0, 0)
+nntile.starpu.init()
+
+# Define mapping between numpy and nntile types
+Tensor = {np.float32: nntile.tensor.Tensor_fp32,
+          np.float64: nntile.tensor.Tensor_fp64}
+
+# Define mapping between tested function and numpy type
+gemm_gqa = {np.float32: nntile.nntile_core.tensor.gemm_gqa_fp32,
+            np.float64: nntile.nntile_core.tensor.gemm_gqa_fp64}
+
+
+def make(dtype, array, basetile, next_tag):
+    traits = nntile.tensor.TensorTraits(array.shape, basetile)
+    mpi_distr = [0] * traits.grid.nelems
+    tensor = Tensor[dtype](traits, mpi_distr, next_tag)
+    tensor.from_array(array)
+    return tensor
+
+
+@pytest.mark.parametrize('dtype', [np.float32, np.float64])
+@pytest.mark.parametrize('group_tile', [1, 2])
+def test_gemm_gqa(dtype, group_tile):
+    # K is (head_size, n_seq_k, n_batch, n_head_kv), while Q is
+    # (head_size, n_seq_q, n_batch, kv_group_size, n_head_kv)
+    head_size, n_seq_k, n_seq_q, n_batch, group, n_head_kv = 4, 5, 3, 2, 2, 3
+    rng = np.random.default_rng(42)
+    src_K = rng.standard_normal((head_size, n_seq_k, n_batch, n_head_kv))
+    src_K = src_K.astype(dtype, 'F')
+    src_Q = rng.standard_normal(
+        (head_size, n_seq_q, n_batch, group, n_head_kv)
+    ).astype(dtype, 'F')
+    src_dK = rng.standard_normal(src_K.shape).astype(dtype, 'F')
+    K = make(dtype, src_K, (2, 3, 1, 1), 0)
+    Q = make(dtype, src_Q, (2, 2, 1, group_tile, 1), K.next_tag)
+    A = make(dtype, np.zeros((n_seq_k, *src_Q.shape[1:]), dtype, 'F'),
+             (3, 2, 1, group_tile, 1), Q.next_tag)
+    C = make(dtype, np.zeros((n_seq_q, n_seq_k, *src_Q.shape[2:]), dtype,
+                             'F'),
+             (2, 3, 1, group_tile, 1), A.next_tag)
+    dK = make(dtype, src_dK, (2, 3, 1, 1), C.next_tag)
+    # Shared A, shared B and shared C
+    gemm_gqa[dtype](1.0, nntile.trans, K, nntile.notrans, Q, 0.0, A, 1, 3, 1,
+                    GEMM_GQA_BCAST_A, 0)
+    gemm_gqa[dtype](1.0, nntile.trans, Q, nntile.notrans, K, 0.0, C, 1, 3, 1,
+                    GEMM_GQA_BCAST_B, 0)
+    gemm_gqa[dtype](2.0, nntile.notrans, Q, nntile.trans, A, -1.0, dK, 1, 3,
+                    1, GEMM_GQA_BCAST_C, 0)
+    dst_A = np.zeros(A.shape, dtype, 'F')
+    dst_C = np.zeros(C.shape, dtype, 'F')
+    dst_dK = np.zeros(dK.shape, dtype, 'F')
+    A.to_array(dst_A)
+    C.to_array(dst_C)
+    dK.to_array(dst_dK)
+    nntile.starpu.wait_for_all()
+    for tensor in (K, Q, A, C, dK):
+        tensor.unregister()
+    # Check results against numpy
+    ref_A = np.einsum('hkbn,hqbgn->kqbgn', src_K, src_Q)
+    ref_C = np.einsum('hqbgn,hkbn->qkbgn', src_Q, src_K)
+    ref_dK = -src_dK + 2 * np.einsum('hqbgn,kqbgn->hkbn', src_Q, ref_A)
+    assert np.linalg.norm(dst_A - ref_A) <= 1e-4 * np.linalg.norm(ref_A)
+    assert np.linalg.norm(dst_C - ref_C) <= 1e-4 * np.linalg.norm(ref_C)
+    assert np.linalg.norm(dst_dK - ref_dK) <= 1e-4 * np.linalg.norm(ref_dK)
@@ -0,0 +1,60 @@
+# @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+#                              (Skoltech), Russia. All rights reserved.
+#                2023-present Artificial Intelligence Research Institute
+#                              (AIRI), Russia. All rights reserved.
+#
+# NNTile is software framework for fast training of big neural networks on
+# distributed-memory heterogeneous systems based on StarPU runtime system.
+#
+# @file wrappers/python/tests/nntile_core/test_tensor_index_select.py
+# Test for tensor::index_select<T> Python wrapper
+#
+# @version 1.1.0
+
+import numpy as np
+import pytest
+from numpy.testing import assert_equal
+
+import nntile
+
+config = nntile.starpu.Config(1, 0, 0)
+nntile.starpu.init()
+
+Tensor = {np.float32: nntile.tensor.Tensor_fp32,
+          np.float64: nntile.tensor.Tensor_fp64,
+          np.int64: nntile.tensor.Tensor_int64}
+
+
+@pytest.mark.parametrize('dtype', [np.float32, np.float64, np.int64])
+@pytest.mark.parametrize('axis', [0, 1, 2])
+@pytest.mark.parametrize('index', [[2, 0, 0, 1], [1], [0, 1, 2]])
+def test_index_select(dtype, axis, index):
+    src_shape = [3, 4, 5]
+    basetile = [2, 3, 2]
+    rng = np.random.default_rng(42)
+    src_np = np.array(rng.integers(0, 100, src_shape), dtype=dtype,
+                      order='F')
+    # Selected axis is not split into tiles
+    src_basetile = list(basetile)
+    src_basetile[axis] = src_shape[axis]
+    dst_shape = list(src_shape)
+    dst_shape[axis] = len(index)
+    dst_basetile = list(basetile)
+    dst_basetile[axis] = len(index)
+    src_traits = nntile.tensor.TensorTraits(src_shape, src_basetile)
+    src = Tensor[dtype](src_traits, [0] * src_traits.grid.nelems, 0)
+    src.from_array(src_np)
+    dst_traits = nntile.tensor.TensorTraits(dst_shape, dst_basetile)
+    dst = Tensor[dtype](dst_traits, [0] * dst_traits.grid.nelems, 0)
+    index_np = np.array(index, dtype=np.int64)
+    index_traits = nntile.tensor.TensorTraits([len(index)], [len(index)])
+    index_nnt = nntile.tensor.Tensor_int64(index_traits, [0], 0)
+    index_nnt.from_array(index_np)
+    nntile.tensor.index_select_async(index_nnt, src, dst, axis)
+    dst_np = np.zeros(dst_shape, dtype=dtype, order='F')
+    dst.to_array(dst_np)
+    nntile.starpu.wait_for_all()
+    src.unregister()
+    dst.unregister()
+    index_nnt.unregister()
+    assert_equal(dst_np, np.take(src_np, index_np, axis=axis))
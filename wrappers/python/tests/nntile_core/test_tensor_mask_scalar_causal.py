@@ -0,0 +1,56 @@
+# @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+#                              (Skoltech), Russia. All rights reserved.
+#                2023-present Artificial Intelligence Research Institute
+#                              (AIRI), Russia. All rights reserved.
+#
+# NNTile is software framework for fast training of big neural networks on
+# distributed-memory heterogeneous systems based on StarPU runtime system.
+#
+# @file wrappers/python/tests/nntile_core/test_tensor_mask_scalar_causal.py
+# Test for tensor::mask_scalar_causal<T> Python wrapper
+#
+# @version 1.1.0
+
+import numpy as np
+import pytest
+from numpy.testing import assert_equal
+
+import nntile
+
+config = nntile.starpu.Config(1, 0, 0)
+nntile.starpu.init()
+
+# Define mapping between numpy and nntile types
+Tensor = {np.float32: nntile.tensor.Tensor_fp32,
+          np.float64: nntile.tensor.Tensor_fp64}
+
+
+@pytest.mark.parametrize('dtype', [np.float32, np.float64])
+@pytest.mark.parametrize('offset,window,kv_len', [
+    (0, 0, -1), (4, 0, -1), (4, 3, -1), (2, 0, 7),
+])
+def test_mask_scalar_causal(dtype, offset, window, kv_len):
+    shape = [10, 6, 3]
+    basetile = [4, 4, 2]
+    traits = nntile.tensor.TensorTraits(shape, basetile)
+    mpi_distr = [0] * traits.grid.nelems
+    A = Tensor[dtype](traits, mpi_distr, 0)
+    rand_A = np.random.default_rng(42).standard_normal(shape)
+    np_A = np.array(rand_A, dtype=dtype, order='F')
+    A.from_array(np_A)
+    # Explicitly evaluated mask
+    k = np.arange(shape[0])[:, np.newaxis]
+    q = np.arange(shape[1])[np.newaxis, :] + offset
+    keep = k <= q
+    if window > 0:
+        keep &= q - k < window
+    if kv_len >= 0:
+        keep &= k < kv_len
+    mask_value = -1000.
+    np_res = np.where(keep[:, :, np.newaxis], np_A, mask_value)
+    nntile.tensor.mask_scalar_causal_async(offset, window, kv_len,
+                                           mask_value, A, 1)
+    A.to_array(np_A)
+    nntile.starpu.wait_for_all()
+    A.unregister()
+    assert_equal(np_res, np_A)
@@ -0,0 +1,61 @@
+# @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+#                              (Skoltech), Russia. All rights reserved.
+#                2023-present Artificial Intelligence Research Institute
+#                              (AIRI), Russia. All rights reserved.
+#
+# NNTile is software framework for fast training of big neural networks on
+# distributed-memory heterogeneous systems based on StarPU runtime system.
+#
+# @file wrappers/python/tests/nntile_core/test_tensor_mask_varlen.py
+# Test for tensor::mask_varlen Python wrapper
+#
+# @version 1.1.0
+
+import numpy as np
+import pytest
+from numpy.testing import assert_equal
+
+import nntile
+
+config = nntile.starpu.Config(1, 0, 0)
+nntile.starpu.init()
+
+
+@pytest.mark.parametrize('cu_seqlens_k,cu_seqlens_q', [
+    ([0, 7, 10, 17], [0, 7, 10, 17]),
+    ([0, 9, 12, 18], [0, 1, 2, 3]),
+    ([0, 5, 5, 13], [0, 2, 2, 6]),
+])
+def test_mask_varlen(cu_seqlens_k, cu_seqlens_q):
+    shape = [20, 8]
+    basetile = [4, 4]
+    traits = nntile.tensor.TensorTraits(shape, basetile)
+    mpi_distr = [0] * traits.grid.nelems
+    A = nntile.tensor.Tensor_bool(traits, mpi_distr, 0)
+    # Explicitly evaluated mask
+    np_res = np.zeros(shape, dtype=bool, order='F')
+    for s in range(len(cu_seqlens_k) - 1):
+        k0, k1 = cu_seqlens_k[s:s + 2]
+        q0, q1 = cu_seqlens_q[s:s + 2]
+        k = np.arange(k1 - k0)[:, np.newaxis]
+        q = np.arange(q1 - q0)[np.newaxis, :] + (k1 - k0) - (q1 - q0)
+        np_res[k0:k1, q0:q1] = k <= q
+    nntile.tensor.mask_varlen_async(cu_seqlens_k, cu_seqlens_q, A)
+    status = nntile.tensor.mask_varlen_tile_status(cu_seqlens_k,
+                                                   cu_seqlens_q, A)
+    np_A = np.zeros(shape, dtype=bool, order='F')
+    A.to_array(np_A)
+    nntile.starpu.wait_for_all()
+    A.unregister()
+    assert_equal(np_res, np_A)
+    # Status of every tile agrees with its elements
+    for i in range(traits.grid.nelems):
+        index = traits.grid.linear_to_index(i)
+        tile = np_A[index[0] * 4:index[0] * 4 + 4,
+                    index[1] * 4:index[1] * 4 + 4]
+        if not tile.any():
+            assert status[i] == 0
+        elif tile.all():
+            assert status[i] == 2
+        else:
+            assert status[i] == 1
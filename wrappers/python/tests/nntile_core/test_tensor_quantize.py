@@ -0,0 +1,58 @@
+# @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+#                              (Skoltech), Russia. All rights reserved.
+#                2023-present Artificial Intelligence Research Institute
+#                              (AIRI), Russia. All rights reserved.
+#
+# NNTile is software framework for fast training of big neural networks on
+# distributed-memory heterogeneous systems based on StarPU runtime system.
+#
+# @file wrappers/python/tests/nntile_core/test_tensor_quantize.py
+# Test for tensor::quantize<T> and tensor::dequantize<T> Python wrappers
+#
+# @version 1.1.0
+
+import numpy as np
+import pytest
+from numpy.testing import assert_allclose
+
+import nntile
+
+config = nntile.starpu.Config(1, 0, 0)
+nntile.starpu.init()
+
+Tensor = {np.float32: nntile.tensor.Tensor_fp32,
+          np.float64: nntile.tensor.Tensor_fp64}
+
+
+@pytest.mark.parametrize('dtype', [np.float32, np.float64])
+def test_quantize(dtype):
+    shape = [16, 7, 3]
+    basetile = [16, 3, 2]
+    rng = np.random.default_rng(42)
+    src_np = np.array(rng.standard_normal(shape), dtype=dtype, order='F')
+    traits = nntile.tensor.TensorTraits(shape, basetile)
+    mpi_distr = [0] * traits.grid.nelems
+    src = Tensor[dtype](traits, mpi_distr, 0)
+    src.from_array(src_np)
+    dst = nntile.tensor.Tensor_int8(traits, mpi_distr, 0)
+    out = Tensor[dtype](traits, mpi_distr, 0)
+    scale_traits = nntile.tensor.TensorTraits(shape[1:], basetile[1:])
+    scale = Tensor[dtype](scale_traits, mpi_distr, 0)
+    nntile.tensor.quantize_async(src, dst, scale)
+    nntile.tensor.dequantize_async(dst, scale, out)
+    dst_np = np.zeros(shape, dtype=np.int8, order='F')
+    scale_np = np.zeros(shape[1:], dtype=dtype, order='F')
+    out_np = np.zeros(shape, dtype=dtype, order='F')
+    dst.to_array(dst_np)
+    scale.to_array(scale_np)
+    out.to_array(out_np)
+    nntile.starpu.wait_for_all()
+    src.unregister()
+    dst.unregister()
+    scale.unregister()
+    out.unregister()
+    # A scale per fiber along the first axis
+    assert_allclose(scale_np, np.abs(src_np).max(axis=0) / 127, rtol=1e-6)
+    assert np.abs(dst_np.astype(np.int64)).max() == 127
+    assert_allclose(out_np, dst_np * scale_np[None], rtol=1e-6)
+    assert np.all(np.abs(out_np - src_np) <= 0.5001 * scale_np[None])
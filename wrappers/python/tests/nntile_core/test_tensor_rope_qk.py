@@ -0,0 +1,83 @@
+# @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+#                              (Skoltech), Russia. All rights reserved.
+#                2023-present Artificial Intelligence Research Institute
+#                              (AIRI), Russia. All rights reserved.
+#
+# NNTile is software framework for fast training of big neural networks on
+# distributed-memory heterogeneous systems based on StarPU runtime system.
+#
+# @file wrappers/python/tests/nntile_core/test_tensor_rope_qk.py
+# Test for tensor::rope_qk<T> Python wrapper
+#
+# @version 1.1.0
+
+import numpy as np
+import pytest
+from numpy.testing import assert_allclose
+
+import nntile
+
+config = nntile.starpu.Config(1, 0, 0)
+nntile.starpu.init()
+
+# Define mapping between numpy and nntile types
+Tensor = {np.float32: nntile.tensor.Tensor_fp32,
+          np.float64: nntile.tensor.Tensor_fp64}
+
+
+def make(dtype, np_x, basetile):
+    traits = nntile.tensor.TensorTraits(np_x.shape, basetile)
+    mpi_distr = [0] * traits.grid.nelems
+    x = Tensor[dtype](traits, mpi_distr, 0)
+    x.from_array(np.array(np_x, dtype=dtype, order='F'))
+    return x
+
+
+def rotate(np_sin, np_cos, np_x, offset):
+    n_seq = np_x.shape[1]
+    s = np_sin[:, offset:offset + n_seq, :np_x.shape[2]]
+    c = np_cos[:, offset:offset + n_seq, :np_x.shape[2]]
+    s = s.reshape(s.shape + (1,) * (np_x.ndim - 3))
+    c = c.reshape(c.shape + (1,) * (np_x.ndim - 3))
+    a, b = np_x[0::2], np_x[1::2]
+    res = np.empty_like(np_x)
+    res[0::2] = c * a - s * b
+    res[1::2] = s * a + c * b
+    return res
+
+
+@pytest.mark.parametrize('dtype', [np.float32, np.float64])
+@pytest.mark.parametrize('offset,n_seq,seq_tile', [
+    (0, 7, 3), (5, 1, 1), (3, 4, 4),
+])
+@pytest.mark.parametrize('backward', [False, True])
+def test_rope_qk(dtype, offset, n_seq, seq_tile, backward):
+    head_size, max_seq, n_batch = 8, 12, 3
+    n_group, n_head_kv = 2, 4
+    rng = np.random.default_rng(42)
+    angles = rng.standard_normal((head_size // 2, max_seq, n_batch))
+    np_sin, np_cos = np.sin(angles), np.cos(angles)
+    np_q = rng.standard_normal((head_size, n_seq, n_batch, n_group,
+                                n_head_kv))
+    np_k = rng.standard_normal((head_size, n_seq, n_batch, n_head_kv))
+    sin = make(dtype, np_sin, [head_size // 2, 5, 2])
+    cos = make(dtype, np_cos, [head_size // 2, 5, 2])
+    q = make(dtype, np_q, [head_size, seq_tile, 2, n_group, 2])
+    k = make(dtype, np_k, [head_size, seq_tile, 2, 2])
+    if backward:
+        nntile.tensor.rope_qk_backward_async(offset, sin, cos, q, k)
+        np_sin = -np_sin
+    else:
+        nntile.tensor.rope_qk_async(offset, sin, cos, q, k)
+    np_q_res = np.zeros_like(np_q, dtype=dtype, order='F')
+    np_k_res = np.zeros_like(np_k, dtype=dtype, order='F')
+    q.to_array(np_q_res)
+    k.to_array(np_k_res)
+    nntile.starpu.wait_for_all()
+    for x in (sin, cos, q, k):
+        x.unregister()
+    rtol = 1e-5 if dtype == np.float32 else 1e-10
+    assert_allclose(np_q_res, rotate(np_sin, np_cos, np_q, offset),
+                    rtol=rtol, atol=rtol)
+    assert_allclose(np_k_res, rotate(np_sin, np_cos, np_k, offset),
+                    rtol=rtol, atol=rtol)
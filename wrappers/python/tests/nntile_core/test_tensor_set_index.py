@@ -0,0 +1,52 @@
+# @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+#                              (Skoltech), Russia. All rights reserved.
+#                2023-present Artificial Intelligence Research Institute
+#                              (AIRI), Russia. All rights reserved.
+#
+# NNTile is software framework for fast training of big neural networks on
+# distributed-memory heterogeneous systems based on StarPU runtime system.
+#
+# @file wrappers/python/tests/nntile_core/test_tensor_set_index.py
+# Test for tensor::set_index<T> Python wrapper
+#
+# @version 1.1.0
+
+import numpy as np
+import pytest
+from numpy.testing import assert_equal
+
+import nntile
+
+config = nntile.starpu.Config(1, 0, 0)
+nntile.starpu.init()
+
+Tensor = {np.float32: nntile.tensor.Tensor_fp32,
+          np.float64: nntile.tensor.Tensor_fp64,
+          np.int64: nntile.tensor.Tensor_int64}
+
+
+@pytest.mark.parametrize('dtype', [np.float32, np.float64, np.int64])
+@pytest.mark.parametrize('src_index,dst_index', [(0, 0), (4, 7), (6, 2)])
+def test_set_index(dtype, src_index, dst_index):
+    src_shape = [7, 3]
+    dst_shape = [10, 3]
+    basetile = [3, 2]
+    rng = np.random.default_rng(42)
+    src_np = np.array(rng.integers(0, 100, src_shape), dtype=dtype,
+                      order='F')
+    dst_np = np.array(rng.integers(0, 100, dst_shape), dtype=dtype,
+                      order='F')
+    src_traits = nntile.tensor.TensorTraits(src_shape, basetile)
+    src = Tensor[dtype](src_traits, [0] * src_traits.grid.nelems, 0)
+    src.from_array(src_np)
+    dst_traits = nntile.tensor.TensorTraits(dst_shape, basetile)
+    dst = Tensor[dtype](dst_traits, [0] * dst_traits.grid.nelems, 0)
+    dst.from_array(dst_np)
+    nntile.tensor.set_index_async(src, src_index, dst, dst_index, 0)
+    result_np = np.zeros(dst_shape, dtype=dtype, order='F')
+    dst.to_array(result_np)
+    nntile.starpu.wait_for_all()
+    src.unregister()
+    dst.unregister()
+    dst_np[dst_index] = src_np[src_index]
+    assert_equal(result_np, dst_np)
@@ -0,0 +1,63 @@
+# @copyright (c) 2022-present Skolkovo Institute of Science and Technology
+#                              (Skoltech), Russia. All rights reserved.
+#                2023-present Artificial Intelligence Research Institute
+#                              (AIRI), Russia. All rights reserved.
+#
+# NNTile is software framework for fast training of big neural networks on
+# distributed-memory heterogeneous systems based on StarPU runtime system.
+#
+# @file wrappers/python/tests/nntile_core/test_tensor_topk.py
+# Test for tensor::topk and tensor::sample_topk<T> Python wrappers
+#
+# @version 1.1.0
+
+import numpy as np
+import pytest
+from numpy.testing import assert_equal
+
+import nntile
+
+config = nntile.starpu.Config(1, 0, 0)
+nntile.starpu.init()
+
+Tensor = {np.float32: nntile.tensor.Tensor_fp32,
+          np.float64: nntile.tensor.Tensor_fp64}
+
+
+@pytest.mark.parametrize('dtype', [np.float32, np.float64])
+@pytest.mark.parametrize('k', [1, 5])
+def test_topk(dtype, k):
+    shape = [50, 3, 4]
+    basetile = [16, 2, 4]
+    rng = np.random.default_rng(42)
+    src_np = np.array(rng.integers(0, 20, shape), dtype=dtype, order='F')
+    src_traits = nntile.tensor.TensorTraits(shape, basetile)
+    src = Tensor[dtype](src_traits, [0] * src_traits.grid.nelems, 0)
+    src.from_array(src_np)
+    dst_traits = nntile.tensor.TensorTraits([k] + shape[1:],
+                                            [k] + basetile[1:])
+    mpi_distr = [0] * dst_traits.grid.nelems
+    dst_val = Tensor[dtype](dst_traits, mpi_distr, 0)
+    dst_idx = nntile.tensor.Tensor_int64(dst_traits, mpi_distr, 0)
+    tokens_traits = nntile.tensor.TensorTraits(shape[1:], basetile[1:])
+    tokens = nntile.tensor.Tensor_int64(tokens_traits,
+                                        [0] * tokens_traits.grid.nelems, 0)
+    nntile.tensor.topk_async(src, dst_val, dst_idx)
+    # Zero temperature means greedy sampling
+    nntile.tensor.sample_topk_async(0.0, 1.0, 0, dst_val, dst_idx, tokens)
+    val_np = np.zeros([k] + shape[1:], dtype=dtype, order='F')
+    idx_np = np.zeros([k] + shape[1:], dtype=np.int64, order='F')
+    tokens_np = np.zeros(shape[1:], dtype=np.int64, order='F')
+    dst_val.to_array(val_np)
+    dst_idx.to_array(idx_np)
+    tokens.to_array(tokens_np)
+    nntile.starpu.wait_for_all()
+    src.unregister()
+    dst_val.unregister()
+    dst_idx.unregister()
+    tokens.unregister()
+    # Stable sort keeps smaller indices first among equal values
+    order = np.argsort(-src_np, axis=0, kind='stable')[:k]
+    assert_equal(idx_np, order)
+    assert_equal(val_np, np.take_along_axis(src_np, order, axis=0))
+    assert_equal(tokens_np, order[0])